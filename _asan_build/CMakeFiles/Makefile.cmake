@@ -0,0 +1,154 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/deps/CMakeLists.txt"
+  "/root/repo/deps/imath/CMakeLists.txt"
+  "/root/repo/deps/lz4/CMakeLists.txt"
+  "/root/repo/deps/sha1/CMakeLists.txt"
+  "/root/repo/deps/varint/CMakeLists.txt"
+  "/root/repo/deps/varint/examples/CMakeLists.txt"
+  "/root/repo/deps/varint/src/CMakeLists.txt"
+  "/root/repo/deps/xxHash/CMakeLists.txt"
+  "/root/repo/src/CMakeLists.txt"
+  "/root/repo/src/fenwick/CMakeLists.txt"
+  "/root/repo/src/segment/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/BasicConfigVersion-SameMajorVersion.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePackageConfigHelpers.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceRuns.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckTypeSize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceRuns.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/WriteBasicConfigVersionFile.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/sha1/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/xxHash/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/lz4/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/varint/varintConfigVersion.cmake"
+  "deps/varint/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/varint/src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/varint/examples/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "deps/imath/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/fenwick/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/segment/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "deps/sha1/CMakeFiles/sha1.dir/DependInfo.cmake"
+  "deps/sha1/CMakeFiles/sha1-shared.dir/DependInfo.cmake"
+  "deps/sha1/CMakeFiles/sha1-static.dir/DependInfo.cmake"
+  "deps/sha1/CMakeFiles/sha1-library.dir/DependInfo.cmake"
+  "deps/xxHash/CMakeFiles/xxhash.dir/DependInfo.cmake"
+  "deps/xxHash/CMakeFiles/xxhash-shared.dir/DependInfo.cmake"
+  "deps/xxHash/CMakeFiles/xxhash-static.dir/DependInfo.cmake"
+  "deps/xxHash/CMakeFiles/xxhash-library.dir/DependInfo.cmake"
+  "deps/lz4/CMakeFiles/lz4.dir/DependInfo.cmake"
+  "deps/lz4/CMakeFiles/lz4-shared.dir/DependInfo.cmake"
+  "deps/lz4/CMakeFiles/lz4-static.dir/DependInfo.cmake"
+  "deps/lz4/CMakeFiles/lz4-library.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varint.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintDimension.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varint-shared.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varint-static.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varint-library.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintDimension-shared.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintDimension-static.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintDimension-library.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintPackedTest.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintCompare.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintDimensionTest.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintDeltaTest.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintFORTest.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintPFORTest.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintGroupTest.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintDictTest.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintFloatTest.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintBitmapTest.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintRLETest.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintEliasTest.dir/DependInfo.cmake"
+  "deps/varint/src/CMakeFiles/varintBP128Test.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/example_tagged.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/example_external.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/example_split.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/example_chained.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/example_packed.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/example_dimension.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/example_bitstream.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/database_system.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/network_protocol.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/column_store.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/game_engine.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/sensor_network.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/ml_features.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/kv_store.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/timeseries_db.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/graph_database.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/blockchain_ledger.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/dns_server.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/game_replay_system.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/bytecode_vm.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/inverted_index.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/financial_orderbook.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/log_aggregation.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/geospatial_routing.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/trie_pattern_matcher.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/trie_interactive.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/trie_server.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/trie_client.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/autocomplete_trie.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/pointcloud_octree.dir/DependInfo.cmake"
+  "deps/varint/examples/CMakeFiles/examples.dir/DependInfo.cmake"
+  "deps/imath/CMakeFiles/imath.dir/DependInfo.cmake"
+  "deps/imath/CMakeFiles/imath-shared.dir/DependInfo.cmake"
+  "deps/imath/CMakeFiles/imath-static.dir/DependInfo.cmake"
+  "deps/imath/CMakeFiles/imath-library.dir/DependInfo.cmake"
+  "deps/imath/CMakeFiles/pi-imath.dir/DependInfo.cmake"
+  "src/CMakeFiles/datakit.dir/DependInfo.cmake"
+  "src/CMakeFiles/datakit-shared.dir/DependInfo.cmake"
+  "src/CMakeFiles/datakit-static.dir/DependInfo.cmake"
+  "src/CMakeFiles/datakit-library.dir/DependInfo.cmake"
+  "src/CMakeFiles/datakit-test.dir/DependInfo.cmake"
+  "src/CMakeFiles/datakit-check.dir/DependInfo.cmake"
+  "src/CMakeFiles/datakit-quickcheck.dir/DependInfo.cmake"
+  "src/CMakeFiles/lint.dir/DependInfo.cmake"
+  )
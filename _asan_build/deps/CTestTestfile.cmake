@@ -0,0 +1,11 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/deps
+# Build directory: /root/repo/_asan_build/deps
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("sha1")
+subdirs("xxHash")
+subdirs("lz4")
+subdirs("varint")
+subdirs("imath")
@@ -0,0 +1,10 @@
+file(REMOVE_RECURSE
+  "libimath.pdb"
+  "libimath.so"
+  "libimath.so.3.6"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/imath-library.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
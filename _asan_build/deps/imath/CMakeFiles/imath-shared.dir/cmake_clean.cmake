@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "imath.pdb"
+  "imath.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/imath-shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libimath.a"
+  "libimath.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/imath-static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
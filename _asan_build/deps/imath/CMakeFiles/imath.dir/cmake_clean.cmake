@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/imath.dir/imath.c.o"
+  "CMakeFiles/imath.dir/imath.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/imath.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pi-imath.dir/pi.c.o"
+  "CMakeFiles/pi-imath.dir/pi.c.o.d"
+  "pi-imath"
+  "pi-imath.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/pi-imath.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+file(REMOVE_RECURSE
+  "liblz4.pdb"
+  "liblz4.so"
+  "liblz4.so.3.6"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/lz4-library.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
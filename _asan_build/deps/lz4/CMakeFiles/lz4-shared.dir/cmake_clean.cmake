@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "lz4.pdb"
+  "lz4.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/lz4-shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "liblz4.a"
+  "liblz4.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/lz4-static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
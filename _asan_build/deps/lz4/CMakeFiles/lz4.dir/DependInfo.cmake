@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/deps/lz4/lz4.c" "deps/lz4/CMakeFiles/lz4.dir/lz4.c.o" "gcc" "deps/lz4/CMakeFiles/lz4.dir/lz4.c.o.d"
+  "/root/repo/deps/lz4/lz4frame.c" "deps/lz4/CMakeFiles/lz4.dir/lz4frame.c.o" "gcc" "deps/lz4/CMakeFiles/lz4.dir/lz4frame.c.o.d"
+  "/root/repo/deps/lz4/lz4hc.c" "deps/lz4/CMakeFiles/lz4.dir/lz4hc.c.o" "gcc" "deps/lz4/CMakeFiles/lz4.dir/lz4hc.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/lz4.dir/lz4.c.o"
+  "CMakeFiles/lz4.dir/lz4.c.o.d"
+  "CMakeFiles/lz4.dir/lz4frame.c.o"
+  "CMakeFiles/lz4.dir/lz4frame.c.o.d"
+  "CMakeFiles/lz4.dir/lz4hc.c.o"
+  "CMakeFiles/lz4.dir/lz4hc.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/lz4.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+file(REMOVE_RECURSE
+  "libsha1.pdb"
+  "libsha1.so"
+  "libsha1.so.3.6"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/sha1-library.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "sha1.pdb"
+  "sha1.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/sha1-shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libsha1.a"
+  "libsha1.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/sha1-static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sha1.dir/sha1.c.o"
+  "CMakeFiles/sha1.dir/sha1.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/sha1.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
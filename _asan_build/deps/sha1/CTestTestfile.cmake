@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/deps/sha1
+# Build directory: /root/repo/_asan_build/deps/sha1
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
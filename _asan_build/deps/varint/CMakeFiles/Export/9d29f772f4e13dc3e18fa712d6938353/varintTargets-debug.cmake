@@ -0,0 +1,49 @@
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "Debug".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "varint::varint-static" for configuration "Debug"
+set_property(TARGET varint::varint-static APPEND PROPERTY IMPORTED_CONFIGURATIONS DEBUG)
+set_target_properties(varint::varint-static PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEBUG "C"
+  IMPORTED_LOCATION_DEBUG "${_IMPORT_PREFIX}/lib/varint.a"
+  )
+
+list(APPEND _cmake_import_check_targets varint::varint-static )
+list(APPEND _cmake_import_check_files_for_varint::varint-static "${_IMPORT_PREFIX}/lib/varint.a" )
+
+# Import target "varint::varint-library" for configuration "Debug"
+set_property(TARGET varint::varint-library APPEND PROPERTY IMPORTED_CONFIGURATIONS DEBUG)
+set_target_properties(varint::varint-library PROPERTIES
+  IMPORTED_LOCATION_DEBUG "${_IMPORT_PREFIX}/lib/libvarint.so"
+  IMPORTED_SONAME_DEBUG "libvarint.so"
+  )
+
+list(APPEND _cmake_import_check_targets varint::varint-library )
+list(APPEND _cmake_import_check_files_for_varint::varint-library "${_IMPORT_PREFIX}/lib/libvarint.so" )
+
+# Import target "varint::varintDimension-static" for configuration "Debug"
+set_property(TARGET varint::varintDimension-static APPEND PROPERTY IMPORTED_CONFIGURATIONS DEBUG)
+set_target_properties(varint::varintDimension-static PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEBUG "C"
+  IMPORTED_LOCATION_DEBUG "${_IMPORT_PREFIX}/lib/varintDimension.a"
+  )
+
+list(APPEND _cmake_import_check_targets varint::varintDimension-static )
+list(APPEND _cmake_import_check_files_for_varint::varintDimension-static "${_IMPORT_PREFIX}/lib/varintDimension.a" )
+
+# Import target "varint::varintDimension-library" for configuration "Debug"
+set_property(TARGET varint::varintDimension-library APPEND PROPERTY IMPORTED_CONFIGURATIONS DEBUG)
+set_target_properties(varint::varintDimension-library PROPERTIES
+  IMPORTED_LOCATION_DEBUG "${_IMPORT_PREFIX}/lib/libvarintDimension.so"
+  IMPORTED_SONAME_DEBUG "libvarintDimension.so"
+  )
+
+list(APPEND _cmake_import_check_targets varint::varintDimension-library )
+list(APPEND _cmake_import_check_files_for_varint::varintDimension-library "${_IMPORT_PREFIX}/lib/libvarintDimension.so" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/deps/varint
+# Build directory: /root/repo/_asan_build/deps/varint
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("src")
+subdirs("examples")
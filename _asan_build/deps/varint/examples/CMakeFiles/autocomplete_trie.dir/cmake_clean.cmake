@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/autocomplete_trie.dir/advanced/autocomplete_trie.c.o"
+  "CMakeFiles/autocomplete_trie.dir/advanced/autocomplete_trie.c.o.d"
+  "autocomplete_trie"
+  "autocomplete_trie.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/autocomplete_trie.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
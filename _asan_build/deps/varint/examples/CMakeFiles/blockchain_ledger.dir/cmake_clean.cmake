@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/blockchain_ledger.dir/advanced/blockchain_ledger.c.o"
+  "CMakeFiles/blockchain_ledger.dir/advanced/blockchain_ledger.c.o.d"
+  "blockchain_ledger"
+  "blockchain_ledger.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/blockchain_ledger.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
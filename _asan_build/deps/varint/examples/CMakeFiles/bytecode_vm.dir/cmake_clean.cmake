@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bytecode_vm.dir/advanced/bytecode_vm.c.o"
+  "CMakeFiles/bytecode_vm.dir/advanced/bytecode_vm.c.o.d"
+  "bytecode_vm"
+  "bytecode_vm.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bytecode_vm.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
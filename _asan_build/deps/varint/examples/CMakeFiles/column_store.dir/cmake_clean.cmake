@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/column_store.dir/integration/column_store.c.o"
+  "CMakeFiles/column_store.dir/integration/column_store.c.o.d"
+  "column_store"
+  "column_store.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/column_store.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
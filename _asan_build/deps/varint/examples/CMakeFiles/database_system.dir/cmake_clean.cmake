@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/database_system.dir/integration/database_system.c.o"
+  "CMakeFiles/database_system.dir/integration/database_system.c.o.d"
+  "database_system"
+  "database_system.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/database_system.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
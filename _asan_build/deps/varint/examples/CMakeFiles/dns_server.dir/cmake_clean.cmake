@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/dns_server.dir/advanced/dns_server.c.o"
+  "CMakeFiles/dns_server.dir/advanced/dns_server.c.o.d"
+  "dns_server"
+  "dns_server.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/dns_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
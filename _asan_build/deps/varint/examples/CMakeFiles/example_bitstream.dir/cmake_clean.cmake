@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_bitstream.dir/standalone/example_bitstream.c.o"
+  "CMakeFiles/example_bitstream.dir/standalone/example_bitstream.c.o.d"
+  "example_bitstream"
+  "example_bitstream.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example_bitstream.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_chained.dir/standalone/example_chained.c.o"
+  "CMakeFiles/example_chained.dir/standalone/example_chained.c.o.d"
+  "example_chained"
+  "example_chained.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example_chained.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_dimension.dir/standalone/example_dimension.c.o"
+  "CMakeFiles/example_dimension.dir/standalone/example_dimension.c.o.d"
+  "example_dimension"
+  "example_dimension.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example_dimension.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_external.dir/standalone/example_external.c.o"
+  "CMakeFiles/example_external.dir/standalone/example_external.c.o.d"
+  "example_external"
+  "example_external.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example_external.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
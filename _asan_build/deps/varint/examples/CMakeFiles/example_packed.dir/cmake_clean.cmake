@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_packed.dir/standalone/example_packed.c.o"
+  "CMakeFiles/example_packed.dir/standalone/example_packed.c.o.d"
+  "example_packed"
+  "example_packed.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example_packed.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
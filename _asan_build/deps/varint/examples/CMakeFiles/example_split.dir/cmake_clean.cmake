@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_split.dir/standalone/example_split.c.o"
+  "CMakeFiles/example_split.dir/standalone/example_split.c.o.d"
+  "example_split"
+  "example_split.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example_split.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/example_tagged.dir/standalone/example_tagged.c.o"
+  "CMakeFiles/example_tagged.dir/standalone/example_tagged.c.o.d"
+  "example_tagged"
+  "example_tagged.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/example_tagged.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
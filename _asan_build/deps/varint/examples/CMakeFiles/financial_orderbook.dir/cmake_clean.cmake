@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/financial_orderbook.dir/advanced/financial_orderbook.c.o"
+  "CMakeFiles/financial_orderbook.dir/advanced/financial_orderbook.c.o.d"
+  "financial_orderbook"
+  "financial_orderbook.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/financial_orderbook.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/game_engine.dir/integration/game_engine.c.o"
+  "CMakeFiles/game_engine.dir/integration/game_engine.c.o.d"
+  "game_engine"
+  "game_engine.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/game_engine.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/game_replay_system.dir/advanced/game_replay_system.c.o"
+  "CMakeFiles/game_replay_system.dir/advanced/game_replay_system.c.o.d"
+  "game_replay_system"
+  "game_replay_system.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/game_replay_system.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/geospatial_routing.dir/advanced/geospatial_routing.c.o"
+  "CMakeFiles/geospatial_routing.dir/advanced/geospatial_routing.c.o.d"
+  "geospatial_routing"
+  "geospatial_routing.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/geospatial_routing.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/graph_database.dir/reference/graph_database.c.o"
+  "CMakeFiles/graph_database.dir/reference/graph_database.c.o.d"
+  "graph_database"
+  "graph_database.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/graph_database.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/inverted_index.dir/advanced/inverted_index.c.o"
+  "CMakeFiles/inverted_index.dir/advanced/inverted_index.c.o.d"
+  "inverted_index"
+  "inverted_index.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/inverted_index.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/kv_store.dir/reference/kv_store.c.o"
+  "CMakeFiles/kv_store.dir/reference/kv_store.c.o.d"
+  "kv_store"
+  "kv_store.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/kv_store.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ml_features.dir/integration/ml_features.c.o"
+  "CMakeFiles/ml_features.dir/integration/ml_features.c.o.d"
+  "ml_features"
+  "ml_features.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/ml_features.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pointcloud_octree.dir/advanced/pointcloud_octree.c.o"
+  "CMakeFiles/pointcloud_octree.dir/advanced/pointcloud_octree.c.o.d"
+  "pointcloud_octree"
+  "pointcloud_octree.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/pointcloud_octree.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
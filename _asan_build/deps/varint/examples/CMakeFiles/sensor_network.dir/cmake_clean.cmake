@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sensor_network.dir/integration/sensor_network.c.o"
+  "CMakeFiles/sensor_network.dir/integration/sensor_network.c.o.d"
+  "sensor_network"
+  "sensor_network.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/sensor_network.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
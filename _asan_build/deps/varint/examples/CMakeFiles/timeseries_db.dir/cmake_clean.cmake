@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/timeseries_db.dir/reference/timeseries_db.c.o"
+  "CMakeFiles/timeseries_db.dir/reference/timeseries_db.c.o.d"
+  "timeseries_db"
+  "timeseries_db.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/timeseries_db.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
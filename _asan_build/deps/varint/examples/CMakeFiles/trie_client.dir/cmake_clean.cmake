@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/trie_client.dir/advanced/trie_client.c.o"
+  "CMakeFiles/trie_client.dir/advanced/trie_client.c.o.d"
+  "trie_client"
+  "trie_client.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/trie_client.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
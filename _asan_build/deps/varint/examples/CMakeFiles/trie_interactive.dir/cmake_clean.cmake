@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/trie_interactive.dir/advanced/trie_interactive.c.o"
+  "CMakeFiles/trie_interactive.dir/advanced/trie_interactive.c.o.d"
+  "trie_interactive"
+  "trie_interactive.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/trie_interactive.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
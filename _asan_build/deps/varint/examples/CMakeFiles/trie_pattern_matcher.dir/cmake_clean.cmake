@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/trie_pattern_matcher.dir/advanced/trie_pattern_matcher.c.o"
+  "CMakeFiles/trie_pattern_matcher.dir/advanced/trie_pattern_matcher.c.o.d"
+  "trie_pattern_matcher"
+  "trie_pattern_matcher.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/trie_pattern_matcher.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/trie_server.dir/advanced/trie_server.c.o"
+  "CMakeFiles/trie_server.dir/advanced/trie_server.c.o.d"
+  "trie_server"
+  "trie_server.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/trie_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
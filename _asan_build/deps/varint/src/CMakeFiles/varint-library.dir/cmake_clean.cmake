@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libvarint.pdb"
+  "libvarint.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varint-library.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
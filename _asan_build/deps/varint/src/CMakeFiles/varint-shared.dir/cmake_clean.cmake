@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "varint.pdb"
+  "varint.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varint-shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
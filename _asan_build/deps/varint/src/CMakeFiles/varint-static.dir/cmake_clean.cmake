@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "varint.a"
+  "varint.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varint-static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/deps/varint/src/varintChained.c" "deps/varint/src/CMakeFiles/varint.dir/varintChained.c.o" "gcc" "deps/varint/src/CMakeFiles/varint.dir/varintChained.c.o.d"
+  "/root/repo/deps/varint/src/varintChainedSimple.c" "deps/varint/src/CMakeFiles/varint.dir/varintChainedSimple.c.o" "gcc" "deps/varint/src/CMakeFiles/varint.dir/varintChainedSimple.c.o.d"
+  "/root/repo/deps/varint/src/varintExternal.c" "deps/varint/src/CMakeFiles/varint.dir/varintExternal.c.o" "gcc" "deps/varint/src/CMakeFiles/varint.dir/varintExternal.c.o.d"
+  "/root/repo/deps/varint/src/varintExternalBigEndian.c" "deps/varint/src/CMakeFiles/varint.dir/varintExternalBigEndian.c.o" "gcc" "deps/varint/src/CMakeFiles/varint.dir/varintExternalBigEndian.c.o.d"
+  "/root/repo/deps/varint/src/varintTagged.c" "deps/varint/src/CMakeFiles/varint.dir/varintTagged.c.o" "gcc" "deps/varint/src/CMakeFiles/varint.dir/varintTagged.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
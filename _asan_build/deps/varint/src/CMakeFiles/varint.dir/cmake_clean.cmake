@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varint.dir/varintChained.c.o"
+  "CMakeFiles/varint.dir/varintChained.c.o.d"
+  "CMakeFiles/varint.dir/varintChainedSimple.c.o"
+  "CMakeFiles/varint.dir/varintChainedSimple.c.o.d"
+  "CMakeFiles/varint.dir/varintExternal.c.o"
+  "CMakeFiles/varint.dir/varintExternal.c.o.d"
+  "CMakeFiles/varint.dir/varintExternalBigEndian.c.o"
+  "CMakeFiles/varint.dir/varintExternalBigEndian.c.o.d"
+  "CMakeFiles/varint.dir/varintTagged.c.o"
+  "CMakeFiles/varint.dir/varintTagged.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varint.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/deps/varint/src/varintAdaptive.c" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintAdaptive.c.o" "gcc" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintAdaptive.c.o.d"
+  "/root/repo/deps/varint/src/varintAdaptiveTest.c" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintAdaptiveTest.c.o" "gcc" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintAdaptiveTest.c.o.d"
+  "/root/repo/deps/varint/src/varintBitmap.c" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintBitmap.c.o" "gcc" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintBitmap.c.o.d"
+  "/root/repo/deps/varint/src/varintDelta.c" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintDelta.c.o" "gcc" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintDelta.c.o.d"
+  "/root/repo/deps/varint/src/varintDict.c" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintDict.c.o" "gcc" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintDict.c.o.d"
+  "/root/repo/deps/varint/src/varintExternal.c" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintExternal.c.o" "gcc" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintExternal.c.o.d"
+  "/root/repo/deps/varint/src/varintFOR.c" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintFOR.c.o" "gcc" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintFOR.c.o.d"
+  "/root/repo/deps/varint/src/varintPFOR.c" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintPFOR.c.o" "gcc" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintPFOR.c.o.d"
+  "/root/repo/deps/varint/src/varintTagged.c" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintTagged.c.o" "gcc" "deps/varint/src/CMakeFiles/varintAdaptiveTest.dir/varintTagged.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
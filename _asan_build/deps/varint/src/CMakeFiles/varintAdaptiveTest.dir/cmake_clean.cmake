@@ -0,0 +1,27 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintAdaptiveTest.dir/varintAdaptive.c.o"
+  "CMakeFiles/varintAdaptiveTest.dir/varintAdaptive.c.o.d"
+  "CMakeFiles/varintAdaptiveTest.dir/varintAdaptiveTest.c.o"
+  "CMakeFiles/varintAdaptiveTest.dir/varintAdaptiveTest.c.o.d"
+  "CMakeFiles/varintAdaptiveTest.dir/varintBitmap.c.o"
+  "CMakeFiles/varintAdaptiveTest.dir/varintBitmap.c.o.d"
+  "CMakeFiles/varintAdaptiveTest.dir/varintDelta.c.o"
+  "CMakeFiles/varintAdaptiveTest.dir/varintDelta.c.o.d"
+  "CMakeFiles/varintAdaptiveTest.dir/varintDict.c.o"
+  "CMakeFiles/varintAdaptiveTest.dir/varintDict.c.o.d"
+  "CMakeFiles/varintAdaptiveTest.dir/varintExternal.c.o"
+  "CMakeFiles/varintAdaptiveTest.dir/varintExternal.c.o.d"
+  "CMakeFiles/varintAdaptiveTest.dir/varintFOR.c.o"
+  "CMakeFiles/varintAdaptiveTest.dir/varintFOR.c.o.d"
+  "CMakeFiles/varintAdaptiveTest.dir/varintPFOR.c.o"
+  "CMakeFiles/varintAdaptiveTest.dir/varintPFOR.c.o.d"
+  "CMakeFiles/varintAdaptiveTest.dir/varintTagged.c.o"
+  "CMakeFiles/varintAdaptiveTest.dir/varintTagged.c.o.d"
+  "varintAdaptiveTest"
+  "varintAdaptiveTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintAdaptiveTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintBP128Test.dir/varintBP128.c.o"
+  "CMakeFiles/varintBP128Test.dir/varintBP128.c.o.d"
+  "CMakeFiles/varintBP128Test.dir/varintBP128Test.c.o"
+  "CMakeFiles/varintBP128Test.dir/varintBP128Test.c.o.d"
+  "CMakeFiles/varintBP128Test.dir/varintTagged.c.o"
+  "CMakeFiles/varintBP128Test.dir/varintTagged.c.o.d"
+  "varintBP128Test"
+  "varintBP128Test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintBP128Test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
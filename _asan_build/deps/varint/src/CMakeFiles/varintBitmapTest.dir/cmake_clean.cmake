@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintBitmapTest.dir/varintBitmap.c.o"
+  "CMakeFiles/varintBitmapTest.dir/varintBitmap.c.o.d"
+  "CMakeFiles/varintBitmapTest.dir/varintBitmapTest.c.o"
+  "CMakeFiles/varintBitmapTest.dir/varintBitmapTest.c.o.d"
+  "CMakeFiles/varintBitmapTest.dir/varintExternal.c.o"
+  "CMakeFiles/varintBitmapTest.dir/varintExternal.c.o.d"
+  "varintBitmapTest"
+  "varintBitmapTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintBitmapTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
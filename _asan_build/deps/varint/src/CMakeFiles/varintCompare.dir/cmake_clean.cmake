@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintCompare.dir/varintCompare.c.o"
+  "CMakeFiles/varintCompare.dir/varintCompare.c.o.d"
+  "varintCompare"
+  "varintCompare.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintCompare.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintDeltaTest.dir/varintDelta.c.o"
+  "CMakeFiles/varintDeltaTest.dir/varintDelta.c.o.d"
+  "CMakeFiles/varintDeltaTest.dir/varintDeltaTest.c.o"
+  "CMakeFiles/varintDeltaTest.dir/varintDeltaTest.c.o.d"
+  "CMakeFiles/varintDeltaTest.dir/varintExternal.c.o"
+  "CMakeFiles/varintDeltaTest.dir/varintExternal.c.o.d"
+  "varintDeltaTest"
+  "varintDeltaTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintDeltaTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/deps/varint/src/varintDict.c" "deps/varint/src/CMakeFiles/varintDictTest.dir/varintDict.c.o" "gcc" "deps/varint/src/CMakeFiles/varintDictTest.dir/varintDict.c.o.d"
+  "/root/repo/deps/varint/src/varintDictTest.c" "deps/varint/src/CMakeFiles/varintDictTest.dir/varintDictTest.c.o" "gcc" "deps/varint/src/CMakeFiles/varintDictTest.dir/varintDictTest.c.o.d"
+  "/root/repo/deps/varint/src/varintExternal.c" "deps/varint/src/CMakeFiles/varintDictTest.dir/varintExternal.c.o" "gcc" "deps/varint/src/CMakeFiles/varintDictTest.dir/varintExternal.c.o.d"
+  "/root/repo/deps/varint/src/varintTagged.c" "deps/varint/src/CMakeFiles/varintDictTest.dir/varintTagged.c.o" "gcc" "deps/varint/src/CMakeFiles/varintDictTest.dir/varintTagged.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
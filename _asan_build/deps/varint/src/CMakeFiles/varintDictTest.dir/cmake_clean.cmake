@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintDictTest.dir/varintDict.c.o"
+  "CMakeFiles/varintDictTest.dir/varintDict.c.o.d"
+  "CMakeFiles/varintDictTest.dir/varintDictTest.c.o"
+  "CMakeFiles/varintDictTest.dir/varintDictTest.c.o.d"
+  "CMakeFiles/varintDictTest.dir/varintExternal.c.o"
+  "CMakeFiles/varintDictTest.dir/varintExternal.c.o.d"
+  "CMakeFiles/varintDictTest.dir/varintTagged.c.o"
+  "CMakeFiles/varintDictTest.dir/varintTagged.c.o.d"
+  "varintDictTest"
+  "varintDictTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintDictTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
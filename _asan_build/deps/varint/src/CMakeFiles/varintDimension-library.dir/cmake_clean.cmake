@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libvarintDimension.pdb"
+  "libvarintDimension.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintDimension-library.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
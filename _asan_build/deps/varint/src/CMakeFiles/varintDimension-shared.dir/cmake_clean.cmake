@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "varintDimension.pdb"
+  "varintDimension.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintDimension-shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
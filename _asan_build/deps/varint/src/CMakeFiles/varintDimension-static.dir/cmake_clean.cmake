@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "varintDimension.a"
+  "varintDimension.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintDimension-static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
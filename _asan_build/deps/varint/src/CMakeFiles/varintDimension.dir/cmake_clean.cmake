@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintDimension.dir/varintDimension.c.o"
+  "CMakeFiles/varintDimension.dir/varintDimension.c.o.d"
+  "CMakeFiles/varintDimension.dir/varintExternal.c.o"
+  "CMakeFiles/varintDimension.dir/varintExternal.c.o.d"
+  "CMakeFiles/varintDimension.dir/varintTagged.c.o"
+  "CMakeFiles/varintDimension.dir/varintTagged.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintDimension.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintDimensionTest.dir/varintDimensionTest.c.o"
+  "CMakeFiles/varintDimensionTest.dir/varintDimensionTest.c.o.d"
+  "varintDimensionTest"
+  "varintDimensionTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintDimensionTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
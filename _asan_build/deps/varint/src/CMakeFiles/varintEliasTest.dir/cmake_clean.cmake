@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintEliasTest.dir/varintElias.c.o"
+  "CMakeFiles/varintEliasTest.dir/varintElias.c.o.d"
+  "CMakeFiles/varintEliasTest.dir/varintEliasTest.c.o"
+  "CMakeFiles/varintEliasTest.dir/varintEliasTest.c.o.d"
+  "varintEliasTest"
+  "varintEliasTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintEliasTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
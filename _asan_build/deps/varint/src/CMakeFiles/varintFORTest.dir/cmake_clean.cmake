@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintFORTest.dir/varintExternal.c.o"
+  "CMakeFiles/varintFORTest.dir/varintExternal.c.o.d"
+  "CMakeFiles/varintFORTest.dir/varintFOR.c.o"
+  "CMakeFiles/varintFORTest.dir/varintFOR.c.o.d"
+  "CMakeFiles/varintFORTest.dir/varintFORTest.c.o"
+  "CMakeFiles/varintFORTest.dir/varintFORTest.c.o.d"
+  "CMakeFiles/varintFORTest.dir/varintTagged.c.o"
+  "CMakeFiles/varintFORTest.dir/varintTagged.c.o.d"
+  "varintFORTest"
+  "varintFORTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintFORTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
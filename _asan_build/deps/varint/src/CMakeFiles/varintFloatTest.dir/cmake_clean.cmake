@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintFloatTest.dir/varintExternal.c.o"
+  "CMakeFiles/varintFloatTest.dir/varintExternal.c.o.d"
+  "CMakeFiles/varintFloatTest.dir/varintFloat.c.o"
+  "CMakeFiles/varintFloatTest.dir/varintFloat.c.o.d"
+  "CMakeFiles/varintFloatTest.dir/varintFloatTest.c.o"
+  "CMakeFiles/varintFloatTest.dir/varintFloatTest.c.o.d"
+  "varintFloatTest"
+  "varintFloatTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintFloatTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintGroupTest.dir/varintExternal.c.o"
+  "CMakeFiles/varintGroupTest.dir/varintExternal.c.o.d"
+  "CMakeFiles/varintGroupTest.dir/varintGroup.c.o"
+  "CMakeFiles/varintGroupTest.dir/varintGroup.c.o.d"
+  "CMakeFiles/varintGroupTest.dir/varintGroupTest.c.o"
+  "CMakeFiles/varintGroupTest.dir/varintGroupTest.c.o.d"
+  "varintGroupTest"
+  "varintGroupTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintGroupTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintPFORTest.dir/varintExternal.c.o"
+  "CMakeFiles/varintPFORTest.dir/varintExternal.c.o.d"
+  "CMakeFiles/varintPFORTest.dir/varintFOR.c.o"
+  "CMakeFiles/varintPFORTest.dir/varintFOR.c.o.d"
+  "CMakeFiles/varintPFORTest.dir/varintPFOR.c.o"
+  "CMakeFiles/varintPFORTest.dir/varintPFOR.c.o.d"
+  "CMakeFiles/varintPFORTest.dir/varintPFORTest.c.o"
+  "CMakeFiles/varintPFORTest.dir/varintPFORTest.c.o.d"
+  "CMakeFiles/varintPFORTest.dir/varintTagged.c.o"
+  "CMakeFiles/varintPFORTest.dir/varintTagged.c.o.d"
+  "varintPFORTest"
+  "varintPFORTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintPFORTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintPackedTest.dir/varintPackedTest.c.o"
+  "CMakeFiles/varintPackedTest.dir/varintPackedTest.c.o.d"
+  "varintPackedTest"
+  "varintPackedTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintPackedTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
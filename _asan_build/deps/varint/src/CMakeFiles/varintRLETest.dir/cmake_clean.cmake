@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/varintRLETest.dir/varintExternal.c.o"
+  "CMakeFiles/varintRLETest.dir/varintExternal.c.o.d"
+  "CMakeFiles/varintRLETest.dir/varintRLE.c.o"
+  "CMakeFiles/varintRLETest.dir/varintRLE.c.o.d"
+  "CMakeFiles/varintRLETest.dir/varintRLETest.c.o"
+  "CMakeFiles/varintRLETest.dir/varintRLETest.c.o.d"
+  "CMakeFiles/varintRLETest.dir/varintTagged.c.o"
+  "CMakeFiles/varintRLETest.dir/varintTagged.c.o.d"
+  "varintRLETest"
+  "varintRLETest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/varintRLETest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,32 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/deps/varint/src
+# Build directory: /root/repo/_asan_build/deps/varint/src
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(varint-packed "/root/repo/_asan_build/deps/varint/src/varintPackedTest" "1")
+set_tests_properties(varint-packed PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;160;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
+add_test(varint-dimension "/root/repo/_asan_build/deps/varint/src/varintDimensionTest")
+set_tests_properties(varint-dimension PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;161;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
+add_test(varint-delta "/root/repo/_asan_build/deps/varint/src/varintDeltaTest")
+set_tests_properties(varint-delta PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;162;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
+add_test(varint-for "/root/repo/_asan_build/deps/varint/src/varintFORTest")
+set_tests_properties(varint-for PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;163;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
+add_test(varint-pfor "/root/repo/_asan_build/deps/varint/src/varintPFORTest")
+set_tests_properties(varint-pfor PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;164;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
+add_test(varint-group "/root/repo/_asan_build/deps/varint/src/varintGroupTest")
+set_tests_properties(varint-group PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;165;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
+add_test(varint-dict "/root/repo/_asan_build/deps/varint/src/varintDictTest")
+set_tests_properties(varint-dict PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;166;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
+add_test(varint-adaptive "/root/repo/_asan_build/deps/varint/src/varintAdaptiveTest")
+set_tests_properties(varint-adaptive PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;167;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
+add_test(varint-float "/root/repo/_asan_build/deps/varint/src/varintFloatTest")
+set_tests_properties(varint-float PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;168;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
+add_test(varint-bitmap "/root/repo/_asan_build/deps/varint/src/varintBitmapTest")
+set_tests_properties(varint-bitmap PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;169;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
+add_test(varint-rle "/root/repo/_asan_build/deps/varint/src/varintRLETest")
+set_tests_properties(varint-rle PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;170;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
+add_test(varint-elias "/root/repo/_asan_build/deps/varint/src/varintEliasTest")
+set_tests_properties(varint-elias PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;171;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
+add_test(varint-bp128 "/root/repo/_asan_build/deps/varint/src/varintBP128Test")
+set_tests_properties(varint-bp128 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/deps/varint/src/CMakeLists.txt;172;add_test;/root/repo/deps/varint/src/CMakeLists.txt;0;")
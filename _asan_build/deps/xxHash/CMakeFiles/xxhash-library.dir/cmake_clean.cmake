@@ -0,0 +1,10 @@
+file(REMOVE_RECURSE
+  "libxxhash.pdb"
+  "libxxhash.so"
+  "libxxhash.so.3.6"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/xxhash-library.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
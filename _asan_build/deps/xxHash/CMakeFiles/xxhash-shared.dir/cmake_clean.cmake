@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "xxhash.pdb"
+  "xxhash.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/xxhash-shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
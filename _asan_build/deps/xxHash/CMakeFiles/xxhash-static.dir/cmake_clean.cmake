@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libxxhash.a"
+  "libxxhash.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/xxhash-static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/xxhash.dir/xxhash.c.o"
+  "CMakeFiles/xxhash.dir/xxhash.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/xxhash.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
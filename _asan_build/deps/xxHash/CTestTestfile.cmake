@@ -0,0 +1,6 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/deps/xxHash
+# Build directory: /root/repo/_asan_build/deps/xxHash
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
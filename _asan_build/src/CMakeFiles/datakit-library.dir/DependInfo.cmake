@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/deps/varint/src/varintBP128.c" "src/CMakeFiles/datakit-library.dir/__/deps/varint/src/varintBP128.c.o" "gcc" "src/CMakeFiles/datakit-library.dir/__/deps/varint/src/varintBP128.c.o.d"
+  "/root/repo/deps/varint/src/varintDelta.c" "src/CMakeFiles/datakit-library.dir/__/deps/varint/src/varintDelta.c.o" "gcc" "src/CMakeFiles/datakit-library.dir/__/deps/varint/src/varintDelta.c.o.d"
+  "/root/repo/deps/varint/src/varintFloat.c" "src/CMakeFiles/datakit-library.dir/__/deps/varint/src/varintFloat.c.o" "gcc" "src/CMakeFiles/datakit-library.dir/__/deps/varint/src/varintFloat.c.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_asan_build/src/libdatakit.so" "/root/repo/_asan_build/src/libdatakit.so.0.3.0"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
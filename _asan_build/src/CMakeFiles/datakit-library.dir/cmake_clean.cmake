@@ -0,0 +1,16 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/datakit-library.dir/__/deps/varint/src/varintBP128.c.o"
+  "CMakeFiles/datakit-library.dir/__/deps/varint/src/varintBP128.c.o.d"
+  "CMakeFiles/datakit-library.dir/__/deps/varint/src/varintDelta.c.o"
+  "CMakeFiles/datakit-library.dir/__/deps/varint/src/varintDelta.c.o.d"
+  "CMakeFiles/datakit-library.dir/__/deps/varint/src/varintFloat.c.o"
+  "CMakeFiles/datakit-library.dir/__/deps/varint/src/varintFloat.c.o.d"
+  "libdatakit.pdb"
+  "libdatakit.so"
+  "libdatakit.so.0.3.0"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/datakit-library.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/datakit-quickcheck"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/datakit-quickcheck.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
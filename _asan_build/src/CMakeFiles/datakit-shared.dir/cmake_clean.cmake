@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/datakit-shared.dir/__/deps/varint/src/varintBP128.c.o"
+  "CMakeFiles/datakit-shared.dir/__/deps/varint/src/varintBP128.c.o.d"
+  "CMakeFiles/datakit-shared.dir/__/deps/varint/src/varintDelta.c.o"
+  "CMakeFiles/datakit-shared.dir/__/deps/varint/src/varintDelta.c.o.d"
+  "CMakeFiles/datakit-shared.dir/__/deps/varint/src/varintFloat.c.o"
+  "CMakeFiles/datakit-shared.dir/__/deps/varint/src/varintFloat.c.o.d"
+  "datakit.pdb"
+  "datakit.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/datakit-shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/datakit-static.dir/__/deps/varint/src/varintBP128.c.o"
+  "CMakeFiles/datakit-static.dir/__/deps/varint/src/varintBP128.c.o.d"
+  "CMakeFiles/datakit-static.dir/__/deps/varint/src/varintDelta.c.o"
+  "CMakeFiles/datakit-static.dir/__/deps/varint/src/varintDelta.c.o.d"
+  "CMakeFiles/datakit-static.dir/__/deps/varint/src/varintFloat.c.o"
+  "CMakeFiles/datakit-static.dir/__/deps/varint/src/varintFloat.c.o.d"
+  "datakit.a"
+  "datakit.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/datakit-static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
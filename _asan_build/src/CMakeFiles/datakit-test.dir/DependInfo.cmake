@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/datakit-test.c" "src/CMakeFiles/datakit-test.dir/datakit-test.c.o" "gcc" "src/CMakeFiles/datakit-test.dir/datakit-test.c.o.d"
+  "/root/repo/src/fenwick/fenwickI64Test.c" "src/CMakeFiles/datakit-test.dir/fenwick/fenwickI64Test.c.o" "gcc" "src/CMakeFiles/datakit-test.dir/fenwick/fenwickI64Test.c.o.d"
+  "/root/repo/src/segment/segmentI64Test.c" "src/CMakeFiles/datakit-test.dir/segment/segmentI64Test.c.o" "gcc" "src/CMakeFiles/datakit-test.dir/segment/segmentI64Test.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_asan_build/src/CMakeFiles/datakit-static.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/datakit-test.dir/datakit-test.c.o"
+  "CMakeFiles/datakit-test.dir/datakit-test.c.o.d"
+  "CMakeFiles/datakit-test.dir/fenwick/fenwickI64Test.c.o"
+  "CMakeFiles/datakit-test.dir/fenwick/fenwickI64Test.c.o.d"
+  "CMakeFiles/datakit-test.dir/segment/segmentI64Test.c.o"
+  "CMakeFiles/datakit-test.dir/segment/segmentI64Test.c.o.d"
+  "datakit-test"
+  "datakit-test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/datakit-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
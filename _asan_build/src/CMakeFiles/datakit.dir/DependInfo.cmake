@@ -0,0 +1,163 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/OSRegulate.c" "src/CMakeFiles/datakit.dir/OSRegulate.c.o" "gcc" "src/CMakeFiles/datakit.dir/OSRegulate.c.o.d"
+  "/root/repo/src/atomPool.c" "src/CMakeFiles/datakit.dir/atomPool.c.o" "gcc" "src/CMakeFiles/datakit.dir/atomPool.c.o.d"
+  "/root/repo/src/bbits.c" "src/CMakeFiles/datakit.dir/bbits.c.o" "gcc" "src/CMakeFiles/datakit.dir/bbits.c.o.d"
+  "/root/repo/src/bigmath-imath.c" "src/CMakeFiles/datakit.dir/bigmath-imath.c.o" "gcc" "src/CMakeFiles/datakit.dir/bigmath-imath.c.o.d"
+  "/root/repo/src/binaryFuse.c" "src/CMakeFiles/datakit.dir/binaryFuse.c.o" "gcc" "src/CMakeFiles/datakit.dir/binaryFuse.c.o.d"
+  "/root/repo/src/clusterRing.c" "src/CMakeFiles/datakit.dir/clusterRing.c.o" "gcc" "src/CMakeFiles/datakit.dir/clusterRing.c.o.d"
+  "/root/repo/src/compressionBench.c" "src/CMakeFiles/datakit.dir/compressionBench.c.o" "gcc" "src/CMakeFiles/datakit.dir/compressionBench.c.o.d"
+  "/root/repo/src/databox.c" "src/CMakeFiles/datakit.dir/databox.c.o" "gcc" "src/CMakeFiles/datakit.dir/databox.c.o.d"
+  "/root/repo/src/databoxLinear.c" "src/CMakeFiles/datakit.dir/databoxLinear.c.o" "gcc" "src/CMakeFiles/datakit.dir/databoxLinear.c.o.d"
+  "/root/repo/src/datakit.c" "src/CMakeFiles/datakit.dir/datakit.c.o" "gcc" "src/CMakeFiles/datakit.dir/datakit.c.o.d"
+  "/root/repo/src/dataspeed.c" "src/CMakeFiles/datakit.dir/dataspeed.c.o" "gcc" "src/CMakeFiles/datakit.dir/dataspeed.c.o.d"
+  "/root/repo/src/dj.c" "src/CMakeFiles/datakit.dir/dj.c.o" "gcc" "src/CMakeFiles/datakit.dir/dj.c.o.d"
+  "/root/repo/src/dod.c" "src/CMakeFiles/datakit.dir/dod.c.o" "gcc" "src/CMakeFiles/datakit.dir/dod.c.o.d"
+  "/root/repo/src/fastmutex.c" "src/CMakeFiles/datakit.dir/fastmutex.c.o" "gcc" "src/CMakeFiles/datakit.dir/fastmutex.c.o.d"
+  "/root/repo/src/fenwick/fenwickDouble.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickDouble.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickDouble.c.o.d"
+  "/root/repo/src/fenwick/fenwickDoubleFull.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickDoubleFull.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickDoubleFull.c.o.d"
+  "/root/repo/src/fenwick/fenwickDoubleSmall.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickDoubleSmall.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickDoubleSmall.c.o.d"
+  "/root/repo/src/fenwick/fenwickFloat.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickFloat.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickFloat.c.o.d"
+  "/root/repo/src/fenwick/fenwickFloatFull.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickFloatFull.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickFloatFull.c.o.d"
+  "/root/repo/src/fenwick/fenwickFloatSmall.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickFloatSmall.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickFloatSmall.c.o.d"
+  "/root/repo/src/fenwick/fenwickI128.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickI128.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickI128.c.o.d"
+  "/root/repo/src/fenwick/fenwickI128Full.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickI128Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickI128Full.c.o.d"
+  "/root/repo/src/fenwick/fenwickI128Small.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickI128Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickI128Small.c.o.d"
+  "/root/repo/src/fenwick/fenwickI16.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickI16.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickI16.c.o.d"
+  "/root/repo/src/fenwick/fenwickI16Full.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickI16Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickI16Full.c.o.d"
+  "/root/repo/src/fenwick/fenwickI16Small.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickI16Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickI16Small.c.o.d"
+  "/root/repo/src/fenwick/fenwickI32.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickI32.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickI32.c.o.d"
+  "/root/repo/src/fenwick/fenwickI32Full.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickI32Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickI32Full.c.o.d"
+  "/root/repo/src/fenwick/fenwickI32Small.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickI32Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickI32Small.c.o.d"
+  "/root/repo/src/fenwick/fenwickI64.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickI64.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickI64.c.o.d"
+  "/root/repo/src/fenwick/fenwickI64Full.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickI64Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickI64Full.c.o.d"
+  "/root/repo/src/fenwick/fenwickI64Small.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickI64Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickI64Small.c.o.d"
+  "/root/repo/src/fenwick/fenwickU128.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickU128.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickU128.c.o.d"
+  "/root/repo/src/fenwick/fenwickU128Full.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickU128Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickU128Full.c.o.d"
+  "/root/repo/src/fenwick/fenwickU128Small.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickU128Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickU128Small.c.o.d"
+  "/root/repo/src/fenwick/fenwickU16.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickU16.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickU16.c.o.d"
+  "/root/repo/src/fenwick/fenwickU16Full.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickU16Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickU16Full.c.o.d"
+  "/root/repo/src/fenwick/fenwickU16Small.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickU16Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickU16Small.c.o.d"
+  "/root/repo/src/fenwick/fenwickU32.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickU32.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickU32.c.o.d"
+  "/root/repo/src/fenwick/fenwickU32Full.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickU32Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickU32Full.c.o.d"
+  "/root/repo/src/fenwick/fenwickU32Small.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickU32Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickU32Small.c.o.d"
+  "/root/repo/src/fenwick/fenwickU64.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickU64.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickU64.c.o.d"
+  "/root/repo/src/fenwick/fenwickU64Full.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickU64Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickU64Full.c.o.d"
+  "/root/repo/src/fenwick/fenwickU64Small.c" "src/CMakeFiles/datakit.dir/fenwick/fenwickU64Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/fenwick/fenwickU64Small.c.o.d"
+  "/root/repo/src/fibbuf.c" "src/CMakeFiles/datakit.dir/fibbuf.c.o" "gcc" "src/CMakeFiles/datakit.dir/fibbuf.c.o.d"
+  "/root/repo/src/flex.c" "src/CMakeFiles/datakit.dir/flex.c.o" "gcc" "src/CMakeFiles/datakit.dir/flex.c.o.d"
+  "/root/repo/src/float16.c" "src/CMakeFiles/datakit.dir/float16.c.o" "gcc" "src/CMakeFiles/datakit.dir/float16.c.o.d"
+  "/root/repo/src/floatExtendedTest.c" "src/CMakeFiles/datakit.dir/floatExtendedTest.c.o" "gcc" "src/CMakeFiles/datakit.dir/floatExtendedTest.c.o.d"
+  "/root/repo/src/hyperloglog.c" "src/CMakeFiles/datakit.dir/hyperloglog.c.o" "gcc" "src/CMakeFiles/datakit.dir/hyperloglog.c.o.d"
+  "/root/repo/src/intersectInt.c" "src/CMakeFiles/datakit.dir/intersectInt.c.o" "gcc" "src/CMakeFiles/datakit.dir/intersectInt.c.o.d"
+  "/root/repo/src/intset.c" "src/CMakeFiles/datakit.dir/intset.c.o" "gcc" "src/CMakeFiles/datakit.dir/intset.c.o.d"
+  "/root/repo/src/intsetBig.c" "src/CMakeFiles/datakit.dir/intsetBig.c.o" "gcc" "src/CMakeFiles/datakit.dir/intsetBig.c.o.d"
+  "/root/repo/src/intsetFull.c" "src/CMakeFiles/datakit.dir/intsetFull.c.o" "gcc" "src/CMakeFiles/datakit.dir/intsetFull.c.o.d"
+  "/root/repo/src/intsetMedium.c" "src/CMakeFiles/datakit.dir/intsetMedium.c.o" "gcc" "src/CMakeFiles/datakit.dir/intsetMedium.c.o.d"
+  "/root/repo/src/intsetSmall.c" "src/CMakeFiles/datakit.dir/intsetSmall.c.o" "gcc" "src/CMakeFiles/datakit.dir/intsetSmall.c.o.d"
+  "/root/repo/src/intsetTest.c" "src/CMakeFiles/datakit.dir/intsetTest.c.o" "gcc" "src/CMakeFiles/datakit.dir/intsetTest.c.o.d"
+  "/root/repo/src/intsetU32.c" "src/CMakeFiles/datakit.dir/intsetU32.c.o" "gcc" "src/CMakeFiles/datakit.dir/intsetU32.c.o.d"
+  "/root/repo/src/jebuf.c" "src/CMakeFiles/datakit.dir/jebuf.c.o" "gcc" "src/CMakeFiles/datakit.dir/jebuf.c.o.d"
+  "/root/repo/src/linearBloomTest.c" "src/CMakeFiles/datakit.dir/linearBloomTest.c.o" "gcc" "src/CMakeFiles/datakit.dir/linearBloomTest.c.o.d"
+  "/root/repo/src/mds.c" "src/CMakeFiles/datakit.dir/mds.c.o" "gcc" "src/CMakeFiles/datakit.dir/mds.c.o.d"
+  "/root/repo/src/mdsc.c" "src/CMakeFiles/datakit.dir/mdsc.c.o" "gcc" "src/CMakeFiles/datakit.dir/mdsc.c.o.d"
+  "/root/repo/src/membound.c" "src/CMakeFiles/datakit.dir/membound.c.o" "gcc" "src/CMakeFiles/datakit.dir/membound.c.o.d"
+  "/root/repo/src/memtest.c" "src/CMakeFiles/datakit.dir/memtest.c.o" "gcc" "src/CMakeFiles/datakit.dir/memtest.c.o.d"
+  "/root/repo/src/mflex.c" "src/CMakeFiles/datakit.dir/mflex.c.o" "gcc" "src/CMakeFiles/datakit.dir/mflex.c.o.d"
+  "/root/repo/src/multiFenwick.c" "src/CMakeFiles/datakit.dir/multiFenwick.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiFenwick.c.o.d"
+  "/root/repo/src/multiFenwickTest.c" "src/CMakeFiles/datakit.dir/multiFenwickTest.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiFenwickTest.c.o.d"
+  "/root/repo/src/multiOrderedSet.c" "src/CMakeFiles/datakit.dir/multiOrderedSet.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiOrderedSet.c.o.d"
+  "/root/repo/src/multiOrderedSetFull.c" "src/CMakeFiles/datakit.dir/multiOrderedSetFull.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiOrderedSetFull.c.o.d"
+  "/root/repo/src/multiOrderedSetMedium.c" "src/CMakeFiles/datakit.dir/multiOrderedSetMedium.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiOrderedSetMedium.c.o.d"
+  "/root/repo/src/multiOrderedSetSmall.c" "src/CMakeFiles/datakit.dir/multiOrderedSetSmall.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiOrderedSetSmall.c.o.d"
+  "/root/repo/src/multiTimer.c" "src/CMakeFiles/datakit.dir/multiTimer.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiTimer.c.o.d"
+  "/root/repo/src/multiTimerTest.c" "src/CMakeFiles/datakit.dir/multiTimerTest.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiTimerTest.c.o.d"
+  "/root/repo/src/multiarray.c" "src/CMakeFiles/datakit.dir/multiarray.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiarray.c.o.d"
+  "/root/repo/src/multiarrayLarge.c" "src/CMakeFiles/datakit.dir/multiarrayLarge.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiarrayLarge.c.o.d"
+  "/root/repo/src/multiarrayMedium.c" "src/CMakeFiles/datakit.dir/multiarrayMedium.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiarrayMedium.c.o.d"
+  "/root/repo/src/multiarraySmall.c" "src/CMakeFiles/datakit.dir/multiarraySmall.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiarraySmall.c.o.d"
+  "/root/repo/src/multidict.c" "src/CMakeFiles/datakit.dir/multidict.c.o" "gcc" "src/CMakeFiles/datakit.dir/multidict.c.o.d"
+  "/root/repo/src/multilist.c" "src/CMakeFiles/datakit.dir/multilist.c.o" "gcc" "src/CMakeFiles/datakit.dir/multilist.c.o.d"
+  "/root/repo/src/multilistFull.c" "src/CMakeFiles/datakit.dir/multilistFull.c.o" "gcc" "src/CMakeFiles/datakit.dir/multilistFull.c.o.d"
+  "/root/repo/src/multilistMedium.c" "src/CMakeFiles/datakit.dir/multilistMedium.c.o" "gcc" "src/CMakeFiles/datakit.dir/multilistMedium.c.o.d"
+  "/root/repo/src/multilistQueue.c" "src/CMakeFiles/datakit.dir/multilistQueue.c.o" "gcc" "src/CMakeFiles/datakit.dir/multilistQueue.c.o.d"
+  "/root/repo/src/multilistSmall.c" "src/CMakeFiles/datakit.dir/multilistSmall.c.o" "gcc" "src/CMakeFiles/datakit.dir/multilistSmall.c.o.d"
+  "/root/repo/src/multilru.c" "src/CMakeFiles/datakit.dir/multilru.c.o" "gcc" "src/CMakeFiles/datakit.dir/multilru.c.o.d"
+  "/root/repo/src/multilruSim.c" "src/CMakeFiles/datakit.dir/multilruSim.c.o" "gcc" "src/CMakeFiles/datakit.dir/multilruSim.c.o.d"
+  "/root/repo/src/multimap.c" "src/CMakeFiles/datakit.dir/multimap.c.o" "gcc" "src/CMakeFiles/datakit.dir/multimap.c.o.d"
+  "/root/repo/src/multimapAtom.c" "src/CMakeFiles/datakit.dir/multimapAtom.c.o" "gcc" "src/CMakeFiles/datakit.dir/multimapAtom.c.o.d"
+  "/root/repo/src/multimapFull.c" "src/CMakeFiles/datakit.dir/multimapFull.c.o" "gcc" "src/CMakeFiles/datakit.dir/multimapFull.c.o.d"
+  "/root/repo/src/multimapMedium.c" "src/CMakeFiles/datakit.dir/multimapMedium.c.o" "gcc" "src/CMakeFiles/datakit.dir/multimapMedium.c.o.d"
+  "/root/repo/src/multimapSmall.c" "src/CMakeFiles/datakit.dir/multimapSmall.c.o" "gcc" "src/CMakeFiles/datakit.dir/multimapSmall.c.o.d"
+  "/root/repo/src/multiroar.c" "src/CMakeFiles/datakit.dir/multiroar.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiroar.c.o.d"
+  "/root/repo/src/multiroarBsi.c" "src/CMakeFiles/datakit.dir/multiroarBsi.c.o" "gcc" "src/CMakeFiles/datakit.dir/multiroarBsi.c.o.d"
+  "/root/repo/src/offsetArray.c" "src/CMakeFiles/datakit.dir/offsetArray.c.o" "gcc" "src/CMakeFiles/datakit.dir/offsetArray.c.o.d"
+  "/root/repo/src/persist.c" "src/CMakeFiles/datakit.dir/persist.c.o" "gcc" "src/CMakeFiles/datakit.dir/persist.c.o.d"
+  "/root/repo/src/persist/flexP.c" "src/CMakeFiles/datakit.dir/persist/flexP.c.o" "gcc" "src/CMakeFiles/datakit.dir/persist/flexP.c.o.d"
+  "/root/repo/src/persist/intsetP.c" "src/CMakeFiles/datakit.dir/persist/intsetP.c.o" "gcc" "src/CMakeFiles/datakit.dir/persist/intsetP.c.o.d"
+  "/root/repo/src/persist/multiOrderedSetP.c" "src/CMakeFiles/datakit.dir/persist/multiOrderedSetP.c.o" "gcc" "src/CMakeFiles/datakit.dir/persist/multiOrderedSetP.c.o.d"
+  "/root/repo/src/persist/multidictP.c" "src/CMakeFiles/datakit.dir/persist/multidictP.c.o" "gcc" "src/CMakeFiles/datakit.dir/persist/multidictP.c.o.d"
+  "/root/repo/src/persist/multilistP.c" "src/CMakeFiles/datakit.dir/persist/multilistP.c.o" "gcc" "src/CMakeFiles/datakit.dir/persist/multilistP.c.o.d"
+  "/root/repo/src/persist/multilruP.c" "src/CMakeFiles/datakit.dir/persist/multilruP.c.o" "gcc" "src/CMakeFiles/datakit.dir/persist/multilruP.c.o.d"
+  "/root/repo/src/persist/multimapP.c" "src/CMakeFiles/datakit.dir/persist/multimapP.c.o" "gcc" "src/CMakeFiles/datakit.dir/persist/multimapP.c.o.d"
+  "/root/repo/src/persist/multiroarP.c" "src/CMakeFiles/datakit.dir/persist/multiroarP.c.o" "gcc" "src/CMakeFiles/datakit.dir/persist/multiroarP.c.o.d"
+  "/root/repo/src/persist/persistCtx.c" "src/CMakeFiles/datakit.dir/persist/persistCtx.c.o" "gcc" "src/CMakeFiles/datakit.dir/persist/persistCtx.c.o.d"
+  "/root/repo/src/portableRandom.c" "src/CMakeFiles/datakit.dir/portableRandom.c.o" "gcc" "src/CMakeFiles/datakit.dir/portableRandom.c.o.d"
+  "/root/repo/src/ptrPrevNext.c" "src/CMakeFiles/datakit.dir/ptrPrevNext.c.o" "gcc" "src/CMakeFiles/datakit.dir/ptrPrevNext.c.o.d"
+  "/root/repo/src/segment/segmentDouble.c" "src/CMakeFiles/datakit.dir/segment/segmentDouble.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentDouble.c.o.d"
+  "/root/repo/src/segment/segmentDoubleFull.c" "src/CMakeFiles/datakit.dir/segment/segmentDoubleFull.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentDoubleFull.c.o.d"
+  "/root/repo/src/segment/segmentDoubleSmall.c" "src/CMakeFiles/datakit.dir/segment/segmentDoubleSmall.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentDoubleSmall.c.o.d"
+  "/root/repo/src/segment/segmentFloat.c" "src/CMakeFiles/datakit.dir/segment/segmentFloat.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentFloat.c.o.d"
+  "/root/repo/src/segment/segmentFloatFull.c" "src/CMakeFiles/datakit.dir/segment/segmentFloatFull.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentFloatFull.c.o.d"
+  "/root/repo/src/segment/segmentFloatSmall.c" "src/CMakeFiles/datakit.dir/segment/segmentFloatSmall.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentFloatSmall.c.o.d"
+  "/root/repo/src/segment/segmentI128.c" "src/CMakeFiles/datakit.dir/segment/segmentI128.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentI128.c.o.d"
+  "/root/repo/src/segment/segmentI128Full.c" "src/CMakeFiles/datakit.dir/segment/segmentI128Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentI128Full.c.o.d"
+  "/root/repo/src/segment/segmentI128Small.c" "src/CMakeFiles/datakit.dir/segment/segmentI128Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentI128Small.c.o.d"
+  "/root/repo/src/segment/segmentI16.c" "src/CMakeFiles/datakit.dir/segment/segmentI16.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentI16.c.o.d"
+  "/root/repo/src/segment/segmentI16Full.c" "src/CMakeFiles/datakit.dir/segment/segmentI16Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentI16Full.c.o.d"
+  "/root/repo/src/segment/segmentI16Small.c" "src/CMakeFiles/datakit.dir/segment/segmentI16Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentI16Small.c.o.d"
+  "/root/repo/src/segment/segmentI32.c" "src/CMakeFiles/datakit.dir/segment/segmentI32.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentI32.c.o.d"
+  "/root/repo/src/segment/segmentI32Full.c" "src/CMakeFiles/datakit.dir/segment/segmentI32Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentI32Full.c.o.d"
+  "/root/repo/src/segment/segmentI32Small.c" "src/CMakeFiles/datakit.dir/segment/segmentI32Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentI32Small.c.o.d"
+  "/root/repo/src/segment/segmentI64.c" "src/CMakeFiles/datakit.dir/segment/segmentI64.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentI64.c.o.d"
+  "/root/repo/src/segment/segmentI64Full.c" "src/CMakeFiles/datakit.dir/segment/segmentI64Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentI64Full.c.o.d"
+  "/root/repo/src/segment/segmentI64Small.c" "src/CMakeFiles/datakit.dir/segment/segmentI64Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentI64Small.c.o.d"
+  "/root/repo/src/segment/segmentU128.c" "src/CMakeFiles/datakit.dir/segment/segmentU128.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentU128.c.o.d"
+  "/root/repo/src/segment/segmentU128Full.c" "src/CMakeFiles/datakit.dir/segment/segmentU128Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentU128Full.c.o.d"
+  "/root/repo/src/segment/segmentU128Small.c" "src/CMakeFiles/datakit.dir/segment/segmentU128Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentU128Small.c.o.d"
+  "/root/repo/src/segment/segmentU16.c" "src/CMakeFiles/datakit.dir/segment/segmentU16.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentU16.c.o.d"
+  "/root/repo/src/segment/segmentU16Full.c" "src/CMakeFiles/datakit.dir/segment/segmentU16Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentU16Full.c.o.d"
+  "/root/repo/src/segment/segmentU16Small.c" "src/CMakeFiles/datakit.dir/segment/segmentU16Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentU16Small.c.o.d"
+  "/root/repo/src/segment/segmentU32.c" "src/CMakeFiles/datakit.dir/segment/segmentU32.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentU32.c.o.d"
+  "/root/repo/src/segment/segmentU32Full.c" "src/CMakeFiles/datakit.dir/segment/segmentU32Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentU32Full.c.o.d"
+  "/root/repo/src/segment/segmentU32Small.c" "src/CMakeFiles/datakit.dir/segment/segmentU32Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentU32Small.c.o.d"
+  "/root/repo/src/segment/segmentU64.c" "src/CMakeFiles/datakit.dir/segment/segmentU64.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentU64.c.o.d"
+  "/root/repo/src/segment/segmentU64Full.c" "src/CMakeFiles/datakit.dir/segment/segmentU64Full.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentU64Full.c.o.d"
+  "/root/repo/src/segment/segmentU64Small.c" "src/CMakeFiles/datakit.dir/segment/segmentU64Small.c.o" "gcc" "src/CMakeFiles/datakit.dir/segment/segmentU64Small.c.o.d"
+  "/root/repo/src/setproctitle.c" "src/CMakeFiles/datakit.dir/setproctitle.c.o" "gcc" "src/CMakeFiles/datakit.dir/setproctitle.c.o.d"
+  "/root/repo/src/str.c" "src/CMakeFiles/datakit.dir/str.c.o" "gcc" "src/CMakeFiles/datakit.dir/str.c.o.d"
+  "/root/repo/src/strDoubleFormat.c" "src/CMakeFiles/datakit.dir/strDoubleFormat.c.o" "gcc" "src/CMakeFiles/datakit.dir/strDoubleFormat.c.o.d"
+  "/root/repo/src/stringPool.c" "src/CMakeFiles/datakit.dir/stringPool.c.o" "gcc" "src/CMakeFiles/datakit.dir/stringPool.c.o.d"
+  "/root/repo/src/timeUtil.c" "src/CMakeFiles/datakit.dir/timeUtil.c.o" "gcc" "src/CMakeFiles/datakit.dir/timeUtil.c.o.d"
+  "/root/repo/src/timerWheel.c" "src/CMakeFiles/datakit.dir/timerWheel.c.o" "gcc" "src/CMakeFiles/datakit.dir/timerWheel.c.o.d"
+  "/root/repo/src/timerWheelTest.c" "src/CMakeFiles/datakit.dir/timerWheelTest.c.o" "gcc" "src/CMakeFiles/datakit.dir/timerWheelTest.c.o.d"
+  "/root/repo/src/ulid.c" "src/CMakeFiles/datakit.dir/ulid.c.o" "gcc" "src/CMakeFiles/datakit.dir/ulid.c.o.d"
+  "/root/repo/src/util.c" "src/CMakeFiles/datakit.dir/util.c.o" "gcc" "src/CMakeFiles/datakit.dir/util.c.o.d"
+  "/root/repo/src/versionOSRuntime.c" "src/CMakeFiles/datakit.dir/versionOSRuntime.c.o" "gcc" "src/CMakeFiles/datakit.dir/versionOSRuntime.c.o.d"
+  "/root/repo/src/xof.c" "src/CMakeFiles/datakit.dir/xof.c.o" "gcc" "src/CMakeFiles/datakit.dir/xof.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,297 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/datakit.dir/OSRegulate.c.o"
+  "CMakeFiles/datakit.dir/OSRegulate.c.o.d"
+  "CMakeFiles/datakit.dir/atomPool.c.o"
+  "CMakeFiles/datakit.dir/atomPool.c.o.d"
+  "CMakeFiles/datakit.dir/bbits.c.o"
+  "CMakeFiles/datakit.dir/bbits.c.o.d"
+  "CMakeFiles/datakit.dir/bigmath-imath.c.o"
+  "CMakeFiles/datakit.dir/bigmath-imath.c.o.d"
+  "CMakeFiles/datakit.dir/binaryFuse.c.o"
+  "CMakeFiles/datakit.dir/binaryFuse.c.o.d"
+  "CMakeFiles/datakit.dir/clusterRing.c.o"
+  "CMakeFiles/datakit.dir/clusterRing.c.o.d"
+  "CMakeFiles/datakit.dir/compressionBench.c.o"
+  "CMakeFiles/datakit.dir/compressionBench.c.o.d"
+  "CMakeFiles/datakit.dir/databox.c.o"
+  "CMakeFiles/datakit.dir/databox.c.o.d"
+  "CMakeFiles/datakit.dir/databoxLinear.c.o"
+  "CMakeFiles/datakit.dir/databoxLinear.c.o.d"
+  "CMakeFiles/datakit.dir/datakit.c.o"
+  "CMakeFiles/datakit.dir/datakit.c.o.d"
+  "CMakeFiles/datakit.dir/dataspeed.c.o"
+  "CMakeFiles/datakit.dir/dataspeed.c.o.d"
+  "CMakeFiles/datakit.dir/dj.c.o"
+  "CMakeFiles/datakit.dir/dj.c.o.d"
+  "CMakeFiles/datakit.dir/dod.c.o"
+  "CMakeFiles/datakit.dir/dod.c.o.d"
+  "CMakeFiles/datakit.dir/fastmutex.c.o"
+  "CMakeFiles/datakit.dir/fastmutex.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickDouble.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickDouble.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickDoubleFull.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickDoubleFull.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickDoubleSmall.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickDoubleSmall.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickFloat.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickFloat.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickFloatFull.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickFloatFull.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickFloatSmall.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickFloatSmall.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI128.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI128.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI128Full.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI128Full.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI128Small.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI128Small.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI16.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI16.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI16Full.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI16Full.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI16Small.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI16Small.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI32.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI32.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI32Full.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI32Full.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI32Small.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI32Small.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI64.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI64.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI64Full.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI64Full.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI64Small.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickI64Small.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU128.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU128.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU128Full.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU128Full.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU128Small.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU128Small.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU16.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU16.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU16Full.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU16Full.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU16Small.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU16Small.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU32.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU32.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU32Full.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU32Full.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU32Small.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU32Small.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU64.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU64.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU64Full.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU64Full.c.o.d"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU64Small.c.o"
+  "CMakeFiles/datakit.dir/fenwick/fenwickU64Small.c.o.d"
+  "CMakeFiles/datakit.dir/fibbuf.c.o"
+  "CMakeFiles/datakit.dir/fibbuf.c.o.d"
+  "CMakeFiles/datakit.dir/flex.c.o"
+  "CMakeFiles/datakit.dir/flex.c.o.d"
+  "CMakeFiles/datakit.dir/float16.c.o"
+  "CMakeFiles/datakit.dir/float16.c.o.d"
+  "CMakeFiles/datakit.dir/floatExtendedTest.c.o"
+  "CMakeFiles/datakit.dir/floatExtendedTest.c.o.d"
+  "CMakeFiles/datakit.dir/hyperloglog.c.o"
+  "CMakeFiles/datakit.dir/hyperloglog.c.o.d"
+  "CMakeFiles/datakit.dir/intersectInt.c.o"
+  "CMakeFiles/datakit.dir/intersectInt.c.o.d"
+  "CMakeFiles/datakit.dir/intset.c.o"
+  "CMakeFiles/datakit.dir/intset.c.o.d"
+  "CMakeFiles/datakit.dir/intsetBig.c.o"
+  "CMakeFiles/datakit.dir/intsetBig.c.o.d"
+  "CMakeFiles/datakit.dir/intsetFull.c.o"
+  "CMakeFiles/datakit.dir/intsetFull.c.o.d"
+  "CMakeFiles/datakit.dir/intsetMedium.c.o"
+  "CMakeFiles/datakit.dir/intsetMedium.c.o.d"
+  "CMakeFiles/datakit.dir/intsetSmall.c.o"
+  "CMakeFiles/datakit.dir/intsetSmall.c.o.d"
+  "CMakeFiles/datakit.dir/intsetTest.c.o"
+  "CMakeFiles/datakit.dir/intsetTest.c.o.d"
+  "CMakeFiles/datakit.dir/intsetU32.c.o"
+  "CMakeFiles/datakit.dir/intsetU32.c.o.d"
+  "CMakeFiles/datakit.dir/jebuf.c.o"
+  "CMakeFiles/datakit.dir/jebuf.c.o.d"
+  "CMakeFiles/datakit.dir/linearBloomTest.c.o"
+  "CMakeFiles/datakit.dir/linearBloomTest.c.o.d"
+  "CMakeFiles/datakit.dir/mds.c.o"
+  "CMakeFiles/datakit.dir/mds.c.o.d"
+  "CMakeFiles/datakit.dir/mdsc.c.o"
+  "CMakeFiles/datakit.dir/mdsc.c.o.d"
+  "CMakeFiles/datakit.dir/membound.c.o"
+  "CMakeFiles/datakit.dir/membound.c.o.d"
+  "CMakeFiles/datakit.dir/memtest.c.o"
+  "CMakeFiles/datakit.dir/memtest.c.o.d"
+  "CMakeFiles/datakit.dir/mflex.c.o"
+  "CMakeFiles/datakit.dir/mflex.c.o.d"
+  "CMakeFiles/datakit.dir/multiFenwick.c.o"
+  "CMakeFiles/datakit.dir/multiFenwick.c.o.d"
+  "CMakeFiles/datakit.dir/multiFenwickTest.c.o"
+  "CMakeFiles/datakit.dir/multiFenwickTest.c.o.d"
+  "CMakeFiles/datakit.dir/multiOrderedSet.c.o"
+  "CMakeFiles/datakit.dir/multiOrderedSet.c.o.d"
+  "CMakeFiles/datakit.dir/multiOrderedSetFull.c.o"
+  "CMakeFiles/datakit.dir/multiOrderedSetFull.c.o.d"
+  "CMakeFiles/datakit.dir/multiOrderedSetMedium.c.o"
+  "CMakeFiles/datakit.dir/multiOrderedSetMedium.c.o.d"
+  "CMakeFiles/datakit.dir/multiOrderedSetSmall.c.o"
+  "CMakeFiles/datakit.dir/multiOrderedSetSmall.c.o.d"
+  "CMakeFiles/datakit.dir/multiTimer.c.o"
+  "CMakeFiles/datakit.dir/multiTimer.c.o.d"
+  "CMakeFiles/datakit.dir/multiTimerTest.c.o"
+  "CMakeFiles/datakit.dir/multiTimerTest.c.o.d"
+  "CMakeFiles/datakit.dir/multiarray.c.o"
+  "CMakeFiles/datakit.dir/multiarray.c.o.d"
+  "CMakeFiles/datakit.dir/multiarrayLarge.c.o"
+  "CMakeFiles/datakit.dir/multiarrayLarge.c.o.d"
+  "CMakeFiles/datakit.dir/multiarrayMedium.c.o"
+  "CMakeFiles/datakit.dir/multiarrayMedium.c.o.d"
+  "CMakeFiles/datakit.dir/multiarraySmall.c.o"
+  "CMakeFiles/datakit.dir/multiarraySmall.c.o.d"
+  "CMakeFiles/datakit.dir/multidict.c.o"
+  "CMakeFiles/datakit.dir/multidict.c.o.d"
+  "CMakeFiles/datakit.dir/multilist.c.o"
+  "CMakeFiles/datakit.dir/multilist.c.o.d"
+  "CMakeFiles/datakit.dir/multilistFull.c.o"
+  "CMakeFiles/datakit.dir/multilistFull.c.o.d"
+  "CMakeFiles/datakit.dir/multilistMedium.c.o"
+  "CMakeFiles/datakit.dir/multilistMedium.c.o.d"
+  "CMakeFiles/datakit.dir/multilistQueue.c.o"
+  "CMakeFiles/datakit.dir/multilistQueue.c.o.d"
+  "CMakeFiles/datakit.dir/multilistSmall.c.o"
+  "CMakeFiles/datakit.dir/multilistSmall.c.o.d"
+  "CMakeFiles/datakit.dir/multilru.c.o"
+  "CMakeFiles/datakit.dir/multilru.c.o.d"
+  "CMakeFiles/datakit.dir/multilruSim.c.o"
+  "CMakeFiles/datakit.dir/multilruSim.c.o.d"
+  "CMakeFiles/datakit.dir/multimap.c.o"
+  "CMakeFiles/datakit.dir/multimap.c.o.d"
+  "CMakeFiles/datakit.dir/multimapAtom.c.o"
+  "CMakeFiles/datakit.dir/multimapAtom.c.o.d"
+  "CMakeFiles/datakit.dir/multimapFull.c.o"
+  "CMakeFiles/datakit.dir/multimapFull.c.o.d"
+  "CMakeFiles/datakit.dir/multimapMedium.c.o"
+  "CMakeFiles/datakit.dir/multimapMedium.c.o.d"
+  "CMakeFiles/datakit.dir/multimapSmall.c.o"
+  "CMakeFiles/datakit.dir/multimapSmall.c.o.d"
+  "CMakeFiles/datakit.dir/multiroar.c.o"
+  "CMakeFiles/datakit.dir/multiroar.c.o.d"
+  "CMakeFiles/datakit.dir/multiroarBsi.c.o"
+  "CMakeFiles/datakit.dir/multiroarBsi.c.o.d"
+  "CMakeFiles/datakit.dir/offsetArray.c.o"
+  "CMakeFiles/datakit.dir/offsetArray.c.o.d"
+  "CMakeFiles/datakit.dir/persist.c.o"
+  "CMakeFiles/datakit.dir/persist.c.o.d"
+  "CMakeFiles/datakit.dir/persist/flexP.c.o"
+  "CMakeFiles/datakit.dir/persist/flexP.c.o.d"
+  "CMakeFiles/datakit.dir/persist/intsetP.c.o"
+  "CMakeFiles/datakit.dir/persist/intsetP.c.o.d"
+  "CMakeFiles/datakit.dir/persist/multiOrderedSetP.c.o"
+  "CMakeFiles/datakit.dir/persist/multiOrderedSetP.c.o.d"
+  "CMakeFiles/datakit.dir/persist/multidictP.c.o"
+  "CMakeFiles/datakit.dir/persist/multidictP.c.o.d"
+  "CMakeFiles/datakit.dir/persist/multilistP.c.o"
+  "CMakeFiles/datakit.dir/persist/multilistP.c.o.d"
+  "CMakeFiles/datakit.dir/persist/multilruP.c.o"
+  "CMakeFiles/datakit.dir/persist/multilruP.c.o.d"
+  "CMakeFiles/datakit.dir/persist/multimapP.c.o"
+  "CMakeFiles/datakit.dir/persist/multimapP.c.o.d"
+  "CMakeFiles/datakit.dir/persist/multiroarP.c.o"
+  "CMakeFiles/datakit.dir/persist/multiroarP.c.o.d"
+  "CMakeFiles/datakit.dir/persist/persistCtx.c.o"
+  "CMakeFiles/datakit.dir/persist/persistCtx.c.o.d"
+  "CMakeFiles/datakit.dir/portableRandom.c.o"
+  "CMakeFiles/datakit.dir/portableRandom.c.o.d"
+  "CMakeFiles/datakit.dir/ptrPrevNext.c.o"
+  "CMakeFiles/datakit.dir/ptrPrevNext.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentDouble.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentDouble.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentDoubleFull.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentDoubleFull.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentDoubleSmall.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentDoubleSmall.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentFloat.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentFloat.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentFloatFull.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentFloatFull.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentFloatSmall.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentFloatSmall.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentI128.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentI128.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentI128Full.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentI128Full.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentI128Small.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentI128Small.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentI16.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentI16.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentI16Full.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentI16Full.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentI16Small.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentI16Small.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentI32.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentI32.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentI32Full.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentI32Full.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentI32Small.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentI32Small.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentI64.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentI64.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentI64Full.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentI64Full.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentI64Small.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentI64Small.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentU128.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentU128.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentU128Full.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentU128Full.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentU128Small.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentU128Small.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentU16.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentU16.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentU16Full.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentU16Full.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentU16Small.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentU16Small.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentU32.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentU32.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentU32Full.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentU32Full.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentU32Small.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentU32Small.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentU64.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentU64.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentU64Full.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentU64Full.c.o.d"
+  "CMakeFiles/datakit.dir/segment/segmentU64Small.c.o"
+  "CMakeFiles/datakit.dir/segment/segmentU64Small.c.o.d"
+  "CMakeFiles/datakit.dir/setproctitle.c.o"
+  "CMakeFiles/datakit.dir/setproctitle.c.o.d"
+  "CMakeFiles/datakit.dir/str.c.o"
+  "CMakeFiles/datakit.dir/str.c.o.d"
+  "CMakeFiles/datakit.dir/strDoubleFormat.c.o"
+  "CMakeFiles/datakit.dir/strDoubleFormat.c.o.d"
+  "CMakeFiles/datakit.dir/stringPool.c.o"
+  "CMakeFiles/datakit.dir/stringPool.c.o.d"
+  "CMakeFiles/datakit.dir/timeUtil.c.o"
+  "CMakeFiles/datakit.dir/timeUtil.c.o.d"
+  "CMakeFiles/datakit.dir/timerWheel.c.o"
+  "CMakeFiles/datakit.dir/timerWheel.c.o.d"
+  "CMakeFiles/datakit.dir/timerWheelTest.c.o"
+  "CMakeFiles/datakit.dir/timerWheelTest.c.o.d"
+  "CMakeFiles/datakit.dir/ulid.c.o"
+  "CMakeFiles/datakit.dir/ulid.c.o.d"
+  "CMakeFiles/datakit.dir/util.c.o"
+  "CMakeFiles/datakit.dir/util.c.o.d"
+  "CMakeFiles/datakit.dir/versionOSRuntime.c.o"
+  "CMakeFiles/datakit.dir/versionOSRuntime.c.o.d"
+  "CMakeFiles/datakit.dir/xof.c.o"
+  "CMakeFiles/datakit.dir/xof.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/datakit.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,142 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src
+# Build directory: /root/repo/_asan_build/src
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(flex "/root/repo/_asan_build/src/datakit-test" "test" "flex")
+set_tests_properties(flex PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(mflex "/root/repo/_asan_build/src/datakit-test" "test" "mflex")
+set_tests_properties(mflex PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multilist "/root/repo/_asan_build/src/datakit-test" "test" "multilist")
+set_tests_properties(multilist PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multilistFull "/root/repo/_asan_build/src/datakit-test" "test" "multilistFull")
+set_tests_properties(multilistFull PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multilistQueue "/root/repo/_asan_build/src/datakit-test" "test" "multilistQueue")
+set_tests_properties(multilistQueue PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multidict "/root/repo/_asan_build/src/datakit-test" "test" "multidict")
+set_tests_properties(multidict PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multimap "/root/repo/_asan_build/src/datakit-test" "test" "multimap")
+set_tests_properties(multimap PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multimapFull "/root/repo/_asan_build/src/datakit-test" "test" "multimapFull")
+set_tests_properties(multimapFull PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multimapAtom "/root/repo/_asan_build/src/datakit-test" "test" "multimapAtom")
+set_tests_properties(multimapAtom PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(stringPool "/root/repo/_asan_build/src/datakit-test" "test" "stringPool")
+set_tests_properties(stringPool PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(atomPool "/root/repo/_asan_build/src/datakit-test" "test" "atomPool")
+set_tests_properties(atomPool PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multiarray "/root/repo/_asan_build/src/datakit-test" "test" "multiarray")
+set_tests_properties(multiarray PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multiarraySmall "/root/repo/_asan_build/src/datakit-test" "test" "multiarraySmall")
+set_tests_properties(multiarraySmall PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multiarrayMedium "/root/repo/_asan_build/src/datakit-test" "test" "multiarrayMedium")
+set_tests_properties(multiarrayMedium PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multiarrayLarge "/root/repo/_asan_build/src/datakit-test" "test" "multiarrayLarge")
+set_tests_properties(multiarrayLarge PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multiroar "/root/repo/_asan_build/src/datakit-test" "test" "multiroar")
+set_tests_properties(multiroar PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multiroarBsi "/root/repo/_asan_build/src/datakit-test" "test" "multiroarBsi")
+set_tests_properties(multiroarBsi PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multiOrderedSet "/root/repo/_asan_build/src/datakit-test" "test" "multiOrderedSet")
+set_tests_properties(multiOrderedSet PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multilru "/root/repo/_asan_build/src/datakit-test" "test" "multilru")
+set_tests_properties(multilru PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multilruSim "/root/repo/_asan_build/src/datakit-test" "test" "multilruSim")
+set_tests_properties(multilruSim PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(list "/root/repo/_asan_build/src/datakit-test" "test" "list")
+set_tests_properties(list PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(ptrPrevNext "/root/repo/_asan_build/src/datakit-test" "test" "ptrPrevNext")
+set_tests_properties(ptrPrevNext PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(float16 "/root/repo/_asan_build/src/datakit-test" "test" "float16")
+set_tests_properties(float16 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(floatExtended "/root/repo/_asan_build/src/datakit-test" "test" "floatExtended")
+set_tests_properties(floatExtended PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(intset "/root/repo/_asan_build/src/datakit-test" "test" "intset")
+set_tests_properties(intset PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(intsetU32 "/root/repo/_asan_build/src/datakit-test" "test" "intsetU32")
+set_tests_properties(intsetU32 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(fenwickI64 "/root/repo/_asan_build/src/datakit-test" "test" "fenwickI64")
+set_tests_properties(fenwickI64 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(segmentI64 "/root/repo/_asan_build/src/datakit-test" "test" "segmentI64")
+set_tests_properties(segmentI64 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multiFenwick "/root/repo/_asan_build/src/datakit-test" "test" "multiFenwick")
+set_tests_properties(multiFenwick PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(intsetBig "/root/repo/_asan_build/src/datakit-test" "test" "intsetBig")
+set_tests_properties(intsetBig PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(mds "/root/repo/_asan_build/src/datakit-test" "test" "mds")
+set_tests_properties(mds PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(mdsc "/root/repo/_asan_build/src/datakit-test" "test" "mdsc")
+set_tests_properties(mdsc PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(str "/root/repo/_asan_build/src/datakit-test" "test" "str")
+set_tests_properties(str PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(strDoubleFormat "/root/repo/_asan_build/src/datakit-test" "test" "strDoubleFormat")
+set_tests_properties(strDoubleFormat PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(dj "/root/repo/_asan_build/src/datakit-test" "test" "dj")
+set_tests_properties(dj PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(dod "/root/repo/_asan_build/src/datakit-test" "test" "dod")
+set_tests_properties(dod PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(xof "/root/repo/_asan_build/src/datakit-test" "test" "xof")
+set_tests_properties(xof PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(intersectInt "/root/repo/_asan_build/src/datakit-test" "test" "intersectInt")
+set_tests_properties(intersectInt PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(hyperloglog "/root/repo/_asan_build/src/datakit-test" "test" "hyperloglog")
+set_tests_properties(hyperloglog PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(linearBloom "/root/repo/_asan_build/src/datakit-test" "test" "linearBloom")
+set_tests_properties(linearBloom PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(binaryFuse "/root/repo/_asan_build/src/datakit-test" "test" "binaryFuse")
+set_tests_properties(binaryFuse PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(sha1 "/root/repo/_asan_build/src/datakit-test" "test" "sha1")
+set_tests_properties(sha1 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(timeUtil "/root/repo/_asan_build/src/datakit-test" "test" "timeUtil")
+set_tests_properties(timeUtil PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multiTimer "/root/repo/_asan_build/src/datakit-test" "test" "multiTimer")
+set_tests_properties(multiTimer PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(timerWheel "/root/repo/_asan_build/src/datakit-test" "test" "timerWheel")
+set_tests_properties(timerWheel PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(fibbuf "/root/repo/_asan_build/src/datakit-test" "test" "fibbuf")
+set_tests_properties(fibbuf PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(jebuf "/root/repo/_asan_build/src/datakit-test" "test" "jebuf")
+set_tests_properties(jebuf PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(util "/root/repo/_asan_build/src/datakit-test" "test" "util")
+set_tests_properties(util PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(databox "/root/repo/_asan_build/src/datakit-test" "test" "databox")
+set_tests_properties(databox PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(databoxLinear "/root/repo/_asan_build/src/datakit-test" "test" "databoxLinear")
+set_tests_properties(databoxLinear PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(offsetArray "/root/repo/_asan_build/src/datakit-test" "test" "offsetArray")
+set_tests_properties(offsetArray PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(membound "/root/repo/_asan_build/src/datakit-test" "test" "membound")
+set_tests_properties(membound PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(memtest "/root/repo/_asan_build/src/datakit-test" "test" "memtest")
+set_tests_properties(memtest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(bbits "/root/repo/_asan_build/src/datakit-test" "test" "bbits")
+set_tests_properties(bbits PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(ulid "/root/repo/_asan_build/src/datakit-test" "test" "ulid")
+set_tests_properties(ulid PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(persist "/root/repo/_asan_build/src/datakit-test" "test" "persist")
+set_tests_properties(persist PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(persistCtx "/root/repo/_asan_build/src/datakit-test" "test" "persistCtx")
+set_tests_properties(persistCtx PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multimapP "/root/repo/_asan_build/src/datakit-test" "test" "multimapP")
+set_tests_properties(multimapP PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multilistP "/root/repo/_asan_build/src/datakit-test" "test" "multilistP")
+set_tests_properties(multilistP PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multidictP "/root/repo/_asan_build/src/datakit-test" "test" "multidictP")
+set_tests_properties(multidictP PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(flexP "/root/repo/_asan_build/src/datakit-test" "test" "flexP")
+set_tests_properties(flexP PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(intsetP "/root/repo/_asan_build/src/datakit-test" "test" "intsetP")
+set_tests_properties(intsetP PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multiOrderedSetP "/root/repo/_asan_build/src/datakit-test" "test" "multiOrderedSetP")
+set_tests_properties(multiOrderedSetP PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multiroarP "/root/repo/_asan_build/src/datakit-test" "test" "multiroarP")
+set_tests_properties(multiroarP PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(multilruP "/root/repo/_asan_build/src/datakit-test" "test" "multilruP")
+set_tests_properties(multilruP PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(clusterRing "/root/repo/_asan_build/src/datakit-test" "test" "clusterRing")
+set_tests_properties(clusterRing PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+add_test(compressionBench "/root/repo/_asan_build/src/datakit-test" "test" "compressionBench")
+set_tests_properties(compressionBench PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/CMakeLists.txt;623;add_test;/root/repo/src/CMakeLists.txt;0;")
+subdirs("fenwick")
+subdirs("segment")
@@ -0,0 +1,936 @@
+/* binaryFuse.c - static 3-wise binary fuse filter
+ *
+ * Construction follows Graf & Lemire, "Binary Fuse Filters: Fast and
+ * Smaller Than Xor Filters" (2022): the fingerprint array is split into
+ * segments and each key maps to one slot in each of three consecutive
+ * segments. Keys are peeled off slots they own alone, then fingerprints are
+ * assigned in reverse peel order so that
+ *     fp[h0] ^ fp[h1] ^ fp[h2] == fingerprint(key)
+ * holds for every key. */
+
+#include "binaryFuse.h"
+
+#include "datakit.h"
+#include "multidict.h"
+#include "multimap.h"
+
+#define XXH_STATIC_LINKING_ONLY
+#include "../deps/xxHash/xxhash.h"
+
+#include <math.h>
+
+/* Peeling fails with probability well under 1% per attempt for more than a
+ * few hundred keys; 100 failed seeds in a row means something is broken. */
+#define BINARY_FUSE_MAX_ATTEMPTS 100
+#define BINARY_FUSE_MAX_SEGMENT_LENGTH 262144
+
+struct binaryFuse {
+    uint64_t seed;
+    uint32_t count; /* distinct keys */
+    uint32_t segmentLength;
+    uint32_t segmentLengthMask;
+    uint32_t segmentCount;
+    uint32_t segmentCountLength; /* segmentCount * segmentLength */
+    uint32_t arrayLength;        /* (segmentCount + 2) * segmentLength */
+    binaryFuseBits bits;
+    void *fingerprints; /* arrayLength uint8_t or uint16_t */
+};
+
+/* ====================================================================
+ * Hashing
+ * ==================================================================== */
+DK_INLINE_ALWAYS uint64_t binaryFuseMurmur64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+DK_INLINE_ALWAYS uint64_t binaryFuseSplitMix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+DK_INLINE_ALWAYS uint64_t binaryFuseMulHi(uint64_t a, uint64_t b) {
+    return (uint64_t)(((__uint128_t)a * b) >> 64);
+}
+
+DK_INLINE_ALWAYS uint32_t binaryFuseFingerprint(uint64_t hash) {
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+/* Slot of 'hash' in segment 'index' (0, 1, or 2) */
+DK_INLINE_ALWAYS uint32_t binaryFuseSlot(const binaryFuse *f, uint32_t index,
+                                         uint64_t hash) {
+    uint64_t h = binaryFuseMulHi(hash, f->segmentCountLength);
+    h += (uint64_t)index * f->segmentLength;
+
+    /* index 0: no perturbation; 1: bits 18..; 2: bits 0.. */
+    const uint64_t hh = hash & ((1ULL << 36) - 1);
+    h ^= (hh >> (36 - 18 * index)) & f->segmentLengthMask;
+    return (uint32_t)h;
+}
+
+bool binaryFuseHashKey(const databox *key, uint64_t *hash) {
+    /* Numbers hash by value: non-negative signed integers match unsigned
+     * ones, and floats are widened so 1.5f matches 1.5. */
+    uint64_t seed = key->type;
+    uint64_t value = key->data.u;
+    switch (key->type) {
+    case DATABOX_BYTES:
+    case DATABOX_BYTES_EMBED:
+    case DATABOX_BYTES_NEVER_FREE:
+        *hash = XXH3_64bits(databoxCBytes(key), databoxLen(key));
+        return true;
+    case DATABOX_SIGNED_64:
+        if (key->data.i64 >= 0) {
+            seed = DATABOX_UNSIGNED_64;
+        }
+
+        break;
+    case DATABOX_SIGNED_128:
+    case DATABOX_UNSIGNED_128:
+        *hash = XXH3_64bits_withSeed(key->data.u128, sizeof(*key->data.u128),
+                                     key->type);
+        return true;
+    case DATABOX_FLOAT_32: {
+        const double widened = key->data.f32;
+        seed = DATABOX_DOUBLE_64;
+        memcpy(&value, &widened, sizeof(value));
+        break;
+    }
+    case DATABOX_UNSIGNED_64:
+    case DATABOX_DOUBLE_64:
+    case DATABOX_PTR:
+    case DATABOX_CONTAINER_REFERENCE_EXTERNAL:
+        break;
+    case DATABOX_VOID:
+    case DATABOX_TRUE:
+    case DATABOX_FALSE:
+    case DATABOX_NULL:
+        /* Type-only values; 'data' is unspecified */
+        value = 0;
+        break;
+    default:
+        return false;
+    }
+
+    *hash = XXH3_64bits_withSeed(&value, sizeof(value), seed);
+    return true;
+}
+
+/* ====================================================================
+ * Geometry
+ * ==================================================================== */
+static void binaryFuseSize(binaryFuse *f, uint32_t count) {
+    /* Constants from the reference implementation; they are sensitive,
+     * e.g. rounding instead of flooring the segment length measurably
+     * raises construction failures. */
+    if (count == 0) {
+        f->segmentLength = 4;
+    } else {
+        f->segmentLength =
+            1U << (int)floor(log((double)count) / log(3.33) + 2.25);
+    }
+
+    if (f->segmentLength > BINARY_FUSE_MAX_SEGMENT_LENGTH) {
+        f->segmentLength = BINARY_FUSE_MAX_SEGMENT_LENGTH;
+    }
+
+    f->segmentLengthMask = f->segmentLength - 1;
+
+    const double sizeFactor =
+        count <= 1 ? 0
+                   : fmax(1.125, 0.875 + 0.25 * log(1000000.0) / log(count));
+    const uint64_t capacity = (uint64_t)round((double)count * sizeFactor);
+    const uint64_t segments =
+        (capacity + f->segmentLength - 1) / f->segmentLength;
+
+    /* Keys start in any of the first 'segmentCount' segments and span
+     * three, so the array holds segmentCount + 2 segments. */
+    f->segmentCount = segments <= 2 ? 1 : (uint32_t)(segments - 2);
+    f->arrayLength = (f->segmentCount + 2) * f->segmentLength;
+    f->segmentCountLength = f->segmentCount * f->segmentLength;
+}
+
+/* ====================================================================
+ * Construction
+ * ==================================================================== */
+static int binaryFuseCompareU64(const void *a, const void *b) {
+    const uint64_t x = *(const uint64_t *)a;
+    const uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+DK_INLINE_ALWAYS void binaryFuseStore(binaryFuse *f, uint32_t slot,
+                                      uint32_t fp) {
+    if (f->bits == BINARY_FUSE_8) {
+        ((uint8_t *)f->fingerprints)[slot] = (uint8_t)fp;
+    } else {
+        ((uint16_t *)f->fingerprints)[slot] = (uint16_t)fp;
+    }
+}
+
+DK_INLINE_ALWAYS uint32_t binaryFuseLoad(const binaryFuse *f, uint32_t slot) {
+    if (f->bits == BINARY_FUSE_8) {
+        return ((const uint8_t *)f->fingerprints)[slot];
+    }
+
+    return ((const uint16_t *)f->fingerprints)[slot];
+}
+
+/* Peel 'count' distinct keys into 'f'. Returns false if no seed worked. */
+static bool binaryFusePopulate(binaryFuse *f, const uint64_t *keys,
+                               uint32_t count) {
+    const uint32_t capacity = f->arrayLength;
+    uint64_t rng = 0x726b2b9d438b9d4dULL;
+    f->seed = binaryFuseSplitMix64(&rng);
+
+    /* 'order' is first the keys' mixed hashes bucketed by segment (for
+     * cache locality while counting), then the peel stack. Slot 'count'
+     * is a non-zero sentinel so bucketing never runs off the end. */
+    uint64_t *order = zcalloc(count + 1, sizeof(*order));
+    uint8_t *orderSlot = zmalloc(count ? count : 1);
+    uint32_t *alone = zmalloc(capacity * sizeof(*alone));
+
+    /* Per slot: (keys << 2) | xor of the key's segment index (0, 1, 2),
+     * and xor of the mixed hashes of its keys. Once a slot holds one key
+     * these give its hash and which of its three slots this is. */
+    uint8_t *t2count = zcalloc(capacity, sizeof(*t2count));
+    uint64_t *t2hash = zcalloc(capacity, sizeof(*t2hash));
+
+    uint32_t blockBits = 1;
+    while ((1U << blockBits) < f->segmentCount) {
+        blockBits++;
+    }
+
+    const uint32_t blocks = 1U << blockBits;
+    uint32_t *startPos = zmalloc(blocks * sizeof(*startPos));
+
+    bool ok = false;
+    uint32_t stackSize = 0;
+    order[count] = 1;
+    for (uint32_t attempt = 0; attempt < BINARY_FUSE_MAX_ATTEMPTS; attempt++) {
+        if (attempt) {
+            memset(order, 0, count * sizeof(*order));
+            memset(t2count, 0, capacity * sizeof(*t2count));
+            memset(t2hash, 0, capacity * sizeof(*t2hash));
+            f->seed = binaryFuseSplitMix64(&rng);
+        }
+
+        for (uint32_t i = 0; i < blocks; i++) {
+            startPos[i] = (uint32_t)(((uint64_t)i * count) >> blockBits);
+        }
+
+        for (uint32_t i = 0; i < count; i++) {
+            const uint64_t hash = binaryFuseMurmur64(keys[i] + f->seed);
+            uint64_t block = hash >> (64 - blockBits);
+            while (order[startPos[block]] != 0) {
+                block = (block + 1) & (blocks - 1);
+            }
+
+            order[startPos[block]++] = hash;
+        }
+
+        bool overflow = false;
+        for (uint32_t i = 0; i < count; i++) {
+            const uint64_t hash = order[i];
+            for (uint32_t s = 0; s < 3; s++) {
+                const uint32_t slot = binaryFuseSlot(f, s, hash);
+                t2count[slot] += 4;
+                t2count[slot] ^= s;
+                t2hash[slot] ^= hash;
+                overflow |= t2count[slot] < 4;
+            }
+        }
+
+        if (overflow) {
+            continue;
+        }
+
+        uint32_t queued = 0;
+        for (uint32_t i = 0; i < capacity; i++) {
+            alone[queued] = i;
+            queued += (t2count[i] >> 2) == 1;
+        }
+
+        stackSize = 0;
+        while (queued > 0) {
+            const uint32_t slot = alone[--queued];
+            if ((t2count[slot] >> 2) != 1) {
+                continue;
+            }
+
+            const uint64_t hash = t2hash[slot];
+            const uint8_t found = t2count[slot] & 3;
+            orderSlot[stackSize] = found;
+            order[stackSize++] = hash;
+
+            for (uint32_t s = 0; s < 3; s++) {
+                if (s == found) {
+                    continue;
+                }
+
+                const uint32_t other = binaryFuseSlot(f, s, hash);
+                alone[queued] = other;
+                queued += (t2count[other] >> 2) == 2;
+                t2count[other] -= 4;
+                t2count[other] ^= s;
+                t2hash[other] ^= hash;
+            }
+        }
+
+        if (stackSize == count) {
+            ok = true;
+            break;
+        }
+    }
+
+    if (ok) {
+        /* Last peeled key first: its two other slots are final by now */
+        for (uint32_t i = count; i-- > 0;) {
+            const uint64_t hash = order[i];
+            const uint32_t found = orderSlot[i];
+            uint32_t fp = binaryFuseFingerprint(hash);
+            uint32_t target = 0;
+            for (uint32_t s = 0; s < 3; s++) {
+                const uint32_t slot = binaryFuseSlot(f, s, hash);
+                if (s == found) {
+                    target = slot;
+                } else {
+                    fp ^= binaryFuseLoad(f, slot);
+                }
+            }
+
+            binaryFuseStore(f, target, fp);
+        }
+    }
+
+    zfree(startPos);
+    zfree(t2hash);
+    zfree(t2count);
+    zfree(alone);
+    zfree(orderSlot);
+    zfree(order);
+    return ok;
+}
+
+static binaryFuse *binaryFuseAllocate(uint32_t count, binaryFuseBits bits) {
+    binaryFuse *f = zcalloc(1, sizeof(*f));
+    f->bits = bits;
+    f->count = count;
+    binaryFuseSize(f, count);
+    f->fingerprints = zcalloc(f->arrayLength, bits / 8);
+    return f;
+}
+
+binaryFuse *binaryFuseNew(const uint64_t *hashes, size_t count,
+                          binaryFuseBits bits) {
+    if ((bits != BINARY_FUSE_8 && bits != BINARY_FUSE_16) ||
+        count > UINT32_MAX) {
+        return NULL;
+    }
+
+    /* Duplicates would never peel (two identical keys share all three
+     * slots), so build from the sorted unique set. */
+    uint64_t *keys = zmalloc((count ? count : 1) * sizeof(*keys));
+    if (count) {
+        memcpy(keys, hashes, count * sizeof(*keys));
+    }
+
+    qsort(keys, count, sizeof(*keys), binaryFuseCompareU64);
+    size_t unique = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (unique == 0 || keys[i] != keys[unique - 1]) {
+            keys[unique++] = keys[i];
+        }
+    }
+
+    binaryFuse *f = binaryFuseAllocate((uint32_t)unique, bits);
+    if (!binaryFusePopulate(f, keys, (uint32_t)unique)) {
+        binaryFuseFree(f);
+        f = NULL;
+    }
+
+    zfree(keys);
+    return f;
+}
+
+binaryFuse *binaryFuseNewFromMultidict(multidict *d, binaryFuseBits bits) {
+    const uint64_t count = multidictCount(d);
+    uint64_t *hashes = zmalloc((count ? count : 1) * sizeof(*hashes));
+    size_t n = 0;
+
+    multidictIterator iter;
+    multidictEntry entry;
+    multidictIteratorInit(d, &iter);
+    bool hashable = true;
+    while (hashable && n < count && multidictIteratorNext(&iter, &entry)) {
+        hashable = binaryFuseHashKey(&entry.key, &hashes[n++]);
+    }
+
+    multidictIteratorRelease(&iter);
+
+    binaryFuse *f = hashable ? binaryFuseNew(hashes, n, bits) : NULL;
+    zfree(hashes);
+    return f;
+}
+
+binaryFuse *binaryFuseNewFromMultimap(const multimap *m, binaryFuseBits bits) {
+    const size_t count = multimapCount(m);
+    uint64_t *hashes = zmalloc((count ? count : 1) * sizeof(*hashes));
+    size_t n = 0;
+
+    multimapIterator iter;
+    multimapIteratorInit(m, &iter, true);
+
+    /* Big boxes so 128-bit keys have somewhere to land */
+    const uint32_t width = iter.elementsPerEntry;
+    databoxBig *boxes = zcalloc(width, sizeof(*boxes));
+    databox **elements = zcalloc(width, sizeof(*elements));
+    for (uint32_t i = 0; i < width; i++) {
+        elements[i] = (databox *)&boxes[i];
+    }
+
+    bool hashable = true;
+    while (hashable && n < count && multimapIteratorNext(&iter, elements)) {
+        hashable = binaryFuseHashKey(elements[0], &hashes[n++]);
+    }
+
+    zfree(elements);
+    zfree(boxes);
+
+    binaryFuse *f = hashable ? binaryFuseNew(hashes, n, bits) : NULL;
+    zfree(hashes);
+    return f;
+}
+
+void binaryFuseFree(binaryFuse *f) {
+    if (f) {
+        zfree(f->fingerprints);
+        zfree(f);
+    }
+}
+
+/* ====================================================================
+ * Query
+ * ==================================================================== */
+bool binaryFuseContains(const binaryFuse *f, uint64_t hash) {
+    const uint64_t mixed = binaryFuseMurmur64(hash + f->seed);
+    const uint32_t h0 = binaryFuseSlot(f, 0, mixed);
+    const uint32_t h1 = binaryFuseSlot(f, 1, mixed);
+    const uint32_t h2 = binaryFuseSlot(f, 2, mixed);
+    const uint32_t fp = binaryFuseFingerprint(mixed);
+
+    if (f->bits == BINARY_FUSE_8) {
+        const uint8_t *fps = f->fingerprints;
+        return (uint8_t)(fp ^ fps[h0] ^ fps[h1] ^ fps[h2]) == 0;
+    }
+
+    const uint16_t *fps = f->fingerprints;
+    return (uint16_t)(fp ^ fps[h0] ^ fps[h1] ^ fps[h2]) == 0;
+}
+
+bool binaryFuseContainsKey(const binaryFuse *f, const databox *key) {
+    uint64_t hash;
+    return binaryFuseHashKey(key, &hash) && binaryFuseContains(f, hash);
+}
+
+size_t binaryFuseCount(const binaryFuse *f) {
+    return f->count;
+}
+
+binaryFuseBits binaryFuseFingerprintBits(const binaryFuse *f) {
+    return f->bits;
+}
+
+size_t binaryFuseBytes(const binaryFuse *f) {
+    return sizeof(*f) + (size_t)f->arrayLength * (f->bits / 8);
+}
+
+/* ====================================================================
+ * Serialization
+ * ====================================================================
+ * Layout (all integers little endian):
+ *   magic "BFUS" | version (1) | flags: fingerprint bits (1)
+ *   seed (8) | count (4) | segmentLength (4) | segmentCount (4)
+ *   fingerprints (arrayLength * bits / 8) */
+#define BINARY_FUSE_MAGIC_0 'B'
+#define BINARY_FUSE_MAGIC_1 'F'
+#define BINARY_FUSE_MAGIC_2 'U'
+#define BINARY_FUSE_MAGIC_3 'S'
+#define BINARY_FUSE_VERSION 1
+#define BINARY_FUSE_HEADER_BYTES (4 + 1 + 1 + 8 + 4 + 4 + 4)
+
+static uint8_t *binaryFusePutLE(uint8_t *p, uint64_t value, uint32_t bytes) {
+    for (uint32_t i = 0; i < bytes; i++) {
+        *p++ = (uint8_t)(value >> (8 * i));
+    }
+
+    return p;
+}
+
+static const uint8_t *binaryFuseGetLE(const uint8_t *p, uint64_t *value,
+                                      uint32_t bytes) {
+    *value = 0;
+    for (uint32_t i = 0; i < bytes; i++) {
+        *value |= (uint64_t)*p++ << (8 * i);
+    }
+
+    return p;
+}
+
+uint64_t binaryFuseSerializedSize(const binaryFuse *f) {
+    return BINARY_FUSE_HEADER_BYTES + (uint64_t)f->arrayLength * (f->bits / 8);
+}
+
+uint64_t binaryFuseSerialize(const binaryFuse *f, void *buf, uint64_t bufSize) {
+    const uint64_t size = binaryFuseSerializedSize(f);
+    if (!buf || bufSize < size) {
+        return 0;
+    }
+
+    uint8_t *p = buf;
+    *p++ = BINARY_FUSE_MAGIC_0;
+    *p++ = BINARY_FUSE_MAGIC_1;
+    *p++ = BINARY_FUSE_MAGIC_2;
+    *p++ = BINARY_FUSE_MAGIC_3;
+    *p++ = BINARY_FUSE_VERSION;
+    *p++ = (uint8_t)f->bits;
+    p = binaryFusePutLE(p, f->seed, 8);
+    p = binaryFusePutLE(p, f->count, 4);
+    p = binaryFusePutLE(p, f->segmentLength, 4);
+    p = binaryFusePutLE(p, f->segmentCount, 4);
+
+    if (f->bits == BINARY_FUSE_8) {
+        memcpy(p, f->fingerprints, f->arrayLength);
+    } else {
+        const uint16_t *fps = f->fingerprints;
+        for (uint32_t i = 0; i < f->arrayLength; i++) {
+            p = binaryFusePutLE(p, fps[i], 2);
+        }
+    }
+
+    return size;
+}
+
+binaryFuse *binaryFuseDeserialize(const void *buf, uint64_t bufSize) {
+    if (!buf || bufSize < BINARY_FUSE_HEADER_BYTES) {
+        return NULL;
+    }
+
+    const uint8_t *p = buf;
+    if (p[0] != BINARY_FUSE_MAGIC_0 || p[1] != BINARY_FUSE_MAGIC_1 ||
+        p[2] != BINARY_FUSE_MAGIC_2 || p[3] != BINARY_FUSE_MAGIC_3) {
+        return NULL;
+    }
+
+    p += 4;
+    if (*p++ != BINARY_FUSE_VERSION) {
+        return NULL;
+    }
+
+    const uint8_t bits = *p++;
+    if (bits != BINARY_FUSE_8 && bits != BINARY_FUSE_16) {
+        return NULL;
+    }
+
+    uint64_t seed, count, segmentLength, segmentCount;
+    p = binaryFuseGetLE(p, &seed, 8);
+    p = binaryFuseGetLE(p, &count, 4);
+    p = binaryFuseGetLE(p, &segmentLength, 4);
+    p = binaryFuseGetLE(p, &segmentCount, 4);
+
+    /* Geometry is fully determined by 'count', so anything else is a
+     * corrupt or foreign buffer. */
+    binaryFuse geometry = {.bits = bits};
+    binaryFuseSize(&geometry, (uint32_t)count);
+    if (geometry.segmentLength != segmentLength ||
+        geometry.segmentCount != segmentCount ||
+        bufSize < binaryFuseSerializedSize(&geometry)) {
+        return NULL;
+    }
+
+    binaryFuse *f = binaryFuseAllocate((uint32_t)count, bits);
+    f->seed = seed;
+
+    if (bits == BINARY_FUSE_8) {
+        memcpy(f->fingerprints, p, f->arrayLength);
+    } else {
+        uint16_t *fps = f->fingerprints;
+        for (uint32_t i = 0; i < f->arrayLength; i++) {
+            uint64_t fp;
+            p = binaryFuseGetLE(p, &fp, 2);
+            fps[i] = (uint16_t)fp;
+        }
+    }
+
+    return f;
+}
+
+#ifdef DATAKIT_TEST
+#include "ctest.h"
+#include "linearBloom.h"
+#include "linearBloomBlocked.h"
+#include "perf.h"
+
+static void binaryFuseTestHashes(uint64_t *hashes, size_t count,
+                                 uint64_t seed) {
+    for (size_t i = 0; i < count; i++) {
+        hashes[i] = binaryFuseSplitMix64(&seed);
+    }
+}
+
+int binaryFuseTest(int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int err = 0;
+
+    static const binaryFuseBits allBits[] = {BINARY_FUSE_8, BINARY_FUSE_16};
+
+    TEST("no false negatives across sizes") {
+        static const size_t sizes[] = {0, 1, 2, 3, 10, 100, 1000, 12345,
+                                       1000000};
+        for (size_t b = 0; b < COUNT_ARRAY(allBits); b++) {
+            for (size_t s = 0; s < COUNT_ARRAY(sizes); s++) {
+                const size_t count = sizes[s];
+                uint64_t *hashes = zmalloc((count + 1) * sizeof(*hashes));
+                binaryFuseTestHashes(hashes, count, count);
+
+                binaryFuse *f = binaryFuseNew(hashes, count, allBits[b]);
+                if (!f) {
+                    ERR("Build failed for %zu keys at %d bits", count,
+                        allBits[b]);
+                    zfree(hashes);
+                    continue;
+                }
+
+                if (binaryFuseCount(f) != count) {
+                    ERR("Count %zu != %zu", binaryFuseCount(f), count);
+                }
+
+                size_t missing = 0;
+                for (size_t i = 0; i < count; i++) {
+                    missing += !binaryFuseContains(f, hashes[i]);
+                }
+
+                if (missing) {
+                    ERR("%zu of %zu keys missing at %d bits", missing, count,
+                        allBits[b]);
+                }
+
+                binaryFuseFree(f);
+                zfree(hashes);
+            }
+        }
+    }
+
+    TEST("false positive rate matches fingerprint width") {
+        const size_t count = 200000;
+        const size_t probes = 2000000;
+        uint64_t *hashes = zmalloc(count * sizeof(*hashes));
+        binaryFuseTestHashes(hashes, count, 1);
+
+        for (size_t b = 0; b < COUNT_ARRAY(allBits); b++) {
+            binaryFuse *f = binaryFuseNew(hashes, count, allBits[b]);
+
+            uint64_t seed = 0xfeedULL;
+            size_t fp = 0;
+            for (size_t i = 0; i < probes; i++) {
+                fp += binaryFuseContains(f, binaryFuseSplitMix64(&seed));
+            }
+
+            const double rate = (double)fp / probes;
+            const double expected = 1.0 / (1ULL << allBits[b]);
+            const double bitsPerKey = 8.0 * binaryFuseBytes(f) / count;
+            printf("%2d-bit: FPP %.5f%% (expected %.5f%%), %.2f bits/key\n",
+                   allBits[b], rate * 100, expected * 100, bitsPerKey);
+            if (rate > expected * 1.5 + 2.0 / probes) {
+                ERR("FPP %f too high for %d bits", rate, allBits[b]);
+            }
+
+            if (bitsPerKey > allBits[b] * 1.2) {
+                ERR("%.2f bits per key too large for %d bits", bitsPerKey,
+                    allBits[b]);
+            }
+
+            binaryFuseFree(f);
+        }
+
+        zfree(hashes);
+    }
+
+    TEST("duplicate hashes collapse") {
+        uint64_t hashes[3000];
+        for (size_t i = 0; i < COUNT_ARRAY(hashes); i++) {
+            hashes[i] = (i % 1000) * 0x9e3779b97f4a7c15ULL;
+        }
+
+        binaryFuse *f = binaryFuseNew(hashes, COUNT_ARRAY(hashes), 8);
+        if (!f || binaryFuseCount(f) != 1000) {
+            ERR("Expected 1000 distinct keys, got %zu",
+                f ? binaryFuseCount(f) : 0);
+        } else {
+            for (size_t i = 0; i < 1000; i++) {
+                if (!binaryFuseContains(f, hashes[i])) {
+                    ERR("Key %zu missing", i);
+                    break;
+                }
+            }
+        }
+
+        binaryFuseFree(f);
+    }
+
+    TEST("invalid parameters") {
+        uint64_t h = 1;
+        if (binaryFuseNew(&h, 1, 12)) {
+            ERRR("Accepted 12-bit fingerprints");
+        }
+    }
+
+    TEST("key hashing normalizes numbers") {
+        const databox s = DATABOX_SIGNED(5);
+        const databox u = DATABOX_UNSIGNED(5);
+        const databox neg = DATABOX_SIGNED(-5);
+        uint64_t hs, hu, hneg;
+        if (!binaryFuseHashKey(&s, &hs) || !binaryFuseHashKey(&u, &hu) ||
+            !binaryFuseHashKey(&neg, &hneg)) {
+            ERRR("Rejected an integer key");
+        }
+
+        if (hs != hu) {
+            ERRR("Signed and unsigned 5 hash differently");
+        }
+
+        if (hneg == hu) {
+            ERRR("-5 and 5 hash the same");
+        }
+    }
+
+    TEST("key hashing rejects types without a value") {
+        /* Type-only boxes hash the same whatever 'data' holds */
+        databox t1 = {.type = DATABOX_TRUE, .data.u = 1};
+        databox t2 = {.type = DATABOX_TRUE, .data.u = 2};
+        uint64_t h1, h2;
+        if (!binaryFuseHashKey(&t1, &h1) || !binaryFuseHashKey(&t2, &h2) ||
+            h1 != h2) {
+            ERRR("TRUE hashed by its unused payload");
+        }
+
+        const databoxType rejected[] = {
+            DATABOX_ERROR, DATABOX_ARRAY_START, DATABOX_BYTES_VOID,
+            DATABOX_BYTES_OFFSET, DATABOX_CONTAINER_FLEX_MAP};
+        for (size_t i = 0; i < COUNT_ARRAY(rejected); i++) {
+            const databox box = {.type = rejected[i]};
+            uint64_t h;
+            if (binaryFuseHashKey(&box, &h)) {
+                ERR("Hashed databox type %d", rejected[i]);
+            }
+        }
+    }
+
+    TEST("build from multidict") {
+        multidictClass *qdc = multidictDefaultClassNew();
+        multidict *d = multidictNew(&multidictTypeExactKey, qdc, 0);
+        char buf[32];
+        for (int i = 0; i < 5000; i++) {
+            snprintf(buf, sizeof(buf), "key:%d", i);
+            const databox keyBox = databoxNewBytes(buf, strlen(buf));
+            const databox val = databoxNewSigned(i);
+            multidictAdd(d, &keyBox, &val);
+        }
+
+        for (size_t b = 0; b < COUNT_ARRAY(allBits); b++) {
+            binaryFuse *f = binaryFuseNewFromMultidict(d, allBits[b]);
+            if (!f || binaryFuseCount(f) != 5000) {
+                ERR("Expected 5000 keys, got %zu", f ? binaryFuseCount(f) : 0);
+            } else {
+                for (int i = 0; i < 5000; i++) {
+                    snprintf(buf, sizeof(buf), "key:%d", i);
+                    const databox keyBox = databoxNewBytes(buf, strlen(buf));
+                    if (!binaryFuseContainsKey(f, &keyBox)) {
+                        ERR("Key %s missing", buf);
+                        break;
+                    }
+                }
+            }
+
+            binaryFuseFree(f);
+        }
+
+        multidictFree(d);
+        multidictDefaultClassFree(qdc);
+    }
+
+    TEST("build from multimap") {
+        multimap *m = multimapNew(2);
+        for (int64_t i = 0; i < 5000; i++) {
+            const databox key = databoxNewSigned(i * 7 - 10000);
+            const databox val = databoxNewSigned(i);
+            const databox *elements[] = {&key, &val};
+            multimapInsert(&m, elements);
+        }
+
+        binaryFuse *f = binaryFuseNewFromMultimap(m, BINARY_FUSE_16);
+        if (!f || binaryFuseCount(f) != 5000) {
+            ERR("Expected 5000 keys, got %zu", f ? binaryFuseCount(f) : 0);
+        } else {
+            for (int64_t i = 0; i < 5000; i++) {
+                const databox key = databoxNewSigned(i * 7 - 10000);
+                if (!binaryFuseContainsKey(f, &key)) {
+                    ERR("Key %" PRId64 " missing", i * 7 - 10000);
+                    break;
+                }
+            }
+        }
+
+        binaryFuseFree(f);
+        multimapFree(m);
+    }
+
+    TEST("serialize round trip") {
+        const size_t count = 50000;
+        uint64_t *hashes = zmalloc(count * sizeof(*hashes));
+        binaryFuseTestHashes(hashes, count, 7);
+
+        for (size_t b = 0; b < COUNT_ARRAY(allBits); b++) {
+            binaryFuse *f = binaryFuseNew(hashes, count, allBits[b]);
+            const uint64_t size = binaryFuseSerializedSize(f);
+            uint8_t *buf = zmalloc(size);
+
+            if (binaryFuseSerialize(f, buf, size - 1) != 0) {
+                ERRR("Serialized into a short buffer");
+            }
+
+            if (binaryFuseSerialize(f, buf, size) != size) {
+                ERRR("Serialize size mismatch");
+            }
+
+            binaryFuse *g = binaryFuseDeserialize(buf, size);
+            if (!g) {
+                ERRR("Deserialize failed");
+            } else {
+                uint64_t seed = 99;
+                for (size_t i = 0; i < count; i++) {
+                    if (!binaryFuseContains(g, hashes[i])) {
+                        ERR("Key %zu missing after round trip", i);
+                        break;
+                    }
+
+                    const uint64_t probe = binaryFuseSplitMix64(&seed);
+                    if (binaryFuseContains(f, probe) !=
+                        binaryFuseContains(g, probe)) {
+                        ERR("Probe %zu disagrees after round trip", i);
+                        break;
+                    }
+                }
+            }
+
+            if (binaryFuseDeserialize(buf, size - 1)) {
+                ERRR("Accepted truncated buffer");
+            }
+
+            buf[0] = 'X';
+            if (binaryFuseDeserialize(buf, size)) {
+                ERRR("Accepted bad magic");
+            }
+
+            buf[0] = BINARY_FUSE_MAGIC_0;
+            buf[18]++; /* segmentLength */
+            if (binaryFuseDeserialize(buf, size)) {
+                ERRR("Accepted inconsistent geometry");
+            }
+
+            binaryFuseFree(g);
+            binaryFuseFree(f);
+            zfree(buf);
+        }
+
+        zfree(hashes);
+    }
+
+    TEST("PERF: binaryFuse vs. linearBloom vs. linearBloomBlocked") {
+        /* linearBloomBlocked sized for ~0.4% FPP; linearBloom is fixed */
+        const size_t count = 1000000;
+        const size_t queries = 4000000;
+        uint64_t *hashes = zmalloc(count * sizeof(*hashes));
+        uint64_t *probes = zmalloc(queries * sizeof(*probes));
+        binaryFuseTestHashes(hashes, count, 11);
+        binaryFuseTestHashes(probes, queries, 12);
+
+        PERF_TIMERS_SETUP;
+        binaryFuse *f8 = binaryFuseNew(hashes, count, BINARY_FUSE_8);
+        PERF_TIMERS_FINISH_PRINT_RESULTS(count, "binaryFuse8 build");
+
+        PERF_TIMERS_SETUP;
+        binaryFuse *f16 = binaryFuseNew(hashes, count, BINARY_FUSE_16);
+        PERF_TIMERS_FINISH_PRINT_RESULTS(count, "binaryFuse16 build");
+
+        linearBloomBlocked *blocked = linearBloomBlockedNew(count * 12 / 8);
+        for (size_t i = 0; i < count; i++) {
+            uint64_t hash[2] = {hashes[i], binaryFuseMurmur64(hashes[i])};
+            linearBloomBlockedHashSet(blocked, hash);
+        }
+
+        linearBloom *linear = linearBloomNew();
+        for (size_t i = 0; i < count; i++) {
+            uint64_t hash[2] = {hashes[i], binaryFuseMurmur64(hashes[i])};
+            linearBloomHashSet(linear, hash);
+        }
+
+        size_t hits = 0;
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < queries; i++) {
+            hits += binaryFuseContains(f8, probes[i]);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(queries, "binaryFuse8 check");
+        printf("  %.2f bits/key, FPP %.4f%%\n",
+               8.0 * binaryFuseBytes(f8) / count, 100.0 * hits / queries);
+
+        hits = 0;
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < queries; i++) {
+            hits += binaryFuseContains(f16, probes[i]);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(queries, "binaryFuse16 check");
+        printf("  %.2f bits/key, FPP %.4f%%\n",
+               8.0 * binaryFuseBytes(f16) / count, 100.0 * hits / queries);
+
+        hits = 0;
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < queries; i++) {
+            const uint64_t hash[2] = {probes[i], binaryFuseMurmur64(probes[i])};
+            hits += linearBloomBlockedHashCheck(blocked, hash);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(queries, "linearBloomBlocked check");
+        printf("  %.2f bits/key, FPP %.4f%%\n",
+               8.0 * linearBloomBlockedBytes(blocked) / count,
+               100.0 * hits / queries);
+
+        hits = 0;
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < queries; i++) {
+            uint64_t hash[2] = {probes[i], binaryFuseMurmur64(probes[i])};
+            hits += linearBloomHashCheck(linear, hash);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(queries, "linearBloom check");
+        printf("  %.2f bits/key, FPP %.4f%%\n",
+               8.0 * LINEARBLOOM_EXTENT_BYTES / count, 100.0 * hits / queries);
+
+        linearBloomFree(linear);
+        linearBloomBlockedFree(blocked);
+        binaryFuseFree(f16);
+        binaryFuseFree(f8);
+        zfree(probes);
+        zfree(hashes);
+    }
+
+    TEST_FINAL_RESULT;
+}
+#endif
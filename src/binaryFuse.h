@@ -0,0 +1,66 @@
+#pragma once
+
+#include "databox.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* binaryFuse is a static approximate membership filter (a 3-wise binary
+ * fuse filter, the successor of xor filters) built once from a fixed set
+ * of 64-bit key hashes.
+ *
+ * A query reads exactly three fingerprints and never returns a false
+ * negative for a key in the build set. False positive rate is 2^-bits:
+ * about 0.39% with 8-bit fingerprints and 0.0015% with 16-bit fingerprints,
+ * at roughly 9.0 and 18.0 bits of storage per key respectively.
+ *
+ * The filter can't be modified after construction; rebuild it from the
+ * source set (or use linearBloom) when keys change. */
+
+typedef struct binaryFuse binaryFuse;
+
+typedef enum binaryFuseBits {
+    BINARY_FUSE_8 = 8,
+    BINARY_FUSE_16 = 16,
+} binaryFuseBits;
+
+typedef struct multidict multidict;
+typedef struct multimap multimap;
+
+/* Build from 'count' key hashes. Duplicate hashes are allowed.
+ * Returns NULL if 'bits' is invalid, 'count' is above UINT32_MAX, or
+ * construction didn't converge (practically never). */
+binaryFuse *binaryFuseNew(const uint64_t *hashes, size_t count,
+                          binaryFuseBits bits);
+
+/* Build from every key of a multidict or multimap, hashed with
+ * binaryFuseHashKey(). Returns NULL if any key has a type it rejects. */
+binaryFuse *binaryFuseNewFromMultidict(multidict *d, binaryFuseBits bits);
+binaryFuse *binaryFuseNewFromMultimap(const multimap *m, binaryFuseBits bits);
+
+void binaryFuseFree(binaryFuse *f);
+
+/* Hash for a databox key, as used by the multidict/multimap builders.
+ * Bytes hash by content; numbers hash by value, so DATABOX_SIGNED(5) and
+ * DATABOX_UNSIGNED(5) produce the same hash. TRUE/FALSE/NULL/VOID hash by
+ * type alone and PTR/EXTERNAL REF by their raw value. Returns false for
+ * types without a self-contained value (ERROR, BYTES_VOID, BYTES_OFFSET,
+ * containers and aggregate markers). */
+bool binaryFuseHashKey(const databox *key, uint64_t *hash);
+
+bool binaryFuseContains(const binaryFuse *f, uint64_t hash);
+/* False for keys binaryFuseHashKey() rejects */
+bool binaryFuseContainsKey(const binaryFuse *f, const databox *key);
+
+size_t binaryFuseCount(const binaryFuse *f); /* Distinct keys in filter */
+binaryFuseBits binaryFuseFingerprintBits(const binaryFuse *f);
+size_t binaryFuseBytes(const binaryFuse *f);
+
+/* Serialization (for persist snapshots) */
+uint64_t binaryFuseSerializedSize(const binaryFuse *f);
+uint64_t binaryFuseSerialize(const binaryFuse *f, void *buf, uint64_t bufSize);
+binaryFuse *binaryFuseDeserialize(const void *buf, uint64_t bufSize);
+
+#ifdef DATAKIT_TEST
+int binaryFuseTest(int argc, char *argv[]);
+#endif
@@ -11,6 +11,7 @@
 #include "../deps/sha1/sha1.h"
 #include "atomPool.h"
 #include "bbits.h"
+#include "binaryFuse.h"
 #include "clusterRing.h"
 #include "compressionBench.h"
 #include "databox.h"
@@ -46,14 +47,17 @@
 #include "multilist.h"
 #include "multilistFull.h"
 #include "multilistMedium.h"
+#include "multilistQueue.h"
 #include "multilistSmall.h"
 #include "multilru.h"
+#include "multilruSim.h"
 #include "multimap.h"
 #include "multimapAtom.h"
 #include "multimapFull.h"
 #include "multimapMedium.h"
 #include "multimapSmall.h"
 #include "multiroar.h"
+#include "multiroarBsi.h"
 #include "offsetArray.h"
 #include "persist.h"
 #include "persist/flexP.h"
@@ -160,12 +164,14 @@ static int mdscBenchWrapper(int argc, char *argv[]) {
  */
 static const TestEntry testRegistry[] = {
     /* Core data structures */
-    T(flex), T(mflex), T_A(multilist, "ml"), T(multilistFull), T(multidict),
+    T(flex), T(mflex), T_A(multilist, "ml"), T(multilistFull),
+    T_A(multilistQueue, "mlq"), T(multidict),
     T_ADJ(multimap), T(multimapFull), T_A_ADJ(multimapAtom, "atom"),
     T_A_ADJ(stringPool, "sp,strpool"), T_A_ADJ(atomPool, "ap,apool"),
     T_ADJ(multiarray), T_ADJ(multiarraySmall), T_ADJ(multiarrayMedium),
-    T_ADJ(multiarrayLarge), T_ADJ(multiroar), T_A_ADJ(multiOrderedSet, "mos"),
-    T_A_ADJ(multilru, "lru,mlru"), T_ADJ(list), T_A_ADJ(ptrPrevNext, "ppn"),
+    T_ADJ(multiarrayLarge), T_ADJ(multiroar), T_A_ADJ(multiroarBsi, "bsi"),
+    T_A_ADJ(multiOrderedSet, "mos"), T_A_ADJ(multilru, "lru,mlru"),
+    T_A_ADJ(multilruSim, "lrusim"), T_ADJ(list), T_A_ADJ(ptrPrevNext, "ppn"),
 
     /* Numeric types */
     T_A(float16, "f16"), T_A_ADJ(floatExtended, "float128,fe"), T(intset),
@@ -181,7 +187,8 @@ static const TestEntry testRegistry[] = {
 
     /* Algorithms */
     T(dj), T_ADJ(dod), T_ADJ(xof), T_ADJ(intersectInt),
-    T_A_ADJ(hyperloglog, "hll"), T_A_ADJ(linearBloom, "bloom"), T(sha1),
+    T_A_ADJ(hyperloglog, "hll"), T_A_ADJ(linearBloom, "bloom"),
+    T_A_ADJ(binaryFuse, "fuse"), T(sha1),
 
     /* Timers */
     T_A_ADJ(timeUtil, "time"), T_A_ADJ(multiTimer, "timer"),
@@ -256,6 +263,11 @@ static void printUsage(const char *progname) {
            "iters\n");
     printf("                    speed --json       Output full benchmark as "
            "JSON\n");
+    printf("  lrusim <trace> [options]\n");
+    printf("                  Replay a key-access trace through multilru\n");
+    printf("                  and print hit ratio vs. capacity curves as "
+           "CSV\n");
+    printf("                  (run 'lrusim' without arguments for options)\n");
     printf("  help          Show this help message\n");
 }
 
@@ -464,6 +476,11 @@ int main(int argc, char *argv[]) {
         return dataspeed(mb, iters);
     }
 
+    /* lrusim <trace> [options] */
+    if (strcasecmp(cmd, "lrusim") == 0) {
+        return multilruSimMain(argc - 2, argv + 2);
+    }
+
     /* bench <name> */
     if (strcasecmp(cmd, "bench") == 0 && argc >= 3) {
         const TestEntry *t = findBench(argv[2]);
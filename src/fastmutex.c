@@ -187,7 +187,12 @@ int fastMutexCondTimedWait(fastCond *c, fastMutex *m, struct timespec *ts) {
         if (head) {
             assert(head == &waiter);
             *last = waiter.next;
-            if (c->w && waiter.next == NULL) {
+            if (last == &c->w) {
+                /* Removed the head; only the head tracks the tail. */
+                if (c->w) {
+                    c->w->tail = waiter.tail;
+                }
+            } else if (waiter.next == NULL) {
                 c->w->tail = lasttail;
             }
         } else {
@@ -208,7 +213,7 @@ int fastMutexCondTimedWait(fastCond *c, fastMutex *m, struct timespec *ts) {
     }
 
     fast_waiter_destroy(&waiter);
-    fast_mutex_lock(m);
+    fastMutexLock(m);
     return ret;
 }
 
@@ -224,7 +229,7 @@ void fastMutexCondSignal(fastCond *c) {
 
         c->w = waiter->next;
         if (c->w) {
-            assert(c->w->tail = waiter->tail);
+            assert(c->w->tail == waiter->tail);
         }
     }
 
@@ -239,3 +244,23 @@ void fastMutexCondSignal(fastCond *c) {
     pthread_cond_signal(&waiter->cond);
     pthread_mutex_unlock(&waiter->lock);
 }
+
+void fastMutexCondBroadcast(fastCond *c) {
+    pthread_mutex_lock(&c->m);
+    fastWaiter *waiter = c->w;
+    c->w = NULL;
+    pthread_mutex_unlock(&c->m);
+
+    while (waiter) {
+        /* Read 'next' before waking: the waiter owns its node and
+         * destroys it as soon as it observes the wakeup. */
+        fastWaiter *next = waiter->next;
+
+        pthread_mutex_lock(&waiter->lock);
+        waiter->waiting = false;
+        pthread_cond_signal(&waiter->cond);
+        pthread_mutex_unlock(&waiter->lock);
+
+        waiter = next;
+    }
+}
@@ -23,7 +23,7 @@ typedef struct fastCond {
 void fastMutexLockSlow(fastMutex *m);
 void fastMutexUnlockSlow(fastMutex *m);
 
-static inline void fast_mutex_lock(fastMutex *m) {
+static inline void fastMutexLock(fastMutex *m) {
     uint64_t prev = 0;
     if (!atomic_compare_exchange_weak_explicit(
             &m->word, &prev, 1, memory_order_acquire, memory_order_relaxed)) {
@@ -40,14 +40,11 @@ static inline void fastMutexUnlock(fastMutex *m) {
     }
 }
 
+/* Returns true if the lock was acquired. */
 static inline bool fastMutexTryLock(fastMutex *m) {
     uint64_t prev = 0;
-    if (!atomic_compare_exchange_weak_explicit(
-            &m->word, &prev, 1, memory_order_acquire, memory_order_relaxed)) {
-        return true;
-    }
-
-    return false;
+    return atomic_compare_exchange_strong_explicit(
+        &m->word, &prev, 1, memory_order_acquire, memory_order_relaxed);
 }
 
 static inline bool fastMutexIsLocked(fastMutex *m) {
@@ -59,6 +56,7 @@ static inline void fastMutexInit(fastMutex *m) {
 }
 
 static inline int fastMutexCondInit(fastCond *c, void *unused) {
+    (void)unused;
     int ret;
     ret = pthread_mutex_init(&c->m, NULL);
     if (ret) {
@@ -73,3 +71,4 @@ static inline int fastMutexCondInit(fastCond *c, void *unused) {
 int fastMutexCondWait(fastCond *c, fastMutex *m);
 int fastMutexCondTimedWait(fastCond *c, fastMutex *m, struct timespec *ts);
 void fastMutexCondSignal(fastCond *c);
+void fastMutexCondBroadcast(fastCond *c);
@@ -104,6 +104,13 @@
 
 #define FENWICK_DECLARE_FUNCTIONS(suffix, value_type, index_type_small,        \
                                   index_type_full)                             \
+    /* Bulk helpers on a raw BIT array (shared by both tiers) */               \
+    void FENWICK_NAME(suffix, TreeBuild)(value_type * tree,                    \
+                                         uint64_t capacity);                   \
+    void FENWICK_NAME(suffix, TreeUpdateMany)(                                 \
+        value_type * tree, uint64_t capacity, const size_t *indices,           \
+        const value_type *deltas, size_t count);                               \
+                                                                               \
     /* Small tier */                                                           \
     FENWICK_SMALL_TYPENAME(suffix) * FENWICK_NAME(suffix, SmallNew)(void);     \
     FENWICK_SMALL_TYPENAME(suffix) *                                           \
@@ -114,6 +121,9 @@
         FENWICK_NAME(suffix, SmallUpdate)(FENWICK_SMALL_TYPENAME(suffix) * fw, \
                                           index_type_small idx,                \
                                           value_type delta, bool *success);    \
+    FENWICK_SMALL_TYPENAME(suffix) * FENWICK_NAME(suffix, SmallUpdateMany)(    \
+        FENWICK_SMALL_TYPENAME(suffix) * fw, const size_t *indices,            \
+        const value_type *deltas, size_t count, bool *success);                \
     value_type FENWICK_NAME(suffix, SmallQuery)(                               \
         const FENWICK_SMALL_TYPENAME(suffix) * fw, index_type_small idx);      \
     value_type FENWICK_NAME(suffix, SmallRangeQuery)(                          \
@@ -149,6 +159,9 @@
         FENWICK_NAME(suffix, FullUpdate)(FENWICK_FULL_TYPENAME(suffix) * fw,   \
                                          index_type_full idx,                  \
                                          value_type delta, bool *success);     \
+    FENWICK_FULL_TYPENAME(suffix) * FENWICK_NAME(suffix, FullUpdateMany)(      \
+        FENWICK_FULL_TYPENAME(suffix) * fw, const size_t *indices,             \
+        const value_type *deltas, size_t count, bool *success);                \
     value_type FENWICK_NAME(suffix, FullQuery)(                                \
         const FENWICK_FULL_TYPENAME(suffix) * fw, index_type_full idx);        \
     value_type FENWICK_NAME(suffix, FullRangeQuery)(                           \
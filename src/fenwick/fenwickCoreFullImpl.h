@@ -71,25 +71,9 @@ FENWICK_IMPL_SCOPE FENWICK_FULL_TYPENAME(FENWICK_SUFFIX) *
     fw->maxCapacity = (FENWICK_INDEX_TYPE_FULL)-1;
     fw->tree = zcalloc(capacity, sizeof(FENWICK_VALUE_TYPE));
 
-    /* Build BIT */
-    for (FENWICK_INDEX_TYPE_FULL i = 0; i < count; i++) {
-        FENWICK_VALUE_TYPE value = values[i];
-        if (FENWICK_IS_FLOATING) {
-            if (value == (FENWICK_VALUE_TYPE)0.0) {
-                continue;
-            }
-        } else {
-            if (value == (FENWICK_VALUE_TYPE)0) {
-                continue;
-            }
-        }
-
-        FENWICK_INDEX_TYPE_FULL idx = i + 1;
-        while (idx <= capacity) {
-            fw->tree[idx - 1] += value;
-            idx = fenwickParent(idx);
-        }
-    }
+    /* Build BIT in place from the raw values (O(n)) */
+    memcpy(fw->tree, values, count * sizeof(FENWICK_VALUE_TYPE));
+    FENWICK_NAME(FENWICK_SUFFIX, TreeBuild)(fw->tree, capacity);
 
     return fw;
 }
@@ -99,23 +83,21 @@ FENWICK_IMPL_SCOPE FENWICK_FULL_TYPENAME(FENWICK_SUFFIX) *
     FENWICK_NAME(FENWICK_SUFFIX,
                  FullFromSmall)(FENWICK_SMALL_TYPENAME(FENWICK_SUFFIX) *
                                 small) {
-    if (!small) {
-        return FENWICK_NAME(FENWICK_SUFFIX, FullNew)();
-    }
-
-    /* Extract all values from Small tier */
-    FENWICK_INDEX_TYPE_SMALL count = small->count;
-    FENWICK_VALUE_TYPE *values = zmalloc(count * sizeof(FENWICK_VALUE_TYPE));
-
-    for (FENWICK_INDEX_TYPE_SMALL i = 0; i < count; i++) {
-        values[i] = FENWICK_NAME(FENWICK_SUFFIX, SmallGet)(small, i);
+    FENWICK_FULL_TYPENAME(FENWICK_SUFFIX) *full =
+        FENWICK_NAME(FENWICK_SUFFIX, FullNew)();
+    if (!small || small->capacity == 0) {
+        return full;
     }
 
-    /* Create Full from values */
-    FENWICK_FULL_TYPENAME(FENWICK_SUFFIX) *full =
-        FENWICK_NAME(FENWICK_SUFFIX, FullNewFromArray)(values, count);
+    /* Both tiers keep the same BIT layout over a power-of-2 capacity, so
+     * the Small tree is already a valid Full tree: copy it in O(n) instead
+     * of extracting and rebuilding every element. */
+    const FENWICK_INDEX_TYPE_SMALL capacity = small->capacity;
+    full->count = small->count;
+    full->capacity = capacity;
+    full->tree = zmalloc(capacity * sizeof(FENWICK_VALUE_TYPE));
+    memcpy(full->tree, small->tree, capacity * sizeof(FENWICK_VALUE_TYPE));
 
-    zfree(values);
     return full;
 }
 
@@ -233,6 +215,52 @@ FENWICK_IMPL_SCOPE FENWICK_FULL_TYPENAME(FENWICK_SUFFIX) *
     return fw;
 }
 
+/* Batch update: add deltas[i] to element indices[i] for each i in one
+ * pass over the tree (see TreeUpdateMany). Grows to fit the largest index
+ * the same way FullUpdate() does. */
+FENWICK_IMPL_SCOPE FENWICK_FULL_TYPENAME(FENWICK_SUFFIX) *
+    FENWICK_NAME(FENWICK_SUFFIX,
+                 FullUpdateMany)(FENWICK_FULL_TYPENAME(FENWICK_SUFFIX) * fw,
+                                 const size_t *indices,
+                                 const FENWICK_VALUE_TYPE *deltas,
+                                 size_t count, bool *success) {
+    if (!fw || (count > 0 && (!indices || !deltas))) {
+        if (success) {
+            *success = false;
+        }
+        return fw;
+    }
+
+    size_t maxIdx = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] > maxIdx) {
+            maxIdx = indices[i];
+        }
+    }
+
+    if (count > 0 && maxIdx >= fw->count) {
+        /* A zero-delta update resizes and extends count like any other */
+        bool grown = false;
+        fw = FENWICK_NAME(FENWICK_SUFFIX, FullUpdate)(
+            fw, (FENWICK_INDEX_TYPE_FULL)maxIdx,
+            FENWICK_ZERO(FENWICK_VALUE_TYPE, FENWICK_IS_FLOATING), &grown);
+        if (!grown) {
+            if (success) {
+                *success = false;
+            }
+            return fw;
+        }
+    }
+
+    FENWICK_NAME(FENWICK_SUFFIX, TreeUpdateMany)(fw->tree, fw->capacity,
+                                                 indices, deltas, count);
+
+    if (success) {
+        *success = true;
+    }
+    return fw;
+}
+
 /* Query: prefix sum */
 FENWICK_IMPL_SCOPE FENWICK_VALUE_TYPE FENWICK_NAME(FENWICK_SUFFIX, FullQuery)(
     const FENWICK_FULL_TYPENAME(FENWICK_SUFFIX) * fw,
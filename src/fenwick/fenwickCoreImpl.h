@@ -80,6 +80,200 @@
 #define FENWICK_MEDIUM_MAX_BYTES (16 * 1024 * 1024)
 #endif
 
+/* ====================================================================
+ * BULK HELPERS (shared by Small and Full tiers)
+ * ==================================================================== */
+
+/* Convert tree[0, capacity) from plain element values into BIT form in
+ * place. Nodes are visited in index order, so by the time node i is
+ * reached it already holds its full range sum and is pushed into its
+ * parent exactly once: O(capacity) instead of one O(log n) update per
+ * element. */
+FENWICK_IMPL_SCOPE void
+FENWICK_NAME(FENWICK_SUFFIX, TreeBuild)(FENWICK_VALUE_TYPE *tree,
+                                        uint64_t capacity) {
+    for (uint64_t i = 1; i <= capacity; i++) {
+        const uint64_t parent = fenwickParent(i);
+        if (parent <= capacity) {
+            tree[parent - 1] += tree[i - 1];
+        }
+    }
+}
+
+/* Inverse of TreeBuild(): undo the pushes in reverse order, leaving plain
+ * element values in tree[0, capacity). */
+static void FENWICK_NAME(FENWICK_SUFFIX, TreeUnbuild)(FENWICK_VALUE_TYPE *tree,
+                                                      uint64_t capacity) {
+    for (uint64_t i = capacity; i > 0; i--) {
+        const uint64_t parent = fenwickParent(i);
+        if (parent <= capacity) {
+            tree[parent - 1] -= tree[i - 1];
+        }
+    }
+}
+
+typedef struct FENWICK_NAME(FENWICK_SUFFIX, TreeDelta) {
+    uint64_t node; /* 1-based BIT node */
+    FENWICK_VALUE_TYPE delta;
+} FENWICK_NAME(FENWICK_SUFFIX, TreeDelta);
+
+/* Sort deltas by node: LSD radix sort, 8-bit digits, skipping digits
+ * shared by every node (nodes never exceed capacity, so a 1M-node tree
+ * pays for three digits at most). Returns whichever buffer holds the
+ * result. */
+static FENWICK_NAME(FENWICK_SUFFIX, TreeDelta) *
+    FENWICK_NAME(FENWICK_SUFFIX,
+                 TreeDeltaSort)(FENWICK_NAME(FENWICK_SUFFIX, TreeDelta) * src,
+                                FENWICK_NAME(FENWICK_SUFFIX, TreeDelta) * dst,
+                                size_t count) {
+    size_t hist[8][256] = {{0}};
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t node = src[i].node;
+        for (size_t d = 0; d < 8; d++) {
+            hist[d][(node >> (d * 8)) & 0xff]++;
+        }
+    }
+
+    for (size_t d = 0; d < 8; d++) {
+        const size_t shift = d * 8;
+        if (hist[d][(src[0].node >> shift) & 0xff] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; b++) {
+            const size_t c = hist[d][b];
+            hist[d][b] = offset;
+            offset += c;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            dst[hist[d][(src[i].node >> shift) & 0xff]++] = src[i];
+        }
+
+        FENWICK_NAME(FENWICK_SUFFIX, TreeDelta) *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    return src;
+}
+
+/* Add deltas[i] to element indices[i] for every i; all indices must be
+ * below 'capacity' and duplicates accumulate.
+ *
+ * Dense batches (count * log2(capacity) >= capacity) are cheaper as one
+ * linear pass: integer trees are unbuilt to plain values, patched, and
+ * rebuilt in place; floating-point trees instead build the deltas in a
+ * scratch tree and add it, so existing sums don't pick up rounding error.
+ *
+ * Sparse batches are sorted by index and propagated in one bottom-up
+ * sweep. Sums still owed to nodes above the current index wait on a small
+ * stack; every waiting node covers the current index, so the stack is a
+ * subset of a single update path (at most 64 nodes) and stays sorted with
+ * the lowest node on top. Each touched node is written once, where
+ * individual updates would rewrite shared ancestors once per delta. */
+FENWICK_IMPL_SCOPE void FENWICK_NAME(FENWICK_SUFFIX, TreeUpdateMany)(
+    FENWICK_VALUE_TYPE *tree, uint64_t capacity, const size_t *indices,
+    const FENWICK_VALUE_TYPE *deltas, size_t count) {
+    if (count == 0 || capacity == 0) {
+        return;
+    }
+
+    const uint64_t depth = 64 - __builtin_clzll(capacity);
+    if (count >= capacity / depth) {
+        if (FENWICK_IS_FLOATING) {
+            FENWICK_VALUE_TYPE *scratch =
+                zcalloc(capacity, sizeof(FENWICK_VALUE_TYPE));
+            for (size_t i = 0; i < count; i++) {
+                scratch[indices[i]] += deltas[i];
+            }
+
+            for (uint64_t i = 1; i <= capacity; i++) {
+                const uint64_t parent = fenwickParent(i);
+                if (parent <= capacity) {
+                    scratch[parent - 1] += scratch[i - 1];
+                }
+
+                tree[i - 1] += scratch[i - 1];
+            }
+
+            zfree(scratch);
+        } else {
+            FENWICK_NAME(FENWICK_SUFFIX, TreeUnbuild)(tree, capacity);
+            for (size_t i = 0; i < count; i++) {
+                tree[indices[i]] += deltas[i];
+            }
+
+            FENWICK_NAME(FENWICK_SUFFIX, TreeBuild)(tree, capacity);
+        }
+
+        return;
+    }
+
+    /* First half holds the batch, second half is radix scratch */
+    FENWICK_NAME(FENWICK_SUFFIX, TreeDelta) *batch =
+        zmalloc(2 * count * sizeof(*batch));
+    bool inOrder = true;
+    for (size_t i = 0; i < count; i++) {
+        batch[i].node = (uint64_t)indices[i] + 1;
+        batch[i].delta = deltas[i];
+        if (i > 0 && indices[i] < indices[i - 1]) {
+            inOrder = false;
+        }
+    }
+
+    const FENWICK_NAME(FENWICK_SUFFIX, TreeDelta) *sorted = batch;
+    if (!inOrder) {
+        sorted =
+            FENWICK_NAME(FENWICK_SUFFIX, TreeDeltaSort)(batch, batch + count,
+                                                        count);
+    }
+
+    uint64_t pendingNode[64];
+    FENWICK_VALUE_TYPE pendingDelta[64];
+    uint32_t pending = 0; /* pendingNode[pending - 1] is the lowest node */
+
+    for (size_t i = 0; i <= count; i++) {
+        /* Flush every waiting node below the next update; after the last
+         * update, flush everything. */
+        const uint64_t next = i < count ? sorted[i].node : UINT64_MAX;
+        while (pending > 0 && pendingNode[pending - 1] < next) {
+            pending--;
+            const uint64_t node = pendingNode[pending];
+            const FENWICK_VALUE_TYPE delta = pendingDelta[pending];
+            tree[node - 1] += delta;
+
+            const uint64_t parent = fenwickParent(node);
+            if (parent > capacity) {
+                continue;
+            }
+
+            if (pending > 0 && pendingNode[pending - 1] == parent) {
+                pendingDelta[pending - 1] += delta;
+            } else {
+                pendingNode[pending] = parent;
+                pendingDelta[pending] = delta;
+                pending++;
+            }
+        }
+
+        if (i == count) {
+            break;
+        }
+
+        if (pending > 0 && pendingNode[pending - 1] == next) {
+            pendingDelta[pending - 1] += sorted[i].delta;
+        } else {
+            pendingNode[pending] = next;
+            pendingDelta[pending] = sorted[i].delta;
+            pending++;
+        }
+    }
+
+    zfree(batch);
+}
+
 /* ====================================================================
  * SMALL TIER IMPLEMENTATIONS
  * ==================================================================== */
@@ -115,25 +309,9 @@ FENWICK_IMPL_SCOPE FENWICK_SMALL_TYPENAME(FENWICK_SUFFIX) *
     fw->count = count;
     fw->capacity = capacity;
 
-    /* Build BIT by applying updates */
-    for (FENWICK_INDEX_TYPE_SMALL i = 0; i < count; i++) {
-        FENWICK_VALUE_TYPE value = values[i];
-        if (FENWICK_IS_FLOATING) {
-            if (value == (FENWICK_VALUE_TYPE)0.0) {
-                continue;
-            }
-        } else {
-            if (value == (FENWICK_VALUE_TYPE)0) {
-                continue;
-            }
-        }
-
-        FENWICK_INDEX_TYPE_SMALL idx = i + 1;
-        while (idx <= capacity) {
-            fw->tree[idx - 1] += value;
-            idx = fenwickParent(idx);
-        }
-    }
+    /* Build BIT in place from the raw values (O(n)) */
+    memcpy(fw->tree, values, count * sizeof(FENWICK_VALUE_TYPE));
+    FENWICK_NAME(FENWICK_SUFFIX, TreeBuild)(fw->tree, capacity);
 
     return fw;
 }
@@ -246,6 +424,59 @@ FENWICK_IMPL_SCOPE FENWICK_SMALL_TYPENAME(FENWICK_SUFFIX) *
     return fw;
 }
 
+/* Batch update: add deltas[i] to element indices[i] for each i in one
+ * pass over the tree (see TreeUpdateMany). Grows to fit the largest index
+ * the same way SmallUpdate() does. */
+FENWICK_IMPL_SCOPE FENWICK_SMALL_TYPENAME(FENWICK_SUFFIX) *
+    FENWICK_NAME(FENWICK_SUFFIX,
+                 SmallUpdateMany)(FENWICK_SMALL_TYPENAME(FENWICK_SUFFIX) * fw,
+                                  const size_t *indices,
+                                  const FENWICK_VALUE_TYPE *deltas,
+                                  size_t count, bool *success) {
+    if (!fw || (count > 0 && (!indices || !deltas))) {
+        if (success) {
+            *success = false;
+        }
+        return fw;
+    }
+
+    size_t maxIdx = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] > maxIdx) {
+            maxIdx = indices[i];
+        }
+    }
+
+    if (count > 0 && maxIdx >= fw->count) {
+        if (maxIdx >= (FENWICK_INDEX_TYPE_SMALL)-1) {
+            if (success) {
+                *success = false;
+            }
+            return fw;
+        }
+
+        /* A zero-delta update resizes and extends count like any other */
+        bool grown = false;
+        fw = FENWICK_NAME(FENWICK_SUFFIX, SmallUpdate)(
+            fw, (FENWICK_INDEX_TYPE_SMALL)maxIdx,
+            FENWICK_ZERO(FENWICK_VALUE_TYPE, FENWICK_IS_FLOATING), &grown);
+        if (!grown) {
+            if (success) {
+                *success = false;
+            }
+            return fw;
+        }
+    }
+
+    FENWICK_NAME(FENWICK_SUFFIX, TreeUpdateMany)(fw->tree, fw->capacity,
+                                                 indices, deltas, count);
+
+    if (success) {
+        *success = true;
+    }
+    return fw;
+}
+
 /* Query: compute prefix sum [0, idx] */
 FENWICK_IMPL_SCOPE FENWICK_VALUE_TYPE FENWICK_NAME(FENWICK_SUFFIX, SmallQuery)(
     const FENWICK_SMALL_TYPENAME(FENWICK_SUFFIX) * fw,
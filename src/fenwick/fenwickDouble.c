@@ -41,6 +41,23 @@ static void *fenwickDoubleUpgradeSmallToFull(fenwickDoubleSmall *small) {
     return FENWICK_DOUBLE_TAG(full, FENWICK_DOUBLE_TYPE_FULL);
 }
 
+/* Create fenwickDouble from 'count' initial values in O(n) */
+void *fenwickDoubleNewFromArray(const double *values, size_t count) {
+    if (count * sizeof(double) > 128 * 1024) {
+        fenwickDoubleFull *full =
+            fenwickDoubleFullNewFromArray(values, (uint64_t)count);
+        return FENWICK_DOUBLE_TAG(full, FENWICK_DOUBLE_TYPE_FULL);
+    }
+
+    fenwickDoubleSmall *small =
+        fenwickDoubleSmallNewFromArray(values, (uint32_t)count);
+    if (fenwickDoubleSmallShouldUpgrade(small)) {
+        return fenwickDoubleUpgradeSmallToFull(small);
+    }
+
+    return FENWICK_DOUBLE_TAG(small, FENWICK_DOUBLE_TYPE_SMALL);
+}
+
 /* Update with tier transitions (2-TIER) */
 bool fenwickDoubleUpdate(void **fw, size_t idx, double delta) {
     if (!fw) {
@@ -88,6 +105,60 @@ bool fenwickDoubleUpdate(void **fw, size_t idx, double delta) {
     return false;
 }
 
+/* Batch update: add deltas[i] at indices[i] in a single pass */
+bool fenwickDoubleUpdateMany(void **fw, const size_t *indices,
+                             const double *deltas, size_t count) {
+    if (!fw || (count > 0 && (!indices || !deltas))) {
+        return false;
+    }
+
+    if (!*fw) {
+        *fw = fenwickDoubleNew();
+    }
+
+    size_t maxIdx = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] > maxIdx) {
+            maxIdx = indices[i];
+        }
+    }
+
+    fenwickDoubleType type = FENWICK_DOUBLE_TYPE(*fw);
+    void *ptr = FENWICK_DOUBLE_UNTAG(*fw);
+
+    switch (type) {
+    case FENWICK_DOUBLE_TYPE_SMALL: {
+        fenwickDoubleSmall *small = (fenwickDoubleSmall *)ptr;
+
+        /* Same upgrade rule as fenwickDoubleUpdate(), for the largest index */
+        if (fenwickDoubleSmallShouldUpgrade(small) ||
+            maxIdx >= fenwickDoubleSmallCount(small) + 1000 ||
+            maxIdx * sizeof(double) > 128 * 1024) {
+            *fw = fenwickDoubleUpgradeSmallToFull(small);
+            return fenwickDoubleUpdateMany(fw, indices, deltas, count);
+        }
+
+        bool success = false;
+        fenwickDoubleSmall *newSmall = fenwickDoubleSmallUpdateMany(
+            small, indices, deltas, count, &success);
+        *fw = FENWICK_DOUBLE_TAG(newSmall, FENWICK_DOUBLE_TYPE_SMALL);
+        return success;
+    }
+
+    case FENWICK_DOUBLE_TYPE_FULL: {
+        fenwickDoubleFull *full = (fenwickDoubleFull *)ptr;
+
+        bool success = false;
+        fenwickDoubleFull *newFull =
+            fenwickDoubleFullUpdateMany(full, indices, deltas, count, &success);
+        *fw = FENWICK_DOUBLE_TAG(newFull, FENWICK_DOUBLE_TYPE_FULL);
+        return success;
+    }
+    }
+
+    return false;
+}
+
 /* Query prefix sum */
 double fenwickDoubleQuery(const void *fw, size_t idx) {
     if (!fw) {
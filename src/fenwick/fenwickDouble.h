@@ -35,8 +35,11 @@ typedef enum fenwickDoubleType {
 
 /* Public API - 2-tier automatic tier management */
 void *fenwickDoubleNew(void);
+void *fenwickDoubleNewFromArray(const double *values, size_t count);
 void fenwickDoubleFree(void *fw);
 bool fenwickDoubleUpdate(void **fw, size_t idx, double delta);
+bool fenwickDoubleUpdateMany(void **fw, const size_t *indices,
+                             const double *deltas, size_t count);
 double fenwickDoubleQuery(const void *fw, size_t idx);
 double fenwickDoubleRangeQuery(const void *fw, size_t left, size_t right);
 double fenwickDoubleGet(const void *fw, size_t idx);
@@ -41,6 +41,23 @@ static void *fenwickFloatUpgradeSmallToFull(fenwickFloatSmall *small) {
     return FENWICK_FLOAT_TAG(full, FENWICK_FLOAT_TYPE_FULL);
 }
 
+/* Create fenwickFloat from 'count' initial values in O(n) */
+void *fenwickFloatNewFromArray(const float *values, size_t count) {
+    if (count * sizeof(float) > 128 * 1024) {
+        fenwickFloatFull *full =
+            fenwickFloatFullNewFromArray(values, (uint64_t)count);
+        return FENWICK_FLOAT_TAG(full, FENWICK_FLOAT_TYPE_FULL);
+    }
+
+    fenwickFloatSmall *small =
+        fenwickFloatSmallNewFromArray(values, (uint32_t)count);
+    if (fenwickFloatSmallShouldUpgrade(small)) {
+        return fenwickFloatUpgradeSmallToFull(small);
+    }
+
+    return FENWICK_FLOAT_TAG(small, FENWICK_FLOAT_TYPE_SMALL);
+}
+
 /* Update with tier transitions (2-TIER) */
 bool fenwickFloatUpdate(void **fw, size_t idx, float delta) {
     if (!fw) {
@@ -88,6 +105,60 @@ bool fenwickFloatUpdate(void **fw, size_t idx, float delta) {
     return false;
 }
 
+/* Batch update: add deltas[i] at indices[i] in a single pass */
+bool fenwickFloatUpdateMany(void **fw, const size_t *indices,
+                            const float *deltas, size_t count) {
+    if (!fw || (count > 0 && (!indices || !deltas))) {
+        return false;
+    }
+
+    if (!*fw) {
+        *fw = fenwickFloatNew();
+    }
+
+    size_t maxIdx = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] > maxIdx) {
+            maxIdx = indices[i];
+        }
+    }
+
+    fenwickFloatType type = FENWICK_FLOAT_TYPE(*fw);
+    void *ptr = FENWICK_FLOAT_UNTAG(*fw);
+
+    switch (type) {
+    case FENWICK_FLOAT_TYPE_SMALL: {
+        fenwickFloatSmall *small = (fenwickFloatSmall *)ptr;
+
+        /* Same upgrade rule as fenwickFloatUpdate(), for the largest index */
+        if (fenwickFloatSmallShouldUpgrade(small) ||
+            maxIdx >= fenwickFloatSmallCount(small) + 1000 ||
+            maxIdx * sizeof(float) > 128 * 1024) {
+            *fw = fenwickFloatUpgradeSmallToFull(small);
+            return fenwickFloatUpdateMany(fw, indices, deltas, count);
+        }
+
+        bool success = false;
+        fenwickFloatSmall *newSmall = fenwickFloatSmallUpdateMany(
+            small, indices, deltas, count, &success);
+        *fw = FENWICK_FLOAT_TAG(newSmall, FENWICK_FLOAT_TYPE_SMALL);
+        return success;
+    }
+
+    case FENWICK_FLOAT_TYPE_FULL: {
+        fenwickFloatFull *full = (fenwickFloatFull *)ptr;
+
+        bool success = false;
+        fenwickFloatFull *newFull =
+            fenwickFloatFullUpdateMany(full, indices, deltas, count, &success);
+        *fw = FENWICK_FLOAT_TAG(newFull, FENWICK_FLOAT_TYPE_FULL);
+        return success;
+    }
+    }
+
+    return false;
+}
+
 /* Query prefix sum */
 float fenwickFloatQuery(const void *fw, size_t idx) {
     if (!fw) {
@@ -35,8 +35,11 @@ typedef enum fenwickFloatType {
 
 /* Public API - 2-tier automatic tier management */
 void *fenwickFloatNew(void);
+void *fenwickFloatNewFromArray(const float *values, size_t count);
 void fenwickFloatFree(void *fw);
 bool fenwickFloatUpdate(void **fw, size_t idx, float delta);
+bool fenwickFloatUpdateMany(void **fw, const size_t *indices,
+                            const float *deltas, size_t count);
 float fenwickFloatQuery(const void *fw, size_t idx);
 float fenwickFloatRangeQuery(const void *fw, size_t left, size_t right);
 float fenwickFloatGet(const void *fw, size_t idx);
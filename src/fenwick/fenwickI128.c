@@ -43,6 +43,23 @@ static void *fenwickI128UpgradeSmallToFull(fenwickI128Small *small) {
     return FENWICK_I128_TAG(full, FENWICK_I128_TYPE_FULL);
 }
 
+/* Create fenwickI128 from 'count' initial values in O(n) */
+void *fenwickI128NewFromArray(const __int128_t *values, size_t count) {
+    if (count * sizeof(__int128_t) > 128 * 1024) {
+        fenwickI128Full *full =
+            fenwickI128FullNewFromArray(values, (uint64_t)count);
+        return FENWICK_I128_TAG(full, FENWICK_I128_TYPE_FULL);
+    }
+
+    fenwickI128Small *small =
+        fenwickI128SmallNewFromArray(values, (uint32_t)count);
+    if (fenwickI128SmallShouldUpgrade(small)) {
+        return fenwickI128UpgradeSmallToFull(small);
+    }
+
+    return FENWICK_I128_TAG(small, FENWICK_I128_TYPE_SMALL);
+}
+
 /* Update with tier transitions (2-TIER) */
 bool fenwickI128Update(void **fw, size_t idx, __int128_t delta) {
     if (!fw) {
@@ -90,6 +107,60 @@ bool fenwickI128Update(void **fw, size_t idx, __int128_t delta) {
     return false;
 }
 
+/* Batch update: add deltas[i] at indices[i] in a single pass */
+bool fenwickI128UpdateMany(void **fw, const size_t *indices,
+                           const __int128_t *deltas, size_t count) {
+    if (!fw || (count > 0 && (!indices || !deltas))) {
+        return false;
+    }
+
+    if (!*fw) {
+        *fw = fenwickI128New();
+    }
+
+    size_t maxIdx = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] > maxIdx) {
+            maxIdx = indices[i];
+        }
+    }
+
+    fenwickI128Type type = FENWICK_I128_TYPE(*fw);
+    void *ptr = FENWICK_I128_UNTAG(*fw);
+
+    switch (type) {
+    case FENWICK_I128_TYPE_SMALL: {
+        fenwickI128Small *small = (fenwickI128Small *)ptr;
+
+        /* Same upgrade rule as fenwickI128Update(), for the largest index */
+        if (fenwickI128SmallShouldUpgrade(small) ||
+            maxIdx >= fenwickI128SmallCount(small) + 1000 ||
+            maxIdx * sizeof(__int128_t) > 128 * 1024) {
+            *fw = fenwickI128UpgradeSmallToFull(small);
+            return fenwickI128UpdateMany(fw, indices, deltas, count);
+        }
+
+        bool success = false;
+        fenwickI128Small *newSmall =
+            fenwickI128SmallUpdateMany(small, indices, deltas, count, &success);
+        *fw = FENWICK_I128_TAG(newSmall, FENWICK_I128_TYPE_SMALL);
+        return success;
+    }
+
+    case FENWICK_I128_TYPE_FULL: {
+        fenwickI128Full *full = (fenwickI128Full *)ptr;
+
+        bool success = false;
+        fenwickI128Full *newFull =
+            fenwickI128FullUpdateMany(full, indices, deltas, count, &success);
+        *fw = FENWICK_I128_TAG(newFull, FENWICK_I128_TYPE_FULL);
+        return success;
+    }
+    }
+
+    return false;
+}
+
 /* Query prefix sum */
 __int128_t fenwickI128Query(const void *fw, size_t idx) {
     if (!fw) {
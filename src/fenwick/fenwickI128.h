@@ -37,8 +37,11 @@ typedef enum fenwickI128Type {
 
 /* Public API - 2-tier automatic tier management */
 void *fenwickI128New(void);
+void *fenwickI128NewFromArray(const __int128_t *values, size_t count);
 void fenwickI128Free(void *fw);
 bool fenwickI128Update(void **fw, size_t idx, __int128_t delta);
+bool fenwickI128UpdateMany(void **fw, const size_t *indices,
+                           const __int128_t *deltas, size_t count);
 __int128_t fenwickI128Query(const void *fw, size_t idx);
 __int128_t fenwickI128RangeQuery(const void *fw, size_t left, size_t right);
 __int128_t fenwickI128Get(const void *fw, size_t idx);
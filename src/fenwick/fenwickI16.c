@@ -41,6 +41,23 @@ static void *fenwickI16UpgradeSmallToFull(fenwickI16Small *small) {
     return FENWICK_I16_TAG(full, FENWICK_I16_TYPE_FULL);
 }
 
+/* Create fenwickI16 from 'count' initial values in O(n) */
+void *fenwickI16NewFromArray(const int16_t *values, size_t count) {
+    if (count * sizeof(int16_t) > 128 * 1024) {
+        fenwickI16Full *full =
+            fenwickI16FullNewFromArray(values, (uint64_t)count);
+        return FENWICK_I16_TAG(full, FENWICK_I16_TYPE_FULL);
+    }
+
+    fenwickI16Small *small =
+        fenwickI16SmallNewFromArray(values, (uint32_t)count);
+    if (fenwickI16SmallShouldUpgrade(small)) {
+        return fenwickI16UpgradeSmallToFull(small);
+    }
+
+    return FENWICK_I16_TAG(small, FENWICK_I16_TYPE_SMALL);
+}
+
 /* Update with tier transitions (2-TIER) */
 bool fenwickI16Update(void **fw, size_t idx, int16_t delta) {
     if (!fw) {
@@ -88,6 +105,60 @@ bool fenwickI16Update(void **fw, size_t idx, int16_t delta) {
     return false;
 }
 
+/* Batch update: add deltas[i] at indices[i] in a single pass */
+bool fenwickI16UpdateMany(void **fw, const size_t *indices,
+                          const int16_t *deltas, size_t count) {
+    if (!fw || (count > 0 && (!indices || !deltas))) {
+        return false;
+    }
+
+    if (!*fw) {
+        *fw = fenwickI16New();
+    }
+
+    size_t maxIdx = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] > maxIdx) {
+            maxIdx = indices[i];
+        }
+    }
+
+    fenwickI16Type type = FENWICK_I16_TYPE(*fw);
+    void *ptr = FENWICK_I16_UNTAG(*fw);
+
+    switch (type) {
+    case FENWICK_I16_TYPE_SMALL: {
+        fenwickI16Small *small = (fenwickI16Small *)ptr;
+
+        /* Same upgrade rule as fenwickI16Update(), for the largest index */
+        if (fenwickI16SmallShouldUpgrade(small) ||
+            maxIdx >= fenwickI16SmallCount(small) + 1000 ||
+            maxIdx * sizeof(int16_t) > 128 * 1024) {
+            *fw = fenwickI16UpgradeSmallToFull(small);
+            return fenwickI16UpdateMany(fw, indices, deltas, count);
+        }
+
+        bool success = false;
+        fenwickI16Small *newSmall =
+            fenwickI16SmallUpdateMany(small, indices, deltas, count, &success);
+        *fw = FENWICK_I16_TAG(newSmall, FENWICK_I16_TYPE_SMALL);
+        return success;
+    }
+
+    case FENWICK_I16_TYPE_FULL: {
+        fenwickI16Full *full = (fenwickI16Full *)ptr;
+
+        bool success = false;
+        fenwickI16Full *newFull =
+            fenwickI16FullUpdateMany(full, indices, deltas, count, &success);
+        *fw = FENWICK_I16_TAG(newFull, FENWICK_I16_TYPE_FULL);
+        return success;
+    }
+    }
+
+    return false;
+}
+
 /* Query prefix sum */
 int16_t fenwickI16Query(const void *fw, size_t idx) {
     if (!fw) {
@@ -35,8 +35,11 @@ typedef enum fenwickI16Type {
 
 /* Public API - 2-tier automatic tier management */
 void *fenwickI16New(void);
+void *fenwickI16NewFromArray(const int16_t *values, size_t count);
 void fenwickI16Free(void *fw);
 bool fenwickI16Update(void **fw, size_t idx, int16_t delta);
+bool fenwickI16UpdateMany(void **fw, const size_t *indices,
+                          const int16_t *deltas, size_t count);
 int16_t fenwickI16Query(const void *fw, size_t idx);
 int16_t fenwickI16RangeQuery(const void *fw, size_t left, size_t right);
 int16_t fenwickI16Get(const void *fw, size_t idx);
@@ -41,6 +41,23 @@ static void *fenwickI32UpgradeSmallToFull(fenwickI32Small *small) {
     return FENWICK_I32_TAG(full, FENWICK_I32_TYPE_FULL);
 }
 
+/* Create fenwickI32 from 'count' initial values in O(n) */
+void *fenwickI32NewFromArray(const int32_t *values, size_t count) {
+    if (count * sizeof(int32_t) > 128 * 1024) {
+        fenwickI32Full *full =
+            fenwickI32FullNewFromArray(values, (uint64_t)count);
+        return FENWICK_I32_TAG(full, FENWICK_I32_TYPE_FULL);
+    }
+
+    fenwickI32Small *small =
+        fenwickI32SmallNewFromArray(values, (uint32_t)count);
+    if (fenwickI32SmallShouldUpgrade(small)) {
+        return fenwickI32UpgradeSmallToFull(small);
+    }
+
+    return FENWICK_I32_TAG(small, FENWICK_I32_TYPE_SMALL);
+}
+
 /* Update with tier transitions (2-TIER) */
 bool fenwickI32Update(void **fw, size_t idx, int32_t delta) {
     if (!fw) {
@@ -88,6 +105,60 @@ bool fenwickI32Update(void **fw, size_t idx, int32_t delta) {
     return false;
 }
 
+/* Batch update: add deltas[i] at indices[i] in a single pass */
+bool fenwickI32UpdateMany(void **fw, const size_t *indices,
+                          const int32_t *deltas, size_t count) {
+    if (!fw || (count > 0 && (!indices || !deltas))) {
+        return false;
+    }
+
+    if (!*fw) {
+        *fw = fenwickI32New();
+    }
+
+    size_t maxIdx = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] > maxIdx) {
+            maxIdx = indices[i];
+        }
+    }
+
+    fenwickI32Type type = FENWICK_I32_TYPE(*fw);
+    void *ptr = FENWICK_I32_UNTAG(*fw);
+
+    switch (type) {
+    case FENWICK_I32_TYPE_SMALL: {
+        fenwickI32Small *small = (fenwickI32Small *)ptr;
+
+        /* Same upgrade rule as fenwickI32Update(), for the largest index */
+        if (fenwickI32SmallShouldUpgrade(small) ||
+            maxIdx >= fenwickI32SmallCount(small) + 1000 ||
+            maxIdx * sizeof(int32_t) > 128 * 1024) {
+            *fw = fenwickI32UpgradeSmallToFull(small);
+            return fenwickI32UpdateMany(fw, indices, deltas, count);
+        }
+
+        bool success = false;
+        fenwickI32Small *newSmall =
+            fenwickI32SmallUpdateMany(small, indices, deltas, count, &success);
+        *fw = FENWICK_I32_TAG(newSmall, FENWICK_I32_TYPE_SMALL);
+        return success;
+    }
+
+    case FENWICK_I32_TYPE_FULL: {
+        fenwickI32Full *full = (fenwickI32Full *)ptr;
+
+        bool success = false;
+        fenwickI32Full *newFull =
+            fenwickI32FullUpdateMany(full, indices, deltas, count, &success);
+        *fw = FENWICK_I32_TAG(newFull, FENWICK_I32_TYPE_FULL);
+        return success;
+    }
+    }
+
+    return false;
+}
+
 /* Query prefix sum */
 int32_t fenwickI32Query(const void *fw, size_t idx) {
     if (!fw) {
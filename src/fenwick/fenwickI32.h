@@ -35,8 +35,11 @@ typedef enum fenwickI32Type {
 
 /* Public API - 2-tier automatic tier management */
 void *fenwickI32New(void);
+void *fenwickI32NewFromArray(const int32_t *values, size_t count);
 void fenwickI32Free(void *fw);
 bool fenwickI32Update(void **fw, size_t idx, int32_t delta);
+bool fenwickI32UpdateMany(void **fw, const size_t *indices,
+                          const int32_t *deltas, size_t count);
 int32_t fenwickI32Query(const void *fw, size_t idx);
 int32_t fenwickI32RangeQuery(const void *fw, size_t left, size_t right);
 int32_t fenwickI32Get(const void *fw, size_t idx);
@@ -41,6 +41,23 @@ static void *fenwickI64UpgradeSmallToFull(fenwickI64Small *small) {
     return FENWICK_I64_TAG(full, FENWICK_I64_TYPE_FULL);
 }
 
+/* Create fenwickI64 from 'count' initial values in O(n) */
+void *fenwickI64NewFromArray(const int64_t *values, size_t count) {
+    if (count * sizeof(int64_t) > 128 * 1024) {
+        fenwickI64Full *full =
+            fenwickI64FullNewFromArray(values, (uint64_t)count);
+        return FENWICK_I64_TAG(full, FENWICK_I64_TYPE_FULL);
+    }
+
+    fenwickI64Small *small =
+        fenwickI64SmallNewFromArray(values, (uint32_t)count);
+    if (fenwickI64SmallShouldUpgrade(small)) {
+        return fenwickI64UpgradeSmallToFull(small);
+    }
+
+    return FENWICK_I64_TAG(small, FENWICK_I64_TYPE_SMALL);
+}
+
 /* Update with tier transitions (2-TIER) */
 bool fenwickI64Update(void **fw, size_t idx, int64_t delta) {
     if (!fw) {
@@ -88,6 +105,60 @@ bool fenwickI64Update(void **fw, size_t idx, int64_t delta) {
     return false;
 }
 
+/* Batch update: add deltas[i] at indices[i] in a single pass */
+bool fenwickI64UpdateMany(void **fw, const size_t *indices,
+                          const int64_t *deltas, size_t count) {
+    if (!fw || (count > 0 && (!indices || !deltas))) {
+        return false;
+    }
+
+    if (!*fw) {
+        *fw = fenwickI64New();
+    }
+
+    size_t maxIdx = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] > maxIdx) {
+            maxIdx = indices[i];
+        }
+    }
+
+    fenwickI64Type type = FENWICK_I64_TYPE(*fw);
+    void *ptr = FENWICK_I64_UNTAG(*fw);
+
+    switch (type) {
+    case FENWICK_I64_TYPE_SMALL: {
+        fenwickI64Small *small = (fenwickI64Small *)ptr;
+
+        /* Same upgrade rule as fenwickI64Update(), for the largest index */
+        if (fenwickI64SmallShouldUpgrade(small) ||
+            maxIdx >= fenwickI64SmallCount(small) + 1000 ||
+            maxIdx * sizeof(int64_t) > 128 * 1024) {
+            *fw = fenwickI64UpgradeSmallToFull(small);
+            return fenwickI64UpdateMany(fw, indices, deltas, count);
+        }
+
+        bool success = false;
+        fenwickI64Small *newSmall =
+            fenwickI64SmallUpdateMany(small, indices, deltas, count, &success);
+        *fw = FENWICK_I64_TAG(newSmall, FENWICK_I64_TYPE_SMALL);
+        return success;
+    }
+
+    case FENWICK_I64_TYPE_FULL: {
+        fenwickI64Full *full = (fenwickI64Full *)ptr;
+
+        bool success = false;
+        fenwickI64Full *newFull =
+            fenwickI64FullUpdateMany(full, indices, deltas, count, &success);
+        *fw = FENWICK_I64_TAG(newFull, FENWICK_I64_TYPE_FULL);
+        return success;
+    }
+    }
+
+    return false;
+}
+
 /* Query prefix sum */
 int64_t fenwickI64Query(const void *fw, size_t idx) {
     if (!fw) {
@@ -35,8 +35,11 @@ typedef enum fenwickI64Type {
 
 /* Public API - 2-tier automatic tier management */
 void *fenwickI64New(void);
+void *fenwickI64NewFromArray(const int64_t *values, size_t count);
 void fenwickI64Free(void *fw);
 bool fenwickI64Update(void **fw, size_t idx, int64_t delta);
+bool fenwickI64UpdateMany(void **fw, const size_t *indices,
+                          const int64_t *deltas, size_t count);
 int64_t fenwickI64Query(const void *fw, size_t idx);
 int64_t fenwickI64RangeQuery(const void *fw, size_t left, size_t right);
 int64_t fenwickI64Get(const void *fw, size_t idx);
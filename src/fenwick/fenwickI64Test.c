@@ -165,11 +165,7 @@ int fenwickI64Test(int argc, char *argv[]) {
 
     TEST("basic: prefix sum correctness") {
         int64_t values[] = {3, 1, 4, 1, 5, 9, 2, 6};
-        /* Note: Can't use fenwickI64NewFromArray yet - need to implement */
-        void *fw = fenwickI64New();
-        for (int i = 0; i < 8; i++) {
-            fenwickI64Update(&fw, i, values[i]);
-        }
+        void *fw = fenwickI64NewFromArray(values, 8);
 
         /* Prefix sums: [3, 4, 8, 9, 14, 23, 25, 31] */
         int64_t expected[] = {3, 4, 8, 9, 14, 23, 25, 31};
@@ -737,6 +733,201 @@ int fenwickI64Test(int argc, char *argv[]) {
         fenwickI64Free(fw);
     }
 
+    /* =================================================================
+     * CATEGORY 7: BULK OPERATIONS (4 tests)
+     * ================================================================= */
+
+    TEST("bulk: newFromArray matches per-element updates") {
+        /* Covers empty, power-of-2 edges, and both tiers */
+        const size_t sizes[] = {0, 1, 2, 7, 8, 9, 1000, 16384, 50000};
+        uint64_t seed = 424242;
+
+        for (size_t s = 0; s < COUNT_ARRAY(sizes); s++) {
+            const size_t n = sizes[s];
+            int64_t *values = zcalloc(n + 1, sizeof(int64_t));
+            for (size_t i = 0; i < n; i++) {
+                values[i] = (int64_t)(randSeed(&seed) % 2001) - 1000;
+                if (i % 5 == 0) {
+                    values[i] = 0; /* Zeros cover sparse inputs too */
+                }
+            }
+
+            void *bulk = fenwickI64NewFromArray(values, n);
+            void *ref = fenwickI64New();
+            for (size_t i = 0; i < n; i++) {
+                fenwickI64Update(&ref, i, values[i]);
+            }
+
+            if (fenwickI64Count(bulk) != n) {
+                ERR("[%zu] count should be %zu, got %zu", n, n,
+                    fenwickI64Count(bulk));
+            }
+
+            if (FENWICK_I64_TYPE(bulk) != FENWICK_I64_TYPE(ref)) {
+                ERR("[%zu] tier %d differs from incremental tier %d", n,
+                    FENWICK_I64_TYPE(bulk), FENWICK_I64_TYPE(ref));
+            }
+
+            for (size_t i = 0; i < n; i++) {
+                if (fenwickI64Query(bulk, i) != fenwickI64Query(ref, i)) {
+                    ERR("[%zu] prefix sum at %zu: %" PRId64 " != %" PRId64, n,
+                        i, fenwickI64Query(bulk, i), fenwickI64Query(ref, i));
+                    break;
+                }
+
+                if (fenwickI64Get(bulk, i) != values[i]) {
+                    ERR("[%zu] element %zu should be %" PRId64 ", got %" PRId64,
+                        n, i, values[i], fenwickI64Get(bulk, i));
+                    break;
+                }
+            }
+
+            /* Tree must stay fully usable, including growth past capacity */
+            fenwickI64Update(&bulk, n + 3, 11);
+            fenwickI64Update(&ref, n + 3, 11);
+            if (fenwickI64Query(bulk, n + 3) != fenwickI64Query(ref, n + 3)) {
+                ERR("[%zu] prefix sum after growth: %" PRId64 " != %" PRId64, n,
+                    fenwickI64Query(bulk, n + 3), fenwickI64Query(ref, n + 3));
+            }
+
+            fenwickI64Free(bulk);
+            fenwickI64Free(ref);
+            zfree(values);
+        }
+    }
+
+    TEST("bulk: updateMany matches sequential updates") {
+        const size_t sizes[] = {16, 1000, 40000};
+        uint64_t seed = 777;
+
+        for (size_t s = 0; s < COUNT_ARRAY(sizes); s++) {
+            const size_t n = sizes[s];
+            const size_t batch = n * 2; /* Forces duplicate indices */
+            size_t *indices = zmalloc(batch * sizeof(*indices));
+            int64_t *deltas = zmalloc(batch * sizeof(*deltas));
+
+            int64_t *init = zcalloc(n, sizeof(int64_t));
+            for (size_t i = 0; i < n; i++) {
+                init[i] = (int64_t)(randSeed(&seed) % 100);
+            }
+
+            void *bulk = fenwickI64NewFromArray(init, n);
+            void *ref = fenwickI64NewFromArray(init, n);
+
+            /* Rounds 0-2 are dense (linear rebuild): unsorted, sorted, and
+             * a single repeated index. Rounds 3-4 are sparse (sorted sweep):
+             * unsorted, then sorted. */
+            for (int round = 0; round < 5; round++) {
+                const size_t used = round < 3 ? batch : n / 64 + 1;
+                for (size_t i = 0; i < used; i++) {
+                    indices[i] = round == 2 ? n / 2 : randSeed(&seed) % n;
+                    deltas[i] = (int64_t)(randSeed(&seed) % 201) - 100;
+                }
+
+                if (round == 1 || round == 4) {
+                    for (size_t i = 0; i < used; i++) {
+                        indices[i] = i * n / used;
+                    }
+                }
+
+                if (!fenwickI64UpdateMany(&bulk, indices, deltas, used)) {
+                    ERR("[%zu] updateMany failed in round %d", n, round);
+                }
+
+                for (size_t i = 0; i < used; i++) {
+                    fenwickI64Update(&ref, indices[i], deltas[i]);
+                }
+
+                for (size_t i = 0; i < n; i++) {
+                    if (fenwickI64Query(bulk, i) != fenwickI64Query(ref, i)) {
+                        ERR("[%zu] round %d prefix sum at %zu: %" PRId64
+                            " != %" PRId64,
+                            n, round, i, fenwickI64Query(bulk, i),
+                            fenwickI64Query(ref, i));
+                        break;
+                    }
+                }
+            }
+
+            fenwickI64Free(bulk);
+            fenwickI64Free(ref);
+            zfree(indices);
+            zfree(deltas);
+            zfree(init);
+        }
+    }
+
+    TEST("bulk: updateMany grows and upgrades like update") {
+        void *fw = fenwickI64New();
+        void *ref = fenwickI64New();
+
+        /* Small batch stays in Small; a far index upgrades to Full */
+        const size_t idxA[] = {3, 0, 3, 9};
+        const int64_t deltaA[] = {5, 1, 2, -4};
+        const size_t idxB[] = {12, 30000, 7};
+        const int64_t deltaB[] = {8, 100, 6};
+
+        fenwickI64UpdateMany(&fw, idxA, deltaA, COUNT_ARRAY(idxA));
+        for (size_t i = 0; i < COUNT_ARRAY(idxA); i++) {
+            fenwickI64Update(&ref, idxA[i], deltaA[i]);
+        }
+
+        if (FENWICK_I64_TYPE(fw) != FENWICK_I64_TYPE_SMALL) {
+            ERRR("Small batch should stay in Small tier");
+        }
+
+        if (fenwickI64Count(fw) != 10) {
+            ERR("Count should be 10, got %zu", fenwickI64Count(fw));
+        }
+
+        fenwickI64UpdateMany(&fw, idxB, deltaB, COUNT_ARRAY(idxB));
+        for (size_t i = 0; i < COUNT_ARRAY(idxB); i++) {
+            fenwickI64Update(&ref, idxB[i], deltaB[i]);
+        }
+
+        if (FENWICK_I64_TYPE(fw) != FENWICK_I64_TYPE_FULL) {
+            ERRR("Batch with a far index should upgrade to Full tier");
+        }
+
+        if (fenwickI64Count(fw) != fenwickI64Count(ref)) {
+            ERR("Count %zu should match %zu", fenwickI64Count(fw),
+                fenwickI64Count(ref));
+        }
+
+        for (size_t i = 0; i <= 30000; i++) {
+            if (fenwickI64Query(fw, i) != fenwickI64Query(ref, i)) {
+                ERR("Prefix sum at %zu: %" PRId64 " != %" PRId64, i,
+                    fenwickI64Query(fw, i), fenwickI64Query(ref, i));
+                break;
+            }
+        }
+
+        fenwickI64Free(fw);
+        fenwickI64Free(ref);
+    }
+
+    TEST("bulk: NULL and empty parameter handling") {
+        void *fw = fenwickI64NewFromArray(NULL, 10);
+        if (!fw || fenwickI64Count(fw) != 0) {
+            ERRR("NewFromArray(NULL) should return an empty tree");
+        }
+
+        if (!fenwickI64UpdateMany(&fw, NULL, NULL, 0)) {
+            ERRR("Empty batch should succeed");
+        }
+
+        const size_t idx = 1;
+        if (fenwickI64UpdateMany(&fw, &idx, NULL, 1)) {
+            ERRR("Batch without deltas should fail");
+        }
+
+        if (fenwickI64UpdateMany(NULL, NULL, NULL, 0)) {
+            ERRR("NULL tree pointer should fail");
+        }
+
+        fenwickI64Free(fw);
+    }
+
     /* =================================================================
      * Performance Benchmarks - Fenwick vs Naive Array
      * ================================================================= */
@@ -928,6 +1119,72 @@ int fenwickI64Test(int argc, char *argv[]) {
         zfree(init);
     }
 
+    TEST("BENCH: Bulk construction and batched updates") {
+        const size_t N = 4 * 1024 * 1024; /* Full tier */
+        const size_t BATCH = 1024 * 1024;
+        uint64_t seed = 12345;
+
+        int64_t *init = zcalloc(N, sizeof(int64_t));
+        for (size_t i = 0; i < N; i++) {
+            init[i] = (randSeed(&seed) % 1000) - 500;
+        }
+
+        PERF_TIMERS_SETUP;
+        void *ref = fenwickI64New();
+        for (size_t i = 0; i < N; i++) {
+            fenwickI64Update(&ref, i, init[i]);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(N, "fenwickI64 build by updates (4M)");
+
+        PERF_TIMERS_SETUP;
+        void *bulk = fenwickI64NewFromArray(init, N);
+        PERF_TIMERS_FINISH_PRINT_RESULTS(N, "fenwickI64 NewFromArray (4M)");
+
+        size_t *indices = zmalloc(BATCH * sizeof(*indices));
+        int64_t *deltas = zmalloc(BATCH * sizeof(*deltas));
+        for (size_t i = 0; i < BATCH; i++) {
+            indices[i] = randSeed(&seed) % N;
+            deltas[i] = (int64_t)(randSeed(&seed) % 10);
+        }
+
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < BATCH; i++) {
+            fenwickI64Update(&ref, indices[i], deltas[i]);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(BATCH, "fenwickI64 updates (1M)");
+
+        PERF_TIMERS_SETUP;
+        fenwickI64UpdateMany(&bulk, indices, deltas, BATCH);
+        PERF_TIMERS_FINISH_PRINT_RESULTS(BATCH, "fenwickI64 UpdateMany (1M)");
+
+        /* Sparse batch takes the sorted sweep instead of a rebuild */
+        const size_t SPARSE = 64 * 1024;
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < SPARSE; i++) {
+            fenwickI64Update(&ref, indices[i], deltas[i]);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(SPARSE, "fenwickI64 updates (64K)");
+
+        PERF_TIMERS_SETUP;
+        fenwickI64UpdateMany(&bulk, indices, deltas, SPARSE);
+        PERF_TIMERS_FINISH_PRINT_RESULTS(SPARSE,
+                                         "fenwickI64 UpdateMany (64K)");
+
+        for (size_t i = 0; i < N; i += 4093) {
+            if (fenwickI64Query(bulk, i) != fenwickI64Query(ref, i)) {
+                ERR("Prefix sum at %zu: %" PRId64 " != %" PRId64, i,
+                    fenwickI64Query(bulk, i), fenwickI64Query(ref, i));
+                break;
+            }
+        }
+
+        fenwickI64Free(ref);
+        fenwickI64Free(bulk);
+        zfree(indices);
+        zfree(deltas);
+        zfree(init);
+    }
+
     TEST_FINAL_RESULT;
 }
 
@@ -43,6 +43,23 @@ static void *fenwickU128UpgradeSmallToFull(fenwickU128Small *small) {
     return FENWICK_U128_TAG(full, FENWICK_U128_TYPE_FULL);
 }
 
+/* Create fenwickU128 from 'count' initial values in O(n) */
+void *fenwickU128NewFromArray(const __uint128_t *values, size_t count) {
+    if (count * sizeof(__uint128_t) > 128 * 1024) {
+        fenwickU128Full *full =
+            fenwickU128FullNewFromArray(values, (uint64_t)count);
+        return FENWICK_U128_TAG(full, FENWICK_U128_TYPE_FULL);
+    }
+
+    fenwickU128Small *small =
+        fenwickU128SmallNewFromArray(values, (uint32_t)count);
+    if (fenwickU128SmallShouldUpgrade(small)) {
+        return fenwickU128UpgradeSmallToFull(small);
+    }
+
+    return FENWICK_U128_TAG(small, FENWICK_U128_TYPE_SMALL);
+}
+
 /* Update with tier transitions (2-TIER) */
 bool fenwickU128Update(void **fw, size_t idx, __uint128_t delta) {
     if (!fw) {
@@ -90,6 +107,60 @@ bool fenwickU128Update(void **fw, size_t idx, __uint128_t delta) {
     return false;
 }
 
+/* Batch update: add deltas[i] at indices[i] in a single pass */
+bool fenwickU128UpdateMany(void **fw, const size_t *indices,
+                           const __uint128_t *deltas, size_t count) {
+    if (!fw || (count > 0 && (!indices || !deltas))) {
+        return false;
+    }
+
+    if (!*fw) {
+        *fw = fenwickU128New();
+    }
+
+    size_t maxIdx = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] > maxIdx) {
+            maxIdx = indices[i];
+        }
+    }
+
+    fenwickU128Type type = FENWICK_U128_TYPE(*fw);
+    void *ptr = FENWICK_U128_UNTAG(*fw);
+
+    switch (type) {
+    case FENWICK_U128_TYPE_SMALL: {
+        fenwickU128Small *small = (fenwickU128Small *)ptr;
+
+        /* Same upgrade rule as fenwickU128Update(), for the largest index */
+        if (fenwickU128SmallShouldUpgrade(small) ||
+            maxIdx >= fenwickU128SmallCount(small) + 1000 ||
+            maxIdx * sizeof(__uint128_t) > 128 * 1024) {
+            *fw = fenwickU128UpgradeSmallToFull(small);
+            return fenwickU128UpdateMany(fw, indices, deltas, count);
+        }
+
+        bool success = false;
+        fenwickU128Small *newSmall =
+            fenwickU128SmallUpdateMany(small, indices, deltas, count, &success);
+        *fw = FENWICK_U128_TAG(newSmall, FENWICK_U128_TYPE_SMALL);
+        return success;
+    }
+
+    case FENWICK_U128_TYPE_FULL: {
+        fenwickU128Full *full = (fenwickU128Full *)ptr;
+
+        bool success = false;
+        fenwickU128Full *newFull =
+            fenwickU128FullUpdateMany(full, indices, deltas, count, &success);
+        *fw = FENWICK_U128_TAG(newFull, FENWICK_U128_TYPE_FULL);
+        return success;
+    }
+    }
+
+    return false;
+}
+
 /* Query prefix sum */
 __uint128_t fenwickU128Query(const void *fw, size_t idx) {
     if (!fw) {
@@ -37,8 +37,11 @@ typedef enum fenwickU128Type {
 
 /* Public API - 2-tier automatic tier management */
 void *fenwickU128New(void);
+void *fenwickU128NewFromArray(const __uint128_t *values, size_t count);
 void fenwickU128Free(void *fw);
 bool fenwickU128Update(void **fw, size_t idx, __uint128_t delta);
+bool fenwickU128UpdateMany(void **fw, const size_t *indices,
+                           const __uint128_t *deltas, size_t count);
 __uint128_t fenwickU128Query(const void *fw, size_t idx);
 __uint128_t fenwickU128RangeQuery(const void *fw, size_t left, size_t right);
 __uint128_t fenwickU128Get(const void *fw, size_t idx);
@@ -41,6 +41,23 @@ static void *fenwickU16UpgradeSmallToFull(fenwickU16Small *small) {
     return FENWICK_U16_TAG(full, FENWICK_U16_TYPE_FULL);
 }
 
+/* Create fenwickU16 from 'count' initial values in O(n) */
+void *fenwickU16NewFromArray(const uint16_t *values, size_t count) {
+    if (count * sizeof(uint16_t) > 128 * 1024) {
+        fenwickU16Full *full =
+            fenwickU16FullNewFromArray(values, (uint64_t)count);
+        return FENWICK_U16_TAG(full, FENWICK_U16_TYPE_FULL);
+    }
+
+    fenwickU16Small *small =
+        fenwickU16SmallNewFromArray(values, (uint32_t)count);
+    if (fenwickU16SmallShouldUpgrade(small)) {
+        return fenwickU16UpgradeSmallToFull(small);
+    }
+
+    return FENWICK_U16_TAG(small, FENWICK_U16_TYPE_SMALL);
+}
+
 /* Update with tier transitions (2-TIER) */
 bool fenwickU16Update(void **fw, size_t idx, uint16_t delta) {
     if (!fw) {
@@ -88,6 +105,60 @@ bool fenwickU16Update(void **fw, size_t idx, uint16_t delta) {
     return false;
 }
 
+/* Batch update: add deltas[i] at indices[i] in a single pass */
+bool fenwickU16UpdateMany(void **fw, const size_t *indices,
+                          const uint16_t *deltas, size_t count) {
+    if (!fw || (count > 0 && (!indices || !deltas))) {
+        return false;
+    }
+
+    if (!*fw) {
+        *fw = fenwickU16New();
+    }
+
+    size_t maxIdx = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] > maxIdx) {
+            maxIdx = indices[i];
+        }
+    }
+
+    fenwickU16Type type = FENWICK_U16_TYPE(*fw);
+    void *ptr = FENWICK_U16_UNTAG(*fw);
+
+    switch (type) {
+    case FENWICK_U16_TYPE_SMALL: {
+        fenwickU16Small *small = (fenwickU16Small *)ptr;
+
+        /* Same upgrade rule as fenwickU16Update(), for the largest index */
+        if (fenwickU16SmallShouldUpgrade(small) ||
+            maxIdx >= fenwickU16SmallCount(small) + 1000 ||
+            maxIdx * sizeof(uint16_t) > 128 * 1024) {
+            *fw = fenwickU16UpgradeSmallToFull(small);
+            return fenwickU16UpdateMany(fw, indices, deltas, count);
+        }
+
+        bool success = false;
+        fenwickU16Small *newSmall =
+            fenwickU16SmallUpdateMany(small, indices, deltas, count, &success);
+        *fw = FENWICK_U16_TAG(newSmall, FENWICK_U16_TYPE_SMALL);
+        return success;
+    }
+
+    case FENWICK_U16_TYPE_FULL: {
+        fenwickU16Full *full = (fenwickU16Full *)ptr;
+
+        bool success = false;
+        fenwickU16Full *newFull =
+            fenwickU16FullUpdateMany(full, indices, deltas, count, &success);
+        *fw = FENWICK_U16_TAG(newFull, FENWICK_U16_TYPE_FULL);
+        return success;
+    }
+    }
+
+    return false;
+}
+
 /* Query prefix sum */
 uint16_t fenwickU16Query(const void *fw, size_t idx) {
     if (!fw) {
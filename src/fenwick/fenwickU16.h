@@ -35,8 +35,11 @@ typedef enum fenwickU16Type {
 
 /* Public API - 2-tier automatic tier management */
 void *fenwickU16New(void);
+void *fenwickU16NewFromArray(const uint16_t *values, size_t count);
 void fenwickU16Free(void *fw);
 bool fenwickU16Update(void **fw, size_t idx, uint16_t delta);
+bool fenwickU16UpdateMany(void **fw, const size_t *indices,
+                          const uint16_t *deltas, size_t count);
 uint16_t fenwickU16Query(const void *fw, size_t idx);
 uint16_t fenwickU16RangeQuery(const void *fw, size_t left, size_t right);
 uint16_t fenwickU16Get(const void *fw, size_t idx);
@@ -41,6 +41,23 @@ static void *fenwickU32UpgradeSmallToFull(fenwickU32Small *small) {
     return FENWICK_U32_TAG(full, FENWICK_U32_TYPE_FULL);
 }
 
+/* Create fenwickU32 from 'count' initial values in O(n) */
+void *fenwickU32NewFromArray(const uint32_t *values, size_t count) {
+    if (count * sizeof(uint32_t) > 128 * 1024) {
+        fenwickU32Full *full =
+            fenwickU32FullNewFromArray(values, (uint64_t)count);
+        return FENWICK_U32_TAG(full, FENWICK_U32_TYPE_FULL);
+    }
+
+    fenwickU32Small *small =
+        fenwickU32SmallNewFromArray(values, (uint32_t)count);
+    if (fenwickU32SmallShouldUpgrade(small)) {
+        return fenwickU32UpgradeSmallToFull(small);
+    }
+
+    return FENWICK_U32_TAG(small, FENWICK_U32_TYPE_SMALL);
+}
+
 /* Update with tier transitions (2-TIER) */
 bool fenwickU32Update(void **fw, size_t idx, uint32_t delta) {
     if (!fw) {
@@ -88,6 +105,60 @@ bool fenwickU32Update(void **fw, size_t idx, uint32_t delta) {
     return false;
 }
 
+/* Batch update: add deltas[i] at indices[i] in a single pass */
+bool fenwickU32UpdateMany(void **fw, const size_t *indices,
+                          const uint32_t *deltas, size_t count) {
+    if (!fw || (count > 0 && (!indices || !deltas))) {
+        return false;
+    }
+
+    if (!*fw) {
+        *fw = fenwickU32New();
+    }
+
+    size_t maxIdx = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] > maxIdx) {
+            maxIdx = indices[i];
+        }
+    }
+
+    fenwickU32Type type = FENWICK_U32_TYPE(*fw);
+    void *ptr = FENWICK_U32_UNTAG(*fw);
+
+    switch (type) {
+    case FENWICK_U32_TYPE_SMALL: {
+        fenwickU32Small *small = (fenwickU32Small *)ptr;
+
+        /* Same upgrade rule as fenwickU32Update(), for the largest index */
+        if (fenwickU32SmallShouldUpgrade(small) ||
+            maxIdx >= fenwickU32SmallCount(small) + 1000 ||
+            maxIdx * sizeof(uint32_t) > 128 * 1024) {
+            *fw = fenwickU32UpgradeSmallToFull(small);
+            return fenwickU32UpdateMany(fw, indices, deltas, count);
+        }
+
+        bool success = false;
+        fenwickU32Small *newSmall =
+            fenwickU32SmallUpdateMany(small, indices, deltas, count, &success);
+        *fw = FENWICK_U32_TAG(newSmall, FENWICK_U32_TYPE_SMALL);
+        return success;
+    }
+
+    case FENWICK_U32_TYPE_FULL: {
+        fenwickU32Full *full = (fenwickU32Full *)ptr;
+
+        bool success = false;
+        fenwickU32Full *newFull =
+            fenwickU32FullUpdateMany(full, indices, deltas, count, &success);
+        *fw = FENWICK_U32_TAG(newFull, FENWICK_U32_TYPE_FULL);
+        return success;
+    }
+    }
+
+    return false;
+}
+
 /* Query prefix sum */
 uint32_t fenwickU32Query(const void *fw, size_t idx) {
     if (!fw) {
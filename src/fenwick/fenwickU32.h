@@ -35,8 +35,11 @@ typedef enum fenwickU32Type {
 
 /* Public API - 2-tier automatic tier management */
 void *fenwickU32New(void);
+void *fenwickU32NewFromArray(const uint32_t *values, size_t count);
 void fenwickU32Free(void *fw);
 bool fenwickU32Update(void **fw, size_t idx, uint32_t delta);
+bool fenwickU32UpdateMany(void **fw, const size_t *indices,
+                          const uint32_t *deltas, size_t count);
 uint32_t fenwickU32Query(const void *fw, size_t idx);
 uint32_t fenwickU32RangeQuery(const void *fw, size_t left, size_t right);
 uint32_t fenwickU32Get(const void *fw, size_t idx);
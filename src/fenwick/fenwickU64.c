@@ -41,6 +41,23 @@ static void *fenwickU64UpgradeSmallToFull(fenwickU64Small *small) {
     return FENWICK_U64_TAG(full, FENWICK_U64_TYPE_FULL);
 }
 
+/* Create fenwickU64 from 'count' initial values in O(n) */
+void *fenwickU64NewFromArray(const uint64_t *values, size_t count) {
+    if (count * sizeof(uint64_t) > 128 * 1024) {
+        fenwickU64Full *full =
+            fenwickU64FullNewFromArray(values, (uint64_t)count);
+        return FENWICK_U64_TAG(full, FENWICK_U64_TYPE_FULL);
+    }
+
+    fenwickU64Small *small =
+        fenwickU64SmallNewFromArray(values, (uint32_t)count);
+    if (fenwickU64SmallShouldUpgrade(small)) {
+        return fenwickU64UpgradeSmallToFull(small);
+    }
+
+    return FENWICK_U64_TAG(small, FENWICK_U64_TYPE_SMALL);
+}
+
 /* Update with tier transitions (2-TIER) */
 bool fenwickU64Update(void **fw, size_t idx, uint64_t delta) {
     if (!fw) {
@@ -88,6 +105,60 @@ bool fenwickU64Update(void **fw, size_t idx, uint64_t delta) {
     return false;
 }
 
+/* Batch update: add deltas[i] at indices[i] in a single pass */
+bool fenwickU64UpdateMany(void **fw, const size_t *indices,
+                          const uint64_t *deltas, size_t count) {
+    if (!fw || (count > 0 && (!indices || !deltas))) {
+        return false;
+    }
+
+    if (!*fw) {
+        *fw = fenwickU64New();
+    }
+
+    size_t maxIdx = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] > maxIdx) {
+            maxIdx = indices[i];
+        }
+    }
+
+    fenwickU64Type type = FENWICK_U64_TYPE(*fw);
+    void *ptr = FENWICK_U64_UNTAG(*fw);
+
+    switch (type) {
+    case FENWICK_U64_TYPE_SMALL: {
+        fenwickU64Small *small = (fenwickU64Small *)ptr;
+
+        /* Same upgrade rule as fenwickU64Update(), for the largest index */
+        if (fenwickU64SmallShouldUpgrade(small) ||
+            maxIdx >= fenwickU64SmallCount(small) + 1000 ||
+            maxIdx * sizeof(uint64_t) > 128 * 1024) {
+            *fw = fenwickU64UpgradeSmallToFull(small);
+            return fenwickU64UpdateMany(fw, indices, deltas, count);
+        }
+
+        bool success = false;
+        fenwickU64Small *newSmall =
+            fenwickU64SmallUpdateMany(small, indices, deltas, count, &success);
+        *fw = FENWICK_U64_TAG(newSmall, FENWICK_U64_TYPE_SMALL);
+        return success;
+    }
+
+    case FENWICK_U64_TYPE_FULL: {
+        fenwickU64Full *full = (fenwickU64Full *)ptr;
+
+        bool success = false;
+        fenwickU64Full *newFull =
+            fenwickU64FullUpdateMany(full, indices, deltas, count, &success);
+        *fw = FENWICK_U64_TAG(newFull, FENWICK_U64_TYPE_FULL);
+        return success;
+    }
+    }
+
+    return false;
+}
+
 /* Query prefix sum */
 uint64_t fenwickU64Query(const void *fw, size_t idx) {
     if (!fw) {
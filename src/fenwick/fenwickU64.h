@@ -35,8 +35,11 @@ typedef enum fenwickU64Type {
 
 /* Public API - 2-tier automatic tier management */
 void *fenwickU64New(void);
+void *fenwickU64NewFromArray(const uint64_t *values, size_t count);
 void fenwickU64Free(void *fw);
 bool fenwickU64Update(void **fw, size_t idx, uint64_t delta);
+bool fenwickU64UpdateMany(void **fw, const size_t *indices,
+                          const uint64_t *deltas, size_t count);
 uint64_t fenwickU64Query(const void *fw, size_t idx);
 uint64_t fenwickU64RangeQuery(const void *fw, size_t left, size_t right);
 uint64_t fenwickU64Get(const void *fw, size_t idx);
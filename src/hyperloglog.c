@@ -25,6 +25,7 @@
 
 #include <assert.h>
 #include <math.h>
+#include <pthread.h>
 #include <stdarg.h> /* va_arg */
 
 #ifndef XXH_INLINE_ALL
@@ -58,7 +59,9 @@
  * for accessing internal fields.
  *
  * Header encodes:
- *  - cached cardinality (61 bits)
+ *  - cached cardinality (56 bits)
+ *  - precision (5 bits; 0 is the default HLL_P so sketches written before
+ *    precision was configurable still read correctly)
  *  - cached cardinality validity (is number here valid?) (1 bit)
  *  - encoding (3 values requiring 2 bits: sparse, dense, raw)
  *  - variable length data.
@@ -69,7 +72,8 @@
  *   - when clang adds support, add:
  *     - __attribute__ ((scalar_storage_order("little-endian"))) */
 typedef struct hyperloglogHeader {
-    uint64_t cardinality : 61;     /* Cached cardinality */
+    uint64_t cardinality : 56;     /* Cached cardinality */
+    uint64_t precision : 5;        /* Register index bits; 0 means HLL_P */
     uint64_t cardinalityValid : 1; /* Boolean, is cardinality valid? */
     uint64_t encoding : 2;         /* Encoding; one of SPARSE, DENSE, or RAW */
     uint8_t registers[];           /* Data bytes. */
@@ -90,9 +94,11 @@ _Static_assert(sizeof(hyperloglogHeader) == sizeof(uint64_t),
 "Persisting and reading persisted HLLs may not work reliably."
 #endif
 
-/* This needs to be configurable later, but it's a holdover from when
- * integration was baked directly into the server config. */
-static const uint64_t serverSparseMaxBytes = 4096;
+/* Sparse representations grow until they reach one third of the dense
+ * register bytes (4096 bytes at the default precision), then convert to
+ * dense. */
+#define HLL_SPARSE_MAX_BYTES(p) (HLL_REGISTERS_P(p) * HLL_BITS / 8 / 3)
+#define serverSparseMaxBytes HLL_SPARSE_MAX_BYTES(HLL_P)
 
 /* This HyperLogLog implementation is based on the following ideas:
  *
@@ -229,15 +235,6 @@ static const uint64_t serverSparseMaxBytes = 4096;
 #define toHLLIn(mdsc_) ((hyperloglog **)&(mdsc_))
 #define toMDSC(hyperloglog_) ((mdsc *)(hyperloglog_))
 
-#define HLL_MERGE(max, current, failure)                                       \
-    do {                                                                       \
-        /* Merge with this HLL with our 'max' HHL by setting max[i]            \
-         * to MAX(max[i],hyperloglog[i]). */                                   \
-        if (hyperloglogMerge((max), (current)) == false) {                     \
-            return (failure);                                                  \
-        }                                                                      \
-    } while (0)
-
 /* The cached cardinality signals validity of the cached value. */
 #define HLL_INVALIDATE_CACHE(hdr)                                              \
     do {                                                                       \
@@ -246,19 +243,34 @@ static const uint64_t serverSparseMaxBytes = 4096;
 
 #define HLL_VALID_CACHE(hdr) ((hdr)->cardinalityValid)
 
-#define HLL_CARDINALITY_MAX (1ULL << 61)
+#define HLL_CARDINALITY_MAX (1ULL << 56)
 
+/* Precision 'p' uses 2^p registers; standard error is 1.04 / sqrt(2^p).
+ * The *_P(p) macros take an explicit precision; the unsuffixed forms are
+ * the default precision. */
 #define HLL_P 14           /* The greater is P, the smaller the error. */
+#define HLL_P_MIN 4        /* 16 registers, 20 bytes dense. */
+#define HLL_P_MAX 18       /* 262144 registers, 192 KiB dense. */
 #define HLL_Q (64 - HLL_P) /* bits of hash for determining leading zeroes */
-#define HLL_REGISTERS (1 << HLL_P)     /* With P=14, 16384 registers. */
-#define HLL_P_MASK (HLL_REGISTERS - 1) /* Mask to index register. */
+#define HLL_Q_P(p) (64 - (p))
+#define HLL_REGISTERS (1 << HLL_P) /* With P=14, 16384 registers. */
+#define HLL_REGISTERS_P(p) (1U << (p))
 #define HLL_BITS 6 /* Enough to count up to 63 leading zeroes. */
 #define HLL_REGISTER_MAX ((1 << HLL_BITS) - 1)
 #define HLL_HDR_SIZE sizeof(hyperloglogHeader)
-#define HLL_DENSE_SIZE (HLL_HDR_SIZE + ((HLL_REGISTERS * HLL_BITS + 7) / 8))
+#define HLL_DENSE_SIZE_P(p)                                                    \
+    (HLL_HDR_SIZE + ((HLL_REGISTERS_P(p) * HLL_BITS + 7) / 8))
+#define HLL_DENSE_SIZE HLL_DENSE_SIZE_P(HLL_P)
 #define HLL_MAX_SIZE HLL_HDR_SIZE + HLL_REGISTERS
 #define HLL_MAX_ENCODING 1
-#define HLL_ZERO_BOUND ((sizeof(uint64_t) * 8) - HLL_P)
+
+/* Register histograms are indexed by register value. */
+#define HLL_HISTO_SIZE (HLL_REGISTER_MAX + 1)
+
+/* Precision of 'hdr' (stored as 0 for the default so older sketches and
+ * default sketches share one layout). */
+#define hllP(hdr) ((hdr)->precision ? (uint32_t)(hdr)->precision : HLL_P)
+#define hllSetP(hdr, p) ((hdr)->precision = (p) == HLL_P ? 0 : (p))
 
 typedef uint8_t hllStatic[HLL_MAX_SIZE];
 
@@ -462,13 +474,14 @@ typedef enum hyperloglogEncoding {
 
 /* ========================= HyperLogLog algorithm  ========================= */
 
-/* Given a string element to add to the HyperLogLog, returns the length
- * of the pattern 000..1 of the element hash. As a side effect 'regp' is
- * set to the register index this element hashes to. */
-DK_STATIC int_fast32_t hyperloglogPatLen(const void *data_, size_t len,
-                                         int64_t *regp) {
-    uint64_t hash;
+#define HLL_HASH_SEED 0xadc83b19ULL
 
+/* Given the 64 bit hash of an element, returns the length of the pattern
+ * 000..1 of the hash bits not used for the register index. As a side effect
+ * 'regp' is set to the register index (of 2^p registers) this hash maps to. */
+static inline int_fast32_t hyperloglogPatLenFromHash(uint64_t hash,
+                                                     const uint32_t p,
+                                                     int64_t *regp) {
     /* Count the number of zeroes starting from bit HLL_REGISTERS
      * (that is a power of two corresponding to the first bit we don't use
      * as index). The max run can be 64-P+1 bits = Q+1 bits.
@@ -480,20 +493,22 @@ DK_STATIC int_fast32_t hyperloglogPatLen(const void *data_, size_t len,
      *
      * This may sound like inefficient, but actually in the average case
      * there are high probabilities to find a 1 after a few iterations. */
-    hash = HYPERHASH(data_, len, 0xadc83b19ULL);
-    *regp = hash & HLL_P_MASK; /* Register index. */
-    hash >>= HLL_P;            /* Remove bits used to address the register. */
-    hash |= (1ULL << HLL_Q);   /* Verify count will be <= Q + 1 */
-
-    /* ctzll can't handle 0 as an input, so we need to special-case
-     * the unlikely scenario */
-    if (unlikely(hash == 0)) {
-        return HLL_ZERO_BOUND; /* Handle special case. */
-    }
+    *regp = hash & (HLL_REGISTERS_P(p) - 1); /* Register index. */
+    hash >>= p;                /* Remove bits used to address the register. */
+    hash |= (1ULL << HLL_Q_P(p)); /* Verify count will be <= Q + 1 */
 
     return __builtin_ctzll(hash) + 1; /* Use builtin if possible. */
 }
 
+/* Given a string element to add to the HyperLogLog, returns the length
+ * of the pattern 000..1 of the element hash. As a side effect 'regp' is
+ * set to the register index this element hashes to. */
+DK_STATIC int_fast32_t hyperloglogPatLen(const void *data_, size_t len,
+                                         const uint32_t p, int64_t *regp) {
+    const uint64_t hash = HYPERHASH(data_, len, HLL_HASH_SEED);
+    return hyperloglogPatLenFromHash(hash, p, regp);
+}
+
 /* ================== Dense representation implementation  ================== */
 
 /* Low level function to set the dense HLL register at 'index' to the
@@ -526,23 +541,24 @@ DK_STATIC bool hyperloglogDenseSet(uint8_t *registers, int64_t index,
  *
  * This is just a wrapper to hllDenseSet(), performing the hashing of the
  * element in order to retrieve the index and zero-run count. */
-DK_STATIC bool hyperloglogDenseAdd(uint8_t *registers, const void *data_,
-                                   size_t len) {
+DK_STATIC bool hyperloglogDenseAdd(uint8_t *registers, const uint32_t p,
+                                   const void *data_, size_t len) {
     int64_t index;
-    uint_fast8_t count = hyperloglogPatLen(data_, len, &index);
+    uint_fast8_t count = hyperloglogPatLen(data_, len, p, &index);
     /* Update the register if this element produced a longer run of zeroes. */
     return hyperloglogDenseSet(registers, index, count);
 }
 
 /* Compute the register histogram in the dense representation. */
 DK_STATIC void hyperloglogDenseRegisterHistogram(uint8_t *registers,
+                                                 const uint32_t p,
                                                  int32_t *reghisto) {
-    /* default is to use 16384 registers 6 bits each. The code works
-     * with other values by modifying the defines, but for our target value
-     * we take a faster path with unrolled loops. */
-    if (HLL_REGISTERS == 16384 && HLL_BITS == 6) {
+    /* Every supported precision has a multiple of 16 registers, so we
+     * always take the unrolled path decoding 16 6-bit registers from
+     * 12 bytes at a time. */
+    if (HLL_BITS == 6) {
         uint8_t *r = registers;
-        for (uint_fast32_t j = 0; j < 1024; j++) {
+        for (uint_fast32_t j = 0; j < HLL_REGISTERS_P(p) / 16; j++) {
             uint64_t r0 = r[0] & 63;
             uint64_t r1 = (r[0] >> 6 | r[1] << 2) & 63;
             uint64_t r2 = (r[1] >> 4 | r[2] << 4) & 63;
@@ -580,7 +596,7 @@ DK_STATIC void hyperloglogDenseRegisterHistogram(uint8_t *registers,
             r += 12;
         }
     } else {
-        for (uint_fast32_t j = 0; j < HLL_REGISTERS; j++) {
+        for (uint_fast32_t j = 0; j < HLL_REGISTERS_P(p); j++) {
             uint64_t reg;
 
             HLL_DENSE_GET_REGISTER(reg, registers, j);
@@ -618,9 +634,10 @@ DK_STATIC bool hyperloglogSparseToDense(hyperloglog **inHll) {
     /* New string of the right size filled with zero bytes.
      * Note that the cached cardinality is set to 0 as a side effect
      * that is exactly the cardinality of an empty HLL. */
-    dense = mdscnewlen(NULL, HLL_DENSE_SIZE);
+    const uint32_t registers = HLL_REGISTERS_P(hllP(oldhdr));
+    dense = mdscnewlen(NULL, HLL_DENSE_SIZE_P(hllP(oldhdr)));
     hdr = (hyperloglog *)dense;
-    *hdr = *oldhdr; /* copies cached card */
+    *hdr = *oldhdr; /* copies cached card and precision */
     hdr->encoding = HLL_DENSE;
 
     /* Now read the sparse representation and set non-zero registers
@@ -640,7 +657,7 @@ DK_STATIC bool hyperloglogSparseToDense(hyperloglog **inHll) {
             regval = HLL_SPARSE_VAL_VALUE(p);
 
             /* too big, corrupt */
-            if ((runlen + idx) > HLL_REGISTERS) {
+            if ((runlen + idx) > (int32_t)registers) {
                 return false;
             }
 
@@ -654,8 +671,8 @@ DK_STATIC bool hyperloglogSparseToDense(hyperloglog **inHll) {
     }
 
     /* If the sparse representation was valid, we expect to find idx
-     * set to HLL_REGISTERS. */
-    if (idx != HLL_REGISTERS) {
+     * set to the register count. */
+    if (idx != (int32_t)registers) {
         mdscfree(dense);
         assert(NULL && "Conversion error?");
         return false;
@@ -883,7 +900,8 @@ DK_STATIC int32_t hyperloglogSparseSet(hyperloglog **inHll, int64_t index,
     const int32_t oldlen = isXzero ? 2 : 1;
     const int32_t deltalen = seqlen - oldlen;
 
-    if (deltalen > 0 && mdsclen(hmdsc) + deltalen > serverSparseMaxBytes) {
+    if (deltalen > 0 &&
+        mdsclen(hmdsc) + deltalen > HLL_SPARSE_MAX_BYTES(hllP(toHLL(hmdsc)))) {
         goto promote;
     }
 
@@ -969,7 +987,8 @@ promote: /* Promote to dense representation. */
 DK_STATIC int32_t hyperloglogSparseAdd(hyperloglog **inHll, const void *data_,
                                        size_t len) {
     int64_t index;
-    const uint_fast8_t count = hyperloglogPatLen(data_, len, &index);
+    const uint_fast8_t count =
+        hyperloglogPatLen(data_, len, hllP(*inHll), &index);
 
     /* Update the register if this element produced a longer run of zeroes. */
     return hyperloglogSparseSet(inHll, index, count);
@@ -977,35 +996,37 @@ DK_STATIC int32_t hyperloglogSparseAdd(hyperloglog **inHll, const void *data_,
 
 /* Compute the register histogram in the sparse representation. */
 DK_STATIC void hyperloglogSparseRegisterHistogram(uint8_t *sparse,
-                                                  int sparselen, bool *invalid,
+                                                  int sparselen,
+                                                  const uint32_t p,
+                                                  bool *invalid,
                                                   int32_t *reghisto) {
     int32_t idx = 0;
     int32_t runlen;
     int32_t regval;
     uint8_t *end = sparse + sparselen;
-    uint8_t *p = sparse;
+    uint8_t *s = sparse;
 
-    while (p < end) {
-        if (HLL_SPARSE_IS_ZERO(p)) {
-            runlen = HLL_SPARSE_ZERO_LEN(p);
+    while (s < end) {
+        if (HLL_SPARSE_IS_ZERO(s)) {
+            runlen = HLL_SPARSE_ZERO_LEN(s);
             idx += runlen;
             reghisto[0] += runlen;
-            p++;
-        } else if (HLL_SPARSE_IS_XZERO(p)) {
-            runlen = HLL_SPARSE_XZERO_LEN(p);
+            s++;
+        } else if (HLL_SPARSE_IS_XZERO(s)) {
+            runlen = HLL_SPARSE_XZERO_LEN(s);
             idx += runlen;
             reghisto[0] += runlen;
-            p += 2;
+            s += 2;
         } else {
-            runlen = HLL_SPARSE_VAL_LEN(p);
-            regval = HLL_SPARSE_VAL_VALUE(p);
+            runlen = HLL_SPARSE_VAL_LEN(s);
+            regval = HLL_SPARSE_VAL_VALUE(s);
             idx += runlen;
             reghisto[regval] += runlen;
-            p++;
+            s++;
         }
     }
 
-    if (idx != HLL_REGISTERS && invalid) {
+    if (idx != (int32_t)HLL_REGISTERS_P(p) && invalid) {
         *invalid = true;
     }
 }
@@ -1018,13 +1039,14 @@ DK_STATIC void hyperloglogSparseRegisterHistogram(uint8_t *sparse,
 
 /* Implements the register histogram calculation for uint8_t data type
  * which is only used internally as speedup for PFCOUNT with multiple keys. */
-void hyperloglogRawRegisterHistogram(uint8_t *registers, int32_t *reghisto) {
+void hyperloglogRawRegisterHistogram(uint8_t *registers, const uint32_t p,
+                                     int32_t *reghisto) {
 #if HLL_USE_SSE
     /* SSE2 optimized: check 16 bytes at a time for all-zeros */
     const __m128i *vec = (const __m128i *)registers;
     const __m128i zero = _mm_setzero_si128();
 
-    for (int_fast32_t j = 0; j < HLL_REGISTERS / 16; j++) {
+    for (int_fast32_t j = 0; j < HLL_REGISTERS_P(p) / 16; j++) {
         __m128i chunk = _mm_loadu_si128(&vec[j]);
         __m128i cmp = _mm_cmpeq_epi8(chunk, zero);
         int mask = _mm_movemask_epi8(cmp);
@@ -1046,7 +1068,7 @@ void hyperloglogRawRegisterHistogram(uint8_t *registers, int32_t *reghisto) {
     const uint8_t *data = registers;
     const uint8x16_t zero = vdupq_n_u8(0);
 
-    for (int_fast32_t j = 0; j < HLL_REGISTERS / 16; j++, data += 16) {
+    for (int_fast32_t j = 0; j < HLL_REGISTERS_P(p) / 16; j++, data += 16) {
         uint8x16_t chunk = vld1q_u8(data);
         uint8x16_t cmp = vceqq_u8(chunk, zero);
 
@@ -1069,7 +1091,7 @@ void hyperloglogRawRegisterHistogram(uint8_t *registers, int32_t *reghisto) {
     const uint64_t *word = (uint64_t *)registers;
     uint8_t *bytes;
 
-    for (int_fast32_t j = 0; j < HLL_REGISTERS / 8; j++) {
+    for (int_fast32_t j = 0; j < HLL_REGISTERS_P(p) / 8; j++) {
         if (*word == 0) {
             reghisto[0] += 8;
         } else {
@@ -1090,11 +1112,12 @@ void hyperloglogRawRegisterHistogram(uint8_t *registers, int32_t *reghisto) {
 
 /* Scalar baseline for benchmarking comparison */
 void hyperloglogRawRegisterHistogramScalar(uint8_t *registers,
+                                           const uint32_t p,
                                            int32_t *reghisto) {
     const uint64_t *word = (uint64_t *)registers;
     uint8_t *bytes;
 
-    for (int_fast32_t j = 0; j < HLL_REGISTERS / 8; j++) {
+    for (int_fast32_t j = 0; j < HLL_REGISTERS_P(p) / 8; j++) {
         if (*word == 0) {
             reghisto[0] += 8;
         } else {
@@ -1178,19 +1201,21 @@ static DK_FN_PURE double hllTau(double x) {
  * This is useful in order to speedup PFCOUNT when called against multiple
  * keys (no need to work with 6-bit integers encoding). */
 DK_INLINE_ALWAYS uint64_t hyperloglogCount_(hyperloglog *hdr, bool *invalid) {
-    double m = HLL_REGISTERS;
+    const uint32_t p = hllP(hdr);
+    const int_fast32_t q = HLL_Q_P(p);
+    double m = HLL_REGISTERS_P(p);
     double E;
-    int32_t reghisto[HLL_Q + 2] = {0};
+    int32_t reghisto[HLL_HISTO_SIZE] = {0};
 
     /* Compute register histogram */
     if (isDense(hdr)) {
-        hyperloglogDenseRegisterHistogram(hdr->registers, reghisto);
+        hyperloglogDenseRegisterHistogram(hdr->registers, p, reghisto);
     } else if (isSparse(hdr)) {
         hyperloglogSparseRegisterHistogram(hdr->registers,
                                            mdsclen((mdsc *)hdr) - HLL_HDR_SIZE,
-                                           invalid, reghisto);
+                                           p, invalid, reghisto);
     } else if (hdr->encoding == HLL_RAW) {
-        hyperloglogRawRegisterHistogram(hdr->registers, reghisto);
+        hyperloglogRawRegisterHistogram(hdr->registers, p, reghisto);
     } else {
         /* Error condition! */
         return -1; /* this is BAD because return becomes UINT64_MAX */
@@ -1199,8 +1224,8 @@ DK_INLINE_ALWAYS uint64_t hyperloglogCount_(hyperloglog *hdr, bool *invalid) {
     /* Estimate cardinality form register histogram. See:
      * "New cardinality estimation algorithms for HyperLogLog sketches"
      * Otmar Ertl, arXiv:1702.01284 */
-    double z = m * hllTau((m - reghisto[HLL_Q + 1]) / (double)m);
-    for (int_fast32_t j = HLL_Q; j >= 1; --j) {
+    double z = m * hllTau((m - reghisto[q + 1]) / (double)m);
+    for (int_fast32_t j = q; j >= 1; --j) {
         z += reghisto[j];
         z *= 0.5;
     }
@@ -1220,171 +1245,283 @@ uint64_t hyperloglogCount(hyperloglog *hdr, bool *invalid) {
 int hyperloglogAdd(hyperloglog **inHll, const void *data, size_t size) {
     hyperloglogHeader *hdr = *inHll;
     if (hdr->encoding == HLL_DENSE) {
-        return hyperloglogDenseAdd(hdr->registers, data, size);
+        return hyperloglogDenseAdd(hdr->registers, hllP(hdr), data, size);
     }
 
     /* else, is sparse */
     return hyperloglogSparseAdd(inHll, data, size);
 }
 
-/* Merge by computing MAX(registers[i],hyperloglog[i]) the HyperLogLog
- * 'hyperloglog' with an array of uint8_t HLL_REGISTERS registers
- * pointed by 'max'.
- *
- * The hyperloglog object must be valid (either by hyperloglogDetect() or some
- * other way).
- *
- * If the HyperLogLog is sparse and is found to be invalid, false
- * is returned, otherwise the function always succeeds. */
-bool hyperloglogMerge(hyperloglog *restrict target,
-                      const hyperloglog *restrict hdr) {
-    uint8_t *max = target->registers;
+/* Elements hashed per hyperloglogAddMany() pass. Hashing a batch up front
+ * keeps the hash loop free of register updates and the update loop free of
+ * hashing, so each runs as a tight independent loop. */
+#define HLL_ADD_MANY_BATCH 64
+
+/* Add 'count' elements (data[i] of length lens[i]) to the HLL.
+ * The sketch may be promoted from sparse to dense part way through.
+ * Returns the number of elements that updated a register, or -1 if the
+ * sparse representation is invalid. */
+int hyperloglogAddMany(hyperloglog **inHll, const void *const *data,
+                       const size_t *lens, size_t count) {
+    uint64_t hashes[HLL_ADD_MANY_BATCH];
+    const uint32_t p = hllP(*inHll);
+    int updated = 0;
+
+    for (size_t i = 0; i < count; i += HLL_ADD_MANY_BATCH) {
+        const size_t batch = count - i < HLL_ADD_MANY_BATCH
+                                 ? count - i
+                                 : HLL_ADD_MANY_BATCH;
+
+        for (size_t j = 0; j < batch; j++) {
+            hashes[j] = HYPERHASH(data[i + j], lens[i + j], HLL_HASH_SEED);
+        }
 
-    /* Target must use 8-bit per register (HLL_RAW) for direct array access.
-     * Source should be DENSE or SPARSE, not RAW. */
-    assert(target->encoding == HLL_RAW);
-    assert(hdr->encoding != HLL_RAW);
+        size_t j = 0;
+        int64_t index;
+        uint_fast8_t zeroes;
 
-    if (isDense(hdr)) {
-#if HLL_USE_NEON && HLL_REGISTERS == 16384 && HLL_BITS == 6
-        /* ARM NEON optimized merge: process 16 registers (12 packed bytes) at a
-         * time. Unpacks 6-bit registers to 8-bit, then uses vector max. */
-        uint8_t *r = (uint8_t *)hdr->registers;
-        for (size_t j = 0; j < 1024; j++) {
-            /* Unpack 16 6-bit registers from 12 bytes into temporary buffer */
-            uint8_t unpacked[16];
-            unpacked[0] = r[0] & 63;
-            unpacked[1] = (r[0] >> 6 | r[1] << 2) & 63;
-            unpacked[2] = (r[1] >> 4 | r[2] << 4) & 63;
-            unpacked[3] = (r[2] >> 2) & 63;
-            unpacked[4] = r[3] & 63;
-            unpacked[5] = (r[3] >> 6 | r[4] << 2) & 63;
-            unpacked[6] = (r[4] >> 4 | r[5] << 4) & 63;
-            unpacked[7] = (r[5] >> 2) & 63;
-            unpacked[8] = r[6] & 63;
-            unpacked[9] = (r[6] >> 6 | r[7] << 2) & 63;
-            unpacked[10] = (r[7] >> 4 | r[8] << 4) & 63;
-            unpacked[11] = (r[8] >> 2) & 63;
-            unpacked[12] = r[9] & 63;
-            unpacked[13] = (r[9] >> 6 | r[10] << 2) & 63;
-            unpacked[14] = (r[10] >> 4 | r[11] << 4) & 63;
-            unpacked[15] = (r[11] >> 2) & 63;
-
-            /* NEON vector max operation - 16 bytes at once */
-            uint8x16_t src = vld1q_u8(unpacked);
-            uint8x16_t dst = vld1q_u8(max);
-            uint8x16_t result = vmaxq_u8(src, dst);
-            vst1q_u8(max, result);
-
-            max += 16;
-            r += 12;
+        /* Sparse updates until (if ever) the sketch is promoted... */
+        for (; j < batch && isSparse(*inHll); j++) {
+            zeroes = hyperloglogPatLenFromHash(hashes[j], p, &index);
+            const int32_t result = hyperloglogSparseSet(inHll, index, zeroes);
+            if (result < 0) {
+                return -1;
+            }
+
+            updated += result;
         }
-#elif HLL_USE_SSE && HLL_REGISTERS == 16384 && HLL_BITS == 6
-        /* SSE optimized merge: same approach as NEON */
-        uint8_t *r = (uint8_t *)hdr->registers;
-        for (size_t j = 0; j < 1024; j++) {
-            /* Unpack 16 6-bit registers from 12 bytes into temporary buffer */
-            uint8_t unpacked[16];
-            unpacked[0] = r[0] & 63;
-            unpacked[1] = (r[0] >> 6 | r[1] << 2) & 63;
-            unpacked[2] = (r[1] >> 4 | r[2] << 4) & 63;
-            unpacked[3] = (r[2] >> 2) & 63;
-            unpacked[4] = r[3] & 63;
-            unpacked[5] = (r[3] >> 6 | r[4] << 2) & 63;
-            unpacked[6] = (r[4] >> 4 | r[5] << 4) & 63;
-            unpacked[7] = (r[5] >> 2) & 63;
-            unpacked[8] = r[6] & 63;
-            unpacked[9] = (r[6] >> 6 | r[7] << 2) & 63;
-            unpacked[10] = (r[7] >> 4 | r[8] << 4) & 63;
-            unpacked[11] = (r[8] >> 2) & 63;
-            unpacked[12] = r[9] & 63;
-            unpacked[13] = (r[9] >> 6 | r[10] << 2) & 63;
-            unpacked[14] = (r[10] >> 4 | r[11] << 4) & 63;
-            unpacked[15] = (r[11] >> 2) & 63;
-
-            /* SSE vector max operation - 16 bytes at once */
-            __m128i src = _mm_loadu_si128((__m128i *)unpacked);
-            __m128i dst = _mm_loadu_si128((__m128i *)max);
-            __m128i result = _mm_max_epu8(src, dst);
-            _mm_storeu_si128((__m128i *)max, result);
-
-            max += 16;
-            r += 12;
+
+        /* ...then dense updates for the rest of the batch. */
+        uint8_t *registers = (*inHll)->registers;
+        for (; j < batch; j++) {
+            zeroes = hyperloglogPatLenFromHash(hashes[j], p, &index);
+            updated += hyperloglogDenseSet(registers, index, zeroes);
         }
-#else
-        /* Scalar fallback */
+    }
+
+    if (updated) {
+        HLL_INVALIDATE_CACHE(*inHll);
+    }
+
+    return updated;
+}
+
+/* Fold register 'idx' (of a precision 'srcP' sketch) holding 'val' into
+ * the precision 'p' raw registers 'max', where p < srcP.
+ *
+ * The low 'p' bits of idx select the target register. The remaining
+ * (srcP - p) index bits are the hash bits the lower precision counts
+ * zeroes in first: if any is set the run ends inside them, otherwise the
+ * run continues into the bits that produced 'val'. Both cases give the
+ * exact value the lower precision sketch would have stored. */
+static inline void hyperloglogFoldRegister(uint8_t *max, const uint32_t p,
+                                           const uint32_t srcP, uint64_t idx,
+                                           uint_fast8_t val) {
+    const uint64_t extra = idx >> p;
+    const uint_fast8_t folded = extra ? (uint_fast8_t)__builtin_ctzll(extra) + 1
+                                      : (uint_fast8_t)(val + srcP - p);
+    uint8_t *reg = &max[idx & (HLL_REGISTERS_P(p) - 1)];
+    if (folded > *reg) {
+        *reg = folded;
+    }
+}
+
+/* Merge registers [start, end) of the precision 'p' raw array 'max' with
+ * the dense sketch 'hdr' by computing MAX(max[i], hdr[i]).
+ *
+ * A source with a higher precision is folded: every source register whose
+ * low 'p' index bits fall inside [start, end) is visited. For a source of
+ * the same precision, 'start' and 'end' must be multiples of 16 so the
+ * vector path always decodes whole 12 byte groups. */
+static void hyperloglogMergeDenseRange(uint8_t *restrict max, const uint32_t p,
+                                       const hyperloglog *restrict hdr,
+                                       const uint32_t srcP,
+                                       const uint32_t start,
+                                       const uint32_t end) {
+    if (srcP != p) {
         uint8_t val;
-        for (size_t i = 0; i < HLL_REGISTERS; i++) {
-            HLL_DENSE_GET_REGISTER(val, hdr->registers, i);
-            if (val > max[i]) {
-                max[i] = val;
+        for (uint32_t base = 0; base < HLL_REGISTERS_P(srcP);
+             base += HLL_REGISTERS_P(p)) {
+            for (uint32_t i = base + start; i < base + end; i++) {
+                HLL_DENSE_GET_REGISTER(val, hdr->registers, i);
+                if (val) {
+                    hyperloglogFoldRegister(max, p, srcP, i, val);
+                }
             }
         }
+
+        return;
+    }
+
+#if (HLL_USE_NEON || HLL_USE_SSE) && HLL_BITS == 6
+    /* Vector merge: process 16 registers (12 packed bytes) at a time.
+     * Unpacks 6-bit registers to 8-bit, then uses vector max. */
+    assert(start % 16 == 0 && end % 16 == 0);
+    const uint8_t *r = hdr->registers + (start / 16) * 12;
+    for (uint32_t j = start; j < end; j += 16) {
+        /* Unpack 16 6-bit registers from 12 bytes into temporary buffer */
+        uint8_t unpacked[16];
+        unpacked[0] = r[0] & 63;
+        unpacked[1] = (r[0] >> 6 | r[1] << 2) & 63;
+        unpacked[2] = (r[1] >> 4 | r[2] << 4) & 63;
+        unpacked[3] = (r[2] >> 2) & 63;
+        unpacked[4] = r[3] & 63;
+        unpacked[5] = (r[3] >> 6 | r[4] << 2) & 63;
+        unpacked[6] = (r[4] >> 4 | r[5] << 4) & 63;
+        unpacked[7] = (r[5] >> 2) & 63;
+        unpacked[8] = r[6] & 63;
+        unpacked[9] = (r[6] >> 6 | r[7] << 2) & 63;
+        unpacked[10] = (r[7] >> 4 | r[8] << 4) & 63;
+        unpacked[11] = (r[8] >> 2) & 63;
+        unpacked[12] = r[9] & 63;
+        unpacked[13] = (r[9] >> 6 | r[10] << 2) & 63;
+        unpacked[14] = (r[10] >> 4 | r[11] << 4) & 63;
+        unpacked[15] = (r[11] >> 2) & 63;
+
+#if HLL_USE_NEON
+        /* NEON vector max operation - 16 bytes at once */
+        uint8x16_t src = vld1q_u8(unpacked);
+        uint8x16_t dst = vld1q_u8(&max[j]);
+        vst1q_u8(&max[j], vmaxq_u8(src, dst));
+#else
+        /* SSE vector max operation - 16 bytes at once */
+        __m128i src = _mm_loadu_si128((__m128i *)unpacked);
+        __m128i dst = _mm_loadu_si128((__m128i *)&max[j]);
+        _mm_storeu_si128((__m128i *)&max[j], _mm_max_epu8(src, dst));
 #endif
-    } else {
-        uint8_t *p = (uint8_t *)hdr;
-        uint8_t *end = p + mdsclen(toMDSC(hdr));
-        int64_t runlen;
-        int64_t regval;
 
-        p += HLL_HDR_SIZE;
-        int_fast32_t i = 0;
-        while (p < end) {
-            if (HLL_SPARSE_IS_ZERO(p)) {
-                runlen = HLL_SPARSE_ZERO_LEN(p);
-                i += runlen;
-                p++;
-            } else if (HLL_SPARSE_IS_XZERO(p)) {
-                runlen = HLL_SPARSE_XZERO_LEN(p);
-                i += runlen;
-                p += 2;
-            } else {
-                runlen = HLL_SPARSE_VAL_LEN(p);
-                regval = HLL_SPARSE_VAL_VALUE(p);
+        r += 12;
+    }
+#else
+    /* Scalar fallback */
+    uint8_t val;
+    for (uint32_t i = start; i < end; i++) {
+        HLL_DENSE_GET_REGISTER(val, hdr->registers, i);
+        if (val > max[i]) {
+            max[i] = val;
+        }
+    }
+#endif
+}
 
-                /* too big, corrupt */
-                if ((runlen + i) > HLL_REGISTERS) {
-                    return false;
-                }
+/* Sparse version of hyperloglogMergeDenseRange(). The opcodes are walked
+ * from the beginning; for a source of the same precision the walk stops
+ * once it passes 'end'.
+ *
+ * Returns false if the sparse representation is found to be invalid. Only
+ * a walk reaching the end of the opcodes can see every error, which a walk
+ * with 'end' of 2^p always does. */
+static bool hyperloglogMergeSparseRange(uint8_t *restrict max,
+                                        const uint32_t p,
+                                        const hyperloglog *restrict hdr,
+                                        const uint32_t srcP,
+                                        const uint32_t start,
+                                        const uint32_t end) {
+    const uint8_t *s = hdr->registers;
+    const uint8_t *send = (const uint8_t *)hdr + mdsclen(toMDSC(hdr));
+    const uint32_t mask = HLL_REGISTERS_P(p) - 1;
+    int64_t runlen;
+    int64_t regval;
+    int64_t i = 0;
+
+    while (s < send) {
+        if (HLL_SPARSE_IS_ZERO(s)) {
+            runlen = HLL_SPARSE_ZERO_LEN(s);
+            i += runlen;
+            s++;
+        } else if (HLL_SPARSE_IS_XZERO(s)) {
+            runlen = HLL_SPARSE_XZERO_LEN(s);
+            i += runlen;
+            s += 2;
+        } else {
+            runlen = HLL_SPARSE_VAL_LEN(s);
+            regval = HLL_SPARSE_VAL_VALUE(s);
 
-                while (runlen--) {
-                    if (regval > max[i]) {
+            /* too big, corrupt */
+            if ((runlen + i) > HLL_REGISTERS_P(srcP)) {
+                return false;
+            }
+
+            while (runlen--) {
+                const uint32_t target = i & mask;
+                if (target >= start && target < end) {
+                    if (srcP != p) {
+                        hyperloglogFoldRegister(max, p, srcP, i, regval);
+                    } else if (regval > max[i]) {
                         max[i] = regval;
                     }
-
-                    i++;
                 }
 
-                p++;
+                i++;
             }
+
+            s++;
         }
 
-        if (i != HLL_REGISTERS) {
-            return false;
+        if (srcP == p && i >= end && end != HLL_REGISTERS_P(p)) {
+            return true;
         }
     }
 
-    return true;
+    return i == HLL_REGISTERS_P(srcP);
+}
+
+/* Merge by computing MAX(registers[i],hyperloglog[i]) the HyperLogLog
+ * 'hyperloglog' with the HLL_RAW array of uint8_t registers in 'target'.
+ *
+ * The hyperloglog object must be valid (either by hyperloglogDetect() or some
+ * other way).
+ *
+ * A source with a higher precision than 'target' is folded down to the
+ * target precision. A source with a lower precision can't be merged.
+ *
+ * If the HyperLogLog is sparse and is found to be invalid, or the source
+ * has a lower precision than the target, false is returned, otherwise the
+ * function always succeeds. */
+bool hyperloglogMerge(hyperloglog *restrict target,
+                      const hyperloglog *restrict hdr) {
+    const uint32_t p = hllP(target);
+    const uint32_t srcP = hllP(hdr);
+
+    /* Target must use 8-bit per register (HLL_RAW) for direct array access.
+     * Source should be DENSE or SPARSE, not RAW. */
+    assert(target->encoding == HLL_RAW);
+    assert(hdr->encoding != HLL_RAW);
+
+    if (srcP < p) {
+        return false;
+    }
+
+    if (isDense(hdr)) {
+        hyperloglogMergeDenseRange(target->registers, p, hdr, srcP, 0,
+                                   HLL_REGISTERS_P(p));
+        return true;
+    }
+
+    return hyperloglogMergeSparseRange(target->registers, p, hdr, srcP, 0,
+                                       HLL_REGISTERS_P(p));
 }
 
 /* ========================== HyperLogLog commands ========================== */
 
-/* New HLL object. We always create the HLL using sparse encoding.
- * This will be upgraded to the dense representation as needed. */
-hyperloglog *hyperloglogNew(void) {
+/* New HLL object with 2^p registers. We always create the HLL using sparse
+ * encoding. This will be upgraded to the dense representation as needed. */
+hyperloglog *hyperloglogNewPrecision(uint32_t p) {
+    assert(p >= HLL_P_MIN && p <= HLL_P_MAX);
+
     const size_t sparselen =
-        HLL_HDR_SIZE + (((HLL_REGISTERS + (HLL_SPARSE_XZERO_MAX_LEN - 1)) /
+        HLL_HDR_SIZE + (((HLL_REGISTERS_P(p) + (HLL_SPARSE_XZERO_MAX_LEN - 1)) /
                          HLL_SPARSE_XZERO_MAX_LEN) *
                         2);
 
     /* Populate the sparse representation with as many XZERO opcodes as
      * needed to represent all the registers. */
-    int_fast32_t aux = HLL_REGISTERS;
+    int_fast32_t aux = HLL_REGISTERS_P(p);
 
     const mdsc *s = mdscnewlen(NULL, sparselen);
     hyperloglog *restrict h = toHLL(s);
 
-    uint8_t *p = (uint8_t *)h + HLL_HDR_SIZE;
+    uint8_t *cursor = (uint8_t *)h + HLL_HDR_SIZE;
 
     while (aux) {
         int_fast32_t xzero = HLL_SPARSE_XZERO_MAX_LEN;
@@ -1392,26 +1529,42 @@ hyperloglog *hyperloglogNew(void) {
             xzero = aux;
         }
 
-        HLL_SPARSE_XZERO_SET(p, xzero);
-        p += 2;
+        HLL_SPARSE_XZERO_SET(cursor, xzero);
+        cursor += 2;
         aux -= xzero;
     }
 
-    assert((p - (uint8_t *)s) == sparselen);
+    assert((cursor - (uint8_t *)s) == sparselen);
 
     /* Create the actual object. */
     h->encoding = HLL_SPARSE;
+    hllSetP(h, p);
     return h;
 }
 
+hyperloglog *hyperloglogNewDensePrecision(uint32_t p) {
+    assert(p >= HLL_P_MIN && p <= HLL_P_MAX);
+
+    hyperloglog *dense = toHLL(mdscnewlen(NULL, HLL_DENSE_SIZE_P(p)));
+    dense->encoding = HLL_DENSE;
+    hllSetP(dense, p);
+    return dense;
+}
+
+hyperloglog *hyperloglogNew(void) {
+    return hyperloglogNewPrecision(HLL_P);
+}
+
 hyperloglog *hyperloglogNewSparse(void) {
     return hyperloglogNew();
 }
 
 hyperloglog *hyperloglogNewDense(void) {
-    hyperloglog *dense = toHLL(mdscnewlen(NULL, HLL_DENSE_SIZE));
-    dense->encoding = HLL_DENSE;
-    return dense;
+    return hyperloglogNewDensePrecision(HLL_P);
+}
+
+uint32_t hyperloglogPrecision(const hyperloglog *h) {
+    return hllP(h);
 }
 
 void hyperloglogFree(hyperloglog *h) {
@@ -1449,8 +1602,13 @@ bool hyperloglogDetect(hyperloglog *h) {
         return false;
     }
 
+    if (h->precision &&
+        (h->precision < HLL_P_MIN || h->precision > HLL_P_MAX)) {
+        return false;
+    }
+
     /* Dense representation string length should match exactly. */
-    if ((h->encoding == HLL_DENSE) && (len != HLL_DENSE_SIZE)) {
+    if ((h->encoding == HLL_DENSE) && (len != HLL_DENSE_SIZE_P(hllP(h)))) {
         return false;
     }
 
@@ -1535,7 +1693,7 @@ uint64_t pfcountSingle(hyperloglog *h) {
 
         if (card < HLL_CARDINALITY_MAX) {
             /* You've got bigger problems if your count
-             * reaches 2^61 - 1... */
+             * reaches 2^56 - 1... */
             hdr->cardinality = card;
             hdr->cardinalityValid = true;
         }
@@ -1549,91 +1707,155 @@ uint64_t pfcountSingle(hyperloglog *h) {
     return card;
 }
 
-DK_INLINE_ALWAYS uint64_t pfvcount(hyperloglog *first, va_list ap) {
-#if 0
-    hyperloglog *second = va_arg(ap, hyperloglog *);
-    if (!second) {
-        return pfcountSingle(first);
+/* Lowest precision of 'first' and the NULL terminated sketches in 'ap'.
+ * Multi-sketch operations run at this precision since higher precision
+ * sketches can be folded down but not up. */
+static uint32_t hyperloglogMinPrecision(const hyperloglog *first, va_list ap) {
+    uint32_t p = hllP(first);
+    va_list scan;
+    va_copy(scan, ap);
+    const hyperloglog *current;
+    while ((current = va_arg(scan, const hyperloglog *))) {
+        if (hllP(current) < p) {
+            p = hllP(current);
+        }
     }
-#endif
 
-    /* multi-key keys, cardinality of the union.
-     *
-     * When multiple keys are specified, PFCOUNT actually computes
-     * the cardinality of the merge of the N HLLs specified. */
-    hllStatic max = {0};
-
-    /* Compute an HLL with M[i] = MAX(M[i]_j). */
-    hyperloglog *hdr = toHLL(max);
-    hdr->encoding = HLL_RAW; /* Special internal-only encoding. */
-
-    HLL_MERGE(hdr, first, -1);
-#if 0
-    HLL_MERGE(hdr, second, -1);
-#endif
+    va_end(scan);
+    return p;
+}
 
-    hyperloglog *current;
-    while ((current = va_arg(ap, hyperloglog *))) {
-        HLL_MERGE(hdr, current, -1);
+/* Zeroed HLL_RAW registers at precision 'p'. Uses the caller's 'stack'
+ * buffer when it is large enough, otherwise allocates; release with
+ * hyperloglogRawFree(). */
+static hyperloglog *hyperloglogRawNew(hllStatic stack, uint32_t p) {
+    hyperloglog *raw;
+    if (HLL_REGISTERS_P(p) <= HLL_REGISTERS) {
+        raw = toHLL(stack);
+        memset(raw, 0, HLL_HDR_SIZE + HLL_REGISTERS_P(p));
+    } else {
+        raw = zcalloc(1, HLL_HDR_SIZE + HLL_REGISTERS_P(p));
     }
 
-    /* Compute cardinality of the resulting set. */
-    return hyperloglogCount_(hdr, NULL);
+    raw->encoding = HLL_RAW; /* Special internal-only encoding. */
+    hllSetP(raw, p);
+    return raw;
 }
 
-/* Returns merged count of all input parameters. */
-uint64_t pfcount(hyperloglog *h, ...) {
-    va_list ap;
-    va_start(ap, h);
-    const uint64_t count = pfvcount(h, ap);
-    va_end(ap);
-    return count;
+static void hyperloglogRawFree(hllStatic stack, hyperloglog *raw) {
+    if ((uint8_t *)raw != stack) {
+        zfree(raw);
+    }
 }
 
-/* PFMERGE src1 src2 src3 ... srcN NULL => merged HLL */
-DK_INLINE_ALWAYS hyperloglog *pfvmerge(hyperloglog *first, va_list ap) {
-    hllStatic max = {0};
-    hyperloglog *restrict total = toHLL(max);
-    bool useDense = false;
+/* Compute an HLL with M[i] = MAX(M[i]_j) over 'first' and the NULL
+ * terminated sketches in 'ap'. Returns NULL if any input is invalid. */
+static hyperloglog *hyperloglogRawMergeAll(hllStatic stack,
+                                           hyperloglog *first, va_list ap,
+                                           bool *anyDense) {
+    hyperloglog *raw =
+        hyperloglogRawNew(stack, hyperloglogMinPrecision(first, ap));
+    *anyDense = isDense(first);
+
+    if (!hyperloglogMerge(raw, first)) {
+        hyperloglogRawFree(stack, raw);
+        return NULL;
+    }
 
-    HLL_MERGE(total, first, NULL);
-    /* Compute an HLL with M[i] = MAX(M[i]_j).
-     * We we the maximum into the max array of registers. We'll write
-     * it to the target variable later. */
     hyperloglog *current;
     while ((current = va_arg(ap, hyperloglog *))) {
-        HLL_MERGE(total, current, NULL);
-        if (current->encoding == HLL_DENSE) {
-            useDense = true;
+        if (!hyperloglogMerge(raw, current)) {
+            hyperloglogRawFree(stack, raw);
+            return NULL;
         }
+
+        *anyDense |= isDense(current);
     }
 
+    return raw;
+}
+
+/* New sketch holding the registers of 'raw' at the precision of 'raw'.
+ * The result is dense if 'dense', otherwise sparse (promoting to dense on
+ * its own if the registers don't fit the sparse representation). */
+static hyperloglog *hyperloglogFromRaw(const hyperloglog *raw, bool dense) {
+    const uint32_t p = hllP(raw);
+    const uint8_t *registers = raw->registers;
+
     /* Create / unshare the destination key's value if needed. */
-    hyperloglog *result = hyperloglogNew();
+    hyperloglog *result = hyperloglogNewPrecision(p);
 
     /* Convert the destination object to dense representation if at least
      * one of the inputs was dense. */
-    if (useDense && !hyperloglogSparseToDense(&result)) {
+    if (dense && !hyperloglogSparseToDense(&result)) {
         return NULL;
     }
 
     /* Write the resulting HLL to the destination HLL registers and
      * invalidate the cached value. */
-    for (int j = 0; j < HLL_REGISTERS; j++) {
-        if (max[j] == 0) {
+    for (uint32_t j = 0; j < HLL_REGISTERS_P(p); j++) {
+        if (registers[j] == 0) {
             continue;
         }
 
         if (result->encoding == HLL_DENSE) {
-            hyperloglogDenseSet(result->registers, j, max[j]);
+            hyperloglogDenseSet(result->registers, j, registers[j]);
         } else {
             /* else, HLL_SPARSE */
-            hyperloglogSparseSet(&result, j, max[j]);
+            hyperloglogSparseSet(&result, j, registers[j]);
         }
     }
 
     HLL_INVALIDATE_CACHE(result);
+    return result;
+}
 
+DK_INLINE_ALWAYS uint64_t pfvcount(hyperloglog *first, va_list ap) {
+    /* multi-key keys, cardinality of the union.
+     *
+     * When multiple keys are specified, PFCOUNT actually computes
+     * the cardinality of the merge of the N HLLs specified. */
+    hllStatic max;
+    bool anyDense;
+
+    hyperloglog *hdr = hyperloglogRawMergeAll(max, first, ap, &anyDense);
+    if (!hdr) {
+        return -1;
+    }
+
+    /* Compute cardinality of the resulting set. */
+    const uint64_t count = hyperloglogCount_(hdr, NULL);
+    hyperloglogRawFree(max, hdr);
+    return count;
+}
+
+/* Returns merged count of all input parameters. */
+uint64_t pfcount(hyperloglog *h, ...) {
+    va_list ap;
+    va_start(ap, h);
+    const uint64_t count = pfvcount(h, ap);
+    va_end(ap);
+    return count;
+}
+
+/* PFMERGE src1 src2 src3 ... srcN NULL => merged HLL
+ *
+ * The result has the lowest precision of all inputs. */
+DK_INLINE_ALWAYS hyperloglog *pfvmerge(hyperloglog *first, va_list ap) {
+    hllStatic max;
+    bool useDense;
+
+    /* Compute an HLL with M[i] = MAX(M[i]_j).
+     * We we the maximum into the max array of registers. We'll write
+     * it to the target variable later. */
+    hyperloglog *restrict total =
+        hyperloglogRawMergeAll(max, first, ap, &useDense);
+    if (!total) {
+        return NULL;
+    }
+
+    hyperloglog *result = hyperloglogFromRaw(total, useDense);
+    hyperloglogRawFree(max, total);
     return result;
 }
 
@@ -1646,6 +1868,159 @@ hyperloglog *pfmerge(hyperloglog *h, ...) {
     return merged;
 }
 
+/* ======================= Parallel many-sketch union ======================= */
+
+/* Smallest register slice given to one worker thread. Below this, thread
+ * startup costs more than the merge itself. */
+#define HLL_MERGE_MANY_MIN_SLICE 2048
+
+typedef struct hyperloglogMergeSlice {
+    hyperloglog *const *hlls;
+    size_t count;
+    uint8_t *max;
+    uint32_t p;
+    uint32_t start;
+    uint32_t end;
+    bool valid;
+} hyperloglogMergeSlice;
+
+/* Merge registers [start, end) of every input into the shared raw array.
+ * Slices never overlap, so workers write 'max' without synchronization. */
+static void *hyperloglogMergeSliceRun(void *arg) {
+    hyperloglogMergeSlice *slice = arg;
+    slice->valid = true;
+
+    for (size_t i = 0; i < slice->count; i++) {
+        const hyperloglog *h = slice->hlls[i];
+        if (isDense(h)) {
+            hyperloglogMergeDenseRange(slice->max, slice->p, h, hllP(h),
+                                       slice->start, slice->end);
+        } else if (!hyperloglogMergeSparseRange(slice->max, slice->p, h,
+                                                hllP(h), slice->start,
+                                                slice->end)) {
+            slice->valid = false;
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+/* Compute M[i] = MAX(M[i]_j) over 'hlls' into raw registers at the lowest
+ * input precision, splitting the register space across up to 'threads'
+ * threads (the calling thread works the first slice). Returns NULL if any
+ * input is invalid. */
+static hyperloglog *hyperloglogRawMergeMany(hllStatic stack,
+                                            hyperloglog *const *hlls,
+                                            size_t count, uint32_t threads,
+                                            bool *anyDense) {
+    uint32_t p = HLL_P_MAX;
+    *anyDense = false;
+    for (size_t i = 0; i < count; i++) {
+        if (hllP(hlls[i]) < p) {
+            p = hllP(hlls[i]);
+        }
+
+        *anyDense |= isDense(hlls[i]);
+    }
+
+    hyperloglog *raw = hyperloglogRawNew(stack, p);
+
+    /* Slices are multiples of 16 registers for the vector merge. */
+    const uint32_t registers = HLL_REGISTERS_P(p);
+    uint32_t slices = threads ? threads : 1;
+    if (slices > registers / HLL_MERGE_MANY_MIN_SLICE) {
+        slices = registers / HLL_MERGE_MANY_MIN_SLICE;
+    }
+
+    if (slices < 1) {
+        slices = 1;
+    }
+
+    const uint32_t sliceLen = ((registers / slices) + 15) & ~15U;
+
+    hyperloglogMergeSlice work[slices];
+    pthread_t tids[slices];
+    bool started[slices];
+
+    for (uint32_t i = 0; i < slices; i++) {
+        const uint32_t start = i * sliceLen;
+        work[i] = (hyperloglogMergeSlice){
+            .hlls = hlls,
+            .count = count,
+            .max = raw->registers,
+            .p = p,
+            .start = start,
+            .end = i == slices - 1 ? registers : start + sliceLen,
+        };
+
+        /* If a thread can't be created its slice runs inline below. */
+        started[i] = i > 0 && pthread_create(&tids[i], NULL,
+                                             hyperloglogMergeSliceRun,
+                                             &work[i]) == 0;
+    }
+
+    bool valid = true;
+    for (uint32_t i = 0; i < slices; i++) {
+        if (started[i]) {
+            pthread_join(tids[i], NULL);
+        } else {
+            hyperloglogMergeSliceRun(&work[i]);
+        }
+
+        valid &= work[i].valid;
+    }
+
+    if (!valid) {
+        hyperloglogRawFree(stack, raw);
+        return NULL;
+    }
+
+    return raw;
+}
+
+/* Cardinality of the union of 'count' sketches. */
+uint64_t hyperloglogCountMany(hyperloglog *const *hlls, size_t count,
+                              uint32_t threads) {
+    hllStatic max;
+    bool anyDense;
+
+    if (!count) {
+        return 0;
+    }
+
+    hyperloglog *raw =
+        hyperloglogRawMergeMany(max, hlls, count, threads, &anyDense);
+    if (!raw) {
+        return -1;
+    }
+
+    const uint64_t card = hyperloglogCount_(raw, NULL);
+    hyperloglogRawFree(max, raw);
+    return card;
+}
+
+/* New sketch holding the union of 'count' sketches. */
+hyperloglog *hyperloglogMergeMany(hyperloglog *const *hlls, size_t count,
+                                  uint32_t threads) {
+    hllStatic max;
+    bool anyDense;
+
+    if (!count) {
+        return hyperloglogNew();
+    }
+
+    hyperloglog *raw =
+        hyperloglogRawMergeMany(max, hlls, count, threads, &anyDense);
+    if (!raw) {
+        return NULL;
+    }
+
+    hyperloglog *result = hyperloglogFromRaw(raw, anyDense);
+    hyperloglogRawFree(max, raw);
+    return result;
+}
+
 /* ========================== Testing / Debugging  ========================== */
 
 #ifdef DATAKIT_TEST
@@ -1731,7 +2106,8 @@ int hyperloglogTest(int argc, char *argv[]) {
                    j, (float)j / testCount * 100);
         }
         ele = j ^ seed;
-        hyperloglogDenseAdd(hdr->registers, (uint8_t *)&ele, sizeof(ele));
+        hyperloglogDenseAdd(hdr->registers, HLL_P, (uint8_t *)&ele,
+                            sizeof(ele));
         hyperloglogAdd(&h, &ele, sizeof(ele));
 
         /* Make sure for small cardinalities we use sparse encoding. */
@@ -1905,7 +2281,7 @@ cleanup:
         uint64_t startSIMD = timeUtilMonotonicNs();
         for (int iter = 0; iter < histoIterations; iter++) {
             memset(reghistoSIMD, 0, sizeof(reghistoSIMD));
-            hyperloglogRawRegisterHistogram(testRegisters, reghistoSIMD);
+            hyperloglogRawRegisterHistogram(testRegisters, HLL_P, reghistoSIMD);
         }
         uint64_t endSIMD = timeUtilMonotonicNs();
 
@@ -1913,7 +2289,7 @@ cleanup:
         uint64_t startScalar = timeUtilMonotonicNs();
         for (int iter = 0; iter < histoIterations; iter++) {
             memset(reghistoScalar, 0, sizeof(reghistoScalar));
-            hyperloglogRawRegisterHistogramScalar(testRegisters,
+            hyperloglogRawRegisterHistogramScalar(testRegisters, HLL_P,
                                                   reghistoScalar);
         }
         uint64_t endScalar = timeUtilMonotonicNs();
@@ -1921,8 +2297,9 @@ cleanup:
         /* Verify correctness: SIMD result should match scalar */
         memset(reghistoSIMD, 0, sizeof(reghistoSIMD));
         memset(reghistoScalar, 0, sizeof(reghistoScalar));
-        hyperloglogRawRegisterHistogram(testRegisters, reghistoSIMD);
-        hyperloglogRawRegisterHistogramScalar(testRegisters, reghistoScalar);
+        hyperloglogRawRegisterHistogram(testRegisters, HLL_P, reghistoSIMD);
+        hyperloglogRawRegisterHistogramScalar(testRegisters, HLL_P,
+                                              reghistoScalar);
 
         int histoMismatch = 0;
         for (int i = 0; i < HLL_Q + 2; i++) {
@@ -1954,6 +2331,347 @@ cleanup:
         zfree(testRegisters);
     }
 
+    const uint64_t pseed = (uint64_t)rand() | (uint64_t)rand() << 32;
+
+    /* Test 6: approximation error at non-default precisions. */
+    printf("[precision error]: Testing precisions 4, 10, 14, 18...\n");
+    {
+        const uint32_t precisions[] = {4, 10, 14, 18};
+        for (size_t k = 0; k < sizeof(precisions) / sizeof(*precisions);
+             k++) {
+            const uint32_t p = precisions[k];
+            const double perr = 1.04 / sqrt(HLL_REGISTERS_P(p));
+            hyperloglog *ph = hyperloglogNewPrecision(p);
+            uint64_t pcheck = 1000;
+
+            if (hyperloglogPrecision(ph) != p) {
+                printf("TESTFAILED precision %u reported as %u\n", p,
+                       hyperloglogPrecision(ph));
+                errors++;
+            }
+
+            for (uint64_t j = 1; j <= 1000000; j++) {
+                const uint64_t pele = j ^ pseed;
+                hyperloglogAdd(&ph, &pele, sizeof(pele));
+                if (j == pcheck) {
+                    HLL_INVALIDATE_CACHE(ph);
+                    int64_t abserr = (int64_t)j - (int64_t)pfcountSingle(ph);
+                    if (abserr < 0) {
+                        abserr = -abserr;
+                    }
+
+                    if (abserr > (int64_t)ceil(perr * 6 * j)) {
+                        printf("TESTFAILED p=%u card:%" PRIu64
+                               " abserr:%" PRId64 "\n",
+                               p, j, abserr);
+                        errors++;
+                    }
+
+                    pcheck *= 10;
+                }
+            }
+
+            if (!isDense(ph) || !hyperloglogDetect(ph) ||
+                mdsclen(toMDSC(ph)) != HLL_DENSE_SIZE_P(p)) {
+                printf("TESTFAILED p=%u dense size %zu != %zu\n", p,
+                       mdsclen(toMDSC(ph)), (size_t)HLL_DENSE_SIZE_P(p));
+                errors++;
+            }
+
+            hyperloglogFree(ph);
+        }
+    }
+
+    /* Test 7: hyperloglogAddMany() builds the same registers as
+     * hyperloglogAdd() one element at a time, through sparse promotion. */
+    printf("[add many]: Testing batch add matches single adds...\n");
+    {
+        const size_t total = 50000;
+        const size_t chunk = 1000;
+        uint64_t *vals = zcalloc(total, sizeof(*vals));
+        const void **ptrs = zcalloc(total, sizeof(*ptrs));
+        size_t *lens = zcalloc(total, sizeof(*lens));
+        for (size_t i = 0; i < total; i++) {
+            vals[i] = i * 0x9e3779b97f4a7c15ULL;
+            ptrs[i] = &vals[i];
+            lens[i] = sizeof(vals[i]);
+        }
+
+        const uint32_t precisions[] = {10, HLL_P};
+        for (size_t k = 0; k < sizeof(precisions) / sizeof(*precisions);
+             k++) {
+            hyperloglog *one = hyperloglogNewPrecision(precisions[k]);
+            hyperloglog *many = hyperloglogNewPrecision(precisions[k]);
+            for (size_t i = 0; i < total; i++) {
+                hyperloglogAdd(&one, ptrs[i], lens[i]);
+            }
+
+            for (size_t i = 0; i < total; i += chunk) {
+                if (hyperloglogAddMany(&many, &ptrs[i], &lens[i], chunk) < 0) {
+                    printf("TESTFAILED add many reported invalid sketch\n");
+                    errors++;
+                }
+            }
+
+            HLL_INVALIDATE_CACHE(one);
+            if (one->encoding != many->encoding ||
+                mdsclen(toMDSC(one)) != mdsclen(toMDSC(many)) ||
+                memcmp(one->registers, many->registers,
+                       mdsclen(toMDSC(one)) - HLL_HDR_SIZE) ||
+                pfcountSingle(one) != pfcountSingle(many)) {
+                printf("TESTFAILED add many differs at p=%u\n",
+                       precisions[k]);
+                errors++;
+            }
+
+            hyperloglogFree(one);
+            hyperloglogFree(many);
+        }
+
+        zfree(vals);
+        zfree(ptrs);
+        zfree(lens);
+    }
+
+    /* Test 8: merging different precisions folds to the lower precision
+     * and matches a sketch built at that precision exactly. */
+    printf("[precision merge]: Testing p18 + p12 folds to p12...\n");
+    {
+        const uint64_t sizes[] = {200, 200000};
+        for (size_t k = 0; k < sizeof(sizes) / sizeof(*sizes); k++) {
+            hyperloglog *h18 = hyperloglogNewPrecision(18);
+            hyperloglog *h12 = hyperloglogNewPrecision(12);
+            for (uint64_t i = 0; i < sizes[k]; i++) {
+                const uint64_t v = i ^ pseed;
+                hyperloglogAdd(&h18, &v, sizeof(v));
+                hyperloglogAdd(&h12, &v, sizeof(v));
+            }
+
+            hyperloglog *both = pfmerge(h18, h12, (hyperloglog *)NULL);
+            const uint64_t expect = pfcountSingle(h12);
+
+            /* Folding p18 alone reproduces the p12 registers exactly. */
+            hllStatic foldStack;
+            hllStatic directStack;
+            hyperloglog *folded = hyperloglogRawNew(foldStack, 12);
+            hyperloglog *direct = hyperloglogRawNew(directStack, 12);
+            if (!hyperloglogMerge(folded, h18) ||
+                !hyperloglogMerge(direct, h12) ||
+                memcmp(folded->registers, direct->registers,
+                       HLL_REGISTERS_P(12))) {
+                printf("TESTFAILED folded registers differ from p12\n");
+                errors++;
+            }
+
+            if (!both || hyperloglogPrecision(both) != 12) {
+                printf("TESTFAILED merge did not produce p12\n");
+                errors++;
+            } else if (pfcountSingle(both) != expect ||
+                       pfcount(h12, h18, (hyperloglog *)NULL) != expect ||
+                       pfcount(h18, h12, (hyperloglog *)NULL) != expect) {
+                printf("TESTFAILED merged count %" PRIu64
+                       " != p12 count %" PRIu64 "\n",
+                       pfcountSingle(both), expect);
+                errors++;
+            }
+
+            /* Lower precision can't be merged up into higher precision. */
+            hllStatic stack;
+            hyperloglog *raw = hyperloglogRawNew(stack, 18);
+            if (hyperloglogMerge(raw, h12)) {
+                printf("TESTFAILED merged p12 into p18\n");
+                errors++;
+            }
+
+            hyperloglogRawFree(stack, raw);
+            hyperloglogRawFree(foldStack, folded);
+            hyperloglogRawFree(directStack, direct);
+            hyperloglogFree(h18);
+            hyperloglogFree(h12);
+            hyperloglogFree(both);
+        }
+    }
+
+    /* Test 9: the sparse representation grows up to a third of the dense
+     * size of its own precision before converting. */
+    printf("[precision sparse]: Testing sparse thresholds scale with p...\n");
+    {
+        const uint32_t precisions[] = {8, 12, 16};
+        uint64_t prevPromoted = 0;
+        for (size_t k = 0; k < sizeof(precisions) / sizeof(*precisions);
+             k++) {
+            const uint32_t p = precisions[k];
+            hyperloglog *ph = hyperloglogNewPrecision(p);
+            size_t maxSparse = 0;
+            uint64_t promoted = 0;
+            for (uint64_t j = 1; j <= 1000000 && !promoted; j++) {
+                const uint64_t pele = j ^ pseed;
+                hyperloglogAdd(&ph, &pele, sizeof(pele));
+                if (isSparse(ph)) {
+                    if (mdsclen(toMDSC(ph)) > maxSparse) {
+                        maxSparse = mdsclen(toMDSC(ph));
+                    }
+                } else {
+                    promoted = j;
+                }
+            }
+
+            if (!promoted || maxSparse > HLL_SPARSE_MAX_BYTES(p) ||
+                promoted <= prevPromoted) {
+                printf("TESTFAILED p=%u promoted at %" PRIu64
+                       " with sparse max %zu (limit %u)\n",
+                       p, promoted, maxSparse, HLL_SPARSE_MAX_BYTES(p));
+                errors++;
+            }
+
+            prevPromoted = promoted;
+            hyperloglogFree(ph);
+        }
+    }
+
+    /* Test 10: batch add throughput vs single add. */
+    printf("[add many benchmark]: Benchmarking batch add...\n");
+    {
+        const size_t total = 1000000;
+        uint64_t *vals = zcalloc(total, sizeof(*vals));
+        const void **ptrs = zcalloc(total, sizeof(*ptrs));
+        size_t *lens = zcalloc(total, sizeof(*lens));
+        for (size_t i = 0; i < total; i++) {
+            vals[i] = i ^ pseed;
+            ptrs[i] = &vals[i];
+            lens[i] = sizeof(vals[i]);
+        }
+
+        hyperloglog *one = hyperloglogNewDense();
+        hyperloglog *many = hyperloglogNewDense();
+
+        uint64_t startOne = timeUtilMonotonicNs();
+        for (size_t i = 0; i < total; i++) {
+            hyperloglogAdd(&one, ptrs[i], lens[i]);
+        }
+        uint64_t endOne = timeUtilMonotonicNs();
+
+        uint64_t startMany = timeUtilMonotonicNs();
+        hyperloglogAddMany(&many, ptrs, lens, total);
+        uint64_t endMany = timeUtilMonotonicNs();
+
+        printf("  Add: %.1f ns/element, AddMany: %.1f ns/element\n",
+               (double)(endOne - startOne) / total,
+               (double)(endMany - startMany) / total);
+
+        hyperloglogFree(one);
+        hyperloglogFree(many);
+        zfree(vals);
+        zfree(ptrs);
+        zfree(lens);
+    }
+
+    /* Test 11: parallel many-sketch union matches a serial merge for mixed
+     * sparse/dense inputs and mixed precisions. */
+    printf("[merge many]: Testing parallel union...\n");
+    {
+        const size_t numHlls = 40;
+        hyperloglog *hlls[numHlls];
+        for (size_t i = 0; i < numHlls; i++) {
+            /* Every fifth sketch is a higher precision to exercise folding;
+             * small sketches stay sparse. */
+            hlls[i] = hyperloglogNewPrecision(i % 5 == 0 ? 16 : HLL_P);
+            const uint64_t elements = i % 2 ? 50 : 20000;
+            for (uint64_t j = 0; j < elements; j++) {
+                const uint64_t v = (i * 100000 + j) ^ pseed;
+                hyperloglogAdd(&hlls[i], &v, sizeof(v));
+            }
+        }
+
+        hllStatic serialStack;
+        hyperloglog *serial = hyperloglogRawNew(serialStack, HLL_P);
+        for (size_t i = 0; i < numHlls; i++) {
+            hyperloglogMerge(serial, hlls[i]);
+        }
+
+        const uint64_t expect = hyperloglogCount_(serial, NULL);
+        const uint32_t threadCounts[] = {0, 1, 3, 4, 8};
+        for (size_t k = 0; k < sizeof(threadCounts) / sizeof(*threadCounts);
+             k++) {
+            const uint32_t threads = threadCounts[k];
+            const uint64_t card = hyperloglogCountMany(hlls, numHlls, threads);
+            hyperloglog *merged = hyperloglogMergeMany(hlls, numHlls, threads);
+
+            hllStatic mergedStack;
+            hyperloglog *check = hyperloglogRawNew(mergedStack, HLL_P);
+            if (card != expect || !merged || !hyperloglogMerge(check, merged) ||
+                memcmp(check->registers, serial->registers, HLL_REGISTERS)) {
+                printf("TESTFAILED merge many with %u threads: %" PRIu64
+                       " != %" PRIu64 "\n",
+                       threads, card, expect);
+                errors++;
+            }
+
+            hyperloglogRawFree(mergedStack, check);
+            hyperloglogFree(merged);
+        }
+
+        /* All-sparse input stays sparse. */
+        hyperloglog *sparseOnly[] = {hlls[1], hlls[3], hlls[7]};
+        hyperloglog *sparseMerged = hyperloglogMergeMany(sparseOnly, 3, 4);
+        if (!sparseMerged || !isSparse(sparseMerged)) {
+            printf("TESTFAILED merge many of sparse inputs not sparse\n");
+            errors++;
+        }
+
+        hyperloglogFree(sparseMerged);
+        hyperloglogRawFree(serialStack, serial);
+        for (size_t i = 0; i < numHlls; i++) {
+            hyperloglogFree(hlls[i]);
+        }
+    }
+
+    /* Test 12: parallel union throughput vs serial merge. */
+    printf("[merge many benchmark]: Benchmarking parallel union...\n");
+    {
+        const size_t numHlls = 256;
+        const int iterations = 20;
+        hyperloglog *hlls[numHlls];
+        for (size_t i = 0; i < numHlls; i++) {
+            hlls[i] = hyperloglogNewDense();
+            for (uint64_t j = 0; j < 5000; j++) {
+                const uint64_t v = i * 5000 + j;
+                hyperloglogAdd(&hlls[i], &v, sizeof(v));
+            }
+        }
+
+        uint64_t start = timeUtilMonotonicNs();
+        for (int iter = 0; iter < iterations; iter++) {
+            hllStatic stack;
+            hyperloglog *raw = hyperloglogRawNew(stack, HLL_P);
+            for (size_t i = 0; i < numHlls; i++) {
+                hyperloglogMerge(raw, hlls[i]);
+            }
+
+            hyperloglogCount_(raw, NULL);
+        }
+        const uint64_t serialNs = timeUtilMonotonicNs() - start;
+
+        printf("  serial: %.1f us/union of %zu\n",
+               (double)serialNs / iterations / 1000, numHlls);
+
+        const uint32_t threadCounts[] = {1, 2, 4, 8};
+        for (size_t k = 0; k < sizeof(threadCounts) / sizeof(*threadCounts);
+             k++) {
+            start = timeUtilMonotonicNs();
+            for (int iter = 0; iter < iterations; iter++) {
+                hyperloglogCountMany(hlls, numHlls, threadCounts[k]);
+            }
+            const uint64_t ns = timeUtilMonotonicNs() - start;
+            printf("  %u threads: %.1f us/union (%.2fx)\n", threadCounts[k],
+                   (double)ns / iterations / 1000, (double)serialNs / ns);
+        }
+
+        for (size_t i = 0; i < numHlls; i++) {
+            hyperloglogFree(hlls[i]);
+        }
+    }
+
     return errors;
 }
 #endif
@@ -10,14 +10,34 @@ typedef struct hyperloglogHeader hyperloglog;
 hyperloglog *hyperloglogNew(void);
 hyperloglog *hyperloglogNewSparse(void);
 hyperloglog *hyperloglogNewDense(void);
+
+/* Precision 'p' (4 to 18) gives 2^p registers and a standard error of
+ * 1.04 / sqrt(2^p). The default precision is 14. */
+hyperloglog *hyperloglogNewPrecision(uint32_t p);
+hyperloglog *hyperloglogNewDensePrecision(uint32_t p);
+uint32_t hyperloglogPrecision(const hyperloglog *h);
 hyperloglog *hyperloglogCopy(const hyperloglog *src);
 void hyperloglogFree(hyperloglog *h);
 bool hyperloglogDetect(hyperloglog *h);
 uint64_t hyperloglogCount(hyperloglog *hdr, bool *invalid);
 int hyperloglogAdd(hyperloglog **inHll, const void *data, size_t size);
+int hyperloglogAddMany(hyperloglog **inHll, const void *const *data,
+                       const size_t *lens, size_t count);
+/* Merging sketches of different precisions folds to the lower precision;
+ * 'target' must not have a higher precision than 'hdr'. */
 bool hyperloglogMerge(hyperloglog *target, const hyperloglog *hdr);
 void hyperloglogInvalidateCache(hyperloglog *h);
 
+/* Union of 'count' sketches at the lowest input precision. The register
+ * space is split across up to 'threads' threads (0 or 1 merges in the
+ * calling thread). Sparse inputs are merged without converting to dense.
+ * CountMany returns UINT64_MAX and MergeMany returns NULL if any input is
+ * invalid. */
+uint64_t hyperloglogCountMany(hyperloglog *const *hlls, size_t count,
+                              uint32_t threads);
+hyperloglog *hyperloglogMergeMany(hyperloglog *const *hlls, size_t count,
+                                  uint32_t threads);
+
 /* User-friendly API */
 int pfadd(hyperloglog **hh, ...);
 uint64_t pfcount(hyperloglog *h, ...);
@@ -23,7 +23,44 @@ size_t intersectIntAVX2(const uint32_t *set1, const size_t length1,
                         uint32_t *out);
 #endif
 
-#if __AVX2__
+/* AVX-512 kernels are compiled with a per-function target attribute on any
+ * x86 AVX2 build and only run when the CPU reports AVX-512F at runtime, so
+ * one binary works on hosts with and without AVX-512. */
+#if __AVX2__ && (defined(__x86_64__) || defined(__i386__)) &&                  \
+    defined(__GNUC__)
+#define INTERSECT_INT_HAVE_AVX512 1
+#include <stdbool.h>
+/*
+ * True if the running CPU supports AVX-512F (checked once, then cached).
+ */
+bool intersectIntHasAVX512(void);
+
+/*
+ * intersectIntAVX2 with a 16x16 block-compare kernel for inputs within 2x of
+ * each other and scalar galloping from 1000x.
+ * Only call when intersectIntHasAVX512() is true.
+ */
+size_t intersectIntAVX512(const uint32_t *set1, const size_t length1,
+                          const uint32_t *set2, const size_t length2,
+                          uint32_t *out);
+
+/*
+ * intersectIntAVX512 or intersectIntAVX2, resolved on first call from
+ * intersectIntHasAVX512() and called through a function pointer after that.
+ */
+size_t intersectIntDispatch(const uint32_t *set1, const size_t length1,
+                            const uint32_t *set2, const size_t length2,
+                            uint32_t *out);
+#endif
+
+/*
+ * intersectIntAuto is the front-end: it resolves to the widest kernel set the
+ * build and the running CPU support, and each of those picks galloping / v3 /
+ * v1 by size ratio (>= 1000x, >= 50x, otherwise).
+ */
+#if INTERSECT_INT_HAVE_AVX512
+#define intersectIntAuto(a, b, c, d, e) intersectIntDispatch(a, b, c, d, e)
+#elif __AVX2__
 #define intersectIntAuto(a, b, c, d, e) intersectIntAVX2(a, b, c, d, e)
 #else
 #define intersectIntAuto(a, b, c, d, e) intersectInt(a, b, c, d, e)
@@ -41,6 +78,38 @@ size_t intersectIntOneSidedGalloping(const uint32_t *smallset,
                                      const uint32_t *largeset,
                                      const size_t largelength, uint32_t *out);
 
+/*
+ * Intersection of 'count' sorted sets, written to out (which must hold the
+ * smallest set). Sets are processed smallest-first, so each step is as
+ * skewed as possible, and processing stops as soon as the result is empty.
+ * Returns the cardinality of the intersection.
+ */
+size_t intersectIntMany(const uint32_t *const sets[], const size_t lengths[],
+                        const size_t count, uint32_t *out);
+
+/*
+ * Union of two sorted sets. out must hold length1 + length2 values and must
+ * not alias either input. Returns the cardinality of the union.
+ *
+ * Skewed inputs (>= 16x) gallop through the larger set and copy runs;
+ * otherwise a 4-lane SIMD merge (SSE4.1 or NEON) is used.
+ */
+size_t intersectIntUnion(const uint32_t *set1, const size_t length1,
+                         const uint32_t *set2, const size_t length2,
+                         uint32_t *out);
+
+/*
+ * Difference set1 \ set2 of two sorted sets. out must hold length1 values
+ * and can be set1. Returns the cardinality of the difference.
+ *
+ * Skewed inputs (set1 32x smaller or set2 50x smaller) gallop; otherwise a
+ * block-compare kernel (AVX-512 when the CPU has it, else SSE or NEON) is
+ * used.
+ */
+size_t intersectIntDifference(const uint32_t *set1, const size_t length1,
+                              const uint32_t *set2, const size_t length2,
+                              uint32_t *out);
+
 #ifdef DATAKIT_TEST
 int intersectIntTest(int argc, char *argv[]);
 #endif
@@ -129,6 +129,248 @@ void intsetAdd(intset **is, int64_t value, bool *success) {
     }
 }
 
+/* Sort in place: insertion sort for tiny batches, otherwise an LSD radix
+ * sort on the sign-flipped key that skips digits shared by every value
+ * (so batches of small IDs only pay for the low bytes). */
+static void intsetSortBatch(int64_t *values, int64_t *scratch, size_t count) {
+    if (count < 32) {
+        for (size_t i = 1; i < count; i++) {
+            const int64_t v = values[i];
+            size_t j = i;
+            while (j > 0 && values[j - 1] > v) {
+                values[j] = values[j - 1];
+                j--;
+            }
+
+            values[j] = v;
+        }
+
+        return;
+    }
+
+#define BATCH_KEY(v) ((uint64_t)(v) ^ (UINT64_C(1) << 63))
+    size_t hist[8][256] = {{0}};
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t key = BATCH_KEY(values[i]);
+        for (size_t d = 0; d < 8; d++) {
+            hist[d][(key >> (d * 8)) & 0xff]++;
+        }
+    }
+
+    int64_t *src = values;
+    int64_t *dst = scratch;
+    for (size_t d = 0; d < 8; d++) {
+        const size_t shift = d * 8;
+        if (hist[d][(BATCH_KEY(src[0]) >> shift) & 0xff] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; b++) {
+            const size_t c = hist[d][b];
+            hist[d][b] = offset;
+            offset += c;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            dst[hist[d][(BATCH_KEY(src[i]) >> shift) & 0xff]++] = src[i];
+        }
+
+        int64_t *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+#undef BATCH_KEY
+
+    if (src != values) {
+        memcpy(values, src, count * sizeof(*values));
+    }
+}
+
+/* Current number of int16_t and int32_t members of 'is' */
+static void intsetClassCounts(const intset *is, uint64_t *count16,
+                              uint64_t *count32) {
+    const void *ptr = INTSET_UNTAG(is);
+    switch (INTSET_TYPE(is)) {
+    case INTSET_TYPE_SMALL:
+        *count16 = ((const intsetSmall *)ptr)->count16;
+        *count32 = 0;
+        break;
+    case INTSET_TYPE_MEDIUM:
+        *count16 = ((const intsetMedium *)ptr)->count16;
+        *count32 = ((const intsetMedium *)ptr)->count32;
+        break;
+    case INTSET_TYPE_FULL:
+        *count16 = ((const intsetFull *)ptr)->count16;
+        *count32 = ((const intsetFull *)ptr)->count32;
+        break;
+    }
+}
+
+/* Record how many members of each batch class 'is' already holds. Each
+ * class is only compared against the array of the same width, so every
+ * common member is counted exactly once. */
+static void intsetCountCommonBatch(const intset *is, intsetBatch *b16,
+                                   intsetBatch *b32, intsetBatch *b64) {
+    const void *ptr = INTSET_UNTAG(is);
+    b16->common = 0;
+    b32->common = 0;
+    b64->common = 0;
+    switch (INTSET_TYPE(is)) {
+    case INTSET_TYPE_SMALL: {
+        const intsetSmall *small = ptr;
+        b16->common = intsetCountCommon16(small->values16, small->count16,
+                                          b16->values, b16->count);
+        break;
+    }
+
+    case INTSET_TYPE_MEDIUM: {
+        const intsetMedium *medium = ptr;
+        b16->common = intsetCountCommon16(medium->values16, medium->count16,
+                                          b16->values, b16->count);
+        b32->common = intsetCountCommon32(medium->values32, medium->count32,
+                                          b32->values, b32->count);
+        break;
+    }
+
+    case INTSET_TYPE_FULL: {
+        const intsetFull *full = ptr;
+        b16->common = intsetCountCommon16(full->values16, full->count16,
+                                          b16->values, b16->count);
+        b32->common = intsetCountCommon32(full->values32, full->count32,
+                                          b32->values, b32->count);
+        b64->common = intsetCountCommon64(full->values64, full->count64,
+                                          b64->values, b64->count);
+        break;
+    }
+    }
+}
+
+/* Add many values at once */
+size_t intsetAddMany(intset **is, const int64_t *values, size_t count) {
+    if (!is || !values || count == 0) {
+        return 0;
+    }
+
+    if (!*is) {
+        *is = intsetNew();
+    }
+
+    /* Sort + dedupe a private copy; the second half is radix scratch, then
+     * holds the 32-bit and 64-bit classes. */
+    int64_t *sorted = zmalloc(2 * count * sizeof(*sorted));
+    int64_t *scratch = sorted + count;
+    memcpy(sorted, values, count * sizeof(*sorted));
+    intsetSortBatch(sorted, scratch, count);
+
+    size_t n = 1;
+    for (size_t i = 1; i < count; i++) {
+        if (sorted[i] != sorted[n - 1]) {
+            sorted[n++] = sorted[i];
+        }
+    }
+
+    /* Sorted order puts each width class in contiguous runs:
+     * [64-][32-][16][32+][64+]. The int16 run is used in place; the 32-bit
+     * and 64-bit runs are gathered (still sorted) into scratch. */
+    size_t lo32 = 0;
+    while (lo32 < n && !intsetValueFitsInt32(sorted[lo32])) {
+        lo32++;
+    }
+
+    size_t lo16 = lo32;
+    while (lo16 < n && !intsetValueFitsInt16(sorted[lo16])) {
+        lo16++;
+    }
+
+    size_t hi16 = lo16;
+    while (hi16 < n && intsetValueFitsInt16(sorted[hi16])) {
+        hi16++;
+    }
+
+    size_t hi32 = hi16;
+    while (hi32 < n && intsetValueFitsInt32(sorted[hi32])) {
+        hi32++;
+    }
+
+    intsetBatch b16 = {.values = sorted + lo16, .count = hi16 - lo16};
+
+    int64_t *values32 = scratch;
+    uint64_t n32 = 0;
+    memcpy(values32, sorted + lo32, (lo16 - lo32) * sizeof(*values32));
+    n32 += lo16 - lo32;
+    memcpy(values32 + n32, sorted + hi16, (hi32 - hi16) * sizeof(*values32));
+    n32 += hi32 - hi16;
+    intsetBatch b32 = {.values = values32, .count = n32};
+
+    int64_t *values64 = values32 + n32;
+    uint64_t n64 = 0;
+    memcpy(values64, sorted, lo32 * sizeof(*values64));
+    n64 += lo32;
+    memcpy(values64 + n64, sorted + hi32, (n - hi32) * sizeof(*values64));
+    n64 += n - hi32;
+    intsetBatch b64 = {.values = values64, .count = n64};
+
+    /* Pick the final tier once: the widest class present, or the next tier
+     * up if the merged result would exceed the current tier's limits. */
+    const intsetType type = INTSET_TYPE(*is);
+    intsetType target = n64 ? INTSET_TYPE_FULL
+                            : (n32 ? INTSET_TYPE_MEDIUM : INTSET_TYPE_SMALL);
+    if (target < type) {
+        target = type;
+    }
+
+    uint64_t final16 = 0;
+    uint64_t final32 = 0;
+    intsetClassCounts(*is, &final16, &final32);
+    intsetCountCommonBatch(*is, &b16, &b32, &b64);
+    final16 += b16.count - b16.common;
+    final32 += b32.count - b32.common;
+    if (target == INTSET_TYPE_SMALL &&
+        (final16 > INTSET_SMALL_MAX_COUNT ||
+         sizeof(intsetSmall) + final16 * sizeof(int16_t) >
+             INTSET_SMALL_MAX_BYTES)) {
+        target = INTSET_TYPE_MEDIUM;
+    }
+
+    if (target == INTSET_TYPE_MEDIUM &&
+        (final16 + final32 > INTSET_MEDIUM_MAX_COUNT ||
+         sizeof(intsetMedium) + final16 * sizeof(int16_t) +
+                 final32 * sizeof(int32_t) >
+             INTSET_MEDIUM_MAX_BYTES)) {
+        target = INTSET_TYPE_FULL;
+    }
+
+    if (INTSET_TYPE(*is) == INTSET_TYPE_SMALL && target != INTSET_TYPE_SMALL) {
+        *is = intsetUpgradeSmallToMedium((intsetSmall *)INTSET_UNTAG(*is));
+    }
+
+    if (INTSET_TYPE(*is) == INTSET_TYPE_MEDIUM && target == INTSET_TYPE_FULL) {
+        *is = intsetUpgradeMediumToFull((intsetMedium *)INTSET_UNTAG(*is));
+    }
+
+    /* Upgrades keep every array as-is, so the counted overlap still holds */
+    uint64_t added = 0;
+    void *ptr = INTSET_UNTAG(*is);
+    switch (target) {
+    case INTSET_TYPE_SMALL:
+        *is = INTSET_TAG(intsetSmallAddSorted(ptr, &b16, &added),
+                         INTSET_TYPE_SMALL);
+        break;
+    case INTSET_TYPE_MEDIUM:
+        *is = INTSET_TAG(intsetMediumAddSorted(ptr, &b16, &b32, &added),
+                         INTSET_TYPE_MEDIUM);
+        break;
+    case INTSET_TYPE_FULL:
+        *is = INTSET_TAG(intsetFullAddSorted(ptr, &b16, &b32, &b64, &added),
+                         INTSET_TYPE_FULL);
+        break;
+    }
+
+    zfree(sorted);
+    return added;
+}
+
 /* Remove value from intset */
 void intsetRemove(intset **is, int64_t value, bool *success) {
     if (!is || !*is) {
@@ -35,6 +35,13 @@ void intsetFree(intset *is);
  * success: set to true if added, false if already exists */
 void intsetAdd(intset **is, int64_t value, bool *success);
 
+/* Add 'count' values (any order, duplicates allowed) in one pass
+ * is: pointer to intset pointer (may be modified due to reallocation/upgrade)
+ * The batch is sorted and deduplicated, the final tier is chosen once, and
+ * each underlying array is merged with a single backward pass.
+ * Returns the number of values that were newly added. */
+size_t intsetAddMany(intset **is, const int64_t *values, size_t count);
+
 /* Remove value from intset
  * is: pointer to intset pointer (may be modified due to reallocation)
  * value: value to remove
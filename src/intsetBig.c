@@ -4,9 +4,29 @@
 #include "intsetU32.h"
 #include "str.h"
 
+#if __AVX2__
+#include <immintrin.h>
+#elif __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+/* Lookup directory: every bucket's order key (its high bits) next to its
+ * intsetU32 (its low 20 bits), in bucket order. Lookups search the keys
+ * several at a time instead of walking multimap entries. It is built by an
+ * explicit intsetBigIndex() call; a bucket moving in memory is patched in
+ * place, while adding or removing a bucket drops the directory until the
+ * next intsetBigIndex(). */
+typedef struct intsetBigDirectory {
+    uint64_t *keys;
+    intsetU32 **sets;
+    size_t count;
+    bool valid;
+} intsetBigDirectory;
+
 struct intsetBigSet {
     multimap *i;
     size_t count;
+    intsetBigDirectory dir;
 };
 
 /* If we limit our buckets to 2^20 (1 million) elements each,
@@ -159,7 +179,7 @@ valueFromBucketOffset(const databoxBig *restrict const bucket,
 
 intsetBig *intsetBigNew(void) {
     /* Create map of bucketIndex -> intsetU32 */
-    intsetBig *isb = zmalloc(sizeof(*isb));
+    intsetBig *isb = zcalloc(1, sizeof(*isb));
     /* Use multimapNew (not multimapSetNew) because we need key-only comparison
      * for insert/replace operations. multimapSetNew compares all elements
      * (key+value), so when the intsetU32 pointer changes after resize, the
@@ -184,20 +204,22 @@ void intsetBigFree(intsetBig *isb) {
             multimapFree(isb->i);
         }
 
+        zfree(isb->dir.keys);
+        zfree(isb->dir.sets);
         zfree(isb);
     }
 }
 
 intsetBig *intsetBigCopy(const intsetBig *const isb) {
-    /* Copy 'isb' for the bucket->intsetU32 mappings,
-     * then copy each intsetU32 from the source into
-     * the matching bucket in the result. */
-    intsetBig *result = zmalloc(sizeof(*result));
+    /* Stream 'isb's buckets in order into a new bucket map, copying each
+     * intsetU32. (Inserting into a multimapCopy() while iterating it breaks
+     * once the map has split into multiple maps.) */
+    intsetBig *result = zcalloc(1, sizeof(*result));
     result->count = isb->count;
-    result->i = multimapCopy(isb->i);
+    result->i = multimapNew(2);
 
     multimapIterator iter;
-    multimapIteratorInit(result->i, &iter, true);
+    multimapIteratorInit(isb->i, &iter, true);
 
     databoxBig bucket;
     databox vptr;
@@ -243,9 +265,9 @@ size_t intsetBigBytes(const intsetBig *isb) {
     return totalBytes;
 }
 
-DK_INLINE_ALWAYS bool setFromInput(const intsetBig *isb, const databoxBig *val,
-                                   uint32_t *offsetIn, bool *isNegative,
-                                   databoxBig *lookup, databox *found) {
+/* Convert 'val' into its bucket key box ('lookup') and in-bucket offset */
+DK_INLINE_ALWAYS bool bucketFromInput(const databoxBig *val, uint32_t *offsetIn,
+                                      bool *isNegative, databoxBig *lookup) {
 #if USE_128_BIT_BUCKETS
     __uint128_t bucket;
 #else
@@ -311,6 +333,16 @@ DK_INLINE_ALWAYS bool setFromInput(const intsetBig *isb, const databoxBig *val,
         }
     }
 
+    return true;
+}
+
+DK_INLINE_ALWAYS bool setFromInput(const intsetBig *isb, const databoxBig *val,
+                                   uint32_t *offsetIn, bool *isNegative,
+                                   databoxBig *lookup, databox *found) {
+    if (!bucketFromInput(val, offsetIn, isNegative, lookup)) {
+        return false;
+    }
+
     databox *ptr[] = {found};
     if (multimapLookup(isb->i, (databox *)lookup, ptr)) {
         return true;
@@ -319,6 +351,114 @@ DK_INLINE_ALWAYS bool setFromInput(const intsetBig *isb, const databoxBig *val,
     return false;
 }
 
+/* Bucket keys are SIGNED_64 (negative zone) or UNSIGNED_64 below 2^44, so
+ * flipping the sign bit of the int64 value gives an unsigned key that sorts
+ * in the same order as the multimap. */
+DK_INLINE_ALWAYS uint64_t bucketOrderKey(const databoxBig *bucket) {
+    return (uint64_t)bucket->data.i ^ (1ULL << 63);
+}
+
+DK_INLINE_ALWAYS void intsetBigDirectoryInvalidate(intsetBig *isb) {
+    isb->dir.valid = false;
+}
+
+void intsetBigIndex(intsetBig *isb) {
+    const size_t count = multimapCount(isb->i);
+    isb->dir.keys = zrealloc(isb->dir.keys, count * sizeof(*isb->dir.keys));
+    isb->dir.sets = zrealloc(isb->dir.sets, count * sizeof(*isb->dir.sets));
+
+    multimapIterator iter;
+    multimapIteratorInit(isb->i, &iter, true);
+
+    databoxBig bucket;
+    databox vptr;
+    databox *elements[] = {(databox *)&bucket, &vptr};
+    size_t n = 0;
+    while (multimapIteratorNext(&iter, elements)) {
+        isb->dir.keys[n] = bucketOrderKey(&bucket);
+        isb->dir.sets[n] = boxPtrToU32(vptr);
+        n++;
+    }
+
+    isb->dir.count = n;
+    isb->dir.valid = true;
+}
+
+/* Find the position of bucket order key 'key' in the directory (or -1):
+ * branchless halving down to a window of 8 keys, then 8 keys compared at
+ * once. */
+#define INTSET_BIG_DIRECTORY_WINDOW 8
+static ssize_t intsetBigDirectoryPosition(const intsetBigDirectory *dir,
+                                          const uint64_t key) {
+    const uint64_t *keys = dir->keys;
+    const size_t count = dir->count;
+    if (count < INTSET_BIG_DIRECTORY_WINDOW) {
+        for (size_t i = 0; i < count; i++) {
+            if (keys[i] == key) {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    const uint64_t *base = keys;
+    size_t n = count;
+    while (n > INTSET_BIG_DIRECTORY_WINDOW) {
+        const size_t half = n >> 1;
+        base = (base[half] <= key) ? base + half : base;
+        n -= half;
+    }
+
+    const uint64_t *end = keys + count - INTSET_BIG_DIRECTORY_WINDOW;
+    const uint64_t *w = base < end ? base : end;
+
+#if __AVX2__
+    const __m256i k = _mm256_set1_epi64x((int64_t)key);
+    const __m256i eq0 =
+        _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)w), k);
+    const __m256i eq1 =
+        _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(w + 4)), k);
+    const uint32_t mask =
+        (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(eq0)) |
+        ((uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(eq1)) << 4);
+    if (mask) {
+        return (w - keys) + __builtin_ctz(mask);
+    }
+#elif __ARM_NEON
+    const uint64x2_t k = vdupq_n_u64(key);
+    for (size_t i = 0; i < INTSET_BIG_DIRECTORY_WINDOW; i += 2) {
+        const uint64x2_t eq = vceqq_u64(vld1q_u64(w + i), k);
+        if (vgetq_lane_u64(eq, 0)) {
+            return (w - keys) + i;
+        }
+
+        if (vgetq_lane_u64(eq, 1)) {
+            return (w - keys) + i + 1;
+        }
+    }
+#else
+    for (size_t i = 0; i < INTSET_BIG_DIRECTORY_WINDOW; i++) {
+        if (w[i] == key) {
+            return (w - keys) + i;
+        }
+    }
+#endif
+
+    return -1;
+}
+
+/* Keep the directory current after bucket 'lookup' moved to 'set'. */
+static void intsetBigDirectoryMoved(intsetBig *isb, const databoxBig *lookup,
+                                    intsetU32 *set) {
+    if (isb->dir.valid) {
+        const ssize_t pos =
+            intsetBigDirectoryPosition(&isb->dir, bucketOrderKey(lookup));
+        assert(pos >= 0);
+        isb->dir.sets[pos] = set;
+    }
+}
+
 /* TODO: write multi-add function so if we are, for example, adding a million
  * elements (sorted!) we can just add/merge in chunks so we don't need to run
  * the multimapLookup() inside setFromInput() a million times for adding. */
@@ -350,6 +490,12 @@ bool intsetBigAdd(intsetBig *isb, const databoxBig *val) {
 
     /* Add intsetU32 back to isb for bucket */
     if (orig != boxPtrToU32(found)) {
+        if (orig) {
+            intsetBigDirectoryMoved(isb, &lookup, boxPtrToU32(found));
+        } else {
+            intsetBigDirectoryInvalidate(isb);
+        }
+
         /* Need to update multimap bucket again since the set pointer changed */
         const databox *insert[] = {(databox *)&lookup, &found};
         multimapInsert(&isb->i, insert);
@@ -388,9 +534,11 @@ bool intsetBigRemove(intsetBig *isb, const databoxBig *val) {
                 /* no more elements, free this and delete from map */
                 intsetU32Free(boxPtrToU32(found));
                 multimapDelete(&isb->i, (databox *)&lookup);
+                intsetBigDirectoryInvalidate(isb);
             } else {
                 /* removal caused intsetU32 to move, so we need to update map */
                 if (orig != boxPtrToU32(found)) {
+                    intsetBigDirectoryMoved(isb, &lookup, boxPtrToU32(found));
                     const databox *insert[] = {(databox *)&lookup, &found};
                     multimapInsert(&isb->i, insert);
                 }
@@ -408,6 +556,17 @@ bool intsetBigExists(const intsetBig *isb, const databoxBig *val) {
     bool exists = false;
     bool isNegative;
 
+    /* Use the directory when intsetBigIndex() has built one */
+    if (isb->dir.valid) {
+        if (bucketFromInput(val, &offset, &isNegative, &lookup)) {
+            const ssize_t pos =
+                intsetBigDirectoryPosition(&isb->dir, bucketOrderKey(&lookup));
+            exists = pos >= 0 && intsetU32Exists(isb->dir.sets[pos], offset);
+        }
+
+        return exists;
+    }
+
     /* Create lookup/storage criteria and attempt to fetch a set */
     if (setFromInput(isb, val, &offset, &isNegative, &lookup, &found)) {
         exists = intsetU32Exists(boxPtrToU32(found), offset);
@@ -577,6 +736,7 @@ bool intsetBigAddByBucketDirectOverwriteBulk(intsetBig *isb, databoxBig *bucket,
                                              intsetU32 *iu32) {
     /* NOTE: These MODIFY isb->i and requires INVALIDATING any iterator you
      *       currently have open! */
+    intsetBigDirectoryInvalidate(isb);
     if (intsetU32Count(iu32) > 0) {
         databox vptr = {.type = DATABOX_PTR, .data.ptr = iu32};
         const databox *insert[2] = {(databox *)bucket, &vptr};
@@ -604,8 +764,254 @@ bool intsetBigAddByBucketDirectOverwriteBulkUpdateIterator(
     return didIt;
 }
 
+/* Swap in a freshly built bucket map, releasing 'isb's previous buckets
+ * (except those whose intsetU32 was moved into 'replacement'). */
+static void intsetBigReplaceMap(intsetBig *isb, multimap *replacement,
+                                size_t count, bool freeOldSets) {
+    if (freeOldSets) {
+        multimapIterator iter;
+        multimapIteratorInit(isb->i, &iter, true);
+
+        databoxBig bucket;
+        databox vptr;
+        databox *elements[] = {(databox *)&bucket, &vptr};
+        while (multimapIteratorNext(&iter, elements)) {
+            intsetU32Free(boxPtrToU32(vptr));
+        }
+    }
+
+    multimapFree(isb->i);
+    isb->i = replacement;
+    isb->count = count;
+    intsetBigDirectoryInvalidate(isb);
+}
+
+/* Replaces 'result' with a ∩ b ('result' may be 'a' or 'b').
+ *
+ * Buckets are streamed in key order from both inputs: matching buckets are
+ * intersected with intersectIntAuto() into a reusable scratch array and the
+ * non-empty results are appended to a new bucket map, so the result is
+ * built without a per-bucket lookup or iterator re-seek. */
 size_t intsetBigIntersect(const intsetBig *a, const intsetBig *b,
                           intsetBig *result) {
+    multimapIterator ia;
+    multimapIterator ib;
+    databoxBig key[2];
+    databox val[2];
+    databox *ea[2] = {(databox *)&key[0], &val[0]};
+    databox *eb[2] = {(databox *)&key[1], &val[1]};
+
+    multimap *out = multimapNew(2);
+    size_t intersectCount = 0;
+    uint32_t *scratch = NULL;
+    size_t scratchLen = 0;
+
+    multimapIteratorInit(a->i, &ia, true);
+    multimapIteratorInit(b->i, &ib, true);
+    bool foundA = multimapIteratorNext(&ia, ea);
+    bool foundB = multimapIteratorNext(&ib, eb);
+
+    /* element-by-element zipper algoirthm for intersecting two sorted lists. */
+    while (foundA && foundB) {
+        const int compared = databoxCompare(ea[0], eb[0]);
+        if (compared < 0) {
+            foundA = multimapIteratorNext(&ia, ea);
+        } else if (compared > 0) {
+            foundB = multimapIteratorNext(&ib, eb);
+        } else {
+            intsetU32 *eaai = val[0].data.ptr;
+            intsetU32 *ebbi = val[1].data.ptr;
+            const size_t eaaiCount = intsetU32Count(eaai);
+            const size_t ebbiCount = intsetU32Count(ebbi);
+            const size_t smallest =
+                eaaiCount < ebbiCount ? eaaiCount : ebbiCount;
+
+            if (smallest > scratchLen) {
+                scratchLen = smallest;
+                scratch = zrealloc(scratch, scratchLen * sizeof(*scratch));
+            }
+
+            const size_t intersectedCount =
+                intersectIntAuto(intsetU32Array(eaai), eaaiCount,
+                                 intsetU32Array(ebbi), ebbiCount, scratch);
+
+            if (intersectedCount) {
+                intsetU32 *bucketSet = intsetU32NewLen(intersectedCount);
+                memcpy(intsetU32Array(bucketSet), scratch,
+                       intersectedCount * sizeof(*scratch));
+                intsetU32UpdateCount(bucketSet, intersectedCount);
+
+                databox vptr = {.type = DATABOX_PTR, .data.ptr = bucketSet};
+                const databox *append[2] = {(databox *)&key[0], &vptr};
+                multimapInsert(&out, append);
+                intersectCount += intersectedCount;
+            }
+
+            foundA = multimapIteratorNext(&ia, ea);
+            foundB = multimapIteratorNext(&ib, eb);
+        }
+    }
+
+    zfree(scratch);
+
+    /* Inputs are no longer read, so replacing 'result' is safe even when it
+     * aliases an input. */
+    intsetBigReplaceMap(result, out, intersectCount, true);
+    return intersectCount;
+}
+
+/* Merge 'b' into 'a'
+ *
+ * Buckets are streamed in key order into a new bucket map: buckets only in
+ * 'a' are moved, buckets only in 'b' are copied, and shared buckets are
+ * merged with intsetU32Merge() (one linear pass per bucket). */
+void intsetBigMergeInto(intsetBig *a, const intsetBig *b) {
+    if (a == b) {
+        return;
+    }
+
+    multimapIterator ia;
+    multimapIterator ib;
+    databoxBig key[2];
+    databox val[2];
+    databox *ea[2] = {(databox *)&key[0], &val[0]};
+    databox *eb[2] = {(databox *)&key[1], &val[1]};
+
+    multimap *out = multimapNew(2);
+    size_t count = a->count;
+
+    multimapIteratorInit(a->i, &ia, true);
+    multimapIteratorInit(b->i, &ib, true);
+    bool foundA = multimapIteratorNext(&ia, ea);
+    bool foundB = multimapIteratorNext(&ib, eb);
+
+    while (foundA || foundB) {
+        const int compared =
+            !foundB ? -1 : (!foundA ? 1 : databoxCompare(ea[0], eb[0]));
+        databox vptr = {.type = DATABOX_PTR};
+        const databox *append[2] = {(databox *)&key[compared > 0], &vptr};
+
+        if (compared < 0) {
+            /* Only in A: move A's set into the result as-is */
+            vptr.data.ptr = val[0].data.ptr;
+        } else if (compared > 0) {
+            /* Only in B: result gets its own copy of B's set */
+            const intsetU32 *ebbi = val[1].data.ptr;
+            vptr.data.ptr = intsetU32Copy(ebbi);
+            count += intsetU32Count(ebbi);
+        } else {
+            /* Match! _Merge_ B's bucket into A's bucket */
+            intsetU32 *eaai = val[0].data.ptr;
+            count += intsetU32Merge(&eaai, val[1].data.ptr);
+            vptr.data.ptr = eaai;
+        }
+
+        /* Append before advancing: the iterators overwrite 'key' */
+        multimapInsert(&out, append);
+
+        if (compared <= 0) {
+            foundA = multimapIteratorNext(&ia, ea);
+        }
+
+        if (compared >= 0) {
+            foundB = multimapIteratorNext(&ib, eb);
+        }
+    }
+
+    /* Every set of 'a' now lives in 'out', so only the old map is freed. */
+    intsetBigReplaceMap(a, out, count, false);
+}
+
+bool intsetBigRandom(const intsetBig *isb, databoxBig *val) {
+    /* Failure method: */
+    /* Step 1: get random bucket
+     * Step 2: get random element inside bucket */
+    /* Using the above will improperly weight smaller buckets with higher
+     * returns because we would have equal picks between buckets without
+     * considering how many elements they contain. */
+
+    /* Successful method: */
+    /* Step 1: pick random position index from count of all elements
+     * Step 2: return value for random position. */
+    /* TODO: if this random() is too slow, we could augment with
+     *       xorshift128plus() */
+    const uint64_t bigRandom = ((uint64_t)random() << 32) | random();
+    const uint64_t selectedIndex = bigRandom % isb->count;
+
+    /* Set up initial conditions */
+    intsetBigIterator isbIter;
+    databoxBig bucket;
+    databox pval;
+    uint64_t currentCount = 0;
+
+    intsetBigIteratorInit(isb, &isbIter);
+    while (intsetBigIteratorNextBucket(&isbIter, &bucket, &pval)) {
+        const intsetU32 *use = boxPtrToU32(pval);
+        const size_t localCount = intsetU32Count(use);
+        currentCount += localCount;
+
+        if (currentCount >= selectedIndex) {
+            /* random element is INSIDE THE HOUSE */
+            const ssize_t useOffset = currentCount - selectedIndex - 1;
+            assert(useOffset >= 0);
+
+            uint32_t localIVAL;
+            const bool got = intsetU32Get(use, useOffset, &localIVAL);
+            (void)got;
+            assert(got);
+
+            valueFromBucketOffset(&bucket, localIVAL, val);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool intsetBigRandomDelete(intsetBig *isb, databoxBig *deleted) {
+    /* We are basically doing a double fetch of the bucket and intsetU32 here
+     * (once for Random() and once for Remove()), but it's okay for now (not
+     * perf tested though). */
+
+    intsetBigRandom(isb, deleted);
+    /* TODO: we could improve the performance here by making 'delete' a special
+     * case of intsetBigRandom() itself since intsetBigRandom() already has the
+     * bucket and intsetU32 values directly when it creates the return value
+     * 'deleted' here. */
+    return intsetBigRemove(isb, deleted);
+}
+
+#ifdef DATAKIT_TEST
+#include "ctest.h"
+#include "perf.h"
+#include "timeUtil.h"
+#include <inttypes.h>
+#define TIME_INIT PERF_TIMERS_SETUP
+#define TIME_FINISH(i, what) PERF_TIMERS_FINISH_PRINT_RESULTS(i, what)
+
+void intsetBigRepr(const intsetBig *isb) {
+    if (isb) {
+        if (isb->i) {
+            multimapIterator iter;
+            multimapIteratorInit(isb->i, &iter, true);
+
+            databoxBig bucket;
+            databox vptr;
+            DATABOX_BIG_INIT(&bucket);
+            databox *elements[] = {(databox *)&bucket, &vptr};
+            while (multimapIteratorNext(&iter, elements)) {
+                databoxReprSay("Bucket", (databox *)&bucket);
+                intsetU32Repr(boxPtrToU32(vptr));
+            }
+        }
+    }
+}
+
+/* Previous intersect/merge paths (per-bucket multimapInsert plus iterator
+ * re-seek), kept as the baseline for the streaming benchmark below. */
+static size_t intsetBigIntersectPerBucketInsert(const intsetBig *a,
+                                                const intsetBig *b,
+                                                intsetBig *result) {
     size_t intersectCount = 0;
 
     /* First, get common buckets between 'a' and 'b' */
@@ -689,8 +1095,8 @@ size_t intsetBigIntersect(const intsetBig *a, const intsetBig *b,
     return intersectCount;
 }
 
-/* Merge 'b' into 'a' */
-void intsetBigMergeInto(intsetBig *a, const intsetBig *b) {
+static void intsetBigMergeIntoPerBucketInsert(intsetBig *a,
+                                              const intsetBig *b) {
     multimapIterator ia;
     multimapIterator ib;
     databoxBig key[2];
@@ -754,87 +1160,135 @@ void intsetBigMergeInto(intsetBig *a, const intsetBig *b) {
     }
 }
 
-bool intsetBigRandom(const intsetBig *isb, databoxBig *val) {
-    /* Failure method: */
-    /* Step 1: get random bucket
-     * Step 2: get random element inside bucket */
-    /* Using the above will improperly weight smaller buckets with higher
-     * returns because we would have equal picks between buckets without
-     * considering how many elements they contain. */
-
-    /* Successful method: */
-    /* Step 1: pick random position index from count of all elements
-     * Step 2: return value for random position. */
-    /* TODO: if this random() is too slow, we could augment with
-     *       xorshift128plus() */
-    const uint64_t bigRandom = ((uint64_t)random() << 32) | random();
-    const uint64_t selectedIndex = bigRandom % isb->count;
-
-    /* Set up initial conditions */
-    intsetBigIterator isbIter;
-    databoxBig bucket;
-    databox pval;
-    uint64_t currentCount = 0;
-
-    intsetBigIteratorInit(isb, &isbIter);
-    while (intsetBigIteratorNextBucket(&isbIter, &bucket, &pval)) {
-        const intsetU32 *use = boxPtrToU32(pval);
-        const size_t localCount = intsetU32Count(use);
-        currentCount += localCount;
-
-        if (currentCount >= selectedIndex) {
-            /* random element is INSIDE THE HOUSE */
-            const ssize_t useOffset = currentCount - selectedIndex - 1;
-            assert(useOffset >= 0);
-
-            uint32_t localIVAL;
-            const bool got = intsetU32Get(use, useOffset, &localIVAL);
-            (void)got;
-            assert(got);
+/* Previous membership path: multimap bucket lookup + scalar binary search */
+static bool intsetBigExistsScalar(const intsetBig *isb, const databoxBig *val) {
+    databoxBig lookup;
+    databox found;
+    uint32_t offset;
+    bool isNegative;
 
-            valueFromBucketOffset(&bucket, localIVAL, val);
-            return true;
+    if (setFromInput(isb, val, &offset, &isNegative, &lookup, &found)) {
+        const intsetU32 *set = boxPtrToU32(found);
+        const uint32_t *arr = set->contents;
+        int64_t lo = 0;
+        int64_t hi = (int64_t)set->count - 1;
+        while (lo <= hi) {
+            const int64_t mid = (lo + hi) >> 1;
+            if (arr[mid] < offset) {
+                lo = mid + 1;
+            } else if (arr[mid] > offset) {
+                hi = mid - 1;
+            } else {
+                return true;
+            }
         }
     }
 
     return false;
 }
 
-bool intsetBigRandomDelete(intsetBig *isb, databoxBig *deleted) {
-    /* We are basically doing a double fetch of the bucket and intsetU32 here
-     * (once for Random() and once for Remove()), but it's okay for now (not
-     * perf tested though). */
-
-    intsetBigRandom(isb, deleted);
-    /* TODO: we could improve the performance here by making 'delete' a special
-     * case of intsetBigRandom() itself since intsetBigRandom() already has the
-     * bucket and intsetU32 values directly when it creates the return value
-     * 'deleted' here. */
-    return intsetBigRemove(isb, deleted);
+/* Build a set of ~'count' random values spread over 'buckets' buckets
+ * directly from per-bucket batches (intsetBigAdd at 10M is too slow to use
+ * for benchmark setup). */
+static intsetBig *intsetBigBenchBuild(size_t count, size_t buckets,
+                                      uint32_t seed) {
+    intsetBig *isb = intsetBigNew();
+    const size_t perBucket = count / buckets;
+    uint32_t *batch = zmalloc(perBucket * sizeof(*batch));
+    uint64_t state = seed | 1;
+    for (size_t bk = 0; bk < buckets; bk++) {
+        for (size_t i = 0; i < perBucket; i++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            batch[i] = state & ((1u << DIVISOR_WIDTH) - 1);
+        }
+
+        intsetU32 *set = intsetU32New();
+        isb->count += intsetU32AddMany(&set, batch, perBucket);
+        databoxBig key = DATABOX_BIG_UNSIGNED(bk);
+        intsetBigAddByBucketDirectOverwriteBulk(isb, &key, set);
+    }
+
+    zfree(batch);
+    return isb;
 }
 
-#ifdef DATAKIT_TEST
-#include "ctest.h"
-#include "perf.h"
-#define TIME_INIT PERF_TIMERS_SETUP
-#define TIME_FINISH(i, what) PERF_TIMERS_FINISH_PRINT_RESULTS(i, what)
+static void intsetBigBenchmark(size_t count) {
+    const size_t buckets = count / 16384;
+    intsetBig *a = intsetBigBenchBuild(count, buckets, 0x1234);
+    intsetBig *b = intsetBigBenchBuild(count, buckets, 0x9876);
+    printf("  %zu elements (%zu buckets):\n", intsetBigCountElements(a),
+           buckets);
 
-void intsetBigRepr(const intsetBig *isb) {
-    if (isb) {
-        if (isb->i) {
-            multimapIterator iter;
-            multimapIteratorInit(isb->i, &iter, true);
-
-            databoxBig bucket;
-            databox vptr;
-            DATABOX_BIG_INIT(&bucket);
-            databox *elements[] = {(databox *)&bucket, &vptr};
-            while (multimapIteratorNext(&iter, elements)) {
-                databoxReprSay("Bucket", (databox *)&bucket);
-                intsetU32Repr(boxPtrToU32(vptr));
-            }
-        }
-    }
+    const size_t probes = 1000000;
+    uint64_t *probe = zmalloc(probes * sizeof(*probe));
+    intsetBigIterator iter;
+    databoxBig val;
+    intsetBigIteratorInit(a, &iter);
+    for (size_t i = 0; i < probes; i++) {
+        /* Half hits (members of 'a'), half random */
+        if ((i & 1) && intsetBigIteratorNextBox(&iter, &val)) {
+            probe[i] = val.data.u;
+        } else {
+            probe[i] = ((uint64_t)random() << 20 | random()) %
+                       (buckets << DIVISOR_WIDTH);
+        }
+    }
+
+    size_t hitsScalar = 0;
+    size_t hits = 0;
+    uint64_t start = timeUtilMonotonicNs();
+    for (size_t i = 0; i < probes; i++) {
+        hitsScalar +=
+            intsetBigExistsScalar(a, &DATABOX_BIG_UNSIGNED(probe[i]));
+    }
+    const uint64_t scalarNs = timeUtilMonotonicNs() - start;
+
+    intsetBigIndex(a);
+    start = timeUtilMonotonicNs();
+    for (size_t i = 0; i < probes; i++) {
+        hits += intsetBigExists(a, &DATABOX_BIG_UNSIGNED(probe[i]));
+    }
+    const uint64_t simdNs = timeUtilMonotonicNs() - start;
+    assert(hits == hitsScalar);
+    printf("    exists:    scalar %6.1f ns/op, directory+SIMD %6.1f ns/op\n",
+           (double)scalarNs / probes, (double)simdNs / probes);
+
+    intsetBig *r0 = intsetBigNew();
+    start = timeUtilMonotonicNs();
+    const size_t c0 = intsetBigIntersectPerBucketInsert(a, b, r0);
+    const uint64_t interOldNs = timeUtilMonotonicNs() - start;
+
+    intsetBig *r1 = intsetBigNew();
+    start = timeUtilMonotonicNs();
+    const size_t c1 = intsetBigIntersect(a, b, r1);
+    const uint64_t interNewNs = timeUtilMonotonicNs() - start;
+    assert(c0 == c1 && intsetBigEqual(r0, r1));
+    printf("    intersect: per-bucket %7.2f ms, streaming %7.2f ms\n",
+           interOldNs / 1e6, interNewNs / 1e6);
+
+    intsetBig *m0 = intsetBigCopy(a);
+    start = timeUtilMonotonicNs();
+    intsetBigMergeIntoPerBucketInsert(m0, b);
+    const uint64_t mergeOldNs = timeUtilMonotonicNs() - start;
+
+    intsetBig *m1 = intsetBigCopy(a);
+    start = timeUtilMonotonicNs();
+    intsetBigMergeInto(m1, b);
+    const uint64_t mergeNewNs = timeUtilMonotonicNs() - start;
+    assert(intsetBigEqual(m0, m1) &&
+           intsetBigCountElements(m0) == intsetBigCountElements(m1));
+    printf("    union:     per-bucket %7.2f ms, streaming %7.2f ms\n",
+           mergeOldNs / 1e6, mergeNewNs / 1e6);
+
+    zfree(probe);
+    intsetBigFree(r0);
+    intsetBigFree(r1);
+    intsetBigFree(m0);
+    intsetBigFree(m1);
+    intsetBigFree(a);
+    intsetBigFree(b);
 }
 
 __attribute__((optnone)) int intsetBigTest(int argc, char *argv[]) {
@@ -2744,6 +3198,62 @@ __attribute__((optnone)) int intsetBigTest(int argc, char *argv[]) {
         intsetBigFree(b);
     }
 
+    TEST("directory lookups track bucket changes") {
+        intsetBig *isb = intsetBigNew();
+        for (int64_t i = -40; i < 40; i++) {
+            intsetBigAdd(isb,
+                         &DATABOX_BIG_SIGNED(i * (int64_t)BUCKET_SIZE + 7));
+        }
+
+        /* Build the directory, then mutate and re-check */
+        intsetBigIndex(isb);
+        for (int round = 0; round < 3; round++) {
+            for (int64_t i = -40; i < 40; i++) {
+                const int64_t v = i * (int64_t)BUCKET_SIZE + 7;
+                const bool expect = !(round == 2 && i == 3);
+                if (intsetBigExists(isb, &DATABOX_BIG_SIGNED(v)) != expect) {
+                    ERR("Round %d: wrong membership for %" PRId64, round, v);
+                }
+
+                if (intsetBigExists(isb, &DATABOX_BIG_SIGNED(v + 1))) {
+                    ERR("Round %d: phantom %" PRId64, round, v + 1);
+                }
+            }
+
+            if (round == 0) {
+                intsetBigAdd(isb, &DATABOX_BIG_SIGNED(90 * BUCKET_SIZE));
+            } else if (round == 1) {
+                intsetBigRemove(isb, &DATABOX_BIG_SIGNED(3 * BUCKET_SIZE + 7));
+            }
+        }
+
+        if (!intsetBigExists(isb, &DATABOX_BIG_SIGNED(90 * BUCKET_SIZE))) {
+            ERRR("Bucket added after directory build not found!");
+        }
+
+        /* Growing a bucket moves its set; the directory is patched in place
+         * instead of being dropped. */
+        intsetBigIndex(isb);
+        const int64_t base = 5 * (int64_t)BUCKET_SIZE + 100;
+        for (int64_t j = 0; j < 1000; j++) {
+            intsetBigAdd(isb, &DATABOX_BIG_SIGNED(base + j));
+        }
+
+        for (int64_t j = 0; j < 1000; j++) {
+            if (!intsetBigExists(isb, &DATABOX_BIG_SIGNED(base + j))) {
+                ERR("Grown bucket lost %" PRId64, base + j);
+                break;
+            }
+        }
+
+        intsetBigFree(isb);
+    }
+
+    TEST("PERF: SIMD lookup and streaming intersect/union (1M, 10M)") {
+        intsetBigBenchmark(1000000);
+        intsetBigBenchmark(10000000);
+    }
+
 #undef BUCKET_SIZE
 
     TEST_FINAL_RESULT;
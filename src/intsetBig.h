@@ -49,6 +49,11 @@ intsetBig *intsetBigCopy(const intsetBig *isb);
 bool intsetBigAdd(intsetBig *isb, const databoxBig *val);
 bool intsetBigRemove(intsetBig *isb, const databoxBig *val);
 bool intsetBigExists(const intsetBig *isb, const databoxBig *val);
+
+/* Build the bucket lookup directory used by intsetBigExists(). It survives
+ * buckets growing or shrinking, but adding or removing a whole bucket drops
+ * it until the next intsetBigIndex(). */
+void intsetBigIndex(intsetBig *isb);
 bool intsetBigRandom(const intsetBig *isb, databoxBig *val);
 bool intsetBigRandomDelete(intsetBig *isb, databoxBig *deleted);
 
@@ -50,3 +50,83 @@ typedef enum intsetSearchResult {
     INTSET_FOUND = 0,     /* Value found at returned position */
     INTSET_NOT_FOUND = 1, /* Value not found, position is insert point */
 } intsetSearchResult;
+
+/* One width class of an intsetAddMany() batch: sorted, duplicate-free
+ * values which all fit that class's element type, plus how many of them the
+ * set already holds (counted once, before any tier upgrade). */
+typedef struct intsetBatch {
+    const int64_t *values;
+    uint64_t count;
+    uint64_t common;
+} intsetBatch;
+
+/* Batch merge helpers (intsetAddMany). 'batch' is sorted, duplicate-free,
+ * and every value fits the array's element type.
+ *
+ * intsetCountCommonNN: number of batch values already in arr[0..count).
+ *   Small batches binary search with a moving lower bound; large ones do a
+ *   linear merge.
+ * intsetMergeSortedNN: merge batch into arr (which must have room for
+ *   newCount = count + n - common) in one backward pass, so each existing
+ *   element moves at most once. */
+#define INTSET_DEFINE_BATCH_MERGE(bits)                                        \
+    static inline uint64_t intsetCountCommon##bits(                            \
+        const int##bits##_t *arr, uint64_t count, const int64_t *batch,       \
+        uint64_t n) {                                                          \
+        uint64_t common = 0;                                                   \
+        uint64_t i = 0;                                                        \
+        if (n * 16 < count) {                                                  \
+            for (uint64_t j = 0; j < n && i < count; j++) {                    \
+                uint64_t hi = count;                                           \
+                while (i < hi) {                                               \
+                    const uint64_t mid = i + (hi - i) / 2;                     \
+                    if (arr[mid] < batch[j]) {                                 \
+                        i = mid + 1;                                           \
+                    } else {                                                   \
+                        hi = mid;                                              \
+                    }                                                          \
+                }                                                              \
+                                                                               \
+                common += i < count && arr[i] == batch[j];                     \
+            }                                                                  \
+                                                                               \
+            return common;                                                     \
+        }                                                                      \
+                                                                               \
+        for (uint64_t j = 0; j < n && i < count;) {                            \
+            if (arr[i] < batch[j]) {                                           \
+                i++;                                                           \
+            } else if (arr[i] > batch[j]) {                                    \
+                j++;                                                           \
+            } else {                                                           \
+                common++;                                                      \
+                i++;                                                           \
+                j++;                                                           \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return common;                                                         \
+    }                                                                          \
+                                                                               \
+    static inline void intsetMergeSorted##bits(                                \
+        int##bits##_t *arr, uint64_t count, const int64_t *batch, uint64_t n, \
+        uint64_t newCount) {                                                   \
+        uint64_t i = count;                                                    \
+        uint64_t j = n;                                                        \
+        uint64_t k = newCount;                                                 \
+        while (j > 0) {                                                        \
+            if (i > 0 && arr[i - 1] > batch[j - 1]) {                          \
+                arr[--k] = arr[--i];                                           \
+            } else {                                                           \
+                if (i > 0 && arr[i - 1] == batch[j - 1]) {                     \
+                    i--;                                                       \
+                }                                                              \
+                                                                               \
+                arr[--k] = (int##bits##_t)batch[--j];                          \
+            }                                                                  \
+        }                                                                      \
+    }
+
+INTSET_DEFINE_BATCH_MERGE(16)
+INTSET_DEFINE_BATCH_MERGE(32)
+INTSET_DEFINE_BATCH_MERGE(64)
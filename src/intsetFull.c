@@ -383,6 +383,52 @@ intsetFull *intsetFullAdd(intsetFull *f, int64_t value, bool *added) {
     return f;
 }
 
+/* Merge sorted, duplicate-free batches into full intset */
+intsetFull *intsetFullAddSorted(intsetFull *f, const intsetBatch *b16,
+                                const intsetBatch *b32, const intsetBatch *b64,
+                                uint64_t *added) {
+    if (!f) {
+        f = intsetFullNew();
+    }
+
+    const uint64_t oldCount = intsetFullCount(f);
+
+    if (b16->count) {
+        const uint64_t newCount = f->count16 + b16->count - b16->common;
+        if (newCount != f->count16) {
+            f->values16 = zrealloc(f->values16, newCount * sizeof(int16_t));
+            intsetMergeSorted16(f->values16, f->count16, b16->values,
+                                b16->count, newCount);
+            f->count16 = newCount;
+        }
+    }
+
+    if (b32->count) {
+        const uint64_t newCount = f->count32 + b32->count - b32->common;
+        if (newCount != f->count32) {
+            f->values32 = zrealloc(f->values32, newCount * sizeof(int32_t));
+            intsetMergeSorted32(f->values32, f->count32, b32->values,
+                                b32->count, newCount);
+            f->count32 = newCount;
+        }
+    }
+
+    if (b64->count) {
+        const uint64_t newCount = f->count64 + b64->count - b64->common;
+        if (newCount != f->count64) {
+            f->values64 = zrealloc(f->values64, newCount * sizeof(int64_t));
+            intsetMergeSorted64(f->values64, f->count64, b64->values,
+                                b64->count, newCount);
+            f->count64 = newCount;
+        }
+    }
+
+    if (added) {
+        *added = intsetFullCount(f) - oldCount;
+    }
+    return f;
+}
+
 /* Remove value from full intset */
 intsetFull *intsetFullRemove(intsetFull *f, int64_t value, bool *removed) {
     if (!f) {
@@ -47,6 +47,12 @@ bool intsetFullGet(const intsetFull *f, uint64_t pos, int64_t *value);
 /* Add value - returns new intset (may be reallocated) and whether added */
 intsetFull *intsetFullAdd(intsetFull *f, int64_t value, bool *added);
 
+/* Merge sorted, duplicate-free batches, one per width class (see
+ * intsetMediumAddSorted), in one pass per array */
+intsetFull *intsetFullAddSorted(intsetFull *f, const intsetBatch *b16,
+                                const intsetBatch *b32, const intsetBatch *b64,
+                                uint64_t *added);
+
 /* Remove value - returns new intset (may be reallocated) and whether removed */
 intsetFull *intsetFullRemove(intsetFull *f, int64_t value, bool *removed);
 
@@ -301,6 +301,43 @@ intsetMedium *intsetMediumAdd(intsetMedium *m, int64_t value, bool *added) {
     return m;
 }
 
+/* Merge sorted, duplicate-free batches into medium intset */
+intsetMedium *intsetMediumAddSorted(intsetMedium *m, const intsetBatch *b16,
+                                    const intsetBatch *b32, uint64_t *added) {
+    if (!m) {
+        m = intsetMediumNew();
+    }
+
+    const uint64_t oldCount = intsetMediumCount(m);
+
+    if (b16->count) {
+        const uint64_t newCount = m->count16 + b16->count - b16->common;
+        assert(newCount <= INTSET_MEDIUM_MAX_COUNT);
+        if (newCount != m->count16) {
+            m->values16 = zrealloc(m->values16, newCount * sizeof(int16_t));
+            intsetMergeSorted16(m->values16, m->count16, b16->values,
+                                b16->count, newCount);
+            m->count16 = (uint32_t)newCount;
+        }
+    }
+
+    if (b32->count) {
+        const uint64_t newCount = m->count32 + b32->count - b32->common;
+        assert(newCount <= INTSET_MEDIUM_MAX_COUNT);
+        if (newCount != m->count32) {
+            m->values32 = zrealloc(m->values32, newCount * sizeof(int32_t));
+            intsetMergeSorted32(m->values32, m->count32, b32->values,
+                                b32->count, newCount);
+            m->count32 = (uint32_t)newCount;
+        }
+    }
+
+    if (added) {
+        *added = intsetMediumCount(m) - oldCount;
+    }
+    return m;
+}
+
 /* Remove value from medium intset */
 intsetMedium *intsetMediumRemove(intsetMedium *m, int64_t value,
                                  bool *removed) {
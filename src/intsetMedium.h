@@ -44,6 +44,11 @@ bool intsetMediumGet(const intsetMedium *m, uint64_t pos, int64_t *value);
 /* Add value - returns new intset (may be reallocated) and whether added */
 intsetMedium *intsetMediumAdd(intsetMedium *m, int64_t value, bool *added);
 
+/* Merge int16_t and int32_t (not int16_t) batches in one pass per array -
+ * returns new intset and how many were new */
+intsetMedium *intsetMediumAddSorted(intsetMedium *m, const intsetBatch *b16,
+                                    const intsetBatch *b32, uint64_t *added);
+
 /* Remove value - returns new intset (may be reallocated) and whether removed */
 intsetMedium *intsetMediumRemove(intsetMedium *m, int64_t value, bool *removed);
 
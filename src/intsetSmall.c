@@ -140,6 +140,30 @@ intsetSmall *intsetSmallAdd(intsetSmall *is, int64_t value, bool *added) {
     return newIs;
 }
 
+/* Merge sorted, duplicate-free int16-range values into small intset */
+intsetSmall *intsetSmallAddSorted(intsetSmall *is, const intsetBatch *b16,
+                                  uint64_t *added) {
+    if (!is) {
+        is = intsetSmallNew();
+    }
+
+    const uint64_t oldCount = is->count16;
+    const uint64_t newCount = oldCount + b16->count - b16->common;
+    assert(newCount <= INTSET_SMALL_MAX_COUNT);
+
+    if (newCount != oldCount) {
+        is = zrealloc(is, sizeof(intsetSmall) + newCount * sizeof(int16_t));
+        intsetMergeSorted16(is->values16, oldCount, b16->values, b16->count,
+                            newCount);
+        is->count16 = (uint32_t)newCount;
+    }
+
+    if (added) {
+        *added = newCount - oldCount;
+    }
+    return is;
+}
+
 /* Remove value from small intset */
 intsetSmall *intsetSmallRemove(intsetSmall *is, int64_t value, bool *removed) {
     if (!is) {
@@ -45,6 +45,11 @@ bool intsetSmallGet(const intsetSmall *is, uint32_t pos, int64_t *value);
 /* Add value - returns new intset (may be reallocated) and whether added */
 intsetSmall *intsetSmallAdd(intsetSmall *is, int64_t value, bool *added);
 
+/* Merge an int16_t batch in one pass - returns new intset (may be
+ * reallocated) and how many were new */
+intsetSmall *intsetSmallAddSorted(intsetSmall *is, const intsetBatch *b16,
+                                  uint64_t *added);
+
 /* Remove value - returns new intset (may be reallocated) and whether removed */
 intsetSmall *intsetSmallRemove(intsetSmall *is, int64_t value, bool *removed);
 
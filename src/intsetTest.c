@@ -5,6 +5,7 @@
 #include "intsetFull.h"
 #include "intsetMedium.h"
 #include "intsetSmall.h"
+#include "timeUtil.h"
 #include <assert.h>
 #include <inttypes.h>
 #include <stdio.h>
@@ -1241,5 +1242,164 @@ int intsetTest(int argc, char *argv[]) {
         intsetFree(is);
     }
 
+    TEST("AddMany matches sequential intsetAdd across tiers") {
+        /* Each scenario: starting contents, then a batch mixing widths and
+         * duplicates. Covers staying in tier, upgrades by width, and
+         * upgrades by size (small -> medium past 32K int16 values). */
+        const int64_t ranges[] = {1000, 30000, INT32_MAX / 2, INT64_MAX / 4};
+        for (size_t scenario = 0; scenario < 8; scenario++) {
+            const int64_t range = ranges[scenario % 4];
+            const size_t seedCount = scenario < 4 ? 0 : 500;
+            const size_t batchCount = scenario == 5 ? 70000 : 5000;
+
+            intset *seq = intsetNew();
+            intset *many = intsetNew();
+            for (size_t i = 0; i < seedCount; i++) {
+                const int64_t v = (int64_t)(rand() % 20000) - 10000;
+                intsetAdd(&seq, v, NULL);
+                intsetAdd(&many, v, NULL);
+            }
+
+            int64_t *batch = zmalloc(batchCount * sizeof(*batch));
+            for (size_t i = 0; i < batchCount; i++) {
+                int64_t v = (((int64_t)rand() << 31) ^ rand()) % range;
+                batch[i] = (i & 1) ? -v : v;
+            }
+
+            size_t added = 0;
+            for (size_t i = 0; i < batchCount; i++) {
+                bool success;
+                intsetAdd(&seq, batch[i], &success);
+                added += success;
+            }
+
+            const size_t manyAdded = intsetAddMany(&many, batch, batchCount);
+            if (manyAdded != added) {
+                ERR("Scenario %zu: AddMany added %zu, sequential added %zu",
+                    scenario, manyAdded, added);
+            }
+
+            if (intsetCount(many) != intsetCount(seq)) {
+                ERR("Scenario %zu: count %zu != %zu", scenario,
+                    intsetCount(many), intsetCount(seq));
+            } else {
+                for (size_t i = 0; i < intsetCount(seq); i++) {
+                    int64_t a, b;
+                    intsetGet(seq, i, &a);
+                    intsetGet(many, i, &b);
+                    if (a != b) {
+                        ERR("Scenario %zu: position %zu has %" PRId64
+                            " != %" PRId64,
+                            scenario, i, b, a);
+                        break;
+                    }
+                }
+            }
+
+            if (intsetAddMany(&many, batch, batchCount) != 0) {
+                ERR("Scenario %zu: re-adding batch added values", scenario);
+            }
+
+            zfree(batch);
+            intsetFree(seq);
+            intsetFree(many);
+        }
+    }
+
+    TEST("AddMany edge cases") {
+        intset *is = NULL;
+        if (intsetAddMany(&is, NULL, 0) != 0 || is) {
+            ERRR("Empty batch should be a no-op");
+        }
+
+        const int64_t dups[] = {7, 7, 7, INT64_MIN, INT64_MAX, 7, INT64_MIN};
+        if (intsetAddMany(&is, dups, 7) != 3) {
+            ERRR("Expected 3 distinct values added");
+        }
+
+        int64_t val;
+        if (!intsetGet(is, 0, &val) || val != INT64_MIN ||
+            !intsetGet(is, 2, &val) || val != INT64_MAX) {
+            ERRR("Extremes not in sorted position");
+        }
+
+        if (INTSET_TYPE(is) != INTSET_TYPE_FULL) {
+            ERRR("int64 values should land in full tier");
+        }
+
+        intsetFree(is);
+    }
+
+    TEST("AddMany sizes medium tier from its existing int32 members") {
+        /* Nearly full medium set of int32 values, then a batch of new int16
+         * and int32 values plus two existing ones. The result stays within
+         * the medium count limit but not the byte limit, which only shows
+         * when the existing int32 members are counted as int32. */
+        const size_t base = INTSET_MEDIUM_MAX_COUNT - 12;
+        int64_t *batch = zmalloc(base * sizeof(*batch));
+        for (size_t i = 0; i < base; i++) {
+            batch[i] = 100000 + (int64_t)i;
+        }
+
+        intset *is = NULL;
+        intsetAddMany(&is, batch, base);
+        if (INTSET_TYPE(is) != INTSET_TYPE_MEDIUM) {
+            ERRR("int32 values under the limits should stay medium");
+        }
+
+        const int64_t top = 100000 + (int64_t)base;
+        const int64_t more[] = {1,       2,       3,       4,       5,
+                                6,       7,       100000,  100001,  top,
+                                top + 1, top + 2, top + 3, top + 4};
+        const size_t added =
+            intsetAddMany(&is, more, sizeof(more) / sizeof(*more));
+        if (added != 12) {
+            ERR("Expected 12 new members, added %zu", added);
+        }
+
+        if (intsetCount(is) != INTSET_MEDIUM_MAX_COUNT) {
+            ERR("Expected %d members, have %zu", INTSET_MEDIUM_MAX_COUNT,
+                intsetCount(is));
+        }
+
+        if (INTSET_TYPE(is) != INTSET_TYPE_FULL) {
+            ERRR("Medium past its byte limit should become full");
+        }
+
+        zfree(batch);
+        intsetFree(is);
+    }
+
+    TEST("PERF: AddMany vs sequential intsetAdd (100K random ids)") {
+        const size_t n = 100000;
+        int64_t *batch = zmalloc(n * sizeof(*batch));
+        for (size_t i = 0; i < n; i++) {
+            batch[i] = rand() % 1000000;
+        }
+
+        intset *seq = intsetNew();
+        uint64_t start = timeUtilMonotonicNs();
+        for (size_t i = 0; i < n; i++) {
+            intsetAdd(&seq, batch[i], NULL);
+        }
+        const uint64_t seqNs = timeUtilMonotonicNs() - start;
+
+        intset *many = intsetNew();
+        start = timeUtilMonotonicNs();
+        intsetAddMany(&many, batch, n);
+        const uint64_t manyNs = timeUtilMonotonicNs() - start;
+
+        if (intsetCount(seq) != intsetCount(many)) {
+            ERRR("Batch and sequential counts differ");
+        }
+
+        printf("  sequential: %.2f ms, AddMany: %.2f ms (%.1fx)\n",
+               seqNs / 1e6, manyNs / 1e6, (double)seqNs / manyNs);
+
+        zfree(batch);
+        intsetFree(seq);
+        intsetFree(many);
+    }
+
     TEST_FINAL_RESULT;
 }
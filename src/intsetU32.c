@@ -1,5 +1,8 @@
 #include "intsetU32.h"
 #include "datakit.h"
+
+#include "../deps/varint/src/varintBP128.h"
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -207,13 +210,125 @@ bool intsetU32Subset(const intsetU32 *const a, const intsetU32 *const b) {
     return true;
 }
 
+/* Merge sorted, duplicate-free 'values' into 'is' with one reallocation and
+ * one backward pass. Returns number of values newly added. */
+static uint32_t intsetU32MergeSorted(intsetU32 **is, const uint32_t *values,
+                                     uint32_t n) {
+    const uint32_t *arr = (*is)->contents;
+    const uint32_t count = (*is)->count;
+
+    /* Count members already present so the result is sized exactly */
+    uint32_t common = 0;
+    for (uint32_t i = 0, j = 0; i < count && j < n;) {
+        if (arr[i] < values[j]) {
+            i++;
+        } else if (arr[i] > values[j]) {
+            j++;
+        } else {
+            common++;
+            i++;
+            j++;
+        }
+    }
+
+    const uint32_t added = n - common;
+    if (added == 0) {
+        return 0;
+    }
+
+    intsetU32Resize(is, count + added);
+    uint32_t *out = (*is)->contents;
+    int64_t i = (int64_t)count - 1;
+    int64_t j = (int64_t)n - 1;
+    int64_t k = (int64_t)count + added - 1;
+    while (j >= 0) {
+        if (i >= 0 && out[i] > values[j]) {
+            out[k--] = out[i--];
+        } else if (i >= 0 && out[i] == values[j]) {
+            out[k--] = out[i--];
+            j--;
+        } else {
+            out[k--] = values[j--];
+        }
+    }
+
+    (*is)->count = count + added;
+    return added;
+}
+
 uint32_t intsetU32Merge(intsetU32 **dst, const intsetU32 *b) {
-    uint32_t merged = 0;
-    for (size_t i = 0; i < b->count; i++) {
-        merged += intsetU32Add(dst, b->contents[i]);
+    return intsetU32MergeSorted(dst, b->contents, b->count);
+}
+
+/* Add 'count' values (any order, duplicates allowed) in one pass */
+uint32_t intsetU32AddMany(intsetU32 **is, const uint32_t *values,
+                          uint32_t count) {
+    if (count == 0) {
+        return 0;
     }
 
-    return merged;
+    uint32_t *sorted = zmalloc(2 * (size_t)count * sizeof(*sorted));
+    uint32_t *scratch = sorted + count;
+    memcpy(sorted, values, count * sizeof(*sorted));
+
+    bool isSorted = true;
+    for (uint32_t i = 1; i < count; i++) {
+        if (sorted[i] < sorted[i - 1]) {
+            isSorted = false;
+            break;
+        }
+    }
+
+    if (!isSorted) {
+        /* LSD radix sort, 8-bit digits; skips digits shared by all values */
+        uint32_t hist[4][256] = {{0}};
+        for (uint32_t i = 0; i < count; i++) {
+            const uint32_t v = sorted[i];
+            hist[0][v & 0xff]++;
+            hist[1][(v >> 8) & 0xff]++;
+            hist[2][(v >> 16) & 0xff]++;
+            hist[3][v >> 24]++;
+        }
+
+        uint32_t *src = sorted;
+        uint32_t *dst = scratch;
+        for (uint32_t d = 0; d < 4; d++) {
+            const uint32_t shift = d * 8;
+            if (hist[d][(src[0] >> shift) & 0xff] == count) {
+                continue;
+            }
+
+            uint32_t offset = 0;
+            for (uint32_t b = 0; b < 256; b++) {
+                const uint32_t c = hist[d][b];
+                hist[d][b] = offset;
+                offset += c;
+            }
+
+            for (uint32_t i = 0; i < count; i++) {
+                dst[hist[d][(src[i] >> shift) & 0xff]++] = src[i];
+            }
+
+            uint32_t *tmp = src;
+            src = dst;
+            dst = tmp;
+        }
+
+        if (src != sorted) {
+            memcpy(sorted, src, count * sizeof(*sorted));
+        }
+    }
+
+    uint32_t n = 1;
+    for (uint32_t i = 1; i < count; i++) {
+        if (sorted[i] != sorted[n - 1]) {
+            sorted[n++] = sorted[i];
+        }
+    }
+
+    const uint32_t added = intsetU32MergeSorted(is, sorted, n);
+    zfree(sorted);
+    return added;
 }
 
 /* Return random member */
@@ -247,6 +362,487 @@ size_t intsetU32Bytes(const intsetU32 *is) {
     return sizeof(intsetU32) + (sizeof(uint32_t) * is->count);
 }
 
+/* ====================================================================
+ * Frozen sets
+ * ==================================================================== */
+#define FROZEN_BLOCK VARINT_BP128_BLOCK_SIZE
+
+typedef struct intsetU32FrozenBlock {
+    uint32_t min; /* first value of the block */
+    uint8_t bitWidth;
+    uint8_t unused[3];
+    uint64_t offset; /* payload offset relative to frozenPayload() */
+} intsetU32FrozenBlock;
+
+struct intsetU32Frozen {
+    uint64_t bytes;
+    uint32_t count;
+    uint32_t blockCount;
+    uint8_t codec;
+    uint8_t unused[7];
+    intsetU32FrozenBlock blocks[];
+    /* payload follows blocks[blockCount], then 8 bytes of slack so every
+     * packed value can be read with one unaligned 64-bit load */
+};
+
+DK_INLINE_ALWAYS const uint8_t *frozenPayload(const intsetU32Frozen *f) {
+    return (const uint8_t *)(f->blocks + f->blockCount);
+}
+
+DK_INLINE_ALWAYS uint32_t frozenBlockLen(const intsetU32Frozen *f,
+                                         uint32_t b) {
+    return b + 1 < f->blockCount ? FROZEN_BLOCK : f->count - b * FROZEN_BLOCK;
+}
+
+/* Packed value i of a block (fixed width w, LSB-first as in varintBP128) */
+DK_INLINE_ALWAYS uint32_t frozenUnpack(const uint8_t *data, uint8_t w,
+                                       uint32_t i) {
+    const uint64_t bit = (uint64_t)i * w;
+    uint64_t word;
+    memcpy(&word, data + (bit >> 3), sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return (uint32_t)((word >> (bit & 7)) & ((UINT64_C(1) << w) - 1));
+}
+
+static void frozenResiduals(const uint32_t *values, uint32_t n,
+                            intsetU32FrozenCodec codec, uint32_t *residuals) {
+    if (codec == INTSET_U32_FROZEN_FOR) {
+        for (uint32_t i = 0; i < n; i++) {
+            residuals[i] = values[i] - values[0];
+        }
+    } else {
+        residuals[0] = 0;
+        for (uint32_t i = 1; i < n; i++) {
+            residuals[i] = values[i] - values[i - 1] - 1;
+        }
+    }
+}
+
+static void frozenPack(uint8_t *dst, const uint32_t *residuals, uint32_t n,
+                       uint8_t w) {
+    uint64_t acc = 0;
+    uint32_t filled = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc |= (uint64_t)residuals[i] << filled;
+        filled += w;
+        while (filled >= 8) {
+            *dst++ = (uint8_t)acc;
+            acc >>= 8;
+            filled -= 8;
+        }
+    }
+
+    if (filled) {
+        *dst = (uint8_t)acc;
+    }
+}
+
+intsetU32Frozen *intsetU32Freeze(const intsetU32 *is,
+                                 intsetU32FrozenCodec codec) {
+    const uint32_t count = is->count;
+    const uint32_t blockCount = (count + FROZEN_BLOCK - 1) / FROZEN_BLOCK;
+    uint32_t residuals[FROZEN_BLOCK];
+
+    /* Pass 1: size payload */
+    uint64_t payloadBytes = 0;
+    for (uint32_t b = 0; b < blockCount; b++) {
+        const uint32_t start = b * FROZEN_BLOCK;
+        const uint32_t n = b + 1 < blockCount ? FROZEN_BLOCK : count - start;
+        frozenResiduals(is->contents + start, n, codec, residuals);
+        const uint8_t w = varintBP128MaxBitWidth32(residuals, n);
+        payloadBytes += ((uint64_t)n * w + 7) / 8;
+    }
+
+    const uint64_t bytes = sizeof(intsetU32Frozen) +
+                           sizeof(intsetU32FrozenBlock) * blockCount +
+                           payloadBytes + sizeof(uint64_t);
+    intsetU32Frozen *f = zcalloc(1, bytes);
+    f->bytes = bytes;
+    f->count = count;
+    f->blockCount = blockCount;
+    f->codec = codec;
+
+    /* Pass 2: headers and packed payload */
+    uint8_t *payload = (uint8_t *)frozenPayload(f);
+    uint64_t offset = 0;
+    for (uint32_t b = 0; b < blockCount; b++) {
+        const uint32_t start = b * FROZEN_BLOCK;
+        const uint32_t n = frozenBlockLen(f, b);
+        frozenResiduals(is->contents + start, n, codec, residuals);
+        const uint8_t w = varintBP128MaxBitWidth32(residuals, n);
+
+        intsetU32FrozenBlock *block = &f->blocks[b];
+        block->min = is->contents[start];
+        block->bitWidth = w;
+        block->offset = offset;
+        frozenPack(payload + offset, residuals, n, w);
+        offset += ((uint64_t)n * w + 7) / 8;
+    }
+
+    return f;
+}
+
+void intsetU32FrozenFree(intsetU32Frozen *f) {
+    if (f) {
+        zfree(f);
+    }
+}
+
+size_t intsetU32FrozenCount(const intsetU32Frozen *f) {
+    return f->count;
+}
+
+size_t intsetU32FrozenBytes(const intsetU32Frozen *f) {
+    return f->bytes;
+}
+
+/* Check every field Freeze() derives before trusting a stored image: the
+ * header, the skip headers, the exact payload layout, and that each block
+ * decodes to strictly increasing values below the next block's first. */
+static bool frozenValid(const intsetU32Frozen *f, size_t len) {
+    if (f->bytes != len || f->codec > INTSET_U32_FROZEN_DELTA) {
+        return false;
+    }
+
+    for (size_t i = 0; i < sizeof(f->unused); i++) {
+        if (f->unused[i]) {
+            return false;
+        }
+    }
+
+    const uint64_t blockCount =
+        ((uint64_t)f->count + FROZEN_BLOCK - 1) / FROZEN_BLOCK;
+    if (f->blockCount != blockCount ||
+        (len - sizeof(*f) - sizeof(uint64_t)) / sizeof(f->blocks[0]) <
+            blockCount) {
+        return false;
+    }
+
+    const uint64_t payloadBytes = len - sizeof(*f) - sizeof(uint64_t) -
+                                  sizeof(f->blocks[0]) * blockCount;
+    const uint8_t *payload = frozenPayload(f);
+    uint64_t offset = 0;
+    for (uint32_t b = 0; b < f->blockCount; b++) {
+        const intsetU32FrozenBlock *block = &f->blocks[b];
+        const uint32_t n = frozenBlockLen(f, b);
+        if (block->bitWidth > 32 || block->offset != offset ||
+            block->unused[0] || block->unused[1] || block->unused[2]) {
+            return false;
+        }
+
+        offset += ((uint64_t)n * block->bitWidth + 7) / 8;
+        if (offset > payloadBytes) {
+            return false;
+        }
+
+        /* Every value of the block must sit below the next block's first */
+        const uint64_t limit = b + 1 < f->blockCount
+                                   ? f->blocks[b + 1].min
+                                   : (uint64_t)UINT32_MAX + 1;
+        const uint8_t *data = payload + block->offset;
+        uint64_t prev = block->min;
+        for (uint32_t i = 1; i < n; i++) {
+            const uint64_t r = frozenUnpack(data, block->bitWidth, i);
+            const uint64_t v = f->codec == INTSET_U32_FROZEN_FOR
+                                   ? block->min + r
+                                   : prev + r + 1;
+            if (v <= prev) {
+                return false;
+            }
+
+            prev = v;
+        }
+
+        if (prev >= limit || frozenUnpack(data, block->bitWidth, 0)) {
+            return false;
+        }
+    }
+
+    return offset == payloadBytes;
+}
+
+intsetU32Frozen *intsetU32FrozenLoad(const void *buf, size_t len) {
+    if (len < sizeof(intsetU32Frozen) + sizeof(uint64_t)) {
+        return NULL;
+    }
+
+    /* Copy first: 'buf' may be unaligned, and validating the copy means
+     * nothing can change between the check and its use */
+    intsetU32Frozen *f = zmalloc(len);
+    memcpy(f, buf, len);
+    if (!frozenValid(f, len)) {
+        zfree(f);
+        return NULL;
+    }
+
+    return f;
+}
+
+/* Last block at or after 'lo' whose first value is <= value; false if
+ * value precedes block 'lo'. With 'gallop', the search range grows
+ * exponentially from 'lo' first (cheap when the answer is close by). */
+static bool frozenFindBlock(const intsetU32Frozen *f, uint32_t lo,
+                            uint32_t value, bool gallop, uint32_t *block) {
+    if (f->blockCount == 0 || value < f->blocks[lo].min) {
+        return false;
+    }
+
+    uint32_t hi = f->blockCount - 1;
+    if (gallop) {
+        uint32_t step = 1;
+        while (lo + step <= hi && f->blocks[lo + step].min <= value) {
+            lo += step;
+            step *= 2;
+        }
+
+        if (lo + step <= hi) {
+            hi = lo + step - 1;
+        }
+    }
+
+    while (lo < hi) {
+        const uint32_t mid = lo + (hi - lo + 1) / 2;
+        if (f->blocks[mid].min <= value) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    *block = lo;
+    return true;
+}
+
+/* First index i in block b with value_i >= value (block length if none).
+ * *at receives value_i when i < length; *prev receives value_{i-1} when
+ * i > 0. DELTA blocks are decoded only up to i. */
+static uint32_t frozenBlockLowerBound(const intsetU32Frozen *f, uint32_t b,
+                                      uint32_t value, uint32_t *at,
+                                      uint32_t *prev) {
+    const intsetU32FrozenBlock *block = &f->blocks[b];
+    const uint8_t *data = frozenPayload(f) + block->offset;
+    const uint8_t w = block->bitWidth;
+    const uint32_t n = frozenBlockLen(f, b);
+
+    if (value <= block->min) {
+        *at = block->min;
+        return 0;
+    }
+
+    if (f->codec == INTSET_U32_FROZEN_FOR) {
+        const uint32_t target = value - block->min;
+        uint32_t lo = 1;
+        uint32_t hi = n;
+        while (lo < hi) {
+            const uint32_t mid = (lo + hi) / 2;
+            if (frozenUnpack(data, w, mid) < target) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        *prev = block->min + frozenUnpack(data, w, lo - 1);
+        if (lo < n) {
+            *at = block->min + frozenUnpack(data, w, lo);
+        }
+
+        return lo;
+    }
+
+    uint32_t v = block->min;
+    for (uint32_t i = 1; i < n; i++) {
+        const uint32_t next = v + frozenUnpack(data, w, i) + 1;
+        if (next >= value) {
+            *prev = v;
+            *at = next;
+            return i;
+        }
+
+        v = next;
+    }
+
+    *prev = v;
+    return n;
+}
+
+bool intsetU32FrozenExists(const intsetU32Frozen *f, uint32_t value) {
+    uint32_t b;
+    if (!frozenFindBlock(f, 0, value, false, &b)) {
+        return false;
+    }
+
+    uint32_t at = 0;
+    uint32_t prev;
+    const uint32_t i = frozenBlockLowerBound(f, b, value, &at, &prev);
+    return i < frozenBlockLen(f, b) && at == value;
+}
+
+bool intsetU32FrozenGet(const intsetU32Frozen *f, uint32_t pos,
+                        uint32_t *value) {
+    if (pos >= f->count) {
+        return false;
+    }
+
+    const intsetU32FrozenBlock *block = &f->blocks[pos / FROZEN_BLOCK];
+    const uint8_t *data = frozenPayload(f) + block->offset;
+    const uint32_t i = pos % FROZEN_BLOCK;
+
+    if (f->codec == INTSET_U32_FROZEN_FOR) {
+        *value = block->min + frozenUnpack(data, block->bitWidth, i);
+        return true;
+    }
+
+    uint32_t v = block->min;
+    for (uint32_t j = 1; j <= i; j++) {
+        v += frozenUnpack(data, block->bitWidth, j) + 1;
+    }
+
+    *value = v;
+    return true;
+}
+
+void intsetU32FrozenIteratorInit(const intsetU32Frozen *f,
+                                 intsetU32FrozenIterator *it) {
+    it->f = f;
+    it->pos = 0;
+    it->prev = 0;
+}
+
+bool intsetU32FrozenIteratorNext(intsetU32FrozenIterator *it,
+                                 uint32_t *value) {
+    const intsetU32Frozen *f = it->f;
+    if (it->pos >= f->count) {
+        return false;
+    }
+
+    const intsetU32FrozenBlock *block = &f->blocks[it->pos / FROZEN_BLOCK];
+    const uint32_t i = it->pos % FROZEN_BLOCK;
+    uint32_t v = block->min;
+    if (i) {
+        const uint32_t r = frozenUnpack(frozenPayload(f) + block->offset,
+                                        block->bitWidth, i);
+        v = f->codec == INTSET_U32_FROZEN_FOR ? block->min + r
+                                              : it->prev + r + 1;
+    }
+
+    it->prev = v;
+    it->pos++;
+    *value = v;
+    return true;
+}
+
+void intsetU32FrozenIteratorSeek(intsetU32FrozenIterator *it,
+                                 uint32_t value) {
+    const intsetU32Frozen *f = it->f;
+    uint32_t b;
+    if (!frozenFindBlock(f, 0, value, false, &b)) {
+        it->pos = 0;
+        return;
+    }
+
+    uint32_t at;
+    uint32_t prev = 0;
+    const uint32_t i = frozenBlockLowerBound(f, b, value, &at, &prev);
+    it->pos = b * FROZEN_BLOCK + i;
+    it->prev = prev;
+}
+
+intsetU32 *intsetU32FrozenThaw(const intsetU32Frozen *f) {
+    intsetU32 *is = intsetU32NewLen(f->count);
+    intsetU32FrozenIterator it;
+    intsetU32FrozenIteratorInit(f, &it);
+    uint32_t value;
+    while (intsetU32FrozenIteratorNext(&it, &value)) {
+        is->contents[is->count++] = value;
+    }
+
+    return is;
+}
+
+intsetU32 *intsetU32FrozenIntersect(const intsetU32Frozen *f,
+                                    const intsetU32 *is) {
+    const uint32_t m = is->count;
+    const uint32_t *probes = is->contents;
+    intsetU32 *result = intsetU32NewLen(m < f->count ? m : f->count);
+    uint32_t *out = result->contents;
+
+    uint32_t j = 0;
+    uint32_t b = 0;
+    while (j < m && b < f->blockCount) {
+        /* Jump straight to the block that could hold the next probe */
+        if (!frozenFindBlock(f, b, probes[j], true, &b)) {
+            /* probe precedes block b; skip probes below its first value */
+            const uint32_t first = f->blocks[b].min;
+            while (j < m && probes[j] < first) {
+                j++;
+            }
+
+            continue;
+        }
+
+        const intsetU32FrozenBlock *block = &f->blocks[b];
+        const uint8_t *data = frozenPayload(f) + block->offset;
+        const uint8_t w = block->bitWidth;
+        const uint32_t n = frozenBlockLen(f, b);
+        const uint32_t last = b + 1 < f->blockCount ? f->blocks[b + 1].min - 1
+                                                    : UINT32_MAX;
+
+        if (f->codec == INTSET_U32_FROZEN_FOR) {
+            uint32_t lo = 0;
+            for (; j < m && probes[j] <= last; j++) {
+                const uint32_t target = probes[j] - block->min;
+                uint32_t hi = n;
+                while (lo < hi) {
+                    const uint32_t mid = (lo + hi) / 2;
+                    if (frozenUnpack(data, w, mid) < target) {
+                        lo = mid + 1;
+                    } else {
+                        hi = mid;
+                    }
+                }
+
+                if (lo == n) {
+                    break;
+                }
+
+                if (frozenUnpack(data, w, lo) == target) {
+                    *out++ = probes[j];
+                }
+            }
+        } else {
+            uint32_t i = 0;
+            uint32_t v = block->min;
+            for (; j < m && probes[j] <= last; j++) {
+                while (v < probes[j] && ++i < n) {
+                    v += frozenUnpack(data, w, i) + 1;
+                }
+
+                if (i == n) {
+                    break;
+                }
+
+                if (v == probes[j]) {
+                    *out++ = probes[j];
+                }
+            }
+        }
+
+        /* remaining probes in this block's range are above its last value */
+        while (j < m && probes[j] <= last) {
+            j++;
+        }
+
+        b++;
+    }
+
+    result->count = out - result->contents;
+    intsetU32ShrinkToSize(&result);
+    return result;
+}
+
 void intsetU32Repr(const intsetU32 *is) {
     printf("[");
     for (uint32_t i = 0; i < is->count; i++) {
@@ -382,6 +978,311 @@ int intsetU32Test(int argc, char **argv) {
         ok();
     }
 
+    printf("AddMany matches sequential adds: ");
+    {
+        for (int round = 0; round < 20; round++) {
+            const uint32_t n = 1 + random() % 5000;
+            const uint32_t range = round % 2 ? 0x1000 : UINT32_MAX;
+            uint32_t *vals = zmalloc(n * sizeof(*vals));
+            for (uint32_t i = 0; i < n; i++) {
+                vals[i] = random() % range;
+            }
+
+            intsetU32 *a = intsetU32New();
+            intsetU32 *b = intsetU32New();
+            for (uint32_t i = 0; i < 300; i++) {
+                const uint32_t v = random() % range;
+                intsetU32Add(&a, v);
+                intsetU32Add(&b, v);
+            }
+
+            uint32_t seq = 0;
+            for (uint32_t i = 0; i < n; i++) {
+                seq += intsetU32Add(&a, vals[i]);
+            }
+
+            intsetU32Assert(intsetU32AddMany(&b, vals, n) == seq);
+            intsetU32Assert(intsetU32Equal(a, b));
+            intsetU32Assert(intsetU32AddMany(&b, vals, n) == 0);
+
+            intsetU32Free(a);
+            intsetU32Free(b);
+            zfree(vals);
+        }
+
+        ok();
+    }
+
+    printf("AddMany vs sequential add (100K random ids):\n");
+    {
+        const uint32_t n = 100000;
+        uint32_t *vals = zmalloc(n * sizeof(*vals));
+        for (uint32_t i = 0; i < n; i++) {
+            vals[i] = random();
+        }
+
+        intsetU32 *a = intsetU32New();
+        long long start = usec();
+        for (uint32_t i = 0; i < n; i++) {
+            intsetU32Add(&a, vals[i]);
+        }
+        const long long seqUs = usec() - start;
+
+        intsetU32 *b = intsetU32New();
+        start = usec();
+        intsetU32AddMany(&b, vals, n);
+        const long long manyUs = usec() - start;
+        intsetU32Assert(intsetU32Equal(a, b));
+
+        printf("    sequential: %lld us, AddMany: %lld us\n", seqUs, manyUs);
+        intsetU32Free(a);
+        intsetU32Free(b);
+        zfree(vals);
+    }
+
+    printf("Frozen sets match source (FOR + DELTA): ");
+    {
+        const uint32_t sizes[] = {0,   1,   2,   127,  128,
+                                  129, 255, 256, 1000, 20000};
+        const uint32_t maxGaps[] = {1, 3, 100, 1u << 24};
+        for (size_t g = 0; g < sizeof(maxGaps) / sizeof(*maxGaps); g++) {
+            for (size_t si = 0; si < sizeof(sizes) / sizeof(*sizes); si++) {
+                const uint32_t n = sizes[si];
+                is = intsetU32NewLen(n);
+                uint64_t v = random() % maxGaps[g];
+                for (uint32_t i = 0; i < n && v <= UINT32_MAX; i++) {
+                    is->contents[is->count++] = (uint32_t)v;
+                    v += 1 + random() % maxGaps[g];
+                }
+
+                for (int codec = 0; codec < 2; codec++) {
+                    intsetU32Frozen *f = intsetU32Freeze(is, codec);
+                    intsetU32Assert(intsetU32FrozenCount(f) == is->count);
+
+                    intsetU32FrozenIterator it;
+                    intsetU32FrozenIteratorInit(f, &it);
+                    for (uint32_t i = 0; i < is->count; i++) {
+                        uint32_t got;
+                        intsetU32Assert(intsetU32FrozenGet(f, i, &got));
+                        intsetU32Assert(got == is->contents[i]);
+                        intsetU32Assert(intsetU32FrozenIteratorNext(&it, &got));
+                        intsetU32Assert(got == is->contents[i]);
+                        intsetU32Assert(
+                            intsetU32FrozenExists(f, is->contents[i]));
+                    }
+
+                    uint32_t got;
+                    intsetU32Assert(!intsetU32FrozenIteratorNext(&it, &got));
+                    intsetU32Assert(!intsetU32FrozenGet(f, is->count, &got));
+
+                    /* non-members and seeks at random probes */
+                    for (int k = 0; k < 2000; k++) {
+                        const uint32_t probe = (uint32_t)random();
+                        intsetU32Assert(intsetU32FrozenExists(f, probe) ==
+                                        intsetU32Exists(is, probe));
+
+                        uint32_t pos = 0;
+                        while (pos < is->count && is->contents[pos] < probe) {
+                            pos++;
+                        }
+
+                        intsetU32FrozenIteratorSeek(&it, probe);
+                        if (pos < is->count) {
+                            intsetU32Assert(
+                                intsetU32FrozenIteratorNext(&it, &got));
+                            intsetU32Assert(got == is->contents[pos]);
+                        } else {
+                            intsetU32Assert(
+                                !intsetU32FrozenIteratorNext(&it, &got));
+                        }
+
+                        if (pos + 1 < is->count) {
+                            intsetU32Assert(
+                                intsetU32FrozenIteratorNext(&it, &got));
+                            intsetU32Assert(got == is->contents[pos + 1]);
+                        }
+                    }
+
+                    intsetU32 *thawed = intsetU32FrozenThaw(f);
+                    intsetU32Assert(intsetU32Equal(thawed, is));
+                    intsetU32Free(thawed);
+
+                    /* Intersect against a mix of members and neighbors */
+                    intsetU32 *probes = intsetU32New();
+                    intsetU32 *expect = intsetU32New();
+                    for (uint32_t i = 0; i < is->count; i += 1 + random() % 7) {
+                        intsetU32Add(&probes, is->contents[i] + 1);
+                        if (random() & 1) {
+                            intsetU32Add(&probes, is->contents[i]);
+                        }
+                    }
+
+                    for (int k = 0; k < 50; k++) {
+                        intsetU32Add(&probes, (uint32_t)random());
+                    }
+
+                    for (uint32_t i = 0; i < probes->count; i++) {
+                        if (intsetU32Exists(is, probes->contents[i])) {
+                            intsetU32Add(&expect, probes->contents[i]);
+                        }
+                    }
+
+                    intsetU32 *inter = intsetU32FrozenIntersect(f, probes);
+                    intsetU32Assert(intsetU32Equal(inter, expect));
+                    intsetU32Free(inter);
+                    intsetU32Free(probes);
+                    intsetU32Free(expect);
+                    intsetU32FrozenFree(f);
+                }
+
+                intsetU32Free(is);
+            }
+        }
+
+        ok();
+    }
+
+    printf("Frozen payload is varintBP128 block layout: ");
+    {
+        is = intsetU32NewLen(FROZEN_BLOCK);
+        for (uint32_t i = 0; i < FROZEN_BLOCK; i++) {
+            is->contents[is->count++] = 1000 + i * 37 + (random() % 37);
+        }
+
+        intsetU32Frozen *f = intsetU32Freeze(is, INTSET_U32_FROZEN_FOR);
+        const intsetU32FrozenBlock *block = &f->blocks[0];
+        uint8_t encoded[VARINT_BP128_MAX_BLOCK_BYTES + 8] = {0};
+        encoded[0] = block->bitWidth;
+        memcpy(encoded + 1, frozenPayload(f) + block->offset,
+               (FROZEN_BLOCK * block->bitWidth + 7) / 8);
+
+        uint32_t decoded[FROZEN_BLOCK];
+        varintBP128DecodeBlock32(encoded, decoded);
+        for (uint32_t i = 0; i < FROZEN_BLOCK; i++) {
+            intsetU32Assert(decoded[i] + block->min == is->contents[i]);
+        }
+
+        intsetU32FrozenFree(f);
+        intsetU32Free(is);
+        ok();
+    }
+
+    printf("Frozen images load verbatim and reject corruption: ");
+    {
+        is = intsetU32NewLen(1000);
+        for (uint32_t i = 0; i < 1000; i++) {
+            is->contents[is->count++] = i * 5 + (random() % 5);
+        }
+
+        for (int codec = 0; codec < 2; codec++) {
+            intsetU32Frozen *f = intsetU32Freeze(is, codec);
+            const size_t len = intsetU32FrozenBytes(f);
+
+            /* Stored at an odd address to exercise the unaligned copy */
+            uint8_t *buf = zmalloc(len + 1);
+            memcpy(buf + 1, f, len);
+            intsetU32Frozen *loaded = intsetU32FrozenLoad(buf + 1, len);
+            intsetU32Assert(loaded);
+            intsetU32 *thawed = intsetU32FrozenThaw(loaded);
+            intsetU32Assert(intsetU32Equal(thawed, is));
+            intsetU32Free(thawed);
+            intsetU32FrozenFree(loaded);
+
+            intsetU32Assert(!intsetU32FrozenLoad(buf + 1, len - 1));
+            intsetU32Assert(!intsetU32FrozenLoad(buf + 1, 8));
+
+            intsetU32Frozen *bad = (intsetU32Frozen *)(buf + 1);
+#define FROZEN_REJECTS(corrupt)                                                \
+    do {                                                                       \
+        memcpy(buf + 1, f, len);                                               \
+        corrupt;                                                               \
+        intsetU32Assert(!intsetU32FrozenLoad(buf + 1, len));                   \
+    } while (0)
+            FROZEN_REJECTS(bad->codec = 2);
+            FROZEN_REJECTS(bad->unused[3] = 1);
+            FROZEN_REJECTS(bad->count += FROZEN_BLOCK);
+            FROZEN_REJECTS(bad->blockCount = UINT32_MAX);
+            FROZEN_REJECTS(bad->bytes++);
+            FROZEN_REJECTS(bad->blocks[1].bitWidth = 33);
+            FROZEN_REJECTS(bad->blocks[1].offset++);
+            FROZEN_REJECTS(bad->blocks[2].min = bad->blocks[1].min);
+            FROZEN_REJECTS(bad->blocks[3].unused[0] = 1);
+            /* a residual that pushes past the next block's first value */
+            FROZEN_REJECTS(memset((uint8_t *)(bad->blocks + bad->blockCount) +
+                                      bad->blocks[1].offset,
+                                  0xff, 4));
+#undef FROZEN_REJECTS
+
+            zfree(buf);
+            intsetU32FrozenFree(f);
+        }
+
+        intsetU32Free(is);
+        ok();
+    }
+
+    printf("Frozen size and lookups (10M ids, mean gap 64):\n");
+    {
+        const uint32_t n = 10000000;
+        is = intsetU32NewLen(n);
+        uint32_t v = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            v += 1 + random() % 127;
+            is->contents[is->count++] = v;
+        }
+
+        uint32_t *lookups = zmalloc(sizeof(*lookups) * 1000000);
+        for (uint32_t i = 0; i < 1000000; i++) {
+            lookups[i] = random() % v;
+        }
+
+        long long start = usec();
+        size_t hits = 0;
+        for (uint32_t i = 0; i < 1000000; i++) {
+            hits += intsetU32Exists(is, lookups[i]);
+        }
+
+        printf("    plain:  %5.2f bytes/id, %4lld ns/lookup\n",
+               (double)intsetU32Bytes(is) / n, (usec() - start) / 1000);
+
+        for (int codec = 0; codec < 2; codec++) {
+            start = usec();
+            intsetU32Frozen *f = intsetU32Freeze(is, codec);
+            const long long freezeUs = usec() - start;
+
+            start = usec();
+            size_t frozenHits = 0;
+            for (uint32_t i = 0; i < 1000000; i++) {
+                frozenHits += intsetU32FrozenExists(f, lookups[i]);
+            }
+
+            const long long lookupUs = usec() - start;
+            intsetU32Assert(frozenHits == hits);
+
+            intsetU32 *probes = intsetU32NewLen(n / 100);
+            for (uint32_t i = 0; i < n; i += 100) {
+                probes->contents[probes->count++] = is->contents[i];
+            }
+
+            start = usec();
+            intsetU32 *inter = intsetU32FrozenIntersect(f, probes);
+            const long long interUs = usec() - start;
+            intsetU32Assert(intsetU32Equal(inter, probes));
+
+            printf("    %-6s  %5.2f bytes/id, %4lld ns/lookup, freeze %lld "
+                   "ms, intersect 100K %lld us\n",
+                   codec == INTSET_U32_FROZEN_FOR ? "FOR:" : "DELTA:",
+                   (double)intsetU32FrozenBytes(f) / n, lookupUs / 1000,
+                   freezeUs / 1000, interUs);
+            intsetU32Free(inter);
+            intsetU32Free(probes);
+            intsetU32FrozenFree(f);
+        }
+
+        zfree(lookups);
+        intsetU32Free(is);
+    }
+
     return 0;
 }
 
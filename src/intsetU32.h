@@ -20,6 +20,9 @@ void intsetU32Free(intsetU32 *is);
 bool intsetU32Add(intsetU32 **is, uint32_t value);
 bool intsetU32Remove(intsetU32 **is, uint32_t value);
 uint32_t intsetU32Merge(intsetU32 **dst, const intsetU32 *b);
+/* Add unsorted (possibly duplicated) values; returns count newly added */
+uint32_t intsetU32AddMany(intsetU32 **is, const uint32_t *values,
+                          uint32_t count);
 bool intsetU32Exists(const intsetU32 *is, uint32_t value);
 bool intsetU32Equal(const intsetU32 *a, const intsetU32 *b);
 bool intsetU32Subset(const intsetU32 *a, const intsetU32 *b);
@@ -29,6 +32,65 @@ bool intsetU32RandomDelete(intsetU32 **is, uint32_t *deleted);
 size_t intsetU32Count(const intsetU32 *is);
 size_t intsetU32Bytes(const intsetU32 *is);
 
+/* ====================================================================
+ * Frozen (read-only, block-compressed) sets
+ * ====================================================================
+ * Values are split into blocks of 128 (VARINT_BP128_BLOCK_SIZE). Each block
+ * has a skip header (first value, bit width, payload offset) and a payload
+ * bit-packed in the varintBP128 block layout (fixed width, LSB-first):
+ *   - INTSET_U32_FROZEN_FOR:   value - blockMin. Any element decodes in
+ *                              O(1), so lookups binary search the block.
+ *   - INTSET_U32_FROZEN_DELTA: gap - 1 from the previous value. Smaller
+ *                              (consecutive runs pack to 0 bits), but
+ *                              lookups prefix-sum inside one block.
+ * Lookups binary search the skip headers and then decode only as much of
+ * one block as needed; nothing ever decompresses a whole block up front.
+ *
+ * Picking a codec: DELTA is the smaller image, but each probe prefix-sums
+ * up to a whole block where FOR binary searches it. Point lookups are
+ * dominated by the skip-header search and cost about the same, while
+ * intersecting with sparse probes runs roughly 3x slower over DELTA. Use
+ * FOR for sets that are intersected more than stored.
+ *
+ * A frozen set is one flat allocation holding only relative offsets, so
+ * its intsetU32FrozenBytes() bytes can be stored verbatim and read back with
+ * intsetU32FrozenLoad(), which validates the image (NULL if malformed). */
+typedef enum intsetU32FrozenCodec {
+    INTSET_U32_FROZEN_FOR = 0,
+    INTSET_U32_FROZEN_DELTA = 1
+} intsetU32FrozenCodec;
+
+typedef struct intsetU32Frozen intsetU32Frozen;
+
+typedef struct intsetU32FrozenIterator {
+    const intsetU32Frozen *f;
+    uint32_t pos;  /* position of the next value returned */
+    uint32_t prev; /* value at pos - 1 (DELTA decoding state) */
+} intsetU32FrozenIterator;
+
+intsetU32Frozen *intsetU32Freeze(const intsetU32 *is,
+                                 intsetU32FrozenCodec codec);
+intsetU32 *intsetU32FrozenThaw(const intsetU32Frozen *f);
+void intsetU32FrozenFree(intsetU32Frozen *f);
+size_t intsetU32FrozenCount(const intsetU32Frozen *f);
+size_t intsetU32FrozenBytes(const intsetU32Frozen *f);
+intsetU32Frozen *intsetU32FrozenLoad(const void *buf, size_t len);
+bool intsetU32FrozenExists(const intsetU32Frozen *f, uint32_t value);
+bool intsetU32FrozenGet(const intsetU32Frozen *f, uint32_t pos,
+                        uint32_t *value);
+
+void intsetU32FrozenIteratorInit(const intsetU32Frozen *f,
+                                 intsetU32FrozenIterator *it);
+bool intsetU32FrozenIteratorNext(intsetU32FrozenIterator *it,
+                                 uint32_t *value);
+/* Position 'it' so the next value returned is the first one >= 'value' */
+void intsetU32FrozenIteratorSeek(intsetU32FrozenIterator *it, uint32_t value);
+
+/* Values present in both; blocks holding none of 'is' are skipped through
+ * the skip headers without being decoded. Caller frees. */
+intsetU32 *intsetU32FrozenIntersect(const intsetU32Frozen *f,
+                                    const intsetU32 *is);
+
 #ifdef DATAKIT_TEST
 int intsetU32Test(int argc, char *argv[]);
 void intsetU32Repr(const intsetU32 *is);
@@ -109,6 +109,64 @@ linearBloomHashCheckEarlyExit(const linearBloom *restrict const bloom,
     return true;
 }
 
+/* Batch APIs: while key 'i' is resolved, the probe slots of key
+ * 'i + LINEARBLOOM_PREFETCH_DISTANCE' are prefetched so their cache misses
+ * overlap instead of being paid one key at a time. */
+#ifndef LINEARBLOOM_PREFETCH_DISTANCE
+#define LINEARBLOOM_PREFETCH_DISTANCE 8
+#endif
+
+#define LINEARBLOOM_PREFETCH_PROBES(bloom, hash, rw)                           \
+    do {                                                                       \
+        for (uint32_t _i = 0; _i < LINEARBLOOM_HASHES; _i++) {                 \
+            const uint64_t _bitPos =                                           \
+                LINEARBLOOM_KIRSCHMITZENMACHER(_i, (hash)[0], (hash)[1]) %     \
+                LINEARBLOOM_EXTENT_BITS;                                       \
+            __builtin_prefetch(&(bloom)[LB_SLOT(_bitPos)], rw);                \
+        }                                                                      \
+    } while (0)
+
+/* results[i] = linearBloomHashCheck(bloom, hashes[i]) for each of 'n' keys */
+DK_INLINE_ALWAYS void
+linearBloomHashCheckMany(const linearBloom *restrict const bloom,
+                         uint64_t hashes[][2], size_t n,
+                         bool *restrict results) {
+    for (size_t i = 0; i < n && i < LINEARBLOOM_PREFETCH_DISTANCE; i++) {
+        LINEARBLOOM_PREFETCH_PROBES(bloom, hashes[i], 0);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (i + LINEARBLOOM_PREFETCH_DISTANCE < n) {
+            LINEARBLOOM_PREFETCH_PROBES(
+                bloom, hashes[i + LINEARBLOOM_PREFETCH_DISTANCE], 0);
+        }
+
+        results[i] = linearBloomHashCheck(bloom, hashes[i]);
+    }
+}
+
+/* linearBloomHashSet() each of 'n' keys in order. If 'results' is not NULL,
+ * results[i] is the linearBloomHashSet() result for key 'i'. */
+DK_INLINE_ALWAYS void linearBloomHashSetMany(linearBloom *restrict const bloom,
+                                             uint64_t hashes[][2], size_t n,
+                                             bool *restrict results) {
+    for (size_t i = 0; i < n && i < LINEARBLOOM_PREFETCH_DISTANCE; i++) {
+        LINEARBLOOM_PREFETCH_PROBES(bloom, hashes[i], 1);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (i + LINEARBLOOM_PREFETCH_DISTANCE < n) {
+            LINEARBLOOM_PREFETCH_PROBES(
+                bloom, hashes[i + LINEARBLOOM_PREFETCH_DISTANCE], 1);
+        }
+
+        const bool existed = linearBloomHashSet(bloom, hashes[i]);
+        if (results) {
+            results[i] = existed;
+        }
+    }
+}
+
 #ifdef DATAKIT_TEST
 int linearBloomTest(int argc, char *argv[]);
 #endif
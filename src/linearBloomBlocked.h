@@ -0,0 +1,223 @@
+#pragma once
+
+#include "datakit.h"
+
+/* linearBloomBlocked is a split-block Bloom filter: the filter is an array
+ * of 64-byte blocks (one cache line each) and every key sets or checks
+ * exactly one bit in each of the block's eight 64-bit words.
+ *
+ * hash[0] picks the block, hash[1] picks the bit within each word, so a
+ * set or check touches a single cache line and the eight word tests run
+ * as one vector mask operation (AVX2, SSE2, or NEON).
+ *
+ * Compared to linearBloom (k = 13 probes across the whole bit array) the
+ * blocked filter trades a slightly higher false positive rate at the same
+ * size for one cache miss per operation instead of up to 13.
+ * At 16 bits per item the false positive rate is about 0.1%;
+ * at 24 bits per item it is about 0.01%. */
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+#define LINEARBLOOMBLOCKED_BLOCK_BYTES 64
+#define LINEARBLOOMBLOCKED_BLOCK_WORDS                                         \
+    (LINEARBLOOMBLOCKED_BLOCK_BYTES / sizeof(uint64_t))
+
+typedef struct linearBloomBlocked {
+    uint64_t *bits; /* 64-byte aligned; blocks * 8 words */
+    uint64_t blocks;
+    void *alloc; /* Unaligned allocation holding 'bits' */
+} linearBloomBlocked;
+
+/* Odd multipliers spreading one 32-bit key into eight 6-bit bit offsets
+ * (one per word); from the Impala/Parquet split-block Bloom filter. */
+static const uint32_t linearBloomBlockedSalt[LINEARBLOOMBLOCKED_BLOCK_WORDS]
+    __attribute__((aligned(32))) = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU,
+                                    0xa2b7289dU, 0x705495c7U, 0x2df1424bU,
+                                    0x9efc4947U, 0x5c6bfb31U};
+
+/* Create a filter of at least 'bytes' bytes (rounded up to whole 64-byte
+ * blocks). Size for about 16 bits (2 bytes) per expected item for a 0.1%
+ * false positive rate. */
+DK_INLINE_ALWAYS linearBloomBlocked *linearBloomBlockedNew(uint64_t bytes) {
+    linearBloomBlocked *bloom = zcalloc(1, sizeof(*bloom));
+    bloom->blocks = (bytes + LINEARBLOOMBLOCKED_BLOCK_BYTES - 1) /
+                    LINEARBLOOMBLOCKED_BLOCK_BYTES;
+    if (!bloom->blocks) {
+        bloom->blocks = 1;
+    }
+
+    bloom->alloc = zcalloc(1, bloom->blocks * LINEARBLOOMBLOCKED_BLOCK_BYTES +
+                                  LINEARBLOOMBLOCKED_BLOCK_BYTES);
+    const uintptr_t alignMask = LINEARBLOOMBLOCKED_BLOCK_BYTES - 1;
+    bloom->bits =
+        (uint64_t *)(((uintptr_t)bloom->alloc + alignMask) & ~alignMask);
+    return bloom;
+}
+
+DK_INLINE_ALWAYS void linearBloomBlockedFree(linearBloomBlocked *bloom) {
+    if (bloom) {
+        zfree(bloom->alloc);
+        zfree(bloom);
+    }
+}
+
+DK_INLINE_ALWAYS void linearBloomBlockedReset(linearBloomBlocked *bloom) {
+    memset(bloom->bits, 0, bloom->blocks * LINEARBLOOMBLOCKED_BLOCK_BYTES);
+}
+
+DK_INLINE_ALWAYS uint64_t
+linearBloomBlockedBytes(const linearBloomBlocked *bloom) {
+    return bloom->blocks * LINEARBLOOMBLOCKED_BLOCK_BYTES;
+}
+
+/* Block for 'hash': maps hash[0] onto [0, blocks) with a multiply instead
+ * of a modulo so any block count is equally cheap. */
+DK_INLINE_ALWAYS uint64_t *
+linearBloomBlockedBlock(const linearBloomBlocked *bloom,
+                        const uint64_t hash[2]) {
+    const uint64_t block =
+        (uint64_t)(((__uint128_t)hash[0] * bloom->blocks) >> 64);
+    return bloom->bits + block * LINEARBLOOMBLOCKED_BLOCK_WORDS;
+}
+
+/* One bit per word: word 'i' gets bit ((key * salt[i]) >> 26). */
+DK_INLINE_ALWAYS void
+linearBloomBlockedMasks(const uint64_t hash[2],
+                        uint64_t masks[LINEARBLOOMBLOCKED_BLOCK_WORDS]) {
+    const uint32_t key = (uint32_t)hash[1];
+    for (uint32_t i = 0; i < LINEARBLOOMBLOCKED_BLOCK_WORDS; i++) {
+        masks[i] = 1ULL << ((key * linearBloomBlockedSalt[i]) >> 26);
+    }
+}
+
+#if defined(__AVX2__)
+/* Eight 64-bit masks as two 256-bit vectors. */
+DK_INLINE_ALWAYS void linearBloomBlockedMasksAVX2(const uint64_t hash[2],
+                                                  __m256i *lo, __m256i *hi) {
+    const __m256i key = _mm256_set1_epi32((int32_t)(uint32_t)hash[1]);
+    const __m256i salt =
+        _mm256_load_si256((const __m256i *)linearBloomBlockedSalt);
+    const __m256i shift =
+        _mm256_srli_epi32(_mm256_mullo_epi32(key, salt), 26);
+    const __m256i one = _mm256_set1_epi64x(1);
+    *lo = _mm256_sllv_epi64(
+        one, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(shift)));
+    *hi = _mm256_sllv_epi64(
+        one, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(shift, 1)));
+}
+#endif
+
+/* Reference scalar check; the vector paths below must agree with it. */
+DK_INLINE_ALWAYS bool
+linearBloomBlockedHashCheckScalar(const linearBloomBlocked *restrict bloom,
+                                  const uint64_t hash[2]) {
+    const uint64_t *block = linearBloomBlockedBlock(bloom, hash);
+    uint64_t masks[LINEARBLOOMBLOCKED_BLOCK_WORDS];
+    linearBloomBlockedMasks(hash, masks);
+
+    uint64_t missing = 0;
+    for (uint32_t i = 0; i < LINEARBLOOMBLOCKED_BLOCK_WORDS; i++) {
+        missing |= masks[i] & ~block[i];
+    }
+
+    return missing == 0;
+}
+
+DK_INLINE_ALWAYS bool
+linearBloomBlockedHashCheck(const linearBloomBlocked *restrict bloom,
+                            const uint64_t hash[2]) {
+    const uint64_t *block = linearBloomBlockedBlock(bloom, hash);
+
+#if defined(__AVX2__)
+    __m256i mlo, mhi;
+    linearBloomBlockedMasksAVX2(hash, &mlo, &mhi);
+    const __m256i missing = _mm256_or_si256(
+        _mm256_andnot_si256(_mm256_load_si256((const __m256i *)block), mlo),
+        _mm256_andnot_si256(_mm256_load_si256((const __m256i *)block + 1),
+                            mhi));
+    return _mm256_testz_si256(missing, missing);
+#elif defined(__SSE2__)
+    uint64_t masks[LINEARBLOOMBLOCKED_BLOCK_WORDS] __attribute__((aligned(16)));
+    linearBloomBlockedMasks(hash, masks);
+
+    const __m128i *b = (const __m128i *)block;
+    const __m128i *m = (const __m128i *)masks;
+    const __m128i missing = _mm_or_si128(
+        _mm_or_si128(_mm_andnot_si128(_mm_load_si128(b), _mm_load_si128(m)),
+                     _mm_andnot_si128(_mm_load_si128(b + 1),
+                                      _mm_load_si128(m + 1))),
+        _mm_or_si128(_mm_andnot_si128(_mm_load_si128(b + 2),
+                                      _mm_load_si128(m + 2)),
+                     _mm_andnot_si128(_mm_load_si128(b + 3),
+                                      _mm_load_si128(m + 3))));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(missing, _mm_setzero_si128())) ==
+           0xFFFF;
+#elif defined(__aarch64__)
+    uint64_t masks[LINEARBLOOMBLOCKED_BLOCK_WORDS];
+    linearBloomBlockedMasks(hash, masks);
+
+    uint64x2_t missing = vdupq_n_u64(0);
+    for (uint32_t i = 0; i < LINEARBLOOMBLOCKED_BLOCK_WORDS; i += 2) {
+        missing = vorrq_u64(missing,
+                            vbicq_u64(vld1q_u64(masks + i),
+                                      vld1q_u64(block + i)));
+    }
+
+    return vmaxvq_u32(vreinterpretq_u32_u64(missing)) == 0;
+#else
+    return linearBloomBlockedHashCheckScalar(bloom, hash);
+#endif
+}
+
+/* Set all bits for 'hash'. Returns true if they were all already set
+ * (the key was possibly present), like linearBloomHashSet(). */
+DK_INLINE_ALWAYS bool
+linearBloomBlockedHashSet(linearBloomBlocked *restrict bloom,
+                          const uint64_t hash[2]) {
+    uint64_t *block = linearBloomBlockedBlock(bloom, hash);
+
+#if defined(__AVX2__)
+    __m256i mlo, mhi;
+    linearBloomBlockedMasksAVX2(hash, &mlo, &mhi);
+    const __m256i blo = _mm256_load_si256((const __m256i *)block);
+    const __m256i bhi = _mm256_load_si256((const __m256i *)block + 1);
+    const __m256i missing = _mm256_or_si256(_mm256_andnot_si256(blo, mlo),
+                                            _mm256_andnot_si256(bhi, mhi));
+    _mm256_store_si256((__m256i *)block, _mm256_or_si256(blo, mlo));
+    _mm256_store_si256((__m256i *)block + 1, _mm256_or_si256(bhi, mhi));
+    return _mm256_testz_si256(missing, missing);
+#elif defined(__SSE2__)
+    uint64_t masks[LINEARBLOOMBLOCKED_BLOCK_WORDS] __attribute__((aligned(16)));
+    linearBloomBlockedMasks(hash, masks);
+
+    __m128i *b = (__m128i *)block;
+    const __m128i *m = (const __m128i *)masks;
+    __m128i missing = _mm_setzero_si128();
+    for (uint32_t i = 0; i < 4; i++) {
+        const __m128i cur = _mm_load_si128(b + i);
+        const __m128i mask = _mm_load_si128(m + i);
+        missing = _mm_or_si128(missing, _mm_andnot_si128(cur, mask));
+        _mm_store_si128(b + i, _mm_or_si128(cur, mask));
+    }
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(missing, _mm_setzero_si128())) ==
+           0xFFFF;
+#else
+    uint64_t masks[LINEARBLOOMBLOCKED_BLOCK_WORDS];
+    linearBloomBlockedMasks(hash, masks);
+
+    uint64_t missing = 0;
+    for (uint32_t i = 0; i < LINEARBLOOMBLOCKED_BLOCK_WORDS; i++) {
+        missing |= masks[i] & ~block[i];
+        block[i] |= masks[i];
+    }
+
+    return missing == 0;
+#endif
+}
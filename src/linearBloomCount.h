@@ -58,14 +58,21 @@ linearBloomCountReset(linearBloomCount *restrict const bloom) {
     memset(bloom, 0, LINEARBLOOMCOUNT_EXTENT_BYTES);
 }
 
+/* Counter index of every probe for 'hash' */
 DK_INLINE_ALWAYS void
-linearBloomCountHashSet(linearBloomCount *restrict const bloom,
-                        uint64_t hash[2]) {
-    struct {
-        uint_fast32_t bit;
-        uint_fast32_t value;
-    } bitPositions[LINEARBLOOMCOUNT_HASHES];
+linearBloomCountPositions(const uint64_t hash[2],
+                          uint32_t positions[LINEARBLOOMCOUNT_HASHES]) {
+    for (uint32_t i = 0; i < LINEARBLOOMCOUNT_HASHES; i++) {
+        positions[i] =
+            LINEARBLOOMCOUNT_KIRSCHMITZENMACHER(i, hash[0], hash[1]) %
+            LINEARBLOOMCOUNT_EXTENT_ENTRIES;
+    }
+}
 
+DK_INLINE_ALWAYS void linearBloomCountSetPositions(
+    linearBloomCount *restrict const bloom,
+    const uint32_t positions[LINEARBLOOMCOUNT_HASHES]) {
+    uint_fast32_t values[LINEARBLOOMCOUNT_HASHES];
     uint_fast32_t minimumValue = UINT_FAST32_MAX;
 
     /* O(2N) Steps:
@@ -74,38 +81,30 @@ linearBloomCountHashSet(linearBloomCount *restrict const bloom,
 
     /* O(N) */
     for (uint32_t i = 0; i < LINEARBLOOMCOUNT_HASHES; i++) {
-        const uint64_t setBit =
-            LINEARBLOOMCOUNT_KIRSCHMITZENMACHER(i, hash[0], hash[1]) %
-            LINEARBLOOMCOUNT_EXTENT_ENTRIES;
-
         /* Read position */
-        bitPositions[i].bit = setBit;
-        bitPositions[i].value = varintPacked3Get(bloom, setBit);
+        values[i] = varintPacked3Get(bloom, positions[i]);
 
         /* If position has new minimum value, set new minimum */
-        if (bitPositions[i].value < minimumValue) {
-            minimumValue = bitPositions[i].value;
+        if (values[i] < minimumValue) {
+            minimumValue = values[i];
         }
     }
 
     /* O(N) */
     for (uint32_t i = 0; i < LINEARBLOOMCOUNT_HASHES; i++) {
         /* If position is minimum value, increment */
-        if (bitPositions[i].value == minimumValue) {
-            varintPacked3SetIncr(bloom, bitPositions[i].bit, 1);
+        if (values[i] == minimumValue) {
+            varintPacked3SetIncr(bloom, positions[i], 1);
         }
     }
 }
 
-DK_INLINE_ALWAYS uint_fast32_t linearBloomCountHashCheck(
-    const linearBloomCount *restrict const bloom, uint64_t hash[2]) {
+DK_INLINE_ALWAYS uint_fast32_t linearBloomCountCheckPositions(
+    const linearBloomCount *restrict const bloom,
+    const uint32_t positions[LINEARBLOOMCOUNT_HASHES]) {
     uint_fast32_t minimumValue = UINT_FAST32_MAX;
     for (uint32_t i = 0; i < LINEARBLOOMCOUNT_HASHES; i++) {
-        const uint64_t checkBit =
-            LINEARBLOOMCOUNT_KIRSCHMITZENMACHER(i, hash[0], hash[1]) %
-            LINEARBLOOMCOUNT_EXTENT_ENTRIES;
-
-        const uint64_t value = varintPacked3Get(bloom, checkBit);
+        const uint64_t value = varintPacked3Get(bloom, positions[i]);
         if (value < minimumValue) {
             minimumValue = value;
         }
@@ -114,6 +113,82 @@ DK_INLINE_ALWAYS uint_fast32_t linearBloomCountHashCheck(
     return minimumValue;
 }
 
+DK_INLINE_ALWAYS void
+linearBloomCountHashSet(linearBloomCount *restrict const bloom,
+                        uint64_t hash[2]) {
+    uint32_t positions[LINEARBLOOMCOUNT_HASHES];
+    linearBloomCountPositions(hash, positions);
+    linearBloomCountSetPositions(bloom, positions);
+}
+
+DK_INLINE_ALWAYS uint_fast32_t linearBloomCountHashCheck(
+    const linearBloomCount *restrict const bloom, uint64_t hash[2]) {
+    uint32_t positions[LINEARBLOOMCOUNT_HASHES];
+    linearBloomCountPositions(hash, positions);
+    return linearBloomCountCheckPositions(bloom, positions);
+}
+
+/* Batch APIs: probe positions are computed (one modulo each) and their
+ * words prefetched LINEARBLOOMCOUNT_PREFETCH_DISTANCE keys ahead of the key
+ * being resolved; positions are kept in a small ring so each is computed
+ * once. */
+#ifndef LINEARBLOOMCOUNT_PREFETCH_DISTANCE
+#define LINEARBLOOMCOUNT_PREFETCH_DISTANCE 8
+#endif
+
+#define LINEARBLOOMCOUNT_PREFETCH_POSITIONS(bloom, positions, rw)              \
+    do {                                                                       \
+        for (uint32_t _i = 0; _i < LINEARBLOOMCOUNT_HASHES; _i++) {            \
+            __builtin_prefetch(                                                \
+                &(bloom)[((uint64_t)(positions)[_i] * LINEAR_BLOOM_BITS) /     \
+                         (sizeof(linearBloomCount) * 8)],                      \
+                rw);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* Shared pipeline for the batch APIs: 'resolve' runs on key 'i' once the
+ * probes of key 'i + distance' have been prefetched. */
+#define LINEARBLOOMCOUNT_PIPELINE(bloom, hashes, n, rw, resolve)               \
+    do {                                                                       \
+        uint32_t _ring[LINEARBLOOMCOUNT_PREFETCH_DISTANCE]                     \
+                      [LINEARBLOOMCOUNT_HASHES];                               \
+        for (size_t _j = 0;                                                    \
+             _j < (n) && _j < LINEARBLOOMCOUNT_PREFETCH_DISTANCE; _j++) {      \
+            linearBloomCountPositions((hashes)[_j], _ring[_j]);                \
+            LINEARBLOOMCOUNT_PREFETCH_POSITIONS(bloom, _ring[_j], rw);         \
+        }                                                                      \
+                                                                               \
+        for (size_t i = 0; i < (n); i++) {                                     \
+            uint32_t *const positions =                                        \
+                _ring[i % LINEARBLOOMCOUNT_PREFETCH_DISTANCE];                 \
+            resolve;                                                           \
+            if (i + LINEARBLOOMCOUNT_PREFETCH_DISTANCE < (n)) {                \
+                linearBloomCountPositions(                                     \
+                    (hashes)[i + LINEARBLOOMCOUNT_PREFETCH_DISTANCE],          \
+                    positions);                                                \
+                LINEARBLOOMCOUNT_PREFETCH_POSITIONS(bloom, positions, rw);     \
+            }                                                                  \
+        }                                                                      \
+    } while (0)
+
+/* linearBloomCountHashSet() each of 'n' keys in order */
+DK_INLINE_ALWAYS void
+linearBloomCountHashSetMany(linearBloomCount *restrict const bloom,
+                            uint64_t hashes[][2], size_t n) {
+    LINEARBLOOMCOUNT_PIPELINE(bloom, hashes, n, 1,
+                              linearBloomCountSetPositions(bloom, positions));
+}
+
+/* results[i] = linearBloomCountHashCheck(bloom, hashes[i]) */
+DK_INLINE_ALWAYS void
+linearBloomCountHashCheckMany(const linearBloomCount *restrict const bloom,
+                              uint64_t hashes[][2], size_t n,
+                              uint_fast32_t *restrict results) {
+    LINEARBLOOMCOUNT_PIPELINE(
+        bloom, hashes, n, 0,
+        results[i] = linearBloomCountCheckPositions(bloom, positions));
+}
+
 /* SWAR (SIMD Within A Register) optimization for halving 3-bit packed values.
  *
  * 3-bit values are packed continuously across 64-bit words. In each group of
@@ -0,0 +1,512 @@
+#pragma once
+
+#include "linearBloomCount.h"
+
+/* linearBloomCountMin is a Count-Min sketch with conservative update: the
+ * frequency counterpart of linearBloomCount. It uses the same
+ * Kirsch-Mitzenmacher probes from a hash[2] and the same decay interface,
+ * but counters are 32 bits wide and the sketch is 'depth' rows of 'width'
+ * counters chosen at runtime.
+ *
+ * An estimate never undercounts. With width = e / epsilon and
+ * depth = ln(1 / delta) it overcounts by more than epsilon * total with
+ * probability at most delta; conservative update (raise only the counters
+ * at the current minimum) tightens this further in practice.
+ *
+ * linearBloomTopK (below) tracks the k most frequent keys in a stream with
+ * the Space-Saving algorithm, using a sketch to admit and count keys. */
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+#define LINEARBLOOMCOUNTMIN_MAX_DEPTH 16
+
+typedef struct linearBloomCountMin {
+    uint32_t *counters; /* 'depth' rows of 'width' counters, row-major */
+    uint32_t width;
+    uint32_t depth;
+    uint64_t total; /* sum of all counts added, scaled by decay */
+} linearBloomCountMin;
+
+/* Create a sketch of 'depth' rows (1 to LINEARBLOOMCOUNTMIN_MAX_DEPTH)
+ * of 'width' counters each. */
+DK_INLINE_ALWAYS linearBloomCountMin *linearBloomCountMinNew(uint32_t width,
+                                                             uint32_t depth) {
+    if (!width || !depth || depth > LINEARBLOOMCOUNTMIN_MAX_DEPTH) {
+        return NULL;
+    }
+
+    linearBloomCountMin *cms = zcalloc(1, sizeof(*cms));
+    cms->width = width;
+    cms->depth = depth;
+    cms->counters = zcalloc((size_t)width * depth, sizeof(*cms->counters));
+    return cms;
+}
+
+/* Create a sketch overcounting by at most 'epsilon' * total with
+ * probability 1 - 'delta'. */
+DK_INLINE_ALWAYS linearBloomCountMin *
+linearBloomCountMinNewForError(double epsilon, double delta) {
+    const double width = ceil(2.718281828459045 / epsilon);
+    const double depth = ceil(log(1.0 / delta));
+    if (!(width >= 1 && width <= UINT32_MAX) || !(depth >= 1)) {
+        return NULL;
+    }
+
+    return linearBloomCountMinNew((uint32_t)width,
+                                  depth > LINEARBLOOMCOUNTMIN_MAX_DEPTH
+                                      ? LINEARBLOOMCOUNTMIN_MAX_DEPTH
+                                      : (uint32_t)depth);
+}
+
+DK_INLINE_ALWAYS void linearBloomCountMinFree(linearBloomCountMin *cms) {
+    if (cms) {
+        zfree(cms->counters);
+        zfree(cms);
+    }
+}
+
+DK_INLINE_ALWAYS size_t
+linearBloomCountMinEntries(const linearBloomCountMin *cms) {
+    return (size_t)cms->width * cms->depth;
+}
+
+DK_INLINE_ALWAYS size_t
+linearBloomCountMinBytes(const linearBloomCountMin *cms) {
+    return linearBloomCountMinEntries(cms) * sizeof(*cms->counters);
+}
+
+DK_INLINE_ALWAYS void linearBloomCountMinReset(linearBloomCountMin *cms) {
+    memset(cms->counters, 0, linearBloomCountMinBytes(cms));
+    cms->total = 0;
+}
+
+/* Counter index of 'hash' in every row */
+DK_INLINE_ALWAYS void
+linearBloomCountMinPositions(const linearBloomCountMin *cms,
+                             const uint64_t hash[2],
+                             size_t positions[LINEARBLOOMCOUNTMIN_MAX_DEPTH]) {
+    for (uint32_t row = 0; row < cms->depth; row++) {
+        const uint64_t probe =
+            LINEARBLOOMCOUNT_KIRSCHMITZENMACHER(row, hash[0], hash[1]);
+        positions[row] = (size_t)row * cms->width +
+                         (size_t)(((__uint128_t)probe * cms->width) >> 64);
+    }
+}
+
+/* Add 'count' occurrences of 'hash' and return its new estimate.
+ * Conservative update: only counters below the new estimate are raised. */
+DK_INLINE_ALWAYS uint32_t
+linearBloomCountMinHashAdd(linearBloomCountMin *restrict cms,
+                           const uint64_t hash[2], uint32_t count) {
+    size_t positions[LINEARBLOOMCOUNTMIN_MAX_DEPTH];
+    linearBloomCountMinPositions(cms, hash, positions);
+
+    uint32_t minimum = UINT32_MAX;
+    for (uint32_t row = 0; row < cms->depth; row++) {
+        const uint32_t value = cms->counters[positions[row]];
+        minimum = value < minimum ? value : minimum;
+    }
+
+    /* Saturate instead of wrapping */
+    const uint32_t target =
+        minimum > UINT32_MAX - count ? UINT32_MAX : minimum + count;
+    for (uint32_t row = 0; row < cms->depth; row++) {
+        if (cms->counters[positions[row]] < target) {
+            cms->counters[positions[row]] = target;
+        }
+    }
+
+    cms->total += count;
+    return target;
+}
+
+DK_INLINE_ALWAYS uint32_t
+linearBloomCountMinHashEstimate(const linearBloomCountMin *restrict cms,
+                                const uint64_t hash[2]) {
+    size_t positions[LINEARBLOOMCOUNTMIN_MAX_DEPTH];
+    linearBloomCountMinPositions(cms, hash, positions);
+
+    uint32_t minimum = UINT32_MAX;
+    for (uint32_t row = 0; row < cms->depth; row++) {
+        const uint32_t value = cms->counters[positions[row]];
+        minimum = value < minimum ? value : minimum;
+    }
+
+    return minimum;
+}
+
+/* ====================================================================
+ * Decay
+ * ====================================================================
+ * Same interface as linearBloomCount's decay, so one timer can age both
+ * structures. Counters are plain 32-bit lanes, so halving is a vector
+ * shift. */
+DK_INLINE_ALWAYS void
+linearBloomCountMinHalfScalar(linearBloomCountMin *restrict cms) {
+    const size_t entries = linearBloomCountMinEntries(cms);
+    for (size_t i = 0; i < entries; i++) {
+        cms->counters[i] >>= 1;
+    }
+
+    cms->total >>= 1;
+}
+
+DK_INLINE_ALWAYS void
+linearBloomCountMinHalf(linearBloomCountMin *restrict cms) {
+    const size_t entries = linearBloomCountMinEntries(cms);
+    uint32_t *restrict c = cms->counters;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    for (; i + 8 <= entries; i += 8) {
+        const __m256i v = _mm256_loadu_si256((const __m256i *)(c + i));
+        _mm256_storeu_si256((__m256i *)(c + i), _mm256_srli_epi32(v, 1));
+    }
+#elif defined(__SSE2__)
+    for (; i + 4 <= entries; i += 4) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(c + i));
+        _mm_storeu_si128((__m128i *)(c + i), _mm_srli_epi32(v, 1));
+    }
+#elif defined(__aarch64__)
+    for (; i + 4 <= entries; i += 4) {
+        vst1q_u32(c + i, vshrq_n_u32(vld1q_u32(c + i), 1));
+    }
+#endif
+
+    for (; i < entries; i++) {
+        c[i] >>= 1;
+    }
+
+    cms->total >>= 1;
+}
+
+/* new_value = old_value * decay_factor with probabilistic rounding, as
+ * linearBloomCountDecayByFactor(). */
+DK_INLINE_ALWAYS void
+linearBloomCountMinDecayByFactor(linearBloomCountMin *restrict cms,
+                                 double decay_factor, uint64_t rng_seed) {
+    if (decay_factor <= 0.0) {
+        linearBloomCountMinReset(cms);
+        return;
+    }
+
+    if (decay_factor >= 1.0) {
+        return;
+    }
+
+    if (decay_factor == 0.5) {
+        linearBloomCountMinHalf(cms);
+        return;
+    }
+
+    linearBloomCountRNG rng;
+    linearBloomCountRNGInit(&rng, rng_seed);
+
+    const size_t entries = linearBloomCountMinEntries(cms);
+    for (size_t i = 0; i < entries; i++) {
+        const uint32_t old = cms->counters[i];
+        if (old) {
+            const double scaled = old * decay_factor;
+            const uint32_t whole = (uint32_t)scaled;
+            cms->counters[i] =
+                whole + (linearBloomCountRNGDouble(&rng) < scaled - whole);
+        }
+    }
+
+    cms->total = (uint64_t)(cms->total * decay_factor);
+}
+
+/* Time-based exponential decay: values halve every 'half_life_ms'.
+ * Same arguments as linearBloomCountDecay(). */
+DK_INLINE_ALWAYS void
+linearBloomCountMinDecay(linearBloomCountMin *restrict cms,
+                         uint64_t elapsed_ms, uint64_t half_life_ms,
+                         uint64_t rng_seed) {
+    if (elapsed_ms == 0 || half_life_ms == 0) {
+        return;
+    }
+
+    const double ratio = (double)elapsed_ms / (double)half_life_ms;
+    linearBloomCountMinDecayByFactor(cms, exp(-0.693147180559945309 * ratio),
+                                     rng_seed);
+}
+
+/* ====================================================================
+ * linearBloomTopK: Space-Saving heavy hitters
+ * ====================================================================
+ * Keeps the k keys with the highest estimated counts in a min-heap, with
+ * an open-addressed index from key hash to heap position.
+ *
+ * Every offered key is counted in the sketch. A key not yet tracked
+ * replaces the heap minimum only when its sketch estimate exceeds the
+ * minimum's count, so a stream of one-off keys can't flush the heavy
+ * hitters out (plain Space-Saving would replace the minimum every time).
+ * Counts are sketch estimates, so they never undercount. An entry's
+ * 'error' is its estimate from before it was admitted: occurrences not
+ * observed while tracked, and where any overcount it carries came from. */
+
+typedef struct linearBloomTopKEntry {
+    uint64_t hash[2];
+    uint64_t id;     /* caller's identifier, from linearBloomTopKHashOffer() */
+    uint32_t count;  /* sketch estimate; never below the true count */
+    uint32_t error;  /* estimate before admission */
+    uint32_t indexSlot;
+} linearBloomTopKEntry;
+
+typedef struct linearBloomTopK {
+    linearBloomCountMin *cms;
+    linearBloomTopKEntry *heap; /* min-heap on 'count' */
+    uint32_t *index;            /* heap position + 1; 0 is empty */
+    uint32_t indexMask;
+    uint32_t k;
+    uint32_t used;
+} linearBloomTopK;
+
+/* Track the top 'k' keys counted in a 'width' x 'depth' sketch */
+DK_INLINE_ALWAYS linearBloomTopK *linearBloomTopKNew(uint32_t k, uint32_t width,
+                                                     uint32_t depth) {
+    linearBloomCountMin *cms = linearBloomCountMinNew(width, depth);
+    if (!cms || !k || k > (UINT32_MAX >> 2)) {
+        linearBloomCountMinFree(cms);
+        return NULL;
+    }
+
+    /* Index at most half full so probe runs stay short */
+    uint32_t slots = 2;
+    while (slots < 2 * k) {
+        slots <<= 1;
+    }
+
+    linearBloomTopK *topk = zcalloc(1, sizeof(*topk));
+    topk->cms = cms;
+    topk->k = k;
+    topk->heap = zcalloc(k, sizeof(*topk->heap));
+    topk->index = zcalloc(slots, sizeof(*topk->index));
+    topk->indexMask = slots - 1;
+    return topk;
+}
+
+DK_INLINE_ALWAYS void linearBloomTopKFree(linearBloomTopK *topk) {
+    if (topk) {
+        linearBloomCountMinFree(topk->cms);
+        zfree(topk->index);
+        zfree(topk->heap);
+        zfree(topk);
+    }
+}
+
+DK_INLINE_ALWAYS uint32_t linearBloomTopKCount(const linearBloomTopK *topk) {
+    return topk->used;
+}
+
+DK_INLINE_ALWAYS uint32_t
+linearBloomTopKHashEstimate(const linearBloomTopK *topk,
+                            const uint64_t hash[2]) {
+    return linearBloomCountMinHashEstimate(topk->cms, hash);
+}
+
+/* Heap position of 'hash', or UINT32_MAX if untracked */
+DK_INLINE_ALWAYS uint32_t linearBloomTopKFind(const linearBloomTopK *topk,
+                                              const uint64_t hash[2]) {
+    for (uint32_t s = (uint32_t)hash[0] & topk->indexMask;;
+         s = (s + 1) & topk->indexMask) {
+        const uint32_t at = topk->index[s];
+        if (!at) {
+            return UINT32_MAX;
+        }
+
+        const linearBloomTopKEntry *e = &topk->heap[at - 1];
+        if (e->hash[0] == hash[0] && e->hash[1] == hash[1]) {
+            return at - 1;
+        }
+    }
+}
+
+DK_INLINE_ALWAYS void linearBloomTopKIndexInsert(linearBloomTopK *topk,
+                                                 uint32_t pos) {
+    uint32_t s = (uint32_t)topk->heap[pos].hash[0] & topk->indexMask;
+    while (topk->index[s]) {
+        s = (s + 1) & topk->indexMask;
+    }
+
+    topk->index[s] = pos + 1;
+    topk->heap[pos].indexSlot = s;
+}
+
+/* Remove slot 's' with backward-shift deletion (no tombstones) */
+DK_INLINE_ALWAYS void linearBloomTopKIndexRemove(linearBloomTopK *topk,
+                                                 uint32_t s) {
+    const uint32_t mask = topk->indexMask;
+    uint32_t hole = s;
+    for (uint32_t next = (s + 1) & mask; topk->index[next];
+         next = (next + 1) & mask) {
+        linearBloomTopKEntry *e = &topk->heap[topk->index[next] - 1];
+        const uint32_t home = (uint32_t)e->hash[0] & mask;
+
+        /* Move 'next' into the hole unless its home lies after the hole */
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            topk->index[hole] = topk->index[next];
+            e->indexSlot = hole;
+            hole = next;
+        }
+    }
+
+    topk->index[hole] = 0;
+}
+
+DK_INLINE_ALWAYS void linearBloomTopKHeapSwap(linearBloomTopK *topk,
+                                              uint32_t a, uint32_t b) {
+    const linearBloomTopKEntry tmp = topk->heap[a];
+    topk->heap[a] = topk->heap[b];
+    topk->heap[b] = tmp;
+    topk->index[topk->heap[a].indexSlot] = a + 1;
+    topk->index[topk->heap[b].indexSlot] = b + 1;
+}
+
+DK_INLINE_ALWAYS void linearBloomTopKSiftDown(linearBloomTopK *topk,
+                                              uint32_t pos) {
+    for (;;) {
+        const uint32_t left = 2 * pos + 1;
+        const uint32_t right = left + 1;
+        uint32_t smallest = pos;
+        if (left < topk->used &&
+            topk->heap[left].count < topk->heap[smallest].count) {
+            smallest = left;
+        }
+
+        if (right < topk->used &&
+            topk->heap[right].count < topk->heap[smallest].count) {
+            smallest = right;
+        }
+
+        if (smallest == pos) {
+            return;
+        }
+
+        linearBloomTopKHeapSwap(topk, pos, smallest);
+        pos = smallest;
+    }
+}
+
+DK_INLINE_ALWAYS void linearBloomTopKSiftUp(linearBloomTopK *topk,
+                                            uint32_t pos) {
+    while (pos) {
+        const uint32_t parent = (pos - 1) / 2;
+        if (topk->heap[parent].count <= topk->heap[pos].count) {
+            return;
+        }
+
+        linearBloomTopKHeapSwap(topk, pos, parent);
+        pos = parent;
+    }
+}
+
+/* Count 'count' occurrences of 'hash' (identified by 'id').
+ * Returns true if the key is in the top-k after this update. */
+DK_INLINE_ALWAYS bool linearBloomTopKHashOffer(linearBloomTopK *restrict topk,
+                                               const uint64_t hash[2],
+                                               uint64_t id, uint32_t count) {
+    const uint32_t estimate =
+        linearBloomCountMinHashAdd(topk->cms, hash, count);
+
+    const uint32_t pos = linearBloomTopKFind(topk, hash);
+    if (pos != UINT32_MAX) {
+        topk->heap[pos].count = estimate;
+        topk->heap[pos].id = id;
+        linearBloomTopKSiftDown(topk, pos);
+        linearBloomTopKSiftUp(topk, pos);
+        return true;
+    }
+
+    linearBloomTopKEntry *e;
+    if (topk->used < topk->k) {
+        e = &topk->heap[topk->used++];
+    } else if (estimate > topk->heap[0].count) {
+        e = &topk->heap[0];
+        linearBloomTopKIndexRemove(topk, e->indexSlot);
+    } else {
+        return false;
+    }
+
+    const uint32_t at = (uint32_t)(e - topk->heap);
+    e->hash[0] = hash[0];
+    e->hash[1] = hash[1];
+    e->id = id;
+    e->count = estimate;
+    e->error = estimate - count;
+    linearBloomTopKIndexInsert(topk, at);
+
+    if (at) {
+        linearBloomTopKSiftUp(topk, at);
+    } else {
+        linearBloomTopKSiftDown(topk, 0);
+    }
+
+    return true;
+}
+
+DK_INLINE_ALWAYS int linearBloomTopKEntryCompareDesc(const void *a,
+                                                     const void *b) {
+    const uint32_t x = ((const linearBloomTopKEntry *)a)->count;
+    const uint32_t y = ((const linearBloomTopKEntry *)b)->count;
+    return (x < y) - (x > y);
+}
+
+/* Copy up to 'max' tracked entries into 'entries', highest count first.
+ * Returns number of entries copied. */
+DK_INLINE_ALWAYS uint32_t linearBloomTopKList(const linearBloomTopK *topk,
+                                              linearBloomTopKEntry *entries,
+                                              uint32_t max) {
+    linearBloomTopKEntry *sorted = zmalloc(
+        (topk->used ? topk->used : 1) * sizeof(*sorted));
+    memcpy(sorted, topk->heap, topk->used * sizeof(*sorted));
+    qsort(sorted, topk->used, sizeof(*sorted),
+          linearBloomTopKEntryCompareDesc);
+
+    const uint32_t n = topk->used < max ? topk->used : max;
+    memcpy(entries, sorted, n * sizeof(*entries));
+    zfree(sorted);
+    return n;
+}
+
+/* Halve the sketch and every tracked count. Floor halving is monotonic,
+ * so the heap stays ordered. */
+DK_INLINE_ALWAYS void linearBloomTopKHalf(linearBloomTopK *topk) {
+    linearBloomCountMinHalf(topk->cms);
+    for (uint32_t i = 0; i < topk->used; i++) {
+        topk->heap[i].count >>= 1;
+        topk->heap[i].error >>= 1;
+    }
+}
+
+/* Decay the sketch as linearBloomCountMinDecay(), then refresh tracked
+ * counts from it and rebuild the heap. */
+DK_INLINE_ALWAYS void linearBloomTopKDecay(linearBloomTopK *topk,
+                                           uint64_t elapsed_ms,
+                                           uint64_t half_life_ms,
+                                           uint64_t rng_seed) {
+    if (elapsed_ms == 0 || half_life_ms == 0) {
+        return;
+    }
+
+    const double ratio = (double)elapsed_ms / (double)half_life_ms;
+    const double factor = exp(-0.693147180559945309 * ratio);
+    linearBloomCountMinDecayByFactor(topk->cms, factor, rng_seed);
+
+    for (uint32_t i = 0; i < topk->used; i++) {
+        linearBloomTopKEntry *e = &topk->heap[i];
+        e->count = linearBloomCountMinHashEstimate(topk->cms, e->hash);
+        e->error = (uint32_t)(e->error * factor);
+        e->error = e->error > e->count ? e->count : e->error;
+    }
+
+    for (uint32_t i = topk->used / 2; i-- > 0;) {
+        linearBloomTopKSiftDown(topk, i);
+    }
+}
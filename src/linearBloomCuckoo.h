@@ -0,0 +1,357 @@
+#pragma once
+
+#include "datakit.h"
+
+/* linearBloomCuckoo is a bucketized cuckoo filter: approximate membership
+ * with deletes, without the 3-bit counter per slot linearBloomCount needs.
+ *
+ * Each bucket holds four 8-bit or 16-bit fingerprints (one 32-bit or 64-bit
+ * word). A key lives in one of two buckets:
+ *     i1 = hash[0] % buckets
+ *     i2 = i1 ^ scramble(fingerprint(hash[1]))
+ * so an entry can be moved to its other bucket knowing only its fingerprint.
+ * A check compares the fingerprint against all eight slots of both buckets
+ * at once: SWAR over one 64-bit word for 8-bit fingerprints, SSE2 or NEON
+ * over one 128-bit vector for 16-bit fingerprints.
+ *
+ * Inserts are multiset inserts: setting a key twice stores it twice, and it
+ * stays present until deleted twice. Only delete keys that were set.
+ *
+ * Fills to about 95% before inserts start failing. False positive rate is
+ * about 8 / 2^bits: 3% with 8-bit and 0.012% with 16-bit fingerprints. */
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+#define LINEARBLOOMCUCKOO_SLOTS 4 /* fingerprints per bucket */
+
+#ifndef LINEARBLOOMCUCKOO_MAX_KICKS
+#define LINEARBLOOMCUCKOO_MAX_KICKS 500
+#endif
+
+typedef struct linearBloomCuckoo {
+    void *buckets; /* uint32_t (8-bit fingerprints) or uint64_t (16-bit) */
+    uint64_t bucketMask; /* bucket count - 1; bucket count is a power of 2 */
+    uint64_t count;      /* fingerprints stored, including the victim */
+    uint64_t kicks;      /* relocations performed by all inserts */
+    uint64_t rng;        /* picks which slot to evict */
+    uint32_t bits;       /* 8 or 16 */
+    uint32_t fpMask;
+    /* Entry evicted by the last failed insert; checked like a slot */
+    uint64_t victimBucket;
+    uint32_t victimFp;
+    bool victimUsed;
+} linearBloomCuckoo;
+
+typedef struct linearBloomCuckooStats {
+    uint64_t count;
+    uint64_t slots;
+    uint64_t buckets;
+    uint64_t kicks;
+    uint64_t bytes;
+    double loadFactor;
+    bool full; /* an insert failed; further inserts fail until a delete */
+} linearBloomCuckooStats;
+
+/* Create a filter for about 'capacity' keys with 8 or 16 bit fingerprints.
+ * Returns NULL for any other fingerprint width. */
+DK_INLINE_ALWAYS linearBloomCuckoo *linearBloomCuckooNew(uint64_t capacity,
+                                                         uint32_t bits) {
+    if (bits != 8 && bits != 16) {
+        return NULL;
+    }
+
+    /* Round up to a power of two so the alternate bucket is a plain xor */
+    const uint64_t wanted =
+        (uint64_t)((double)capacity / (LINEARBLOOMCUCKOO_SLOTS * 0.95)) + 1;
+    uint64_t buckets = 1;
+    while (buckets < wanted) {
+        buckets <<= 1;
+    }
+
+    linearBloomCuckoo *cuckoo = zcalloc(1, sizeof(*cuckoo));
+    cuckoo->bits = bits;
+    cuckoo->fpMask = (1U << bits) - 1;
+    cuckoo->bucketMask = buckets - 1;
+    cuckoo->rng = 0x9e3779b97f4a7c15ULL;
+    cuckoo->buckets = zcalloc(buckets, LINEARBLOOMCUCKOO_SLOTS * bits / 8);
+    return cuckoo;
+}
+
+DK_INLINE_ALWAYS void linearBloomCuckooFree(linearBloomCuckoo *cuckoo) {
+    if (cuckoo) {
+        zfree(cuckoo->buckets);
+        zfree(cuckoo);
+    }
+}
+
+DK_INLINE_ALWAYS uint64_t
+linearBloomCuckooBytes(const linearBloomCuckoo *cuckoo) {
+    return (cuckoo->bucketMask + 1) * LINEARBLOOMCUCKOO_SLOTS * cuckoo->bits /
+           8;
+}
+
+DK_INLINE_ALWAYS void linearBloomCuckooReset(linearBloomCuckoo *cuckoo) {
+    memset(cuckoo->buckets, 0, linearBloomCuckooBytes(cuckoo));
+    cuckoo->count = 0;
+    cuckoo->kicks = 0;
+    cuckoo->victimUsed = false;
+}
+
+/* ====================================================================
+ * Addressing
+ * ==================================================================== */
+/* Non-zero fingerprint; zero marks an empty slot */
+DK_INLINE_ALWAYS uint32_t
+linearBloomCuckooFingerprint(const linearBloomCuckoo *cuckoo,
+                             const uint64_t hash[2]) {
+    const uint32_t fp = (uint32_t)hash[1] & cuckoo->fpMask;
+    return fp ? fp : 1;
+}
+
+DK_INLINE_ALWAYS uint64_t
+linearBloomCuckooAltBucket(const linearBloomCuckoo *cuckoo, uint64_t bucket,
+                           uint32_t fp) {
+    /* MurmurHash2 multiplier spreads small fingerprints over all bits */
+    return (bucket ^ (fp * 0x5bd1e995ULL)) & cuckoo->bucketMask;
+}
+
+/* Bucket 'bucket' as one word with slot 's' in lane 's' */
+DK_INLINE_ALWAYS uint64_t
+linearBloomCuckooBucketWord(const linearBloomCuckoo *cuckoo, uint64_t bucket) {
+    if (cuckoo->bits == 8) {
+        return ((const uint32_t *)cuckoo->buckets)[bucket];
+    }
+
+    return ((const uint64_t *)cuckoo->buckets)[bucket];
+}
+
+DK_INLINE_ALWAYS void linearBloomCuckooSlotSet(linearBloomCuckoo *cuckoo,
+                                               uint64_t bucket, uint32_t slot,
+                                               uint32_t fp) {
+    const uint64_t at = bucket * LINEARBLOOMCUCKOO_SLOTS + slot;
+    if (cuckoo->bits == 8) {
+        ((uint8_t *)cuckoo->buckets)[at] = (uint8_t)fp;
+    } else {
+        ((uint16_t *)cuckoo->buckets)[at] = (uint16_t)fp;
+    }
+}
+
+DK_INLINE_ALWAYS uint32_t linearBloomCuckooSlotGet(
+    const linearBloomCuckoo *cuckoo, uint64_t bucket, uint32_t slot) {
+    const uint64_t at = bucket * LINEARBLOOMCUCKOO_SLOTS + slot;
+    if (cuckoo->bits == 8) {
+        return ((const uint8_t *)cuckoo->buckets)[at];
+    }
+
+    return ((const uint16_t *)cuckoo->buckets)[at];
+}
+
+/* ====================================================================
+ * Bucket matching
+ * ==================================================================== */
+/* First slot of 'bucket' holding 'fp' (use 0 to find an empty slot), or
+ * LINEARBLOOMCUCKOO_SLOTS if none. SWAR zero-lane test: the lowest flagged
+ * lane is always a true match (borrows only propagate upward). */
+DK_INLINE_ALWAYS uint32_t
+linearBloomCuckooBucketFind(const linearBloomCuckoo *cuckoo, uint64_t bucket,
+                            uint32_t fp) {
+    const uint64_t word = linearBloomCuckooBucketWord(cuckoo, bucket);
+    uint64_t zero;
+    uint32_t laneBits;
+    if (cuckoo->bits == 8) {
+        const uint64_t x = word ^ (fp * 0x01010101ULL);
+        zero = (x - 0x01010101ULL) & ~x & 0x80808080ULL;
+        laneBits = 8;
+    } else {
+        const uint64_t x = word ^ (fp * 0x0001000100010001ULL);
+        zero = (x - 0x0001000100010001ULL) & ~x & 0x8000800080008000ULL;
+        laneBits = 16;
+    }
+
+    return zero ? (uint32_t)__builtin_ctzll(zero) / laneBits
+                : LINEARBLOOMCUCKOO_SLOTS;
+}
+
+/* Reference check; the vector path below must agree with it. */
+DK_INLINE_ALWAYS bool
+linearBloomCuckooMatchScalar(const linearBloomCuckoo *cuckoo, uint64_t i1,
+                             uint64_t i2, uint32_t fp) {
+    for (uint32_t s = 0; s < LINEARBLOOMCUCKOO_SLOTS; s++) {
+        if (linearBloomCuckooSlotGet(cuckoo, i1, s) == fp ||
+            linearBloomCuckooSlotGet(cuckoo, i2, s) == fp) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Does 'fp' appear in any of the eight slots of buckets 'i1' and 'i2'? */
+DK_INLINE_ALWAYS bool linearBloomCuckooMatch(const linearBloomCuckoo *cuckoo,
+                                             uint64_t i1, uint64_t i2,
+                                             uint32_t fp) {
+    if (cuckoo->bits == 8) {
+        /* Both buckets fit in one 64-bit register: 8 byte lanes */
+        const uint32_t *b = cuckoo->buckets;
+        const uint64_t x =
+            (((uint64_t)b[i2] << 32) | b[i1]) ^ (fp * 0x0101010101010101ULL);
+        return ((x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL) != 0;
+    }
+
+    const uint64_t *b = cuckoo->buckets;
+#if defined(__SSE2__)
+    const __m128i lanes = _mm_set_epi64x((int64_t)b[i2], (int64_t)b[i1]);
+    const __m128i eq = _mm_cmpeq_epi16(lanes, _mm_set1_epi16((int16_t)fp));
+    return _mm_movemask_epi8(eq) != 0;
+#elif defined(__aarch64__)
+    const uint16x8_t lanes = vreinterpretq_u16_u64(
+        vcombine_u64(vcreate_u64(b[i1]), vcreate_u64(b[i2])));
+    return vmaxvq_u16(vceqq_u16(lanes, vdupq_n_u16((uint16_t)fp))) != 0;
+#else
+    return linearBloomCuckooBucketFind(cuckoo, i1, fp) !=
+               LINEARBLOOMCUCKOO_SLOTS ||
+           linearBloomCuckooBucketFind(cuckoo, i2, fp) !=
+               LINEARBLOOMCUCKOO_SLOTS;
+#endif
+}
+
+/* ====================================================================
+ * Operations
+ * ==================================================================== */
+DK_INLINE_ALWAYS bool
+linearBloomCuckooHashCheck(const linearBloomCuckoo *restrict cuckoo,
+                           const uint64_t hash[2]) {
+    const uint32_t fp = linearBloomCuckooFingerprint(cuckoo, hash);
+    const uint64_t i1 = hash[0] & cuckoo->bucketMask;
+    const uint64_t i2 = linearBloomCuckooAltBucket(cuckoo, i1, fp);
+
+    if (linearBloomCuckooMatch(cuckoo, i1, i2, fp)) {
+        return true;
+    }
+
+    return cuckoo->victimUsed && cuckoo->victimFp == fp &&
+           (cuckoo->victimBucket == i1 || cuckoo->victimBucket == i2);
+}
+
+/* Place 'fp' in 'bucket' or its alternate, evicting residents as needed.
+ * On failure the last evicted fingerprint becomes the victim, so nothing
+ * previously stored is lost. */
+DK_INLINE_ALWAYS bool linearBloomCuckooPlace(linearBloomCuckoo *cuckoo,
+                                             uint64_t bucket, uint32_t fp) {
+    for (uint32_t kick = 0; kick <= LINEARBLOOMCUCKOO_MAX_KICKS; kick++) {
+        const uint64_t alt = linearBloomCuckooAltBucket(cuckoo, bucket, fp);
+        uint32_t slot = linearBloomCuckooBucketFind(cuckoo, bucket, 0);
+        if (slot == LINEARBLOOMCUCKOO_SLOTS) {
+            slot = linearBloomCuckooBucketFind(cuckoo, alt, 0);
+            if (slot != LINEARBLOOMCUCKOO_SLOTS) {
+                bucket = alt;
+            }
+        }
+
+        if (slot != LINEARBLOOMCUCKOO_SLOTS) {
+            linearBloomCuckooSlotSet(cuckoo, bucket, slot, fp);
+            return true;
+        }
+
+        /* Both full: swap with a random resident of a random candidate */
+        cuckoo->rng ^= cuckoo->rng << 13;
+        cuckoo->rng ^= cuckoo->rng >> 7;
+        cuckoo->rng ^= cuckoo->rng << 17;
+        if (cuckoo->rng & 4) {
+            bucket = alt;
+        }
+
+        slot = cuckoo->rng & (LINEARBLOOMCUCKOO_SLOTS - 1);
+        const uint32_t evicted = linearBloomCuckooSlotGet(cuckoo, bucket, slot);
+        linearBloomCuckooSlotSet(cuckoo, bucket, slot, fp);
+        fp = evicted;
+        bucket = linearBloomCuckooAltBucket(cuckoo, bucket, fp);
+        cuckoo->kicks++;
+    }
+
+    cuckoo->victimBucket = bucket;
+    cuckoo->victimFp = fp;
+    cuckoo->victimUsed = true;
+    return false;
+}
+
+/* Insert 'hash'. Returns false if the filter is full; the key is still
+ * reported present, but further inserts fail until something is deleted. */
+DK_INLINE_ALWAYS bool
+linearBloomCuckooHashSet(linearBloomCuckoo *restrict cuckoo,
+                         const uint64_t hash[2]) {
+    if (cuckoo->victimUsed) {
+        return false;
+    }
+
+    cuckoo->count++;
+    const uint32_t fp = linearBloomCuckooFingerprint(cuckoo, hash);
+    return linearBloomCuckooPlace(cuckoo, hash[0] & cuckoo->bucketMask, fp);
+}
+
+/* Remove one copy of 'hash'. Returns false if it wasn't found. */
+DK_INLINE_ALWAYS bool
+linearBloomCuckooHashDelete(linearBloomCuckoo *restrict cuckoo,
+                            const uint64_t hash[2]) {
+    const uint32_t fp = linearBloomCuckooFingerprint(cuckoo, hash);
+    const uint64_t i1 = hash[0] & cuckoo->bucketMask;
+    const uint64_t i2 = linearBloomCuckooAltBucket(cuckoo, i1, fp);
+
+    uint64_t bucket = i1;
+    uint32_t slot = linearBloomCuckooBucketFind(cuckoo, i1, fp);
+    if (slot == LINEARBLOOMCUCKOO_SLOTS) {
+        bucket = i2;
+        slot = linearBloomCuckooBucketFind(cuckoo, i2, fp);
+    }
+
+    if (slot != LINEARBLOOMCUCKOO_SLOTS) {
+        linearBloomCuckooSlotSet(cuckoo, bucket, slot, 0);
+    } else if (cuckoo->victimUsed && cuckoo->victimFp == fp &&
+               (cuckoo->victimBucket == i1 || cuckoo->victimBucket == i2)) {
+        cuckoo->victimUsed = false;
+        cuckoo->count--;
+        return true;
+    } else {
+        return false;
+    }
+
+    cuckoo->count--;
+
+    /* A slot just opened up: give the victim another chance */
+    if (cuckoo->victimUsed) {
+        cuckoo->victimUsed = false;
+        linearBloomCuckooPlace(cuckoo, cuckoo->victimBucket,
+                               cuckoo->victimFp);
+    }
+
+    return true;
+}
+
+DK_INLINE_ALWAYS uint64_t
+linearBloomCuckooCount(const linearBloomCuckoo *cuckoo) {
+    return cuckoo->count;
+}
+
+DK_INLINE_ALWAYS double
+linearBloomCuckooLoadFactor(const linearBloomCuckoo *cuckoo) {
+    return (double)cuckoo->count /
+           ((cuckoo->bucketMask + 1) * LINEARBLOOMCUCKOO_SLOTS);
+}
+
+DK_INLINE_ALWAYS void
+linearBloomCuckooGetStats(const linearBloomCuckoo *cuckoo,
+                          linearBloomCuckooStats *stats) {
+    stats->count = cuckoo->count;
+    stats->buckets = cuckoo->bucketMask + 1;
+    stats->slots = stats->buckets * LINEARBLOOMCUCKOO_SLOTS;
+    stats->kicks = cuckoo->kicks;
+    stats->bytes = linearBloomCuckooBytes(cuckoo);
+    stats->loadFactor = linearBloomCuckooLoadFactor(cuckoo);
+    stats->full = cuckoo->victimUsed;
+}
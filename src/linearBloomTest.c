@@ -1,6 +1,9 @@
 /* Bloom Filter Tests */
 #include "linearBloom.h"
+#include "linearBloomBlocked.h"
 #include "linearBloomCount.h"
+#include "linearBloomCountMin.h"
+#include "linearBloomCuckoo.h"
 
 #include <inttypes.h>
 #include <math.h>
@@ -256,6 +259,161 @@ int linearBloomTest(int argc, char *argv[]) {
         linearBloomFree(bloom);
     }
 
+    /* ================================================================
+     * linearBloomBlocked tests
+     * ================================================================ */
+
+    TEST("linearBloomBlocked: basic set and check") {
+        linearBloomBlocked *bloom = linearBloomBlockedNew(4096);
+        uint64_t hash[2];
+        hashFromInt(12345, hash);
+
+        if (linearBloomBlockedBytes(bloom) != 4096) {
+            ERR("Expected 4096 bytes, got %" PRIu64,
+                linearBloomBlockedBytes(bloom));
+        }
+
+        if ((uintptr_t)bloom->bits % LINEARBLOOMBLOCKED_BLOCK_BYTES) {
+            ERR("Blocks not cache line aligned: %p", (void *)bloom->bits);
+        }
+
+        if (linearBloomBlockedHashCheck(bloom, hash)) {
+            ERR("Item found in empty blocked bloom filter%s", "");
+        }
+
+        if (linearBloomBlockedHashSet(bloom, hash)) {
+            ERR("linearBloomBlockedHashSet returned true for new item%s", "");
+        }
+
+        if (!linearBloomBlockedHashCheck(bloom, hash)) {
+            ERR("Item not found after set%s", "");
+        }
+
+        if (!linearBloomBlockedHashSet(bloom, hash)) {
+            ERR("linearBloomBlockedHashSet returned false for existing "
+                "item%s",
+                "");
+        }
+
+        /* Exactly one bit per word of one block is set. */
+        size_t bitsSet = 0;
+        for (uint64_t i = 0; i < bloom->blocks * LINEARBLOOMBLOCKED_BLOCK_WORDS;
+             i++) {
+            bitsSet += __builtin_popcountll(bloom->bits[i]);
+        }
+
+        if (bitsSet != LINEARBLOOMBLOCKED_BLOCK_WORDS) {
+            ERR("Expected %zu bits set, got %zu",
+                (size_t)LINEARBLOOMBLOCKED_BLOCK_WORDS, bitsSet);
+        }
+
+        linearBloomBlockedReset(bloom);
+        if (linearBloomBlockedHashCheck(bloom, hash)) {
+            ERR("Item found after reset%s", "");
+        }
+
+        linearBloomBlockedFree(bloom);
+        linearBloomBlockedFree(NULL);
+    }
+
+    TEST("linearBloomBlocked FUZZ: no false negatives, vector matches "
+         "scalar") {
+        /* Odd sizes exercise the non power of two block mapping. */
+        const uint64_t sizes[] = {1, 64, 1000, 12345, 1 << 20};
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+            linearBloomBlocked *bloom = linearBloomBlockedNew(sizes[s]);
+            const size_t numItems = 20000;
+            uint64_t hash[2];
+
+            for (size_t i = 0; i < numItems; i++) {
+                hashFromInt(i, hash);
+                linearBloomBlockedHashSet(bloom, hash);
+            }
+
+            for (size_t i = 0; i < numItems * 2; i++) {
+                hashFromInt(i, hash);
+                const bool vec = linearBloomBlockedHashCheck(bloom, hash);
+                const bool scalar =
+                    linearBloomBlockedHashCheckScalar(bloom, hash);
+                if (vec != scalar) {
+                    ERR("size %" PRIu64 " item %zu: vector %d != scalar %d",
+                        sizes[s], i, vec, scalar);
+                    break;
+                }
+
+                if (i < numItems && !vec) {
+                    ERR("size %" PRIu64 " false negative for item %zu",
+                        sizes[s], i);
+                    break;
+                }
+            }
+
+            linearBloomBlockedFree(bloom);
+        }
+    }
+
+    TEST("linearBloomBlocked: false positive rate and throughput vs "
+         "linearBloom") {
+        /* Same memory as linearBloom, filled to its design capacity. */
+        linearBloom *linear = linearBloomNew();
+        linearBloomBlocked *blocked =
+            linearBloomBlockedNew(LINEARBLOOM_EXTENT_BYTES);
+        const size_t numItems = 430000;
+        const size_t numOps = 10000000;
+        uint64_t hash[2];
+
+        for (size_t i = 0; i < numItems; i++) {
+            hashFromInt(i, hash);
+            linearBloomHashSet(linear, hash);
+            linearBloomBlockedHashSet(blocked, hash);
+        }
+
+        /* Hash up front so the timed loops measure only the filters. */
+        uint64_t (*hashes)[2] = zcalloc(numOps, sizeof(*hashes));
+        for (size_t i = 0; i < numOps; i++) {
+            hashFromInt(numItems + i, hashes[i]);
+        }
+
+        size_t linearFp = 0;
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < numOps; i++) {
+            linearFp += linearBloomHashCheck(linear, hashes[i]);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps,
+                                         "linearBloom check (negative)");
+
+        size_t blockedFp = 0;
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < numOps; i++) {
+            blockedFp += linearBloomBlockedHashCheck(blocked, hashes[i]);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps,
+                                         "linearBloomBlocked check (negative)");
+
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < numOps; i++) {
+            linearBloomBlockedHashSet(blocked, hashes[i]);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps, "linearBloomBlocked set");
+
+        const double linearRate = (double)linearFp / numOps;
+        const double blockedRate = (double)blockedFp / numOps;
+        printf("    False positive rate at %zu items in %" PRIu64
+               " bytes: linearBloom %.4f%%, linearBloomBlocked %.4f%%\n",
+               numItems, (uint64_t)LINEARBLOOM_EXTENT_BYTES, linearRate * 100,
+               blockedRate * 100);
+
+        /* ~19.5 bits per item: expect ~0.03% for the blocked filter. */
+        if (blockedRate > 0.002) {
+            ERR("Blocked false positive rate %.4f%% exceeds 0.2%%",
+                blockedRate * 100);
+        }
+
+        zfree(hashes);
+        linearBloomFree(linear);
+        linearBloomBlockedFree(blocked);
+    }
+
     /* ================================================================
      * linearBloomCount tests
      * ================================================================ */
@@ -2247,6 +2405,638 @@ int linearBloomTest(int argc, char *argv[]) {
         linearBloomCountFree(bloom);
     }
 
+    /* ================================================================
+     * Batched probe tests
+     * ================================================================ */
+
+    TEST("linearBloom: batched set/check match single key operations") {
+        linearBloom *single = linearBloomNew();
+        linearBloom *batched = linearBloomNew();
+        const size_t batchSizes[] = {0, 1, 7, 8, 9, 64, 1000};
+        uint64_t(*hashes)[2] = zcalloc(1000, sizeof(*hashes));
+        bool results[1000];
+        size_t next = 0;
+
+        for (size_t b = 0; b < sizeof(batchSizes) / sizeof(*batchSizes); b++) {
+            const size_t n = batchSizes[b];
+            /* Half of each batch repeats earlier keys. */
+            for (size_t i = 0; i < n; i++) {
+                hashFromInt(i % 2 ? next++ : next / 2, hashes[i]);
+            }
+
+            linearBloomHashSetMany(batched, hashes, n, results);
+            for (size_t i = 0; i < n; i++) {
+                if (linearBloomHashSet(single, hashes[i]) != results[i]) {
+                    ERR("batch %zu key %zu: set result differs", n, i);
+                }
+            }
+
+            if (memcmp(single, batched, LINEARBLOOM_EXTENT_BYTES)) {
+                ERR("batch %zu: filters differ after set", n);
+            }
+
+            /* Check a mix of present and absent keys. */
+            for (size_t i = 0; i < n; i++) {
+                hashFromInt(next + i * (i % 2), hashes[i]);
+            }
+
+            linearBloomHashCheckMany(batched, hashes, n, results);
+            for (size_t i = 0; i < n; i++) {
+                if (linearBloomHashCheck(single, hashes[i]) != results[i]) {
+                    ERR("batch %zu key %zu: check result differs", n, i);
+                }
+            }
+        }
+
+        linearBloomHashSetMany(batched, hashes, 0, NULL);
+        zfree(hashes);
+        linearBloomFree(single);
+        linearBloomFree(batched);
+    }
+
+    TEST("linearBloomCount: batched set/check match single key operations") {
+        linearBloomCount *single = linearBloomCountNew();
+        linearBloomCount *batched = linearBloomCountNew();
+        const size_t batchSizes[] = {0, 1, 7, 8, 9, 64, 1000};
+        uint64_t(*hashes)[2] = zcalloc(1000, sizeof(*hashes));
+        uint_fast32_t results[1000];
+
+        for (size_t b = 0; b < sizeof(batchSizes) / sizeof(*batchSizes); b++) {
+            const size_t n = batchSizes[b];
+            /* Few distinct keys so counters climb and saturate. */
+            for (size_t i = 0; i < n; i++) {
+                hashFromInt(i % 37, hashes[i]);
+            }
+
+            linearBloomCountHashSetMany(batched, hashes, n);
+            for (size_t i = 0; i < n; i++) {
+                linearBloomCountHashSet(single, hashes[i]);
+            }
+
+            if (memcmp(single, batched, LINEARBLOOMCOUNT_EXTENT_BYTES)) {
+                ERR("batch %zu: counting filters differ after set", n);
+            }
+
+            linearBloomCountHashCheckMany(batched, hashes, n, results);
+            for (size_t i = 0; i < n; i++) {
+                if (linearBloomCountHashCheck(single, hashes[i]) !=
+                    results[i]) {
+                    ERR("batch %zu key %zu: count differs", n, i);
+                }
+            }
+        }
+
+        zfree(hashes);
+        linearBloomCountFree(single);
+        linearBloomCountFree(batched);
+    }
+
+    TEST("linearBloom: batched probe performance (64 key batches)") {
+        /* Prefetching pays off once the filter is larger than the cache;
+         * with the default ~1 MB extents both variants mostly hit L2. */
+        const size_t numOps = 4000000;
+        const size_t batch = 64;
+        uint64_t(*hashes)[2] = zcalloc(numOps, sizeof(*hashes));
+        bool results[64];
+        uint_fast32_t counts[64];
+        for (size_t i = 0; i < numOps; i++) {
+            hashFromInt(i, hashes[i]);
+        }
+
+        linearBloom *bloom = linearBloomNew();
+        for (size_t i = 0; i < numOps; i += 8) {
+            linearBloomHashSet(bloom, hashes[i]);
+        }
+
+        size_t foundSingle = 0;
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < numOps; i++) {
+            foundSingle += linearBloomHashCheck(bloom, hashes[i]);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps, "linearBloom check single");
+
+        size_t foundMany = 0;
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < numOps; i += batch) {
+            linearBloomHashCheckMany(bloom, &hashes[i], batch, results);
+            for (size_t j = 0; j < batch; j++) {
+                foundMany += results[j];
+            }
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps, "linearBloom check batched");
+
+        if (foundSingle != foundMany) {
+            ERR("Batched found %zu, single found %zu", foundMany, foundSingle);
+        }
+
+        linearBloomCount *count = linearBloomCountNew();
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < numOps; i++) {
+            linearBloomCountHashSet(count, hashes[i]);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps, "linearBloomCount set single");
+
+        linearBloomCountReset(count);
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < numOps; i += batch) {
+            linearBloomCountHashSetMany(count, &hashes[i], batch);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps,
+                                         "linearBloomCount set batched");
+
+        uint64_t totalSingle = 0;
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < numOps; i++) {
+            totalSingle += linearBloomCountHashCheck(count, hashes[i]);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps,
+                                         "linearBloomCount check single");
+
+        uint64_t totalMany = 0;
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < numOps; i += batch) {
+            linearBloomCountHashCheckMany(count, &hashes[i], batch, counts);
+            for (size_t j = 0; j < batch; j++) {
+                totalMany += counts[j];
+            }
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps,
+                                         "linearBloomCount check batched");
+
+        if (totalSingle != totalMany) {
+            ERR("Batched count total %" PRIu64 ", single %" PRIu64, totalMany,
+                totalSingle);
+        }
+
+        zfree(hashes);
+        linearBloomFree(bloom);
+        linearBloomCountFree(count);
+    }
+
+    /* ================================================================
+     * linearBloomCuckoo tests
+     * ================================================================ */
+
+    TEST("linearBloomCuckoo: basic set, check, and delete") {
+        const uint32_t widths[] = {8, 16};
+        for (size_t w = 0; w < sizeof(widths) / sizeof(*widths); w++) {
+            linearBloomCuckoo *cuckoo = linearBloomCuckooNew(1000, widths[w]);
+            uint64_t hash[2];
+            hashFromInt(12345, hash);
+
+            if (linearBloomCuckooHashCheck(cuckoo, hash)) {
+                ERR("Item found in empty %u-bit cuckoo filter", widths[w]);
+            }
+
+            if (!linearBloomCuckooHashSet(cuckoo, hash) ||
+                !linearBloomCuckooHashCheck(cuckoo, hash)) {
+                ERR("Item not found after set (%u-bit)", widths[w]);
+            }
+
+            /* Multiset: two sets need two deletes */
+            linearBloomCuckooHashSet(cuckoo, hash);
+            if (linearBloomCuckooCount(cuckoo) != 2) {
+                ERR("Expected count 2, got %" PRIu64,
+                    linearBloomCuckooCount(cuckoo));
+            }
+
+            if (!linearBloomCuckooHashDelete(cuckoo, hash) ||
+                !linearBloomCuckooHashCheck(cuckoo, hash)) {
+                ERR("Item lost after first of two deletes (%u-bit)",
+                    widths[w]);
+            }
+
+            if (!linearBloomCuckooHashDelete(cuckoo, hash) ||
+                linearBloomCuckooHashCheck(cuckoo, hash)) {
+                ERR("Item still present after deletes (%u-bit)", widths[w]);
+            }
+
+            if (linearBloomCuckooHashDelete(cuckoo, hash)) {
+                ERR("Deleted item from empty filter (%u-bit)", widths[w]);
+            }
+
+            linearBloomCuckooFree(cuckoo);
+        }
+
+        if (linearBloomCuckooNew(1000, 12)) {
+            ERRR("Accepted 12-bit fingerprints");
+        }
+    }
+
+    TEST("linearBloomCuckoo FUZZ: no false negatives to full load, SIMD "
+         "matches scalar") {
+        const uint32_t widths[] = {8, 16};
+        for (size_t w = 0; w < sizeof(widths) / sizeof(*widths); w++) {
+            const size_t capacity = 100000;
+            linearBloomCuckoo *cuckoo =
+                linearBloomCuckooNew(capacity, widths[w]);
+            linearBloomCuckooStats stats;
+            linearBloomCuckooGetStats(cuckoo, &stats);
+
+            /* Insert until the first failure */
+            size_t inserted = 0;
+            uint64_t hash[2];
+            while (inserted < stats.slots) {
+                hashFromInt(inserted, hash);
+                inserted++;
+                if (!linearBloomCuckooHashSet(cuckoo, hash)) {
+                    break;
+                }
+            }
+
+            linearBloomCuckooGetStats(cuckoo, &stats);
+            printf("    %2u-bit: full at load %.3f after %" PRIu64
+                   " kicks (%zu keys, %" PRIu64 " bytes)\n",
+                   widths[w], stats.loadFactor, stats.kicks, inserted,
+                   stats.bytes);
+            if (!stats.full || stats.loadFactor < 0.9) {
+                ERR("%u-bit filter filled at load %.3f", widths[w],
+                    stats.loadFactor);
+            }
+
+            if (linearBloomCuckooHashSet(cuckoo, hash)) {
+                ERR("Insert into full %u-bit filter succeeded", widths[w]);
+            }
+
+            for (size_t i = 0; i < inserted; i++) {
+                hashFromInt(i, hash);
+                if (!linearBloomCuckooHashCheck(cuckoo, hash)) {
+                    ERR("False negative for %zu (%u-bit)", i, widths[w]);
+                    break;
+                }
+            }
+
+            for (size_t i = 0; i < 200000; i++) {
+                hashFromInt(i + 10000000, hash);
+                const uint32_t fp = linearBloomCuckooFingerprint(cuckoo, hash);
+                const uint64_t i1 = hash[0] & cuckoo->bucketMask;
+                const uint64_t i2 = linearBloomCuckooAltBucket(cuckoo, i1, fp);
+                if (linearBloomCuckooMatch(cuckoo, i1, i2, fp) !=
+                    linearBloomCuckooMatchScalar(cuckoo, i1, i2, fp)) {
+                    ERR("Vector match disagrees with scalar for %zu", i);
+                    break;
+                }
+            }
+
+            /* Deleting half frees room and keeps the other half */
+            for (size_t i = 0; i < inserted; i += 2) {
+                hashFromInt(i, hash);
+                if (!linearBloomCuckooHashDelete(cuckoo, hash)) {
+                    ERR("Delete of %zu failed (%u-bit)", i, widths[w]);
+                    break;
+                }
+            }
+
+            linearBloomCuckooGetStats(cuckoo, &stats);
+            if (stats.full || stats.count != inserted / 2) {
+                ERR("After deletes: full %d count %" PRIu64 " (want %zu)",
+                    stats.full, stats.count, inserted / 2);
+            }
+
+            for (size_t i = 1; i < inserted; i += 2) {
+                hashFromInt(i, hash);
+                if (!linearBloomCuckooHashCheck(cuckoo, hash)) {
+                    ERR("Kept key %zu lost by deletes (%u-bit)", i, widths[w]);
+                    break;
+                }
+            }
+
+            for (size_t i = 1; i < inserted; i += 2) {
+                hashFromInt(i, hash);
+                linearBloomCuckooHashDelete(cuckoo, hash);
+            }
+
+            size_t nonzero = 0;
+            for (uint64_t b = 0; b <= cuckoo->bucketMask; b++) {
+                nonzero += linearBloomCuckooBucketWord(cuckoo, b) != 0;
+            }
+
+            if (nonzero || linearBloomCuckooCount(cuckoo)) {
+                ERR("%zu buckets not empty after deleting everything",
+                    nonzero);
+            }
+
+            linearBloomCuckooFree(cuckoo);
+        }
+    }
+
+    TEST("linearBloomCuckoo: false positive rate and throughput vs "
+         "linearBloomCount") {
+        const size_t items = 400000;
+        const size_t numOps = 4000000;
+        uint64_t(*hashes)[2] = zcalloc(numOps, sizeof(*hashes));
+        for (size_t i = 0; i < numOps; i++) {
+            hashFromInt(i, hashes[i]);
+        }
+
+        const uint32_t widths[] = {8, 16};
+        for (size_t w = 0; w < sizeof(widths) / sizeof(*widths); w++) {
+            linearBloomCuckoo *cuckoo = linearBloomCuckooNew(items, widths[w]);
+            for (size_t i = 0; i < items; i++) {
+                linearBloomCuckooHashSet(cuckoo, hashes[i]);
+            }
+
+            size_t fp = 0;
+            PERF_TIMERS_SETUP;
+            for (size_t i = items; i < numOps; i++) {
+                fp += linearBloomCuckooHashCheck(cuckoo, hashes[i]);
+            }
+            PERF_TIMERS_FINISH_PRINT_RESULTS(numOps - items,
+                                             "linearBloomCuckoo check");
+
+            const double rate = (double)fp / (numOps - items);
+            printf("    %2u-bit: FPP %.4f%% at load %.3f (%" PRIu64
+                   " bytes)\n",
+                   widths[w], rate * 100, linearBloomCuckooLoadFactor(cuckoo),
+                   linearBloomCuckooBytes(cuckoo));
+            if (rate > 8.0 / (1 << widths[w])) {
+                ERR("%u-bit FPP %f above 8/2^bits", widths[w], rate);
+            }
+
+            PERF_TIMERS_SETUP;
+            for (size_t i = 0; i < items; i++) {
+                linearBloomCuckooHashDelete(cuckoo, hashes[i]);
+            }
+            PERF_TIMERS_FINISH_PRINT_RESULTS(items, "linearBloomCuckoo delete");
+
+            linearBloomCuckooFree(cuckoo);
+        }
+
+        linearBloomCount *count = linearBloomCountNew();
+        for (size_t i = 0; i < items; i++) {
+            linearBloomCountHashSet(count, hashes[i]);
+        }
+
+        size_t fp = 0;
+        PERF_TIMERS_SETUP;
+        for (size_t i = items; i < numOps; i++) {
+            fp += linearBloomCountHashCheck(count, hashes[i]) != 0;
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps - items,
+                                         "linearBloomCount check");
+        printf("    FPP %.4f%% (%zu bytes)\n",
+               100.0 * fp / (numOps - items),
+               (size_t)LINEARBLOOMCOUNT_EXTENT_BYTES);
+
+        linearBloomCountFree(count);
+        zfree(hashes);
+    }
+
+    /* ================================================================
+     * linearBloomCountMin / linearBloomTopK tests
+     * ================================================================ */
+
+    TEST("linearBloomCountMin: estimates never undercount, error bound") {
+        /* Zipf-like stream over 100k keys: key ~ exp(u * ln(n)) */
+        const size_t keys = 100000;
+        const size_t events = 2000000;
+        uint32_t *truth = zcalloc(keys, sizeof(*truth));
+        const double epsilon = 0.0005;
+        const double delta = 0.01;
+        linearBloomCountMin *cms =
+            linearBloomCountMinNewForError(epsilon, delta);
+
+        if (!cms || cms->width != 5437 || cms->depth != 5) {
+            ERR("Unexpected geometry %u x %u", cms ? cms->width : 0,
+                cms ? cms->depth : 0);
+        }
+
+        linearBloomCountRNG rng;
+        linearBloomCountRNGInit(&rng, 7);
+        uint64_t hash[2];
+        for (size_t i = 0; i < events; i++) {
+            const size_t key =
+                (size_t)exp(linearBloomCountRNGDouble(&rng) * log(keys));
+            truth[key - 1]++;
+            hashFromInt(key - 1, hash);
+            linearBloomCountMinHashAdd(cms, hash, 1);
+        }
+
+        if (cms->total != events) {
+            ERR("Total %" PRIu64 " != %zu", cms->total, events);
+        }
+
+        size_t under = 0;
+        size_t beyondBound = 0;
+        uint64_t overcount = 0;
+        for (size_t k = 0; k < keys; k++) {
+            hashFromInt(k, hash);
+            const uint32_t estimate =
+                linearBloomCountMinHashEstimate(cms, hash);
+            under += estimate < truth[k];
+            beyondBound += estimate > truth[k] + epsilon * events;
+            overcount += estimate - truth[k];
+        }
+
+        printf("    %zu keys beyond epsilon bound, mean overcount %.3f "
+               "(bound %.0f, %zu bytes)\n",
+               beyondBound, (double)overcount / keys, epsilon * events,
+               linearBloomCountMinBytes(cms));
+        if (under) {
+            ERR("%zu keys undercounted", under);
+        }
+
+        if (beyondBound > delta * keys) {
+            ERR("%zu keys beyond the epsilon bound", beyondBound);
+        }
+
+        linearBloomCountMinFree(cms);
+        zfree(truth);
+
+        if (linearBloomCountMinNew(100, 0) ||
+            linearBloomCountMinNew(100, LINEARBLOOMCOUNTMIN_MAX_DEPTH + 1)) {
+            ERRR("Accepted invalid depth");
+        }
+    }
+
+    TEST("linearBloomCountMin: half matches scalar, decay scales counts") {
+        /* Odd size exercises the vector tail */
+        linearBloomCountMin *a = linearBloomCountMinNew(1001, 3);
+        linearBloomCountMin *b = linearBloomCountMinNew(1001, 3);
+        linearBloomCountRNG rng;
+        linearBloomCountRNGInit(&rng, 3);
+        for (size_t i = 0; i < linearBloomCountMinEntries(a); i++) {
+            a->counters[i] = (uint32_t)linearBloomCountRNGNext(&rng);
+        }
+
+        memcpy(b->counters, a->counters, linearBloomCountMinBytes(a));
+        linearBloomCountMinHalf(a);
+        linearBloomCountMinHalfScalar(b);
+        if (memcmp(a->counters, b->counters, linearBloomCountMinBytes(a))) {
+            ERRR("Vector half differs from scalar half");
+        }
+
+        linearBloomCountMinReset(a);
+        uint64_t hash[2];
+        hashFromInt(42, hash);
+        linearBloomCountMinHashAdd(a, hash, 1001);
+        linearBloomCountMinDecayByFactor(a, 0.5, 0);
+        if (linearBloomCountMinHashEstimate(a, hash) != 500) {
+            ERR("Half of 1001 estimated as %u",
+                linearBloomCountMinHashEstimate(a, hash));
+        }
+
+        /* One half-life of time-based decay halves (within rounding) */
+        linearBloomCountMinReset(a);
+        linearBloomCountMinHashAdd(a, hash, 100000);
+        linearBloomCountMinDecay(a, 30 * 1000, 60 * 1000, 0);
+        const uint32_t decayed = linearBloomCountMinHashEstimate(a, hash);
+        if (decayed < 70709 || decayed > 70712) {
+            ERR("100000 after half a half-life estimated as %u", decayed);
+        }
+
+        linearBloomCountMinFree(b);
+        linearBloomCountMinFree(a);
+    }
+
+    TEST("linearBloomTopK: finds heavy hitters in a skewed stream") {
+        const size_t keys = 100000;
+        const size_t events = 2000000;
+        const uint32_t k = 32;
+        uint32_t *truth = zcalloc(keys, sizeof(*truth));
+        linearBloomTopK *topk = linearBloomTopKNew(k, 8192, 4);
+
+        linearBloomCountRNG rng;
+        linearBloomCountRNGInit(&rng, 11);
+        uint64_t hash[2];
+        for (size_t i = 0; i < events; i++) {
+            const size_t key =
+                (size_t)exp(linearBloomCountRNGDouble(&rng) * log(keys)) - 1;
+            truth[key]++;
+            hashFromInt(key, hash);
+            linearBloomTopKHashOffer(topk, hash, key, 1);
+        }
+
+        linearBloomTopKEntry entries[32];
+        const uint32_t n = linearBloomTopKList(topk, entries, k);
+        if (n != k) {
+            ERR("Listed %u entries, expected %u", n, k);
+        }
+
+        /* The ten most frequent keys are 0..9 by construction */
+        for (uint64_t want = 0; want < 10; want++) {
+            bool found = false;
+            for (uint32_t i = 0; i < n; i++) {
+                found |= entries[i].id == want;
+            }
+
+            if (!found) {
+                ERR("Heavy hitter %" PRIu64 " (count %u) not tracked", want,
+                    truth[want]);
+            }
+        }
+
+        for (uint32_t i = 0; i < n; i++) {
+            if (i && entries[i].count > entries[i - 1].count) {
+                ERR("List not sorted at %u", i);
+            }
+
+            if (entries[i].count < truth[entries[i].id] ||
+                entries[i].error > entries[i].count) {
+                ERR("Key %" PRIu64 ": count %u error %u truth %u",
+                    entries[i].id, entries[i].count, entries[i].error,
+                    truth[entries[i].id]);
+            }
+
+            hashFromInt(entries[i].id, hash);
+            if (linearBloomTopKFind(topk, hash) == UINT32_MAX) {
+                ERR("Index lost key %" PRIu64, entries[i].id);
+            }
+        }
+
+        printf("    top: key %" PRIu64 " count %u (true %u)\n", entries[0].id,
+               entries[0].count, truth[entries[0].id]);
+
+        /* Decay keeps the heap consistent and the leader on top */
+        linearBloomTopKHalf(topk);
+        linearBloomTopKDecay(topk, 60 * 1000, 60 * 1000, 0);
+        linearBloomTopKEntry after[32];
+        linearBloomTopKList(topk, after, k);
+        if (after[0].id != entries[0].id ||
+            after[0].count > entries[0].count / 4 + 1) {
+            ERR("After decay leader %" PRIu64 " count %u", after[0].id,
+                after[0].count);
+        }
+
+        for (uint32_t i = 1; i < topk->used; i++) {
+            if (topk->heap[(i - 1) / 2].count > topk->heap[i].count) {
+                ERR("Heap order broken at %u after decay", i);
+                break;
+            }
+        }
+
+        linearBloomTopKFree(topk);
+        zfree(truth);
+    }
+
+    TEST("linearBloomTopK FUZZ: index survives churn") {
+        /* k = 8 with a flat stream forces constant replacement */
+        linearBloomTopK *topk = linearBloomTopKNew(8, 64, 2);
+        uint64_t hash[2];
+        for (size_t i = 0; i < 200000; i++) {
+            const uint64_t key = (i * 2654435761ULL) % 97;
+            hashFromInt(key, hash);
+            linearBloomTopKHashOffer(topk, hash, key, 1 + (i % 3));
+            if (i % 1000 == 0) {
+                for (uint32_t j = 0; j < topk->used; j++) {
+                    if (linearBloomTopKFind(topk, topk->heap[j].hash) != j) {
+                        ERR("Entry %u not found at its heap position", j);
+                        i = SIZE_MAX - 1;
+                        break;
+                    }
+                }
+            }
+        }
+
+        linearBloomTopKFree(topk);
+    }
+
+    TEST("linearBloomCountMin: add and estimate throughput") {
+        const size_t numOps = 4000000;
+        uint64_t(*hashes)[2] = zcalloc(numOps, sizeof(*hashes));
+        for (size_t i = 0; i < numOps; i++) {
+            hashFromInt(i % 100000, hashes[i]);
+        }
+
+        linearBloomCountMin *cms = linearBloomCountMinNew(1 << 16, 4);
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < numOps; i++) {
+            linearBloomCountMinHashAdd(cms, hashes[i], 1);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps, "linearBloomCountMin add");
+
+        uint64_t sum = 0;
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < numOps; i++) {
+            sum += linearBloomCountMinHashEstimate(cms, hashes[i]);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps,
+                                         "linearBloomCountMin estimate");
+
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < 100; i++) {
+            linearBloomCountMinHalf(cms);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(100, "linearBloomCountMin half");
+
+        linearBloomTopK *topk = linearBloomTopKNew(100, 1 << 16, 4);
+        PERF_TIMERS_SETUP;
+        for (size_t i = 0; i < numOps; i++) {
+            linearBloomTopKHashOffer(topk, hashes[i], i, 1);
+        }
+        PERF_TIMERS_FINISH_PRINT_RESULTS(numOps, "linearBloomTopK offer");
+
+        if (!sum) {
+            ERRR("Estimates all zero");
+        }
+
+        linearBloomTopKFree(topk);
+        linearBloomCountMinFree(cms);
+        zfree(hashes);
+    }
+
     TEST_FINAL_RESULT;
+
+
 }
 #endif
@@ -165,6 +165,11 @@ bool mflexIsCompressed(const mflex *m) {
     return _mflexType(m) == MFLEX_TYPE_CFLEX;
 }
 
+/* Returns true if 'm' is compressed or may be compressed on its next close. */
+bool mflexAllowsCompression(const mflex *m) {
+    return _mflexType(m) != MFLEX_TYPE_NO_COMPRESS;
+}
+
 void mflexFree(mflex *m) {
     /* just drop the whole block of memory.
      * don't need to bother with any compression semantics here. */
@@ -486,6 +491,15 @@ void mflexSetCompressAuto(mflex **mm, mflexState *state) {
     mflexCloseGrow(mm, state, f);
 }
 
+/* Allow compression of '*mm' without compressing it now; contents stay
+ * directly readable until a later mflexSetCompressAuto() or growing
+ * close compresses them. */
+void mflexSetCompressDeferred(mflex **mm) {
+    if (_mflexType(*mm) == MFLEX_TYPE_NO_COMPRESS) {
+        *mm = _MFLEX_RETAG(*mm, MFLEX_TYPE_FLEX);
+    }
+}
+
 mflex *mflexConvertFromFlex(flex *f, mflexState *state) {
     mflex *m = (mflex *)f;
     mflexSetCompressAuto(&m, state);
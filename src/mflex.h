@@ -30,6 +30,7 @@ size_t mflexBytesUncompressed(const mflex *m);
 size_t mflexBytesCompressed(const mflex *m);
 size_t mflexBytesActual(const mflex *m);
 bool mflexIsCompressed(const mflex *m);
+bool mflexAllowsCompression(const mflex *m);
 
 /* mflex clear / free */
 void mflexReset(mflex **mm);
@@ -67,6 +68,7 @@ void mflexCloseNoCompress(mflex **mm, mflexState *state, const flex *f);
 /* mflex type options */
 void mflexSetCompressNever(mflex **mm, mflexState *state);
 void mflexSetCompressAuto(mflex **mm, mflexState *state);
+void mflexSetCompressDeferred(mflex **mm);
 
 #ifdef DATAKIT_TEST
 int mflexTest(int argc, char *argv[]);
@@ -65,55 +65,51 @@ multiFenwick *multiFenwickNewFromArray(const databox *values, size_t count) {
         capacity <<= 1;
     }
 
-    /* Pre-populate multilist with zero values up to capacity */
-    databox zero = databoxZeroLike(&values[0]);
+    /* Build BIT values in a flat scratch array first: each node starts as
+     * its own value and, visited in index order, pushes its finished range
+     * sum into its parent once. Time: O(n), then one tail push per node
+     * instead of an index + replace for every O(log n) update step. */
+    const databox zero = databoxZeroLike(&values[0]);
+    databox *nodes = zmalloc(capacity * sizeof(*nodes));
     for (uint64_t i = 0; i < capacity; i++) {
-        multilistPushByTypeTail(&mfw->tree, mfw->state, &zero);
-    }
-
-    mfw->count = count;
-    mfw->capacity = capacity;
-
-    /* Build BIT by applying updates for each value
-     * Time: O(n log n) */
-    for (uint64_t i = 0; i < count; i++) {
-        if (DATABOX_IS_VOID(&values[i])) {
+        nodes[i] = zero;
+        if (i >= count || DATABOX_IS_VOID(&values[i])) {
             continue; /* Skip zero/void values */
         }
 
-        /* Check if value is zero - optimization */
         databox zeroCheck = databoxZeroLike(&values[i]);
         if (databoxCompareNumeric(&values[i], &zeroCheck) == 0) {
             continue;
         }
 
-        /* Update: add value to position i (0-based external, 1-based internal)
-         */
-        uint64_t idx = i + 1; /* Convert to 1-based */
-        while (idx <= capacity) {
-            /* Get current value at BIT position idx */
-            multilistEntry entry;
-            if (multilistIndex(mfw->tree, mfw->state, idx - 1, &entry, true)) {
-                /* Add values[i] to current BIT value */
-                databox newVal;
-                if (!databoxAdd(&entry.box, &values[i], &newVal)) {
-                    /* Type mismatch or error */
-                    multiFenwickFree(mfw);
-                    return NULL;
-                }
-
-                /* Update the multilist entry */
-                if (!multilistReplaceByTypeAtIndex(&mfw->tree, mfw->state,
-                                                   idx - 1, &newVal)) {
-                    multiFenwickFree(mfw);
-                    return NULL;
-                }
-            }
+        if (!databoxAdd(&zero, &values[i], &nodes[i])) {
+            /* Type mismatch or error */
+            zfree(nodes);
+            multiFenwickFree(mfw);
+            return NULL;
+        }
+    }
 
-            idx = multiFenwickParent(idx);
+    for (uint64_t idx = 1; idx <= capacity; idx++) {
+        const uint64_t parent = multiFenwickParent(idx);
+        if (parent <= capacity &&
+            !databoxAdd(&nodes[parent - 1], &nodes[idx - 1],
+                        &nodes[parent - 1])) {
+            zfree(nodes);
+            multiFenwickFree(mfw);
+            return NULL;
         }
     }
 
+    for (uint64_t i = 0; i < capacity; i++) {
+        multilistPushByTypeTail(&mfw->tree, mfw->state, &nodes[i]);
+    }
+
+    zfree(nodes);
+
+    mfw->count = count;
+    mfw->capacity = capacity;
+
     return mfw;
 }
 
@@ -428,6 +428,93 @@ bool multiOrderedSetLast(const multiOrderedSet *mos, databox *member,
     MOS_RETURN(mos, Last, member, score);
 }
 
+/* ====================================================================
+ * Bounded Top-K
+ * ==================================================================== */
+
+struct multiOrderedSetTopK {
+    multiOrderedSet *set;
+    size_t capacity;
+    databox minScore; /* lowest score on the board; valid once full */
+    uint64_t evictions;
+    uint64_t rejections;
+};
+
+multiOrderedSetTopK *multiOrderedSetTopKNew(size_t capacity) {
+    multiOrderedSetTopK *topk = zcalloc(1, sizeof(*topk));
+    topk->set = multiOrderedSetNew();
+    topk->capacity = capacity;
+    return topk;
+}
+
+void multiOrderedSetTopKFree(multiOrderedSetTopK *topk) {
+    if (topk) {
+        multiOrderedSetFree(topk->set);
+        zfree(topk);
+    }
+}
+
+bool multiOrderedSetTopKAdd(multiOrderedSetTopK *topk, const databox *score,
+                            const databox *member) {
+    if (topk->capacity == 0) {
+        topk->rejections++;
+        return false;
+    }
+
+    const bool full = multiOrderedSetCount(topk->set) >= topk->capacity;
+
+    /* Fast path: below the cached minimum can't displace anything. Only a
+     * member already on the board still needs its score updated. */
+    if (full && databoxCompare(score, &topk->minScore) < 0 &&
+        !multiOrderedSetExists(topk->set, member)) {
+        topk->rejections++;
+        return false;
+    }
+
+    const bool existed = multiOrderedSetAdd(&topk->set, score, member);
+    bool kept = true;
+
+    if (!existed && full) {
+        /* Over capacity by one: evict the minimum. Compare before popping
+         * since popped member bytes don't outlive the removal. */
+        databox minMember;
+        databox minScore;
+        multiOrderedSetFirst(topk->set, &minMember, &minScore);
+        if (databoxCompare(&minMember, member) == 0) {
+            /* Tied the minimum score but sorts below it */
+            kept = false;
+            topk->rejections++;
+        } else {
+            topk->evictions++;
+        }
+
+        multiOrderedSetPopMin(&topk->set, 1, &minMember, &minScore);
+    }
+
+    if (multiOrderedSetCount(topk->set) >= topk->capacity) {
+        databox minMember;
+        multiOrderedSetFirst(topk->set, &minMember, &topk->minScore);
+    }
+
+    return kept;
+}
+
+const multiOrderedSet *multiOrderedSetTopKSet(const multiOrderedSetTopK *topk) {
+    return topk->set;
+}
+
+size_t multiOrderedSetTopKCapacity(const multiOrderedSetTopK *topk) {
+    return topk->capacity;
+}
+
+uint64_t multiOrderedSetTopKEvictions(const multiOrderedSetTopK *topk) {
+    return topk->evictions;
+}
+
+uint64_t multiOrderedSetTopKRejections(const multiOrderedSetTopK *topk) {
+    return topk->rejections;
+}
+
 /* ====================================================================
  * Random Access
  * ==================================================================== */
@@ -468,103 +555,211 @@ static void applyAggregate(databox *result, const databox *a, const databox *b,
     DATABOX_SET_DOUBLE(result, combined);
 }
 
-multiOrderedSet *multiOrderedSetUnion(const multiOrderedSet *sets[],
-                                      const double *weights, size_t numSets,
-                                      mosAggregate aggregate) {
-    if (numSets == 0) {
-        return multiOrderedSetNew();
+/* Results with at least this many entries skip per-entry inserts and get
+ * their Full tier sub-maps bulk-built from the sorted entries. Smaller
+ * results are inserted normally so they land in the Small/Medium tiers. */
+#define MOS_STORE_BULK_MIN_ENTRIES 256
+
+static int mosEntrySortCompare(const void *a, const void *b) {
+    const mosEntry *ea = a;
+    const mosEntry *eb = b;
+    return mosCompareEntries(&ea->score, &ea->member, &eb->score, &eb->member);
+}
+
+/* Sort unique-member 'entries' once and build a set from them, keeping the
+ * compression settings of 'like' (or the multiOrderedSetNew() defaults). */
+static multiOrderedSet *mosBuildFromEntries(mosEntry *entries, size_t count,
+                                            const multiOrderedSet *like) {
+    const uint32_t depth = like ? COMPRESS_DEPTH(like) : 0;
+    const uint32_t limit = like ? COMPRESS_LIMIT(like) : FLEX_CAP_LEVEL_2048;
+
+    if (count > 1) {
+        qsort(entries, count, sizeof(*entries), mosEntrySortCompare);
     }
 
-    multiOrderedSet *result = multiOrderedSetNew();
+    multiOrderedSet *result;
+    if (count >= MOS_STORE_BULK_MIN_ENTRIES) {
+        multiOrderedSetFull *full =
+            multiOrderedSetFullNewFromSorted(entries, count);
+        result = MOS_TAG_(full, MOS_TYPE_FULL);
+        result = SET_COMPRESS_DEPTH_LIMIT(result, depth, limit);
+    } else {
+        result = multiOrderedSetNew();
+        result = SET_COMPRESS_DEPTH_LIMIT(result, depth, limit);
+        for (size_t i = 0; i < count; i++) {
+            multiOrderedSetAdd(&result, &entries[i].score, &entries[i].member);
+        }
+    }
+
+    return result;
+}
+
+/* Replace *dst with 'result'; *dst may be one of the inputs, so this only
+ * happens after the result is fully built. */
+static void mosStoreResult(multiOrderedSet **dst, multiOrderedSet *result) {
+    multiOrderedSetFree(*dst);
+    *dst = result;
+}
+
+size_t multiOrderedSetUnionStore(multiOrderedSet **dst,
+                                 const multiOrderedSet *sets[],
+                                 const double *weights, size_t numSets,
+                                 mosAggregate aggregate) {
+    /* Aggregate member → weighted score in a hash instead of a sorted set */
+    multidictClass *qdc = multidictDefaultClassNew();
+    multidict *scores = multidictNew(&multidictTypeExactKey, qdc, 0);
 
     for (size_t i = 0; i < numSets; i++) {
         if (!sets[i]) {
             continue;
         }
 
-        double weight = weights ? weights[i] : 1.0;
+        const double weight = weights ? weights[i] : 1.0;
 
         mosIterator iter;
         multiOrderedSetIteratorInit(sets[i], &iter, true);
 
         databox member, score;
         while (multiOrderedSetIteratorNext(&iter, &member, &score)) {
-            /* Check if member already exists in result */
+            databox combined;
             databox existingScore;
-            if (multiOrderedSetGetScore(result, &member, &existingScore)) {
-                /* Combine scores using aggregate */
-                databox newScore;
-                applyAggregate(&newScore, &existingScore, &score, 1.0, weight,
+            if (multidictFind(scores, &member, &existingScore)) {
+                applyAggregate(&combined, &existingScore, &score, 1.0, weight,
                                aggregate);
-                multiOrderedSetAdd(&result, &newScore, &member);
             } else {
-                /* New member, add with weighted score */
-                databox weightedScore;
-                double val = mosDataboxToDouble(&score) * weight;
-                DATABOX_SET_DOUBLE(&weightedScore, val);
-                multiOrderedSetAdd(&result, &weightedScore, &member);
+                DATABOX_SET_DOUBLE(&combined,
+                                   mosDataboxToDouble(&score) * weight);
             }
+
+            multidictAdd(scores, &member, &combined);
         }
     }
 
-    return result;
-}
-
-multiOrderedSet *multiOrderedSetIntersect(const multiOrderedSet *sets[],
-                                          const double *weights, size_t numSets,
-                                          mosAggregate aggregate) {
-    if (numSets < 2) {
-        return multiOrderedSetNew();
+    /* Entries point at keys owned by 'scores' until the build is done */
+    const size_t total = multidictCount(scores);
+    mosEntry *entries = zmalloc(sizeof(*entries) * (total ? total : 1));
+    size_t count = 0;
+
+    multidictIterator iter;
+    multidictIteratorInit(scores, &iter);
+    multidictEntry entry;
+    while (count < total && multidictIteratorNext(&iter, &entry)) {
+        entries[count].score = entry.val;
+        entries[count].member = entry.key;
+        count++;
     }
+    multidictIteratorRelease(&iter);
+
+    multiOrderedSet *result = mosBuildFromEntries(entries, count, *dst);
+
+    zfree(entries);
+    multidictFree(scores);
+    multidictDefaultClassFree(qdc);
+
+    mosStoreResult(dst, result);
+    return count;
+}
 
-    /* Start with smallest set for efficiency */
+size_t multiOrderedSetIntersectStore(multiOrderedSet **dst,
+                                     const multiOrderedSet *sets[],
+                                     const double *weights, size_t numSets,
+                                     mosAggregate aggregate) {
+    /* Any missing input makes the intersection empty */
     size_t smallestIdx = 0;
-    size_t smallestCount = multiOrderedSetCount(sets[0]);
-    for (size_t i = 1; i < numSets; i++) {
-        size_t count = multiOrderedSetCount(sets[i]);
+    size_t smallestCount = SIZE_MAX;
+    for (size_t i = 0; i < numSets; i++) {
+        const size_t count = sets[i] ? multiOrderedSetCount(sets[i]) : 0;
         if (count < smallestCount) {
             smallestCount = count;
             smallestIdx = i;
         }
     }
 
-    multiOrderedSet *result = multiOrderedSetNew();
+    if (numSets == 0 || smallestCount == 0) {
+        mosStoreResult(dst, mosBuildFromEntries(NULL, 0, *dst));
+        return 0;
+    }
+
+    /* Candidates are the smallest set's members; they reference that set's
+     * storage, which outlives the build even if it's also *dst. */
+    mosEntry *entries = zmalloc(sizeof(*entries) * smallestCount);
+    size_t count = 0;
+    const double weight0 = weights ? weights[smallestIdx] : 1.0;
 
-    /* Iterate through smallest set */
     mosIterator iter;
     multiOrderedSetIteratorInit(sets[smallestIdx], &iter, true);
-
     databox member, score;
-    while (multiOrderedSetIteratorNext(&iter, &member, &score)) {
-        bool inAll = true;
-        databox combinedScore = score;
-        double weight0 = weights ? weights[smallestIdx] : 1.0;
-
-        /* Apply weight to initial score */
-        double val = mosDataboxToDouble(&combinedScore) * weight0;
-        DATABOX_SET_DOUBLE(&combinedScore, val);
-
-        /* Check if member exists in all other sets */
-        for (size_t i = 0; i < numSets && inAll; i++) {
-            if (i == smallestIdx) {
-                continue;
+    while (count < smallestCount &&
+           multiOrderedSetIteratorNext(&iter, &member, &score)) {
+        DATABOX_SET_DOUBLE(&entries[count].score,
+                           mosDataboxToDouble(&score) * weight0);
+        entries[count].member = member;
+        count++;
+    }
+
+    for (size_t i = 0; i < numSets && count > 0; i++) {
+        if (i == smallestIdx) {
+            continue;
+        }
+
+        /* Probe through a member hash: Full already keeps one in
+         * memberIndex; Small/Medium only have score-ordered flex, so hash
+         * their members once instead of scanning per candidate. */
+        multidictClass *tmpClass = NULL;
+        multidict *index;
+        if (mosType_(sets[i]) == MOS_TYPE_FULL) {
+            index = mosf(sets[i])->memberIndex;
+        } else {
+            tmpClass = multidictDefaultClassNew();
+            index = multidictNew(&multidictTypeExactKey, tmpClass, 0);
+            multiOrderedSetIteratorInit(sets[i], &iter, true);
+            while (multiOrderedSetIteratorNext(&iter, &member, &score)) {
+                multidictAdd(index, &member, &score);
             }
+        }
 
+        const double weight = weights ? weights[i] : 1.0;
+        size_t kept = 0;
+        for (size_t c = 0; c < count; c++) {
             databox otherScore;
-            if (multiOrderedSetGetScore(sets[i], &member, &otherScore)) {
-                double weight = weights ? weights[i] : 1.0;
-                applyAggregate(&combinedScore, &combinedScore, &otherScore, 1.0,
-                               weight, aggregate);
-            } else {
-                inAll = false;
+            if (multidictFind(index, &entries[c].member, &otherScore)) {
+                applyAggregate(&entries[c].score, &entries[c].score,
+                               &otherScore, 1.0, weight, aggregate);
+                entries[kept++] = entries[c];
             }
         }
+        count = kept;
 
-        if (inAll) {
-            multiOrderedSetAdd(&result, &combinedScore, &member);
+        if (tmpClass) {
+            multidictFree(index);
+            multidictDefaultClassFree(tmpClass);
         }
     }
 
+    multiOrderedSet *result = mosBuildFromEntries(entries, count, *dst);
+    zfree(entries);
+
+    mosStoreResult(dst, result);
+    return count;
+}
+
+multiOrderedSet *multiOrderedSetUnion(const multiOrderedSet *sets[],
+                                      const double *weights, size_t numSets,
+                                      mosAggregate aggregate) {
+    multiOrderedSet *result = NULL;
+    multiOrderedSetUnionStore(&result, sets, weights, numSets, aggregate);
+    return result;
+}
+
+multiOrderedSet *multiOrderedSetIntersect(const multiOrderedSet *sets[],
+                                          const double *weights, size_t numSets,
+                                          mosAggregate aggregate) {
+    if (numSets < 2) {
+        return multiOrderedSetNew();
+    }
+
+    multiOrderedSet *result = NULL;
+    multiOrderedSetIntersectStore(&result, sets, weights, numSets, aggregate);
     return result;
 }
 
@@ -1002,6 +1197,210 @@ int multiOrderedSetTest(int argc, char *argv[]) {
         multiOrderedSetFree(result);
     }
 
+    TEST("multiOrderedSet: weighted union/intersect store") {
+        /* a: Full tier, i -> i; b: Full tier, even i -> i + 0.5;
+         * c: Small tier, multiples of 3 below 100 -> 100 - i */
+        multiOrderedSet *a = multiOrderedSetNew();
+        multiOrderedSet *b = multiOrderedSetNew();
+        multiOrderedSet *c = multiOrderedSetNew();
+
+        databox score, member;
+        char buf[16];
+        for (int i = 0; i < 4000; i++) {
+            int len = snprintf(buf, sizeof(buf), "u%d", i);
+            member = databoxNewBytes(buf, len);
+            if (i < 2000) {
+                DATABOX_SET_DOUBLE(&score, (double)i);
+                multiOrderedSetAdd(&a, &score, &member);
+            }
+
+            if (i % 2 == 0) {
+                DATABOX_SET_DOUBLE(&score, (double)i + 0.5);
+                multiOrderedSetAdd(&b, &score, &member);
+            }
+
+            if (i < 100 && i % 3 == 0) {
+                DATABOX_SET_DOUBLE(&score, 100.0 - i);
+                multiOrderedSetAdd(&c, &score, &member);
+            }
+        }
+
+        assert(mosType_(a) == MOS_TYPE_FULL);
+        assert(mosType_(b) == MOS_TYPE_FULL);
+        assert(mosType_(c) != MOS_TYPE_FULL);
+
+        const multiOrderedSet *sets[] = {a, b, c};
+        const double weights[] = {2.0, -1.0, 3.0};
+
+        /* SUM union matches per-member IncrBy aggregation */
+        multiOrderedSet *reference = multiOrderedSetNew();
+        for (size_t s = 0; s < 3; s++) {
+            mosIterator iter;
+            multiOrderedSetIteratorInit(sets[s], &iter, true);
+            while (multiOrderedSetIteratorNext(&iter, &member, &score)) {
+                databox delta, result;
+                DATABOX_SET_DOUBLE(&delta,
+                                   mosDataboxToDouble(&score) * weights[s]);
+                multiOrderedSetIncrBy(&reference, &delta, &member, &result);
+            }
+        }
+
+        multiOrderedSet *unioned = NULL;
+        size_t stored = multiOrderedSetUnionStore(&unioned, sets, weights, 3,
+                                                  MOS_AGGREGATE_SUM);
+        assert(stored == multiOrderedSetCount(reference));
+        assert(stored == multiOrderedSetCount(unioned));
+        assert(mosType_(unioned) == MOS_TYPE_FULL);
+
+        {
+            mosIterator iter;
+            multiOrderedSetIteratorInit(unioned, &iter, true);
+            int64_t rank = 0;
+            databox prevScore = {{0}};
+            while (multiOrderedSetIteratorNext(&iter, &member, &score)) {
+                databox expected;
+                assert(multiOrderedSetGetScore(reference, &member, &expected));
+                assert(mosDataboxToDouble(&expected) ==
+                       mosDataboxToDouble(&score));
+                assert(rank == 0 || databoxCompare(&prevScore, &score) <= 0);
+                if (rank % 61 == 0) {
+                    assert(multiOrderedSetGetRank(unioned, &member) == rank);
+                }
+                prevScore = score;
+                rank++;
+            }
+            assert((size_t)rank == stored);
+        }
+
+        /* Bulk-built result keeps working as a normal set */
+        DATABOX_SET_DOUBLE(&score, -1e9);
+        member = databoxNewBytes("newcomer", 8);
+        multiOrderedSetAdd(&unioned, &score, &member);
+        assert(multiOrderedSetGetRank(unioned, &member) == 0);
+
+        /* MIN intersection: only multiples of 6 below 100 are in all three */
+        multiOrderedSet *intersected = NULL;
+        stored = multiOrderedSetIntersectStore(&intersected, sets, weights, 3,
+                                               MOS_AGGREGATE_MIN);
+        assert(stored == 17);
+        for (int i = 0; i < 100; i += 6) {
+            int len = snprintf(buf, sizeof(buf), "u%d", i);
+            member = databoxNewBytes(buf, len);
+            double expect = 2.0 * i;
+            if (-1.0 * (i + 0.5) < expect) {
+                expect = -1.0 * (i + 0.5);
+            }
+            if (3.0 * (100 - i) < expect) {
+                expect = 3.0 * (100 - i);
+            }
+            databox got;
+            assert(multiOrderedSetGetScore(intersected, &member, &got));
+            assert(mosDataboxToDouble(&got) == expect);
+        }
+
+        /* MAX intersection of the two Full sets uses their memberIndex */
+        const multiOrderedSet *fullSets[] = {a, b};
+        stored = multiOrderedSetIntersectStore(&intersected, fullSets, NULL, 2,
+                                               MOS_AGGREGATE_MAX);
+        assert(stored == 1000);
+        member = databoxNewBytes("u10", 3);
+        databox got;
+        assert(multiOrderedSetGetScore(intersected, &member, &got));
+        assert(mosDataboxToDouble(&got) == 10.5);
+
+        /* Destination may also be an input */
+        const multiOrderedSet *selfSets[] = {a, c};
+        stored = multiOrderedSetUnionStore(&a, selfSets, NULL, 2,
+                                           MOS_AGGREGATE_MAX);
+        assert(stored == 2000);
+        assert(multiOrderedSetCount(a) == 2000);
+        member = databoxNewBytes("u3", 2);
+        assert(multiOrderedSetGetScore(a, &member, &got));
+        assert(mosDataboxToDouble(&got) == 97.0);
+
+        /* A NULL input empties an intersection */
+        const multiOrderedSet *withNull[] = {b, NULL};
+        stored = multiOrderedSetIntersectStore(&intersected, withNull, NULL, 2,
+                                               MOS_AGGREGATE_SUM);
+        assert(stored == 0);
+        assert(multiOrderedSetCount(intersected) == 0);
+
+        multiOrderedSetFree(a);
+        multiOrderedSetFree(b);
+        multiOrderedSetFree(c);
+        multiOrderedSetFree(reference);
+        multiOrderedSetFree(unioned);
+        multiOrderedSetFree(intersected);
+    }
+
+    TEST("multiOrderedSet: bounded top-K") {
+        const size_t K = 1000;
+        const int N = 50000;
+        multiOrderedSetTopK *topk = multiOrderedSetTopKNew(K);
+        multiOrderedSet *all = multiOrderedSetNew();
+
+        /* Unique members: the board must equal the top K of everything */
+        uint64_t seed[2] = {0xfeedULL, 0xbeefULL};
+        databox score, member;
+        char buf[32];
+        for (int i = 0; i < N; i++) {
+            score = (databox){.type = DATABOX_SIGNED_64,
+                              .data.i = (int64_t)(xoroshiro128plus(seed) %
+                                                  100000)};
+            int len = snprintf(buf, sizeof(buf), "p%d", i);
+            member = databoxNewBytes(buf, len);
+            multiOrderedSetTopKAdd(topk, &score, &member);
+            multiOrderedSetAdd(&all, &score, &member);
+            assert(multiOrderedSetCount(multiOrderedSetTopKSet(topk)) <= K);
+        }
+
+        const multiOrderedSet *board = multiOrderedSetTopKSet(topk);
+        assert(multiOrderedSetCount(board) == K);
+        assert(multiOrderedSetTopKEvictions(topk) +
+                   multiOrderedSetTopKRejections(topk) ==
+               (uint64_t)N - K);
+
+        for (size_t r = 0; r < K; r++) {
+            databox expectMember, expectScore, gotMember, gotScore;
+            assert(multiOrderedSetGetByRank(all, -1 - (int64_t)r,
+                                            &expectMember, &expectScore));
+            assert(multiOrderedSetGetByRank(board, -1 - (int64_t)r, &gotMember,
+                                            &gotScore));
+            assert(databoxCompare(&expectMember, &gotMember) == 0);
+            assert(databoxCompare(&expectScore, &gotScore) == 0);
+        }
+
+        /* Existing members are updated even below the minimum */
+        databox lowMember, lowScore;
+        multiOrderedSetLast(board, &lowMember, &lowScore);
+        int len = snprintf(buf, sizeof(buf), "%.*s", (int)lowMember.len,
+                           (const char *)lowMember.data.bytes.start);
+        member = databoxNewBytes(buf, len);
+        score = (databox){.type = DATABOX_SIGNED_64, .data.i = -5};
+        assert(multiOrderedSetTopKAdd(topk, &score, &member));
+        assert(multiOrderedSetCount(board) == K);
+        assert(multiOrderedSetGetRank(board, &member) == 0);
+
+        /* ...and the cached minimum follows the update */
+        uint64_t rejected = multiOrderedSetTopKRejections(topk);
+        score.data.i = -10;
+        member = databoxNewBytes("latecomer", 9);
+        assert(!multiOrderedSetTopKAdd(topk, &score, &member));
+        assert(multiOrderedSetTopKRejections(topk) == rejected + 1);
+        score.data.i = -1;
+        assert(multiOrderedSetTopKAdd(topk, &score, &member));
+        assert(multiOrderedSetCount(board) == K);
+
+        /* Capacity 0 rejects everything */
+        multiOrderedSetTopK *none = multiOrderedSetTopKNew(0);
+        assert(!multiOrderedSetTopKAdd(none, &score, &member));
+        assert(multiOrderedSetCount(multiOrderedSetTopKSet(none)) == 0);
+
+        multiOrderedSetTopKFree(none);
+        multiOrderedSetTopKFree(topk);
+        multiOrderedSetFree(all);
+    }
+
     TEST("multiOrderedSet: copy") {
         multiOrderedSet *mos = multiOrderedSetNew();
 
@@ -1638,6 +2037,132 @@ int multiOrderedSetTest(int argc, char *argv[]) {
         }
     }
 
+    TEST("PERF: weighted union store vs IncrBy aggregation") {
+        const size_t SETS = 24;
+        const size_t PER_SET = 20000;
+        const size_t UNIVERSE = 100000;
+
+        multiOrderedSet *sets[SETS];
+        double weights[SETS];
+        uint64_t seed[2] = {0x1234567, 0x89abcdef};
+        for (size_t s = 0; s < SETS; s++) {
+            sets[s] = multiOrderedSetNew();
+            weights[s] = 1.0 + (double)s / 8.0;
+            for (size_t i = 0; i < PER_SET; i++) {
+                const uint64_t r = xoroshiro128plus(seed);
+                databox score = {.type = DATABOX_SIGNED_64,
+                                 .data.i = (int64_t)(r % 1000000)};
+                char buf[32];
+                snprintf(buf, sizeof(buf), "player%zu",
+                         (size_t)((r >> 32) % UNIVERSE));
+                databox member = databoxNewBytesAllowEmbed(buf, strlen(buf));
+                multiOrderedSetAdd(&sets[s], &score, &member);
+            }
+        }
+
+        size_t incrCount;
+        {
+            multiOrderedSet *board = multiOrderedSetNew();
+            TIME_INIT;
+            for (size_t s = 0; s < SETS; s++) {
+                mosIterator iter;
+                multiOrderedSetIteratorInit(sets[s], &iter, true);
+                databox member, score;
+                while (multiOrderedSetIteratorNext(&iter, &member, &score)) {
+                    databox delta, result;
+                    DATABOX_SET_DOUBLE(
+                        &delta, mosDataboxToDouble(&score) * weights[s]);
+                    multiOrderedSetIncrBy(&board, &delta, &member, &result);
+                }
+            }
+            TIME_FINISH(SETS * PER_SET, "IncrBy aggregation (per input)");
+            incrCount = multiOrderedSetCount(board);
+            multiOrderedSetFree(board);
+        }
+
+        {
+            multiOrderedSet *board = NULL;
+            TIME_INIT;
+            size_t stored = multiOrderedSetUnionStore(
+                &board, (const multiOrderedSet **)sets, weights, SETS,
+                MOS_AGGREGATE_SUM);
+            TIME_FINISH(SETS * PER_SET, "UnionStore SUM (per input)");
+            assert(stored == incrCount);
+            multiOrderedSetFree(board);
+        }
+
+        {
+            multiOrderedSet *board = NULL;
+            TIME_INIT;
+            multiOrderedSetIntersectStore(&board,
+                                          (const multiOrderedSet **)sets,
+                                          weights, 4, MOS_AGGREGATE_MAX);
+            TIME_FINISH(4 * PER_SET, "IntersectStore MAX, 4 sets (per input)");
+            multiOrderedSetFree(board);
+        }
+
+        for (size_t s = 0; s < SETS; s++) {
+            multiOrderedSetFree(sets[s]);
+        }
+    }
+
+    TEST("PERF: bounded top-K vs Add + PopMin trimming") {
+        const size_t K = 1000;
+        const size_t EVENTS = 1000000;
+        const size_t PLAYERS = 200000;
+
+        databox *members = zmalloc(sizeof(*members) * PLAYERS);
+        char(*names)[16] = zmalloc(sizeof(*names) * PLAYERS);
+        for (size_t i = 0; i < PLAYERS; i++) {
+            int len = snprintf(names[i], sizeof(names[i]), "pl%zu", i);
+            members[i] = databoxNewBytes(names[i], len);
+        }
+
+        uint64_t trimmedEvictions = 0;
+        {
+            uint64_t seed[2] = {0x5eed, 0xcafe};
+            multiOrderedSet *board = multiOrderedSetNew();
+            databox popMember, popScore;
+            TIME_INIT;
+            for (size_t i = 0; i < EVENTS; i++) {
+                const uint64_t r = xoroshiro128plus(seed);
+                databox score = {.type = DATABOX_SIGNED_64,
+                                 .data.i = (int64_t)(r % 10000000)};
+                multiOrderedSetAdd(&board, &score,
+                                   &members[(r >> 32) % PLAYERS]);
+                if (multiOrderedSetCount(board) > K) {
+                    multiOrderedSetPopMin(&board, 1, &popMember, &popScore);
+                    trimmedEvictions++;
+                }
+            }
+            TIME_FINISH(EVENTS, "Add + PopMin trim");
+            multiOrderedSetFree(board);
+        }
+
+        {
+            uint64_t seed[2] = {0x5eed, 0xcafe};
+            multiOrderedSetTopK *topk = multiOrderedSetTopKNew(K);
+            TIME_INIT;
+            for (size_t i = 0; i < EVENTS; i++) {
+                const uint64_t r = xoroshiro128plus(seed);
+                databox score = {.type = DATABOX_SIGNED_64,
+                                 .data.i = (int64_t)(r % 10000000)};
+                multiOrderedSetTopKAdd(topk, &score,
+                                       &members[(r >> 32) % PLAYERS]);
+            }
+            TIME_FINISH(EVENTS, "TopK add");
+            printf("    evictions=%" PRIu64 " rejections=%" PRIu64
+                   " (trim path evicted %" PRIu64 ")\n",
+                   multiOrderedSetTopKEvictions(topk),
+                   multiOrderedSetTopKRejections(topk), trimmedEvictions);
+            assert(multiOrderedSetCount(multiOrderedSetTopKSet(topk)) == K);
+            multiOrderedSetTopKFree(topk);
+        }
+
+        zfree(names);
+        zfree(members);
+    }
+
     TEST("PERF: Lookup throughput by tier") {
         const size_t LOOKUP_COUNT = 10000;
 
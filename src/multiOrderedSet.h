@@ -422,6 +422,23 @@ multiOrderedSet *multiOrderedSetIntersect(const multiOrderedSet *sets[],
                                           const double *weights, size_t numSets,
                                           mosAggregate aggregate);
 
+/* Store the weighted union/intersection of 'sets' into '*dst', replacing
+ * its previous contents (ZUNIONSTORE / ZINTERSTORE). '*dst' may be NULL or
+ * one of 'sets'. weights can be NULL for all 1.0 weights. NULL entries in
+ * 'sets' are skipped by union and make an intersection empty.
+ *
+ * Scores are combined through a member hash, then the sorted result is
+ * built once instead of re-sorting on every insert.
+ * Returns the number of members stored. */
+size_t multiOrderedSetUnionStore(multiOrderedSet **dst,
+                                 const multiOrderedSet *sets[],
+                                 const double *weights, size_t numSets,
+                                 mosAggregate aggregate);
+size_t multiOrderedSetIntersectStore(multiOrderedSet **dst,
+                                     const multiOrderedSet *sets[],
+                                     const double *weights, size_t numSets,
+                                     mosAggregate aggregate);
+
 /* Create difference (first - rest). Caller must free result. */
 multiOrderedSet *multiOrderedSetDifference(const multiOrderedSet *sets[],
                                            size_t numSets);
@@ -449,6 +466,34 @@ bool multiOrderedSetFirst(const multiOrderedSet *mos, databox *member,
 bool multiOrderedSetLast(const multiOrderedSet *mos, databox *member,
                          databox *score);
 
+/* ====================================================================
+ * Bounded Top-K
+ * ====================================================================
+ * A multiOrderedSet holding at most 'capacity' entries: the highest
+ * (score, member) pairs seen. Once full, a new member scoring below the
+ * current minimum is rejected by comparing against a cached minimum score
+ * without touching the set; otherwise the insert goes through and the
+ * minimum entry is evicted. Updates to members already on the board are
+ * always applied (ZADD semantics), even if they lower the score. */
+typedef struct multiOrderedSetTopK multiOrderedSetTopK;
+
+multiOrderedSetTopK *multiOrderedSetTopKNew(size_t capacity);
+void multiOrderedSetTopKFree(multiOrderedSetTopK *topk);
+
+/* Returns true if 'member' is on the board after the call. */
+bool multiOrderedSetTopKAdd(multiOrderedSetTopK *topk, const databox *score,
+                            const databox *member);
+
+/* Read-only view of the board for rank/iteration/lookup calls */
+const multiOrderedSet *multiOrderedSetTopKSet(const multiOrderedSetTopK *topk);
+size_t multiOrderedSetTopKCapacity(const multiOrderedSetTopK *topk);
+
+/* Members removed to make room for higher scores */
+uint64_t multiOrderedSetTopKEvictions(const multiOrderedSetTopK *topk);
+
+/* New members turned away for scoring below the board minimum */
+uint64_t multiOrderedSetTopKRejections(const multiOrderedSetTopK *topk);
+
 /* ====================================================================
  * Debugging / Testing
  * ==================================================================== */
@@ -24,6 +24,12 @@ typedef enum multiOrderedSetType {
     MOS_TYPE_FULL = 3    /* Dual structure, ~64 bytes */
 } multiOrderedSetType;
 
+/* One (score, member) pair, for building sets from pre-sorted input */
+typedef struct mosEntry {
+    databox score;
+    databox member;
+} mosEntry;
+
 /* Index types for consistency with multimap */
 typedef uint32_t mosMapIdx;
 typedef uint32_t mosMiddle;
@@ -3,6 +3,7 @@
 #include "multiOrderedSetMediumInternal.h"
 /* atomPool.h already included via multiOrderedSetFullInternal.h */
 
+#include "fenwick/fenwickI64.h"
 #include "str.h" /* for random functions */
 
 /* ====================================================================
@@ -152,38 +153,205 @@ static void updateMiddle(multiOrderedSetFull *m, uint32_t idx) {
     }
 }
 
-/* Find which sub-map a score belongs to */
-static int32_t findSubMapForScore(const multiOrderedSetFull *m,
-                                  const databox *score) {
-    /* Binary search through rangeBox to find appropriate sub-map */
-    int32_t left = 0;
-    int32_t right = (int32_t)m->mapCount - 1;
+/* ====================================================================
+ * Rank Tree
+ * ====================================================================
+ * rankTree holds the entry count of every sub-map, so the number of
+ * entries before a sub-map is one prefix query instead of a walk over
+ * every earlier sub-map. Inserts and deletes adjust a single count; splits
+ * and sub-map removal shift sub-map indexes, so those rebuild the tree in
+ * linear time (once per split, and once per range removal no matter how
+ * many sub-maps it drops). */
+
+static void rankTreeRebuild(multiOrderedSetFull *m) {
+    int64_t *counts = zmalloc(m->mapCount * sizeof(*counts));
+    for (uint32_t i = 0; i < m->mapCount; i++) {
+        const flex *map = getSubMap(m, i);
+        counts[i] = map ? (int64_t)subMapCount(map) : 0;
+    }
 
-    while (left < right) {
-        int32_t mid = (left + right) / 2;
-        databox *rangeScorePtr;
-        multiarrayNativeGet(m->rangeBox, databox, rangeScorePtr, mid);
+    fenwickI64Free(m->rankTree);
+    m->rankTree = fenwickI64NewFromArray(counts, m->mapCount);
+    zfree(counts);
+}
 
-        if (rangeScorePtr && databoxCompare(score, rangeScorePtr) <= 0) {
-            right = mid;
+/* Number of entries stored in sub-maps [0, mapIdx) */
+static uint64_t rankBeforeSubMap(const multiOrderedSetFull *m,
+                                 uint32_t mapIdx) {
+    return mapIdx ? (uint64_t)fenwickI64Query(m->rankTree, mapIdx - 1) : 0;
+}
+
+/* Find the sub-map holding normalized 'rank' (< totalEntries) and the
+ * rank's position inside that sub-map. */
+static uint32_t findSubMapForRank(const multiOrderedSetFull *m, uint64_t rank,
+                                  size_t *localRank) {
+    const uint32_t mapIdx =
+        (uint32_t)fenwickI64LowerBound(m->rankTree, (int64_t)rank + 1);
+    *localRank = (size_t)(rank - rankBeforeSubMap(m, mapIdx));
+    return mapIdx;
+}
+
+/* ====================================================================
+ * Sub-map Search
+ * ==================================================================== */
+
+/* Compare (score, memberOrId) against the head entry of sub-map 'idx'.
+ * rangeBox caches the head score, so the member is only read on ties. */
+static int compareSubMapHead(const multiOrderedSetFull *m, uint32_t idx,
+                             const databox *score,
+                             const databox *memberOrId) {
+    int cmp = databoxCompare(score, getRangeBox(m, idx));
+    if (cmp == 0) {
+        flex *map = getSubMap(m, idx);
+        if (flexCount(map) < MOS_ELEMENTS_PER_ENTRY) {
+            return -1;
+        }
+
+        databox headMember;
+        flexGetByType(flexNext(map, flexHead(map)), &headMember);
+        cmp = databoxCompare(memberOrId, &headMember);
+    }
+
+    return cmp;
+}
+
+/* Find the first sub-map which may hold an entry with 'score': the last
+ * sub-map whose head score is below 'score' (equal scores may continue
+ * from the tail of the previous sub-map). */
+static uint32_t findSubMapForScore(const multiOrderedSetFull *m,
+                                   const databox *score) {
+    uint32_t left = 1;
+    uint32_t right = m->mapCount;
+
+    while (left < right) {
+        const uint32_t mid = left + (right - left) / 2;
+        if (databoxCompare(getRangeBox(m, mid), score) < 0) {
+            left = mid + 1;
         } else {
+            right = mid;
+        }
+    }
+
+    return left - 1;
+}
+
+/* Find the sub-map owning (score, memberOrId): the last sub-map whose head
+ * entry is <= the entry in the same (score, member) order flex uses. */
+static uint32_t findSubMapForEntry(const multiOrderedSetFull *m,
+                                   const databox *score,
+                                   const databox *memberOrId) {
+    uint32_t left = 1;
+    uint32_t right = m->mapCount;
+
+    while (left < right) {
+        const uint32_t mid = left + (right - left) / 2;
+        if (compareSubMapHead(m, mid, score, memberOrId) >= 0) {
             left = mid + 1;
+        } else {
+            right = mid;
         }
     }
 
-    return left;
+    return left - 1;
 }
 
-/* Insert into specific sub-map */
-static void insertIntoSubMap(multiOrderedSetFull *m, uint32_t mapIdx,
-                             const databox *score, const databox *member) {
-    flex *map = getSubMap(m, mapIdx);
-    if (!map) {
+/* Refresh rangeBox for a sub-map from its head entry */
+static void updateRangeBox(multiOrderedSetFull *m, uint32_t idx) {
+    databox *rangeScore = getRangeBox(m, idx);
+    if (!rangeScore) {
         return;
     }
 
+    /* flexHead() returns non-NULL even for empty flex (points past header),
+     * so we must check flexCount() to avoid reading invalid memory. */
+    flex *map = getSubMap(m, idx);
+    if (map && flexCount(map) > 0) {
+        flexGetByType(flexHead(map), rangeScore);
+    } else {
+        /* Map is empty, set to max value */
+        rangeScore->type = DATABOX_SIGNED_64;
+        rangeScore->data.i = INT64_MAX;
+    }
+}
+
+/* ====================================================================
+ * Sub-map Split / Removal
+ * ==================================================================== */
+
+/* Place 'map' as a new sub-map at 'idx', shifting later sub-maps up.
+ * Caller refreshes middle/rangeBox for it and rebuilds rankTree. */
+static void insertSubMapAt(multiOrderedSetFull *m, uint32_t idx, flex *map) {
+    uint32_t middle = FLEX_EMPTY_SIZE;
+    databox range = {.type = DATABOX_SIGNED_64, .data.i = INT64_MAX};
+
+    uint32_t scoreMapCount = m->mapCount;
+    uint32_t middleCount = m->mapCount;
+    uint32_t rangeBoxCount = m->mapCount;
+    multiarrayNativeInsert(m->scoreMap, flex *, 64, scoreMapCount, idx, &map);
+    multiarrayNativeInsert(m->middle, uint32_t, 64, middleCount, idx, &middle);
+    multiarrayNativeInsert(m->rangeBox, databox, 64, rangeBoxCount, idx,
+                           &range);
+    m->mapCount++;
+}
+
+/* Split sub-map 'mapIdx' in half; the upper half becomes 'mapIdx + 1'. */
+static void splitSubMap(multiOrderedSetFull *m, uint32_t mapIdx) {
+    flex *lower = getSubMap(m, mapIdx);
+    flex *higher = flexSplitMiddle(&lower, MOS_ELEMENTS_PER_ENTRY,
+                                   flexMiddle(lower, MOS_ELEMENTS_PER_ENTRY));
+    setSubMap(m, mapIdx, lower);
+    updateMiddle(m, mapIdx);
+
+    insertSubMapAt(m, mapIdx + 1, higher);
+    updateMiddle(m, mapIdx + 1);
+    updateRangeBox(m, mapIdx + 1);
+    rankTreeRebuild(m);
+}
+
+/* Drop an empty sub-map (never the last remaining one).
+ * Caller rebuilds rankTree. */
+static void deleteSubMap(multiOrderedSetFull *m, uint32_t mapIdx) {
+    flexFree(getSubMap(m, mapIdx));
+
+    uint32_t scoreMapCount = m->mapCount;
+    uint32_t middleCount = m->mapCount;
+    uint32_t rangeBoxCount = m->mapCount;
+    multiarrayNativeDelete(m->scoreMap, flex *, scoreMapCount, mapIdx);
+    multiarrayNativeDelete(m->middle, uint32_t, middleCount, mapIdx);
+    multiarrayNativeDelete(m->rangeBox, databox, rangeBoxCount, mapIdx);
+    m->mapCount--;
+}
+
+/* Bookkeeping after 'removed' entries were deleted from sub-map 'mapIdx'.
+ * Returns true if the sub-map was emptied and dropped, in which case the
+ * caller must rebuild rankTree before its next rank lookup. */
+static bool subMapEntriesRemoved(multiOrderedSetFull *m, uint32_t mapIdx,
+                                 flex *map, size_t removed) {
+    setSubMap(m, mapIdx, map);
+    m->totalEntries -= removed;
+
+    if (flexCount(map) == 0 && m->mapCount > 1) {
+        deleteSubMap(m, mapIdx);
+        return true;
+    }
+
+    updateMiddle(m, mapIdx);
+    updateRangeBox(m, mapIdx);
+    fenwickI64Update(&m->rankTree, mapIdx, -(int64_t)removed);
+    return false;
+}
+
+/* Insert (score, member) into the sub-map owning it, splitting if needed */
+static void insertIntoSubMap(multiOrderedSetFull *m, const databox *score,
+                             const databox *member) {
     /* In pool mode, convert member to pool ID for storage in scoreMap */
     databox memberOrId = memberToPoolId(m, member);
+    const uint32_t mapIdx = findSubMapForEntry(m, score, &memberOrId);
+    flex *map = getSubMap(m, mapIdx);
+    if (!map) {
+        return;
+    }
+
     const databox *elements[2] = {score, &memberOrId};
     uint32_t mid = getMiddle(m, mapIdx);
     flexEntry *middle = (flexEntry *)(map + mid);
@@ -194,28 +362,25 @@ static void insertIntoSubMap(multiOrderedSetFull *m, uint32_t mapIdx,
     setSubMap(m, mapIdx, map);
     setMiddle(m, mapIdx, (uint32_t)(middle - map));
     m->totalEntries++;
+    fenwickI64Update(&m->rankTree, mapIdx, 1);
 
     /* Update rangeBox if needed */
-    flexEntry *head = flexHead(map);
-    if (head) {
-        databox *rangeScore = getRangeBox(m, mapIdx);
-        if (rangeScore) {
-            flexGetByType(head, rangeScore);
-        }
-    }
+    updateRangeBox(m, mapIdx);
 
     /* Check if we need to split */
-    if (flexBytes(map) > m->maxMapSize && m->mapCount < 1024) {
-        /* TODO: Implement map splitting for better scaling */
+    if (flexBytes(map) > m->maxMapSize &&
+        subMapCount(map) >= MOS_ELEMENTS_PER_ENTRY) {
+        splitSubMap(m, mapIdx);
     }
 }
 
-/* Remove entry from specific sub-map */
-static void removeFromSubMap(multiOrderedSetFull *m, uint32_t mapIdx,
-                             flexEntry *entry) {
+/* Remove entry from specific sub-map.
+ * Returns true if the sub-map was dropped; the caller rebuilds rankTree. */
+static bool removeEntryFromSubMap(multiOrderedSetFull *m, uint32_t mapIdx,
+                                  flexEntry *entry) {
     flex *map = getSubMap(m, mapIdx);
     if (!map) {
-        return;
+        return false;
     }
 
     /* In pool mode, release the member before deleting */
@@ -229,80 +394,109 @@ static void removeFromSubMap(multiOrderedSetFull *m, uint32_t mapIdx,
     }
 
     flexDeleteCount(&map, &entry, MOS_ELEMENTS_PER_ENTRY);
-    setSubMap(m, mapIdx, map);
-    updateMiddle(m, mapIdx);
-    m->totalEntries--;
+    return subMapEntriesRemoved(m, mapIdx, map, 1);
+}
 
-    /* Update rangeBox - check if map has entries before reading head.
-     * flexHead() returns non-NULL even for empty flex (points past header),
-     * so we must check flexCount() to avoid reading invalid memory. */
-    databox *rangeScore = getRangeBox(m, mapIdx);
-    if (rangeScore) {
-        if (flexCount(map) > 0) {
-            flexEntry *head = flexHead(map);
-            flexGetByType(head, rangeScore);
-        } else {
-            /* Map is empty, set to max value */
-            rangeScore->type = DATABOX_SIGNED_64;
-            rangeScore->data.i = INT64_MAX;
+static void removeFromSubMap(multiOrderedSetFull *m, uint32_t mapIdx,
+                             flexEntry *entry) {
+    if (removeEntryFromSubMap(m, mapIdx, entry)) {
+        rankTreeRebuild(m);
+    }
+}
+
+/* Remove 'count' consecutive entries starting at 'localRank' inside sub-map
+ * 'mapIdx', dropping each member from memberIndex (and the pool).
+ * Returns true if the sub-map was dropped; the caller rebuilds rankTree
+ * once after its last run. */
+static bool removeRunFromSubMap(multiOrderedSetFull *m, uint32_t mapIdx,
+                                size_t localRank, size_t count) {
+    flex *map = getSubMap(m, mapIdx);
+    if (!map || count == 0) {
+        return false;
+    }
+
+    const int32_t offset = (int32_t)(localRank * MOS_ELEMENTS_PER_ENTRY);
+    flexEntry *entry = flexIndex(map, offset);
+    for (size_t i = 0; i < count && entry; i++) {
+        flexEntry *memberEntry = flexNext(map, entry);
+
+        /* In pool mode, convert pool ID to member for memberIndex */
+        databox memberOrId, member;
+        flexGetByType(memberEntry, &memberOrId);
+        if (poolIdToMember(m, &memberOrId, &member)) {
+            multidictDelete(m->memberIndex, &member);
         }
+
+        releasePoolMember(m, &memberOrId);
+        entry = flexNext(map, memberEntry);
     }
+
+    flexDeleteRange(&map, offset, (uint32_t)(count * MOS_ELEMENTS_PER_ENTRY));
+    return subMapEntriesRemoved(m, mapIdx, map, count);
 }
 
-/* Find entry in score maps by member (using member index for score lookup) */
+/* Resolve member to the form stored in scoreMap without interning it.
+ * Returns false if the member can't be in scoreMap (pool miss). */
+static bool memberToStoredForm(const multiOrderedSetFull *m,
+                               const databox *member, databox *memberOrId) {
+    if (m->pool) {
+        uint64_t id = atomPoolGetId(m->pool, member);
+        if (id == 0) {
+            return false; /* Member not in pool */
+        }
+        *memberOrId = (databox){.type = DATABOX_UNSIGNED_64, .data.u64 = id};
+    } else {
+        *memberOrId = *member;
+    }
+
+    return true;
+}
+
+/* Find entry in score maps by member (using member index for score lookup).
+ * If 'localRank' is non-NULL, it receives the entry's position in its
+ * sub-map. */
 static flexEntry *findEntryByMember(const multiOrderedSetFull *m,
-                                    const databox *member, uint32_t *mapIdx) {
+                                    const databox *member, uint32_t *mapIdx,
+                                    size_t *localRank) {
     /* First, get the score from member index */
     databox score;
     if (!multidictFind((multidict *)m->memberIndex, member, &score)) {
         return NULL;
     }
 
-    /* Find the sub-map containing this score */
-    *mapIdx = findSubMapForScore(m, &score);
+    /* In pool mode, get the pool ID for comparison */
+    databox memberToMatch;
+    if (!memberToStoredForm(m, member, &memberToMatch)) {
+        return NULL;
+    }
+
+    /* Find the sub-map containing this (score, member) */
+    *mapIdx = findSubMapForEntry(m, &score, &memberToMatch);
     flex *map = getSubMap(m, *mapIdx);
     if (!map) {
         return NULL;
     }
 
-    /* In pool mode, get the pool ID for comparison */
-    databox memberToMatch;
-    if (m->pool) {
-        uint64_t id = atomPoolGetId(m->pool, member);
-        if (id == 0) {
-            return NULL; /* Member not in pool */
-        }
-        memberToMatch = (databox){.type = DATABOX_UNSIGNED_64, .data.u64 = id};
-    } else {
-        memberToMatch = *member;
+    /* Binary search for the exact (score, member/memberID) entry */
+    const databox *compareAgainst[2] = {&score, &memberToMatch};
+    flexEntry *entry = flexFindByTypeSortedWithMiddleFullWidth(
+        map, MOS_ELEMENTS_PER_ENTRY, compareAgainst,
+        map + getMiddle(m, *mapIdx));
+    if (!entry) {
+        return NULL;
     }
 
-    /* Search for the (score, member/memberID) entry */
-    flexEntry *entry = flexHead(map);
-    while (entry) {
-        flexEntry *memberEntry = flexNext(map, entry);
-        if (!memberEntry) {
-            break;
-        }
-
-        databox currentScore, currentMemberOrId;
-        flexGetByType(entry, &currentScore);
-        flexGetByType(memberEntry, &currentMemberOrId);
-
-        if (databoxCompare(&currentScore, &score) == 0 &&
-            databoxCompare(&currentMemberOrId, &memberToMatch) == 0) {
-            return entry;
-        }
-
-        /* If we've passed the score, it's not in this map */
-        if (databoxCompare(&currentScore, &score) > 0) {
-            break;
+    if (localRank) {
+        /* Only rank lookups need the position; count entries before it */
+        size_t position = 0;
+        for (flexEntry *walk = flexHead(map); walk && walk < entry;
+             walk = flexNext(map, flexNext(map, walk))) {
+            position++;
         }
-
-        entry = flexNext(map, memberEntry);
+        *localRank = position;
     }
 
-    return NULL;
+    return entry;
 }
 
 /* ====================================================================
@@ -326,15 +520,19 @@ multiOrderedSetFull *multiOrderedSetFullNew(void) {
     databox initialRange = {.type = DATABOX_SIGNED_64, .data.i = INT64_MAX};
 
     /* Use multiarrayNativeInsert instead of non-existent Append */
-    uint32_t mapCount = 0;
-    multiarrayNativeInsert(m->scoreMap, flex *, 64, mapCount, 0, &initialMap);
-    multiarrayNativeInsert(m->middle, uint32_t, 64, mapCount, 0,
+    uint32_t scoreMapCount = 0;
+    uint32_t middleCount = 0;
+    uint32_t rangeBoxCount = 0;
+    multiarrayNativeInsert(m->scoreMap, flex *, 64, scoreMapCount, 0,
+                           &initialMap);
+    multiarrayNativeInsert(m->middle, uint32_t, 64, middleCount, 0,
                            &initialMiddle);
-    multiarrayNativeInsert(m->rangeBox, databox, 64, mapCount, 0,
+    multiarrayNativeInsert(m->rangeBox, databox, 64, rangeBoxCount, 0,
                            &initialRange);
 
     m->mapCount = 1;
     m->totalEntries = 0;
+    rankTreeRebuild(m);
     m->maxMapSize = MOS_FULL_DEFAULT_MAX_MAP_SIZE;
     m->flags = 0;
     m->pool = NULL;
@@ -398,6 +596,41 @@ multiOrderedSetFullNewFromMedium(struct multiOrderedSetMedium *medium,
     return m;
 }
 
+multiOrderedSetFull *multiOrderedSetFullNewFromSorted(const mosEntry *entries,
+                                                      size_t count) {
+    multiOrderedSetFull *m = multiOrderedSetFullNew();
+
+    /* Fill sub-maps to half of maxMapSize, the size a split leaves behind,
+     * so later inserts have room before the first split. */
+    const size_t fillBytes = m->maxMapSize / 2;
+    uint32_t mapIdx = 0;
+    flex *map = getSubMap(m, 0);
+
+    for (size_t i = 0; i < count; i++) {
+        if (flexBytes(map) >= fillBytes) {
+            setSubMap(m, mapIdx, map);
+            map = flexNew();
+            insertSubMapAt(m, ++mapIdx, map);
+        }
+
+        const databox *pair[MOS_ELEMENTS_PER_ENTRY] = {&entries[i].score,
+                                                       &entries[i].member};
+        flexAppendMultiple(&map, MOS_ELEMENTS_PER_ENTRY, pair);
+        multidictAdd(m->memberIndex, &entries[i].member, &entries[i].score);
+    }
+
+    setSubMap(m, mapIdx, map);
+    m->totalEntries = count;
+
+    for (uint32_t i = 0; i < m->mapCount; i++) {
+        updateMiddle(m, i);
+        updateRangeBox(m, i);
+    }
+
+    rankTreeRebuild(m);
+    return m;
+}
+
 multiOrderedSetFull *multiOrderedSetFullCopy(const multiOrderedSetFull *m) {
     multiOrderedSetFull *copy = zcalloc(1, sizeof(*copy));
 
@@ -419,7 +652,9 @@ multiOrderedSetFull *multiOrderedSetFullCopy(const multiOrderedSetFull *m) {
     copy->middle = multiarrayNativeNew(uint32_t);
     copy->rangeBox = multiarrayNativeNew(databox);
 
-    uint32_t copyCount = 0;
+    uint32_t scoreMapCount = 0;
+    uint32_t middleCount = 0;
+    uint32_t rangeBoxCount = 0;
     for (uint32_t i = 0; i < m->mapCount; i++) {
         flex *origMap = getSubMap(m, i);
         flex *mapCopy = origMap ? flexDuplicate(origMap) : flexNew();
@@ -427,16 +662,18 @@ multiOrderedSetFull *multiOrderedSetFullCopy(const multiOrderedSetFull *m) {
         databox *range = getRangeBox(m, i);
         databox rangeCopy = range ? *range : (databox){0};
 
-        multiarrayNativeInsert(copy->scoreMap, flex *, 64, copyCount, i,
+        multiarrayNativeInsert(copy->scoreMap, flex *, 64, scoreMapCount, i,
                                &mapCopy);
-        multiarrayNativeInsert(copy->middle, uint32_t, 64, copyCount, i, &mid);
-        multiarrayNativeInsert(copy->rangeBox, databox, 64, copyCount, i,
+        multiarrayNativeInsert(copy->middle, uint32_t, 64, middleCount, i,
+                               &mid);
+        multiarrayNativeInsert(copy->rangeBox, databox, 64, rangeBoxCount, i,
                                &rangeCopy);
     }
 
     copy->mapCount = m->mapCount;
     copy->totalEntries = m->totalEntries;
     copy->maxMapSize = m->maxMapSize;
+    rankTreeRebuild(copy);
 
     /* Handle pool mode for copy */
     if (m->pool) {
@@ -555,6 +792,7 @@ void multiOrderedSetFullFree(multiOrderedSetFull *m) {
     multiarrayNativeFree(m->scoreMap);
     multiarrayNativeFree(m->middle);
     multiarrayNativeFree(m->rangeBox);
+    fenwickI64Free(m->rankTree);
 
     zfree(m);
 }
@@ -608,15 +846,19 @@ void multiOrderedSetFullReset(multiOrderedSetFull *m) {
     uint32_t initialMiddle = FLEX_EMPTY_SIZE;
     databox initialRange = {.type = DATABOX_SIGNED_64, .data.i = INT64_MAX};
 
-    uint32_t resetCount = 0;
-    multiarrayNativeInsert(m->scoreMap, flex *, 64, resetCount, 0, &initialMap);
-    multiarrayNativeInsert(m->middle, uint32_t, 64, resetCount, 0,
+    uint32_t scoreMapCount = 0;
+    uint32_t middleCount = 0;
+    uint32_t rangeBoxCount = 0;
+    multiarrayNativeInsert(m->scoreMap, flex *, 64, scoreMapCount, 0,
+                           &initialMap);
+    multiarrayNativeInsert(m->middle, uint32_t, 64, middleCount, 0,
                            &initialMiddle);
-    multiarrayNativeInsert(m->rangeBox, databox, 64, resetCount, 0,
+    multiarrayNativeInsert(m->rangeBox, databox, 64, rangeBoxCount, 0,
                            &initialRange);
 
     m->mapCount = 1;
     m->totalEntries = 0;
+    rankTreeRebuild(m);
 }
 
 /* ====================================================================
@@ -638,6 +880,8 @@ size_t multiOrderedSetFullBytes(const multiOrderedSetFull *m) {
         }
     }
 
+    bytes += fenwickI64Bytes(m->rankTree);
+
     /* Include owned pool bytes in total */
     if (m->pool && (m->flags & MOS_FLAG_POOL_OWNED)) {
         bytes += atomPoolBytes(m->pool);
@@ -658,7 +902,7 @@ bool multiOrderedSetFullAdd(multiOrderedSetFull *m, const databox *score,
     if (existed) {
         /* Remove old entry from score maps */
         uint32_t mapIdx;
-        flexEntry *entry = findEntryByMember(m, member, &mapIdx);
+        flexEntry *entry = findEntryByMember(m, member, &mapIdx, NULL);
         if (entry) {
             removeFromSubMap(m, mapIdx, entry);
         }
@@ -672,8 +916,7 @@ bool multiOrderedSetFullAdd(multiOrderedSetFull *m, const databox *score,
     }
 
     /* Add to score map */
-    uint32_t mapIdx = findSubMapForScore(m, score);
-    insertIntoSubMap(m, mapIdx, score, member);
+    insertIntoSubMap(m, score, member);
 
     return existed;
 }
@@ -685,8 +928,7 @@ bool multiOrderedSetFullAddNX(multiOrderedSetFull *m, const databox *score,
     }
 
     multidictAdd(m->memberIndex, member, score);
-    uint32_t mapIdx = findSubMapForScore(m, score);
-    insertIntoSubMap(m, mapIdx, score, member);
+    insertIntoSubMap(m, score, member);
 
     return true;
 }
@@ -700,15 +942,14 @@ bool multiOrderedSetFullAddXX(multiOrderedSetFull *m, const databox *score,
 
     /* Remove old entry */
     uint32_t mapIdx;
-    flexEntry *entry = findEntryByMember(m, member, &mapIdx);
+    flexEntry *entry = findEntryByMember(m, member, &mapIdx, NULL);
     if (entry) {
         removeFromSubMap(m, mapIdx, entry);
     }
 
     /* Update with new score (entry must exist since XX checked) */
     multidictAdd(m->memberIndex, member, score);
-    mapIdx = findSubMapForScore(m, score);
-    insertIntoSubMap(m, mapIdx, score, member);
+    insertIntoSubMap(m, score, member);
 
     return true;
 }
@@ -721,7 +962,7 @@ bool multiOrderedSetFullAddGetPrevious(multiOrderedSetFull *m,
 
     if (existed) {
         uint32_t mapIdx;
-        flexEntry *entry = findEntryByMember(m, member, &mapIdx);
+        flexEntry *entry = findEntryByMember(m, member, &mapIdx, NULL);
         if (entry) {
             removeFromSubMap(m, mapIdx, entry);
         }
@@ -729,8 +970,7 @@ bool multiOrderedSetFullAddGetPrevious(multiOrderedSetFull *m,
 
     /* multidictAdd does upsert - add or replace */
     multidictAdd(m->memberIndex, member, score);
-    uint32_t mapIdx = findSubMapForScore(m, score);
-    insertIntoSubMap(m, mapIdx, score, member);
+    insertIntoSubMap(m, score, member);
 
     return existed;
 }
@@ -746,7 +986,7 @@ bool multiOrderedSetFullIncrBy(multiOrderedSetFull *m, const databox *delta,
         }
 
         uint32_t mapIdx;
-        flexEntry *entry = findEntryByMember(m, member, &mapIdx);
+        flexEntry *entry = findEntryByMember(m, member, &mapIdx, NULL);
         if (entry) {
             removeFromSubMap(m, mapIdx, entry);
         }
@@ -756,8 +996,7 @@ bool multiOrderedSetFullIncrBy(multiOrderedSetFull *m, const databox *delta,
 
     /* multidictAdd does upsert - add or replace */
     multidictAdd(m->memberIndex, member, result);
-    uint32_t mapIdx = findSubMapForScore(m, result);
-    insertIntoSubMap(m, mapIdx, result, member);
+    insertIntoSubMap(m, result, member);
 
     return true;
 }
@@ -773,7 +1012,7 @@ bool multiOrderedSetFullRemove(multiOrderedSetFull *m, const databox *member) {
     }
 
     uint32_t mapIdx;
-    flexEntry *entry = findEntryByMember(m, member, &mapIdx);
+    flexEntry *entry = findEntryByMember(m, member, &mapIdx, NULL);
     if (entry) {
         removeFromSubMap(m, mapIdx, entry);
     }
@@ -789,7 +1028,7 @@ bool multiOrderedSetFullRemoveGetScore(multiOrderedSetFull *m,
     }
 
     uint32_t mapIdx;
-    flexEntry *entry = findEntryByMember(m, member, &mapIdx);
+    flexEntry *entry = findEntryByMember(m, member, &mapIdx, NULL);
     if (entry) {
         removeFromSubMap(m, mapIdx, entry);
     }
@@ -801,13 +1040,22 @@ bool multiOrderedSetFullRemoveGetScore(multiOrderedSetFull *m,
 size_t multiOrderedSetFullRemoveRangeByScore(multiOrderedSetFull *m,
                                              const mosRangeSpec *range) {
     size_t removed = 0;
+    uint32_t mapIdx = findSubMapForScore(m, &range->min);
+    bool rankStale = false;
 
-    for (uint32_t mapIdx = 0; mapIdx < m->mapCount; mapIdx++) {
+    while (mapIdx < m->mapCount && m->totalEntries > 0) {
         flex *map = getSubMap(m, mapIdx);
         if (!map) {
-            continue;
+            break;
         }
 
+        /* Entries are sorted, so matches form one run per sub-map; any
+         * non-match after the run (or above max) ends the whole range. */
+        size_t position = 0;
+        size_t runStart = 0;
+        size_t runLength = 0;
+        bool pastMax = false;
+
         flexEntry *entry = flexHead(map);
         while (entry) {
             flexEntry *memberEntry = flexNext(map, entry);
@@ -815,39 +1063,48 @@ size_t multiOrderedSetFullRemoveRangeByScore(multiOrderedSetFull *m,
                 break;
             }
 
-            databox score, memberOrId;
+            databox score;
             flexGetByType(entry, &score);
-            flexGetByType(memberEntry, &memberOrId);
 
             if (mosScoreInRange(&score, &range->min, range->minExclusive,
                                 &range->max, range->maxExclusive)) {
-                flexEntry *nextEntry = flexNext(map, memberEntry);
-
-                /* In pool mode, convert pool ID to member for memberIndex */
-                databox member;
-                if (!poolIdToMember(m, &memberOrId, &member)) {
-                    entry = nextEntry;
-                    continue;
+                if (runLength == 0) {
+                    runStart = position;
                 }
-
-                /* Remove from member index */
-                multidictDelete(m->memberIndex, &member);
-
-                /* Remove from score map */
-                removeFromSubMap(m, mapIdx, entry);
-                removed++;
-
-                entry = nextEntry;
+                runLength++;
             } else {
                 int cmp = databoxCompare(&score, &range->max);
-                if (cmp > 0 || (cmp == 0 && range->maxExclusive)) {
+                if (runLength > 0 || cmp > 0 ||
+                    (cmp == 0 && range->maxExclusive)) {
+                    pastMax = true;
                     break;
                 }
-                entry = flexNext(map, memberEntry);
             }
+
+            position++;
+            entry = flexNext(map, memberEntry);
+        }
+
+        const bool dropped =
+            removeRunFromSubMap(m, mapIdx, runStart, runLength);
+        rankStale |= dropped;
+        removed += runLength;
+
+        if (pastMax) {
+            break;
+        }
+
+        /* If the sub-map was emptied and dropped, mapIdx is now the next
+         * sub-map already. */
+        if (!dropped) {
+            mapIdx++;
         }
     }
 
+    if (rankStale) {
+        rankTreeRebuild(m);
+    }
+
     return removed;
 }
 
@@ -861,49 +1118,41 @@ size_t multiOrderedSetFullRemoveRangeByRank(multiOrderedSetFull *m,
         return 0;
     }
 
-    /* Collect entries to remove */
+    /* Only the first sub-map needs a rank lookup: each pass removes the run
+     * of the range living in one sub-map, and the range then continues at
+     * the head of the following sub-map. */
     size_t removed = 0;
-    int64_t currentRank = 0;
+    size_t remaining = (size_t)(stop - start + 1);
+    size_t localRank;
+    uint32_t mapIdx = findSubMapForRank(m, (uint64_t)start, &localRank);
+    bool rankStale = false;
 
-    for (uint32_t mapIdx = 0; mapIdx < m->mapCount && currentRank <= stop;
-         mapIdx++) {
+    while (remaining > 0 && mapIdx < m->mapCount) {
         flex *map = getSubMap(m, mapIdx);
         if (!map) {
-            continue;
+            break;
         }
 
-        flexEntry *entry = flexHead(map);
-        while (entry && currentRank <= stop) {
-            flexEntry *memberEntry = flexNext(map, entry);
-            if (!memberEntry) {
-                break;
-            }
-
-            if (currentRank >= start) {
-                databox memberOrId;
-                flexGetByType(memberEntry, &memberOrId);
-
-                /* In pool mode, convert pool ID to member for memberIndex */
-                databox member;
-                if (!poolIdToMember(m, &memberOrId, &member)) {
-                    currentRank++;
-                    entry = flexNext(map, memberEntry);
-                    continue;
-                }
+        size_t run = subMapCount(map) - localRank;
+        if (run > remaining) {
+            run = remaining;
+        }
 
-                flexEntry *nextEntry = flexNext(map, memberEntry);
+        const bool dropped = removeRunFromSubMap(m, mapIdx, localRank, run);
+        rankStale |= dropped;
+        removed += run;
+        remaining -= run;
 
-                multidictDelete(m->memberIndex, &member);
-                removeFromSubMap(m, mapIdx, entry);
-                removed++;
+        /* A dropped sub-map leaves the next one at 'mapIdx' already */
+        if (!dropped) {
+            mapIdx++;
+        }
 
-                entry = nextEntry;
-            } else {
-                entry = flexNext(map, memberEntry);
-            }
+        localRank = 0;
+    }
 
-            currentRank++;
-        }
+    if (rankStale) {
+        rankTreeRebuild(m);
     }
 
     return removed;
@@ -912,41 +1161,38 @@ size_t multiOrderedSetFullRemoveRangeByRank(multiOrderedSetFull *m,
 size_t multiOrderedSetFullPopMin(multiOrderedSetFull *m, size_t count,
                                  databox *members, databox *scores) {
     size_t popped = 0;
+    bool rankStale = false;
 
-    for (uint32_t mapIdx = 0; mapIdx < m->mapCount && popped < count;
-         mapIdx++) {
-        flex *map = getSubMap(m, mapIdx);
+    /* Only sub-map 0 of an empty set is ever empty, so the minimum is
+     * always the head of sub-map 0. */
+    while (popped < count && m->totalEntries > 0) {
+        flex *map = getSubMap(m, 0);
         if (!map) {
-            continue;
+            break;
         }
 
-        while (popped < count) {
-            flexEntry *head = flexHead(map);
-            if (!head) {
-                break;
-            }
-
-            flexEntry *memberEntry = flexNext(map, head);
-            if (!memberEntry) {
-                break;
-            }
+        flexEntry *head = flexHead(map);
+        flexEntry *memberEntry = flexNext(map, head);
+        if (!memberEntry) {
+            break;
+        }
 
-            flexGetByType(head, &scores[popped]);
+        flexGetByType(head, &scores[popped]);
 
-            /* In pool mode, convert pool ID back to member string */
-            databox memberOrId;
-            flexGetByType(memberEntry, &memberOrId);
-            if (!poolIdToMember(m, &memberOrId, &members[popped])) {
-                break;
-            }
+        /* In pool mode, convert pool ID back to member string */
+        databox memberOrId;
+        flexGetByType(memberEntry, &memberOrId);
+        if (!poolIdToMember(m, &memberOrId, &members[popped])) {
+            break;
+        }
 
-            multidictDelete(m->memberIndex, &members[popped]);
-            removeFromSubMap(m, mapIdx, head);
+        multidictDelete(m->memberIndex, &members[popped]);
+        rankStale |= removeEntryFromSubMap(m, 0, head);
+        popped++;
+    }
 
-            /* Refresh map pointer after removal */
-            map = getSubMap(m, mapIdx);
-            popped++;
-        }
+    if (rankStale) {
+        rankTreeRebuild(m);
     }
 
     return popped;
@@ -955,46 +1201,46 @@ size_t multiOrderedSetFullPopMin(multiOrderedSetFull *m, size_t count,
 size_t multiOrderedSetFullPopMax(multiOrderedSetFull *m, size_t count,
                                  databox *members, databox *scores) {
     size_t popped = 0;
+    bool rankStale = false;
 
-    for (int32_t mapIdx = (int32_t)m->mapCount - 1;
-         mapIdx >= 0 && popped < count; mapIdx--) {
+    while (popped < count && m->totalEntries > 0) {
+        const uint32_t mapIdx = m->mapCount - 1;
         flex *map = getSubMap(m, mapIdx);
         if (!map) {
-            continue;
+            break;
         }
 
-        while (popped < count) {
-            size_t mapEntries = flexCount(map);
-            if (mapEntries < MOS_ELEMENTS_PER_ENTRY) {
-                break;
-            }
+        size_t mapEntries = flexCount(map);
+        if (mapEntries < MOS_ELEMENTS_PER_ENTRY) {
+            break;
+        }
 
-            flexEntry *entry =
-                flexIndex(map, mapEntries - MOS_ELEMENTS_PER_ENTRY);
-            if (!entry) {
-                break;
-            }
+        flexEntry *entry = flexIndex(map, mapEntries - MOS_ELEMENTS_PER_ENTRY);
+        if (!entry) {
+            break;
+        }
 
-            flexEntry *memberEntry = flexNext(map, entry);
-            if (!memberEntry) {
-                break;
-            }
+        flexEntry *memberEntry = flexNext(map, entry);
+        if (!memberEntry) {
+            break;
+        }
 
-            flexGetByType(entry, &scores[popped]);
+        flexGetByType(entry, &scores[popped]);
 
-            /* In pool mode, convert pool ID back to member string */
-            databox memberOrId;
-            flexGetByType(memberEntry, &memberOrId);
-            if (!poolIdToMember(m, &memberOrId, &members[popped])) {
-                break;
-            }
+        /* In pool mode, convert pool ID back to member string */
+        databox memberOrId;
+        flexGetByType(memberEntry, &memberOrId);
+        if (!poolIdToMember(m, &memberOrId, &members[popped])) {
+            break;
+        }
 
-            multidictDelete(m->memberIndex, &members[popped]);
-            removeFromSubMap(m, mapIdx, entry);
+        multidictDelete(m->memberIndex, &members[popped]);
+        rankStale |= removeEntryFromSubMap(m, mapIdx, entry);
+        popped++;
+    }
 
-            map = getSubMap(m, mapIdx);
-            popped++;
-        }
+    if (rankStale) {
+        rankTreeRebuild(m);
     }
 
     return popped;
@@ -1016,52 +1262,13 @@ bool multiOrderedSetFullGetScore(const multiOrderedSetFull *m,
 
 int64_t multiOrderedSetFullGetRank(const multiOrderedSetFull *m,
                                    const databox *member) {
-    databox score;
-    if (!multidictFind((multidict *)m->memberIndex, member, &score)) {
+    uint32_t mapIdx;
+    size_t localRank;
+    if (!findEntryByMember(m, member, &mapIdx, &localRank)) {
         return -1;
     }
 
-    /* In pool mode, get the member's pool ID for comparison */
-    databox memberToMatch;
-    if (m->pool) {
-        uint64_t id = atomPoolGetId(m->pool, member);
-        if (id == 0) {
-            return -1; /* Member not in pool */
-        }
-        memberToMatch = (databox){.type = DATABOX_UNSIGNED_64, .data.u64 = id};
-    } else {
-        memberToMatch = *member;
-    }
-
-    int64_t rank = 0;
-
-    for (uint32_t mapIdx = 0; mapIdx < m->mapCount; mapIdx++) {
-        flex *map = getSubMap(m, mapIdx);
-        if (!map) {
-            continue;
-        }
-
-        flexEntry *entry = flexHead(map);
-        while (entry) {
-            flexEntry *memberEntry = flexNext(map, entry);
-            if (!memberEntry) {
-                break;
-            }
-
-            databox currentScore, currentMemberOrId;
-            flexGetByType(entry, &currentScore);
-            flexGetByType(memberEntry, &currentMemberOrId);
-
-            if (databoxCompare(&currentMemberOrId, &memberToMatch) == 0) {
-                return rank;
-            }
-
-            rank++;
-            entry = flexNext(map, memberEntry);
-        }
-    }
-
-    return -1;
+    return (int64_t)(rankBeforeSubMap(m, mapIdx) + localRank);
 }
 
 int64_t multiOrderedSetFullGetReverseRank(const multiOrderedSetFull *m,
@@ -1080,43 +1287,29 @@ bool multiOrderedSetFullGetByRank(const multiOrderedSetFull *m, int64_t rank,
         return false;
     }
 
-    int64_t currentRank = 0;
-
-    for (uint32_t mapIdx = 0; mapIdx < m->mapCount; mapIdx++) {
-        flex *map = getSubMap(m, mapIdx);
-        if (!map) {
-            continue;
-        }
-
-        size_t mapEntries = subMapCount(map);
-        if (currentRank + (int64_t)mapEntries <= rank) {
-            currentRank += (int64_t)mapEntries;
-            continue;
-        }
-
-        /* Target is in this map */
-        size_t localRank = (size_t)(rank - currentRank);
-        size_t offset = localRank * MOS_ELEMENTS_PER_ENTRY;
-
-        flexEntry *entry = flexIndex(map, offset);
-        if (!entry) {
-            return false;
-        }
-
-        flexEntry *memberEntry = flexNext(map, entry);
-        if (!memberEntry) {
-            return false;
-        }
+    size_t localRank;
+    const uint32_t mapIdx = findSubMapForRank(m, (uint64_t)rank, &localRank);
+    flex *map = getSubMap(m, mapIdx);
+    if (!map) {
+        return false;
+    }
 
-        flexGetByType(entry, score);
+    flexEntry *entry = flexIndex(map, localRank * MOS_ELEMENTS_PER_ENTRY);
+    if (!entry) {
+        return false;
+    }
 
-        /* In pool mode, convert pool ID back to member string */
-        databox memberOrId;
-        flexGetByType(memberEntry, &memberOrId);
-        return poolIdToMember(m, &memberOrId, member);
+    flexEntry *memberEntry = flexNext(map, entry);
+    if (!memberEntry) {
+        return false;
     }
 
-    return false;
+    flexGetByType(entry, score);
+
+    /* In pool mode, convert pool ID back to member string */
+    databox memberOrId;
+    flexGetByType(memberEntry, &memberOrId);
+    return poolIdToMember(m, &memberOrId, member);
 }
 
 /* ====================================================================
@@ -1127,7 +1320,8 @@ size_t multiOrderedSetFullCountByScore(const multiOrderedSetFull *m,
                                        const mosRangeSpec *range) {
     size_t count = 0;
 
-    for (uint32_t mapIdx = 0; mapIdx < m->mapCount; mapIdx++) {
+    for (uint32_t mapIdx = findSubMapForScore(m, &range->min);
+         mapIdx < m->mapCount; mapIdx++) {
         flex *map = getSubMap(m, mapIdx);
         if (!map) {
             continue;
@@ -1250,32 +1444,15 @@ bool multiOrderedSetFullIteratorInitAtRank(const multiOrderedSetFull *m,
         return false;
     }
 
-    int64_t currentRank = 0;
-
-    for (uint32_t mapIdx = 0; mapIdx < m->mapCount; mapIdx++) {
-        flex *map = getSubMap(m, mapIdx);
-        if (!map) {
-            continue;
-        }
-
-        size_t mapEntries = subMapCount(map);
-        if (currentRank + (int64_t)mapEntries <= rank) {
-            currentRank += (int64_t)mapEntries;
-            continue;
-        }
-
-        size_t localRank = (size_t)(rank - currentRank);
-        size_t offset = localRank * MOS_ELEMENTS_PER_ENTRY;
-
-        iter->mapIndex = mapIdx;
-        iter->current = flexIndex(map, offset);
-        iter->valid = (iter->current != NULL);
-        return iter->valid;
-    }
+    size_t localRank;
+    const uint32_t mapIdx = findSubMapForRank(m, (uint64_t)rank, &localRank);
+    flex *map = getSubMap(m, mapIdx);
 
-    iter->current = NULL;
-    iter->valid = false;
-    return false;
+    iter->mapIndex = mapIdx;
+    iter->current =
+        map ? flexIndex(map, localRank * MOS_ELEMENTS_PER_ENTRY) : NULL;
+    iter->valid = (iter->current != NULL);
+    return iter->valid;
 }
 
 bool multiOrderedSetFullIteratorNext(mosIterator *iter, databox *member,
@@ -1321,10 +1498,10 @@ bool multiOrderedSetFullIteratorNext(mosIterator *iter, databox *member,
         }
         iter->current = next;
     } else {
-        size_t currentOffset = entry - map;
-        if (currentOffset >= MOS_ELEMENTS_PER_ENTRY * 2) {
-            iter->current =
-                flexIndex(map, currentOffset - MOS_ELEMENTS_PER_ENTRY);
+        /* 'entry' is a byte position, so step back entry-by-entry */
+        flexEntry *prevMember = flexPrev(map, entry);
+        if (prevMember) {
+            iter->current = flexPrev(map, prevMember);
         } else {
             /* Move to previous map */
             iter->current = NULL;
@@ -1437,6 +1614,7 @@ size_t multiOrderedSetFullRandomMembers(const multiOrderedSetFull *m,
 #ifdef DATAKIT_TEST
 #include "ctest.h"
 #include "perf.h"
+#include "timeUtil.h"
 
 void multiOrderedSetFullRepr(const multiOrderedSetFull *m) {
     printf("multiOrderedSetFull {\n");
@@ -1476,6 +1654,53 @@ void multiOrderedSetFullRepr(const multiOrderedSetFull *m) {
     printf("}\n");
 }
 
+/* Verify sub-map invariants: no empty sub-maps (unless the set is empty),
+ * strictly increasing heads, rangeBox matching heads, and rankTree counts
+ * matching actual sub-map sizes. */
+static bool multiOrderedSetFullCheckSubMaps(const multiOrderedSetFull *m) {
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < m->mapCount; i++) {
+        flex *map = getSubMap(m, i);
+        const size_t count = subMapCount(map);
+        if (count == 0 && m->mapCount > 1) {
+            return false;
+        }
+
+        if (fenwickI64Get(m->rankTree, i) != (int64_t)count) {
+            return false;
+        }
+
+        if (count > 0) {
+            databox headScore, headMember;
+            flexGetByType(flexHead(map), &headScore);
+            flexGetByType(flexNext(map, flexHead(map)), &headMember);
+            if (databoxCompare(&headScore, getRangeBox(m, i)) != 0) {
+                return false;
+            }
+
+            if (i > 0 && compareSubMapHead(m, i - 1, &headScore,
+                                           &headMember) <= 0) {
+                return false;
+            }
+        }
+
+        total += count;
+    }
+
+    return total == m->totalEntries;
+}
+
+/* Linear rank walk over sub-maps; baseline for the rank tree benchmark */
+static uint64_t
+multiOrderedSetFullRankBeforeLinear(const multiOrderedSetFull *m,
+                                    uint32_t mapIdx) {
+    uint64_t rank = 0;
+    for (uint32_t i = 0; i < mapIdx; i++) {
+        rank += subMapCount(getSubMap(m, i));
+    }
+    return rank;
+}
+
 int multiOrderedSetFullTest(int argc, char *argv[]) {
     (void)argc;
     (void)argv;
@@ -1538,6 +1763,241 @@ int multiOrderedSetFullTest(int argc, char *argv[]) {
         multiOrderedSetFullFree(mos);
     }
 
+    TEST("multiOrderedSetFull — sub-map splits keep rank tree in sync") {
+        const int N = 20000;
+        multiOrderedSetFull *inlineSet = multiOrderedSetFullNew();
+        multiOrderedSetFull *poolSet =
+            multiOrderedSetFullNewWithPoolType(ATOM_POOL_HASH);
+        multiOrderedSetFull *sets[2] = {inlineSet, poolSet};
+
+        for (int s = 0; s < 2; s++) {
+            multiOrderedSetFull *mos = sets[s];
+
+            /* Few distinct scores so equal scores straddle split points */
+            for (int i = 0; i < N; i++) {
+                databox score = {.type = DATABOX_SIGNED_64,
+                                 .data.i = (int64_t)((i * 7919) % 97)};
+                char buf[32];
+                snprintf(buf, sizeof(buf), "member%06d", (i * 4999) % N);
+                databox member = databoxNewBytesAllowEmbed(buf, strlen(buf));
+                multiOrderedSetFullAdd(mos, &score, &member);
+            }
+
+            if (multiOrderedSetFullCount(mos) != (size_t)N) {
+                ERR("[%d] Count should be %d, got %zu", s, N,
+                    multiOrderedSetFullCount(mos));
+            }
+
+            if (mos->mapCount < 2) {
+                ERR("[%d] Expected sub-map splits, mapCount=%u", s,
+                    mos->mapCount);
+            }
+
+            if (!multiOrderedSetFullCheckSubMaps(mos)) {
+                ERR("[%d] Sub-map invariants broken after inserts", s);
+            }
+
+            /* Ranks agree with forward iteration order */
+            mosIterator iter;
+            databox m, sc, prevScore = {{0}};
+            int64_t rank = 0;
+            multiOrderedSetFullIteratorInit(mos, &iter, true);
+            while (multiOrderedSetFullIteratorNext(&iter, &m, &sc)) {
+                if (rank > 0 && databoxCompare(&prevScore, &sc) > 0) {
+                    ERR("[%d] Iteration out of order at rank %" PRId64, s,
+                        rank);
+                }
+
+                if (rank % 37 == 0) {
+                    int64_t got = multiOrderedSetFullGetRank(mos, &m);
+                    if (got != rank) {
+                        ERR("[%d] GetRank expected %" PRId64 " got %" PRId64,
+                            s, rank, got);
+                    }
+
+                    databox byRankMember, byRankScore;
+                    if (!multiOrderedSetFullGetByRank(mos, rank, &byRankMember,
+                                                      &byRankScore) ||
+                        databoxCompare(&byRankMember, &m) != 0) {
+                        ERR("[%d] GetByRank(%" PRId64 ") mismatch", s, rank);
+                    }
+                }
+
+                prevScore = sc;
+                rank++;
+            }
+
+            if (rank != N) {
+                ERR("[%d] Forward iteration saw %" PRId64 " entries", s, rank);
+            }
+
+            /* Reverse iteration crosses sub-maps too */
+            int64_t reverseSeen = 0;
+            multiOrderedSetFullIteratorInit(mos, &iter, false);
+            while (multiOrderedSetFullIteratorNext(&iter, &m, &sc)) {
+                reverseSeen++;
+            }
+
+            if (reverseSeen != N) {
+                ERR("[%d] Reverse iteration saw %" PRId64 " entries", s,
+                    reverseSeen);
+            }
+
+            /* Starting an iterator at a rank lands on that rank's entry */
+            databox expectMember, expectScore;
+            multiOrderedSetFullGetByRank(mos, N / 3, &expectMember,
+                                         &expectScore);
+            multiOrderedSetFullIteratorInitAtRank(mos, &iter, N / 3, true);
+            if (!multiOrderedSetFullIteratorNext(&iter, &m, &sc) ||
+                databoxCompare(&m, &expectMember) != 0) {
+                ERR("[%d] IteratorInitAtRank(%d) mismatch", s, N / 3);
+            }
+
+            /* Remove a rank range spanning several sub-maps */
+            size_t removed =
+                multiOrderedSetFullRemoveRangeByRank(mos, 1000, 8999);
+            if (removed != 8000 ||
+                multiOrderedSetFullCount(mos) != (size_t)N - 8000) {
+                ERR("[%d] RemoveRangeByRank removed %zu, count %zu", s,
+                    removed, multiOrderedSetFullCount(mos));
+            }
+
+            if (!multiOrderedSetFullCheckSubMaps(mos)) {
+                ERR("[%d] Sub-map invariants broken after rank removal", s);
+            }
+
+            /* Remove a score range and compare with CountByScore */
+            mosRangeSpec range = {
+                .min = {.type = DATABOX_SIGNED_64, .data.i = 40},
+                .max = {.type = DATABOX_SIGNED_64, .data.i = 60},
+                .minExclusive = false,
+                .maxExclusive = true};
+            size_t inRange = multiOrderedSetFullCountByScore(mos, &range);
+            size_t before = multiOrderedSetFullCount(mos);
+            removed = multiOrderedSetFullRemoveRangeByScore(mos, &range);
+            if (inRange == 0 || removed != inRange ||
+                multiOrderedSetFullCount(mos) != before - removed ||
+                multiOrderedSetFullCountByScore(mos, &range) != 0) {
+                ERR("[%d] RemoveRangeByScore removed %zu of %zu", s, removed,
+                    inRange);
+            }
+
+            if (!multiOrderedSetFullCheckSubMaps(mos)) {
+                ERR("[%d] Sub-map invariants broken after score removal", s);
+            }
+
+            /* Every remaining member is still findable and ranks agree */
+            rank = 0;
+            multiOrderedSetFullIteratorInit(mos, &iter, true);
+            while (multiOrderedSetFullIteratorNext(&iter, &m, &sc)) {
+                if (rank % 53 == 0 &&
+                    multiOrderedSetFullGetRank(mos, &m) != rank) {
+                    ERR("[%d] GetRank mismatch after removals at %" PRId64, s,
+                        rank);
+                }
+                rank++;
+            }
+
+            /* Drain from both ends so sub-maps empty out and get dropped */
+            databox members[64], scores[64];
+            while (multiOrderedSetFullCount(mos) > 0) {
+                multiOrderedSetFullPopMin(mos, 64, members, scores);
+                multiOrderedSetFullPopMax(mos, 64, members, scores);
+                if (!multiOrderedSetFullCheckSubMaps(mos)) {
+                    ERR("[%d] Sub-map invariants broken while popping", s);
+                    break;
+                }
+            }
+
+            if (mos->mapCount != 1) {
+                ERR("[%d] Drained set should have one sub-map, has %u", s,
+                    mos->mapCount);
+            }
+
+            multiOrderedSetFullFree(mos);
+        }
+    }
+
+    TEST("multiOrderedSetFull — copy and reset rebuild rank tree") {
+        multiOrderedSetFull *mos = multiOrderedSetFullNew();
+        for (int i = 0; i < 5000; i++) {
+            databox score = {.type = DATABOX_SIGNED_64, .data.i = i};
+            databox member = {.type = DATABOX_SIGNED_64, .data.i = -i};
+            multiOrderedSetFullAdd(mos, &score, &member);
+        }
+
+        multiOrderedSetFull *copy = multiOrderedSetFullCopy(mos);
+        if (!multiOrderedSetFullCheckSubMaps(copy)) {
+            ERRR("Copied set has inconsistent sub-maps");
+        }
+
+        for (int i = 0; i < 5000; i += 101) {
+            databox member = {.type = DATABOX_SIGNED_64, .data.i = -i};
+            if (multiOrderedSetFullGetRank(copy, &member) != i) {
+                ERR("Copy GetRank(%d) wrong", i);
+            }
+        }
+
+        multiOrderedSetFullReset(mos);
+        if (mos->mapCount != 1 || !multiOrderedSetFullCheckSubMaps(mos)) {
+            ERRR("Reset set has inconsistent sub-maps");
+        }
+
+        multiOrderedSetFullFree(copy);
+        multiOrderedSetFullFree(mos);
+    }
+
+    TEST("multiOrderedSetFull — PERF: rank tree vs linear sub-map walk") {
+        const int N = 1000000;
+        const int lookups = 200000;
+        multiOrderedSetFull *mos = multiOrderedSetFullNew();
+        for (int i = 0; i < N; i++) {
+            databox score = {.type = DATABOX_SIGNED_64, .data.i = i};
+            databox member = {.type = DATABOX_SIGNED_64, .data.i = i};
+            multiOrderedSetFullAdd(mos, &score, &member);
+        }
+
+        uint64_t checksum = 0;
+        uint64_t start = timeUtilMonotonicNs();
+        for (int i = 0; i < lookups; i++) {
+            checksum += multiOrderedSetFullRankBeforeLinear(
+                mos, (uint32_t)(((uint64_t)i * 7919) % mos->mapCount));
+        }
+        uint64_t linearNs = timeUtilMonotonicNs() - start;
+
+        start = timeUtilMonotonicNs();
+        for (int i = 0; i < lookups; i++) {
+            checksum -= rankBeforeSubMap(
+                mos, (uint32_t)(((uint64_t)i * 7919) % mos->mapCount));
+        }
+        uint64_t treeNs = timeUtilMonotonicNs() - start;
+
+        if (checksum != 0) {
+            ERRR("Rank tree prefix sums disagree with linear walk");
+        }
+
+        start = timeUtilMonotonicNs();
+        for (int i = 0; i < lookups; i++) {
+            databox member = {.type = DATABOX_SIGNED_64,
+                              .data.i = ((int64_t)i * 7919) % N};
+            if (multiOrderedSetFullGetRank(mos, &member) != member.data.i) {
+                ERR("GetRank(%" PRId64 ") wrong", member.data.i);
+                break;
+            }
+        }
+        uint64_t getRankNs = timeUtilMonotonicNs() - start;
+
+        printf("  %d entries in %u sub-maps:\n", N, mos->mapCount);
+        printf("    entries before sub-map, linear: %.1f ns/op\n",
+               (double)linearNs / lookups);
+        printf("    entries before sub-map, tree:   %.1f ns/op\n",
+               (double)treeNs / lookups);
+        printf("    GetRank total:                  %.1f ns/op\n",
+               (double)getRankNs / lookups);
+
+        multiOrderedSetFullFree(mos);
+    }
+
     TEST("multiOrderedSetFull — atomPool mode basic (both backends)") {
         /* Test both atomPool backends */
         atomPoolType types[] = {ATOM_POOL_HASH, ATOM_POOL_TREE};
@@ -29,6 +29,11 @@ multiOrderedSetFull *multiOrderedSetFullNewWithPoolType(atomPoolType type);
 multiOrderedSetFull *
 multiOrderedSetFullNewFromMedium(struct multiOrderedSetMedium *medium,
                                  flex *maps[2], uint32_t middles[2]);
+
+/* Build from 'entries' already sorted by mosCompareEntries() with unique
+ * members. Sub-maps are filled by appending, with no sorted inserts. */
+multiOrderedSetFull *multiOrderedSetFullNewFromSorted(const mosEntry *entries,
+                                                      size_t count);
 multiOrderedSetFull *multiOrderedSetFullCopy(const multiOrderedSetFull *m);
 void multiOrderedSetFullFree(multiOrderedSetFull *m);
 void multiOrderedSetFullReset(multiOrderedSetFull *m);
@@ -14,6 +14,13 @@
  *   - scoreMap: multiarray of flex for O(log n) sorted score operations
  *   - middle: multiarray of middle offsets for binary search
  *   - rangeBox: multiarray of score bounds for each sub-map
+ *   - rankTree: Fenwick tree of per-sub-map entry counts for rank lookups
+ *
+ * Sub-maps are kept in global (score, member) order and split in half
+ * once they grow past maxMapSize bytes. Only sub-map 0 may ever be empty
+ * (and only when the whole set is empty); any other sub-map is dropped as
+ * soon as its last entry is removed, so every head entry is a valid
+ * separator for binary search.
  *
  * This provides:
  *   - O(1) member existence check and score lookup
@@ -39,6 +46,7 @@ struct multiOrderedSetFull {
     multiarray *scoreMap;    /* flex *; sorted (score,member/memberID) */
     multiarray *middle;      /* uint32_t; middle offsets per sub-map */
     multiarray *rangeBox;    /* databox; score bounds per sub-map */
+    void *rankTree;          /* fenwickI64; entry count per sub-map */
     atomPool *pool;          /* Optional: atom pool for member interning */
     uint32_t mapCount;       /* Number of sub-maps */
     uint64_t
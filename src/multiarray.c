@@ -125,6 +125,92 @@ void multiarrayInsert(multiarray **m, multiarrayIdx idx, void *what) {
     MULTIARRAY_NORETURN(*m, Insert, idx, what);
 }
 
+void multiarrayAppendMany(multiarray **m, const void *src, size_t count) {
+    const uint8_t *from = src;
+    while (count) {
+        /* Small and Medium append only up to their upgrade point, so
+         * upgrade and continue with the rest. */
+        _multiarrayUpgrade(m);
+
+        size_t appended;
+        uint16_t len;
+        switch (_multiarrayType(*m)) {
+        case MULTIARRAY_TYPE_SMALL:
+            len = mars(*m)->len;
+            appended = multiarraySmallAppendMany(mars(*m), from, count);
+            break;
+        case MULTIARRAY_TYPE_MEDIUM:
+            len = marm(*m)->len;
+            appended = multiarrayMediumAppendMany(marm(*m), from, count);
+            break;
+        case MULTIARRAY_TYPE_LARGE:
+            len = marl(*m)->len;
+            appended = multiarrayLargeAppendMany(marl(*m), from, count);
+            break;
+        default:
+            assert(NULL);
+            __builtin_unreachable();
+        }
+
+        from += (size_t)len * appended;
+        count -= appended;
+    }
+}
+
+void multiarraySpanIteratorInit(multiarray *m, multiarraySpanIterator *iter) {
+    iter->container = _MULTIARRAY_USE(m);
+    iter->type = _multiarrayType(m);
+    iter->nodeIdx = 0;
+    iter->prev = NULL;
+    iter->node = iter->type == MULTIARRAY_TYPE_LARGE ? marl(m)->head : NULL;
+}
+
+bool multiarraySpanNext(multiarraySpanIterator *iter, void **start,
+                        uint32_t *count) {
+    switch (iter->type) {
+    case MULTIARRAY_TYPE_SMALL: {
+        const multiarraySmall *small = iter->container;
+        if (iter->nodeIdx++ == 0 && small->count) {
+            *start = small->data;
+            *count = small->count;
+            return true;
+        }
+
+        return false;
+    }
+    case MULTIARRAY_TYPE_MEDIUM: {
+        const multiarrayMedium *medium = iter->container;
+        while (iter->nodeIdx < medium->count) {
+            const multiarrayMediumNode *node = &medium->node[iter->nodeIdx++];
+            if (node->count) {
+                *start = node->data;
+                *count = node->count;
+                return true;
+            }
+        }
+
+        return false;
+    }
+    case MULTIARRAY_TYPE_LARGE:
+        while (iter->node) {
+            multiarrayLargeNode *node = iter->node;
+            iter->node = (multiarrayLargeNode *)((uintptr_t)iter->prev ^
+                                                 node->prevNext);
+            iter->prev = node;
+            if (node->count) {
+                *start = node->data;
+                *count = node->count;
+                return true;
+            }
+        }
+
+        return false;
+    default:
+        assert(NULL);
+        __builtin_unreachable();
+    }
+}
+
 void multiarrayDelete(multiarray **m, const uint32_t index) {
     /* TODO: auto-shrink behavior?  How to decide when to shrink
      * from Large -> Medium -> Small? */
@@ -138,6 +224,7 @@ void multiarrayFree(multiarray *m) {
 #ifdef DATAKIT_TEST
 
 #include "ctest.h"
+#include "timeUtil.h"
 
 typedef struct s16 {
     int64_t a;
@@ -615,6 +702,201 @@ int multiarrayTest(int argc, char *argv[]) {
 
     printf("\n=== All multiarray fuzz tests completed! ===\n\n");
 
+    TEST("append many across tier transitions") {
+        const size_t batches[] = {1, 7, 511, 512, 513, 5000};
+        for (size_t b = 0; b < sizeof(batches) / sizeof(*batches); b++) {
+            multiarray *mar = multiarrayNew(sizeof(s16), rowMax);
+            const int64_t total = 300000;
+            s16 *src = zmalloc(batches[b] * sizeof(*src));
+
+            /* Start with a few single inserts so appends land on a
+             * partially filled tail. */
+            int64_t next = 0;
+            for (; next < 3; next++) {
+                s16 val = {.a = next, .b = -next};
+                multiarrayInsert(&mar, next, &val);
+            }
+
+            while (next < total) {
+                size_t n = batches[b];
+                if ((int64_t)n > total - next) {
+                    n = total - next;
+                }
+
+                for (size_t i = 0; i < n; i++) {
+                    src[i] = (s16){.a = next + i, .b = -(next + (int64_t)i)};
+                }
+
+                multiarrayAppendMany(&mar, src, n);
+                next += n;
+            }
+
+            if (_multiarrayType(mar) != MULTIARRAY_TYPE_LARGE) {
+                ERR("Batch %zu: expected Large after %" PRId64 " entries!",
+                    batches[b], total);
+            }
+
+            for (int64_t i = 0; i < total; i += 7) {
+                const s16 *got = multiarrayGet(mar, i);
+                if (got->a != i || got->b != -i) {
+                    ERR("Batch %zu: entry %" PRId64 " is %" PRId64 "!",
+                        batches[b], i, got->a);
+                    break;
+                }
+            }
+
+            multiarraySpanIterator iter;
+            multiarraySpanIteratorInit(mar, &iter);
+            void *start;
+            uint32_t count;
+            int64_t seen = 0;
+            while (multiarraySpanNext(&iter, &start, &count)) {
+                const s16 *span = start;
+                for (uint32_t i = 0; i < count; i++) {
+                    if (span[i].a != seen + i) {
+                        ERR("Batch %zu: span entry %" PRId64 " is %" PRId64
+                            "!",
+                            batches[b], seen + i, span[i].a);
+                        break;
+                    }
+                }
+
+                seen += count;
+            }
+
+            if (seen != total) {
+                ERR("Batch %zu: spans covered %" PRId64 " of %" PRId64
+                    " entries!",
+                    batches[b], seen, total);
+            }
+
+            zfree(src);
+            multiarrayFree(mar);
+        }
+    }
+
+    TEST("append many interleaved with inserts and deletes") {
+        multiarray *mar = multiarrayNew(sizeof(s16), 16);
+        const int32_t maxEntries = 20000;
+        int64_t *oracle = zcalloc(maxEntries, sizeof(*oracle));
+        s16 src[40];
+        int32_t count = 0;
+        srand(4242);
+
+        for (int round = 0; round < 3000 && count + 40 < maxEntries;
+             round++) {
+            const int op = rand() % 3;
+            if (op == 0) {
+                const int n = 1 + rand() % 40;
+                for (int i = 0; i < n; i++) {
+                    src[i] = (s16){.a = round * 100 + i, .b = 0};
+                    oracle[count + i] = round * 100 + i;
+                }
+
+                multiarrayAppendMany(&mar, src, n);
+                count += n;
+            } else if (op == 1 || count == 0) {
+                const int32_t at = rand() % (count + 1);
+                s16 val = {.a = -round, .b = 0};
+                multiarrayInsert(&mar, at, &val);
+                memmove(&oracle[at + 1], &oracle[at],
+                        (count - at) * sizeof(*oracle));
+                oracle[at] = -round;
+                count++;
+            } else {
+                const int32_t at = rand() % count;
+                multiarrayDelete(&mar, at);
+                memmove(&oracle[at], &oracle[at + 1],
+                        (count - at - 1) * sizeof(*oracle));
+                count--;
+            }
+        }
+
+        int32_t seen = 0;
+        multiarraySpanIterator iter;
+        multiarraySpanIteratorInit(mar, &iter);
+        void *start;
+        uint32_t spanCount;
+        while (multiarraySpanNext(&iter, &start, &spanCount)) {
+            for (uint32_t i = 0; i < spanCount && seen < count; i++, seen++) {
+                if (((s16 *)start)[i].a != oracle[seen]) {
+                    ERR("Span entry %d is %" PRId64 ", expected %" PRId64 "!",
+                        seen, ((s16 *)start)[i].a, oracle[seen]);
+                    break;
+                }
+            }
+        }
+
+        if (seen != count) {
+            ERR("Spans covered %d of %d entries!", seen, count);
+        }
+
+        for (int32_t i = 0; i < count; i++) {
+            if (((s16 *)multiarrayGet(mar, i))->a != oracle[i]) {
+                ERR("Entry %d mismatch after mixed appends!", i);
+                break;
+            }
+        }
+
+        zfree(oracle);
+        multiarrayFree(mar);
+    }
+
+    TEST("PERF: append many and span iteration vs per-row calls") {
+        const int32_t total = 2000000;
+        s16 *src = zmalloc(total * sizeof(*src));
+        for (int32_t i = 0; i < total; i++) {
+            src[i] = (s16){.a = i, .b = i};
+        }
+
+        multiarray *one = multiarrayNew(sizeof(s16), rowMax);
+        int64_t start = timeUtilMonotonicNs();
+        for (int32_t i = 0; i < total; i++) {
+            multiarrayInsert(&one, i, &src[i]);
+        }
+        const int64_t insertNs = timeUtilMonotonicNs() - start;
+
+        multiarray *many = multiarrayNew(sizeof(s16), rowMax);
+        start = timeUtilMonotonicNs();
+        multiarrayAppendMany(&many, src, total);
+        const int64_t appendNs = timeUtilMonotonicNs() - start;
+
+        int64_t getSum = 0;
+        start = timeUtilMonotonicNs();
+        for (int32_t i = 0; i < total; i++) {
+            getSum += ((s16 *)multiarrayGet(many, i))->a;
+        }
+        const int64_t getNs = timeUtilMonotonicNs() - start;
+
+        int64_t spanSum = 0;
+        start = timeUtilMonotonicNs();
+        multiarraySpanIterator iter;
+        multiarraySpanIteratorInit(many, &iter);
+        void *span;
+        uint32_t count;
+        while (multiarraySpanNext(&iter, &span, &count)) {
+            const s16 *rows = span;
+            for (uint32_t i = 0; i < count; i++) {
+                spanSum += rows[i].a;
+            }
+        }
+        const int64_t spanNs = timeUtilMonotonicNs() - start;
+
+        if (getSum != spanSum) {
+            ERR("Get sum %" PRId64 " != span sum %" PRId64 "!", getSum,
+                spanSum);
+        }
+
+        printf("  %d rows: insert %.1f ns/row, append many %.2f ns/row; "
+               "get %.1f ns/row, spans %.2f ns/row\n",
+               total, (double)insertNs / total, (double)appendNs / total,
+               (double)getNs / total, (double)spanNs / total);
+
+        zfree(src);
+        multiarrayFree(one);
+        multiarrayFree(many);
+    }
+
     TEST_FINAL_RESULT;
 }
 
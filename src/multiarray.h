@@ -162,6 +162,25 @@ void multiarrayInsertAfter(multiarray **m, multiarrayIdx idx, void *what);
 void multiarrayInsertBefore(multiarray **m, multiarrayIdx idx, void *what);
 void multiarrayDelete(multiarray **m, const uint32_t index);
 
+/* Append 'count' entries of the container's width from 'src' to the end of
+ * 'm', filling node tails with memcpy and allocating whole nodes at once. */
+void multiarrayAppendMany(multiarray **m, const void *src, size_t count);
+
+/* Span iteration yields each run of contiguous entries in order: one run
+ * for Small, one per non-empty node for Medium and Large. Spans are
+ * invalidated by any insert or delete. */
+typedef struct multiarraySpanIterator {
+    void *container;
+    void *node;       /* Large: next node to yield */
+    void *prev;       /* Large: node before 'node' in the xor list */
+    uint32_t nodeIdx; /* Small/Medium: next node index to yield */
+    multiarrayType type;
+} multiarraySpanIterator;
+
+void multiarraySpanIteratorInit(multiarray *m, multiarraySpanIterator *iter);
+bool multiarraySpanNext(multiarraySpanIterator *iter, void **start,
+                        uint32_t *count);
+
 #if 0
 bool multiarrayDelRange(multiarray **m, const int64_t start, const int64_t stop);
 bool multiarrayReplaceAtIndex(multiarray **m, nodeId index, databox *box);
@@ -5,6 +5,7 @@
 #include "multiarrayMediumLarge.h"
 
 #include "datakit.h"
+#include "fenwick/fenwickI64.h"
 
 typedef struct multiarrayLargeResult {
     multiarrayLargeNode *prev;
@@ -16,6 +17,24 @@ typedef struct multiarrayLargeResult {
 
 typedef uintptr_t multiarrayLargeptrXorPtr;
 
+/* Lists with fewer nodes than this walk the xor list for positional lookups;
+ * the walk is cheaper than maintaining a directory at that size. */
+#define MULTIARRAY_LARGE_DIRECTORY_MIN_NODES 16
+
+/* multiarrayLargeDirectory maps list positions to nodes.
+ * 'node' is every node pointer in list order.
+ * 'counts' is a fenwickI64 of node->count per node.
+ * The directory exists exactly while the list has at least
+ * MULTIARRAY_LARGE_DIRECTORY_MIN_NODES nodes and is kept current by every
+ * mutation, so lookups (including const getters) only read it. Entry count
+ * changes inside a node and new tail nodes update 'counts' in place; a node
+ * added or removed elsewhere shifts 'node' and rebuilds 'counts' in O(n). */
+typedef struct multiarrayLargeDirectory {
+    multiarrayLargeNode **node;
+    void *counts;
+    uint32_t capacity;
+} multiarrayLargeDirectory;
+
 multiarrayLarge *multiarrayLargeNew(uint16_t len, uint16_t rowMax) {
     multiarrayLarge *e = zcalloc(1, sizeof(*e));
     e->len = len;
@@ -23,6 +42,7 @@ multiarrayLarge *multiarrayLargeNew(uint16_t len, uint16_t rowMax) {
 
     e->head = zcalloc(1, sizeof(*e->head));
     e->tail = e->head;
+    e->nodes = 1;
     return e;
 }
 
@@ -30,6 +50,7 @@ DK_STATIC void
 multiarrayLargeNodeInsertAfter(multiarrayLarge *mar,
                                const multiarrayLargeResult worker,
                                multiarrayLargeNode *newNode);
+static void multiarrayLargeDirSync(multiarrayLarge *mar);
 multiarrayLarge *multiarrayLargeFromMedium(multiarrayMedium *medium) {
     const uint16_t len = medium->len;
     const uint16_t rowMax = medium->rowMax;
@@ -55,12 +76,18 @@ multiarrayLarge *multiarrayLargeFromMedium(multiarrayMedium *medium) {
     /* All done with the medium inner node container */
     zfree(medium->node);
 
+    /* 'medium' is gone after the realloc, so keep its node count first */
+    const uint32_t nodes = medium->count;
+
     /* Now turn the medium container into a large container */
     multiarrayLarge *e = zrealloc(medium, sizeof(*e));
     e->head = head;
     e->tail = tmp.tail;
+    e->dir = NULL;
     e->len = len;
     e->rowMax = rowMax;
+    e->nodes = nodes;
+    multiarrayLargeDirSync(e);
 
     return e;
 }
@@ -74,8 +101,11 @@ multiarrayLarge *multiarrayLargeFromMedium(multiarrayMedium *medium) {
 #define getPrev(current, next) _ptrXor(current, (next)->prevNext)
 #endif
 
+static void multiarrayLargeDirFree(multiarrayLarge *mar);
 void multiarrayLargeFreeInside(multiarrayLarge *mar) {
     if (mar) {
+        multiarrayLargeDirFree(mar);
+
         multiarrayLargeNode *prev = NULL;
         multiarrayLargeNode *e = mar->head;
         while (e) {
@@ -122,6 +152,183 @@ multiarrayLargeGetForwardWorker(multiarrayLargeNode *e, int32_t idx,
     return worker;
 }
 
+/* ====================================================================
+ * Node directory
+ * ==================================================================== */
+static void multiarrayLargeDirFree(multiarrayLarge *mar) {
+    multiarrayLargeDirectory *dir = mar->dir;
+    if (dir) {
+        fenwickI64Free(dir->counts);
+        zfree(dir->node);
+        zfree(dir);
+        mar->dir = NULL;
+    }
+}
+
+static void multiarrayLargeDirReserve(multiarrayLargeDirectory *dir,
+                                      const uint32_t nodes) {
+    if (nodes > dir->capacity) {
+        uint32_t capacity = dir->capacity ? dir->capacity : 64;
+        while (capacity < nodes) {
+            capacity *= 2;
+        }
+
+        dir->node = zrealloc(dir->node, capacity * sizeof(*dir->node));
+        dir->capacity = capacity;
+    }
+}
+
+/* Rebuild 'counts' from the node array with the O(n) fenwick build. */
+static void multiarrayLargeDirCountsBuild(multiarrayLarge *mar) {
+    multiarrayLargeDirectory *dir = mar->dir;
+    int64_t *counts = zmalloc(mar->nodes * sizeof(*counts));
+    for (uint32_t pos = 0; pos < mar->nodes; pos++) {
+        counts[pos] = dir->node[pos]->count;
+    }
+
+    fenwickI64Free(dir->counts);
+    dir->counts = fenwickI64NewFromArray(counts, mar->nodes);
+    zfree(counts);
+}
+
+/* Create or drop the directory when the node count crosses the threshold.
+ * Creating walks the list once: O(nodes). */
+static void multiarrayLargeDirSync(multiarrayLarge *mar) {
+    if (mar->nodes < MULTIARRAY_LARGE_DIRECTORY_MIN_NODES) {
+        multiarrayLargeDirFree(mar);
+        return;
+    }
+
+    if (mar->dir) {
+        return;
+    }
+
+    multiarrayLargeDirectory *dir = mar->dir = zcalloc(1, sizeof(*dir));
+    multiarrayLargeDirReserve(dir, mar->nodes);
+
+    multiarrayLargeNode *prev = NULL;
+    multiarrayLargeNode *current = mar->head;
+    for (uint32_t pos = 0; pos < mar->nodes; pos++) {
+        dir->node[pos] = current;
+        multiarrayLargeNode *next = getNext(prev, current);
+        prev = current;
+        current = next;
+    }
+
+    multiarrayLargeDirCountsBuild(mar);
+}
+
+/* Apply an entry count change inside the node at directory position 'pos'. */
+static inline void multiarrayLargeDirAdjust(multiarrayLarge *mar,
+                                            const int32_t pos,
+                                            const int64_t delta) {
+    if (mar->dir) {
+        assert(pos >= 0);
+        fenwickI64Update(&mar->dir->counts, pos, delta);
+    }
+}
+
+/* 'node' was linked at directory position 'pos' ('mar->nodes' already
+ * includes it). 'moved' is true when entries also moved out of an existing
+ * node, so existing counts changed too.
+ * A plain new tail extends the directory in place; anything else shifts
+ * the node array and rebuilds counts in O(nodes). */
+static void multiarrayLargeDirInserted(multiarrayLarge *mar, const int32_t pos,
+                                       multiarrayLargeNode *node,
+                                       const bool moved) {
+    multiarrayLargeDirectory *dir = mar->dir;
+    if (!dir) {
+        /* No directory yet, so there were no positions to keep */
+        multiarrayLargeDirSync(mar);
+        return;
+    }
+
+    assert(pos >= 0);
+    const uint32_t at = pos;
+    multiarrayLargeDirReserve(dir, mar->nodes);
+    memmove(&dir->node[at + 1], &dir->node[at],
+            (mar->nodes - 1 - at) * sizeof(*dir->node));
+    dir->node[at] = node;
+
+    if (at == mar->nodes - 1 && !moved) {
+        fenwickI64Update(&dir->counts, at, node->count);
+    } else {
+        multiarrayLargeDirCountsBuild(mar);
+    }
+}
+
+/* The node at directory position 'pos' was unlinked ('mar->nodes' already
+ * excludes it). */
+static void multiarrayLargeDirDeleted(multiarrayLarge *mar,
+                                      const int32_t pos) {
+    multiarrayLargeDirectory *dir = mar->dir;
+    if (!dir) {
+        return;
+    }
+
+    if (mar->nodes < MULTIARRAY_LARGE_DIRECTORY_MIN_NODES) {
+        multiarrayLargeDirFree(mar);
+        return;
+    }
+
+    assert(pos >= 0);
+    const uint32_t at = pos;
+    memmove(&dir->node[at], &dir->node[at + 1],
+            (mar->nodes - at) * sizeof(*dir->node));
+    multiarrayLargeDirCountsBuild(mar);
+}
+
+/* Find the node holding forward index 'idx' through the directory.
+ * 'idx' may equal the total entry count, which resolves to one past the
+ * last entry of the tail node (the insert-at-end position).
+ * Returns false when the list is too small for a directory and the caller
+ * should walk the list instead. */
+static bool multiarrayLargeDirFind(const multiarrayLarge *mar,
+                                   const int32_t idx,
+                                   multiarrayLargeResult *worker,
+                                   int32_t *pos) {
+    const multiarrayLargeDirectory *dir = mar->dir;
+    if (!dir) {
+        return false;
+    }
+
+    const int64_t total = fenwickI64Query(dir->counts, mar->nodes - 1);
+    uint32_t found;
+    int32_t offset;
+    if (idx >= total) {
+        found = mar->nodes - 1;
+        offset = idx - (int32_t)(total - dir->node[found]->count);
+    } else {
+        found = (uint32_t)fenwickI64LowerBound(dir->counts, idx + 1);
+        offset = found ? idx - (int32_t)fenwickI64Query(dir->counts, found - 1)
+                       : idx;
+    }
+
+    multiarrayLargeNode *current = dir->node[found];
+    worker->prev = found ? dir->node[found - 1] : NULL;
+    worker->current = current;
+    worker->next = found + 1 < mar->nodes ? dir->node[found + 1] : NULL;
+    worker->entry = current->data + (mar->len * offset);
+    worker->offset = offset;
+    *pos = found;
+    return true;
+}
+
+/* Locate forward index 'idx' using the directory when available, else by
+ * walking nodes from head. 'pos' is the directory position of the found
+ * node, or -1 if the list has no directory. */
+static multiarrayLargeResult multiarrayLargeFind(const multiarrayLarge *mar,
+                                                 const int32_t idx,
+                                                 int32_t *pos) {
+    multiarrayLargeResult worker;
+    if (multiarrayLargeDirFind(mar, idx, &worker, pos)) {
+        return worker;
+    }
+
+    *pos = -1;
+    return multiarrayLargeGetForwardWorker(mar->head, idx, mar->len);
+}
+
 DK_STATIC void multiarrayLargeNodeDelete(multiarrayLarge *mar,
                                          const multiarrayLargeResult worker) {
     multiarrayLargeNode *prev = worker.prev;
@@ -163,6 +370,8 @@ DK_STATIC void multiarrayLargeNodeDelete(multiarrayLarge *mar,
 
     assert(mar->head && mar->tail);
 
+    mar->nodes--;
+
     /* Goodbye node */
     zfree(worker.current->data);
     zfree(worker.current);
@@ -196,6 +405,7 @@ multiarrayLargeNodeInsertAfter(multiarrayLarge *mar,
     /* reverse: current
      * forward: next */
     newNode->prevNext = (uintptr_t)current ^ (uintptr_t)next;
+    mar->nodes++;
     if (!next) {
         mar->tail = newNode;
     }
@@ -228,6 +438,7 @@ DK_STATIC void multiarrayLargeNodeInsert(multiarrayLarge *mar,
     /* reverse: prev
      * forward: current */
     newNode->prevNext = (uintptr_t)prev ^ (uintptr_t)current;
+    mar->nodes++;
     if (!prev) {
         mar->head = newNode;
     }
@@ -237,8 +448,8 @@ void multiarrayLargeInsert(multiarrayLarge *mar, const int32_t idx,
                            const void *s) {
     const uint16_t len = mar->len;
     const uint16_t rowMax = mar->rowMax;
-    multiarrayLargeResult worker =
-        multiarrayLargeGetForwardWorker(mar->head, idx, len);
+    int32_t pos;
+    multiarrayLargeResult worker = multiarrayLargeFind(mar, idx, &pos);
     multiarrayLargeNode *found = worker.current;
 
     const int32_t offset = worker.offset;
@@ -259,6 +470,7 @@ void multiarrayLargeInsert(multiarrayLarge *mar, const int32_t idx,
         multiarrayMediumLargeInsertAtIdx(found, remaining, remainingLen,
                                          offsetLen, found->count, s, len);
         found->count++;
+        multiarrayLargeDirAdjust(mar, pos, 1);
     } else { /* else, we need to add a new node and insert it somewhere. */
              /* split entries at 'offset', write 'offset' to smallest half. */
              /* [CURRENT] -> [SPLIT][OLD CURRENT]
@@ -273,20 +485,26 @@ void multiarrayLargeInsert(multiarrayLarge *mar, const int32_t idx,
 
             if (offset == 0) { /* found->count < rowMax; inserting at HEAD */
                 multiarrayLargeNodeInsert(mar, worker, split);
+                multiarrayLargeDirInserted(mar, pos, split, false);
             } else { /* inserting at TAIL */
                 multiarrayLargeNodeInsertAfter(mar, worker, split);
+                multiarrayLargeDirInserted(mar, pos < 0 ? pos : pos + 1,
+                                           split, false);
             }
         } else if (remaining < offset) {
             /* Inserting AFTER current */
             multiarrayLargeNodeInsertAfter(mar, worker, split);
             multiarrayMediumLargeNodeNewAfter(split, found, remaining,
                                               remainingLen, offsetLen, s, len);
+            multiarrayLargeDirInserted(mar, pos < 0 ? pos : pos + 1, split,
+                                       true);
         } else {
             /* Update pointers in prev, current, next. */
             /* Inserting BEFORE current */
             multiarrayLargeNodeInsert(mar, worker, split);
             multiarrayMediumLargeNodeNew(split, found, offset, remainingLen,
                                          offsetLen, s, len);
+            multiarrayLargeDirInserted(mar, pos, split, true);
         }
     }
 }
@@ -305,12 +523,33 @@ void *multiarrayLargeGet(const multiarrayLarge *mar, const int32_t idx) {
      * return the index directly. */
     const multiarrayLarge *prev = NULL;
     if (getNext(prev, startNode) == NULL) {
+        if (reverse && startNode->count) {
+            index = startNode->count - 1 - index;
+        }
+
         return startNode->data + (mar->len * index);
     }
 
-    /* TODO: verify index is proper for reverse after this return */
-    multiarrayLargeResult worker =
-        multiarrayLargeGetForwardWorker(startNode, index, mar->len);
+    multiarrayLargeResult worker;
+    int32_t pos;
+    if (mar->dir) {
+        if (reverse) {
+            /* Directory knows the total, so reverse becomes forward. */
+            index = (int32_t)fenwickI64Query(mar->dir->counts, mar->nodes - 1) +
+                    idx;
+        }
+
+        multiarrayLargeDirFind(mar, index, &worker, &pos);
+        return worker.entry;
+    }
+
+    /* Walking from tail counts entries backwards through each node. */
+    worker = multiarrayLargeGetForwardWorker(startNode, index, mar->len);
+    if (reverse) {
+        return worker.current->data +
+               (mar->len * (worker.current->count - 1 - worker.offset));
+    }
+
     return worker.entry;
 }
 
@@ -325,8 +564,13 @@ void *multiarrayLargeGetForward(const multiarrayLarge *mar,
         return startNode->data + (mar->len * index);
     }
 
-    multiarrayLargeResult worker =
-        multiarrayLargeGetForwardWorker(startNode, index, mar->len);
+    multiarrayLargeResult worker;
+    int32_t pos;
+    if (multiarrayLargeDirFind(mar, index, &worker, &pos)) {
+        return worker.entry;
+    }
+
+    worker = multiarrayLargeGetForwardWorker(startNode, index, mar->len);
     return worker.entry;
 }
 
@@ -349,8 +593,8 @@ void multiarrayLargeDelete(multiarrayLarge *mar, const int32_t idx) {
      *   3. Shrink count of elements in node by one. */
 
     const uint16_t len = mar->len;
-    multiarrayLargeResult worker =
-        multiarrayLargeGetForwardWorker(mar->head, idx, len);
+    int32_t pos;
+    multiarrayLargeResult worker = multiarrayLargeFind(mar, idx, &pos);
 
     multiarrayLargeNode *found = worker.current;
 
@@ -367,19 +611,68 @@ void multiarrayLargeDelete(multiarrayLarge *mar, const int32_t idx) {
 #endif
 
     if (found->count == 1) {
-        /* Delete entire node */
+        /* Delete entire node (or empty the last remaining node) */
+        const uint32_t nodes = mar->nodes;
         multiarrayLargeNodeDelete(mar, worker);
+        if (mar->nodes < nodes) {
+            multiarrayLargeDirDeleted(mar, pos);
+        } else {
+            multiarrayLargeDirAdjust(mar, pos, -1);
+        }
     } else {
         /* Delete found offset in node. */
         multiarrayMediumLargeDeleteAtIdx(found, remaining, remainingLen,
                                          offsetLen, found->count, mar->len);
         found->count--;
+        multiarrayLargeDirAdjust(mar, pos, -1);
     }
 }
 
+/* Append 'count' entries from 'src' by filling the tail node then linking
+ * whole new nodes of up to 'rowMax' entries after it.
+ * Returns number of entries appended (always 'count'). */
+size_t multiarrayLargeAppendMany(multiarrayLarge *mar, const void *src,
+                                 size_t count) {
+    const uint16_t len = mar->len;
+    const uint16_t rowMax = mar->rowMax;
+    const uint8_t *from = src;
+    size_t remaining = count;
+
+    multiarrayLargeNode *tail = mar->tail;
+    if (tail->count < rowMax && remaining) {
+        const size_t room = rowMax - tail->count;
+        const size_t take = remaining < room ? remaining : room;
+        tail->data = zrealloc(tail->data, len * (tail->count + take));
+        memcpy(tail->data + (len * tail->count), from, len * take);
+        tail->count += take;
+        multiarrayLargeDirAdjust(mar, mar->nodes - 1, take);
+        from += len * take;
+        remaining -= take;
+    }
+
+    while (remaining) {
+        const size_t take = remaining < rowMax ? remaining : rowMax;
+        multiarrayLargeNode *node = zcalloc(1, sizeof(*node));
+        node->data = zmalloc(len * take);
+        node->count = take;
+        memcpy(node->data, from, len * take);
+
+        const multiarrayLargeResult worker = {.current = mar->tail};
+        multiarrayLargeNodeInsertAfter(mar, worker, node);
+        multiarrayLargeDirInserted(mar, mar->dir ? (int32_t)mar->nodes - 1 : -1,
+                                   node, false);
+        from += len * take;
+        remaining -= take;
+    }
+
+    return count;
+}
+
 #ifdef DATAKIT_TEST
 #include "ctest.h"
 
+#include "timeUtil.h"
+
 #include <assert.h>
 
 typedef struct s16 {
@@ -563,6 +856,170 @@ int multiarrayLargeTest(int argc, char *argv[]) {
         multiarrayLargeFree(mar);
     }
 
+    TEST("convert from medium keeps node count and directory") {
+        const uint16_t mediumRowMax = 16;
+        multiarrayMedium *medium =
+            multiarrayMediumNew(sizeof(s16), mediumRowMax);
+        int32_t entries = 0;
+        while (medium->count < mediumRowMax && entries < 100000) {
+            const s16 s = {.a = entries, .b = -entries};
+            multiarrayMediumInsert(medium, entries, &s);
+            entries++;
+        }
+
+        const uint32_t mediumNodes = medium->count;
+        if (mediumNodes != mediumRowMax) {
+            ERR("Medium only grew to %u nodes!", mediumNodes);
+        }
+
+        multiarrayLarge *mar = multiarrayLargeFromMedium(medium);
+
+        uint32_t nodes = 0;
+        int32_t counted = 0;
+        multiarrayLargeNode *prev = NULL;
+        for (multiarrayLargeNode *n = mar->head; n;) {
+            multiarrayLargeNode *next = getNext(prev, n);
+            counted += n->count;
+            nodes++;
+            prev = n;
+            n = next;
+        }
+
+        if (nodes != mediumNodes || mar->nodes != nodes) {
+            ERR("Converted list has %u nodes, expected %u (recorded %u)!",
+                nodes, mediumNodes, mar->nodes);
+        }
+
+        if (counted != entries) {
+            ERR("Converted list has %d entries, expected %d!", counted,
+                entries);
+        }
+
+        if (nodes >= MULTIARRAY_LARGE_DIRECTORY_MIN_NODES && !mar->dir) {
+            ERRR("Converted list is missing its node directory!");
+        }
+
+        for (int32_t i = 0; i < entries; i++) {
+            const s16 *got = multiarrayLargeGet(mar, i);
+            if (got->a != i || multiarrayLargeGet(mar, i - entries) != got) {
+                ERR("Entry %d after conversion is %" PRId64 "!", i, got->a);
+                break;
+            }
+        }
+
+        multiarrayLargeFree(mar);
+    }
+
+    TEST("random insert/delete stays consistent with node directory") {
+        /* Small rows so the list crosses the directory threshold quickly
+         * and splits/deletes nodes often. */
+        multiarrayLarge *mar = multiarrayLargeNew(sizeof(s16), 8);
+        const int32_t maxEntries = 4000;
+        int64_t *shadow = zcalloc(maxEntries, sizeof(*shadow));
+        int32_t entries = 0;
+        uint64_t seed = 7;
+
+        for (int32_t round = 0; round < 40000; round++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const uint32_t r = (uint32_t)(seed >> 33);
+            const bool grow = entries < maxEntries / 2 || (r & 3) != 0;
+            if ((grow && entries < maxEntries) || entries == 0) {
+                const int32_t at = (r >> 2) % (entries + 1);
+                const s16 s = {.a = round, .b = -round};
+                multiarrayLargeInsert(mar, at, &s);
+                memmove(&shadow[at + 1], &shadow[at],
+                        (entries - at) * sizeof(*shadow));
+                shadow[at] = round;
+                entries++;
+            } else {
+                const int32_t at = (r >> 2) % entries;
+                multiarrayLargeDelete(mar, at);
+                memmove(&shadow[at], &shadow[at + 1],
+                        (entries - at - 1) * sizeof(*shadow));
+                entries--;
+            }
+
+            if (round % 500 == 0) {
+                for (int32_t i = 0; i < entries; i++) {
+                    const s16 *fwd = multiarrayLargeGet(mar, i);
+                    const s16 *rev = multiarrayLargeGet(mar, i - entries);
+                    const s16 *fwd2 = multiarrayLargeGetForward(mar, i);
+                    if (fwd->a != shadow[i] || fwd->b != -shadow[i] ||
+                        rev != fwd || fwd2 != fwd) {
+                        ERR("Entry %d expected %" PRId64 " but got %" PRId64
+                            " (reverse %" PRId64 ") with %u nodes!",
+                            i, shadow[i], fwd->a, rev->a, mar->nodes);
+                        break;
+                    }
+                }
+            }
+        }
+
+        uint32_t nodes = 0;
+        int32_t counted = 0;
+        multiarrayLargeNode *prev = NULL;
+        for (multiarrayLargeNode *n = mar->head; n;) {
+            multiarrayLargeNode *next = getNext(prev, n);
+            counted += n->count;
+            nodes++;
+            prev = n;
+            n = next;
+        }
+
+        if (nodes != mar->nodes || counted != entries) {
+            ERR("List has %u nodes and %d entries, expected %u and %d!", nodes,
+                counted, mar->nodes, entries);
+        }
+
+        zfree(shadow);
+        multiarrayLargeFree(mar);
+    }
+
+    TEST("PERF: random get with node directory vs node walk") {
+        multiarrayLarge *mar = multiarrayLargeNew(sizeof(s16), rowMax);
+        const int32_t total = 2000000;
+        for (int32_t i = 0; i < total; i++) {
+            const s16 s = {.a = i, .b = i};
+            multiarrayLargeInsert(mar, i, &s);
+        }
+
+        const size_t rounds = 20000;
+        uint64_t seed = 1;
+        int64_t sink = 0;
+
+        int64_t walkStart = timeUtilMonotonicNs();
+        for (size_t r = 0; r < rounds; r++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const int32_t idx = (int32_t)((seed >> 33) % total);
+            const multiarrayLargeResult got =
+                multiarrayLargeGetForwardWorker(mar->head, idx, sizeof(s16));
+            sink += ((s16 *)got.entry)->a;
+        }
+        int64_t walkNs = timeUtilMonotonicNs() - walkStart;
+
+        seed = 1;
+        int64_t getStart = timeUtilMonotonicNs();
+        for (size_t r = 0; r < rounds; r++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const int32_t idx = (int32_t)((seed >> 33) % total);
+            const s16 *got = multiarrayLargeGet(mar, idx);
+            if (got->a != idx) {
+                ERR("Get %d returned %" PRId64 "!", idx, got->a);
+                break;
+            }
+
+            sink += got->a;
+        }
+        int64_t getNs = timeUtilMonotonicNs() - getStart;
+
+        printf("%d entries in %u nodes; node walk: %.1f ns/get, "
+               "directory: %.1f ns/get (%" PRId64 ")\n",
+               total, mar->nodes, (double)walkNs / rounds,
+               (double)getNs / rounds, sink & 1);
+
+        multiarrayLargeFree(mar);
+    }
+
     TEST_FINAL_RESULT;
 }
 
@@ -19,6 +19,8 @@ void multiarrayLargeFree(multiarrayLarge *e);
 void multiarrayLargeInsert(multiarrayLarge *mar, const int32_t idx,
                            const void *s);
 void multiarrayLargeDelete(multiarrayLarge *mar, const int32_t idx);
+size_t multiarrayLargeAppendMany(multiarrayLarge *mar, const void *src,
+                                 size_t count);
 void *multiarrayLargeGet(const multiarrayLarge *mar, const int32_t idx);
 void *multiarrayLargeGetForward(const multiarrayLarge *mar,
                                 const uint32_t index);
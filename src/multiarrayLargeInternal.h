@@ -11,16 +11,21 @@ typedef struct multiarrayLargeNode {
     uint64_t count : 16;    /* we should only have max 32k entries per node. */
 } multiarrayLargeNode;
 
-/* multiarrayLarge is a 24 byte struct.
+/* multiarrayLarge is a 32 byte struct.
  * 'head' is a direct pointer to the head of the doubly linked xor node list.
  * 'tail' is a direct pointer to the tail of the doubly linked xor node list.
+ * 'dir' is a lazily built directory of node pointers and per-node entry
+ *       counts for index-to-node lookups without walking the node list.
+ *       NULL until the list first has enough nodes to need it.
  * 'len' is the width of every data entry inside every node.
  * 'rowMax' is the maximum number of entires in each node before we create
- *          a new node. */
+ *          a new node.
+ * 'nodes' is the number of nodes in the list. */
 struct multiarrayLarge {
     multiarrayLargeNode *head;
     multiarrayLargeNode *tail;
+    struct multiarrayLargeDirectory *dir;
     uint16_t len;    /* width of individual node->data entires */
     uint16_t rowMax; /* maximum entries per node before creating new node */
-    /* 4 bytes padding */
+    uint32_t nodes;  /* number of nodes in the xor list */
 };
@@ -293,6 +293,51 @@ void multiarrayMediumDelete(multiarrayMedium *mar, const int32_t idx) {
     }
 }
 
+/* Append up to 'count' entries from 'src' by filling the tail node then
+ * adding whole nodes, stopping once we have 'rowMax' full nodes (the point
+ * where multiarray upgrades Medium to Large).
+ * Returns number of entries appended. */
+size_t multiarrayMediumAppendMany(multiarrayMedium *mar, const void *src,
+                                  size_t count) {
+    const uint16_t len = mar->len;
+    const uint16_t rowMax = mar->rowMax;
+    const uint8_t *from = src;
+    size_t appended = 0;
+
+    /* Grow node array once for every new node this append can use. */
+    uint32_t nodeIdx = mar->count - 1;
+    const size_t tailRoom = rowMax - getNode(nodeIdx)->count;
+    if (count > tailRoom && mar->count < rowMax) {
+        size_t newNodes = (count - tailRoom + rowMax - 1) / rowMax;
+        if (newNodes > (size_t)(rowMax - mar->count)) {
+            newNodes = rowMax - mar->count;
+        }
+
+        mar->node =
+            zrealloc(mar->node, (mar->count + newNodes) * sizeof(*mar->node));
+        memset(mar->node + mar->count, 0, newNodes * sizeof(*mar->node));
+        mar->count += newNodes;
+    }
+
+    /* Fill the old tail, then each new node in order. */
+    for (; nodeIdx < mar->count && appended < count; nodeIdx++) {
+        multiarrayMediumNode *node = getNode(nodeIdx);
+        const size_t room = rowMax - node->count;
+        const size_t take = count - appended < room ? count - appended : room;
+        if (!take) {
+            continue;
+        }
+
+        node->data = zrealloc(node->data, len * (node->count + take));
+        memcpy(node->data + (len * node->count), from, len * take);
+        node->count += take;
+        from += len * take;
+        appended += take;
+    }
+
+    return appended;
+}
+
 #ifdef DATAKIT_TEST
 #include "ctest.h"
 
@@ -21,6 +21,8 @@ void multiarrayMediumFree(multiarrayMedium *e);
 void multiarrayMediumInsert(multiarrayMedium *mar, const int32_t idx,
                             const void *s);
 void multiarrayMediumDelete(multiarrayMedium *mar, const int32_t idx);
+size_t multiarrayMediumAppendMany(multiarrayMedium *mar, const void *src,
+                                  size_t count);
 void *multiarrayMediumGet(const multiarrayMedium *mar, const int32_t idx);
 void *multiarrayMediumGetForward(const multiarrayMedium *mar,
                                  const uint32_t idx);
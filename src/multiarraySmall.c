@@ -41,6 +41,21 @@ void multiarraySmallDelete(multiarraySmall *mar, uint16_t idx) {
     mar->count--;
 }
 
+/* Append up to 'count' entries from 'src' without growing beyond 'rowMax'.
+ * Returns number of entries appended. */
+size_t multiarraySmallAppendMany(multiarraySmall *mar, const void *src,
+                                 size_t count) {
+    const size_t room = mar->rowMax > mar->count ? mar->rowMax - mar->count : 0;
+    const size_t take = count < room ? count : room;
+    if (take) {
+        mar->data = zrealloc(mar->data, _mo(mar->count + take));
+        memcpy(mar->data + _mo(mar->count), src, _mo(take));
+        mar->count += take;
+    }
+
+    return take;
+}
+
 #ifdef DATAKIT_TEST
 
 #include "ctest.h"
@@ -83,6 +83,12 @@ typedef enum multilistType {
 #define MULTILIST_SINGLE_NORETURN(m, func) _MULTILIST_SINGLE(, m, func)
 #define MULTILIST_SINGLE_RETURN(m, func) _MULTILIST_SINGLE(return, m, func)
 
+/* flexCapSizeLimit only needs the low bits of the limit byte, so Small and
+ * Medium carry the "defer compression" request in the high bit until they
+ * upgrade to Full (which tracks deferral itself). */
+#define MULTILIST_LIMIT_DEFER 0x80
+#define mlCompressLimit(m) (COMPRESS_LIMIT(m) & ~MULTILIST_LIMIT_DEFER)
+
 /* ====================================================================
  * Manage
  * ==================================================================== */
@@ -146,27 +152,73 @@ static void multilistUpgradeIfNecessary(multilist **m, mflexState *state,
                                         const uint_fast32_t depth,
                                         const uint_fast32_t limit) {
     const multilistType type = _multilistType(*m);
+    const uint_fast32_t sizeLimit = limit & ~MULTILIST_LIMIT_DEFER;
     if (type == MULTILIST_TYPE_SMALL) {
         multilistSmall *small = mls(*m);
         /* Statically defined growth cases: fix?  parameterize?  modularize? */
-        if (multilistSmallBytes(small) > flexOptimizationSizeLimit[limit]) {
+        if (multilistSmallBytes(small) > flexOptimizationSizeLimit[sizeLimit]) {
             multilistMedium *medium =
                 multilistMediumNewFromFlexConsumeGrow(small, small->fl);
-            *m = SET_COMPRESS_DEPTH_LIMIT(medium, depth, limit);
-            *m = _MULTILIST_TAG(medium, MULTILIST_TYPE_MEDIUM);
+            *m = _MULTILIST_TAG(SET_COMPRESS_DEPTH_LIMIT(medium, depth, limit),
+                                MULTILIST_TYPE_MEDIUM);
         }
     } else if (type == MULTILIST_TYPE_MEDIUM) {
         multilistMedium *medium = mlm(*m);
         if (multilistMediumBytes(medium) >
-            (flexOptimizationSizeLimit[limit] * 3)) {
+            (flexOptimizationSizeLimit[sizeLimit] * 3)) {
             flex *f[2] = {medium->fl[0], medium->fl[1]};
             multilistFull *full = multilistFullNewFromFlexConsumeGrow(
-                medium, state, f, 2, depth, limit);
+                medium, state, f, 2, depth, sizeLimit);
+            if (limit & MULTILIST_LIMIT_DEFER) {
+                multilistFullSetCompressDeferred(full, state, true);
+            }
+
             *m = _MULTILIST_TAG(full, MULTILIST_TYPE_FULL);
         }
     } /* else, is FULL and no grow necessary. */
 }
 
+/* ====================================================================
+ * Deferred compression
+ * ==================================================================== */
+void multilistSetCompressDeferred(multilist **m, mflexState *state,
+                                  const bool deferred) {
+    if (_multilistType(*m) == MULTILIST_TYPE_FULL) {
+        multilistFullSetCompressDeferred(mlf(*m), state, deferred);
+        return;
+    }
+
+    const multilistType type = _multilistType(*m);
+    const uint32_t depth = COMPRESS_DEPTH(*m);
+    uint32_t limit = mlCompressLimit(*m);
+    if (deferred) {
+        limit |= MULTILIST_LIMIT_DEFER;
+    }
+
+    *m = _MULTILIST_TAG(SET_COMPRESS_DEPTH_LIMIT(_MULTILIST_USE(*m), depth,
+                                                 limit),
+                        type);
+}
+
+size_t multilistCompressPending(multilist *m, mflexState *state,
+                                const size_t budget) {
+    /* Small and Medium never compress, so they never have pending nodes. */
+    if (_multilistType(m) == MULTILIST_TYPE_FULL) {
+        return multilistFullCompressPending(mlf(m), state, budget);
+    }
+
+    return 0;
+}
+
+void multilistGetCompressStats(const multilist *m,
+                               multilistCompressStats *stats) {
+    if (_multilistType(m) == MULTILIST_TYPE_FULL) {
+        multilistFullCompressStats(mlf(m), stats);
+    } else {
+        *stats = (multilistCompressStats){0};
+    }
+}
+
 /* ====================================================================
  * Insert
  * ==================================================================== */
@@ -365,6 +417,46 @@ int multilistTest(int argc, char *argv[]) {
     int64_t runtime[depthCount];
     const int defaultCompressSizeLimit = 1;
 
+    TEST("deferred compression survives upgrade to full") {
+        multilist *ml = multilistNew(defaultCompressSizeLimit, 1);
+        multilistSetCompressDeferred(&ml, s0, true);
+
+        char buf[64];
+        memset(buf, 'U', sizeof(buf));
+        for (int i = 0; i < 5000; i++) {
+            const databox box = databoxNewBytes(buf, sizeof(buf));
+            multilistPushByTypeTail(&ml, s0, &box);
+        }
+
+        if (_multilistType(ml) != MULTILIST_TYPE_FULL) {
+            ERRR("List did not upgrade to full!");
+        }
+
+        /* Depth and the deferral request must carry through Small and
+         * Medium into Full, so interior nodes get queued. */
+        multilistCompressStats stats;
+        multilistGetCompressStats(ml, &stats);
+        if (!stats.pending || stats.compressed) {
+            ERR("Expected queued nodes after upgrade, got %zu pending!",
+                stats.pending);
+        }
+
+        const size_t pending = stats.pending;
+        const size_t compressed =
+            multilistCompressPending(ml, s0, SIZE_MAX);
+        multilistGetCompressStats(ml, &stats);
+        if (!compressed || stats.pending || compressed > pending) {
+            ERR("Drain compressed %zu of %zu pending nodes!", compressed,
+                pending);
+        }
+
+        if (multilistCount(ml) != 5000) {
+            ERROR;
+        }
+
+        multilistFree(ml);
+    }
+
     for (size_t _i = 0; _i < depthCount; _i++) {
         printf("Testing Option %d\n", depth[_i]);
         int64_t start = timeUtilMs();
@@ -1299,6 +1391,73 @@ int multilistTest(int argc, char *argv[]) {
         mflexStateReset(s0);
         mflexStateReset(s1);
 
+        for (size_t f = 0; f < flexOptimizationSizeLimits; f++) {
+            TEST_DESC("medium iterator at index test at fill %zu at compress "
+                      "%d",
+                      f, depth[_i]) {
+                multilist *ml = multilistNew(f, depth[_i]);
+                int64_t nums[5000];
+                int count = 0;
+
+                /* Push until the list leaves Small, then stop while it is
+                 * still Medium so iteration runs across both Medium flexes. */
+                while (count < 5000 &&
+                       _multilistType(ml) != MULTILIST_TYPE_MEDIUM) {
+                    nums[count] = count;
+                    const databox pushBox = DATABOX_SIGNED(nums[count]);
+                    multilistPushByTypeTail(&ml, s0, &pushBox);
+                    count++;
+                }
+
+                /* The largest fill limits hold 5000 small integers without
+                 * leaving Small, so there is no Medium tier to check. */
+                if (_multilistType(ml) != MULTILIST_TYPE_MEDIUM) {
+                    count = 0;
+                }
+
+                for (int start = 0; start < count; start++) {
+                    multilistEntry entry;
+                    multilistIterator iter = {0};
+                    multilistIteratorInitAtIdxForwardReadOnly(ml, s, &iter,
+                                                              start);
+                    int i = start;
+                    while (multilistNext(&iter, &entry)) {
+                        if (i >= count || entry.box.data.i64 != nums[i]) {
+                            ERR("Forward from %d at %d: got %" PRIi64 "",
+                                start, i, entry.box.data.i64);
+                            break;
+                        }
+
+                        i++;
+                    }
+
+                    if (i != count) {
+                        ERR("Forward from %d stopped at %d of %d", start, i,
+                            count);
+                    }
+
+                    multilistIteratorInitAtIdxReverseReadOnly(ml, s, &iter,
+                                                              start);
+                    i = start;
+                    while (multilistNext(&iter, &entry)) {
+                        if (i < 0 || entry.box.data.i64 != nums[i]) {
+                            ERR("Reverse from %d at %d: got %" PRIi64 "",
+                                start, i, entry.box.data.i64);
+                            break;
+                        }
+
+                        i--;
+                    }
+
+                    if (i != -1) {
+                        ERR("Reverse from %d stopped at %d", start, i);
+                    }
+                }
+
+                multilistFree(ml);
+            }
+        }
+
         for (size_t f = 0; f < flexOptimizationSizeLimits; f++) {
             TEST_DESC("iterator at index test at fill %zu at compress %d", f,
                       depth[_i]) {
@@ -31,6 +31,16 @@ void multilistSetOptions(multilist *ml, int fill, int depth);
 size_t multilistCount(const multilist *m);
 size_t multilistBytes(const multilist *m);
 
+/* Deferred compression: interior nodes leaving the uncompressed depth window
+ * stay uncompressed (and readable) until multilistCompressPending() runs,
+ * so callers can move compression off latency-sensitive insert paths. */
+void multilistSetCompressDeferred(multilist **m, mflexState *state,
+                                  bool deferred);
+size_t multilistCompressPending(multilist *m, mflexState *state,
+                                size_t budget);
+void multilistGetCompressStats(const multilist *m,
+                               multilistCompressStats *stats);
+
 /* TODO: add multi-argument versions so we can, e.g. append
  *       40 databoxes at once as efficiently as possible. */
 void multilistPushByTypeHead(multilist **m, mflexState *state,
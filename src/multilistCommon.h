@@ -55,4 +55,12 @@ typedef struct multilistEntry {
     flex *f; /* Full only */
 } multilistEntry;
 
+/* Deferred compression queue depth and progress (Full lists only). */
+typedef struct multilistCompressStats {
+    size_t pending;      /* nodes waiting for multilistCompressPending() */
+    size_t pendingPeak;  /* largest 'pending' observed */
+    uint64_t deferred;   /* nodes ever queued instead of compressed inline */
+    uint64_t compressed; /* queued nodes compressed by CompressPending */
+} multilistCompressStats;
+
 typedef mflexState multilistState;
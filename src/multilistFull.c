@@ -21,6 +21,7 @@
 
 #include "datakit.h"
 
+#include "fenwick/fenwickI64.h"
 #include "flexCapacityManagement.h"
 #include "mflex.h"
 #include "multilistFull.h"
@@ -28,13 +29,22 @@
 /* ====================================================================
  * Management Defines, Types, and Macros
  * ==================================================================== */
-/* multilistFull is a 24 byte struct.
+/* multilistFull is a 48 byte struct.
  * 'node' is a multiarray of 'mflex *'
  * 'values' is the number of all elements across all mflexes
  * 'count' is the number of nodes
  * 'fill' is either the size-based limit to reach before making a new node
  * 'compress' is 0 if compression is disabled - or - it is the number of
  *            nodes to leave uncompressed from both sides of the list.
+ * 'rankTree' is a fenwick tree of per-node value counts so positional
+ *            lookups find their node in O(log n) instead of walking nodes.
+ * 'rankValid' is false when nodes were inserted before the tail or
+ *             removed since the last rebuild of 'rankTree'; value count
+ *             changes inside an existing node and new tail nodes are
+ *             applied to 'rankTree' directly.
+ * 'defer' is NULL when nodes leaving the uncompressed depth window are
+ *         compressed immediately; otherwise it queues them for
+ *         multilistFullCompressPending().
  * Note: head/tail nodes are *never* compressed. */
 struct multilistFull {
     multiarray *node;  /* array nodes holding flexes */
@@ -42,8 +52,26 @@ struct multilistFull {
     mlNodeId count;    /* number of mflexes */
     uint16_t fill;     /* fill factor for individual nodes */
     uint16_t compress; /* depth of end nodes not to compress;0=off */
+    void *rankTree;    /* fenwickI64; value count per node */
+    bool rankValid;    /* rankTree matches current node layout */
+    struct mlCompressDefer *defer; /* deferred compression queue */
 };
 
+/* Interior nodes waiting for compression. Node indexes are shifted as
+ * nodes are inserted or deleted so they always name the queued node. */
+typedef struct mlCompressDefer {
+    mlNodeId *nodes;
+    mlNodeId highest; /* upper bound of queued indexes; tail-side grows and
+                         deletes past it skip the queue scan */
+    uint32_t count;
+    uint32_t capacity;
+    multilistCompressStats stats;
+} mlCompressDefer;
+
+/* Lists with fewer nodes than this walk nodes directly for positional
+ * lookups; the walk is cheaper than maintaining 'rankTree' at that size. */
+#define RANK_TREE_MIN_NODES 16
+
 /* STORAGE_MAX is the maximum number of entires in our
  * mflex array before it grows to a new multiarray
  * storage type.  The larger the number, the more reallocation
@@ -58,6 +86,40 @@ struct multilistFull {
  *    2048 = 16384 byte array (8 * 2048 nodes) */
 #define STORAGE_MAX 2048
 
+/* Keep queued node indexes pointing at the same nodes after a node is
+ * inserted at (or deleted from) position 'idx'. */
+static void mlDeferShift(multilistFull *ml, const mlNodeId idx,
+                         const bool inserted) {
+    mlCompressDefer *defer = ml->defer;
+    if (!defer || !defer->count || idx > defer->highest) {
+        return;
+    }
+
+    if (inserted) {
+        defer->highest++;
+    } else if (defer->highest) {
+        defer->highest--;
+    }
+
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < defer->count; i++) {
+        mlNodeId node = defer->nodes[i];
+        if (inserted) {
+            node += node >= idx;
+        } else if (node == idx) {
+            /* Queued node deleted; nothing left to compress. */
+            continue;
+        } else {
+            node -= node > idx;
+        }
+
+        defer->nodes[kept++] = node;
+    }
+
+    defer->count = kept;
+    defer->stats.pending = kept;
+}
+
 /* Note: We use 'uintptr_t' as the underlying type because
  *       the 'mflex' type is not complete and can't be dereferenced. */
 #define MAR_MFLEX_STORAGE uintptr_t *
@@ -66,6 +128,8 @@ struct multilistFull {
     do {                                                                       \
         multiarrayNativeInsert(_m->node, MAR_MFLEX_STORAGE, STORAGE_MAX,       \
                                _m->count, idx, &_data);                        \
+        mlRankNodeInserted(_m, idx, _data);                                    \
+        mlDeferShift(_m, idx, true);                                           \
     } while (0)
 
 #define reallocIncrCountBefore(_m, idx, node) _reallocGrowNode(_m, idx, node)
@@ -79,6 +143,8 @@ struct multilistFull {
         mflexFree(getNodeMl(_m, idx));                                         \
         multiarrayNativeDelete((_m)->node, MAR_MFLEX_STORAGE, (_m)->count,     \
                                idx);                                           \
+        (_m)->rankValid = false;                                               \
+        mlDeferShift(_m, idx, false);                                          \
     } while (0)
 
 #define getNode(idx) getNodeMl(ml, idx)
@@ -106,6 +172,63 @@ static inline mflex **getNodeMlPtr(const multilistFull *ml,
     return (mflex **)m;
 }
 
+/* Apply a value count change inside existing node 'nodeIdx' to 'rankTree'.
+ * Node insert/delete invalidates the whole tree instead (every later node
+ * shifts position), so only in-place count changes come through here. */
+static inline void mlRankAdjust(multilistFull *ml, const mlNodeId nodeIdx,
+                                const int64_t delta) {
+    if (ml->rankValid && !fenwickI64Update(&ml->rankTree, nodeIdx, delta)) {
+        ml->rankValid = false;
+    }
+}
+
+/* Account for 'node' just inserted at 'nodeIdx'. A new tail node shifts
+ * nothing, so it only extends 'rankTree'; any other insert invalidates it.
+ * (Placeholder NULL nodes get their contents later, so they invalidate.) */
+static inline void mlRankNodeInserted(multilistFull *ml, const mlNodeId nodeIdx,
+                                      const mflex *node) {
+    if (node && nodeIdx == ml->count - 1) {
+        mlRankAdjust(ml, nodeIdx, (int64_t)mflexCount(node));
+    } else {
+        ml->rankValid = false;
+    }
+}
+
+static void mlRankRebuild(multilistFull *ml) {
+    int64_t *counts = zmalloc(ml->count * sizeof(*counts));
+    for (mlNodeId i = 0; i < ml->count; i++) {
+        counts[i] = (int64_t)mflexCount(getNode(i));
+    }
+
+    /* Linear-time construction from the per-node counts */
+    fenwickI64Free(ml->rankTree);
+    ml->rankTree = fenwickI64NewFromArray(counts, ml->count);
+    ml->rankValid = ml->rankTree != NULL;
+    zfree(counts);
+}
+
+/* Find node holding forward offset 'index' (0 <= index < ml->values).
+ * Populates 'nodeIdx' and the forward offset of 'index' inside that node. */
+static bool mlRankFind(multilistFull *ml, const mlOffsetId index,
+                       mlNodeId *nodeIdx, int32_t *offset) {
+    if (!ml->rankValid) {
+        mlRankRebuild(ml);
+        if (!ml->rankValid) {
+            return false;
+        }
+    }
+
+    const size_t found = fenwickI64LowerBound(ml->rankTree, index + 1);
+    if (found >= (size_t)ml->count) {
+        return false;
+    }
+
+    *nodeIdx = (mlNodeId)found;
+    const int64_t before = found ? fenwickI64Query(ml->rankTree, found - 1) : 0;
+    *offset = (int32_t)(index - before);
+    return true;
+}
+
 /* Create a new multilistFull.
  * Free with multilistFullFree(). */
 multilistFull *multilistFullCreate(void) {
@@ -182,6 +305,12 @@ void multilistFullFree(multilistFull *ml) {
         }
 
         assert(ml->values == 0);
+        fenwickI64Free(ml->rankTree);
+        if (ml->defer) {
+            zfree(ml->defer->nodes);
+            zfree(ml->defer);
+        }
+
         multiarrayNativeFree(ml->node);
         zfree(ml);
     }
@@ -216,17 +345,125 @@ static inline mflex **mlTailPtr(const multilistFull *ml) {
     return (mflex **)m;
 }
 
+/* Defer compression of nodes leaving the uncompressed depth window to
+ * multilistFullCompressPending() instead of compressing them on the
+ * inserting call. Turning deferral off compresses everything queued. */
+void multilistFullSetCompressDeferred(multilistFull *ml, mflexState *state,
+                                      bool deferred) {
+    if (deferred) {
+        if (!ml->defer) {
+            ml->defer = zcalloc(1, sizeof(*ml->defer));
+        }
+
+        return;
+    }
+
+    if (ml->defer) {
+        multilistFullCompressPending(ml, state, SIZE_MAX);
+        zfree(ml->defer->nodes);
+        zfree(ml->defer);
+        ml->defer = NULL;
+    }
+}
+
+/* Compress up to 'budget' queued nodes, oldest first.
+ * Nodes that moved back inside the uncompressed depth window since being
+ * queued are dropped from the queue without compressing.
+ *
+ * Returns number of nodes compressed. */
+size_t multilistFullCompressPending(multilistFull *ml, mflexState *state,
+                                    size_t budget) {
+    mlCompressDefer *defer = ml->defer;
+    if (!defer || !defer->count) {
+        return 0;
+    }
+
+    const uint32_t take = budget < defer->count ? budget : defer->count;
+    const mlNodeId low = mlHeadIdx(ml) + ml->compress;
+    const mlNodeId high = mlTailIdx(ml) - ml->compress;
+    size_t compressed = 0;
+
+    for (uint32_t i = 0; i < take; i++) {
+        const mlNodeId nodeIdx = defer->nodes[i];
+        if (nodeIdx < low || nodeIdx > high) {
+            continue;
+        }
+
+        mflex **node = getNodePtr(nodeIdx);
+        if (mflexAllowsCompression(*node) && !mflexIsCompressed(*node)) {
+            mflexSetCompressAuto(node, state);
+            compressed++;
+        }
+    }
+
+    defer->count -= take;
+    memmove(defer->nodes, defer->nodes + take,
+            defer->count * sizeof(*defer->nodes));
+    defer->stats.pending = defer->count;
+    defer->stats.compressed += compressed;
+
+    return compressed;
+}
+
+void multilistFullCompressStats(const multilistFull *ml,
+                                multilistCompressStats *stats) {
+    if (ml->defer) {
+        *stats = ml->defer->stats;
+    } else {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
+
 #define multilistFullCompressRenew__(ml, state)                                \
     multilistFullCompress__(ml, state, 0, false)
 
 #define multilistFullCompressMiddle__(ml, state, idx)                          \
     multilistFullCompress__(ml, state, idx, true)
 
+/* Compress interior node 'nodeIdx' now, or queue it if compression is
+ * deferred. Queued nodes are marked compressible but stay uncompressed
+ * (and directly readable) until multilistFullCompressPending(). */
+DK_STATIC void multilistFullCompressNode__(multilistFull *ml, mflexState *state,
+                                           const mlNodeId nodeIdx) {
+    mflex **node = getNodePtr(nodeIdx);
+    mlCompressDefer *defer = ml->defer;
+
+    if (!defer) {
+        mflexSetCompressAuto(node, state);
+        return;
+    }
+
+    /* Already queued, already compressed, or previously found not worth
+     * compressing: nothing new to queue. */
+    if (mflexAllowsCompression(*node)) {
+        return;
+    }
+
+    mflexSetCompressDeferred(node);
+
+    if (defer->count == defer->capacity) {
+        defer->capacity = defer->capacity ? defer->capacity * 2 : 16;
+        defer->nodes =
+            zrealloc(defer->nodes, defer->capacity * sizeof(*defer->nodes));
+    }
+
+    if (!defer->count || nodeIdx > defer->highest) {
+        defer->highest = nodeIdx;
+    }
+
+    defer->nodes[defer->count++] = nodeIdx;
+    defer->stats.pending = defer->count;
+    defer->stats.deferred++;
+    if (defer->count > defer->stats.pendingPeak) {
+        defer->stats.pendingPeak = defer->count;
+    }
+}
+
 /* Force 'multilistFull' to meet compression guidelines set by compress depth.
  * The only way to guarantee interior nodes get compressed is to iterate
  * to our "interior" compress depth then compress the next node we find.
  * If compress depth is larger than the entire list, we return immediately. */
-DK_STATIC void multilistFullCompress__(const multilistFull *ml,
+DK_STATIC void multilistFullCompress__(multilistFull *ml,
                                        mflexState *state,
                                        mlNodeId requestedCompressNodeIdx,
                                        const bool middleOnly) {
@@ -252,15 +489,15 @@ DK_STATIC void multilistFullCompress__(const multilistFull *ml,
 
     if (requestedCompressNodeIdx >= (mlHeadIdx(ml) + ml->compress) &&
         requestedCompressNodeIdx <= (int)(mlTailIdx(ml) - ml->compress)) {
-        mflexSetCompressAuto(getNodePtr(requestedCompressNodeIdx), state);
+        multilistFullCompressNode__(ml, state, requestedCompressNodeIdx);
     }
 
     /* Now compress interior nodes one level beyond our compress depth. */
     D("Compressing interior ± 1: %d, %d\n", mlHeadIdx(ml) + ml->compress,
       mlTailIdx(ml) - ml->compress);
 
-    mflexSetCompressAuto(getNodePtr(mlHeadIdx(ml) + ml->compress), state);
-    mflexSetCompressAuto(getNodePtr(mlTailIdx(ml) - ml->compress), state);
+    multilistFullCompressNode__(ml, state, mlHeadIdx(ml) + ml->compress);
+    multilistFullCompressNode__(ml, state, mlTailIdx(ml) - ml->compress);
 
 #if 0
     printf("[");
@@ -360,6 +597,7 @@ void multilistFullPushByTypeHead(multilistFull *ml, mflexState *state,
     mflexPushByType(mlHeadPtr(ml), state, box, FLEX_ENDPOINT_HEAD);
 
     ml->values++;
+    mlRankAdjust(ml, mlHeadIdx(ml), 1);
 }
 
 /* Add new entry to tail node of multilistFull. */
@@ -370,6 +608,7 @@ void multilistFullPushByTypeTail(multilistFull *ml, mflexState *state,
     mflexPushByType(mlTailPtr(ml), state, box, FLEX_ENDPOINT_TAIL);
 
     ml->values++;
+    mlRankAdjust(ml, mlTailIdx(ml), 1);
 }
 
 /* Note: *keeps* 'fl' inside new node. */
@@ -469,11 +708,13 @@ DK_STATIC void multilistFullDelNode__(multilistFull *ml, mflexState *state,
                                       mlNodeId nodeIdx) {
     mflex **node = getNodePtr(nodeIdx);
 
-    ml->values -= mflexCount(*node);
+    const size_t nodeCount = mflexCount(*node);
+    ml->values -= nodeCount;
 
     if (ml->count == 1) {
         /* We always leave one node available, so only delete contents. */
         mflexReset(node);
+        mlRankAdjust(ml, nodeIdx, -(int64_t)nodeCount);
     } else {
         reallocDecrCount(ml, nodeIdx);
 
@@ -495,6 +736,7 @@ DK_STATIC bool multilistFullDelIndex(multilistFull *ml, const mlNodeId nodeIdx,
                                      flex **ff, flexEntry **fe) {
     flexDelete(ff, fe);
     ml->values--;
+    mlRankAdjust(ml, nodeIdx, -1);
 
     if (flexIsEmpty(*ff) && ml->count > 1) {
         /* Only delete node if it's not the only node. */
@@ -711,7 +953,13 @@ DK_STATIC void multilistFullMergeNodes_(multilistFull *ml, mflexState *state[2],
  * Note: accepts *open* node/flex as input, then *closes* before returning. */
 DK_STATIC mlNodeId multilistFullSplitNodeFromOpen_(
     multilistFull *ml, mflexState *state, mflex **node, flex **ff,
-    const mlNodeId nodeIdx, const int offset, const bool after) {
+    const mlNodeId nodeIdx, int offset, const bool after) {
+    /* Entries located from the tail carry negative offsets, but the split
+     * range below needs a head-relative position. */
+    if (offset < 0) {
+        offset += flexCount(*ff);
+    }
+
     /* -1 here means "continue deleting until the list ends" */
     const int origStart = after ? offset + 1 : 0;
     const int origExtent = after ? -1 : offset;
@@ -810,6 +1058,7 @@ DK_STATIC void multilistFullInsert_(multilistFull *ml, mflexState *state[2],
 
         mflexCloseGrow(node, state[0], f);
         ml->values++;
+        mlRankAdjust(ml, entry->nodeIdx, 1);
     }
 }
 
@@ -903,6 +1152,7 @@ bool multilistFullDelRange(multilistFull *ml, mflexState *state,
         } else {
             mflexDeleteOffsetCount(node, state, entry.offset, del);
             ml->values -= del;
+            mlRankAdjust(ml, nodeIdx, -(int64_t)del);
         }
 
         extent -= del;
@@ -1082,9 +1332,47 @@ multilistFull *multilistFullDuplicate(multilistFull *orig) {
         }
     }
 
+    if (orig->defer) {
+        /* Copied nodes keep their compression tags, so copy the queue too. */
+        copy->defer = zmalloc(sizeof(*copy->defer));
+        *copy->defer = *orig->defer;
+        copy->defer->nodes =
+            zmalloc(orig->defer->capacity * sizeof(*copy->defer->nodes));
+        memcpy(copy->defer->nodes, orig->defer->nodes,
+               orig->defer->count * sizeof(*copy->defer->nodes));
+    }
+
     return copy;
 }
 
+/* Populate 'entry' for offset 'entry->offset' inside node 'nodeIdx'. */
+DK_STATIC bool multilistFullIndexFinish_(multilistFull *ml, mflexState *state,
+                                         const mlNodeId nodeIdx,
+                                         multilistEntry *entry,
+                                         const bool openNode) {
+    entry->ml = ml;
+    entry->nodeIdx = nodeIdx;
+
+    if (openNode) {
+        /* The caller will use our result, so we don't re-compress here.
+         * The caller can recompress or delete the node as needed. */
+        entry->f = mflexOpen(getNode(nodeIdx), state);
+        entry->fe = flexIndex(entry->f, entry->offset);
+
+        if (!entry->fe) {
+            entry->fe = flexHead(entry->f);
+            return false;
+        }
+
+        flexGetByType(entry->fe, &entry->box);
+        return true;
+    }
+
+    /* else, return true because we know the bounds exist,
+     * but we didn't get them. */
+    return true;
+}
+
 /* Populate 'entry' with the element at the specified zero-based index.
  * Negative integers count from the tail (-1 = tail, etc).
  *
@@ -1095,6 +1383,28 @@ bool multilistFullIndex(multilistFull *ml, mflexState *state, mlOffsetId index,
     mlNodeId nodeIdx = 0;
     const mlOffsetId originalIndex = index;
 
+    if (ml->count >= RANK_TREE_MIN_NODES) {
+        /* Large lists: jump directly to the node holding 'index' using
+         * cumulative node counts instead of walking from either end. */
+        const mlOffsetId forwardIndex = index < 0 ? index + ml->values : index;
+        if (forwardIndex < 0 || forwardIndex >= ml->values) {
+            return false;
+        }
+
+        /* Head and tail node positions are found directly by the walk
+         * below without touching (or rebuilding) the rank tree. */
+        const mlOffsetId headCount = mflexCount(getNode(0));
+        const mlOffsetId tailCount = mflexCount(getNode(mlTailIdx(ml)));
+        if (forwardIndex >= headCount &&
+            forwardIndex < ml->values - tailCount &&
+            mlRankFind(ml, forwardIndex, &nodeIdx, &entry->offset)) {
+            return multilistFullIndexFinish_(ml, state, nodeIdx, entry,
+                                             openNode);
+        }
+
+        /* else, head/tail node or rank tree unavailable; walk nodes. */
+    }
+
 #if 1
     /* Pre-process 'index' to determine if it would be faster to Iterate
      * from the other side of the list as was requested. */
@@ -1160,27 +1470,7 @@ bool multilistFullIndex(multilistFull *ml, mflexState *state, mlOffsetId index,
         }
     }
 
-    entry->ml = ml;
-    entry->nodeIdx = nodeIdx;
-
-    if (openNode) {
-        /* The caller will use our result, so we don't re-compress here.
-         * The caller can recompress or delete the node as needed. */
-        entry->f = mflexOpen(currentNode, state);
-        entry->fe = flexIndex(entry->f, entry->offset);
-
-        if (!entry->fe) {
-            entry->fe = flexHead(entry->f);
-            return false;
-        }
-
-        flexGetByType(entry->fe, &entry->box);
-        return true;
-    }
-
-    /* else, return true because we know the bounds exist,
-     * but we didn't get them. */
-    return true;
+    return multilistFullIndexFinish_(ml, state, nodeIdx, entry, openNode);
 }
 
 /* Rotate multilistFull by moving the tail element to the head. */
@@ -1511,6 +1801,18 @@ static int mlVerify_(multilistFull *ml, mflexState *state[2], mlNodeId count,
         errors++;
     }
 
+    if (ml->rankValid) {
+        for (mlNodeId at = 0; at < ml->count; at++) {
+            const int64_t ranked = fenwickI64Get(ml->rankTree, at);
+            if (ranked != (int64_t)mflexCount(getNode(at))) {
+                yell("Rank tree count for node %d is %" PRId64
+                     " but node holds %zu values!",
+                     at, ranked, mflexCount(getNode(at)));
+                errors++;
+            }
+        }
+    }
+
     if (ml->count == 0 && !errors) {
         OK;
         return errors;
@@ -2797,10 +3099,378 @@ int multilistFullTest(int argc, char *argv[]) {
             }
         }
 
+        TEST_DESC("positional ops stay consistent with rank tree at "
+                  "compress %d",
+                  depth[_i]) {
+            multilistFull *ml = multilistFullNew(0, depth[_i]);
+            const int64_t maxValues = 6000;
+            int64_t *shadow = zcalloc(maxValues, sizeof(*shadow));
+            int64_t values = 0;
+            uint64_t seed = 0x9E3779B97F4A7C15ULL + _i;
+
+            for (int64_t i = 0; i < 3000; i++) {
+                const databox box = databoxNewSigned(i);
+                multilistFullPushByTypeTail(ml, s0, &box);
+                shadow[values++] = i;
+            }
+
+            for (int round = 0; round < 3000; round++) {
+                seed ^= seed << 13;
+                seed ^= seed >> 7;
+                seed ^= seed << 17;
+                const int64_t at = values ? (int64_t)(seed % values) : 0;
+                const int64_t val = 100000 + round;
+                const databox box = databoxNewSigned(val);
+
+                switch ((seed >> 32) % 5) {
+                case 0:
+                    if (values) {
+                        multilistFullReplaceByTypeAtIndex(ml, s0, at, &box);
+                        shadow[at] = val;
+                    }
+
+                    break;
+                case 1:
+                    if (values && values < maxValues) {
+                        multilistEntry entry;
+                        multilistFullIndexGet(ml, s0, at, &entry);
+                        multilistFullInsertByTypeBefore(ml, s, &entry, &box);
+                        memmove(&shadow[at + 1], &shadow[at],
+                                (values - at) * sizeof(*shadow));
+                        shadow[at] = val;
+                        values++;
+                    }
+
+                    break;
+                case 2: {
+                    const int64_t del = (int64_t)((seed >> 40) % 40) + 1;
+                    const int64_t extent =
+                        del > values - at ? values - at : del;
+                    if (multilistFullDelRange(ml, s0, at, del)) {
+                        memmove(&shadow[at], &shadow[at + extent],
+                                (values - at - extent) * sizeof(*shadow));
+                        values -= extent;
+                    }
+
+                    break;
+                }
+                case 3:
+                    if (values < maxValues) {
+                        multilistFullPushByTypeHead(ml, s0, &box);
+                        memmove(&shadow[1], &shadow[0],
+                                values * sizeof(*shadow));
+                        shadow[0] = val;
+                        values++;
+                    }
+
+                    break;
+                case 4: {
+                    databox popped;
+                    if (multilistFullPopTail(ml, s0, &popped)) {
+                        values--;
+                    }
+
+                    break;
+                }
+                }
+
+                if (round % 100 == 0) {
+                    for (int64_t i = 0; i < values; i++) {
+                        multilistEntry entry;
+                        const int64_t idx = (i & 1) ? i - values : i;
+                        if (!multilistFullIndexGet(ml, s0, idx, &entry) ||
+                            entry.box.data.i != shadow[i]) {
+                            ERR("Index %" PRId64 " (as %" PRId64
+                                ") expected %" PRId64 " but got %" PRId64 "!",
+                                i, idx, shadow[i], entry.box.data.i);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if ((int64_t)multilistFullCount(ml) != values) {
+                ERR("Expected %" PRId64 " values but list has %zu!", values,
+                    multilistFullCount(ml));
+            }
+
+            multilistEntry entry;
+            if (multilistFullIndexGet(ml, s0, values, &entry) ||
+                multilistFullIndexGet(ml, s0, -values - 1, &entry)) {
+                ERRR("Found entry beyond list bounds!");
+            }
+
+            mlVerify(ml, 0, values, 0, 0);
+            zfree(shadow);
+            multilistFullFree(ml);
+        }
+
+        TEST_DESC("tail appends extend rank tree in place at compress %d",
+                  depth[_i]) {
+            multilistFull *ml = multilistFullNew(0, depth[_i]);
+            int64_t values = 0;
+            for (; values < 3000; values++) {
+                const databox box = databoxNewSigned(values);
+                multilistFullPushByTypeTail(ml, s0, &box);
+            }
+
+            /* Mid-list lookup builds the tree... */
+            multilistEntry entry;
+            multilistFullIndexGet(ml, s0, values / 2, &entry);
+            if (!ml->rankValid) {
+                ERRR("Rank tree not built by mid-list index!");
+            }
+
+            /* ...and new tail nodes only extend it. */
+            const mlNodeId nodesBefore = ml->count;
+            for (; values < 6000; values++) {
+                const databox box = databoxNewSigned(values);
+                multilistFullPushByTypeTail(ml, s0, &box);
+            }
+
+            if (ml->count == nodesBefore) {
+                ERRR("Tail pushes didn't add nodes!");
+            }
+
+            if (!ml->rankValid) {
+                ERRR("Tail node append invalidated rank tree!");
+            }
+
+            for (int64_t i = 0; i < values; i++) {
+                if (!multilistFullIndexGet(ml, s0, i, &entry) ||
+                    entry.box.data.i != i) {
+                    ERR("Index %" PRId64 " wrong after tail appends!", i);
+                    break;
+                }
+            }
+
+            /* Head/tail positions never need the tree. */
+            databox popped;
+            multilistFullPopHead(ml, s0, &popped);
+            ml->rankValid = false;
+            if (!multilistFullIndexGet(ml, s0, 0, &entry) ||
+                entry.box.data.i != 1 ||
+                !multilistFullIndexGet(ml, s0, -1, &entry) ||
+                entry.box.data.i != values - 1) {
+                ERRR("Head/tail index wrong!");
+            }
+
+            if (ml->rankValid) {
+                ERRR("Head/tail index rebuilt the rank tree!");
+            }
+
+            mlVerify(ml, 0, values - 1, 0, 0);
+            multilistFullFree(ml);
+        }
+
         int64_t stop = timeUtilMs();
         runtime[_i] = stop - start;
     }
 
+    TEST("deferred compression queues interior nodes until drained") {
+        mflexStateReset(s0);
+        multilistFull *ml = multilistFullNew(2, 1);
+        multilistFullSetCompressDeferred(ml, s0, true);
+
+        char buf[64];
+        memset(buf, 'D', sizeof(buf));
+        const int64_t total = 5000;
+        for (int64_t i = 0; i < total; i++) {
+            const databox box = databoxNewBytes(buf, sizeof(buf));
+            multilistFullPushByTypeTail(ml, s0, &box);
+        }
+
+        multilistCompressStats stats;
+        multilistFullCompressStats(ml, &stats);
+        if (!stats.pending || stats.compressed) {
+            ERR("Expected pending nodes and nothing compressed, got %zu "
+                "pending and %" PRIu64 " compressed!",
+                stats.pending, stats.compressed);
+        }
+
+        if (stats.pendingPeak < stats.pending ||
+            stats.deferred < stats.pending) {
+            ERRR("Deferral stats are inconsistent!");
+        }
+
+        for (mlNodeId i = 0; i < ml->count; i++) {
+            if (mflexIsCompressed(getNode(i))) {
+                ERR("Node %d compressed while compression deferred!", i);
+            }
+        }
+
+        /* Pending nodes are readable in place. */
+        multilistEntry entry;
+        if (!multilistFullIndexGet(ml, s0, total / 2, &entry) ||
+            entry.box.len != sizeof(buf)) {
+            ERRR("Could not read value from pending node!");
+        }
+
+        /* Shift queued node indexes around with head pushes and a
+         * head-side delete before draining. */
+        for (int64_t i = 0; i < 200; i++) {
+            const databox box = databoxNewBytes(buf, sizeof(buf));
+            multilistFullPushByTypeHead(ml, s0, &box);
+        }
+
+        multilistFullDelRange(ml, s0, 0, 150);
+
+        multilistFullCompressStats(ml, &stats);
+        const size_t before = stats.pending;
+        size_t got = multilistFullCompressPending(ml, s0, 3);
+        multilistFullCompressStats(ml, &stats);
+        if (got > 3 || stats.compressed != got) {
+            ERR("Budgeted drain compressed %zu nodes!", got);
+        }
+
+        if (stats.pending > before) {
+            ERRR("Budgeted drain did not shrink queue!");
+        }
+
+        /* Turning deferral off drains everything still queued. */
+        multilistFullSetCompressDeferred(ml, s0, false);
+        multilistFullCompressStats(ml, &stats);
+        if (stats.pending) {
+            ERRR("Queue not drained when deferral turned off!");
+        }
+
+        size_t compressedNodes = 0;
+        for (mlNodeId i = 0; i < ml->count; i++) {
+            const bool interior = i > 0 && i < ml->count - 1;
+            const bool compressed = mflexIsCompressed(getNode(i));
+            if (!interior && compressed) {
+                ERR("Edge node %d compressed with depth 1!", i);
+            }
+
+            compressedNodes += compressed;
+        }
+
+        if (compressedNodes < (size_t)ml->count - 2) {
+            ERR("Only %zu of %d interior nodes compressed after drain!",
+                compressedNodes, ml->count - 2);
+        }
+
+        for (int64_t i = 0; i < (int64_t)multilistFullCount(ml); i += 97) {
+            if (!multilistFullIndexGet(ml, s0, i, &entry) ||
+                entry.box.len != sizeof(buf) ||
+                memcmp(entry.box.data.bytes.start, buf, sizeof(buf))) {
+                ERR("Value %" PRId64 " corrupt after drain!", i);
+                break;
+            }
+        }
+
+        multilistFullFree(ml);
+    }
+
+    TEST("PERF: push tail with inline vs deferred compression") {
+        char buf[64];
+        memset(buf, 'P', sizeof(buf));
+        const int64_t total = 500000;
+        for (int deferred = 0; deferred < 2; deferred++) {
+            mflexStateReset(s0);
+            multilistFull *ml = multilistFullNew(6, 1);
+            multilistFullSetCompressDeferred(ml, s0, deferred);
+
+            /* Per-push timing: inline compression shows up as latency
+             * spikes on the pushes that move a node out of the
+             * uncompressed window. */
+            int64_t elapsed = 0;
+            int64_t slowest = 0;
+            for (int64_t i = 0; i < total; i++) {
+                StrInt64ToBuf(buf, sizeof(buf), i);
+                const databox box = databoxNewBytes(buf, sizeof(buf));
+                const int64_t pushStart = timeUtilMonotonicNs();
+                multilistFullPushByTypeTail(ml, s0, &box);
+                const int64_t pushNs = timeUtilMonotonicNs() - pushStart;
+                elapsed += pushNs;
+                if (pushNs > slowest) {
+                    slowest = pushNs;
+                }
+            }
+
+            multilistCompressStats stats;
+            const int64_t drainStart = timeUtilMonotonicNs();
+            multilistFullCompressPending(ml, s0, SIZE_MAX);
+            const int64_t drainNs = timeUtilMonotonicNs() - drainStart;
+            multilistFullCompressStats(ml, &stats);
+
+            printf("push tail (%s): %.1f ns/push, slowest %.1f us",
+                   deferred ? "deferred" : "inline", (double)elapsed / total,
+                   (double)slowest / 1000.0);
+            if (deferred) {
+                printf("; drain of %" PRIu64 " nodes: %.1f us/node",
+                       stats.compressed,
+                       (double)drainNs / (stats.compressed ?: 1) / 1000.0);
+            }
+
+            printf("\n");
+            multilistFullFree(ml);
+        }
+    }
+
+    TEST("PERF: mid-list index with rank tree vs node walk") {
+        mflexStateReset(s0);
+        multilistFull *ml = multilistFullNew(2, 0);
+        const int64_t total = 1000000;
+        for (int64_t i = 0; i < total; i++) {
+            const databox box = databoxNewSigned(i);
+            multilistFullPushByTypeTail(ml, s0, &box);
+        }
+
+        const size_t rounds = 2000;
+        uint64_t seed = 1;
+        int64_t sink = 0;
+
+        /* Baseline: walk node counts from the nearer end like the
+         * pre-rank-tree lookup did. */
+        int64_t walkStart = timeUtilMonotonicNs();
+        for (size_t r = 0; r < rounds; r++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const int64_t idx =
+                total / 4 + (int64_t)((seed >> 33) % (total / 2));
+            int64_t accum = 0;
+            mlNodeId nodeIdx = 0;
+            if (idx < total / 2) {
+                while (accum + (int64_t)mflexCount(getNode(nodeIdx)) <= idx) {
+                    accum += mflexCount(getNode(nodeIdx++));
+                }
+            } else {
+                nodeIdx = mlTailIdx(ml);
+                const int64_t ridx = total - 1 - idx;
+                while (accum + (int64_t)mflexCount(getNode(nodeIdx)) <= ridx) {
+                    accum += mflexCount(getNode(nodeIdx--));
+                }
+            }
+
+            sink += nodeIdx;
+        }
+        int64_t walkNs = timeUtilMonotonicNs() - walkStart;
+
+        seed = 1;
+        int64_t indexStart = timeUtilMonotonicNs();
+        for (size_t r = 0; r < rounds; r++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const int64_t idx =
+                total / 4 + (int64_t)((seed >> 33) % (total / 2));
+            multilistEntry entry;
+            if (!multilistFullIndexGet(ml, s0, idx, &entry) ||
+                entry.box.data.i != idx) {
+                ERR("Index %" PRId64 " returned wrong value!", idx);
+                break;
+            }
+
+            sink += entry.nodeIdx;
+        }
+        int64_t indexNs = timeUtilMonotonicNs() - indexStart;
+
+        printf("%" PRId64 " values in %d nodes; node walk: %.1f us/lookup, "
+               "indexed get: %.1f us/lookup (%" PRId64 ")\n",
+               total, ml->count, (double)walkNs / rounds / 1000.0,
+               (double)indexNs / rounds / 1000.0, sink & 1);
+
+        multilistFullFree(ml);
+    }
+
     mflexStateReset(s0);
     mflexStateReset(s1);
 
@@ -38,6 +38,14 @@ void multilistFullSetCompressDepth(multilistFull *ml, uint32_t depth);
 void multilistFullSetFill(multilistFull *ml, uint32_t fill);
 void multilistFullSetOptions(multilistFull *ml, uint32_t fill, uint32_t depth);
 
+/* Deferred compression */
+void multilistFullSetCompressDeferred(multilistFull *ml, mflexState *state,
+                                      bool deferred);
+size_t multilistFullCompressPending(multilistFull *ml, mflexState *state,
+                                    size_t budget);
+void multilistFullCompressStats(const multilistFull *ml,
+                                multilistCompressStats *stats);
+
 /* Free */
 void multilistFullFree(multilistFull *ml);
 
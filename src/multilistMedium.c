@@ -211,15 +211,6 @@ bool multilistMediumDelRange(multilistMedium *ml, const mlOffsetId start,
         return false;
     }
 
-    /* delete starting at index... */
-    /* Cases:
-     *      - delete entire list
-     *      - delete all of F0, none of F1
-     *      - delete none of F0, all of F1
-     *      - delete all of F0, part of F1 [start > F0, end in F1]
-     *      - delete part of F0, all of F1 [start in F0, end end of F1]
-     *      - delete part of F0, part of F1 [start in F0, end in F1] */
-
     /* Note: we *already* verified 'extent' is <= currentValues above,
      * so if extent == currentValues, then we're deleting everything. */
     if (extent == currentValues) {
@@ -227,38 +218,34 @@ bool multilistMediumDelRange(multilistMedium *ml, const mlOffsetId start,
          * just clear both */
         flexReset(&F0);
         flexReset(&F1);
-    } else if (entry.nodeIdx == 0 && extent == countF0) {
-        /* If deleting all of F0, clear F0.
-         * (which is the same as swapping F1 with an empty F0) */
-        flexReset(&F0);
-        swapF();
-    } else if (entry.nodeIdx == 1 && extent == countF1) {
-        /* If deleting all of F1, just clear F1. */
-        flexReset(&F1);
-    } else if (extent > countF0) {
-        /* deleting more than F0, so clear F0, delete part of F1, then
-         * swap F1 with F0 */
-        flexReset(&F0);
-        extent -= countF0;
+        return true;
+    }
 
-        flexEntry *deleteStartF1 = flexIndex(F1, entry.offset);
-        flexDeleteCount(&F1, &deleteStartF1, extent);
-    } else if (entry.nodeIdx == 0) {
-        /* deleting part of F0 and part of F1 */
-        flexEntry *deleteStartF0 = flexIndex(F0, entry.offset);
-        flexDeleteCount(&F0, &deleteStartF0, extent - countF1);
+    if (entry.nodeIdx == 0) {
+        /* delete from the start position through (at most) the end of F0,
+         * then any remainder from the head of F1 */
+        mlOffsetId extentF0 = countF0 - entry.offset;
+        if (extentF0 > extent) {
+            extentF0 = extent;
+        }
 
-        extent -= (extent - countF1);
-        assert(extent > 0);
+        flexEntry *deleteStartF0 = flexIndex(F0, entry.offset);
+        flexDeleteCount(&F0, &deleteStartF0, extentF0);
+        extent -= extentF0;
 
-        flexEntry *deleteStartF1 = flexHead(F1);
-        flexDeleteCount(&F1, &deleteStartF1, extent);
-    } else if (entry.nodeIdx == 1) {
+        if (extent > 0) {
+            flexEntry *deleteStartF1 = flexHead(F1);
+            flexDeleteCount(&F1, &deleteStartF1, extent);
+        }
+    } else {
         /* deleting none of F0 and part of F1 */
         flexEntry *deleteStartF1 = flexIndex(F1, entry.offset);
         flexDeleteCount(&F1, &deleteStartF1, extent);
-    } else {
-        assert(NULL && "unexpected combination of conditions!");
+    }
+
+    /* Keep F0 populated while any values remain. */
+    if (flexCount(F0) == 0) {
+        swapF();
     }
 
     return true;
@@ -293,7 +280,8 @@ void multilistMediumIteratorInit(multilistMedium *ml, multilistIterator *iter,
     iter->nodeIdx = forward ? 0 : 1;
     iter->forward = forward;
     iter->ml = ml;
-    iter->fe = flexIndexDirect(ml->fl[iter->nodeIdx], iter->offset);
+    iter->f = ml->fl[iter->nodeIdx];
+    iter->fe = flexIndexDirect(iter->f, iter->offset);
 }
 
 bool multilistMediumIteratorInitAtIdx(multilistMedium *ml,
@@ -303,8 +291,10 @@ bool multilistMediumIteratorInitAtIdx(multilistMedium *ml,
 
     if (multilistMediumIndex(ml, idx, &entry)) {
         multilistMediumIteratorInit(ml, iter, forward);
-        iter->fe = flexIndexDirect(ml->fl[iter->nodeIdx], iter->offset);
+        iter->nodeIdx = entry.nodeIdx;
+        iter->f = ml->fl[entry.nodeIdx];
         iter->offset = entry.offset;
+        iter->fe = entry.fe;
         return true;
     }
 
@@ -367,18 +357,17 @@ bool multilistMediumIndex(multilistMedium *ml, mlOffsetId index,
     entry->ml = ml;
     entry->offset = index;
 
-    /* convert negative offset to positve offset */
-    const bool reverse = index < 0 ? true : false; /* negative == reverse */
-    if (reverse) {
-        index = (-index) - 1;
-    }
-
     /* if out of range of all elements, nothing to index */
     const mlOffsetId values = multilistMediumCount(ml);
-    if (values > 0 && index >= values) {
+    if (values > 0 && (index >= values || index < -values)) {
         return false;
     }
 
+    /* convert negative offset (counting back from tail) to positive offset */
+    if (index < 0) {
+        index += values;
+    }
+
     /* if index is beyond F0, jump over F0 into F1 */
     const mlOffsetId countF0 = flexCount(F0);
     mlNodeId useNode = 0;
@@ -0,0 +1,838 @@
+/* multilistQueue.c - blocking FIFO work queue stored in a multilist
+ *
+ * MPMC mode keeps every entry in 'ml' under 'lock'.
+ *
+ * SPSC mode adds a fixed ring in front of 'ml': the producer publishes
+ * into the ring with a release store of 'ringTail' and the consumer takes
+ * from it with a release store of 'ringHead', so neither thread touches
+ * the mutex in steady state. When the ring is full the producer spills
+ * into 'ml' under 'lock', and keeps spilling until the consumer has
+ * drained 'ml' back to empty. That rule keeps every ring entry older than
+ * every 'ml' entry, so the consumer always drains the ring before 'ml'.
+ *
+ * Sleeping poppers register in 'sleepers' before their final emptiness
+ * check; pushers publish, fence, then check 'sleepers' and only take the
+ * mutex to signal when someone is actually waiting. */
+
+#include "multilistQueue.h"
+
+#include "datakit.h"
+#include "fastmutex.h"
+#include "multilist.h"
+
+#include <errno.h> /* ETIMEDOUT */
+#include <time.h>  /* clock_gettime */
+
+/* SPSC ring slots (power of two); 1024 boxes is 16 KiB. */
+#define RING_SIZE 1024
+#define RING_MASK (RING_SIZE - 1)
+
+struct multilistQueue {
+    /* SPSC consumer-owned */
+    _Atomic uint64_t ringHead; /* next ring slot to pop */
+    uint64_t tailCache;        /* consumer's last observed ringTail */
+    uint8_t padHead[64];       /* keep producer fields off this line */
+
+    /* SPSC producer-owned */
+    _Atomic uint64_t ringTail; /* next ring slot to push */
+    uint64_t headCache;        /* producer's last observed ringHead */
+    uint8_t padTail[64];
+
+    fastMutex lock;
+    fastCond notEmpty;
+    multilist *ml;             /* MPMC: all entries; SPSC: ring overflow */
+    mflexState *state;         /* only used while holding 'lock' */
+    _Atomic size_t mlCount;    /* entries currently in 'ml' */
+    _Atomic uint32_t sleepers; /* poppers registered to wait on 'notEmpty' */
+    _Atomic bool closed;
+    multilistQueueMode mode;
+    databox *ring; /* SPSC only */
+};
+
+multilistQueue *multilistQueueNew(flexCapSizeLimit limit, uint32_t depth,
+                                  multilistQueueMode mode) {
+    multilistQueue *q = zcalloc(1, sizeof(*q));
+
+    fastMutexInit(&q->lock);
+    fastMutexCondInit(&q->notEmpty, NULL);
+    q->ml = multilistNew(limit, depth);
+    q->state = mflexStateCreate();
+    q->mode = mode;
+
+    if (mode == MULTILIST_QUEUE_SPSC) {
+        q->ring = zcalloc(RING_SIZE, sizeof(*q->ring));
+    }
+
+    return q;
+}
+
+/* ====================================================================
+ * SPSC ring
+ * ==================================================================== */
+/* Producer only. Returns number of boxes copied into the ring. */
+static size_t ringPush(multilistQueue *q, const databox *boxes, size_t count) {
+    const uint64_t tail =
+        atomic_load_explicit(&q->ringTail, memory_order_relaxed);
+    uint64_t space = RING_SIZE - (tail - q->headCache);
+
+    if (space < count) {
+        q->headCache = atomic_load_explicit(&q->ringHead, memory_order_acquire);
+        space = RING_SIZE - (tail - q->headCache);
+    }
+
+    const size_t n = count < space ? count : space;
+    for (size_t i = 0; i < n; i++) {
+        databoxCopyBytesFromBox(&q->ring[(tail + i) & RING_MASK], &boxes[i]);
+    }
+
+    if (n) {
+        atomic_store_explicit(&q->ringTail, tail + n, memory_order_release);
+    }
+
+    return n;
+}
+
+/* Consumer only. Returns number of boxes moved out of the ring. */
+static size_t ringPop(multilistQueue *q, databox *boxes, size_t maxCount) {
+    const uint64_t head =
+        atomic_load_explicit(&q->ringHead, memory_order_relaxed);
+    uint64_t avail = q->tailCache - head;
+
+    if (avail < maxCount) {
+        q->tailCache = atomic_load_explicit(&q->ringTail, memory_order_acquire);
+        avail = q->tailCache - head;
+    }
+
+    const size_t n = maxCount < avail ? maxCount : avail;
+    for (size_t i = 0; i < n; i++) {
+        boxes[i] = q->ring[(head + i) & RING_MASK];
+    }
+
+    if (n) {
+        atomic_store_explicit(&q->ringHead, head + n, memory_order_release);
+    }
+
+    return n;
+}
+
+/* ====================================================================
+ * Locked multilist access
+ * ==================================================================== */
+static void mlPushLocked(multilistQueue *q, const databox *boxes,
+                         size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        multilistPushByTypeTail(&q->ml, q->state, &boxes[i]);
+    }
+
+    atomic_fetch_add_explicit(&q->mlCount, count, memory_order_release);
+}
+
+static size_t mlPopLocked(multilistQueue *q, databox *boxes, size_t maxCount) {
+    size_t n = 0;
+    while (n < maxCount && multilistPopHead(&q->ml, q->state, &boxes[n])) {
+        n++;
+    }
+
+    if (n) {
+        atomic_fetch_sub_explicit(&q->mlCount, n, memory_order_release);
+    }
+
+    return n;
+}
+
+/* Pop while holding 'lock'; ring first (older) then 'ml'. */
+static size_t popLocked(multilistQueue *q, databox *boxes, size_t maxCount) {
+    size_t n = 0;
+    if (q->ring) {
+        n = ringPop(q, boxes, maxCount);
+    }
+
+    if (n < maxCount) {
+        n += mlPopLocked(q, boxes + n, maxCount - n);
+    }
+
+    return n;
+}
+
+/* Pop without sleeping. */
+static size_t popAvailable(multilistQueue *q, databox *boxes,
+                           size_t maxCount) {
+    size_t n = 0;
+    if (q->ring) {
+        n = ringPop(q, boxes, maxCount);
+        if (n == maxCount ||
+            !atomic_load_explicit(&q->mlCount, memory_order_acquire)) {
+            return n;
+        }
+    }
+
+    fastMutexLock(&q->lock);
+    n += popLocked(q, boxes + n, maxCount - n);
+    fastMutexUnlock(&q->lock);
+
+    return n;
+}
+
+/* Wake up to 'count' sleeping poppers. Caller holds 'lock'. */
+static void wakeLocked(multilistQueue *q, size_t count) {
+    const uint32_t sleepers =
+        atomic_load_explicit(&q->sleepers, memory_order_relaxed);
+
+    if (count >= sleepers) {
+        if (sleepers) {
+            fastMutexCondBroadcast(&q->notEmpty);
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            fastMutexCondSignal(&q->notEmpty);
+        }
+    }
+}
+
+/* ====================================================================
+ * Push
+ * ==================================================================== */
+size_t multilistQueuePushMany(multilistQueue *q, const databox *boxes,
+                              size_t count) {
+    if (!count) {
+        return 0;
+    }
+
+    if (q->mode == MULTILIST_QUEUE_MPMC) {
+        fastMutexLock(&q->lock);
+        if (atomic_load_explicit(&q->closed, memory_order_relaxed)) {
+            fastMutexUnlock(&q->lock);
+            return 0;
+        }
+
+        mlPushLocked(q, boxes, count);
+        wakeLocked(q, count);
+        fastMutexUnlock(&q->lock);
+        return count;
+    }
+
+    if (atomic_load_explicit(&q->closed, memory_order_relaxed)) {
+        return 0;
+    }
+
+    /* SPSC: only use the ring while nothing has spilled into 'ml',
+     * otherwise new entries would jump ahead of spilled ones. */
+    size_t pushed = 0;
+    if (!atomic_load_explicit(&q->mlCount, memory_order_acquire)) {
+        pushed = ringPush(q, boxes, count);
+    }
+
+    if (pushed < count) {
+        fastMutexLock(&q->lock);
+        mlPushLocked(q, boxes + pushed, count - pushed);
+        fastMutexUnlock(&q->lock);
+    }
+
+    /* Pairs with the fence in multilistQueuePopMany(): either we see the
+     * consumer registered as a sleeper or it sees our entries. */
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&q->sleepers, memory_order_relaxed)) {
+        fastMutexLock(&q->lock);
+        wakeLocked(q, count);
+        fastMutexUnlock(&q->lock);
+    }
+
+    return count;
+}
+
+bool multilistQueuePush(multilistQueue *q, const databox *box) {
+    return multilistQueuePushMany(q, box, 1) == 1;
+}
+
+/* ====================================================================
+ * Pop
+ * ==================================================================== */
+static void deadlineFromNow(struct timespec *ts, uint64_t timeoutUs) {
+    clock_gettime(CLOCK_REALTIME, ts);
+    ts->tv_sec += timeoutUs / 1000000;
+    ts->tv_nsec += (long)(timeoutUs % 1000000) * 1000;
+    if (ts->tv_nsec >= 1000000000) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000;
+    }
+}
+
+size_t multilistQueuePopMany(multilistQueue *q, databox *boxes,
+                             size_t maxCount, uint64_t timeoutUs) {
+    if (!maxCount) {
+        return 0;
+    }
+
+    size_t n = popAvailable(q, boxes, maxCount);
+    if (n || timeoutUs == MULTILIST_QUEUE_NO_WAIT) {
+        return n;
+    }
+
+    struct timespec deadline;
+    const bool timed = timeoutUs != MULTILIST_QUEUE_WAIT_FOREVER;
+    if (timed) {
+        deadlineFromNow(&deadline, timeoutUs);
+    }
+
+    fastMutexLock(&q->lock);
+    atomic_fetch_add_explicit(&q->sleepers, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    while (true) {
+        n = popLocked(q, boxes, maxCount);
+        if (n || atomic_load_explicit(&q->closed, memory_order_relaxed)) {
+            break;
+        }
+
+        int ret;
+        if (timed) {
+            ret = fastMutexCondTimedWait(&q->notEmpty, &q->lock, &deadline);
+        } else {
+            ret = fastMutexCondWait(&q->notEmpty, &q->lock);
+        }
+
+        if (ret == ETIMEDOUT) {
+            n = popLocked(q, boxes, maxCount);
+            break;
+        }
+    }
+
+    atomic_fetch_sub_explicit(&q->sleepers, 1, memory_order_relaxed);
+    fastMutexUnlock(&q->lock);
+
+    return n;
+}
+
+/* ====================================================================
+ * Metadata / Lifecycle
+ * ==================================================================== */
+size_t multilistQueueCount(const multilistQueue *q) {
+    size_t count = atomic_load_explicit(&q->mlCount, memory_order_relaxed);
+    if (q->ring) {
+        count += atomic_load_explicit(&q->ringTail, memory_order_relaxed) -
+                 atomic_load_explicit(&q->ringHead, memory_order_relaxed);
+    }
+
+    return count;
+}
+
+void multilistQueueClose(multilistQueue *q) {
+    fastMutexLock(&q->lock);
+    atomic_store_explicit(&q->closed, true, memory_order_relaxed);
+    fastMutexCondBroadcast(&q->notEmpty);
+    fastMutexUnlock(&q->lock);
+}
+
+bool multilistQueueIsClosed(const multilistQueue *q) {
+    return atomic_load_explicit(&q->closed, memory_order_relaxed);
+}
+
+/* Caller guarantees no other thread is still using 'q'. */
+void multilistQueueFree(multilistQueue *q) {
+    if (!q) {
+        return;
+    }
+
+    databox box;
+    while (popAvailable(q, &box, 1)) {
+        databoxFreeData(&box);
+    }
+
+    multilistFree(q->ml);
+    mflexStateFree(q->state);
+    pthread_mutex_destroy(&q->notEmpty.m);
+    zfree(q->ring);
+    zfree(q);
+}
+
+#ifdef DATAKIT_TEST
+#include "ctest.h"
+#include "timeUtil.h"
+
+#include <pthread.h>
+#include <unistd.h> /* usleep */
+
+static size_t popAllOrdered(multilistQueue *q, int64_t expectStart,
+                            size_t batch, uint32_t *errCount) {
+    databox boxes[64];
+    size_t total = 0;
+    int64_t expect = expectStart;
+    size_t got;
+
+    while ((got = multilistQueuePopMany(q, boxes, batch,
+                                        MULTILIST_QUEUE_NO_WAIT))) {
+        for (size_t i = 0; i < got; i++) {
+            if (boxes[i].data.i != expect) {
+                (*errCount)++;
+            }
+
+            expect++;
+        }
+
+        total += got;
+    }
+
+    return total;
+}
+
+typedef struct mlqProducer {
+    multilistQueue *q;
+    int64_t id;
+    int64_t count;
+    size_t batch;
+} mlqProducer;
+
+typedef struct mlqConsumer {
+    multilistQueue *q;
+    size_t batch;
+    int64_t popped;
+    int64_t sum;
+    int64_t *lastSeen; /* per producer; checks per-producer FIFO order */
+    int64_t producers;
+    int64_t orderErrors;
+} mlqConsumer;
+
+/* Values encode (producer << 32) | sequence */
+static void *mlqProducerRun(void *arg) {
+    mlqProducer *p = arg;
+    databox boxes[64];
+    int64_t seq = 0;
+
+    while (seq < p->count) {
+        size_t n = 0;
+        while (n < p->batch && seq < p->count) {
+            boxes[n++] = databoxNewSigned((p->id << 32) | seq++);
+        }
+
+        if (n == 1) {
+            multilistQueuePush(p->q, &boxes[0]);
+        } else {
+            multilistQueuePushMany(p->q, boxes, n);
+        }
+    }
+
+    return NULL;
+}
+
+static void *mlqConsumerRun(void *arg) {
+    mlqConsumer *c = arg;
+    databox boxes[64];
+    size_t got;
+
+    while ((got = multilistQueuePopMany(c->q, boxes, c->batch,
+                                        MULTILIST_QUEUE_WAIT_FOREVER))) {
+        for (size_t i = 0; i < got; i++) {
+            const int64_t producer = boxes[i].data.i >> 32;
+            const int64_t seq = boxes[i].data.i & 0xffffffff;
+            if (seq <= c->lastSeen[producer]) {
+                c->orderErrors++;
+            }
+
+            c->lastSeen[producer] = seq;
+            c->sum += seq;
+        }
+
+        c->popped += got;
+    }
+
+    return NULL;
+}
+
+/* Run 'producers' x 'consumers' threads through 'q'; returns errors. */
+static uint32_t mlqRunThreads(multilistQueue *q, int64_t producers,
+                              int64_t consumers, int64_t perProducer,
+                              size_t batch, int64_t *elapsedNs) {
+    uint32_t err = 0;
+    pthread_t pt[producers];
+    pthread_t ct[consumers];
+    mlqProducer p[producers];
+    mlqConsumer c[consumers];
+
+    const int64_t start = timeUtilMonotonicNs();
+    for (int64_t i = 0; i < consumers; i++) {
+        c[i] = (mlqConsumer){.q = q, .batch = batch, .producers = producers};
+        c[i].lastSeen = zmalloc(producers * sizeof(*c[i].lastSeen));
+        for (int64_t j = 0; j < producers; j++) {
+            c[i].lastSeen[j] = -1;
+        }
+
+        pthread_create(&ct[i], NULL, mlqConsumerRun, &c[i]);
+    }
+
+    for (int64_t i = 0; i < producers; i++) {
+        p[i] = (mlqProducer){
+            .q = q, .id = i, .count = perProducer, .batch = batch};
+        pthread_create(&pt[i], NULL, mlqProducerRun, &p[i]);
+    }
+
+    for (int64_t i = 0; i < producers; i++) {
+        pthread_join(pt[i], NULL);
+    }
+
+    multilistQueueClose(q);
+
+    int64_t popped = 0;
+    int64_t sum = 0;
+    for (int64_t i = 0; i < consumers; i++) {
+        pthread_join(ct[i], NULL);
+        popped += c[i].popped;
+        sum += c[i].sum;
+        if (c[i].orderErrors) {
+            ERR("Consumer %" PRId64 " saw %" PRId64 " out of order entries!",
+                i, c[i].orderErrors);
+        }
+
+        zfree(c[i].lastSeen);
+    }
+
+    *elapsedNs = timeUtilMonotonicNs() - start;
+
+    const int64_t expectSum = producers * (perProducer * (perProducer - 1) / 2);
+    if (popped != producers * perProducer || sum != expectSum) {
+        ERR("Expected %" PRId64 " entries (sum %" PRId64 ") but popped %" PRId64
+            " (sum %" PRId64 ")!",
+            producers * perProducer, expectSum, popped, sum);
+    }
+
+    if (multilistQueueCount(q)) {
+        ERR("Queue still holds %zu entries!", multilistQueueCount(q));
+    }
+
+    return err;
+}
+
+typedef struct mlqTimedPopper {
+    multilistQueue *q;
+    uint64_t timeoutUs;
+    bool got;
+} mlqTimedPopper;
+
+static void *mlqTimedPopperRun(void *arg) {
+    mlqTimedPopper *t = arg;
+    databox box;
+    t->got = multilistQueuePopTimed(t->q, &box, t->timeoutUs);
+    return NULL;
+}
+
+/* Baseline: multilist wrapped in a pthread mutex and condvar. */
+typedef struct mlqLocked {
+    pthread_mutex_t lock;
+    pthread_cond_t notEmpty;
+    multilist *ml;
+    mflexState *state;
+    int64_t count;
+} mlqLocked;
+
+static void *mlqLockedProducerRun(void *arg) {
+    mlqLocked *l = arg;
+    for (int64_t i = 0; i < l->count; i++) {
+        const databox box = databoxNewSigned(i);
+        pthread_mutex_lock(&l->lock);
+        multilistPushByTypeTail(&l->ml, l->state, &box);
+        pthread_cond_signal(&l->notEmpty);
+        pthread_mutex_unlock(&l->lock);
+    }
+
+    return NULL;
+}
+
+int multilistQueueTest(int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+
+    uint32_t err = 0;
+    const multilistQueueMode modes[] = {MULTILIST_QUEUE_MPMC,
+                                        MULTILIST_QUEUE_SPSC};
+    const char *modeNames[] = {"MPMC", "SPSC"};
+
+    for (size_t m = 0; m < 2; m++) {
+        TEST_DESC("%s: push/pop keeps FIFO order", modeNames[m]) {
+            multilistQueue *q =
+                multilistQueueNew(FLEX_CAP_LEVEL_2048, 0, modes[m]);
+
+            /* 5000 entries overflows the SPSC ring into the multilist */
+            for (int64_t i = 0; i < 5000; i++) {
+                const databox box = databoxNewSigned(i);
+                if (!multilistQueuePush(q, &box)) {
+                    ERR("Push %" PRId64 " failed!", i);
+                }
+            }
+
+            if (multilistQueueCount(q) != 5000) {
+                ERR("Expected 5000 queued, got %zu", multilistQueueCount(q));
+            }
+
+            /* Pop half, then push more while the rest is still queued */
+            uint32_t orderErrors = 0;
+            databox box;
+            for (int64_t i = 0; i < 2500; i++) {
+                if (!multilistQueueTryPop(q, &box) || box.data.i != i) {
+                    orderErrors++;
+                }
+            }
+
+            for (int64_t i = 5000; i < 6000; i++) {
+                box = databoxNewSigned(i);
+                multilistQueuePush(q, &box);
+            }
+
+            const size_t rest = popAllOrdered(q, 2500, 1, &orderErrors);
+            if (orderErrors || rest != 3500) {
+                ERR("Popped %zu with %u order errors", rest, orderErrors);
+            }
+
+            if (multilistQueueTryPop(q, &box)) {
+                ERRR("Popped from empty queue!");
+            }
+
+            multilistQueueFree(q);
+        }
+
+        TEST_DESC("%s: batched push/pop and byte entries", modeNames[m]) {
+            multilistQueue *q =
+                multilistQueueNew(FLEX_CAP_LEVEL_2048, 0, modes[m]);
+            databox boxes[64];
+            int64_t next = 0;
+
+            for (int round = 0; round < 200; round++) {
+                for (size_t i = 0; i < 64; i++) {
+                    boxes[i] = databoxNewSigned(next++);
+                }
+
+                if (multilistQueuePushMany(q, boxes, 64) != 64) {
+                    ERRR("PushMany failed!");
+                }
+            }
+
+            uint32_t orderErrors = 0;
+            const size_t total = popAllOrdered(q, 0, 48, &orderErrors);
+            if (orderErrors || total != 200 * 64) {
+                ERR("Popped %zu with %u order errors", total, orderErrors);
+            }
+
+            const char *payload = "a payload longer than an embedded box";
+            for (int i = 0; i < 3000; i++) {
+                const databox box =
+                    databoxNewBytesString(i % 2 ? payload : "short");
+                multilistQueuePush(q, &box);
+            }
+
+            for (int i = 0; i < 3000; i++) {
+                databox got;
+                if (!multilistQueueTryPop(q, &got)) {
+                    ERR("Missing byte entry %d!", i);
+                    break;
+                }
+
+                const char *want = i % 2 ? payload : "short";
+                if (databoxLen(&got) != strlen(want) ||
+                    memcmp(databoxBytes(&got), want, strlen(want))) {
+                    ERR("Byte entry %d has wrong contents!", i);
+                }
+
+                databoxFreeData(&got);
+            }
+
+            /* Free with entries still queued releases them */
+            for (int i = 0; i < 2000; i++) {
+                const databox box = databoxNewBytesString(payload);
+                multilistQueuePush(q, &box);
+            }
+
+            multilistQueueFree(q);
+        }
+
+        TEST_DESC("%s: timed pop times out and close rejects pushes",
+                  modeNames[m]) {
+            multilistQueue *q =
+                multilistQueueNew(FLEX_CAP_LEVEL_2048, 0, modes[m]);
+            databox box;
+
+            const uint64_t start = timeUtilMonotonicUs();
+            if (multilistQueuePopTimed(q, &box, 20000)) {
+                ERRR("Timed pop returned an entry from empty queue!");
+            }
+
+            const uint64_t waited = timeUtilMonotonicUs() - start;
+            if (waited < 15000) {
+                ERR("Timed pop returned after only %" PRIu64 " us!", waited);
+            }
+
+            box = databoxNewSigned(7);
+            multilistQueuePush(q, &box);
+            multilistQueueClose(q);
+
+            if (multilistQueuePush(q, &box)) {
+                ERRR("Push succeeded on closed queue!");
+            }
+
+            /* Entries queued before close still drain */
+            if (!multilistQueuePop(q, &box) || box.data.i != 7) {
+                ERRR("Entry queued before close was lost!");
+            }
+
+            if (multilistQueuePop(q, &box)) {
+                ERRR("Pop on closed empty queue returned an entry!");
+            }
+
+            multilistQueueFree(q);
+        }
+    }
+
+    TEST("MPMC: timed-out waiter leaves later waiters wakeable") {
+        multilistQueue *q =
+            multilistQueueNew(FLEX_CAP_LEVEL_2048, 0, MULTILIST_QUEUE_MPMC);
+        mlqTimedPopper t[3] = {{q, 10000, false},
+                               {q, 5000000, false},
+                               {q, 5000000, false}};
+        pthread_t threads[3];
+
+        /* First waiter queued is the one that times out, so its removal
+         * must hand the wait list tail to the next waiter before the third
+         * waiter appends behind it. */
+        for (size_t i = 0; i < 2; i++) {
+            pthread_create(&threads[i], NULL, mlqTimedPopperRun, &t[i]);
+            usleep(2000);
+        }
+
+        usleep(50000);
+        pthread_create(&threads[2], NULL, mlqTimedPopperRun, &t[2]);
+        usleep(10000);
+        const databox boxes[2] = {databoxNewSigned(1), databoxNewSigned(2)};
+        multilistQueuePush(q, &boxes[0]);
+        multilistQueuePush(q, &boxes[1]);
+
+        for (size_t i = 0; i < 3; i++) {
+            pthread_join(threads[i], NULL);
+        }
+
+        if (t[0].got || !t[1].got || !t[2].got) {
+            ERR("Timed waiters got (%d, %d, %d); expected (0, 1, 1)", t[0].got,
+                t[1].got, t[2].got);
+        }
+
+        multilistQueueFree(q);
+    }
+
+    TEST("SPSC: threaded producer/consumer keeps order") {
+        for (size_t batch = 1; batch <= 64; batch *= 8) {
+            multilistQueue *q =
+                multilistQueueNew(FLEX_CAP_LEVEL_2048, 0, MULTILIST_QUEUE_SPSC);
+            int64_t elapsed;
+            err += mlqRunThreads(q, 1, 1, 500000, batch, &elapsed);
+            multilistQueueFree(q);
+        }
+    }
+
+    TEST("MPMC: threaded producers/consumers keep per-producer order") {
+        for (size_t batch = 1; batch <= 64; batch *= 8) {
+            multilistQueue *q =
+                multilistQueueNew(FLEX_CAP_LEVEL_2048, 0, MULTILIST_QUEUE_MPMC);
+            int64_t elapsed;
+            err += mlqRunThreads(q, 4, 4, 100000, batch, &elapsed);
+            multilistQueueFree(q);
+        }
+    }
+
+    TEST("PERF: mutex+condvar multilist vs multilistQueue") {
+        const int64_t total = 2000000;
+
+        mlqLocked l = {.count = total};
+        pthread_mutex_init(&l.lock, NULL);
+        pthread_cond_init(&l.notEmpty, NULL);
+        l.ml = multilistNew(FLEX_CAP_LEVEL_2048, 0);
+        l.state = mflexStateCreate();
+
+        int64_t start = timeUtilMonotonicNs();
+        pthread_t producer;
+        pthread_create(&producer, NULL, mlqLockedProducerRun, &l);
+        for (int64_t i = 0; i < total; i++) {
+            databox box;
+            pthread_mutex_lock(&l.lock);
+            while (!multilistPopHead(&l.ml, l.state, &box)) {
+                pthread_cond_wait(&l.notEmpty, &l.lock);
+            }
+
+            pthread_mutex_unlock(&l.lock);
+            if (box.data.i != i) {
+                ERR("Locked baseline out of order at %" PRId64, i);
+                break;
+            }
+        }
+
+        pthread_join(producer, NULL);
+        const int64_t lockedNs = timeUtilMonotonicNs() - start;
+        multilistFree(l.ml);
+        mflexStateFree(l.state);
+        pthread_mutex_destroy(&l.lock);
+        pthread_cond_destroy(&l.notEmpty);
+
+        printf("1P/1C mutex+condvar multilist:  %6.2f M entries/s\n",
+               (double)total / lockedNs * 1000.0);
+
+        /* Same-thread push/pop pairs isolate per-operation overhead from
+         * scheduler handoffs (which dominate on machines with few cores). */
+        for (size_t m = 0; m < 2; m++) {
+            multilistQueue *q =
+                multilistQueueNew(FLEX_CAP_LEVEL_2048, 0, modes[m]);
+            databox boxes[64];
+            int64_t sink = 0;
+
+            start = timeUtilMonotonicNs();
+            for (int64_t i = 0; i < total; i++) {
+                const databox box = databoxNewSigned(i);
+                multilistQueuePush(q, &box);
+                (void)multilistQueueTryPop(q, &boxes[0]);
+                sink += boxes[0].data.i;
+            }
+            const int64_t singleNs = timeUtilMonotonicNs() - start;
+
+            start = timeUtilMonotonicNs();
+            for (int64_t i = 0; i < total; i += 64) {
+                for (size_t j = 0; j < 64; j++) {
+                    boxes[j] = databoxNewSigned(i + j);
+                }
+
+                multilistQueuePushMany(q, boxes, 64);
+                sink += multilistQueuePopMany(q, boxes, 64,
+                                              MULTILIST_QUEUE_NO_WAIT);
+            }
+            const int64_t batchNs = timeUtilMonotonicNs() - start;
+
+            printf("uncontended %s: %.1f ns/entry single, %.1f ns/entry "
+                   "batch 64 (%" PRId64 ")\n",
+                   modeNames[m], (double)singleNs / total,
+                   (double)batchNs / total, sink & 1);
+            multilistQueueFree(q);
+        }
+
+        const struct {
+            multilistQueueMode mode;
+            int64_t producers;
+            size_t batch;
+            const char *name;
+        } runs[] = {
+            {MULTILIST_QUEUE_MPMC, 1, 1, "1P/1C MPMC single"},
+            {MULTILIST_QUEUE_MPMC, 1, 64, "1P/1C MPMC batch 64"},
+            {MULTILIST_QUEUE_SPSC, 1, 1, "1P/1C SPSC single"},
+            {MULTILIST_QUEUE_SPSC, 1, 64, "1P/1C SPSC batch 64"},
+            {MULTILIST_QUEUE_MPMC, 4, 1, "4P/4C MPMC single"},
+            {MULTILIST_QUEUE_MPMC, 4, 64, "4P/4C MPMC batch 64"},
+        };
+
+        for (size_t r = 0; r < sizeof(runs) / sizeof(*runs); r++) {
+            multilistQueue *q =
+                multilistQueueNew(FLEX_CAP_LEVEL_2048, 0, runs[r].mode);
+            int64_t elapsed;
+            err += mlqRunThreads(q, runs[r].producers, runs[r].producers,
+                                 total / runs[r].producers, runs[r].batch,
+                                 &elapsed);
+            printf("%-30s %6.2f M entries/s\n", runs[r].name,
+                   (double)total / elapsed * 1000.0);
+            multilistQueueFree(q);
+        }
+    }
+
+    TEST_FINAL_RESULT;
+}
+#endif
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "databox.h"
+#include "flexCapacityManagement.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* multilistQueue is a blocking FIFO work queue between threads with
+ * entries stored in a multilist.
+ *
+ * MPMC mode: any number of pushing and popping threads; every operation
+ *            takes the queue fastMutex and poppers sleep on a fastCond.
+ * SPSC mode: exactly one pushing thread and one popping thread. Entries
+ *            move through a lock-free ring; the multilist (and the mutex)
+ *            is only used when the ring is full or a popper must sleep.
+ *
+ * Pushed boxes are copied into the queue. Popped boxes are owned by the
+ * caller and must be released with databoxFreeData(). */
+
+typedef struct multilistQueue multilistQueue;
+
+typedef enum multilistQueueMode {
+    MULTILIST_QUEUE_MPMC = 0,
+    MULTILIST_QUEUE_SPSC = 1,
+} multilistQueueMode;
+
+/* Timeouts for Pop/PopMany, in microseconds */
+#define MULTILIST_QUEUE_NO_WAIT 0
+#define MULTILIST_QUEUE_WAIT_FOREVER UINT64_MAX
+
+multilistQueue *multilistQueueNew(flexCapSizeLimit limit, uint32_t depth,
+                                  multilistQueueMode mode);
+void multilistQueueFree(multilistQueue *q);
+
+/* Wake all poppers and reject further pushes. Entries already queued can
+ * still be popped; pops return nothing once the queue is closed and empty. */
+void multilistQueueClose(multilistQueue *q);
+bool multilistQueueIsClosed(const multilistQueue *q);
+
+size_t multilistQueueCount(const multilistQueue *q);
+
+/* Returns false only if the queue is closed. */
+bool multilistQueuePush(multilistQueue *q, const databox *box);
+
+/* Push 'count' boxes with one lock acquisition (or one ring publish).
+ * Returns number of boxes pushed: 'count', or 0 if the queue is closed. */
+size_t multilistQueuePushMany(multilistQueue *q, const databox *boxes,
+                              size_t count);
+
+/* Pop up to 'maxCount' boxes into 'boxes', waiting up to 'timeoutUs' for
+ * the first one to arrive. Returns number of boxes popped; 0 on timeout
+ * or when the queue is closed and empty. */
+size_t multilistQueuePopMany(multilistQueue *q, databox *boxes,
+                             size_t maxCount, uint64_t timeoutUs);
+
+#define multilistQueuePop(q, box)                                              \
+    (multilistQueuePopMany(q, box, 1, MULTILIST_QUEUE_WAIT_FOREVER) == 1)
+#define multilistQueueTryPop(q, box)                                           \
+    (multilistQueuePopMany(q, box, 1, MULTILIST_QUEUE_NO_WAIT) == 1)
+#define multilistQueuePopTimed(q, box, timeoutUs)                              \
+    (multilistQueuePopMany(q, box, 1, timeoutUs) == 1)
+
+#ifdef DATAKIT_TEST
+int multilistQueueTest(int argc, char *argv[]);
+#endif
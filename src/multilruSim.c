@@ -0,0 +1,1035 @@
+#include "multilruSim.h"
+#include "datakit.h"
+
+#ifndef XXH_INLINE_ALL
+#define XXH_INLINE_ALL
+#endif
+#include "../deps/xxHash/xxhash.h"
+
+#include <ctype.h>
+#include <inttypes.h>
+#include <math.h>
+#include <string.h>
+
+/* ====================================================================
+ * Sampled Trace Storage
+ * ==================================================================== */
+/* Spatial sampling modulus: keys with (hash & MASK) < threshold are kept */
+#define SIM_SAMPLE_BITS 24
+#define SIM_SAMPLE_MODULUS (1ULL << SIM_SAMPLE_BITS)
+#define SIM_SAMPLE_MASK (SIM_SAMPLE_MODULUS - 1)
+
+/* Fixed seed so the same key set is sampled across runs */
+#define SIM_HASH_SEED 0x6d6c7275u
+
+struct multilruSimTrace {
+    uint64_t *keys;    /* Key hashes of sampled accesses */
+    uint64_t *weights; /* Weights of sampled accesses (NULL = all 1) */
+    size_t count;      /* Sampled accesses stored */
+    size_t capacity;   /* Allocated slots in keys[] / weights[] */
+
+    uint64_t total;     /* Accesses seen before sampling */
+    uint64_t threshold; /* Sample iff (hash & SIM_SAMPLE_MASK) < threshold */
+    double rate;
+    uint64_t weightSum; /* Sum of sampled weights (for HYBRID limit) */
+};
+
+multilruSimTrace *multilruSimTraceNew(double sampleRate) {
+    multilruSimTrace *trace = zcalloc(1, sizeof(*trace));
+
+    if (!(sampleRate > 0 && sampleRate <= 1)) {
+        sampleRate = 1;
+    }
+
+    trace->threshold = (uint64_t)(sampleRate * SIM_SAMPLE_MODULUS);
+    if (trace->threshold == 0) {
+        trace->threshold = 1;
+    }
+
+    /* Report the rate actually realized by the integer threshold */
+    trace->rate = (double)trace->threshold / SIM_SAMPLE_MODULUS;
+    return trace;
+}
+
+void multilruSimTraceFree(multilruSimTrace *trace) {
+    if (!trace) {
+        return;
+    }
+
+    zfree(trace->keys);
+    zfree(trace->weights);
+    zfree(trace);
+}
+
+static bool traceAppend(multilruSimTrace *trace, uint64_t hash,
+                        uint64_t weight) {
+    trace->total++;
+
+    if ((hash & SIM_SAMPLE_MASK) >= trace->threshold) {
+        return false;
+    }
+
+    if (trace->count == trace->capacity) {
+        trace->capacity = trace->capacity ? trace->capacity * 2 : 4096;
+        trace->keys =
+            zrealloc(trace->keys, trace->capacity * sizeof(*trace->keys));
+        if (trace->weights) {
+            trace->weights = zrealloc(
+                trace->weights, trace->capacity * sizeof(*trace->weights));
+        }
+    }
+
+    /* Weights are only materialized once a non-unit weight shows up */
+    if (weight != 1 && !trace->weights) {
+        trace->weights = zcalloc(trace->capacity, sizeof(*trace->weights));
+        for (size_t i = 0; i < trace->count; i++) {
+            trace->weights[i] = 1;
+        }
+    }
+
+    trace->keys[trace->count] = hash;
+    if (trace->weights) {
+        trace->weights[trace->count] = weight;
+    }
+
+    trace->count++;
+    trace->weightSum += weight;
+    return true;
+}
+
+bool multilruSimTraceAccess(multilruSimTrace *trace, uint64_t key,
+                            uint64_t weight) {
+    /* Hash the little-endian representation so text and binary traces
+     * of the same integer keys sample identically. */
+    uint8_t le[8];
+    for (size_t i = 0; i < 8; i++) {
+        le[i] = (uint8_t)(key >> (i * 8));
+    }
+
+    return traceAppend(trace, XXH3_64bits_withSeed(le, 8, SIM_HASH_SEED),
+                       weight);
+}
+
+bool multilruSimTraceAccessBytes(multilruSimTrace *trace, const void *key,
+                                 size_t len, uint64_t weight) {
+    return traceAppend(trace, XXH3_64bits_withSeed(key, len, SIM_HASH_SEED),
+                       weight);
+}
+
+/* Parse an unsigned decimal token; false if any non-digit is present */
+static bool parseU64(const char *s, size_t len, uint64_t *out) {
+    if (len == 0 || len > 20) {
+        return false;
+    }
+
+    uint64_t v = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (!isdigit((unsigned char)s[i])) {
+            return false;
+        }
+
+        uint64_t digit = (uint64_t)(s[i] - '0');
+        if (v > (UINT64_MAX - digit) / 10) {
+            return false;
+        }
+
+        v = v * 10 + digit;
+    }
+
+    *out = v;
+    return true;
+}
+
+bool multilruSimTraceLoadText(multilruSimTrace *trace, FILE *fp) {
+    char line[4096];
+
+    while (fgets(line, sizeof(line), fp)) {
+        char *p = line;
+        while (*p && isspace((unsigned char)*p)) {
+            p++;
+        }
+
+        if (*p == '\0' || *p == '#') {
+            continue;
+        }
+
+        const char *keyStart = p;
+        while (*p && !isspace((unsigned char)*p)) {
+            p++;
+        }
+
+        const size_t keyLen = p - keyStart;
+
+        while (*p && isspace((unsigned char)*p)) {
+            p++;
+        }
+
+        uint64_t weight = 1;
+        if (*p) {
+            const char *weightStart = p;
+            while (*p && !isspace((unsigned char)*p)) {
+                p++;
+            }
+
+            if (!parseU64(weightStart, p - weightStart, &weight)) {
+                return false;
+            }
+        }
+
+        uint64_t intKey;
+        if (parseU64(keyStart, keyLen, &intKey)) {
+            multilruSimTraceAccess(trace, intKey, weight);
+        } else {
+            multilruSimTraceAccessBytes(trace, keyStart, keyLen, weight);
+        }
+    }
+
+    return !ferror(fp);
+}
+
+static uint64_t loadLE64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < 8; i++) {
+        v |= (uint64_t)p[i] << (i * 8);
+    }
+
+    return v;
+}
+
+bool multilruSimTraceLoadBinary(multilruSimTrace *trace, FILE *fp,
+                                bool weighted) {
+    const size_t recordSize = weighted ? 16 : 8;
+    uint8_t buf[16 * 4096];
+    size_t got;
+
+    while ((got = fread(buf, recordSize, sizeof(buf) / recordSize, fp)) > 0) {
+        for (size_t i = 0; i < got; i++) {
+            const uint8_t *record = buf + (i * recordSize);
+            const uint64_t key = loadLE64(record);
+            const uint64_t weight = weighted ? loadLE64(record + 8) : 1;
+            multilruSimTraceAccess(trace, key, weight);
+        }
+    }
+
+    return !ferror(fp);
+}
+
+bool multilruSimTraceLoadTextFile(multilruSimTrace *trace, const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        return false;
+    }
+
+    const bool ok = multilruSimTraceLoadText(trace, fp);
+    fclose(fp);
+    return ok;
+}
+
+bool multilruSimTraceLoadBinaryFile(multilruSimTrace *trace, const char *path,
+                                    bool weighted) {
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+        return false;
+    }
+
+    const bool ok = multilruSimTraceLoadBinary(trace, fp, weighted);
+    fclose(fp);
+    return ok;
+}
+
+double multilruSimTraceSampleRate(const multilruSimTrace *trace) {
+    return trace->rate;
+}
+
+uint64_t multilruSimTraceTotalAccesses(const multilruSimTrace *trace) {
+    return trace->total;
+}
+
+uint64_t multilruSimTraceSampledAccesses(const multilruSimTrace *trace) {
+    return trace->count;
+}
+
+/* ====================================================================
+ * Resident Key Map
+ * ====================================================================
+ * Open-addressed (linear probing) map of key hash -> multilruPtr for
+ * resident keys, plus a dense multilruPtr -> key hash array so evicted
+ * handles returned by multilruEvictN() can be removed from the map.
+ * Deletion uses backward-shift so no tombstones accumulate. */
+typedef struct simSlot {
+    uint64_t key;
+    multilruPtr ptr; /* 0 = empty slot */
+} simSlot;
+
+typedef struct simMap {
+    simSlot *slots;
+    size_t mask;
+    size_t count;
+    uint8_t bits;
+
+    uint64_t *ptrKey; /* ptrKey[ptr] = key hash of resident entry */
+    size_t ptrKeyCapacity;
+} simMap;
+
+static inline size_t simMapBucket(const simMap *map, uint64_t key) {
+    /* Sampled keys have biased low bits; take the high bits instead */
+    return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> (64 - map->bits));
+}
+
+static void simMapInit(simMap *map, uint8_t bits) {
+    map->bits = bits;
+    map->mask = (1ULL << bits) - 1;
+    map->count = 0;
+    map->slots = zcalloc(map->mask + 1, sizeof(*map->slots));
+}
+
+static multilruPtr simMapGet(const simMap *map, uint64_t key) {
+    for (size_t i = simMapBucket(map, key);; i = (i + 1) & map->mask) {
+        const simSlot *slot = &map->slots[i];
+        if (!slot->ptr) {
+            return 0;
+        }
+
+        if (slot->key == key) {
+            return slot->ptr;
+        }
+    }
+}
+
+static void simMapInsertSlot(simMap *map, uint64_t key, multilruPtr ptr) {
+    size_t i = simMapBucket(map, key);
+    while (map->slots[i].ptr) {
+        i = (i + 1) & map->mask;
+    }
+
+    map->slots[i].key = key;
+    map->slots[i].ptr = ptr;
+    map->count++;
+}
+
+static void simMapPut(simMap *map, uint64_t key, multilruPtr ptr) {
+    /* Grow at 50% load */
+    if ((map->count + 1) * 2 > map->mask + 1) {
+        simSlot *old = map->slots;
+        const size_t oldSize = map->mask + 1;
+
+        simMapInit(map, map->bits + 1);
+        for (size_t i = 0; i < oldSize; i++) {
+            if (old[i].ptr) {
+                simMapInsertSlot(map, old[i].key, old[i].ptr);
+            }
+        }
+
+        zfree(old);
+    }
+
+    simMapInsertSlot(map, key, ptr);
+
+    if (ptr >= map->ptrKeyCapacity) {
+        size_t newCapacity = map->ptrKeyCapacity ? map->ptrKeyCapacity : 1024;
+        while (newCapacity <= ptr) {
+            newCapacity *= 2;
+        }
+
+        map->ptrKey = zrealloc(map->ptrKey, newCapacity * sizeof(uint64_t));
+        map->ptrKeyCapacity = newCapacity;
+    }
+
+    map->ptrKey[ptr] = key;
+}
+
+static void simMapDelete(simMap *map, uint64_t key) {
+    size_t i = simMapBucket(map, key);
+    while (map->slots[i].key != key || !map->slots[i].ptr) {
+        if (!map->slots[i].ptr) {
+            return;
+        }
+
+        i = (i + 1) & map->mask;
+    }
+
+    /* Backward-shift following entries into the hole */
+    size_t hole = i;
+    for (size_t j = (i + 1) & map->mask; map->slots[j].ptr;
+         j = (j + 1) & map->mask) {
+        const size_t home = simMapBucket(map, map->slots[j].key);
+
+        /* Entry at j may move to 'hole' only if its home bucket is not
+         * cyclically inside (hole, j] */
+        const bool homeInRange = (hole <= j) ? (hole < home && home <= j)
+                                             : (hole < home || home <= j);
+        if (!homeInRange) {
+            map->slots[hole] = map->slots[j];
+            hole = j;
+        }
+    }
+
+    map->slots[hole].ptr = 0;
+    map->count--;
+}
+
+static void simMapFree(simMap *map) {
+    zfree(map->slots);
+    zfree(map->ptrKey);
+}
+
+/* ====================================================================
+ * Simulation
+ * ==================================================================== */
+#define SIM_EVICT_BATCH 64
+
+static uint64_t scaleCapacity(const multilruSimTrace *trace,
+                              uint64_t capacity) {
+    const uint64_t scaled = (uint64_t)llround((double)capacity * trace->rate);
+    return scaled ? scaled : 1;
+}
+
+static bool simulateOne(const multilruSimTrace *trace,
+                        const multilruSimConfig *config, uint64_t capacity,
+                        multilruSimPoint *point) {
+    const uint64_t scaled = scaleCapacity(trace, capacity);
+
+    multilruConfig lruConfig = {
+        .maxLevels = config->maxLevels,
+        .startCapacity = 0,
+        .policy = config->policy,
+        .evictStrategy = config->evictStrategy,
+    };
+
+    switch (config->policy) {
+    case MLRU_POLICY_COUNT:
+        lruConfig.maxCount = scaled;
+        break;
+    case MLRU_POLICY_SIZE:
+        lruConfig.maxWeight = scaled;
+        lruConfig.enableWeights = true;
+        break;
+    case MLRU_POLICY_HYBRID: {
+        const uint64_t meanWeight =
+            trace->count ? (trace->weightSum + trace->count - 1) / trace->count
+                         : 1;
+        lruConfig.maxCount = scaled;
+        lruConfig.maxWeight = scaled * (meanWeight ? meanWeight : 1);
+        lruConfig.enableWeights = true;
+        break;
+    }
+    default:
+        return false;
+    }
+
+    multilru *mlru = multilruNewWithConfig(&lruConfig);
+    if (!mlru) {
+        return false;
+    }
+
+    /* Eviction is driven here through multilruEvictN() so evicted handles
+     * can be mapped back to keys. */
+    multilruSetAutoEvict(mlru, false);
+
+    simMap map = {0};
+    simMapInit(&map, 10);
+
+    multilruPtr evicted[SIM_EVICT_BATCH];
+    uint64_t hits = 0;
+
+    for (size_t i = 0; i < trace->count; i++) {
+        const uint64_t key = trace->keys[i];
+        const multilruPtr found = simMapGet(&map, key);
+
+        if (found) {
+            multilruIncrease(mlru, found);
+            hits++;
+            continue;
+        }
+
+        const uint64_t weight = trace->weights ? trace->weights[i] : 1;
+        const multilruPtr ptr = multilruInsertWeighted(mlru, weight);
+        if (!ptr) {
+            simMapFree(&map);
+            multilruFree(mlru);
+            return false;
+        }
+
+        simMapPut(&map, key, ptr);
+
+        while (multilruNeedsEviction(mlru)) {
+            /* Count-limited caches know exactly how many victims are
+             * needed; weight limits are satisfied one victim at a time. */
+            const size_t count = multilruCount(mlru);
+            size_t want = 1;
+            if (lruConfig.maxCount && count > lruConfig.maxCount) {
+                want = count - lruConfig.maxCount;
+                if (want > SIM_EVICT_BATCH) {
+                    want = SIM_EVICT_BATCH;
+                }
+            }
+
+            const size_t got = multilruEvictN(mlru, evicted, want);
+            if (!got) {
+                break;
+            }
+
+            for (size_t j = 0; j < got; j++) {
+                simMapDelete(&map, map.ptrKey[evicted[j]]);
+            }
+        }
+    }
+
+    point->capacity = capacity;
+    point->scaledCapacity = scaled;
+    point->accesses = trace->count;
+    point->hits = hits;
+    point->hitRatio = trace->count ? (double)hits / trace->count : 0;
+
+    simMapFree(&map);
+    multilruFree(mlru);
+    return true;
+}
+
+bool multilruSimRun(const multilruSimTrace *trace,
+                    const multilruSimConfig *config,
+                    const uint64_t capacities[], size_t count,
+                    multilruSimPoint out[]) {
+    for (size_t i = 0; i < count; i++) {
+        if (!simulateOne(trace, config, capacities[i], &out[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static const char *policyName(multilruPolicy policy) {
+    switch (policy) {
+    case MLRU_POLICY_COUNT:
+        return "count";
+    case MLRU_POLICY_SIZE:
+        return "size";
+    case MLRU_POLICY_HYBRID:
+        return "hybrid";
+    default:
+        return "unknown";
+    }
+}
+
+static const char *strategyName(multilruEvictStrategy strategy) {
+    switch (strategy) {
+    case MLRU_EVICT_LRU:
+        return "lru";
+    case MLRU_EVICT_SIZE_WEIGHTED:
+        return "size-weighted";
+    case MLRU_EVICT_SIZE_LRU:
+        return "size-lru";
+    default:
+        return "unknown";
+    }
+}
+
+bool multilruSimSweep(const multilruSimTrace *trace, const size_t levels[],
+                      size_t levelCount, const uint64_t capacities[],
+                      size_t capacityCount, FILE *out) {
+    static const multilruPolicy policies[] = {
+        MLRU_POLICY_COUNT, MLRU_POLICY_SIZE, MLRU_POLICY_HYBRID};
+    static const multilruEvictStrategy strategies[] = {
+        MLRU_EVICT_LRU, MLRU_EVICT_SIZE_WEIGHTED, MLRU_EVICT_SIZE_LRU};
+
+    multilruSimPoint *points = zcalloc(capacityCount, sizeof(*points));
+    bool ok = true;
+
+    fprintf(out, "levels,policy,strategy,capacity,scaledCapacity,accesses,"
+                 "hits,hitRatio\n");
+
+    for (size_t l = 0; l < levelCount && ok; l++) {
+        for (size_t p = 0; p < COUNT_ARRAY(policies) && ok; p++) {
+            for (size_t s = 0; s < COUNT_ARRAY(strategies) && ok; s++) {
+                const multilruSimConfig config = {
+                    .maxLevels = levels[l],
+                    .policy = policies[p],
+                    .evictStrategy = strategies[s],
+                };
+
+                ok = multilruSimRun(trace, &config, capacities, capacityCount,
+                                    points);
+
+                for (size_t c = 0; c < capacityCount && ok; c++) {
+                    fprintf(out,
+                            "%zu,%s,%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64
+                            ",%" PRIu64 ",%.6f\n",
+                            levels[l], policyName(policies[p]),
+                            strategyName(strategies[s]), points[c].capacity,
+                            points[c].scaledCapacity, points[c].accesses,
+                            points[c].hits, points[c].hitRatio);
+                }
+            }
+        }
+    }
+
+    zfree(points);
+    return ok;
+}
+
+size_t multilruSimCapacitiesGeometric(uint64_t minCapacity,
+                                      uint64_t maxCapacity, size_t count,
+                                      uint64_t capacities[]) {
+    if (count == 0) {
+        return 0;
+    }
+
+    if (minCapacity == 0) {
+        minCapacity = 1;
+    }
+
+    if (maxCapacity < minCapacity) {
+        maxCapacity = minCapacity;
+    }
+
+    if (count == 1) {
+        capacities[0] = maxCapacity;
+        return 1;
+    }
+
+    const double ratio =
+        pow((double)maxCapacity / minCapacity, 1.0 / (double)(count - 1));
+
+    size_t written = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t cap = (uint64_t)llround(minCapacity * pow(ratio, (double)i));
+        if (i == count - 1) {
+            cap = maxCapacity;
+        }
+
+        /* Small ranges round several points onto the same capacity */
+        if (written == 0 || cap > capacities[written - 1]) {
+            capacities[written++] = cap;
+        }
+    }
+
+    return written;
+}
+
+/* ====================================================================
+ * Command-Line Front End
+ * ==================================================================== */
+#define SIM_MAX_LEVEL_ARGS 64
+#define SIM_MAX_POINTS 256
+
+static void simUsage(void) {
+    fprintf(stderr,
+            "Usage: lrusim <trace> [--binary|--binary-weighted] [--rate R]\n"
+            "              [--levels 1,4,7] [--min C] [--max C] [--points N]\n"
+            "\n"
+            "Replays <trace> through multilru for every policy/strategy\n"
+            "and level count; writes a CSV hit ratio curve to stdout.\n");
+}
+
+int multilruSimMain(int argc, char *argv[]) {
+    if (argc < 1) {
+        simUsage();
+        return 1;
+    }
+
+    const char *path = argv[0];
+    bool binary = false;
+    bool weighted = false;
+    double rate = 1.0;
+    uint64_t minCapacity = 0;
+    uint64_t maxCapacity = 0;
+    size_t pointCount = 16;
+    size_t levels[SIM_MAX_LEVEL_ARGS] = {1, 4, 7};
+    size_t levelCount = 3;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (!strcmp(arg, "--binary")) {
+            binary = true;
+        } else if (!strcmp(arg, "--binary-weighted")) {
+            binary = true;
+            weighted = true;
+        } else if (!strcmp(arg, "--rate") && hasValue) {
+            rate = atof(argv[++i]);
+        } else if (!strcmp(arg, "--min") && hasValue) {
+            minCapacity = strtoull(argv[++i], NULL, 10);
+        } else if (!strcmp(arg, "--max") && hasValue) {
+            maxCapacity = strtoull(argv[++i], NULL, 10);
+        } else if (!strcmp(arg, "--points") && hasValue) {
+            pointCount = strtoull(argv[++i], NULL, 10);
+        } else if (!strcmp(arg, "--levels") && hasValue) {
+            const char *p = argv[++i];
+            levelCount = 0;
+            while (*p && levelCount < SIM_MAX_LEVEL_ARGS) {
+                char *end;
+                levels[levelCount++] = strtoull(p, &end, 10);
+                p = (*end == ',') ? end + 1 : end;
+                if (end == p && *p) {
+                    break;
+                }
+            }
+        } else {
+            simUsage();
+            return 1;
+        }
+    }
+
+    if (!(rate > 0 && rate <= 1) || pointCount == 0 || levelCount == 0) {
+        simUsage();
+        return 1;
+    }
+
+    if (pointCount > SIM_MAX_POINTS) {
+        pointCount = SIM_MAX_POINTS;
+    }
+
+    multilruSimTrace *trace = multilruSimTraceNew(rate);
+    const bool loaded =
+        binary ? multilruSimTraceLoadBinaryFile(trace, path, weighted)
+               : multilruSimTraceLoadTextFile(trace, path);
+    if (!loaded) {
+        fprintf(stderr, "lrusim: failed to read trace '%s'\n", path);
+        multilruSimTraceFree(trace);
+        return 1;
+    }
+
+    fprintf(stderr,
+            "lrusim: %" PRIu64 " accesses, %" PRIu64
+            " sampled (rate %.6f)\n",
+            multilruSimTraceTotalAccesses(trace),
+            multilruSimTraceSampledAccesses(trace),
+            multilruSimTraceSampleRate(trace));
+
+    /* Default range: up to the number of accesses seen (an upper bound on
+     * the working set), starting a few decades below it. */
+    if (maxCapacity == 0) {
+        maxCapacity = multilruSimTraceTotalAccesses(trace);
+    }
+
+    if (minCapacity == 0) {
+        minCapacity = maxCapacity / 1000;
+    }
+
+    uint64_t capacities[SIM_MAX_POINTS];
+    const size_t capacityCount = multilruSimCapacitiesGeometric(
+        minCapacity, maxCapacity, pointCount, capacities);
+
+    const bool ok = multilruSimSweep(trace, levels, levelCount, capacities,
+                                     capacityCount, stdout);
+    multilruSimTraceFree(trace);
+    return ok ? 0 : 1;
+}
+
+/* ====================================================================
+ * Tests
+ * ==================================================================== */
+#ifdef DATAKIT_TEST
+#include "ctest.h"
+#include "str.h"
+#include "timeUtil.h"
+
+#include <unistd.h>
+
+/* Skewed key generator: key = floor(n * u^skew) concentrates on low keys */
+static uint64_t simSkewedKey(uint64_t seed[2], uint64_t n, double skew) {
+    const double u = (double)(xoroshiro128plus(seed) >> 11) / (1ULL << 53);
+    return (uint64_t)(n * pow(u, skew));
+}
+
+static void simFillSkewed(multilruSimTrace *trace, size_t accesses,
+                          uint64_t keySpace) {
+    uint64_t seed[2] = {0x1234, 0x5678};
+    for (size_t i = 0; i < accesses; i++) {
+        multilruSimTraceAccess(trace, simSkewedKey(seed, keySpace, 3.0), 1);
+    }
+}
+
+int multilruSimTest(int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int err = 0;
+
+    TEST("key map insert / lookup / backward-shift delete") {
+        simMap map = {0};
+        simMapInit(&map, 4);
+
+        for (uint64_t i = 1; i <= 1000; i++) {
+            simMapPut(&map, i * 0x1000000, i);
+        }
+
+        for (uint64_t i = 1; i <= 1000; i += 2) {
+            simMapDelete(&map, map.ptrKey[i]);
+        }
+
+        if (map.count != 500) {
+            ERR("Expected 500 resident keys, got %zu", map.count);
+        }
+
+        for (uint64_t i = 1; i <= 1000; i++) {
+            const multilruPtr got = simMapGet(&map, i * 0x1000000);
+            const multilruPtr expected = (i % 2) ? 0 : i;
+            if (got != expected) {
+                ERR("Key %" PRIu64 ": expected ptr %" PRIu64 ", got %zu", i,
+                    expected, got);
+                break;
+            }
+        }
+
+        simMapFree(&map);
+    }
+
+    TEST("unsampled trace: repeated working set fits exactly") {
+        multilruSimTrace *trace = multilruSimTraceNew(1.0);
+
+        /* 100 distinct keys accessed 10 times each, round-robin */
+        for (size_t round = 0; round < 10; round++) {
+            for (uint64_t k = 0; k < 100; k++) {
+                multilruSimTraceAccess(trace, k, 1);
+            }
+        }
+
+        const uint64_t caps[] = {50, 100, 200};
+        multilruSimPoint points[3];
+
+        for (size_t p = 0; p < 3; p++) {
+            const multilruSimConfig config = {.maxLevels = 4,
+                                              .policy = (multilruPolicy)p};
+            if (!multilruSimRun(trace, &config, caps, 3, points)) {
+                ERRR("Simulation failed");
+            }
+
+            /* At or above the working set every non-compulsory access hits */
+            for (size_t c = 1; c < 3; c++) {
+                if (points[c].hits != 900) {
+                    ERR("policy %zu cap %" PRIu64 ": expected 900 hits, got "
+                        "%" PRIu64,
+                        p, caps[c], points[c].hits);
+                }
+            }
+
+            /* Round-robin over a working set larger than the cache always
+             * misses under LRU ordering at level 0 */
+            if (points[0].hits >= points[1].hits) {
+                ERR("policy %zu: hits at cap 50 (%" PRIu64
+                    ") should be below cap 100",
+                    p, points[0].hits);
+            }
+        }
+
+        multilruSimTraceFree(trace);
+    }
+
+    TEST("hit ratio is non-decreasing in capacity") {
+        multilruSimTrace *trace = multilruSimTraceNew(1.0);
+        simFillSkewed(trace, 200000, 50000);
+
+        uint64_t caps[8];
+        const size_t n = multilruSimCapacitiesGeometric(100, 50000, 8, caps);
+        multilruSimPoint points[8];
+
+        const multilruSimConfig config = {.maxLevels = 4,
+                                          .policy = MLRU_POLICY_COUNT};
+        multilruSimRun(trace, &config, caps, n, points);
+
+        for (size_t i = 1; i < n; i++) {
+            /* Allow tiny non-monotonicity from S4LRU demotion ordering */
+            if (points[i].hitRatio + 0.005 < points[i - 1].hitRatio) {
+                ERR("Hit ratio dropped from %.4f to %.4f between caps %" PRIu64
+                    " and %" PRIu64,
+                    points[i - 1].hitRatio, points[i].hitRatio, caps[i - 1],
+                    caps[i]);
+            }
+        }
+
+        multilruSimTraceFree(trace);
+    }
+
+    TEST("SHARDS sampling approximates the full curve") {
+        multilruSimTrace *full = multilruSimTraceNew(1.0);
+        multilruSimTrace *sampled = multilruSimTraceNew(0.05);
+        simFillSkewed(full, 400000, 100000);
+        simFillSkewed(sampled, 400000, 100000);
+
+        const uint64_t sampledCount =
+            multilruSimTraceSampledAccesses(sampled);
+        if (sampledCount == 0 || sampledCount > 400000 / 5) {
+            ERR("Unexpected sampled access count %" PRIu64, sampledCount);
+        }
+
+        if (multilruSimTraceTotalAccesses(sampled) != 400000) {
+            ERR("Total accesses should be 400000, got %" PRIu64,
+                multilruSimTraceTotalAccesses(sampled));
+        }
+
+        const uint64_t caps[] = {2000, 8000, 32000};
+        multilruSimPoint fullPoints[3];
+        multilruSimPoint sampledPoints[3];
+        const multilruSimConfig config = {.maxLevels = 4,
+                                          .policy = MLRU_POLICY_COUNT};
+
+        multilruSimRun(full, &config, caps, 3, fullPoints);
+        multilruSimRun(sampled, &config, caps, 3, sampledPoints);
+
+        for (size_t i = 0; i < 3; i++) {
+            const double delta =
+                fabs(fullPoints[i].hitRatio - sampledPoints[i].hitRatio);
+            printf("cap %6" PRIu64
+                   ": full %.4f sampled %.4f (scaled cap %" PRIu64 ")\n",
+                   caps[i], fullPoints[i].hitRatio, sampledPoints[i].hitRatio,
+                   sampledPoints[i].scaledCapacity);
+            if (delta > 0.05) {
+                ERR("Sampled hit ratio off by %.4f at capacity %" PRIu64,
+                    delta, caps[i]);
+            }
+        }
+
+        multilruSimTraceFree(full);
+        multilruSimTraceFree(sampled);
+    }
+
+    TEST("weighted size policy evicts by weight") {
+        multilruSimTrace *trace = multilruSimTraceNew(1.0);
+
+        /* Two keys of weight 60 alternate: a 100-unit cache holds one */
+        for (size_t i = 0; i < 100; i++) {
+            multilruSimTraceAccess(trace, i % 2, 60);
+        }
+
+        const uint64_t caps[] = {100, 120};
+        multilruSimPoint points[2];
+        const multilruSimConfig config = {.maxLevels = 2,
+                                          .policy = MLRU_POLICY_SIZE};
+        multilruSimRun(trace, &config, caps, 2, points);
+
+        if (points[0].hits != 0) {
+            ERR("Expected 0 hits at weight cap 100, got %" PRIu64,
+                points[0].hits);
+        }
+
+        if (points[1].hits != 98) {
+            ERR("Expected 98 hits at weight cap 120, got %" PRIu64,
+                points[1].hits);
+        }
+
+        multilruSimTraceFree(trace);
+    }
+
+    TEST("text and binary traces load identically") {
+        char textPath[] = "/tmp/multilruSimTextXXXXXX";
+        char binPath[] = "/tmp/multilruSimBinXXXXXX";
+        const int textFd = mkstemp(textPath);
+        const int binFd = mkstemp(binPath);
+        FILE *text = fdopen(textFd, "w");
+        FILE *bin = fdopen(binFd, "wb");
+
+        fprintf(text, "# comment line\n\n");
+        for (uint64_t i = 0; i < 5000; i++) {
+            const uint64_t key = (i * 7919) % 1000;
+            fprintf(text, "%" PRIu64 "\n", key);
+
+            uint8_t le[8];
+            for (size_t b = 0; b < 8; b++) {
+                le[b] = (uint8_t)(key >> (b * 8));
+            }
+
+            fwrite(le, 1, sizeof(le), bin);
+        }
+
+        fprintf(text, "not-a-number 5\n");
+        fclose(text);
+        fclose(bin);
+
+        multilruSimTrace *fromText = multilruSimTraceNew(1.0);
+        multilruSimTrace *fromBin = multilruSimTraceNew(1.0);
+
+        if (!multilruSimTraceLoadTextFile(fromText, textPath)) {
+            ERRR("Failed to load text trace");
+        }
+
+        if (!multilruSimTraceLoadBinaryFile(fromBin, binPath, false)) {
+            ERRR("Failed to load binary trace");
+        }
+
+        if (multilruSimTraceTotalAccesses(fromText) != 5001 ||
+            multilruSimTraceTotalAccesses(fromBin) != 5000) {
+            ERR("Unexpected access counts: text %" PRIu64 " binary %" PRIu64,
+                multilruSimTraceTotalAccesses(fromText),
+                multilruSimTraceTotalAccesses(fromBin));
+        }
+
+        for (size_t i = 0; i < fromBin->count; i++) {
+            if (fromText->keys[i] != fromBin->keys[i]) {
+                ERR("Key hash mismatch at access %zu", i);
+                break;
+            }
+        }
+
+        if (!fromText->weights || fromText->weights[5000] != 5) {
+            ERRR("Text weight column was not parsed");
+        }
+
+        multilruSimTraceFree(fromText);
+        multilruSimTraceFree(fromBin);
+        unlink(textPath);
+        unlink(binPath);
+    }
+
+    TEST("sweep covers every policy and strategy") {
+        multilruSimTrace *trace = multilruSimTraceNew(1.0);
+        simFillSkewed(trace, 20000, 5000);
+
+        const size_t levels[] = {1, 4};
+        const uint64_t caps[] = {100, 1000};
+
+        FILE *out = tmpfile();
+        if (!multilruSimSweep(trace, levels, 2, caps, 2, out)) {
+            ERRR("Sweep failed");
+        }
+
+        rewind(out);
+
+        size_t lines = 0;
+        int ch;
+        while ((ch = fgetc(out)) != EOF) {
+            lines += ch == '\n';
+        }
+
+        fclose(out);
+
+        /* header + levels(2) * policies(3) * strategies(3) * caps(2) */
+        if (lines != 1 + 2 * 3 * 3 * 2) {
+            ERR("Expected 37 CSV lines, got %zu", lines);
+        }
+
+        multilruSimTraceFree(trace);
+    }
+
+    TEST("sampled replay throughput") {
+        const size_t accesses = 2000000;
+        multilruSimTrace *trace = multilruSimTraceNew(0.01);
+
+        int64_t startNs = timeUtilMonotonicNs();
+        simFillSkewed(trace, accesses, 1000000);
+        const int64_t loadNs = timeUtilMonotonicNs() - startNs;
+
+        uint64_t caps[8];
+        const size_t n =
+            multilruSimCapacitiesGeometric(1000, 1000000, 8, caps);
+        multilruSimPoint points[8];
+        const multilruSimConfig config = {.maxLevels = 7,
+                                          .policy = MLRU_POLICY_COUNT};
+
+        startNs = timeUtilMonotonicNs();
+        multilruSimRun(trace, &config, caps, n, points);
+        const int64_t runNs = timeUtilMonotonicNs() - startNs;
+
+        printf("Sampled %" PRIu64 " of %zu accesses: load %.2f M acc/s, "
+               "%zu-point curve in %.2f ms\n",
+               multilruSimTraceSampledAccesses(trace), accesses,
+               (accesses / (loadNs / 1e9)) / 1e6, n, runNs / 1e6);
+
+        multilruSimTraceFree(trace);
+    }
+
+    TEST_FINAL_RESULT;
+}
+#endif
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "multilru.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* ====================================================================
+ * multilru Trace-Replay Cache Simulator
+ * ====================================================================
+ *
+ * OVERVIEW
+ * --------
+ * Replays key-access traces through a real multilru instance and reports
+ * hit ratio vs. capacity (the inverse of a miss-ratio curve) for any
+ * combination of level count, multilruPolicy, and multilruEvictStrategy.
+ *
+ * Each access in the trace is treated as a cache lookup:
+ *   - hit:  key is resident, entry is promoted via multilruIncrease()
+ *   - miss: key is inserted at level 0; if the cache is over its limit,
+ *           victims are removed through multilruEvictN() (full S4LRU
+ *           demotion semantics) and their keys are dropped from the
+ *           simulator's key map.
+ *
+ * SPATIAL SAMPLING (SHARDS)
+ * -------------------------
+ * Large traces are reduced with fixed-rate spatial hash sampling: a key is
+ * kept iff (hash(key) mod P) < R*P, so either every access to a key is
+ * kept or none are. A cache of capacity C on the full trace behaves like
+ * a cache of capacity R*C on the sampled trace, so each simulated point
+ * runs with the capacity scaled by R. With R = 0.001, a 1B-access trace
+ * replays only ~1M accesses per curve point.
+ *
+ * Sampling happens once while the trace is loaded; only sampled accesses
+ * are kept in memory (16 bytes each) and are replayed for every point.
+ *
+ * TRACE FORMATS
+ * -------------
+ * Text: one access per line, "<key> [weight]". Keys are arbitrary tokens;
+ *       tokens that are plain unsigned decimal integers hash identically
+ *       to the same integer in a binary trace. Blank lines and lines
+ *       starting with '#' are ignored.
+ *
+ * Binary: packed little-endian uint64_t keys, or (key, weight) uint64_t
+ *         pairs when loaded with weighted = true.
+ *
+ * Accesses without an explicit weight have weight 1.
+ *
+ * CAPACITY UNITS
+ * --------------
+ *   MLRU_POLICY_COUNT:  capacity is an entry count
+ *   MLRU_POLICY_SIZE:   capacity is a total weight
+ *   MLRU_POLICY_HYBRID: capacity is an entry count; the weight limit is
+ *                       capacity * (mean sampled access weight)
+ *
+ * USAGE EXAMPLE
+ * -------------
+ *   multilruSimTrace *trace = multilruSimTraceNew(0.01);
+ *   multilruSimTraceLoadTextFile(trace, "access.log");
+ *
+ *   const uint64_t caps[] = {1000, 10000, 100000};
+ *   multilruSimPoint points[3];
+ *   multilruSimConfig config = {.maxLevels = 4,
+ *                               .policy = MLRU_POLICY_COUNT};
+ *   multilruSimRun(trace, &config, caps, 3, points);
+ *
+ *   multilruSimTraceFree(trace);
+ *
+ * A command-line front end is available through the test binary:
+ *   datakit-test lrusim <trace> [--binary|--binary-weighted] [--rate R]
+ *                       [--levels 1,4,7] [--min C] [--max C] [--points N]
+ *
+ * THREAD SAFETY
+ * -------------
+ * A loaded trace is read-only during multilruSimRun() and may be replayed
+ * from multiple threads concurrently.
+ */
+
+typedef struct multilruSimTrace multilruSimTrace;
+
+/* Per-curve simulation parameters */
+typedef struct multilruSimConfig {
+    size_t maxLevels; /* multilru levels (0 = multilru default) */
+    multilruPolicy policy;
+    multilruEvictStrategy evictStrategy;
+} multilruSimConfig;
+
+/* One point on a hit ratio curve */
+typedef struct multilruSimPoint {
+    uint64_t capacity;       /* Requested (unscaled) capacity */
+    uint64_t scaledCapacity; /* Capacity actually simulated (capacity * R) */
+    uint64_t accesses;       /* Sampled accesses replayed */
+    uint64_t hits;           /* Sampled accesses that hit */
+    double hitRatio;         /* hits / accesses (0 if no accesses) */
+} multilruSimPoint;
+
+/* ====================================================================
+ * Trace Loading
+ * ==================================================================== */
+
+/* Create an empty trace sampling keys at 'sampleRate' (0 < rate <= 1).
+ * Out-of-range rates are clamped to 1 (no sampling). */
+multilruSimTrace *multilruSimTraceNew(double sampleRate);
+void multilruSimTraceFree(multilruSimTrace *trace);
+
+/* Feed one access; returns true if the key was sampled. */
+bool multilruSimTraceAccess(multilruSimTrace *trace, uint64_t key,
+                            uint64_t weight);
+bool multilruSimTraceAccessBytes(multilruSimTrace *trace, const void *key,
+                                 size_t len, uint64_t weight);
+
+/* Load a whole trace. Returns false on I/O error or malformed input. */
+bool multilruSimTraceLoadText(multilruSimTrace *trace, FILE *fp);
+bool multilruSimTraceLoadBinary(multilruSimTrace *trace, FILE *fp,
+                                bool weighted);
+bool multilruSimTraceLoadTextFile(multilruSimTrace *trace, const char *path);
+bool multilruSimTraceLoadBinaryFile(multilruSimTrace *trace, const char *path,
+                                    bool weighted);
+
+double multilruSimTraceSampleRate(const multilruSimTrace *trace);
+uint64_t multilruSimTraceTotalAccesses(const multilruSimTrace *trace);
+uint64_t multilruSimTraceSampledAccesses(const multilruSimTrace *trace);
+
+/* ====================================================================
+ * Simulation
+ * ==================================================================== */
+
+/* Replay 'trace' once per entry in capacities[], filling out[i].
+ * Returns false if a multilru could not be created. */
+bool multilruSimRun(const multilruSimTrace *trace,
+                    const multilruSimConfig *config,
+                    const uint64_t capacities[], size_t count,
+                    multilruSimPoint out[]);
+
+/* Run every (levels x policy x strategy x capacity) combination and write
+ * CSV rows to 'out':
+ *   levels,policy,strategy,capacity,scaledCapacity,accesses,hits,hitRatio
+ * Returns false if any simulation failed. */
+bool multilruSimSweep(const multilruSimTrace *trace, const size_t levels[],
+                      size_t levelCount, const uint64_t capacities[],
+                      size_t capacityCount, FILE *out);
+
+/* Fill capacities[] with 'count' geometrically spaced values in
+ * [minCapacity, maxCapacity]; returns number of distinct values written. */
+size_t multilruSimCapacitiesGeometric(uint64_t minCapacity,
+                                      uint64_t maxCapacity, size_t count,
+                                      uint64_t capacities[]);
+
+/* Command-line front end (argv[0] is the trace path) */
+int multilruSimMain(int argc, char *argv[]);
+
+#ifdef DATAKIT_TEST
+int multilruSimTest(int argc, char *argv[]);
+#endif
@@ -127,6 +127,7 @@ typedef enum chunkType {
     CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS,
     CHUNK_TYPE_FULL_BITMAP,
     CHUNK_TYPE_OVER_FULL_DIRECT_NOT_SET_POSITION_NUMBERS,
+    CHUNK_TYPE_RUNS, /* sorted [start, last] ranges; see Run Container below */
     CHUNKY_MONKEY,
     CHUNK_TYPE_MAX_TYPE = 255
 } chunkType;
@@ -440,6 +441,498 @@ DK_STATIC uint16_t deletePackedArrayMember(multiroar *r, const databox *value,
     return currentElementCount;
 }
 
+/* ====================================================================
+ * Run Container Management
+ * ==================================================================== */
+/* Run chunks hold sorted, non-overlapping, non-adjacent [start, last]
+ * ranges of set bits (both ends inclusive).
+ * Layout: [type:1] [runCount:2] [runCount * ([start:2] [last:2])]
+ * All 16-bit fields are little endian.
+ *
+ * A chunk is only stored as runs when the run encoding is strictly
+ * smaller than the positional encoding (sparse list, bitmap, or negative
+ * list) of the same bits, so a run chunk never holds more than
+ * MAX_RUNS_PER_CHUNK runs. */
+#define RUN_HEADER_BYTES 3
+#define RUN_BYTES 4
+#define MAX_RUNS_PER_CHUNK                                                     \
+    ((BITMAP_SIZE_IN_BYTES + 1 - RUN_HEADER_BYTES) / RUN_BYTES)
+
+/* Combining two run lists never yields more runs than both inputs have */
+#define MAX_RUNS_COMBINED (MAX_RUNS_PER_CHUNK * 2)
+
+/* Large enough for any encoded chunk (bitmap is 1 + 1024 bytes; packed
+ * position lists need slack for varintPacked13 partial writes) */
+#define CHUNK_ENCODE_BUFFER_BYTES (BITMAP_SIZE_IN_BYTES + 16)
+
+#define GET_CHUNK_RUNS_START(value)                                            \
+    ((value)->data.bytes.start + RUN_HEADER_BYTES)
+#define RUN_COUNT_FROM_VALUE(value) runLoad16((value)->data.bytes.start + 1)
+
+/* Forward declaration for expandChunkToBitmap */
+DK_STATIC void expandChunkToBitmap(const databox *value, uint8_t *bitmap);
+
+typedef struct chunkRun {
+    uint16_t start;
+    uint16_t last; /* inclusive */
+} chunkRun;
+
+typedef enum chunkRunOp {
+    CHUNK_RUN_OP_AND = 0,
+    CHUNK_RUN_OP_OR,
+    CHUNK_RUN_OP_XOR,
+    CHUNK_RUN_OP_ANDNOT
+} chunkRunOp;
+
+DK_STATIC inline uint16_t runLoad16(const uint8_t *p) {
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+DK_STATIC inline void runStore16(uint8_t *p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+DK_STATIC inline uint16_t runStartAt(const uint8_t *runsStart, uint32_t i) {
+    return runLoad16(runsStart + (i * RUN_BYTES));
+}
+
+DK_STATIC inline uint16_t runLastAt(const uint8_t *runsStart, uint32_t i) {
+    return runLoad16(runsStart + (i * RUN_BYTES) + 2);
+}
+
+DK_STATIC inline uint64_t bitmapWord(const uint8_t *bitmap, uint32_t i) {
+    uint64_t word;
+    memcpy(&word, bitmap + (i * sizeof(word)), sizeof(word));
+    return word;
+}
+
+/* Index of the first run with last >= 'position' ('count' if none).
+ * 'position' is a member iff the returned run also starts <= 'position'. */
+DK_STATIC uint32_t chunkRunsLowerBound(const uint8_t *runsStart,
+                                       uint32_t count, uint16_t position) {
+    uint32_t lo = 0;
+    uint32_t hi = count;
+    while (lo < hi) {
+        const uint32_t mid = lo + ((hi - lo) / 2);
+        if (runLastAt(runsStart, mid) < position) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+DK_STATIC bool chunkRunsContains(const databox *value, uint16_t position) {
+    const uint8_t *runsStart = GET_CHUNK_RUNS_START(value);
+    const uint32_t count = RUN_COUNT_FROM_VALUE(value);
+    const uint32_t idx = chunkRunsLowerBound(runsStart, count, position);
+    return idx < count && runStartAt(runsStart, idx) <= position;
+}
+
+DK_STATIC uint32_t chunkRunsDecode(const databox *value, chunkRun *runs) {
+    const uint8_t *runsStart = GET_CHUNK_RUNS_START(value);
+    const uint32_t count = RUN_COUNT_FROM_VALUE(value);
+    for (uint32_t i = 0; i < count; i++) {
+        runs[i].start = runStartAt(runsStart, i);
+        runs[i].last = runLastAt(runsStart, i);
+    }
+
+    return count;
+}
+
+/* Decode chunks that are natively ranges (ALL_1 and RUNS) into 'runs'.
+ * Returns -1 for chunk types that aren't run-shaped. */
+DK_STATIC int32_t chunkAsRuns(const databox *value, chunkRun *runs) {
+    switch (GET_CHUNK_TYPE(value)) {
+    case CHUNK_TYPE_ALL_1:
+        runs[0].start = 0;
+        runs[0].last = BITMAP_SIZE_IN_BITS - 1;
+        return 1;
+    case CHUNK_TYPE_RUNS:
+        return chunkRunsDecode(value, runs);
+    default:
+        return -1;
+    }
+}
+
+DK_STATIC uint32_t chunkRunsPopulation(const chunkRun *runs, uint32_t count) {
+    uint32_t population = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        population += (uint32_t)runs[i].last - runs[i].start + 1;
+    }
+
+    return population;
+}
+
+DK_STATIC uint32_t chunkRunsValuePopulation(const databox *value) {
+    const uint8_t *runsStart = GET_CHUNK_RUNS_START(value);
+    const uint32_t count = RUN_COUNT_FROM_VALUE(value);
+    uint32_t population = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        population +=
+            (uint32_t)runLastAt(runsStart, i) - runStartAt(runsStart, i) + 1;
+    }
+
+    return population;
+}
+
+/* Set bits [start, end) of 'bitmap' */
+DK_STATIC void bitmapSetRange(uint8_t *bitmap, uint32_t start, uint32_t end) {
+    while (start < end && BIT_OFFSET(start)) {
+        bitmap[BYTE_OFFSET(start)] |= (1 << BIT_OFFSET(start));
+        start++;
+    }
+
+    const uint32_t wholeBytesEnd = end & ~7U;
+    if (start < wholeBytesEnd) {
+        memset(bitmap + BYTE_OFFSET(start), 0xFF,
+               BYTE_OFFSET(wholeBytesEnd - start));
+        start = wholeBytesEnd;
+    }
+
+    while (start < end) {
+        bitmap[BYTE_OFFSET(start)] |= (1 << BIT_OFFSET(start));
+        start++;
+    }
+}
+
+DK_STATIC void chunkRunsToBitmap(const chunkRun *runs, uint32_t count,
+                                 uint8_t *bitmap) {
+    memset(bitmap, 0, BITMAP_SIZE_IN_BYTES);
+    for (uint32_t i = 0; i < count; i++) {
+        bitmapSetRange(bitmap, runs[i].start, (uint32_t)runs[i].last + 1);
+    }
+}
+
+/* Extract runs of set bits from 'bitmap' a word at a time.
+ * Returns the run count, or UINT32_MAX as soon as more than 'maxRuns'
+ * runs exist (so callers can bail out of run encoding cheaply). */
+DK_STATIC uint32_t bitmapToRuns(const uint8_t *bitmap, chunkRun *runs,
+                                uint32_t maxRuns) {
+    const uint32_t words = BITMAP_SIZE_IN_BYTES / sizeof(uint64_t);
+    uint32_t count = 0;
+    uint32_t i = 0;
+    uint64_t current = bitmapWord(bitmap, 0);
+
+    while (true) {
+        while (current == 0 && i + 1 < words) {
+            current = bitmapWord(bitmap, ++i);
+        }
+
+        if (current == 0) {
+            break;
+        }
+
+        if (count == maxRuns) {
+            return UINT32_MAX;
+        }
+
+        const uint32_t start = (i * 64) + __builtin_ctzll(current);
+
+        /* Fill everything below the run start, then find the first
+         * zero at or above it (possibly several words later). */
+        uint64_t filled = current | (current - 1);
+        while (filled == UINT64_MAX && i + 1 < words) {
+            filled = bitmapWord(bitmap, ++i);
+        }
+
+        if (filled == UINT64_MAX) {
+            runs[count].start = start;
+            runs[count].last = BITMAP_SIZE_IN_BITS - 1;
+            count++;
+            break;
+        }
+
+        const uint32_t end = (i * 64) + __builtin_ctzll(~filled);
+        runs[count].start = start;
+        runs[count].last = end - 1;
+        count++;
+
+        /* Clear the run we just consumed */
+        current = filled & (filled + 1);
+    }
+
+    return count;
+}
+
+/* Merge two run lists under 'op' by sweeping over every run boundary.
+ * Adjacent output runs are coalesced so the result is canonical.
+ * 'out' must hold at least (aCount + bCount) runs. */
+DK_STATIC uint32_t chunkRunsCombine(const chunkRun *a, uint32_t aCount,
+                                    const chunkRun *b, uint32_t bCount,
+                                    chunkRunOp op, chunkRun *out) {
+    uint32_t ia = 0;
+    uint32_t ib = 0;
+    uint32_t position = 0;
+    uint32_t count = 0;
+
+    while (true) {
+        /* Drop runs that end before the sweep position */
+        while (ia < aCount && a[ia].last < position) {
+            ia++;
+        }
+
+        while (ib < bCount && b[ib].last < position) {
+            ib++;
+        }
+
+        if (ia == aCount && ib == bCount) {
+            break;
+        }
+
+        const bool inA = ia < aCount && a[ia].start <= position;
+        const bool inB = ib < bCount && b[ib].start <= position;
+
+        const uint32_t nextA =
+            ia < aCount ? (inA ? (uint32_t)a[ia].last + 1 : a[ia].start)
+                        : UINT32_MAX;
+        const uint32_t nextB =
+            ib < bCount ? (inB ? (uint32_t)b[ib].last + 1 : b[ib].start)
+                        : UINT32_MAX;
+        const uint32_t next = nextA < nextB ? nextA : nextB;
+
+        bool in;
+        switch (op) {
+        case CHUNK_RUN_OP_AND:
+            in = inA && inB;
+            break;
+        case CHUNK_RUN_OP_OR:
+            in = inA || inB;
+            break;
+        case CHUNK_RUN_OP_XOR:
+            in = inA != inB;
+            break;
+        case CHUNK_RUN_OP_ANDNOT:
+        default:
+            in = inA && !inB;
+            break;
+        }
+
+        if (in) {
+            if (count > 0 && (uint32_t)out[count - 1].last + 1 == position) {
+                out[count - 1].last = next - 1;
+            } else {
+                out[count].start = position;
+                out[count].last = next - 1;
+                count++;
+            }
+        }
+
+        position = next;
+    }
+
+    return count;
+}
+
+/* Size of the smallest positional (non-run) encoding for 'population'
+ * set bits; mirrors the thresholds used by encodeBitmapChunk(). */
+DK_STATIC uint32_t chunkPositionalBytes(uint32_t population) {
+    if (population < MAX_ENTRIES_PER_DIRECT_LISTING) {
+        return 1 + varintTaggedLen(population) +
+               divCeil(population * DIRECT_STORAGE_BITS, 8);
+    }
+
+    if (population > MAX_BITMAP_ENTIRES_BEFORE_NEGATIVE_LISTING) {
+        const uint32_t unset = BITMAP_SIZE_IN_BITS - population;
+        return 1 + varintTaggedLen(unset) +
+               divCeil(unset * DIRECT_STORAGE_BITS, 8);
+    }
+
+    return 1 + BITMAP_SIZE_IN_BYTES;
+}
+
+/* Largest run count whose encoding beats the positional encoding */
+DK_STATIC uint32_t maxRunsForPopulation(uint32_t population) {
+    const uint32_t positionalBytes = chunkPositionalBytes(population);
+    if (positionalBytes <= RUN_HEADER_BYTES + RUN_BYTES) {
+        return 0;
+    }
+
+    const uint32_t maxRuns =
+        (positionalBytes - RUN_HEADER_BYTES - 1) / RUN_BYTES;
+    return maxRuns < MAX_RUNS_PER_CHUNK ? maxRuns : MAX_RUNS_PER_CHUNK;
+}
+
+DK_STATIC uint32_t writeRunsChunk(const chunkRun *runs, uint32_t count,
+                                  uint8_t *chunk) {
+    chunk[0] = CHUNK_TYPE_RUNS;
+    runStore16(chunk + 1, count);
+
+    uint8_t *runsStart = chunk + RUN_HEADER_BYTES;
+    for (uint32_t i = 0; i < count; i++) {
+        runStore16(runsStart + (i * RUN_BYTES), runs[i].start);
+        runStore16(runsStart + (i * RUN_BYTES) + 2, runs[i].last);
+    }
+
+    return RUN_HEADER_BYTES + (count * RUN_BYTES);
+}
+
+/* Write positions of 'bitmap' as a sparse (set) or negative (unset)
+ * packed position list.
+ * Layout: [type:1] [count:1-2] [positions:N] */
+DK_STATIC uint32_t writePositionListChunk(const uint8_t *bitmap,
+                                          uint8_t *chunk,
+                                          bool trackSetPositions) {
+    memset(chunk, 0, CHUNK_ENCODE_BUFFER_BYTES);
+    chunk[0] = trackSetPositions
+                   ? CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS
+                   : CHUNK_TYPE_OVER_FULL_DIRECT_NOT_SET_POSITION_NUMBERS;
+
+    /* Write positions to a temporary location at offset 1, then move them
+     * to the correct offset based on count's varint length. */
+    const uint16_t count =
+        _bitmapToPositions(bitmap, chunk + 1, trackSetPositions);
+    const uint64_t positionsBytes = divCeil(count * 13, 8);
+
+    const varintWidth countWidth = varintTaggedLen(count);
+    memmove(chunk + 1 + countWidth, chunk + 1, positionsBytes);
+
+    /* Now write the count at offset 1 */
+    varintTaggedPut64(chunk + 1, count);
+
+    return 1 + countWidth + positionsBytes;
+}
+
+/* Encode 'bitmap' into 'chunk' using its smallest representation.
+ * Returns the encoded length; 0 means the chunk is empty and shouldn't
+ * exist. 'chunk' must hold CHUNK_ENCODE_BUFFER_BYTES. */
+DK_STATIC uint32_t encodeBitmapChunk(const uint8_t *bitmap, uint8_t *chunk) {
+    const uint32_t popcount = StrPopCntExact(bitmap, BITMAP_SIZE_IN_BYTES);
+
+    if (popcount == 0) {
+        return 0;
+    }
+
+    if (popcount == BITMAP_SIZE_IN_BITS) {
+        chunk[0] = CHUNK_TYPE_ALL_1;
+        return 1;
+    }
+
+    chunkRun runs[MAX_RUNS_PER_CHUNK];
+    const uint32_t runCount =
+        bitmapToRuns(bitmap, runs, maxRunsForPopulation(popcount));
+    if (runCount != UINT32_MAX) {
+        return writeRunsChunk(runs, runCount, chunk);
+    }
+
+    if (popcount < MAX_ENTRIES_PER_DIRECT_LISTING) {
+        return writePositionListChunk(bitmap, chunk, true);
+    }
+
+    if (popcount > MAX_BITMAP_ENTIRES_BEFORE_NEGATIVE_LISTING) {
+        return writePositionListChunk(bitmap, chunk, false);
+    }
+
+    /* Medium density - keep as bitmap */
+    chunk[0] = CHUNK_TYPE_FULL_BITMAP;
+    memcpy(chunk + 1, bitmap, BITMAP_SIZE_IN_BYTES);
+    return 1 + BITMAP_SIZE_IN_BYTES;
+}
+
+/* Encode canonical 'runs' into 'chunk' using its smallest representation.
+ * Same contract as encodeBitmapChunk(). */
+DK_STATIC uint32_t encodeRunsChunk(const chunkRun *runs, uint32_t count,
+                                   uint8_t *chunk) {
+    if (count == 0) {
+        return 0;
+    }
+
+    const uint32_t population = chunkRunsPopulation(runs, count);
+    if (population == BITMAP_SIZE_IN_BITS) {
+        chunk[0] = CHUNK_TYPE_ALL_1;
+        return 1;
+    }
+
+    if (count <= maxRunsForPopulation(population)) {
+        return writeRunsChunk(runs, count, chunk);
+    }
+
+    uint8_t bitmap[BITMAP_SIZE_IN_BYTES];
+    chunkRunsToBitmap(runs, count, bitmap);
+    return encodeBitmapChunk(bitmap, chunk);
+}
+
+/* Store an encoded chunk at 'key', replacing any existing chunk */
+DK_STATIC void storeEncodedChunk(multiroar *r, const databox *key,
+                                 const uint8_t *chunk, uint32_t len,
+                                 bool chunkExists) {
+    /* Delete existing chunk first if it exists (simpler than replace) */
+    if (chunkExists) {
+        multimapDelete(&r->map, key);
+    }
+
+    if (len == 0) {
+        /* All zeros - no chunk needed */
+        return;
+    }
+
+    const databox box = {.data.bytes.start = (uint8_t *)chunk,
+                         .len = len,
+                         .type = DATABOX_BYTES};
+    const databox *inserting[] = {key, &box};
+    multimapInsert(&r->map, inserting);
+}
+
+/* Overwrite the chunk at 'me' in place (or delete it if 'len' is 0) */
+DK_STATIC void replaceEncodedChunk(multiroar *r, const databox *key,
+                                   multimapEntry *me, const uint8_t *chunk,
+                                   uint32_t len) {
+    if (len == 0) {
+        multimapDelete(&r->map, key);
+        return;
+    }
+
+    const databox box = {.data.bytes.start = (uint8_t *)chunk,
+                         .len = len,
+                         .type = DATABOX_BYTES};
+    multimapReplaceEntry(&r->map, me, &box);
+}
+
+/* Helper: Compress bitmap back to optimal representation */
+DK_STATIC void compressBitmapToChunk(multiroar *r, const databox *key,
+                                     uint8_t *bitmap, bool chunkExists) {
+    uint8_t chunk[CHUNK_ENCODE_BUFFER_BYTES];
+    const uint32_t len = encodeBitmapChunk(bitmap, chunk);
+
+    /* Existing chunks are rewritten in place; delete+insert would shift
+     * the rest of the map twice. */
+    multimapEntry entry;
+    if (chunkExists && multimapGetUnderlyingEntry(r->map, key, &entry)) {
+        databox current;
+        flexGetNextByType(*entry.map, &entry.fe, &current);
+        replaceEncodedChunk(r, key, &entry, chunk, len);
+        return;
+    }
+
+    storeEncodedChunk(r, key, chunk, len, chunkExists);
+}
+
+DK_STATIC void storeRunsToChunk(multiroar *r, const databox *key,
+                                const chunkRun *runs, uint32_t count,
+                                bool chunkExists) {
+    uint8_t chunk[CHUNK_ENCODE_BUFFER_BYTES];
+    const uint32_t len = encodeRunsChunk(runs, count, chunk);
+    storeEncodedChunk(r, key, chunk, len, chunkExists);
+}
+
+/* Apply a single-range update to an existing RUNS chunk in place */
+DK_STATIC void updateRunsChunk(multiroar *r, const databox *key,
+                               multimapEntry *me, const databox *value,
+                               chunkRun range, chunkRunOp op) {
+    chunkRun runs[MAX_RUNS_PER_CHUNK];
+    chunkRun combined[MAX_RUNS_PER_CHUNK + 1];
+    const uint32_t count = chunkRunsDecode(value, runs);
+    const uint32_t combinedCount =
+        chunkRunsCombine(runs, count, &range, 1, op, combined);
+
+    uint8_t chunk[CHUNK_ENCODE_BUFFER_BYTES];
+    const uint32_t len = encodeRunsChunk(combined, combinedCount, chunk);
+    replaceEncodedChunk(r, key, me, chunk, len);
+}
+
 bool multiroarBitSet(multiroar *r, uint64_t position) {
     bool previouslySet = false;
     /* Steps:
@@ -549,6 +1042,19 @@ bool multiroarBitSet(multiroar *r, uint64_t position) {
 
             break;
         }
+        case CHUNK_TYPE_RUNS: {
+            const uint16_t offset = DIRECT_BIT_POSITION(position);
+            if (chunkRunsContains(&value, offset)) {
+                previouslySet = true;
+                break;
+            }
+
+            /* Extends or joins neighboring runs; re-encodes as a sparse
+             * list or bitmap if runs are no longer the smallest form. */
+            const chunkRun bit = {.start = offset, .last = offset};
+            updateRunsChunk(r, &key, &me, &value, bit, CHUNK_RUN_OP_OR);
+            break;
+        }
         default:
             assert(NULL && "Invalid type byte in bitmap!");
         }
@@ -626,6 +1132,8 @@ bool multiroarBitGet(const multiroar *r, uint64_t position) {
             }
             break;
         }
+        case CHUNK_TYPE_RUNS:
+            return chunkRunsContains(&value, DIRECT_BIT_POSITION(position));
         default:
             D("Type byte is: %d (WHY?)\n", GET_CHUNK_TYPE(&value));
             assert(NULL && "Invalid type byte in bitmap!");
@@ -744,6 +1252,17 @@ bool multiroarRemove(multiroar *r, uint64_t position) {
 
         return true;
     }
+    case CHUNK_TYPE_RUNS: {
+        const uint16_t offset = DIRECT_BIT_POSITION(position);
+        if (!chunkRunsContains(&value, offset)) {
+            return false;
+        }
+
+        /* Shrinks or splits the run holding 'offset' */
+        const chunkRun bit = {.start = offset, .last = offset};
+        updateRunsChunk(r, &key, &me, &value, bit, CHUNK_RUN_OP_ANDNOT);
+        return true;
+    }
     default:
         assert(NULL && "Invalid type byte in bitmap!");
         return false;
@@ -766,12 +1285,64 @@ multiroar *multiroarDuplicate(const multiroar *r) {
 /* ====================================================================
  * Range Operations
  * ==================================================================== */
+/* Set bits [first, last] (inclusive) of a single chunk */
+DK_STATIC void bitSetChunkRange(multiroar *r, uint64_t chunkId, uint16_t first,
+                                uint16_t last) {
+    const databox key = {.data.u = chunkId, .type = DATABOX_UNSIGNED_64};
+    const chunkRun range = {.start = first, .last = last};
+    uint8_t chunk[CHUNK_ENCODE_BUFFER_BYTES];
+
+    multimapEntry me;
+    if (!multimapGetUnderlyingEntry(r->map, &key, &me)) {
+        storeEncodedChunk(r, &key, chunk, encodeRunsChunk(&range, 1, chunk),
+                          false);
+        return;
+    }
+
+    databox value = {{0}};
+    flexGetNextByType(*me.map, &me.fe, &value);
+
+    switch (GET_CHUNK_TYPE(&value)) {
+    case CHUNK_TYPE_ALL_1:
+        /* Already fully set */
+        return;
+    case CHUNK_TYPE_RUNS:
+        updateRunsChunk(r, &key, &me, &value, range, CHUNK_RUN_OP_OR);
+        return;
+    default: {
+        uint8_t bitmap[BITMAP_SIZE_IN_BYTES];
+        expandChunkToBitmap(&value, bitmap);
+        bitmapSetRange(bitmap, first, (uint32_t)last + 1);
+        replaceEncodedChunk(r, &key, &me, chunk,
+                            encodeBitmapChunk(bitmap, chunk));
+        return;
+    }
+    }
+}
+
 void multiroarBitSetRange(multiroar *r, uint64_t start, uint64_t extent) {
     /* Set a range of bits from 'start' to 'start + extent - 1' */
-    for (uint64_t i = 0; i < extent; i++) {
-        multiroarBitSet(r, start + i);
+    if (!r || extent == 0) {
+        return;
+    }
+
+    uint64_t last = start + extent - 1;
+
+    /* Guard against overflow */
+    if (last < start) {
+        last = UINT64_MAX;
+    }
+
+    /* Whole chunks inside the range become ALL_1; partial chunks at either
+     * end get a single run merged in. */
+    const uint64_t firstChunk = CHUNK(start);
+    const uint64_t lastChunk = CHUNK(last);
+    for (uint64_t chunkId = firstChunk; chunkId <= lastChunk; chunkId++) {
+        const uint16_t first = chunkId == firstChunk ? OFFSET(start) : 0;
+        const uint16_t end =
+            chunkId == lastChunk ? OFFSET(last) : BITMAP_SIZE_IN_BITS - 1;
+        bitSetChunkRange(r, chunkId, first, end);
     }
-    /* TODO: Optimize by setting full chunks at once */
 }
 
 /* ====================================================================
@@ -827,6 +1398,11 @@ uint64_t multiroarBitCount(const multiroar *r) {
             break;
         }
 
+        case CHUNK_TYPE_RUNS:
+            /* Runs - sum of run lengths */
+            totalCount += chunkRunsValuePopulation(value);
+            break;
+
         default:
             /* Unknown chunk type - skip */
             break;
@@ -840,9 +1416,6 @@ uint64_t multiroarBitCount(const multiroar *r) {
  * Min/Max/Extrema Operations
  * ==================================================================== */
 
-/* Forward declaration for expandChunkToBitmap */
-DK_STATIC void expandChunkToBitmap(const databox *value, uint8_t *bitmap);
-
 /* Helper: Find first set bit in chunk bitmap */
 DK_STATIC uint64_t findFirstSetBitInBitmap(const uint8_t *bitmap,
                                            uint64_t bytes) {
@@ -948,6 +1521,11 @@ bool multiroarMin(const multiroar *r, uint64_t *position) {
         return false;
     }
 
+    case CHUNK_TYPE_RUNS:
+        /* Start of first run */
+        *position = chunkBase + runStartAt(GET_CHUNK_RUNS_START(value), 0);
+        return true;
+
     default:
         return false;
     }
@@ -1030,6 +1608,12 @@ bool multiroarMax(const multiroar *r, uint64_t *position) {
         return false;
     }
 
+    case CHUNK_TYPE_RUNS:
+        /* End of last run */
+        *position = chunkBase + runLastAt(GET_CHUNK_RUNS_START(value),
+                                          RUN_COUNT_FROM_VALUE(value) - 1);
+        return true;
+
     default:
         return false;
     }
@@ -1195,6 +1779,8 @@ DK_STATIC uint64_t countBitsInChunk(const databox *value) {
     }
     case CHUNK_TYPE_OVER_FULL_DIRECT_NOT_SET_POSITION_NUMBERS:
         return BITMAP_SIZE_IN_BITS - PACKED_COUNT_FROM_VALUE(value);
+    case CHUNK_TYPE_RUNS:
+        return chunkRunsValuePopulation(value);
     default:
         return 0;
     }
@@ -1221,80 +1807,108 @@ DK_STATIC uint64_t countBitsInBitmapRange(const uint8_t *bitmap,
     return count;
 }
 
-/* Rank: Count set bits in range [0, position) */
-uint64_t multiroarRank(const multiroar *r, uint64_t position) {
-    if (!r || !r->map) {
+/* Helper: Count set bits in [0, offsetInChunk) within a single chunk */
+DK_STATIC uint64_t rankInChunk(const databox *value, uint64_t offsetInChunk) {
+    uint64_t rank = 0;
+
+    if (offsetInChunk == 0) {
         return 0;
     }
 
-    uint64_t targetChunkId = position / BITMAP_SIZE_IN_BITS;
-    uint64_t offsetInChunk = position % BITMAP_SIZE_IN_BITS;
-    uint64_t totalCount = 0;
-
-    /* Iterate through chunks before target chunk */
-    multimapIterator iter;
-    multimapIteratorInit(r->map, &iter, true);
-
-    databox keyValue[2];
-    databox *kvPtr[2] = {&keyValue[0], &keyValue[1]};
-
-    while (multimapIteratorNext(&iter, kvPtr)) {
-        const databox *key = &keyValue[0];
-        const databox *value = &keyValue[1];
-        uint64_t chunkId = key->data.u;
-
-        if (chunkId < targetChunkId) {
-            /* Count all bits in chunks before target */
-            totalCount += countBitsInChunk(value);
-        } else if (chunkId == targetChunkId) {
-            /* Count bits in range [0, offsetInChunk) within target chunk */
-            if (offsetInChunk == 0) {
-                return totalCount;
-            }
-
-            switch (GET_CHUNK_TYPE(value)) {
-            case CHUNK_TYPE_ALL_0:
-                break;
-            case CHUNK_TYPE_ALL_1:
-                totalCount += offsetInChunk;
-                break;
-            case CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS: {
-                const uint8_t *data = GET_CHUNK_PACKED_START(value);
-                uint16_t count = PACKED_COUNT_FROM_VALUE(value);
-                for (uint16_t i = 0; i < count; i++) {
-                    uint64_t pos = varintPacked13Get(data, i);
-                    if (pos < offsetInChunk) {
-                        totalCount++;
-                    } else {
-                        break; /* Sorted, so we're done */
-                    }
-                }
-                break;
+    switch (GET_CHUNK_TYPE(value)) {
+    case CHUNK_TYPE_ALL_0:
+        break;
+    case CHUNK_TYPE_ALL_1:
+        rank += offsetInChunk;
+        break;
+    case CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS: {
+        const uint8_t *data = GET_CHUNK_PACKED_START(value);
+        uint16_t count = PACKED_COUNT_FROM_VALUE(value);
+        for (uint16_t i = 0; i < count; i++) {
+            uint64_t pos = varintPacked13Get(data, i);
+            if (pos < offsetInChunk) {
+                rank++;
+            } else {
+                break; /* Sorted, so we're done */
             }
-            case CHUNK_TYPE_FULL_BITMAP: {
-                const uint8_t *bitmap = GET_CHUNK_BITMAP_START(value);
-                totalCount += countBitsInBitmapRange(bitmap, offsetInChunk);
+        }
+        break;
+    }
+    case CHUNK_TYPE_FULL_BITMAP: {
+        const uint8_t *bitmap = GET_CHUNK_BITMAP_START(value);
+        rank += countBitsInBitmapRange(bitmap, offsetInChunk);
+        break;
+    }
+    case CHUNK_TYPE_OVER_FULL_DIRECT_NOT_SET_POSITION_NUMBERS: {
+        /* Start with all bits set up to offsetInChunk */
+        uint64_t bitsSet = offsetInChunk;
+        /* Subtract unset positions before offsetInChunk */
+        const uint8_t *data = GET_CHUNK_PACKED_START(value);
+        uint16_t count = PACKED_COUNT_FROM_VALUE(value);
+        for (uint16_t i = 0; i < count; i++) {
+            uint64_t pos = varintPacked13Get(data, i);
+            if (pos < offsetInChunk) {
+                bitsSet--;
+            } else {
                 break;
             }
-            case CHUNK_TYPE_OVER_FULL_DIRECT_NOT_SET_POSITION_NUMBERS: {
-                /* Start with all bits set up to offsetInChunk */
-                uint64_t bitsSet = offsetInChunk;
-                /* Subtract unset positions before offsetInChunk */
-                const uint8_t *data = GET_CHUNK_PACKED_START(value);
-                uint16_t count = PACKED_COUNT_FROM_VALUE(value);
-                for (uint16_t i = 0; i < count; i++) {
-                    uint64_t pos = varintPacked13Get(data, i);
-                    if (pos < offsetInChunk) {
-                        bitsSet--;
-                    } else {
-                        break;
-                    }
-                }
-                totalCount += bitsSet;
+        }
+        rank += bitsSet;
+        break;
+    }
+    case CHUNK_TYPE_RUNS: {
+        /* Whole runs before offsetInChunk, plus a partial run */
+        const uint8_t *runsStart = GET_CHUNK_RUNS_START(value);
+        const uint16_t count = RUN_COUNT_FROM_VALUE(value);
+        for (uint16_t i = 0; i < count; i++) {
+            const uint64_t start = runStartAt(runsStart, i);
+            const uint64_t last = runLastAt(runsStart, i);
+            if (start >= offsetInChunk) {
                 break;
             }
+
+            if (last < offsetInChunk) {
+                rank += last - start + 1;
+            } else {
+                rank += offsetInChunk - start;
+                break;
             }
-            return totalCount;
+        }
+        break;
+    }
+    }
+
+    return rank;
+}
+
+/* Rank: Count set bits in range [0, position) */
+uint64_t multiroarRank(const multiroar *r, uint64_t position) {
+    if (!r || !r->map) {
+        return 0;
+    }
+
+    uint64_t targetChunkId = position / BITMAP_SIZE_IN_BITS;
+    uint64_t offsetInChunk = position % BITMAP_SIZE_IN_BITS;
+    uint64_t totalCount = 0;
+
+    /* Iterate through chunks before target chunk */
+    multimapIterator iter;
+    multimapIteratorInit(r->map, &iter, true);
+
+    databox keyValue[2];
+    databox *kvPtr[2] = {&keyValue[0], &keyValue[1]};
+
+    while (multimapIteratorNext(&iter, kvPtr)) {
+        const databox *key = &keyValue[0];
+        const databox *value = &keyValue[1];
+        uint64_t chunkId = key->data.u;
+
+        if (chunkId < targetChunkId) {
+            /* Count all bits in chunks before target */
+            totalCount += countBitsInChunk(value);
+        } else if (chunkId == targetChunkId) {
+            /* Count bits in range [0, offsetInChunk) within target chunk */
+            return totalCount + rankInChunk(value, offsetInChunk);
         } else {
             /* Beyond target chunk */
             break;
@@ -1397,6 +2011,24 @@ bool multiroarSelect(const multiroar *r, uint64_t k, uint64_t *position) {
                 }
                 return false; /* Shouldn't reach here */
             }
+
+            case CHUNK_TYPE_RUNS: {
+                const uint8_t *runsStart = GET_CHUNK_RUNS_START(value);
+                const uint16_t count = RUN_COUNT_FROM_VALUE(value);
+                uint64_t remaining = targetInChunk;
+
+                for (uint16_t i = 0; i < count; i++) {
+                    const uint64_t start = runStartAt(runsStart, i);
+                    const uint64_t length = runLastAt(runsStart, i) - start + 1;
+                    if (remaining <= length) {
+                        *position = chunkBase + start + (remaining - 1);
+                        return true;
+                    }
+
+                    remaining -= length;
+                }
+                return false; /* Shouldn't reach here */
+            }
             }
         }
 
@@ -1437,10 +2069,8 @@ void multiroarBitClearRange(multiroar *r, uint64_t start, uint64_t extent) {
         return;
     }
 
-    /* Set all bits in range */
-    for (uint64_t pos = start; pos < end; pos++) {
-        multiroarBitSet(rangeRoar, pos);
-    }
+    /* Range is built as runs/ALL_1 chunks, not bit by bit */
+    multiroarBitSetRange(rangeRoar, start, end - start);
 
     /* r = r AND NOT rangeRoar */
     multiroarAndNot(r, rangeRoar);
@@ -1466,10 +2096,8 @@ void multiroarBitFlipRange(multiroar *r, uint64_t start, uint64_t extent) {
         return;
     }
 
-    /* Set all bits in range */
-    for (uint64_t pos = start; pos < end; pos++) {
-        multiroarBitSet(rangeRoar, pos);
-    }
+    /* Range is built as runs/ALL_1 chunks, not bit by bit */
+    multiroarBitSetRange(rangeRoar, start, end - start);
 
     /* r = r XOR rangeRoar (flips all bits in range) */
     multiroarXor(r, rangeRoar);
@@ -1498,39 +2126,47 @@ multiroar *multiroarNewAndNot(const multiroar *a, const multiroar *b) {
     databox keyValue[2];
     databox *kvPtr[2] = {&keyValue[0], &keyValue[1]};
 
+    chunkRun runsA[MAX_RUNS_PER_CHUNK];
+    chunkRun runsB[MAX_RUNS_PER_CHUNK];
+    chunkRun runsResult[MAX_RUNS_COMBINED];
+
     while (multimapIteratorNext(&iter, kvPtr)) {
-        const databox *key = &keyValue[0];
         const databox *aValue = &keyValue[1];
-        uint64_t chunkId = key->data.u;
+        const databox key = {.data.u = keyValue[0].data.u,
+                             .type = DATABOX_UNSIGNED_64};
 
         /* Check if b has this chunk */
-        databox bKey = {.data.u = chunkId, .type = DATABOX_UNSIGNED_64};
         databox bValue;
         databox *bValues[] = {&bValue};
 
-        /* Expand a's chunk to bitmap */
+        if (!multimapLookup(b->map, &key, bValues)) {
+            /* b doesn't have this chunk, so keep a's chunk as-is */
+            const databox *inserting[] = {&key, aValue};
+            multimapInsert(&result->map, inserting);
+            continue;
+        }
+
+        /* Both have this chunk - perform AND NOT */
+        const int32_t countA = chunkAsRuns(aValue, runsA);
+        const int32_t countB = chunkAsRuns(&bValue, runsB);
+        if (countA >= 0 && countB >= 0) {
+            const uint32_t count = chunkRunsCombine(
+                runsA, countA, runsB, countB, CHUNK_RUN_OP_ANDNOT, runsResult);
+            storeRunsToChunk(result, &key, runsResult, count, false);
+            continue;
+        }
+
         uint8_t bitmapA[BITMAP_SIZE_IN_BYTES];
+        uint8_t bitmapB[BITMAP_SIZE_IN_BYTES];
         expandChunkToBitmap(aValue, bitmapA);
+        expandChunkToBitmap(&bValue, bitmapB);
 
-        if (multimapLookup(b->map, &bKey, bValues)) {
-            /* Both have this chunk - perform AND NOT */
-            uint8_t bitmapB[BITMAP_SIZE_IN_BYTES];
-            expandChunkToBitmap(&bValue, bitmapB);
-
-            /* A & ~B */
-            for (uint64_t i = 0; i < BITMAP_SIZE_IN_BYTES; i++) {
-                bitmapA[i] &= ~bitmapB[i];
-            }
+        /* A & ~B */
+        for (uint64_t i = 0; i < BITMAP_SIZE_IN_BYTES; i++) {
+            bitmapA[i] &= ~bitmapB[i];
         }
-        /* else: b doesn't have this chunk, so keep all bits from a */
 
-        /* Set the resulting bits in result */
-        uint64_t chunkBase = chunkId * BITMAP_SIZE_IN_BITS;
-        for (uint64_t i = 0; i < BITMAP_SIZE_IN_BITS; i++) {
-            if (bitmapA[i / 8] & (1 << (i % 8))) {
-                multiroarBitSet(result, chunkBase + i);
-            }
-        }
+        compressBitmapToChunk(result, &key, bitmapA, false);
     }
 
     return result;
@@ -1569,6 +2205,8 @@ void multiroarIteratorInit(const multiroar *r, multiroarIterator *iter) {
 
     memset(iter, 0, sizeof(*iter));
     iter->roar = r;
+    iter->frozen = NULL;
+    iter->frozenChunk = 0;
     iter->valid = false;
 
     if (!r || !r->map) {
@@ -1582,8 +2220,12 @@ void multiroarIteratorInit(const multiroar *r, multiroarIterator *iter) {
     iter->positionInChunk = 0;
     iter->indexInChunk = 0;
     iter->countInChunk = 0;
+    iter->runInChunk = 0;
 }
 
+DK_STATIC void frozenChunkAt(const multiroarFrozen *f, uint64_t index,
+                             databox *key, databox *value);
+
 /* Get next set bit position */
 bool multiroarIteratorNext(multiroarIterator *iter, uint64_t *position) {
     if (!iter || !iter->valid || !position) {
@@ -1667,6 +2309,29 @@ bool multiroarIteratorNext(multiroarIterator *iter, uint64_t *position) {
                 break;
             }
 
+            case CHUNK_TYPE_RUNS: {
+                /* positionInChunk walks the current run; runInChunk
+                 * advances once its last position is emitted. */
+                const uint8_t *runsStart =
+                    GET_CHUNK_RUNS_START(&iter->currentChunk);
+                const uint16_t start =
+                    runStartAt(runsStart, iter->runInChunk);
+                const uint16_t last = runLastAt(runsStart, iter->runInChunk);
+
+                if (iter->positionInChunk < start) {
+                    iter->positionInChunk = start;
+                }
+
+                *position = chunkBase + iter->positionInChunk;
+                if (iter->positionInChunk == last) {
+                    iter->runInChunk++;
+                }
+
+                iter->positionInChunk++;
+                iter->indexInChunk++;
+                return true;
+            }
+
             default:
                 break;
             }
@@ -1676,7 +2341,15 @@ bool multiroarIteratorNext(multiroarIterator *iter, uint64_t *position) {
         databox keyValue[2];
         databox *kvPtr[2] = {&keyValue[0], &keyValue[1]};
 
-        if (!multimapIteratorNext(&iter->mapIter, kvPtr)) {
+        if (iter->frozen) {
+            if (iter->frozenChunk >= iter->frozen->chunkCount) {
+                iter->valid = false;
+                return false;
+            }
+
+            frozenChunkAt(iter->frozen, iter->frozenChunk++, &keyValue[0],
+                          &keyValue[1]);
+        } else if (!multimapIteratorNext(&iter->mapIter, kvPtr)) {
             /* No more chunks */
             iter->valid = false;
             return false;
@@ -1689,6 +2362,7 @@ bool multiroarIteratorNext(multiroarIterator *iter, uint64_t *position) {
         iter->currentChunk = *value;
         iter->positionInChunk = 0;
         iter->indexInChunk = 0;
+        iter->runInChunk = 0;
 
         /* Set count based on chunk type */
         switch (GET_CHUNK_TYPE(value)) {
@@ -1709,6 +2383,9 @@ bool multiroarIteratorNext(multiroarIterator *iter, uint64_t *position) {
             iter->countInChunk = BITMAP_SIZE_IN_BITS - unsetCount;
             break;
         }
+        case CHUNK_TYPE_RUNS:
+            iter->countInChunk = chunkRunsValuePopulation(value);
+            break;
         default:
             iter->countInChunk = 0;
             break;
@@ -1718,6 +2395,11 @@ bool multiroarIteratorNext(multiroarIterator *iter, uint64_t *position) {
 
 /* Reset iterator to beginning */
 void multiroarIteratorReset(multiroarIterator *iter) {
+    if (iter && iter->frozen) {
+        multiroarFrozenIteratorInit(iter->frozen, iter);
+        return;
+    }
+
     if (!iter || !iter->roar) {
         return;
     }
@@ -1906,6 +2588,62 @@ uint64_t multiroarMemoryUsage(const multiroar *r) {
     return totalBytes;
 }
 
+/* Re-encode chunks as runs wherever runs are smaller.
+ * Bits set one at a time never become runs on their own (only range sets
+ * and set operations pick runs), so call this after bulk loading
+ * clustered data. Returns the number of chunks converted. */
+uint64_t multiroarRunOptimize(multiroar *r) {
+    if (!r || !r->map) {
+        return 0;
+    }
+
+    uint64_t numChunks = multimapCount(r->map);
+    if (numChunks == 0) {
+        return 0;
+    }
+
+    /* Collect chunk keys first to avoid iterator invalidation */
+    uint64_t *chunkKeys = zmalloc(numChunks * sizeof(uint64_t));
+    uint64_t keyCount = 0;
+
+    multimapIterator iter;
+    multimapIteratorInit(r->map, &iter, true);
+
+    databox keyStorage[2];
+    databox *keyPtr[2] = {&keyStorage[0], &keyStorage[1]};
+    while (multimapIteratorNext(&iter, keyPtr)) {
+        const uint8_t type = GET_CHUNK_TYPE(&keyStorage[1]);
+        if (type != CHUNK_TYPE_ALL_1 && type != CHUNK_TYPE_RUNS) {
+            chunkKeys[keyCount++] = keyStorage[0].data.u;
+        }
+    }
+
+    uint64_t converted = 0;
+    uint8_t bitmap[BITMAP_SIZE_IN_BYTES];
+    uint8_t chunk[CHUNK_ENCODE_BUFFER_BYTES];
+    for (uint64_t i = 0; i < keyCount; i++) {
+        const databox key = {.data.u = chunkKeys[i],
+                             .type = DATABOX_UNSIGNED_64};
+        multimapEntry me;
+        if (!multimapGetUnderlyingEntry(r->map, &key, &me)) {
+            continue;
+        }
+
+        databox value = {{0}};
+        flexGetNextByType(*me.map, &me.fe, &value);
+        expandChunkToBitmap(&value, bitmap);
+
+        const uint32_t len = encodeBitmapChunk(bitmap, chunk);
+        if (chunk[0] == CHUNK_TYPE_RUNS && len < value.len) {
+            replaceEncodedChunk(r, &key, &me, chunk, len);
+            converted++;
+        }
+    }
+
+    zfree(chunkKeys);
+    return converted;
+}
+
 /* ====================================================================
  * Serialization
  * ==================================================================== */
@@ -1913,7 +2651,10 @@ uint64_t multiroarMemoryUsage(const multiroar *r) {
 /*
  * Wire format:
  * - Magic: 4 bytes "ROAR"
- * - Version: 1 byte (current: 1)
+ * - Version: 1 byte (current: 2)
+ *   - 1: no RUNS chunks
+ *   - 2: adds RUNS chunks. Version 1 buffers still deserialize; readers
+ *        that only know version 1 reject version 2 buffers.
  * - Flags: 1 byte (reserved, must be 0)
  * - Chunk count: varint
  * - For each chunk:
@@ -1925,13 +2666,17 @@ uint64_t multiroarMemoryUsage(const multiroar *r) {
  *     - UNDER_FULL: varint count, then varintPacked data
  *     - FULL_BITMAP: 1024 bytes (8192 bits)
  *     - OVER_FULL: varint count, then varintPacked data
+ *     - RUNS: varint run count, then per run: varint start, varint
+ *             (last - start)
  */
 
 #define MULTIROAR_MAGIC_0 'R'
 #define MULTIROAR_MAGIC_1 'O'
 #define MULTIROAR_MAGIC_2 'A'
 #define MULTIROAR_MAGIC_3 'R'
-#define MULTIROAR_VERSION 1
+#define MULTIROAR_VERSION 2
+#define MULTIROAR_VERSION_MIN 1
+#define MULTIROAR_VERSION_RUNS 2 /* first version with CHUNK_TYPE_RUNS */
 
 /* Helper: write varint to buffer, return bytes written */
 DK_STATIC uint64_t writeVarint(uint8_t *buf, uint64_t value) {
@@ -1968,6 +2713,22 @@ DK_STATIC uint64_t readVarint(const uint8_t *buf, uint64_t bufSize,
     return 0; /* Incomplete varint */
 }
 
+/* Helper: serialized bytes for the data of a RUNS chunk */
+DK_STATIC uint64_t runsSerializedSize(const databox *value) {
+    const uint8_t *runsStart = GET_CHUNK_RUNS_START(value);
+    const uint16_t count = RUN_COUNT_FROM_VALUE(value);
+    uint8_t temp[10];
+
+    uint64_t size = writeVarint(temp, count);
+    for (uint16_t i = 0; i < count; i++) {
+        const uint16_t start = runStartAt(runsStart, i);
+        size += writeVarint(temp, start);
+        size += writeVarint(temp, runLastAt(runsStart, i) - start);
+    }
+
+    return size;
+}
+
 /* Calculate serialized size without actually serializing */
 uint64_t multiroarSerializedSize(const multiroar *r) {
     if (!r || !r->map) {
@@ -2032,6 +2793,10 @@ uint64_t multiroarSerializedSize(const multiroar *r) {
             /* 1024 bytes */
             size += 1024;
             break;
+
+        case CHUNK_TYPE_RUNS:
+            size += runsSerializedSize(value);
+            break;
         }
     }
 
@@ -2155,6 +2920,23 @@ uint64_t multiroarSerialize(const multiroar *r, void *buf, uint64_t bufSize) {
             break;
         }
 
+        case CHUNK_TYPE_RUNS: {
+            const uint8_t *runsStart = GET_CHUNK_RUNS_START(value);
+            const uint16_t count = RUN_COUNT_FROM_VALUE(value);
+
+            if (p + runsSerializedSize(value) > end) {
+                return 0;
+            }
+
+            p += writeVarint(p, count);
+            for (uint16_t i = 0; i < count; i++) {
+                const uint16_t start = runStartAt(runsStart, i);
+                p += writeVarint(p, start);
+                p += writeVarint(p, runLastAt(runsStart, i) - start);
+            }
+            break;
+        }
+
         default:
             /* Unknown chunk type */
             return 0;
@@ -2182,7 +2964,7 @@ multiroar *multiroarDeserialize(const void *buf, uint64_t bufSize) {
 
     /* Check version */
     uint8_t version = *p++;
-    if (version != MULTIROAR_VERSION) {
+    if (version < MULTIROAR_VERSION_MIN || version > MULTIROAR_VERSION) {
         return NULL;
     }
 
@@ -2343,6 +3125,57 @@ multiroar *multiroarDeserialize(const void *buf, uint64_t bufSize) {
             break;
         }
 
+        case CHUNK_TYPE_RUNS: {
+            uint64_t count;
+            if (version < MULTIROAR_VERSION_RUNS) {
+                multiroarFree(r);
+                return NULL;
+            }
+
+            bytesRead = readVarint(p, (uint64_t)(end - p), &count);
+            if (bytesRead == 0 || count == 0 || count > MAX_RUNS_PER_CHUNK) {
+                multiroarFree(r);
+                return NULL;
+            }
+            p += bytesRead;
+
+            /* Runs must be sorted, non-overlapping, and non-adjacent */
+            chunkRun runs[MAX_RUNS_PER_CHUNK];
+            uint64_t nextAllowed = 0;
+            for (uint64_t j = 0; j < count; j++) {
+                uint64_t start;
+                uint64_t length;
+                bytesRead = readVarint(p, (uint64_t)(end - p), &start);
+                if (bytesRead == 0) {
+                    multiroarFree(r);
+                    return NULL;
+                }
+                p += bytesRead;
+
+                /* Bound each value before adding so crafted 64-bit varints
+                 * can't wrap past the chunk size check. */
+                bytesRead = readVarint(p, (uint64_t)(end - p), &length);
+                if (bytesRead == 0 || start < nextAllowed ||
+                    start >= BITMAP_SIZE_IN_BITS ||
+                    length >= BITMAP_SIZE_IN_BITS - start) {
+                    multiroarFree(r);
+                    return NULL;
+                }
+                p += bytesRead;
+
+                runs[j].start = start;
+                runs[j].last = start + length;
+                nextAllowed = start + length + 2;
+            }
+
+            databox key = {{0}};
+            key.data.u = chunkId;
+            key.type = DATABOX_UNSIGNED_64;
+
+            storeRunsToChunk(r, &key, runs, count, false);
+            break;
+        }
+
         default:
             /* Unknown chunk type */
             multiroarFree(r);
@@ -2549,98 +3382,105 @@ DK_STATIC void expandChunkToBitmap(const databox *value, uint8_t *bitmap) {
         }
         break;
     }
+    case CHUNK_TYPE_RUNS: {
+        memset(bitmap, 0, BITMAP_SIZE_IN_BYTES);
+        const uint8_t *runsStart = GET_CHUNK_RUNS_START(value);
+        const uint16_t count = RUN_COUNT_FROM_VALUE(value);
+        for (uint16_t i = 0; i < count; i++) {
+            bitmapSetRange(bitmap, runStartAt(runsStart, i),
+                           (uint32_t)runLastAt(runsStart, i) + 1);
+        }
+        break;
+    }
     default:
         memset(bitmap, 0, BITMAP_SIZE_IN_BYTES);
         break;
     }
 }
 
-/* Helper: Compress bitmap back to optimal representation */
-DK_STATIC void compressBitmapToChunk(multiroar *r, const databox *key,
-                                     uint8_t *bitmap, multimapEntry *me,
-                                     bool chunkExists) {
-    (void)me; /* No longer used - we use delete+insert pattern */
-    uint32_t popcount = StrPopCntExact(bitmap, BITMAP_SIZE_IN_BYTES);
-
-    /* Delete existing chunk first if it exists (simpler than replace) */
-    if (chunkExists) {
-        multimapDelete(&r->map, key);
+/* Helper: r[key] |= bValue, where bValue may live outside of r's map */
+DK_STATIC void orChunkInto(multiroar *r, const databox *key,
+                           const databox *bValue) {
+    uint8_t bitmapR[BITMAP_SIZE_IN_BYTES];
+    uint8_t bitmapB[BITMAP_SIZE_IN_BYTES];
+    chunkRun runsR[MAX_RUNS_PER_CHUNK];
+    chunkRun runsB[MAX_RUNS_PER_CHUNK];
+    chunkRun runsResult[MAX_RUNS_COMBINED];
+
+    /* Look up corresponding chunk in r */
+    databox rValue;
+    databox *rValues[] = {&rValue};
+    bool rHasChunk = multimapLookup(r->map, key, rValues);
+
+    /* Run-shaped chunks merge as runs without expanding to bitmaps */
+    const int32_t runCountB = chunkAsRuns(bValue, runsB);
+    if (runCountB >= 0 && !rHasChunk) {
+        storeRunsToChunk(r, key, runsB, runCountB, false);
+        return;
     }
 
-    if (popcount == 0) {
-        /* All zeros - no chunk needed (already deleted above) */
+    const int32_t runCountR = rHasChunk ? chunkAsRuns(&rValue, runsR) : -1;
+    if (runCountB >= 0 && runCountR >= 0) {
+        const uint32_t count = chunkRunsCombine(
+            runsR, runCountR, runsB, runCountB, CHUNK_RUN_OP_OR, runsResult);
+        storeRunsToChunk(r, key, runsResult, count, true);
         return;
-    } else if (popcount == BITMAP_SIZE_IN_BITS) {
-        /* All ones */
-        uint8_t allOnes[1] = {CHUNK_TYPE_ALL_1};
-        const databox box = {
-            .data.bytes.start = allOnes, .len = 1, .type = DATABOX_BYTES};
-        const databox *inserting[] = {key, &box};
-        multimapInsert(&r->map, inserting);
-    } else if (popcount < MAX_ENTRIES_PER_DIRECT_LISTING) {
-        /* Sparse - convert to packed position list.
-         * Layout: [type:1] [count:1-2] [positions:N]
-         * We need to write positions first to a temp location, then move them
-         * to the correct offset based on count's varint length. */
-        uint8_t packed[BITMAP_SIZE_IN_BYTES + 16] = {0};
-        packed[0] = CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS;
-
-        /* Write positions to temporary location at offset 1 */
-        uint16_t count = bitmapToSetPositions(bitmap, packed + 1);
-        const uint64_t positionsBytes = divCeil(count * 13, 8);
-
-        /* Determine varint length for count and move positions to correct spot
-         */
-        varintWidth countWidth = varintTaggedLen(count);
-        memmove(packed + 1 + countWidth, packed + 1, positionsBytes);
+    }
 
-        /* Now write the count at offset 1 */
-        varintTaggedPut64(packed + 1, count);
+    expandChunkToBitmap(bValue, bitmapB);
 
-        uint64_t packedLen = 1 + countWidth + positionsBytes;
+    if (rHasChunk) {
+        expandChunkToBitmap(&rValue, bitmapR);
+        bitmap_or_simd(bitmapR, bitmapB, BITMAP_SIZE_IN_BYTES);
+    } else {
+        memcpy(bitmapR, bitmapB, BITMAP_SIZE_IN_BYTES);
+    }
 
-        const databox box = {.data.bytes.start = packed,
-                             .len = packedLen,
-                             .type = DATABOX_BYTES};
-        const databox *inserting[] = {key, &box};
-        multimapInsert(&r->map, inserting);
-    } else if (popcount > MAX_BITMAP_ENTIRES_BEFORE_NEGATIVE_LISTING) {
-        /* Nearly full - convert to negative position list.
-         * Same layout as sparse, but stores unset positions. */
-        uint8_t packed[BITMAP_SIZE_IN_BYTES + 16] = {0};
-        packed[0] = CHUNK_TYPE_OVER_FULL_DIRECT_NOT_SET_POSITION_NUMBERS;
+    /* Store result */
+    compressBitmapToChunk(r, key, bitmapR, rHasChunk);
+}
 
-        /* Write positions to temporary location at offset 1 */
-        uint16_t count = bitmapToNegativePositions(bitmap, packed + 1);
-        const uint64_t positionsBytes = divCeil(count * 13, 8);
+/* Helper: r[key] &= bValue; a NULL bValue means b has no such chunk.
+ * r[key] must exist. */
+DK_STATIC void andChunkWith(multiroar *r, const databox *key,
+                            const databox *bValue) {
+    uint8_t bitmapR[BITMAP_SIZE_IN_BYTES];
+    uint8_t bitmapB[BITMAP_SIZE_IN_BYTES];
+    chunkRun runsR[MAX_RUNS_PER_CHUNK];
+    chunkRun runsB[MAX_RUNS_PER_CHUNK];
+    chunkRun runsResult[MAX_RUNS_COMBINED];
+    multimapEntry me;
 
-        /* Determine varint length for count and move positions to correct spot
-         */
-        varintWidth countWidth = varintTaggedLen(count);
-        memmove(packed + 1 + countWidth, packed + 1, positionsBytes);
+    if (!multimapGetUnderlyingEntry(r->map, key, &me)) {
+        return;
+    }
 
-        /* Now write the count at offset 1 */
-        varintTaggedPut64(packed + 1, count);
+    databox rValue;
+    flexGetNextByType(*me.map, &me.fe, &rValue);
 
-        uint64_t packedLen = 1 + countWidth + positionsBytes;
+    /* Run-shaped chunks intersect as runs without expanding */
+    const int32_t runCountR = chunkAsRuns(&rValue, runsR);
+    const int32_t runCountB = bValue ? chunkAsRuns(bValue, runsB) : 0;
+    if (runCountR >= 0 && runCountB >= 0) {
+        const uint32_t count = chunkRunsCombine(
+            runsR, runCountR, runsB, runCountB, CHUNK_RUN_OP_AND, runsResult);
+        storeRunsToChunk(r, key, runsResult, count, true);
+        return;
+    }
 
-        const databox box = {.data.bytes.start = packed,
-                             .len = packedLen,
-                             .type = DATABOX_BYTES};
-        const databox *inserting[] = {key, &box};
-        multimapInsert(&r->map, inserting);
-    } else {
-        /* Medium density - keep as bitmap */
-        uint8_t bitmapWithType[BITMAP_SIZE_IN_BYTES + 1];
-        bitmapWithType[0] = CHUNK_TYPE_FULL_BITMAP;
-        memcpy(bitmapWithType + 1, bitmap, BITMAP_SIZE_IN_BYTES);
+    expandChunkToBitmap(&rValue, bitmapR);
 
-        const databox box = {.data.bytes.start = bitmapWithType,
-                             .len = sizeof(bitmapWithType),
-                             .type = DATABOX_BYTES};
-        const databox *inserting[] = {key, &box};
-        multimapInsert(&r->map, inserting);
+    if (bValue) {
+        /* Both have this chunk - AND them */
+        expandChunkToBitmap(bValue, bitmapB);
+        bitmap_and_simd(bitmapR, bitmapB, BITMAP_SIZE_IN_BYTES);
+    } else {
+        /* b doesn't have this chunk - result is all zeros */
+        memset(bitmapR, 0, BITMAP_SIZE_IN_BYTES);
     }
+
+    /* compressBitmapToChunk() looks the entry up again before rewriting */
+    compressBitmapToChunk(r, key, bitmapR, true);
 }
 
 /* OR: r = r OR b */
@@ -2649,9 +3489,6 @@ void multiroarOr(multiroar *r, multiroar *b) {
         return;
     }
 
-    uint8_t bitmapR[BITMAP_SIZE_IN_BYTES];
-    uint8_t bitmapB[BITMAP_SIZE_IN_BYTES];
-
     /* First, collect all keys from b */
     uint64_t numChunks = multimapCount(b->map);
     if (numChunks == 0) {
@@ -2681,23 +3518,8 @@ void multiroarOr(multiroar *r, multiroar *b) {
         if (!multimapLookup(b->map, &key, bValues)) {
             continue; /* shouldn't happen */
         }
-        expandChunkToBitmap(&bValue, bitmapB);
 
-        /* Look up corresponding chunk in r */
-        databox rValue;
-        databox *rValues[] = {&rValue};
-        bool rHasChunk = multimapLookup(r->map, &key, rValues);
-
-        if (rHasChunk) {
-            expandChunkToBitmap(&rValue, bitmapR);
-            bitmap_or_simd(bitmapR, bitmapB, BITMAP_SIZE_IN_BYTES);
-        } else {
-            memcpy(bitmapR, bitmapB, BITMAP_SIZE_IN_BYTES);
-        }
-
-        /* Store result */
-        multimapEntry me;
-        compressBitmapToChunk(r, &key, bitmapR, &me, rHasChunk);
+        orChunkInto(r, &key, &bValue);
     }
 
     zfree(chunkKeys);
@@ -2711,10 +3533,6 @@ void multiroarAnd(multiroar *r, multiroar *b) {
 
     /* For AND, chunks only in r (not in b) become zeros.
      * We need to collect keys to delete after iteration. */
-    uint8_t bitmapR[BITMAP_SIZE_IN_BYTES];
-    uint8_t bitmapB[BITMAP_SIZE_IN_BYTES];
-
-    /* Collect chunk keys from r that need processing */
     uint64_t numChunks = multimapCount(r->map);
     if (numChunks == 0) {
         return;
@@ -2735,33 +3553,13 @@ void multiroarAnd(multiroar *r, multiroar *b) {
     /* Process each chunk */
     for (uint64_t i = 0; i < keyCount; i++) {
         databox key = {.data.u = chunkKeys[i], .type = DATABOX_UNSIGNED_64};
-        multimapEntry me;
-
-        if (!multimapGetUnderlyingEntry(r->map, &key, &me)) {
-            continue;
-        }
-
-        databox rValue;
-        flexGetNextByType(*me.map, &me.fe, &rValue);
-        expandChunkToBitmap(&rValue, bitmapR);
 
         /* Look up corresponding chunk in b */
         databox bValue;
         databox *bValues[] = {&bValue};
+        const bool bHasChunk = multimapLookup(b->map, &key, bValues);
 
-        if (multimapLookup(b->map, &key, bValues)) {
-            /* Both have this chunk - AND them */
-            expandChunkToBitmap(&bValue, bitmapB);
-            bitmap_and_simd(bitmapR, bitmapB, BITMAP_SIZE_IN_BYTES);
-        } else {
-            /* b doesn't have this chunk - result is all zeros */
-            memset(bitmapR, 0, BITMAP_SIZE_IN_BYTES);
-        }
-
-        /* Re-get entry (may have moved) and update */
-        if (multimapGetUnderlyingEntry(r->map, &key, &me)) {
-            compressBitmapToChunk(r, &key, bitmapR, &me, true);
-        }
+        andChunkWith(r, &key, bHasChunk ? &bValue : NULL);
     }
 
     zfree(chunkKeys);
@@ -2775,6 +3573,9 @@ void multiroarXor(multiroar *r, multiroar *b) {
 
     uint8_t bitmapR[BITMAP_SIZE_IN_BYTES];
     uint8_t bitmapB[BITMAP_SIZE_IN_BYTES];
+    chunkRun runsR[MAX_RUNS_PER_CHUNK];
+    chunkRun runsB[MAX_RUNS_PER_CHUNK];
+    chunkRun runsResult[MAX_RUNS_COMBINED];
 
     /* First, collect all keys from b */
     uint64_t numChunks = multimapCount(b->map);
@@ -2782,13 +3583,8 @@ void multiroarXor(multiroar *r, multiroar *b) {
         return;
     }
 
-    /* Store both keys and bitmaps from b */
-    typedef struct {
-        uint64_t key;
-        uint8_t bitmap[BITMAP_SIZE_IN_BYTES];
-    } ChunkBitmap;
-    ChunkBitmap *chunks = zmalloc(numChunks * sizeof(ChunkBitmap));
-    uint64_t chunkCount = 0;
+    uint64_t *chunkKeys = zmalloc(numChunks * sizeof(uint64_t));
+    uint64_t keyCount = 0;
 
     multimapIterator iter;
     multimapIteratorInit(b->map, &iter, true);
@@ -2796,33 +3592,49 @@ void multiroarXor(multiroar *r, multiroar *b) {
     databox keyStorage[2];
     databox *keyPtr[2] = {&keyStorage[0], &keyStorage[1]};
     while (multimapIteratorNext(&iter, keyPtr)) {
-        chunks[chunkCount].key = keyStorage[0].data.u;
-        expandChunkToBitmap(&keyStorage[1], chunks[chunkCount].bitmap);
-        chunkCount++;
+        chunkKeys[keyCount++] = keyStorage[0].data.u;
     }
 
-    /* Process each chunk from b */
-    for (uint64_t i = 0; i < chunkCount; i++) {
-        databox key = {.data.u = chunks[i].key, .type = DATABOX_UNSIGNED_64};
-        memcpy(bitmapB, chunks[i].bitmap, BITMAP_SIZE_IN_BYTES);
+    /* Process each chunk from b.  Each key is visited once, so looking
+     * b's chunk up again is safe even when r and b are the same roar. */
+    for (uint64_t i = 0; i < keyCount; i++) {
+        databox key = {.data.u = chunkKeys[i], .type = DATABOX_UNSIGNED_64};
+
+        databox bValue;
+        databox *bValues[] = {&bValue};
+        if (!multimapLookup(b->map, &key, bValues)) {
+            continue; /* shouldn't happen */
+        }
 
         /* Look up corresponding chunk in r */
-        multimapEntry me;
-        bool rHasChunk = multimapGetUnderlyingEntry(r->map, &key, &me);
+        databox rValue;
+        databox *rValues[] = {&rValue};
+        bool rHasChunk = multimapLookup(r->map, &key, rValues);
+
+        /* Run-shaped chunks combine as runs without expanding */
+        const int32_t runCountB = chunkAsRuns(&bValue, runsB);
+        const int32_t runCountR = rHasChunk ? chunkAsRuns(&rValue, runsR) : 0;
+        if (runCountB >= 0 && runCountR >= 0) {
+            const uint32_t count =
+                chunkRunsCombine(runsR, runCountR, runsB, runCountB,
+                                 CHUNK_RUN_OP_XOR, runsResult);
+            storeRunsToChunk(r, &key, runsResult, count, rHasChunk);
+            continue;
+        }
+
+        expandChunkToBitmap(&bValue, bitmapB);
 
         if (rHasChunk) {
-            databox rValue;
-            flexGetNextByType(*me.map, &me.fe, &rValue);
             expandChunkToBitmap(&rValue, bitmapR);
             bitmap_xor_simd(bitmapR, bitmapB, BITMAP_SIZE_IN_BYTES);
-            compressBitmapToChunk(r, &key, bitmapR, &me, true);
+            compressBitmapToChunk(r, &key, bitmapR, true);
         } else {
             /* r doesn't have this chunk - XOR with 0 = copy */
-            compressBitmapToChunk(r, &key, bitmapB, &me, false);
+            compressBitmapToChunk(r, &key, bitmapB, false);
         }
     }
 
-    zfree(chunks);
+    zfree(chunkKeys);
 }
 
 /* NOT: r = NOT r (within existing chunks only) */
@@ -2865,11 +3677,7 @@ void multiroarNot(multiroar *r) {
         expandChunkToBitmap(&rValue, bitmap);
         bitmap_not_simd(bitmap, BITMAP_SIZE_IN_BYTES);
 
-        /* Re-get entry and update */
-        multimapEntry me;
-        if (multimapGetUnderlyingEntry(r->map, &key, &me)) {
-            compressBitmapToChunk(r, &key, bitmap, &me, true);
-        }
+        compressBitmapToChunk(r, &key, bitmap, true);
     }
 
     zfree(chunkKeys);
@@ -2903,260 +3711,509 @@ multiroar *multiroarNewNot(const multiroar *r) {
 /* ====================================================================
  * N-way Set Operations (for N >= 2 inputs)
  * ==================================================================== */
+/* OR and XOR walk every input's chunks in key order through a min-heap of
+ * per-input cursors. All chunks sharing a key are folded straight into one
+ * scratch bitmap and encoded once, so no intermediate roars are built and
+ * a key held by a single input is copied without any conversion.
+ *
+ * AND is driven by the input with the fewest chunks, probing the other
+ * inputs in ascending chunk-count order. Each chunk is intersected
+ * incrementally in the smallest representation seen so far (positions,
+ * then runs, then bitmap), and the probe stops at the first input missing
+ * the chunk or as soon as the intersection is empty.
+ *
+ * Results are built in a fresh map and swapped into roars[0] at the end
+ * because roars[0] is itself one of the inputs being walked. */
+
+typedef struct chunkCursor {
+    multimapIterator iter;
+    databox value;
+    uint64_t chunkId;
+} chunkCursor;
 
-/* Helper: Collect all unique chunk IDs across N multiroars */
-DK_STATIC uint64_t *collectAllChunkKeys(uint64_t n, multiroar **roars,
-                                        uint64_t *outCount) {
-    if (n == 0 || !roars) {
-        *outCount = 0;
-        return NULL;
+DK_STATIC bool chunkCursorNext(chunkCursor *cursor) {
+    databox keyValue[2];
+    databox *kvPtr[2] = {&keyValue[0], &keyValue[1]};
+    if (!multimapIteratorNext(&cursor->iter, kvPtr)) {
+        return false;
     }
 
-    /* Estimate total number of chunks across all inputs */
-    uint64_t totalChunks = 0;
-    for (uint64_t i = 0; i < n; i++) {
-        if (roars[i] && roars[i]->map) {
-            totalChunks += multimapCount(roars[i]->map);
+    cursor->chunkId = keyValue[0].data.u;
+    cursor->value = keyValue[1];
+    return true;
+}
+
+DK_STATIC void chunkHeapSiftDown(const chunkCursor *cursors, uint64_t *heap,
+                                 uint64_t count, uint64_t i) {
+    while (true) {
+        const uint64_t left = (2 * i) + 1;
+        const uint64_t right = left + 1;
+        uint64_t smallest = i;
+
+        if (left < count && cursors[heap[left]].chunkId <
+                                cursors[heap[smallest]].chunkId) {
+            smallest = left;
+        }
+
+        if (right < count && cursors[heap[right]].chunkId <
+                                 cursors[heap[smallest]].chunkId) {
+            smallest = right;
+        }
+
+        if (smallest == i) {
+            return;
         }
+
+        const uint64_t tmp = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = tmp;
+        i = smallest;
     }
+}
 
-    if (totalChunks == 0) {
-        *outCount = 0;
-        return NULL;
+DK_STATIC void chunkHeapSiftUp(const chunkCursor *cursors, uint64_t *heap,
+                               uint64_t i) {
+    while (i > 0) {
+        const uint64_t parent = (i - 1) / 2;
+        if (cursors[heap[parent]].chunkId <= cursors[heap[i]].chunkId) {
+            return;
+        }
+
+        const uint64_t tmp = heap[i];
+        heap[i] = heap[parent];
+        heap[parent] = tmp;
+        i = parent;
     }
+}
 
-    /* Collect all chunk keys */
-    uint64_t *allKeys = zmalloc(totalChunks * sizeof(uint64_t));
-    uint64_t keyCount = 0;
+/* scratch |= chunk (or ^= for 'xor') without expanding sparse or run
+ * chunks into a temporary bitmap first */
+DK_STATIC void foldChunkIntoBitmap(uint8_t *scratch, const databox *value,
+                                   bool xor, uint8_t *temp) {
+    switch (GET_CHUNK_TYPE(value)) {
+    case CHUNK_TYPE_ALL_1:
+        if (xor) {
+            bitmap_not_simd(scratch, BITMAP_SIZE_IN_BYTES);
+        } else {
+            memset(scratch, 0xFF, BITMAP_SIZE_IN_BYTES);
+        }
+        return;
+    case CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS: {
+        const uint8_t *packed = GET_CHUNK_PACKED_START(value);
+        const uint16_t count = PACKED_COUNT_FROM_VALUE(value);
+        for (uint16_t i = 0; i < count; i++) {
+            const uint16_t pos = varintPacked13Get(packed, i);
+            if (xor) {
+                scratch[BYTE_OFFSET(pos)] ^= (1 << BIT_OFFSET(pos));
+            } else {
+                scratch[BYTE_OFFSET(pos)] |= (1 << BIT_OFFSET(pos));
+            }
+        }
+        return;
+    }
+    case CHUNK_TYPE_FULL_BITMAP:
+        if (xor) {
+            bitmap_xor_simd(scratch, GET_CHUNK_BITMAP_START(value),
+                            BITMAP_SIZE_IN_BYTES);
+        } else {
+            bitmap_or_simd(scratch, GET_CHUNK_BITMAP_START(value),
+                           BITMAP_SIZE_IN_BYTES);
+        }
+        return;
+    case CHUNK_TYPE_RUNS:
+        if (!xor) {
+            const uint8_t *runsStart = GET_CHUNK_RUNS_START(value);
+            const uint16_t count = RUN_COUNT_FROM_VALUE(value);
+            for (uint16_t i = 0; i < count; i++) {
+                bitmapSetRange(scratch, runStartAt(runsStart, i),
+                               (uint32_t)runLastAt(runsStart, i) + 1);
+            }
+            return;
+        }
+        /* fallthrough */
+    default:
+        expandChunkToBitmap(value, temp);
+        if (xor) {
+            bitmap_xor_simd(scratch, temp, BITMAP_SIZE_IN_BYTES);
+        } else {
+            bitmap_or_simd(scratch, temp, BITMAP_SIZE_IN_BYTES);
+        }
+        return;
+    }
+}
+
+/* Replace the contents of 'r' with those of 'built' and free 'built' */
+DK_STATIC void multiroarAdoptMap(multiroar *r, multiroar *built) {
+    multimap *temp = r->map;
+    r->map = built->map;
+    built->map = temp;
+    multiroarFree(built);
+}
+
+/* Heap-driven N-way OR (or XOR) into roars[0] */
+DK_STATIC void multiroarFoldN(uint64_t n, multiroar **roars, bool xor) {
+    chunkCursor *cursors = zmalloc(n * sizeof(*cursors));
+    uint64_t *heap = zmalloc(n * sizeof(*heap));
+    uint64_t *group = zmalloc(n * sizeof(*group));
+    uint64_t heapCount = 0;
 
     for (uint64_t i = 0; i < n; i++) {
         if (!roars[i] || !roars[i]->map) {
             continue;
         }
 
-        multimapIterator iter;
-        multimapIteratorInit(roars[i]->map, &iter, true);
+        multimapIteratorInit(roars[i]->map, &cursors[i].iter, true);
+        if (chunkCursorNext(&cursors[i])) {
+            heap[heapCount] = i;
+            chunkHeapSiftUp(cursors, heap, heapCount);
+            heapCount++;
+        }
+    }
 
-        databox keyValue[2];
-        databox *kvPtr[2] = {&keyValue[0], &keyValue[1]};
+    multiroar *built = multiroarBitNew();
+    uint8_t scratch[BITMAP_SIZE_IN_BYTES];
+    uint8_t temp[BITMAP_SIZE_IN_BYTES];
 
-        while (multimapIteratorNext(&iter, kvPtr)) {
-            uint64_t chunkId = keyValue[0].data.u;
+    while (heapCount > 0) {
+        /* Pop every cursor positioned at the smallest chunk id */
+        const uint64_t chunkId = cursors[heap[0]].chunkId;
+        uint64_t groupCount = 0;
+        while (heapCount > 0 && cursors[heap[0]].chunkId == chunkId) {
+            group[groupCount++] = heap[0];
+            heap[0] = heap[--heapCount];
+            chunkHeapSiftDown(cursors, heap, heapCount, 0);
+        }
+
+        const databox key = {.data.u = chunkId, .type = DATABOX_UNSIGNED_64};
+        if (groupCount == 1) {
+            /* Only one input has this chunk; its encoding is already
+             * canonical so copy it verbatim. */
+            const databox *inserting[] = {&key, &cursors[group[0]].value};
+            multimapInsert(&built->map, inserting);
+        } else {
+            memset(scratch, 0, BITMAP_SIZE_IN_BYTES);
+            for (uint64_t g = 0; g < groupCount; g++) {
+                const databox *value = &cursors[group[g]].value;
+                foldChunkIntoBitmap(scratch, value, xor, temp);
 
-            /* Check if we already have this key */
-            bool found = false;
-            for (uint64_t j = 0; j < keyCount; j++) {
-                if (allKeys[j] == chunkId) {
-                    found = true;
+                /* OR with a full chunk saturates; skip the rest */
+                if (!xor && GET_CHUNK_TYPE(value) == CHUNK_TYPE_ALL_1) {
                     break;
                 }
             }
 
-            if (!found) {
-                allKeys[keyCount++] = chunkId;
+            compressBitmapToChunk(built, &key, scratch, false);
+        }
+
+        /* Advance the cursors we consumed */
+        for (uint64_t g = 0; g < groupCount; g++) {
+            if (chunkCursorNext(&cursors[group[g]])) {
+                heap[heapCount] = group[g];
+                chunkHeapSiftUp(cursors, heap, heapCount);
+                heapCount++;
             }
         }
     }
 
-    *outCount = keyCount;
-    return allKeys;
+    multiroarAdoptMap(roars[0], built);
+
+    zfree(group);
+    zfree(heap);
+    zfree(cursors);
 }
 
-/* N-way AND: Modifies first roar in array */
-void multiroarAndN(uint64_t n, multiroar **roars) {
-    if (n < 2 || !roars || !roars[0]) {
-        return;
+DK_STATIC bool chunkValueContains(const databox *value, uint16_t offset) {
+    switch (GET_CHUNK_TYPE(value)) {
+    case CHUNK_TYPE_ALL_1:
+        return true;
+    case CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS:
+        return varintPacked13Member(GET_CHUNK_PACKED_START(value),
+                                    PACKED_COUNT_FROM_VALUE(value),
+                                    offset) >= 0;
+    case CHUNK_TYPE_FULL_BITMAP:
+        return (GET_CHUNK_BITMAP_START(value)[BYTE_OFFSET(offset)] >>
+                BIT_OFFSET(offset)) &
+               0x01;
+    case CHUNK_TYPE_OVER_FULL_DIRECT_NOT_SET_POSITION_NUMBERS:
+        return varintPacked13Member(GET_CHUNK_PACKED_START(value),
+                                    PACKED_COUNT_FROM_VALUE(value),
+                                    offset) == -1;
+    case CHUNK_TYPE_RUNS:
+        return chunkRunsContains(value, offset);
+    default:
+        return false;
     }
+}
 
-    multiroar *result = roars[0];
+DK_STATIC bool bitmapIsEmpty(const uint8_t *bitmap) {
+    uint64_t any = 0;
+    for (uint32_t i = 0; i < BITMAP_SIZE_IN_BYTES / sizeof(uint64_t); i++) {
+        any |= bitmapWord(bitmap, i);
+    }
 
-    /* Collect all chunk IDs that exist in ALL inputs */
-    uint64_t allKeyCount;
-    uint64_t *allKeys = collectAllChunkKeys(n, roars, &allKeyCount);
+    return any == 0;
+}
 
-    if (!allKeys) {
-        return;
+/* Working set for intersecting one chunk across N inputs. The set is kept
+ * in the smallest representation seen so far: once any operand is a sparse
+ * position list, only its surviving positions are tracked and every later
+ * operand is just a membership probe. */
+typedef enum chunkIntersectionState {
+    CHUNK_INTERSECTION_FULL = 0, /* no restricting operand yet */
+    CHUNK_INTERSECTION_POSITIONS,
+    CHUNK_INTERSECTION_RUNS,
+    CHUNK_INTERSECTION_BITMAP
+} chunkIntersectionState;
+
+typedef struct chunkIntersection {
+    chunkIntersectionState state;
+    uint32_t count; /* positions or runs held */
+    uint16_t positions[MAX_ENTRIES_PER_DIRECT_LISTING];
+    chunkRun runs[MAX_RUNS_COMBINED];
+    chunkRun operandRuns[MAX_RUNS_PER_CHUNK];
+    chunkRun combined[MAX_RUNS_COMBINED];
+    uint8_t bitmap[BITMAP_SIZE_IN_BYTES];
+    uint8_t temp[BITMAP_SIZE_IN_BYTES];
+} chunkIntersection;
+
+DK_STATIC bool chunkRunsArrayContains(const chunkRun *runs, uint32_t count,
+                                      uint16_t position) {
+    uint32_t lo = 0;
+    uint32_t hi = count;
+    while (lo < hi) {
+        const uint32_t mid = lo + ((hi - lo) / 2);
+        if (runs[mid].last < position) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo < count && runs[lo].start <= position;
+}
+
+/* Switch to POSITIONS using the sparse operand 'value', keeping only
+ * positions also present in the current runs or bitmap. */
+DK_STATIC void chunkIntersectionTakePositions(chunkIntersection *ix,
+                                              const databox *value) {
+    const uint8_t *packed = GET_CHUNK_PACKED_START(value);
+    const uint16_t count = PACKED_COUNT_FROM_VALUE(value);
+    uint32_t kept = 0;
+
+    for (uint16_t i = 0; i < count; i++) {
+        const uint16_t pos = varintPacked13Get(packed, i);
+        bool member;
+        switch (ix->state) {
+        case CHUNK_INTERSECTION_RUNS:
+            member = chunkRunsArrayContains(ix->runs, ix->count, pos);
+            break;
+        case CHUNK_INTERSECTION_BITMAP:
+            member = (ix->bitmap[BYTE_OFFSET(pos)] >> BIT_OFFSET(pos)) & 0x01;
+            break;
+        default:
+            member = true;
+            break;
+        }
+
+        if (member) {
+            ix->positions[kept++] = pos;
+        }
     }
 
-    uint8_t *bitmaps = zmalloc(n * BITMAP_SIZE_IN_BYTES);
-    uint8_t resultBitmap[BITMAP_SIZE_IN_BYTES];
+    ix->state = CHUNK_INTERSECTION_POSITIONS;
+    ix->count = kept;
+}
 
-    /* Process each unique chunk */
-    for (uint64_t i = 0; i < allKeyCount; i++) {
-        databox key = {.data.u = allKeys[i], .type = DATABOX_UNSIGNED_64};
+/* Intersect one more operand into 'ix'; returns false once empty */
+DK_STATIC bool chunkIntersectionApply(chunkIntersection *ix,
+                                      const databox *value) {
+    const uint8_t type = GET_CHUNK_TYPE(value);
+    if (type == CHUNK_TYPE_ALL_1) {
+        return true;
+    }
 
-        /* Check if ALL roars have this chunk */
-        bool allHaveChunk = true;
-        for (uint64_t j = 0; j < n; j++) {
-            if (!roars[j] || !roars[j]->map) {
-                allHaveChunk = false;
-                break;
-            }
+    switch (ix->state) {
+    case CHUNK_INTERSECTION_FULL:
+        if (type == CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS) {
+            chunkIntersectionTakePositions(ix, value);
+        } else if (type == CHUNK_TYPE_RUNS) {
+            ix->count = chunkRunsDecode(value, ix->runs);
+            ix->state = CHUNK_INTERSECTION_RUNS;
+        } else {
+            expandChunkToBitmap(value, ix->bitmap);
+            ix->state = CHUNK_INTERSECTION_BITMAP;
+        }
+        return true;
 
-            databox value;
-            databox *values[] = {&value};
-            if (!multimapLookup(roars[j]->map, &key, values)) {
-                allHaveChunk = false;
-                break;
+    case CHUNK_INTERSECTION_POSITIONS: {
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < ix->count; i++) {
+            if (chunkValueContains(value, ix->positions[i])) {
+                ix->positions[kept++] = ix->positions[i];
             }
         }
+        ix->count = kept;
+        return kept > 0;
+    }
 
-        if (!allHaveChunk) {
-            /* AND with missing chunk (all zeros) = all zeros
-             * So delete this chunk from result if it exists */
-            multimapDelete(&result->map, &key);
-            continue;
+    case CHUNK_INTERSECTION_RUNS:
+        if (type == CHUNK_TYPE_RUNS) {
+            const uint32_t operandCount =
+                chunkRunsDecode(value, ix->operandRuns);
+            ix->count =
+                chunkRunsCombine(ix->runs, ix->count, ix->operandRuns,
+                                 operandCount, CHUNK_RUN_OP_AND, ix->combined);
+            memcpy(ix->runs, ix->combined, ix->count * sizeof(*ix->runs));
+            return ix->count > 0;
         }
 
-        /* Expand all chunks to bitmaps */
-        for (uint64_t j = 0; j < n; j++) {
-            databox value;
-            databox *values[] = {&value};
-            multimapLookup(roars[j]->map, &key, values);
-            expandChunkToBitmap(&value, bitmaps + j * BITMAP_SIZE_IN_BYTES);
+        if (type == CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS) {
+            chunkIntersectionTakePositions(ix, value);
+            return ix->count > 0;
         }
 
-        /* Initialize result with first bitmap */
-        memcpy(resultBitmap, bitmaps, BITMAP_SIZE_IN_BYTES);
+        chunkRunsToBitmap(ix->runs, ix->count, ix->bitmap);
+        ix->state = CHUNK_INTERSECTION_BITMAP;
+        /* fallthrough */
 
-        /* AND with all other bitmaps */
-        for (uint64_t j = 1; j < n; j++) {
-            bitmap_and_simd(resultBitmap, bitmaps + j * BITMAP_SIZE_IN_BYTES,
+    case CHUNK_INTERSECTION_BITMAP:
+    default:
+        switch (type) {
+        case CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS:
+            chunkIntersectionTakePositions(ix, value);
+            return ix->count > 0;
+        case CHUNK_TYPE_FULL_BITMAP:
+            bitmap_and_simd(ix->bitmap, GET_CHUNK_BITMAP_START(value),
                             BITMAP_SIZE_IN_BYTES);
+            break;
+        case CHUNK_TYPE_OVER_FULL_DIRECT_NOT_SET_POSITION_NUMBERS: {
+            /* Only the listed positions can clear bits */
+            const uint8_t *packed = GET_CHUNK_PACKED_START(value);
+            const uint16_t unset = PACKED_COUNT_FROM_VALUE(value);
+            for (uint16_t i = 0; i < unset; i++) {
+                const uint16_t pos = varintPacked13Get(packed, i);
+                ix->bitmap[BYTE_OFFSET(pos)] &= ~(1 << BIT_OFFSET(pos));
+            }
+            break;
+        }
+        default:
+            expandChunkToBitmap(value, ix->temp);
+            bitmap_and_simd(ix->bitmap, ix->temp, BITMAP_SIZE_IN_BYTES);
+            break;
         }
+        return !bitmapIsEmpty(ix->bitmap);
+    }
+}
 
-        /* Store result */
-        multimapEntry me;
-        bool resultHasChunk =
-            multimapGetUnderlyingEntry(result->map, &key, &me);
-        compressBitmapToChunk(result, &key, resultBitmap, &me, resultHasChunk);
+/* Encode the (non-empty) working set; same contract as encodeBitmapChunk */
+DK_STATIC uint32_t chunkIntersectionEncode(chunkIntersection *ix,
+                                           uint8_t *chunk) {
+    switch (ix->state) {
+    case CHUNK_INTERSECTION_FULL:
+        chunk[0] = CHUNK_TYPE_ALL_1;
+        return 1;
+    case CHUNK_INTERSECTION_POSITIONS:
+        memset(ix->bitmap, 0, BITMAP_SIZE_IN_BYTES);
+        for (uint32_t i = 0; i < ix->count; i++) {
+            ix->bitmap[BYTE_OFFSET(ix->positions[i])] |=
+                (1 << BIT_OFFSET(ix->positions[i]));
+        }
+        return encodeBitmapChunk(ix->bitmap, chunk);
+    case CHUNK_INTERSECTION_RUNS:
+        return encodeRunsChunk(ix->runs, ix->count, chunk);
+    case CHUNK_INTERSECTION_BITMAP:
+    default:
+        return encodeBitmapChunk(ix->bitmap, chunk);
     }
+}
+
+typedef struct roarBySize {
+    uint64_t chunks;
+    multiroar *roar;
+} roarBySize;
 
-    zfree(bitmaps);
-    zfree(allKeys);
+DK_STATIC int roarBySizeCompare(const void *a, const void *b) {
+    const uint64_t ca = ((const roarBySize *)a)->chunks;
+    const uint64_t cb = ((const roarBySize *)b)->chunks;
+    return (ca > cb) - (ca < cb);
 }
 
-/* N-way OR: Modifies first roar in array */
-void multiroarOrN(uint64_t n, multiroar **roars) {
+/* N-way AND: Modifies first roar in array */
+void multiroarAndN(uint64_t n, multiroar **roars) {
     if (n < 2 || !roars || !roars[0]) {
         return;
     }
 
-    multiroar *result = roars[0];
+    multiroar *built = multiroarBitNew();
 
-    /* Collect all chunk IDs across all inputs */
-    uint64_t allKeyCount;
-    uint64_t *allKeys = collectAllChunkKeys(n, roars, &allKeyCount);
+    /* Order inputs by chunk count: the sparsest input drives the walk and
+     * the next sparsest are probed first so missing chunks fail fast. */
+    roarBySize *inputs = zmalloc(n * sizeof(*inputs));
+    for (uint64_t i = 0; i < n; i++) {
+        if (!roars[i] || !roars[i]->map || !multimapCount(roars[i]->map)) {
+            /* AND with an empty input is empty */
+            zfree(inputs);
+            multiroarAdoptMap(roars[0], built);
+            return;
+        }
 
-    if (!allKeys) {
-        return;
+        inputs[i].chunks = multimapCount(roars[i]->map);
+        inputs[i].roar = roars[i];
     }
 
-    uint8_t *bitmaps = zmalloc(n * BITMAP_SIZE_IN_BYTES);
-    uint8_t resultBitmap[BITMAP_SIZE_IN_BYTES];
-
-    /* Process each unique chunk */
-    for (uint64_t i = 0; i < allKeyCount; i++) {
-        databox key = {.data.u = allKeys[i], .type = DATABOX_UNSIGNED_64};
+    qsort(inputs, n, sizeof(*inputs), roarBySizeCompare);
 
-        /* Expand all chunks to bitmaps (use zeros for missing chunks) */
-        bool anyHasChunk = false;
-        for (uint64_t j = 0; j < n; j++) {
-            databox value;
-            databox *values[] = {&value};
+    chunkIntersection *ix = zmalloc(sizeof(*ix));
+    uint8_t chunk[CHUNK_ENCODE_BUFFER_BYTES];
 
-            if (roars[j] && roars[j]->map &&
-                multimapLookup(roars[j]->map, &key, values)) {
-                expandChunkToBitmap(&value, bitmaps + j * BITMAP_SIZE_IN_BYTES);
-                anyHasChunk = true;
-            } else {
-                /* Missing chunk = all zeros */
-                memset(bitmaps + j * BITMAP_SIZE_IN_BYTES, 0,
-                       BITMAP_SIZE_IN_BYTES);
-            }
-        }
+    multimapIterator iter;
+    multimapIteratorInit(inputs[0].roar->map, &iter, true);
 
-        if (!anyHasChunk) {
-            /* All chunks are zeros - skip */
-            continue;
-        }
+    databox keyValue[2];
+    databox *kvPtr[2] = {&keyValue[0], &keyValue[1]};
+    while (multimapIteratorNext(&iter, kvPtr)) {
+        const databox key = {.data.u = keyValue[0].data.u,
+                             .type = DATABOX_UNSIGNED_64};
 
-        /* Initialize result with first bitmap */
-        memcpy(resultBitmap, bitmaps, BITMAP_SIZE_IN_BYTES);
+        ix->state = CHUNK_INTERSECTION_FULL;
+        ix->count = 0;
+        bool nonEmpty = chunkIntersectionApply(ix, &keyValue[1]);
 
-        /* OR with all other bitmaps */
-        for (uint64_t j = 1; j < n; j++) {
-            bitmap_or_simd(resultBitmap, bitmaps + j * BITMAP_SIZE_IN_BYTES,
-                           BITMAP_SIZE_IN_BYTES);
+        for (uint64_t j = 1; j < n && nonEmpty; j++) {
+            databox value;
+            databox *lookup[] = {&value};
+            nonEmpty = multimapLookup(inputs[j].roar->map, &key, lookup) &&
+                       chunkIntersectionApply(ix, &value);
         }
 
-        /* Store result */
-        multimapEntry me;
-        bool resultHasChunk =
-            multimapGetUnderlyingEntry(result->map, &key, &me);
-        compressBitmapToChunk(result, &key, resultBitmap, &me, resultHasChunk);
+        if (nonEmpty) {
+            const uint32_t len = chunkIntersectionEncode(ix, chunk);
+            storeEncodedChunk(built, &key, chunk, len, false);
+        }
     }
 
-    zfree(bitmaps);
-    zfree(allKeys);
+    multiroarAdoptMap(roars[0], built);
+
+    zfree(ix);
+    zfree(inputs);
 }
 
-/* N-way XOR: Modifies first roar in array */
-void multiroarXorN(uint64_t n, multiroar **roars) {
+/* N-way OR: Modifies first roar in array */
+void multiroarOrN(uint64_t n, multiroar **roars) {
     if (n < 2 || !roars || !roars[0]) {
         return;
     }
 
-    multiroar *result = roars[0];
-
-    /* Collect all chunk IDs across all inputs */
-    uint64_t allKeyCount;
-    uint64_t *allKeys = collectAllChunkKeys(n, roars, &allKeyCount);
+    multiroarFoldN(n, roars, false);
+}
 
-    if (!allKeys) {
+/* N-way XOR: Modifies first roar in array */
+void multiroarXorN(uint64_t n, multiroar **roars) {
+    if (n < 2 || !roars || !roars[0]) {
         return;
     }
 
-    uint8_t *bitmaps = zmalloc(n * BITMAP_SIZE_IN_BYTES);
-    uint8_t resultBitmap[BITMAP_SIZE_IN_BYTES];
-
-    /* Process each unique chunk */
-    for (uint64_t i = 0; i < allKeyCount; i++) {
-        databox key = {.data.u = allKeys[i], .type = DATABOX_UNSIGNED_64};
-
-        /* Expand all chunks to bitmaps (use zeros for missing chunks) */
-        for (uint64_t j = 0; j < n; j++) {
-            databox value;
-            databox *values[] = {&value};
-
-            if (roars[j] && roars[j]->map &&
-                multimapLookup(roars[j]->map, &key, values)) {
-                expandChunkToBitmap(&value, bitmaps + j * BITMAP_SIZE_IN_BYTES);
-            } else {
-                /* Missing chunk = all zeros */
-                memset(bitmaps + j * BITMAP_SIZE_IN_BYTES, 0,
-                       BITMAP_SIZE_IN_BYTES);
-            }
-        }
-
-        /* Initialize result with first bitmap */
-        memcpy(resultBitmap, bitmaps, BITMAP_SIZE_IN_BYTES);
-
-        /* XOR with all other bitmaps */
-        for (uint64_t j = 1; j < n; j++) {
-            bitmap_xor_simd(resultBitmap, bitmaps + j * BITMAP_SIZE_IN_BYTES,
-                            BITMAP_SIZE_IN_BYTES);
-        }
-
-        /* Store result */
-        multimapEntry me;
-        bool resultHasChunk =
-            multimapGetUnderlyingEntry(result->map, &key, &me);
-        compressBitmapToChunk(result, &key, resultBitmap, &me, resultHasChunk);
-    }
-
-    zfree(bitmaps);
-    zfree(allKeys);
+    multiroarFoldN(n, roars, true);
 }
 
 /* N-way operations returning new multiroar */
@@ -3227,1411 +4284,1356 @@ multiroar *multiroarNewXorN(uint64_t n, multiroar **roars) {
 }
 
 /* ====================================================================
- * Testing
+ * Intersection Cardinality
  * ==================================================================== */
+/* Helper: |a AND b| for two chunks of the same id */
+DK_STATIC uint64_t chunkAndCount(const databox *a, const databox *b) {
+    if (GET_CHUNK_TYPE(a) == CHUNK_TYPE_ALL_1) {
+        return countBitsInChunk(b);
+    }
 
-#ifdef DATAKIT_TEST
+    if (GET_CHUNK_TYPE(b) == CHUNK_TYPE_ALL_1) {
+        return countBitsInChunk(a);
+    }
 
-#include "ctest.h"
-#include "timeUtil.h"
+    /* Probe the other chunk once per listed position */
+    if (GET_CHUNK_TYPE(b) == CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS) {
+        const databox *swap = a;
+        a = b;
+        b = swap;
+    }
 
-void multiroarRepr(multiroar *r, uint64_t highest) {
-    for (uint64_t i = 0; i < divCeil(highest, BITMAP_SIZE_IN_BITS); i++) {
-        databox value;
-        databox *values[1] = {&value};
-        if (multimapLookup(r->map,
-                           &(databox){.data.u = i, .type = DATABOX_UNSIGNED_64},
-                           values)) {
-            printf("[%" PRIu64 "] = %d (%" PRIu64 " byte%s)\n", i,
-                   GET_CHUNK_TYPE(&value), value.len,
-                   value.len == 1 ? "" : "s");
+    if (GET_CHUNK_TYPE(a) == CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS) {
+        const uint8_t *packed = GET_CHUNK_PACKED_START(a);
+        const uint16_t count = PACKED_COUNT_FROM_VALUE(a);
+        uint64_t matched = 0;
+        for (uint16_t i = 0; i < count; i++) {
+            matched += chunkValueContains(b, varintPacked13Get(packed, i));
         }
+
+        return matched;
     }
-}
 
-void multiroarTestCompare(multiroar *r, uint64_t highest) {
-    const uint64_t b = multimapBytes(r->map);
-    printf("Final size: %" PRIu64 " bytes; Highest bit set: %" PRIu64
-           "; Size if linear: %" PRIu64 " "
-           "bytes; Savings: %.2fx\n",
-           b, highest, highest / 8, ((float)(highest / 8) / b) - 1);
+    uint8_t bitmapA[BITMAP_SIZE_IN_BYTES];
+    uint8_t bitmapB[BITMAP_SIZE_IN_BYTES];
+    expandChunkToBitmap(a, bitmapA);
+    expandChunkToBitmap(b, bitmapB);
 
-    const uint64_t maps = multimapCount(r->map);
-    uint64_t asPositional = b;
-    uint64_t minusMaps = maps;
-    if (maps <= 255) {
-        asPositional -= (maps * 3);
-        minusMaps -= maps;
-    } else {
-        asPositional -= (255 * 3);
-        minusMaps -= 255;
+    uint64_t matched = 0;
+    for (uint32_t i = 0; i < BITMAP_SIZE_IN_BYTES / sizeof(uint64_t); i++) {
+        matched += __builtin_popcountll(bitmapWord(bitmapA, i) &
+                                        bitmapWord(bitmapB, i));
+    }
 
-        /* rough estimate of remaining index data */
-        asPositional -= (minusMaps * 4);
+    return matched;
+}
+
+uint64_t multiroarAndCount(const multiroar *a, const multiroar *b) {
+    if (!a || !b || !a->map || !b->map) {
+        return 0;
     }
 
-    /* add positional lookup bitmap overhead */
-    asPositional += divCeil(divCeil(highest, BITMAP_SIZE_IN_BITS), 8);
+    /* Walk the roar with fewer chunks, probe the other */
+    if (multimapCount(b->map) < multimapCount(a->map)) {
+        const multiroar *swap = a;
+        a = b;
+        b = swap;
+    }
 
-    printf("With positional encoding, it would use %" PRIu64
-           " bytes and be a savings "
-           "of %0.2f%%\n",
-           asPositional, (((double)b / asPositional) - 1) * 100);
+    uint64_t total = 0;
+    multimapIterator iter;
+    multimapIteratorInit(a->map, &iter, true);
+
+    databox keyValue[2];
+    databox *kvPtr[2] = {&keyValue[0], &keyValue[1]};
+    while (multimapIteratorNext(&iter, kvPtr)) {
+        databox bValue;
+        databox *bValues[] = {&bValue};
+        if (multimapLookup(b->map, &keyValue[0], bValues)) {
+            total += chunkAndCount(&keyValue[1], &bValue);
+        }
+    }
+
+    return total;
 }
 
-int multiroarTest(int argc, char *argv[]) {
-    (void)argc;
-    (void)argv;
+/* ====================================================================
+ * Chunk-Level Access
+ * ==================================================================== */
+_Static_assert(MULTIROAR_CHUNK_BITS == BITMAP_SIZE_IN_BITS,
+               "public chunk size must match the internal chunk size");
 
-    int err = 0;
+void multiroarChunkCursorInit(const multiroar *r, multiroarChunkCursor *c) {
+    c->roar = r;
+    c->chunkId = 0;
+    c->loaded = false;
+    c->done = !r || !r->map;
+    if (!c->done) {
+        multimapIteratorInit(r->map, &c->mapIter, true);
+    }
+}
 
-    TEST("create") {
-        multiroar *r = multiroarBitNew();
-        multiroarFree(r);
+/* Helper: load the next stored chunk into c->chunk */
+DK_STATIC bool chunkCursorLoad(multiroarChunkCursor *c) {
+    if (c->done) {
+        return false;
     }
 
-    TEST("set and get") {
-        multiroar *r = multiroarBitNew();
-        bool previouslySet = multiroarBitSet(r, 1700);
+    databox keyValue[2];
+    databox *kvPtr[2] = {&keyValue[0], &keyValue[1]};
+    if (!multimapIteratorNext(&c->mapIter, kvPtr)) {
+        c->done = true;
+        c->loaded = false;
+        return false;
+    }
 
-        if (previouslySet) {
-            ERRR("Detected previously set on new assignment!");
-        }
+    c->chunkId = keyValue[0].data.u;
+    c->chunk = keyValue[1];
+    c->loaded = true;
+    return true;
+}
 
-        bool currentlySet = multiroarBitGet(r, 1700);
+bool multiroarChunkCursorNext(multiroarChunkCursor *c, uint64_t *chunkId,
+                              uint8_t *bitmap) {
+    if (!c->loaded && !chunkCursorLoad(c)) {
+        return false;
+    }
 
-        if (!currentlySet) {
-            ERRR("Didn't find set bit after setting the bit!");
-        }
+    *chunkId = c->chunkId;
+    expandChunkToBitmap(&c->chunk, bitmap);
+    c->loaded = false;
+    return true;
+}
 
-        multiroarFree(r);
+bool multiroarChunkCursorSeek(multiroarChunkCursor *c, uint64_t chunkId,
+                              uint8_t *bitmap) {
+    while ((c->loaded || chunkCursorLoad(c)) && c->chunkId < chunkId) {
+        c->loaded = false;
     }
 
-    const int32_t lots = 72000;
+    if (c->loaded && c->chunkId == chunkId) {
+        expandChunkToBitmap(&c->chunk, bitmap);
+        c->loaded = false;
+        return true;
+    }
 
-#if 1
-    TEST_DESC("set and get (%d of random positions; individual roars)", lots) {
-        for (int32_t i = 0; i < lots; i++) {
-            const uint64_t position = (uint64_t)rand() % SIZE_MAX;
+    memset(bitmap, 0, BITMAP_SIZE_IN_BYTES);
+    return false;
+}
 
-            multiroar *r = multiroarBitNew();
+void multiroarChunkStore(multiroar *r, uint64_t chunkId,
+                          const uint8_t *bitmap) {
+    uint8_t chunk[CHUNK_ENCODE_BUFFER_BYTES];
+    const uint32_t len = encodeBitmapChunk(bitmap, chunk);
+    const databox key = {.data.u = chunkId, .type = DATABOX_UNSIGNED_64};
+    if (len == 0) {
+        multimapDelete(&r->map, &key);
+        return;
+    }
 
-            const bool previouslySet = multiroarBitSet(r, position);
+    /* Insert replaces an existing value for the same key */
+    storeEncodedChunk(r, &key, chunk, len, false);
+}
 
-            if (previouslySet) {
-                ERR("Detected previously set on new assignment at position "
-                    "%" PRIu64 "!",
-                    position);
-            }
+/* ====================================================================
+ * Frozen Format (read-only, zero-copy)
+ * ====================================================================
+ * Layout (header and directory integers little endian; payloads are copied
+ * as-is, so varintPacked13 position lists are in native byte order):
+ *   header (32 bytes):
+ *     [magic:4 "RFRZ"] [version:1] [flags:1] [reserved:2]
+ *     [chunkCount:8] [bitCount:8] [totalLen:8]
+ *   directory (chunkCount * 32 bytes, sorted by chunkId):
+ *     [chunkId:8] [rankBefore:8] [offset:8] [len:4] [population:4]
+ *   payloads:
+ *     each chunk blob exactly as stored in memory ([type:1] [data]), placed
+ *     at offset % 8 == 7 so chunk data is 8-byte aligned
+ *   tail padding (FROZEN_TAIL_PAD bytes):
+ *     varintPacked13 reads whole storage slots, which may extend past the
+ *     last packed byte of the final chunk
+ *
+ * Because payloads keep the in-memory chunk encodings, every chunk reader
+ * in this file works on a frozen chunk through a databox pointing into the
+ * buffer. ALL_0 chunks are never written. */
+#define FROZEN_MAGIC_0 'R'
+#define FROZEN_MAGIC_1 'F'
+#define FROZEN_MAGIC_2 'R'
+#define FROZEN_MAGIC_3 'Z'
+#define FROZEN_VERSION 1
+#define FROZEN_FLAGS_KNOWN 0x00 /* no flags defined by version 1 */
+#define FROZEN_HEADER_BYTES 32
+#define FROZEN_DIR_ENTRY_BYTES 32
+#define FROZEN_TAIL_PAD 8
+
+DK_STATIC inline uint64_t frozenLoad64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int32_t i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+
+    return v;
+}
 
-            const bool currentlySet = multiroarBitGet(r, position);
+DK_STATIC inline uint32_t frozenLoad32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
 
-            if (!currentlySet) {
-                ERR("Didn't find set bit after setting the bit at position "
-                    "%" PRIu64 "!",
-                    position);
-            }
+DK_STATIC inline void frozenStore64(uint8_t *p, uint64_t v) {
+    for (uint32_t i = 0; i < 8; i++) {
+        p[i] = (v >> (i * 8)) & 0xFF;
+    }
+}
 
-            multiroarFree(r);
-        }
+DK_STATIC inline void frozenStore32(uint8_t *p, uint32_t v) {
+    for (uint32_t i = 0; i < 4; i++) {
+        p[i] = (v >> (i * 8)) & 0xFF;
     }
+}
 
-    TEST_DESC("set and get (%d of (SMALL) random positions; common roar)",
-              lots) {
-        multiroar *r = multiroarBitNew();
-        uint64_t highest = 0;
-        for (int32_t i = 0; i < lots; i++) {
-            const uint64_t position = ((uint64_t)rand() % UINT16_MAX);
+DK_STATIC inline const uint8_t *frozenDirEntry(const multiroarFrozen *f,
+                                               uint64_t index) {
+    return f->buf + FROZEN_HEADER_BYTES + (index * FROZEN_DIR_ENTRY_BYTES);
+}
 
-            if (position > highest) {
-                highest = position;
-            }
+#define FROZEN_ENTRY_CHUNK_ID(e) frozenLoad64((e))
+#define FROZEN_ENTRY_RANK_BEFORE(e) frozenLoad64((e) + 8)
+#define FROZEN_ENTRY_OFFSET(e) frozenLoad64((e) + 16)
+#define FROZEN_ENTRY_LEN(e) frozenLoad32((e) + 24)
+#define FROZEN_ENTRY_POPULATION(e) frozenLoad32((e) + 28)
 
-            multiroarBitSet(r, position);
-            const bool currentlySet = multiroarBitGet(r, position);
+/* Payload offsets are chosen so (offset + 1) is 8-byte aligned */
+DK_STATIC inline uint64_t frozenAlignPayload(uint64_t offset) {
+    return ((offset + 1 + 7) & ~(uint64_t)7) - 1;
+}
 
-            if (!currentlySet) {
-                ERR("Didn't find set bit after setting the bit at position "
-                    "%" PRIu64 "!",
-                    position);
-            }
+DK_STATIC void frozenChunkAt(const multiroarFrozen *f, uint64_t index,
+                             databox *key, databox *value) {
+    const uint8_t *e = frozenDirEntry(f, index);
+
+    *key = (databox){.data.u = FROZEN_ENTRY_CHUNK_ID(e),
+                     .type = DATABOX_UNSIGNED_64};
+    *value = (databox){
+        .data.bytes.start = (uint8_t *)(f->buf + FROZEN_ENTRY_OFFSET(e)),
+        .len = FROZEN_ENTRY_LEN(e),
+        .type = DATABOX_BYTES};
+}
+
+/* Index of the first directory entry with chunkId >= 'chunkId' */
+DK_STATIC uint64_t frozenLowerBound(const multiroarFrozen *f,
+                                    uint64_t chunkId) {
+    uint64_t lo = 0;
+    uint64_t hi = f->chunkCount;
+    while (lo < hi) {
+        const uint64_t mid = lo + ((hi - lo) / 2);
+        if (FROZEN_ENTRY_CHUNK_ID(frozenDirEntry(f, mid)) < chunkId) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
-        multiroarRepr(r, highest);
-        multiroarTestCompare(r, highest);
-        multiroarFree(r);
     }
 
-    TEST_DESC("set and get (%d of (MEDIUM) random positions; common roar)",
-              lots) {
-        multiroar *r = multiroarBitNew();
-        uint64_t highest = 0;
-        for (int32_t i = 0; i < lots; i++) {
-            const uint64_t position = ((uint64_t)rand());
+    return lo;
+}
 
-            if (position > highest) {
-                highest = position;
-            }
+DK_STATIC bool frozenFindChunk(const multiroarFrozen *f, uint64_t chunkId,
+                               databox *value) {
+    const uint64_t idx = frozenLowerBound(f, chunkId);
+    if (idx >= f->chunkCount ||
+        FROZEN_ENTRY_CHUNK_ID(frozenDirEntry(f, idx)) != chunkId) {
+        return false;
+    }
 
-            multiroarBitSet(r, position);
-            const bool currentlySet = multiroarBitGet(r, position);
+    databox key;
+    frozenChunkAt(f, idx, &key, value);
+    return true;
+}
 
-            if (!currentlySet) {
-                ERR("Didn't find set bit after setting the bit at position "
-                    "%" PRIu64 "!",
-                    position);
+uint64_t multiroarFrozenSize(const multiroar *r) {
+    const uint64_t chunkCount = r && r->map ? multimapCount(r->map) : 0;
+    uint64_t size = FROZEN_HEADER_BYTES + (chunkCount * FROZEN_DIR_ENTRY_BYTES);
+
+    if (chunkCount) {
+        multimapIterator iter;
+        multimapIteratorInit(r->map, &iter, true);
+
+        databox keyValue[2];
+        databox *kvPtr[2] = {&keyValue[0], &keyValue[1]};
+        while (multimapIteratorNext(&iter, kvPtr)) {
+            if (GET_CHUNK_TYPE(&keyValue[1]) == CHUNK_TYPE_ALL_0) {
+                continue;
             }
+
+            size = frozenAlignPayload(size) + keyValue[1].len;
         }
-        multiroarTestCompare(r, highest);
-        multiroarFree(r);
     }
 
-    TEST_DESC("set and get (%d of (BIG) random positions; common roar)", lots) {
-        multiroar *r = multiroarBitNew();
-        uint64_t highest = 0;
-        for (int32_t i = 0; i < lots; i++) {
-            const uint64_t position = ((uint64_t)rand() * rand()) % SIZE_MAX;
+    return size + FROZEN_TAIL_PAD;
+}
 
-            if (position > highest) {
-                highest = position;
-            }
+uint64_t multiroarFreeze(const multiroar *r, void *buf, uint64_t bufSize) {
+    const uint64_t size = multiroarFrozenSize(r);
+    if (!buf || bufSize < size) {
+        return 0;
+    }
 
-            multiroarBitSet(r, position);
-            const bool currentlySet = multiroarBitGet(r, position);
+    uint8_t *out = buf;
+    memset(out, 0, size);
 
-            if (!currentlySet) {
-                ERR("Didn't find set bit after setting the bit at position "
-                    "%" PRIu64 "!",
-                    position);
-            }
-        }
-        multiroarTestCompare(r, highest);
-        multiroarFree(r);
-    }
-#endif
+    uint64_t chunkCount = 0;
+    uint64_t bitCount = 0;
+    const uint64_t mapCount = r && r->map ? multimapCount(r->map) : 0;
+    uint64_t offset = FROZEN_HEADER_BYTES + (mapCount * FROZEN_DIR_ENTRY_BYTES);
 
-    TEST_DESC("set and get (%d of sequential positions; common roar)", lots) {
-        multiroar *r = multiroarBitNew();
-        for (int32_t i = 0; i < lots; i++) {
-            const bool previouslySet = multiroarBitSet(r, i);
-            if (previouslySet) {
-                ERR("Detected previously set on new assignment at position %d!",
-                    i);
+    if (mapCount) {
+        multimapIterator iter;
+        multimapIteratorInit(r->map, &iter, true);
+
+        databox keyValue[2];
+        databox *kvPtr[2] = {&keyValue[0], &keyValue[1]};
+        while (multimapIteratorNext(&iter, kvPtr)) {
+            const databox *value = &keyValue[1];
+            if (GET_CHUNK_TYPE(value) == CHUNK_TYPE_ALL_0) {
+                continue;
             }
 
-            const bool currentlySet = multiroarBitGet(r, i);
+            const uint64_t population = countBitsInChunk(value);
+            uint8_t *e = out + FROZEN_HEADER_BYTES +
+                         (chunkCount * FROZEN_DIR_ENTRY_BYTES);
 
-            if (!currentlySet) {
-                ERR("Didn't find set bit after setting the bit at position %d!",
-                    i);
-            }
+            offset = frozenAlignPayload(offset);
+            frozenStore64(e, keyValue[0].data.u);
+            frozenStore64(e + 8, bitCount);
+            frozenStore64(e + 16, offset);
+            frozenStore32(e + 24, value->len);
+            frozenStore32(e + 28, population);
+            memcpy(out + offset, value->data.bytes.start, value->len);
+
+            offset += value->len;
+            bitCount += population;
+            chunkCount++;
         }
-        multiroarRepr(r, lots - 1);
-        multiroarTestCompare(r, lots - 1);
-        multiroarFree(r);
     }
 
-    TEST("chunk boundary correctness") {
-        /* Test bits at and around chunk boundaries (8192 bits per chunk) */
-        multiroar *r = multiroarBitNew();
-        const uint64_t boundaries[] = {0,     8191,  8192,  8193,  16383,
-                                       16384, 16385, 24575, 24576, 24577};
-        const uint64_t numBoundaries =
-            sizeof(boundaries) / sizeof(boundaries[0]);
+    /* Skipped ALL_0 chunks leave unused directory slots; they're zeroed
+     * padding before the first payload and aren't referenced. */
+    out[0] = FROZEN_MAGIC_0;
+    out[1] = FROZEN_MAGIC_1;
+    out[2] = FROZEN_MAGIC_2;
+    out[3] = FROZEN_MAGIC_3;
+    out[4] = FROZEN_VERSION;
+    frozenStore64(out + 8, chunkCount);
+    frozenStore64(out + 16, bitCount);
+    frozenStore64(out + 24, size);
 
-        /* Set all boundary bits */
-        for (uint64_t i = 0; i < numBoundaries; i++) {
-            multiroarBitSet(r, boundaries[i]);
-        }
+    return size;
+}
 
-        /* Verify all boundary bits are set */
-        for (uint64_t i = 0; i < numBoundaries; i++) {
-            if (!multiroarBitGet(r, boundaries[i])) {
-                ERR("Boundary bit %" PRIu64 " not set!", boundaries[i]);
-            }
-        }
+/* Verify one chunk blob is self-consistent with its directory population,
+ * so the chunk readers never step outside of it. */
+DK_STATIC bool frozenChunkValid(const uint8_t *chunk, uint32_t len,
+                                uint32_t population) {
+    if (len == 0 || population > BITMAP_SIZE_IN_BITS) {
+        return false;
+    }
 
-        /* Verify bits between boundaries are NOT set */
-        if (multiroarBitGet(r, 100)) {
-            ERRR("Bit 100 should not be set!");
+    switch (chunk[0]) {
+    case CHUNK_TYPE_ALL_1:
+        return len == 1 && population == BITMAP_SIZE_IN_BITS;
+    case CHUNK_TYPE_FULL_BITMAP:
+        return len == 1 + BITMAP_SIZE_IN_BYTES;
+    case CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS:
+    case CHUNK_TYPE_OVER_FULL_DIRECT_NOT_SET_POSITION_NUMBERS: {
+        if (len < 2) {
+            return false;
         }
-        if (multiroarBitGet(r, 8100)) {
-            ERRR("Bit 8100 should not be set!");
+
+        const uint32_t countLen = varintTaggedGetLenQuick_(chunk + 1);
+        if (1 + countLen > len) {
+            return false;
         }
-        if (multiroarBitGet(r, 16000)) {
-            ERRR("Bit 16000 should not be set!");
+
+        const uint64_t count = varintTaggedGet64Quick_(chunk + 1);
+        if (count > BITMAP_SIZE_IN_BITS ||
+            1 + countLen + (((count * 13) + 7) / 8) > len) {
+            return false;
         }
 
-        multiroarFree(r);
+        return chunk[0] == CHUNK_TYPE_UNDER_FULL_DIRECT_POSITION_NUMBERS
+                   ? population == count
+                   : population == BITMAP_SIZE_IN_BITS - count;
     }
+    case CHUNK_TYPE_RUNS: {
+        if (len < RUN_HEADER_BYTES) {
+            return false;
+        }
 
-    TEST("sequential set up to bitmap conversion threshold") {
-        /* Test setting many bits sequentially triggers bitmap conversion
-         * and continues to work correctly */
-        multiroar *r = multiroarBitNew();
-        const uint64_t testCount =
-            1000; /* Well above 629 conversion threshold */
-
-        for (uint64_t i = 0; i < testCount; i++) {
-            multiroarBitSet(r, i);
-            if (!multiroarBitGet(r, i)) {
-                ERR("Bit %" PRIu64 " NOT SET immediately after setting!", i);
-            }
+        const uint32_t count = runLoad16(chunk + 1);
+        if (count > MAX_RUNS_PER_CHUNK ||
+            len != RUN_HEADER_BYTES + (count * RUN_BYTES)) {
+            return false;
         }
 
-        /* Verify all bits are still set */
-        for (uint64_t i = 0; i < testCount; i++) {
-            if (!multiroarBitGet(r, i)) {
-                ERR("Bit %" PRIu64 " lost after all sets!", i);
+        const uint8_t *runsStart = chunk + RUN_HEADER_BYTES;
+        uint32_t total = 0;
+        int32_t prevLast = -1;
+        for (uint32_t i = 0; i < count; i++) {
+            const uint16_t start = runStartAt(runsStart, i);
+            const uint16_t last = runLastAt(runsStart, i);
+            if ((int32_t)start <= prevLast || last < start ||
+                last >= BITMAP_SIZE_IN_BITS) {
+                return false;
             }
+
+            total += (uint32_t)(last - start) + 1;
+            prevLast = last;
         }
 
-        multiroarFree(r);
+        return total == population;
     }
-
-    TEST("conversion from UNDER_FULL to FULL_BITMAP") {
-        /* Test that conversion to full bitmap preserves all bits */
-        multiroar *r = multiroarBitNew();
-        const uint64_t maxDirect = 629; /* MAX_ENTRIES_PER_DIRECT_LISTING */
-
-        /* Set exactly maxDirect positions to trigger conversion to bitmap */
-        uint64_t *positions = zcalloc(maxDirect, sizeof(uint64_t));
-        for (uint64_t i = 0; i < maxDirect; i++) {
-            positions[i] = i * 10; /* Spread positions to stay in one chunk */
-            multiroarBitSet(r, positions[i]);
-        }
-
-        /* Verify all positions are still set after potential conversion */
-        for (uint64_t i = 0; i < maxDirect; i++) {
-            if (!multiroarBitGet(r, positions[i])) {
-                ERR("Position %" PRIu64 " lost after bitmap conversion!",
-                    positions[i]);
-            }
-        }
-
-        /* Verify non-set positions are not set */
-        for (uint64_t i = 0; i < maxDirect - 1; i++) {
-            for (uint64_t j = positions[i] + 1; j < positions[i + 1]; j++) {
-                if (multiroarBitGet(r, j)) {
-                    ERR("Position %" PRIu64 " incorrectly set!", j);
-                }
-            }
-        }
-
-        zfree(positions);
-        multiroarFree(r);
+    default:
+        return false;
     }
+}
 
-    TEST("bitmap mode with various positions") {
-        /* Test that bitmap mode (> 629 positions) works correctly */
-        multiroar *r = multiroarBitNew();
-
-        /* Set positions to trigger bitmap mode, then verify */
-        const uint64_t positions[] = {0,    100,  200,  300,  400,  500,
-                                      600,  700,  800,  900,  1000, 1500,
-                                      2000, 2500, 3000, 3500, 4000, 4500,
-                                      5000, 5500, 6000, 6500, 7000};
-        const uint64_t numPositions = sizeof(positions) / sizeof(positions[0]);
+bool multiroarFrozenOpen(multiroarFrozen *f, const void *buf, uint64_t len) {
+    const uint8_t *p = buf;
 
-        /* First, fill up to trigger bitmap conversion */
-        for (uint64_t i = 0; i < 700; i++) {
-            multiroarBitSet(r, i);
-        }
+    if (!f || !p || len < FROZEN_HEADER_BYTES + FROZEN_TAIL_PAD) {
+        return false;
+    }
 
-        /* Set some additional positions */
-        for (uint64_t i = 0; i < numPositions; i++) {
-            multiroarBitSet(r, positions[i]);
-        }
+    if (p[0] != FROZEN_MAGIC_0 || p[1] != FROZEN_MAGIC_1 ||
+        p[2] != FROZEN_MAGIC_2 || p[3] != FROZEN_MAGIC_3 ||
+        p[4] != FROZEN_VERSION) {
+        return false;
+    }
 
-        /* Verify the specific positions are set */
-        for (uint64_t i = 0; i < numPositions; i++) {
-            if (!multiroarBitGet(r, positions[i])) {
-                ERR("Position %" PRIu64 " not set!", positions[i]);
-            }
-        }
+    /* Reject flags this version doesn't know and non-zero reserved bytes,
+     * so later versions can give them meaning without old readers
+     * misinterpreting the image. */
+    if ((p[5] & ~FROZEN_FLAGS_KNOWN) || p[6] || p[7]) {
+        return false;
+    }
 
-        /* Verify positions outside our set are not set */
-        if (multiroarBitGet(r, 7500)) {
-            ERRR("Position 7500 should not be set!");
-        }
+    const uint64_t chunkCount = frozenLoad64(p + 8);
+    const uint64_t bitCount = frozenLoad64(p + 16);
+    const uint64_t totalLen = frozenLoad64(p + 24);
 
-        multiroarFree(r);
+    /* 'len' may be larger (e.g. a page-rounded mapping), never smaller */
+    if (totalLen > len ||
+        totalLen < FROZEN_HEADER_BYTES + FROZEN_TAIL_PAD ||
+        chunkCount > (totalLen - FROZEN_HEADER_BYTES - FROZEN_TAIL_PAD) /
+                         FROZEN_DIR_ENTRY_BYTES) {
+        return false;
     }
 
-    TEST("multi-chunk correctness") {
-        /* Create roar with multiple chunks */
-        multiroar *r = multiroarBitNew();
-        const uint64_t chunkBits = 8192;
+    const uint64_t dirEnd =
+        FROZEN_HEADER_BYTES + (chunkCount * FROZEN_DIR_ENTRY_BYTES);
+    const uint64_t payloadLimit = totalLen - FROZEN_TAIL_PAD;
 
-        /* Chunk 0: sparse (few bits) */
-        multiroarBitSet(r, 100);
-        multiroarBitSet(r, 200);
-        multiroarBitSet(r, 300);
+    multiroarFrozen view = {
+        .buf = p, .len = totalLen, .chunkCount = chunkCount};
 
-        /* Chunk 1: moderately filled */
-        for (uint64_t i = chunkBits; i < chunkBits + 500; i++) {
-            multiroarBitSet(r, i);
-        }
+    uint64_t rank = 0;
+    for (uint64_t i = 0; i < chunkCount; i++) {
+        const uint8_t *e = frozenDirEntry(&view, i);
+        const uint64_t offset = FROZEN_ENTRY_OFFSET(e);
+        const uint32_t chunkLen = FROZEN_ENTRY_LEN(e);
+        const uint32_t population = FROZEN_ENTRY_POPULATION(e);
 
-        /* Chunk 2: also moderately filled */
-        for (uint64_t i = chunkBits * 2; i < chunkBits * 2 + 1000; i++) {
-            multiroarBitSet(r, i);
+        if (i > 0 && FROZEN_ENTRY_CHUNK_ID(e) <=
+                         FROZEN_ENTRY_CHUNK_ID(frozenDirEntry(&view, i - 1))) {
+            return false;
         }
 
-        /* Verify chunk 0 (sparse) */
-        if (!multiroarBitGet(r, 100) || !multiroarBitGet(r, 200) ||
-            !multiroarBitGet(r, 300)) {
-            ERRR("Sparse chunk bits not set!");
-        }
-        if (multiroarBitGet(r, 150)) {
-            ERRR("Unset bit in sparse chunk incorrectly set!");
+        if (FROZEN_ENTRY_RANK_BEFORE(e) != rank || offset < dirEnd ||
+            offset > payloadLimit || chunkLen > payloadLimit - offset) {
+            return false;
         }
 
-        /* Verify chunk 1 */
-        for (uint64_t i = chunkBits; i < chunkBits + 500; i++) {
-            if (!multiroarBitGet(r, i)) {
-                ERR("Bit %" PRIu64 " in chunk 1 should be set!", i);
-            }
+        if (!frozenChunkValid(p + offset, chunkLen, population)) {
+            return false;
         }
 
-        /* Verify chunk 2 */
-        for (uint64_t i = chunkBits * 2; i < chunkBits * 2 + 1000; i++) {
-            if (!multiroarBitGet(r, i)) {
-                ERR("Bit %" PRIu64 " in chunk 2 should be set!", i);
-            }
-        }
-        if (multiroarBitGet(r, chunkBits * 2 + 1500)) {
-            ERRR("Unset bit in chunk 2 incorrectly set!");
-        }
+        rank += population;
+    }
 
-        multiroarFree(r);
+    if (rank != bitCount) {
+        return false;
     }
 
-    TEST("high-scale stress test (100K random bits)") {
-        multiroar *r = multiroarBitNew();
-        const uint64_t scale = 100000;
-        const uint64_t sampleSize = 10000; /* Track a sample for verification */
-        uint64_t *sampleBits = zcalloc(sampleSize, sizeof(uint64_t));
+    view.bitCount = bitCount;
+    *f = view;
+    return true;
+}
 
-        /* Set random bits, tracking a sample for verification */
-        for (uint64_t i = 0; i < scale; i++) {
-            const uint64_t position =
-                ((uint64_t)rand() * rand()) % (SIZE_MAX / 2);
+bool multiroarFrozenBitGet(const multiroarFrozen *f, uint64_t position) {
+    databox value;
+    if (!f || !frozenFindChunk(f, CHUNK(position), &value)) {
+        return false;
+    }
 
-            /* Track every Nth position for verification */
-            if (i < sampleSize) {
-                sampleBits[i] = position;
-            }
+    return chunkValueContains(&value, OFFSET(position));
+}
 
-            multiroarBitSet(r, position);
+uint64_t multiroarFrozenBitCount(const multiroarFrozen *f) {
+    return f ? f->bitCount : 0;
+}
 
-            /* Verify immediately after set */
-            if (!multiroarBitGet(r, position)) {
-                ERR("High-scale: bit %" PRIu64
-                    " not set immediately after setting!",
-                    position);
-            }
-        }
+uint64_t multiroarFrozenRank(const multiroarFrozen *f, uint64_t position) {
+    if (!f) {
+        return 0;
+    }
 
-        /* Verify sample bits are still set after all operations */
-        uint64_t verified = 0;
-        for (uint64_t i = 0; i < sampleSize; i++) {
-            if (multiroarBitGet(r, sampleBits[i])) {
-                verified++;
-            } else {
-                ERR("High-scale: sample bit %" PRIu64 " not set!",
-                    sampleBits[i]);
-            }
-        }
+    const uint64_t idx = frozenLowerBound(f, CHUNK(position));
+    if (idx >= f->chunkCount) {
+        return f->bitCount;
+    }
 
-        if (verified != sampleSize) {
-            ERR("High-scale: only %" PRIu64 " of %" PRIu64
-                " sample bits verified!",
-                verified, sampleSize);
-        }
+    databox key;
+    databox value;
+    frozenChunkAt(f, idx, &key, &value);
 
-        zfree(sampleBits);
-        multiroarFree(r);
+    const uint64_t rankBefore =
+        FROZEN_ENTRY_RANK_BEFORE(frozenDirEntry(f, idx));
+    if (key.data.u != CHUNK(position)) {
+        return rankBefore;
     }
 
-    TEST("set same bit twice returns correct previouslySet") {
-        multiroar *r = multiroarBitNew();
+    return rankBefore + rankInChunk(&value, OFFSET(position));
+}
 
-        bool first = multiroarBitSet(r, 12345);
-        if (first) {
-            ERRR("First set should return false for previouslySet!");
-        }
+void multiroarFrozenIteratorInit(const multiroarFrozen *f,
+                                 multiroarIterator *iter) {
+    if (!iter) {
+        return;
+    }
 
-        bool second = multiroarBitSet(r, 12345);
-        if (!second) {
-            ERRR("Second set should return true for previouslySet!");
-        }
+    multiroarIteratorInit(NULL, iter);
+    if (!f) {
+        return;
+    }
 
-        /* Verify bit is still set */
-        if (!multiroarBitGet(r, 12345)) {
-            ERRR("Bit should remain set after double set!");
-        }
+    iter->frozen = f;
+    iter->valid = true;
+}
 
-        multiroarFree(r);
+void multiroarOrFrozen(multiroar *r, const multiroarFrozen *f) {
+    if (!r || !f) {
+        return;
     }
 
-    TEST("PERF: sequential insert performance") {
-        const uint64_t scale = 100000;
-        multiroar *r = multiroarBitNew();
+    /* Each frozen chunk is OR'd straight out of the buffer */
+    for (uint64_t i = 0; i < f->chunkCount; i++) {
+        databox key;
+        databox value;
+        frozenChunkAt(f, i, &key, &value);
+        orChunkInto(r, &key, &value);
+    }
+}
 
-        int64_t startNs = timeUtilMonotonicNs();
-        for (uint64_t i = 0; i < scale; i++) {
-            multiroarBitSet(r, i);
-        }
-        int64_t elapsed = timeUtilMonotonicNs() - startNs;
-        printf("Sequential insert: %.1f ns/op, %.0f ops/sec\n",
-               (double)elapsed / scale, scale / (elapsed / 1e9));
+void multiroarAndFrozen(multiroar *r, const multiroarFrozen *f) {
+    if (!r || !f) {
+        return;
+    }
 
-        multiroarFree(r);
+    const uint64_t numChunks = multimapCount(r->map);
+    if (numChunks == 0) {
+        return;
     }
 
-    TEST("PERF: random insert performance") {
-        const uint64_t scale = 100000;
-        multiroar *r = multiroarBitNew();
+    /* Collect r's keys first since andChunkWith() mutates r->map */
+    uint64_t *chunkKeys = zmalloc(numChunks * sizeof(uint64_t));
+    uint64_t keyCount = 0;
 
-        int64_t startNs = timeUtilMonotonicNs();
-        for (uint64_t i = 0; i < scale; i++) {
-            multiroarBitSet(r, ((uint64_t)rand() * rand()) % (SIZE_MAX / 2));
-        }
-        int64_t elapsed = timeUtilMonotonicNs() - startNs;
-        printf("Random insert: %.1f ns/op, %.0f ops/sec\n",
-               (double)elapsed / scale, scale / (elapsed / 1e9));
+    multimapIterator iter;
+    multimapIteratorInit(r->map, &iter, true);
 
-        multiroarFree(r);
+    databox keyStorage[2];
+    databox *keyPtr[2] = {&keyStorage[0], &keyStorage[1]};
+    while (multimapIteratorNext(&iter, keyPtr)) {
+        chunkKeys[keyCount++] = keyStorage[0].data.u;
     }
 
-    TEST("PERF: lookup performance (dense)") {
-        const uint64_t scale = 100000;
-        multiroar *r = multiroarBitNew();
-
-        /* Create dense bitmap */
-        for (uint64_t i = 0; i < scale; i++) {
-            multiroarBitSet(r, i);
-        }
+    for (uint64_t i = 0; i < keyCount; i++) {
+        databox key = {.data.u = chunkKeys[i], .type = DATABOX_UNSIGNED_64};
+        databox fValue;
+        const bool fHasChunk = frozenFindChunk(f, chunkKeys[i], &fValue);
+        andChunkWith(r, &key, fHasChunk ? &fValue : NULL);
+    }
 
-        int64_t startNs = timeUtilMonotonicNs();
-        for (uint64_t i = 0; i < scale; i++) {
-            multiroarBitGet(r, i);
-        }
-        int64_t elapsed = timeUtilMonotonicNs() - startNs;
-        printf("Dense lookup: %.1f ns/op, %.0f ops/sec\n",
-               (double)elapsed / scale, scale / (elapsed / 1e9));
+    zfree(chunkKeys);
+}
 
-        multiroarFree(r);
-    }
+/* ====================================================================
+ * Testing
+ * ==================================================================== */
 
-    /* ================================================================
-     * Edge Case and Boundary Tests
-     * ================================================================ */
+#ifdef DATAKIT_TEST
 
-    TEST("UNDER_FULL growth to exactly MAX_ENTRIES") {
-        /* Test growth from 1 to exactly 629 entries (conversion threshold) */
-        multiroar *r = multiroarBitNew();
-        const uint64_t maxDirect = 629; /* MAX_ENTRIES_PER_DIRECT_LISTING */
+#include "ctest.h"
+#include "timeUtil.h"
 
-        /* Insert exactly 628 entries (one below threshold) */
-        for (uint64_t i = 0; i < maxDirect - 1; i++) {
-            multiroarBitSet(r, i * 13); /* Spread to stay in one chunk */
+void multiroarRepr(multiroar *r, uint64_t highest) {
+    for (uint64_t i = 0; i < divCeil(highest, BITMAP_SIZE_IN_BITS); i++) {
+        databox value;
+        databox *values[1] = {&value};
+        if (multimapLookup(r->map,
+                           &(databox){.data.u = i, .type = DATABOX_UNSIGNED_64},
+                           values)) {
+            printf("[%" PRIu64 "] = %d (%" PRIu64 " byte%s)\n", i,
+                   GET_CHUNK_TYPE(&value), value.len,
+                   value.len == 1 ? "" : "s");
         }
+    }
+}
 
-        /* Verify all are still set (should still be UNDER_FULL) */
-        for (uint64_t i = 0; i < maxDirect - 1; i++) {
-            if (!multiroarBitGet(r, i * 13)) {
-                ERR("Position %" PRIu64 " not set before threshold!", i * 13);
-            }
-        }
+void multiroarTestCompare(multiroar *r, uint64_t highest) {
+    const uint64_t b = multimapBytes(r->map);
+    printf("Final size: %" PRIu64 " bytes; Highest bit set: %" PRIu64
+           "; Size if linear: %" PRIu64 " "
+           "bytes; Savings: %.2fx\n",
+           b, highest, highest / 8, ((float)(highest / 8) / b) - 1);
 
-        /* Insert the 629th entry - triggers conversion to FULL_BITMAP */
-        multiroarBitSet(r, (maxDirect - 1) * 13);
+    const uint64_t maps = multimapCount(r->map);
+    uint64_t asPositional = b;
+    uint64_t minusMaps = maps;
+    if (maps <= 255) {
+        asPositional -= (maps * 3);
+        minusMaps -= maps;
+    } else {
+        asPositional -= (255 * 3);
+        minusMaps -= 255;
 
-        /* Verify all entries including the new one */
-        for (uint64_t i = 0; i < maxDirect; i++) {
-            if (!multiroarBitGet(r, i * 13)) {
-                ERR("Position %" PRIu64 " not set after conversion!", i * 13);
-            }
-        }
+        /* rough estimate of remaining index data */
+        asPositional -= (minusMaps * 4);
+    }
 
-        multiroarFree(r);
+    /* add positional lookup bitmap overhead */
+    asPositional += divCeil(divCeil(highest, BITMAP_SIZE_IN_BITS), 8);
+
+    printf("With positional encoding, it would use %" PRIu64
+           " bytes and be a savings "
+           "of %0.2f%%\n",
+           asPositional, (((double)b / asPositional) - 1) * 100);
+}
+
+/* Encoding of chunk 'chunkId' (CHUNK_TYPE_ALL_0 if absent) */
+static uint8_t multiroarTestChunkType(const multiroar *r, uint64_t chunkId) {
+    databox value;
+    databox *values[1] = {&value};
+    if (multimapLookup(
+            r->map, &(databox){.data.u = chunkId, .type = DATABOX_UNSIGNED_64},
+            values)) {
+        return GET_CHUNK_TYPE(&value);
     }
 
-    TEST("FULL_BITMAP exact boundary positions") {
-        /* Test bits at exact byte and word boundaries within bitmap */
-        multiroar *r = multiroarBitNew();
+    return CHUNK_TYPE_ALL_0;
+}
 
-        /* Fill to get into bitmap mode */
-        for (uint64_t i = 0; i < 700; i++) {
-            multiroarBitSet(r, i);
-        }
+/* Roar with one chunk of every encoding, spread over sparse chunk ids */
+static multiroar *multiroarTestFrozenSource(uint64_t seed[2]) {
+    multiroar *r = multiroarBitNew();
+    const uint64_t chunkIds[] = {0, 1, 3, 7, 64, 65, 1000, 123456};
 
-        /* Test byte boundary positions: 0, 7, 8, 15, 16, ... */
-        const uint64_t byteBoundaries[] = {0,   7,   8,   15,  16, 23,
-                                           24,  31,  32,  63,  64, 127,
-                                           128, 255, 256, 511, 512};
-        for (uint64_t i = 0;
-             i < sizeof(byteBoundaries) / sizeof(byteBoundaries[0]); i++) {
-            uint64_t pos = byteBoundaries[i];
-            if (pos < 700) {
-                if (!multiroarBitGet(r, pos)) {
-                    ERR("Byte boundary position %" PRIu64 " should be set!",
-                        pos);
-                }
+    for (uint32_t c = 0; c < sizeof(chunkIds) / sizeof(*chunkIds); c++) {
+        const uint64_t base = chunkIds[c] * BITMAP_SIZE_IN_BITS;
+        switch (c % 5) {
+        case 0: /* UNDER_FULL */
+            for (int k = 0; k < 300; k++) {
+                multiroarBitSet(r, base + (xoroshiro128plus(seed) % 8192));
             }
-        }
-
-        /* Test 64-bit word boundary positions */
-        const uint64_t wordBoundaries[] = {63,  64,  127, 128, 191, 192,
-                                           255, 256, 319, 320, 383, 384,
-                                           447, 448, 511, 512};
-        for (uint64_t i = 0;
-             i < sizeof(wordBoundaries) / sizeof(wordBoundaries[0]); i++) {
-            uint64_t pos = wordBoundaries[i];
-            if (pos < 700) {
-                if (!multiroarBitGet(r, pos)) {
-                    ERR("Word boundary position %" PRIu64 " should be set!",
-                        pos);
+            break;
+        case 1: /* RUNS */
+            for (int k = 0; k < 20; k++) {
+                multiroarBitSetRange(r, base + (xoroshiro128plus(seed) % 8000),
+                                     1 + (xoroshiro128plus(seed) % 150));
+            }
+            break;
+        case 2: /* FULL_BITMAP */
+            for (int k = 0; k < 3000; k++) {
+                multiroarBitSet(r, base + (xoroshiro128plus(seed) % 8192));
+            }
+            break;
+        case 3: /* ALL_1 */
+            multiroarBitSetRange(r, base, BITMAP_SIZE_IN_BITS);
+            break;
+        case 4: /* OVER_FULL */
+            for (uint64_t k = 0; k < BITMAP_SIZE_IN_BITS; k++) {
+                if (k % 97) {
+                    multiroarBitSet(r, base + k);
                 }
             }
+            break;
         }
+    }
+
+    return r;
+}
+
+int multiroarTest(int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int err = 0;
 
+    TEST("create") {
+        multiroar *r = multiroarBitNew();
         multiroarFree(r);
     }
 
-    TEST("sparse positions across chunk boundary") {
-        /* Test sparse positions that span multiple chunks */
+    TEST("set and get") {
         multiroar *r = multiroarBitNew();
-        const uint64_t chunkBits = 8192;
-
-        /* Set sparse positions across 4 chunks */
-        const uint64_t positions[] = {
-            0,
-            100,
-            1000, /* Chunk 0 */
-            chunkBits + 50,
-            chunkBits + 500, /* Chunk 1 */
-            chunkBits * 2 + 1,
-            chunkBits * 2 + 999, /* Chunk 2 */
-            chunkBits * 3 + 8191 /* Chunk 3, last bit */
-        };
-        const uint64_t numPositions = sizeof(positions) / sizeof(positions[0]);
+        bool previouslySet = multiroarBitSet(r, 1700);
 
-        for (uint64_t i = 0; i < numPositions; i++) {
-            multiroarBitSet(r, positions[i]);
+        if (previouslySet) {
+            ERRR("Detected previously set on new assignment!");
         }
 
-        /* Verify all positions */
-        for (uint64_t i = 0; i < numPositions; i++) {
-            if (!multiroarBitGet(r, positions[i])) {
-                ERR("Sparse cross-chunk position %" PRIu64 " not set!",
-                    positions[i]);
-            }
-        }
+        bool currentlySet = multiroarBitGet(r, 1700);
 
-        /* Verify positions between are NOT set */
-        if (multiroarBitGet(r, 50)) {
-            ERRR("Position 50 should not be set!");
-        }
-        if (multiroarBitGet(r, chunkBits + 100)) {
-            ERRR("Position in chunk 1 should not be set!");
+        if (!currentlySet) {
+            ERRR("Didn't find set bit after setting the bit!");
         }
 
         multiroarFree(r);
     }
 
-    TEST("set and immediate re-read in UNDER_FULL mode") {
-        /* Test that set followed by immediate get works in UNDER_FULL */
-        multiroar *r = multiroarBitNew();
+    const int32_t lots = 72000;
 
-        /* Set and verify in sequence, staying in UNDER_FULL mode */
-        for (uint64_t i = 0; i < 100; i++) {
-            uint64_t pos = i * 100; /* Spread positions */
-            multiroarBitSet(r, pos);
+#if 1
+    TEST_DESC("set and get (%d of random positions; individual roars)", lots) {
+        for (int32_t i = 0; i < lots; i++) {
+            const uint64_t position = (uint64_t)rand() % SIZE_MAX;
 
-            /* Immediate verification */
-            if (!multiroarBitGet(r, pos)) {
-                ERR("UNDER_FULL: position %" PRIu64 " not set immediately!",
-                    pos);
+            multiroar *r = multiroarBitNew();
+
+            const bool previouslySet = multiroarBitSet(r, position);
+
+            if (previouslySet) {
+                ERR("Detected previously set on new assignment at position "
+                    "%" PRIu64 "!",
+                    position);
             }
 
-            /* Verify previously set positions still exist */
-            for (uint64_t j = 0; j <= i; j++) {
-                if (!multiroarBitGet(r, j * 100)) {
-                    ERR("UNDER_FULL: earlier position %" PRIu64 " lost!",
-                        j * 100);
-                }
+            const bool currentlySet = multiroarBitGet(r, position);
+
+            if (!currentlySet) {
+                ERR("Didn't find set bit after setting the bit at position "
+                    "%" PRIu64 "!",
+                    position);
             }
-        }
 
-        multiroarFree(r);
+            multiroarFree(r);
+        }
     }
 
-    TEST("set and immediate re-read in FULL_BITMAP mode") {
-        /* Test that set followed by immediate get works in FULL_BITMAP */
+    TEST_DESC("set and get (%d of (SMALL) random positions; common roar)",
+              lots) {
         multiroar *r = multiroarBitNew();
+        uint64_t highest = 0;
+        for (int32_t i = 0; i < lots; i++) {
+            const uint64_t position = ((uint64_t)rand() % UINT16_MAX);
 
-        /* First, fill to trigger bitmap mode */
-        for (uint64_t i = 0; i < 700; i++) {
-            multiroarBitSet(r, i);
-        }
+            if (position > highest) {
+                highest = position;
+            }
 
-        /* Now set additional positions and verify immediately */
-        for (uint64_t i = 700; i < 1000; i++) {
-            multiroarBitSet(r, i);
+            multiroarBitSet(r, position);
+            const bool currentlySet = multiroarBitGet(r, position);
 
-            if (!multiroarBitGet(r, i)) {
-                ERR("FULL_BITMAP: position %" PRIu64 " not set immediately!",
-                    i);
+            if (!currentlySet) {
+                ERR("Didn't find set bit after setting the bit at position "
+                    "%" PRIu64 "!",
+                    position);
             }
         }
+        multiroarRepr(r, highest);
+        multiroarTestCompare(r, highest);
+        multiroarFree(r);
+    }
 
-        /* Verify all positions are still set */
-        for (uint64_t i = 0; i < 1000; i++) {
-            if (!multiroarBitGet(r, i)) {
-                ERR("FULL_BITMAP: position %" PRIu64 " lost!", i);
+    TEST_DESC("set and get (%d of (MEDIUM) random positions; common roar)",
+              lots) {
+        multiroar *r = multiroarBitNew();
+        uint64_t highest = 0;
+        for (int32_t i = 0; i < lots; i++) {
+            const uint64_t position = ((uint64_t)rand());
+
+            if (position > highest) {
+                highest = position;
             }
-        }
 
+            multiroarBitSet(r, position);
+            const bool currentlySet = multiroarBitGet(r, position);
+
+            if (!currentlySet) {
+                ERR("Didn't find set bit after setting the bit at position "
+                    "%" PRIu64 "!",
+                    position);
+            }
+        }
+        multiroarTestCompare(r, highest);
         multiroarFree(r);
     }
 
-    TEST("previouslySet behavior across all chunk types") {
+    TEST_DESC("set and get (%d of (BIG) random positions; common roar)", lots) {
         multiroar *r = multiroarBitNew();
+        uint64_t highest = 0;
+        for (int32_t i = 0; i < lots; i++) {
+            const uint64_t position = ((uint64_t)rand() * rand()) % SIZE_MAX;
 
-        /* Test in UNDER_FULL mode */
-        bool prev = multiroarBitSet(r, 100);
-        if (prev) {
-            ERRR("UNDER_FULL: first set should return false!");
-        }
-        prev = multiroarBitSet(r, 100);
-        if (!prev) {
-            ERRR("UNDER_FULL: second set should return true!");
-        }
-
-        /* Fill to get into FULL_BITMAP mode */
-        for (uint64_t i = 0; i < 700; i++) {
-            multiroarBitSet(r, i);
-        }
+            if (position > highest) {
+                highest = position;
+            }
 
-        /* Test in FULL_BITMAP mode with new position */
-        prev = multiroarBitSet(r, 5000);
-        if (prev) {
-            ERRR("FULL_BITMAP: first set of new pos should return false!");
-        }
-        prev = multiroarBitSet(r, 5000);
-        if (!prev) {
-            ERRR("FULL_BITMAP: second set should return true!");
-        }
+            multiroarBitSet(r, position);
+            const bool currentlySet = multiroarBitGet(r, position);
 
-        /* Test in FULL_BITMAP mode with existing position */
-        prev = multiroarBitSet(r, 100); /* Was set earlier */
-        if (!prev) {
-            ERRR("FULL_BITMAP: set of existing pos should return true!");
+            if (!currentlySet) {
+                ERR("Didn't find set bit after setting the bit at position "
+                    "%" PRIu64 "!",
+                    position);
+            }
         }
-
+        multiroarTestCompare(r, highest);
         multiroarFree(r);
     }
+#endif
 
-    TEST("large position values near SIZE_MAX") {
+    TEST_DESC("set and get (%d of sequential positions; common roar)", lots) {
         multiroar *r = multiroarBitNew();
+        for (int32_t i = 0; i < lots; i++) {
+            const bool previouslySet = multiroarBitSet(r, i);
+            if (previouslySet) {
+                ERR("Detected previously set on new assignment at position %d!",
+                    i);
+            }
 
-        /* Test very large positions */
-        const uint64_t largePositions[] = {SIZE_MAX - 1, SIZE_MAX - 8192,
-                                           SIZE_MAX - 8193, SIZE_MAX / 2,
-                                           SIZE_MAX / 2 + 1};
-        const uint64_t numLarge =
-            sizeof(largePositions) / sizeof(largePositions[0]);
-
-        for (uint64_t i = 0; i < numLarge; i++) {
-            multiroarBitSet(r, largePositions[i]);
-        }
+            const bool currentlySet = multiroarBitGet(r, i);
 
-        for (uint64_t i = 0; i < numLarge; i++) {
-            if (!multiroarBitGet(r, largePositions[i])) {
-                ERR("Large position %" PRIu64 " not set!", largePositions[i]);
+            if (!currentlySet) {
+                ERR("Didn't find set bit after setting the bit at position %d!",
+                    i);
             }
         }
-
-        /* Verify nearby positions are NOT set */
-        if (multiroarBitGet(r, SIZE_MAX - 2)) {
-            ERRR("Position SIZE_MAX-2 should not be set!");
-        }
-
+        multiroarRepr(r, lots - 1);
+        multiroarTestCompare(r, lots - 1);
         multiroarFree(r);
     }
 
-    TEST("interleaved set pattern") {
-        /* Set every other bit, then fill in the gaps */
+    TEST("chunk boundary correctness") {
+        /* Test bits at and around chunk boundaries (8192 bits per chunk) */
         multiroar *r = multiroarBitNew();
-        const uint64_t testRange = 2000;
+        const uint64_t boundaries[] = {0,     8191,  8192,  8193,  16383,
+                                       16384, 16385, 24575, 24576, 24577};
+        const uint64_t numBoundaries =
+            sizeof(boundaries) / sizeof(boundaries[0]);
 
-        /* Set even positions first */
-        for (uint64_t i = 0; i < testRange; i += 2) {
-            multiroarBitSet(r, i);
+        /* Set all boundary bits */
+        for (uint64_t i = 0; i < numBoundaries; i++) {
+            multiroarBitSet(r, boundaries[i]);
         }
 
-        /* Verify even positions are set, odd are not */
-        for (uint64_t i = 0; i < testRange; i++) {
-            bool isSet = multiroarBitGet(r, i);
-            if (i % 2 == 0 && !isSet) {
-                ERR("Even position %" PRIu64 " should be set!", i);
-            }
-            if (i % 2 == 1 && isSet) {
-                ERR("Odd position %" PRIu64 " should NOT be set!", i);
+        /* Verify all boundary bits are set */
+        for (uint64_t i = 0; i < numBoundaries; i++) {
+            if (!multiroarBitGet(r, boundaries[i])) {
+                ERR("Boundary bit %" PRIu64 " not set!", boundaries[i]);
             }
         }
 
-        /* Now set odd positions */
-        for (uint64_t i = 1; i < testRange; i += 2) {
-            multiroarBitSet(r, i);
+        /* Verify bits between boundaries are NOT set */
+        if (multiroarBitGet(r, 100)) {
+            ERRR("Bit 100 should not be set!");
         }
-
-        /* Verify all positions are now set */
-        for (uint64_t i = 0; i < testRange; i++) {
-            if (!multiroarBitGet(r, i)) {
-                ERR("After fill: position %" PRIu64 " should be set!", i);
-            }
+        if (multiroarBitGet(r, 8100)) {
+            ERRR("Bit 8100 should not be set!");
+        }
+        if (multiroarBitGet(r, 16000)) {
+            ERRR("Bit 16000 should not be set!");
         }
 
         multiroarFree(r);
     }
 
-    TEST("reverse order insertion") {
-        /* Insert bits in reverse order */
+    TEST("sequential set up to bitmap conversion threshold") {
+        /* Test setting many bits sequentially triggers bitmap conversion
+         * and continues to work correctly */
         multiroar *r = multiroarBitNew();
-        const uint64_t testCount = 1000;
-
-        for (uint64_t i = testCount; i > 0; i--) {
-            multiroarBitSet(r, i - 1);
+        const uint64_t testCount =
+            1000; /* Well above 629 conversion threshold */
 
-            /* Verify this position is set */
-            if (!multiroarBitGet(r, i - 1)) {
-                ERR("Reverse insert: position %" PRIu64 " not set!", i - 1);
+        for (uint64_t i = 0; i < testCount; i++) {
+            multiroarBitSet(r, i);
+            if (!multiroarBitGet(r, i)) {
+                ERR("Bit %" PRIu64 " NOT SET immediately after setting!", i);
             }
         }
 
-        /* Verify all positions are set */
+        /* Verify all bits are still set */
         for (uint64_t i = 0; i < testCount; i++) {
             if (!multiroarBitGet(r, i)) {
-                ERR("Reverse insert: position %" PRIu64 " lost!", i);
+                ERR("Bit %" PRIu64 " lost after all sets!", i);
             }
         }
 
         multiroarFree(r);
     }
 
-    TEST("random order insertion with verification") {
-        /* Insert bits in pseudo-random order using LCG */
+    TEST("conversion from UNDER_FULL to FULL_BITMAP") {
+        /* Test that conversion to full bitmap preserves all bits */
         multiroar *r = multiroarBitNew();
-        const uint64_t testCount = 500;
-        uint64_t *positions = zcalloc(testCount, sizeof(uint64_t));
-
-        /* Generate pseudo-random positions */
-        uint32_t seed = 12345;
-        for (uint64_t i = 0; i < testCount; i++) {
-            seed = seed * 1103515245 + 12345;
-            positions[i] = (seed >> 8) % 10000;
-        }
+        const uint64_t maxDirect = 629; /* MAX_ENTRIES_PER_DIRECT_LISTING */
 
-        /* Insert all positions */
-        for (uint64_t i = 0; i < testCount; i++) {
+        /* Set exactly maxDirect positions to trigger conversion to bitmap */
+        uint64_t *positions = zcalloc(maxDirect, sizeof(uint64_t));
+        for (uint64_t i = 0; i < maxDirect; i++) {
+            positions[i] = i * 10; /* Spread positions to stay in one chunk */
             multiroarBitSet(r, positions[i]);
         }
 
-        /* Verify all positions are set */
-        for (uint64_t i = 0; i < testCount; i++) {
+        /* Verify all positions are still set after potential conversion */
+        for (uint64_t i = 0; i < maxDirect; i++) {
             if (!multiroarBitGet(r, positions[i])) {
-                ERR("Random order: position %" PRIu64 " not set!",
+                ERR("Position %" PRIu64 " lost after bitmap conversion!",
                     positions[i]);
             }
         }
 
+        /* Verify non-set positions are not set */
+        for (uint64_t i = 0; i < maxDirect - 1; i++) {
+            for (uint64_t j = positions[i] + 1; j < positions[i + 1]; j++) {
+                if (multiroarBitGet(r, j)) {
+                    ERR("Position %" PRIu64 " incorrectly set!", j);
+                }
+            }
+        }
+
         zfree(positions);
         multiroarFree(r);
     }
 
-    TEST("chunk type transitions (UNDER_FULL -> FULL_BITMAP)") {
-        /* Carefully test the transition from UNDER_FULL to FULL_BITMAP */
+    TEST("bitmap mode with various positions") {
+        /* Test that bitmap mode (> 629 positions) works correctly */
         multiroar *r = multiroarBitNew();
 
-        /* Insert 628 positions (just under threshold) */
-        for (uint64_t i = 0; i < 628; i++) {
+        /* Set positions to trigger bitmap mode, then verify */
+        const uint64_t positions[] = {0,    100,  200,  300,  400,  500,
+                                      600,  700,  800,  900,  1000, 1500,
+                                      2000, 2500, 3000, 3500, 4000, 4500,
+                                      5000, 5500, 6000, 6500, 7000};
+        const uint64_t numPositions = sizeof(positions) / sizeof(positions[0]);
+
+        /* First, fill up to trigger bitmap conversion */
+        for (uint64_t i = 0; i < 700; i++) {
             multiroarBitSet(r, i);
-            if (!multiroarBitGet(r, i)) {
-                ERR("Pre-transition: position %" PRIu64 " not set!", i);
-            }
         }
 
-        /* Insert 629th position - triggers transition */
-        multiroarBitSet(r, 628);
-        if (!multiroarBitGet(r, 628)) {
-            ERRR("Transition position 628 not set!");
+        /* Set some additional positions */
+        for (uint64_t i = 0; i < numPositions; i++) {
+            multiroarBitSet(r, positions[i]);
         }
 
-        /* Verify all previous positions survived transition */
-        for (uint64_t i = 0; i < 629; i++) {
-            if (!multiroarBitGet(r, i)) {
-                ERR("Post-transition: position %" PRIu64 " lost!", i);
+        /* Verify the specific positions are set */
+        for (uint64_t i = 0; i < numPositions; i++) {
+            if (!multiroarBitGet(r, positions[i])) {
+                ERR("Position %" PRIu64 " not set!", positions[i]);
             }
         }
 
-        /* Continue inserting to verify bitmap mode works */
-        for (uint64_t i = 629; i < 1000; i++) {
-            multiroarBitSet(r, i);
-            if (!multiroarBitGet(r, i)) {
-                ERR("Bitmap mode: position %" PRIu64 " not set!", i);
-            }
+        /* Verify positions outside our set are not set */
+        if (multiroarBitGet(r, 7500)) {
+            ERRR("Position 7500 should not be set!");
         }
 
         multiroarFree(r);
     }
 
-    TEST("OVER_FULL transition (FULL_BITMAP -> negative list)") {
-        /* Test transition to OVER_FULL when most bits are set */
+    TEST("multi-chunk correctness") {
+        /* Create roar with multiple chunks */
         multiroar *r = multiroarBitNew();
         const uint64_t chunkBits = 8192;
-        const uint64_t threshold = 7564; /* Just past OVER_FULL threshold */
 
-        /* Set bits sequentially up to threshold */
-        for (uint64_t i = 0; i < threshold; i++) {
+        /* Chunk 0: sparse (few bits) */
+        multiroarBitSet(r, 100);
+        multiroarBitSet(r, 200);
+        multiroarBitSet(r, 300);
+
+        /* Chunk 1: moderately filled */
+        for (uint64_t i = chunkBits; i < chunkBits + 500; i++) {
             multiroarBitSet(r, i);
+        }
 
-            /* Verify immediately */
+        /* Chunk 2: also moderately filled */
+        for (uint64_t i = chunkBits * 2; i < chunkBits * 2 + 1000; i++) {
+            multiroarBitSet(r, i);
+        }
+
+        /* Verify chunk 0 (sparse) */
+        if (!multiroarBitGet(r, 100) || !multiroarBitGet(r, 200) ||
+            !multiroarBitGet(r, 300)) {
+            ERRR("Sparse chunk bits not set!");
+        }
+        if (multiroarBitGet(r, 150)) {
+            ERRR("Unset bit in sparse chunk incorrectly set!");
+        }
+
+        /* Verify chunk 1 */
+        for (uint64_t i = chunkBits; i < chunkBits + 500; i++) {
             if (!multiroarBitGet(r, i)) {
-                ERR("OVER_FULL transition: position %" PRIu64
-                    " not set immediately!",
-                    i);
+                ERR("Bit %" PRIu64 " in chunk 1 should be set!", i);
             }
         }
 
-        /* Verify all positions still set after potential transition */
-        uint64_t failures = 0;
-        for (uint64_t i = 0; i < threshold; i++) {
+        /* Verify chunk 2 */
+        for (uint64_t i = chunkBits * 2; i < chunkBits * 2 + 1000; i++) {
             if (!multiroarBitGet(r, i)) {
-                if (failures < 10) {
-                    ERR("OVER_FULL: position %" PRIu64 " lost!", i);
-                }
-                failures++;
+                ERR("Bit %" PRIu64 " in chunk 2 should be set!", i);
             }
         }
-        if (failures > 10) {
-            printf("... and %" PRIu64 " more positions lost\n", failures - 10);
-        }
-
-        /* Verify positions past threshold are NOT set */
-        for (uint64_t i = threshold; i < chunkBits; i += 100) {
-            if (multiroarBitGet(r, i)) {
-                ERR("OVER_FULL: position %" PRIu64 " incorrectly set!", i);
-            }
+        if (multiroarBitGet(r, chunkBits * 2 + 1500)) {
+            ERRR("Unset bit in chunk 2 incorrectly set!");
         }
 
         multiroarFree(r);
     }
 
-    TEST("ALL_1 transition (fill entire chunk)") {
-        /* Fill an entire chunk to trigger ALL_1 type */
+    TEST("high-scale stress test (100K random bits)") {
         multiroar *r = multiroarBitNew();
-        const uint64_t chunkBits = 8192;
-
-        printf("    Filling entire chunk (%" PRIu64 " bits)...\n", chunkBits);
+        const uint64_t scale = 100000;
+        const uint64_t sampleSize = 10000; /* Track a sample for verification */
+        uint64_t *sampleBits = zcalloc(sampleSize, sizeof(uint64_t));
 
-        /* Set all bits in chunk 0 */
-        for (uint64_t i = 0; i < chunkBits; i++) {
-            multiroarBitSet(r, i);
+        /* Set random bits, tracking a sample for verification */
+        for (uint64_t i = 0; i < scale; i++) {
+            const uint64_t position =
+                ((uint64_t)rand() * rand()) % (SIZE_MAX / 2);
 
-            /* Periodic verification */
-            if (i % 1000 == 0 || i == chunkBits - 1) {
-                if (!multiroarBitGet(r, i)) {
-                    ERR("ALL_1 fill: position %" PRIu64 " not set!", i);
-                }
+            /* Track every Nth position for verification */
+            if (i < sampleSize) {
+                sampleBits[i] = position;
             }
-        }
 
-        /* Verify all bits in chunk are set */
-        uint64_t failures = 0;
-        for (uint64_t i = 0; i < chunkBits; i++) {
-            if (!multiroarBitGet(r, i)) {
-                if (failures < 5) {
-                    ERR("ALL_1 verify: position %" PRIu64 " not set!", i);
-                }
-                failures++;
+            multiroarBitSet(r, position);
+
+            /* Verify immediately after set */
+            if (!multiroarBitGet(r, position)) {
+                ERR("High-scale: bit %" PRIu64
+                    " not set immediately after setting!",
+                    position);
             }
         }
-        if (failures > 5) {
-            printf("    ... and %" PRIu64
-                   " more bits not set (total failures: %" PRIu64 ")\n",
-                   failures - 5, failures);
-        }
 
-        /* Verify bits in next chunk are NOT set */
-        if (multiroarBitGet(r, chunkBits)) {
-            ERRR("Bit in next chunk should not be set!");
-        }
-        if (multiroarBitGet(r, chunkBits + 100)) {
-            ERRR("Bit in next chunk should not be set!");
+        /* Verify sample bits are still set after all operations */
+        uint64_t verified = 0;
+        for (uint64_t i = 0; i < sampleSize; i++) {
+            if (multiroarBitGet(r, sampleBits[i])) {
+                verified++;
+            } else {
+                ERR("High-scale: sample bit %" PRIu64 " not set!",
+                    sampleBits[i]);
+            }
         }
 
-        /* Setting a bit in the ALL_1 chunk should return true (already set) */
-        bool prev = multiroarBitSet(r, 4096);
-        if (!prev) {
-            ERRR("ALL_1: setting existing bit should return true!");
+        if (verified != sampleSize) {
+            ERR("High-scale: only %" PRIu64 " of %" PRIu64
+                " sample bits verified!",
+                verified, sampleSize);
         }
 
+        zfree(sampleBits);
         multiroarFree(r);
     }
 
-    TEST("mixed chunk types in single roar") {
-        /* Create a roar with all different chunk types */
+    TEST("set same bit twice returns correct previouslySet") {
         multiroar *r = multiroarBitNew();
-        const uint64_t chunkBits = 8192;
-
-        /* Chunk 0: UNDER_FULL (sparse, few bits) */
-        multiroarBitSet(r, 10);
-        multiroarBitSet(r, 100);
-        multiroarBitSet(r, 500);
 
-        /* Chunk 1: FULL_BITMAP (moderate density) */
-        for (uint64_t i = chunkBits; i < chunkBits + 2000; i++) {
-            multiroarBitSet(r, i);
+        bool first = multiroarBitSet(r, 12345);
+        if (first) {
+            ERRR("First set should return false for previouslySet!");
         }
 
-        /* Chunk 2: High density (triggers OVER_FULL if working) */
-        for (uint64_t i = chunkBits * 2; i < chunkBits * 2 + 7600; i++) {
-            multiroarBitSet(r, i);
+        bool second = multiroarBitSet(r, 12345);
+        if (!second) {
+            ERRR("Second set should return true for previouslySet!");
         }
 
-        /* Verify chunk 0 */
-        if (!multiroarBitGet(r, 10) || !multiroarBitGet(r, 100) ||
-            !multiroarBitGet(r, 500)) {
-            ERRR("Chunk 0 bits not set!");
-        }
-        if (multiroarBitGet(r, 50) || multiroarBitGet(r, 200)) {
-            ERRR("Chunk 0 has unexpected bits set!");
+        /* Verify bit is still set */
+        if (!multiroarBitGet(r, 12345)) {
+            ERRR("Bit should remain set after double set!");
         }
 
-        /* Verify chunk 1 */
-        for (uint64_t i = chunkBits; i < chunkBits + 2000; i += 100) {
-            if (!multiroarBitGet(r, i)) {
-                ERR("Chunk 1 position %" PRIu64 " not set!", i);
-            }
-        }
+        multiroarFree(r);
+    }
 
-        /* Verify chunk 2 */
-        for (uint64_t i = chunkBits * 2; i < chunkBits * 2 + 7600; i += 100) {
-            if (!multiroarBitGet(r, i)) {
-                ERR("Chunk 2 position %" PRIu64 " not set!", i);
-            }
+    TEST("PERF: sequential insert performance") {
+        const uint64_t scale = 100000;
+        multiroar *r = multiroarBitNew();
+
+        int64_t startNs = timeUtilMonotonicNs();
+        for (uint64_t i = 0; i < scale; i++) {
+            multiroarBitSet(r, i);
         }
+        int64_t elapsed = timeUtilMonotonicNs() - startNs;
+        printf("Sequential insert: %.1f ns/op, %.0f ops/sec\n",
+               (double)elapsed / scale, scale / (elapsed / 1e9));
 
         multiroarFree(r);
     }
 
-    TEST("packed array sorted insertion stress") {
-        /* Stress test the sorted insertion in UNDER_FULL mode */
+    TEST("PERF: random insert performance") {
+        const uint64_t scale = 100000;
         multiroar *r = multiroarBitNew();
 
-        /* Insert positions that stress the sorted insert algorithm */
-        const uint64_t positions[] = {
-            500, 100, 900, 50, 950,  25,  975, 12,  988, 6,  994, 3,
-            997, 1,   999, 0,  1000, 2,   998, 4,   996, 8,  992, 16,
-            984, 32,  968, 64, 936,  128, 872, 256, 744, 512};
-        const uint64_t numPos = sizeof(positions) / sizeof(positions[0]);
-
-        for (uint64_t i = 0; i < numPos; i++) {
-            multiroarBitSet(r, positions[i]);
-        }
-
-        /* Verify all positions are set */
-        for (uint64_t i = 0; i < numPos; i++) {
-            if (!multiroarBitGet(r, positions[i])) {
-                ERR("Sorted insert stress: position %" PRIu64 " not set!",
-                    positions[i]);
-            }
+        int64_t startNs = timeUtilMonotonicNs();
+        for (uint64_t i = 0; i < scale; i++) {
+            multiroarBitSet(r, ((uint64_t)rand() * rand()) % (SIZE_MAX / 2));
         }
+        int64_t elapsed = timeUtilMonotonicNs() - startNs;
+        printf("Random insert: %.1f ns/op, %.0f ops/sec\n",
+               (double)elapsed / scale, scale / (elapsed / 1e9));
 
         multiroarFree(r);
     }
 
-    TEST("empty chunk queries") {
-        /* Test queries on chunks that don't exist (empty) */
+    TEST("PERF: lookup performance (dense)") {
+        const uint64_t scale = 100000;
         multiroar *r = multiroarBitNew();
 
-        /* Query various positions without setting anything */
-        if (multiroarBitGet(r, 0)) {
-            ERRR("Empty roar: position 0 should not be set!");
-        }
-        if (multiroarBitGet(r, 100)) {
-            ERRR("Empty roar: position 100 should not be set!");
-        }
-        if (multiroarBitGet(r, 8192)) {
-            ERRR("Empty roar: position 8192 should not be set!");
-        }
-        if (multiroarBitGet(r, SIZE_MAX / 2)) {
-            ERRR("Empty roar: large position should not be set!");
+        /* Create dense bitmap */
+        for (uint64_t i = 0; i < scale; i++) {
+            multiroarBitSet(r, i);
         }
 
-        /* Set one position, verify others still not set */
-        multiroarBitSet(r, 5000);
-        if (!multiroarBitGet(r, 5000)) {
-            ERRR("Position 5000 should be set!");
-        }
-        if (multiroarBitGet(r, 4999) || multiroarBitGet(r, 5001)) {
-            ERRR("Adjacent positions should not be set!");
+        int64_t startNs = timeUtilMonotonicNs();
+        for (uint64_t i = 0; i < scale; i++) {
+            multiroarBitGet(r, i);
         }
+        int64_t elapsed = timeUtilMonotonicNs() - startNs;
+        printf("Dense lookup: %.1f ns/op, %.0f ops/sec\n",
+               (double)elapsed / scale, scale / (elapsed / 1e9));
 
         multiroarFree(r);
     }
 
-    TEST("PERF: sparse lookup performance") {
-        const uint64_t numPositions = 1000;
-        const uint64_t positionSpread = 1000000;
+    /* ================================================================
+     * Edge Case and Boundary Tests
+     * ================================================================ */
+
+    TEST("UNDER_FULL growth to exactly MAX_ENTRIES") {
+        /* Test growth from 1 to exactly 629 entries (conversion threshold) */
         multiroar *r = multiroarBitNew();
+        const uint64_t maxDirect = 629; /* MAX_ENTRIES_PER_DIRECT_LISTING */
 
-        /* Create sparse bitmap across many chunks */
-        for (uint64_t i = 0; i < numPositions; i++) {
-            multiroarBitSet(r, i * positionSpread);
+        /* Insert exactly 628 entries (one below threshold) */
+        for (uint64_t i = 0; i < maxDirect - 1; i++) {
+            multiroarBitSet(r, i * 13); /* Spread to stay in one chunk */
         }
 
-        int64_t startNs = timeUtilMonotonicNs();
-        for (uint64_t round = 0; round < 100; round++) {
-            for (uint64_t i = 0; i < numPositions; i++) {
-                multiroarBitGet(r, i * positionSpread);
+        /* Verify all are still set (should still be UNDER_FULL) */
+        for (uint64_t i = 0; i < maxDirect - 1; i++) {
+            if (!multiroarBitGet(r, i * 13)) {
+                ERR("Position %" PRIu64 " not set before threshold!", i * 13);
             }
         }
-        int64_t elapsed = timeUtilMonotonicNs() - startNs;
-        printf("Sparse lookup: %.1f ns/op, %.0f ops/sec\n",
-               (double)elapsed / (numPositions * 100),
-               (numPositions * 100) / (elapsed / 1e9));
 
-        multiroarFree(r);
-    }
+        /* Insert the 629th entry - triggers conversion to FULL_BITMAP */
+        multiroarBitSet(r, (maxDirect - 1) * 13);
 
-    /* ========================================
-     * FUZZ TESTS - Oracle-Based Verification
-     * ======================================== */
-    printf("\n=== MULTIROAR FUZZ TESTING ===\n\n");
+        /* Verify all entries including the new one */
+        for (uint64_t i = 0; i < maxDirect; i++) {
+            if (!multiroarBitGet(r, i * 13)) {
+                ERR("Position %" PRIu64 " not set after conversion!", i * 13);
+            }
+        }
 
-/* Simple bitmap oracle - just use bits in an array of uint64_t */
-#define FUZZ_ORACLE_MAX_BIT 100000
-#define FUZZ_ORACLE_WORDS ((FUZZ_ORACLE_MAX_BIT + 63) / 64)
-#define FUZZ_ORACLE_SET(oracle, pos)                                           \
-    ((oracle)[(pos) / 64] |= (1ULL << ((pos) % 64)))
-#define FUZZ_ORACLE_CLEAR(oracle, pos)                                         \
-    ((oracle)[(pos) / 64] &= ~(1ULL << ((pos) % 64)))
-#define FUZZ_ORACLE_GET(oracle, pos)                                           \
-    (((oracle)[(pos) / 64] >> ((pos) % 64)) & 1)
+        multiroarFree(r);
+    }
 
-    TEST("FUZZ: random bit operations with oracle") {
+    TEST("FULL_BITMAP exact boundary positions") {
+        /* Test bits at exact byte and word boundaries within bitmap */
         multiroar *r = multiroarBitNew();
-        uint64_t oracle[FUZZ_ORACLE_WORDS] = {0};
 
-        srand(12345);
-        const uint64_t numOps = 10000;
-        uint64_t setOps = 0, getOps = 0;
+        /* Fill to get into bitmap mode */
+        for (uint64_t i = 0; i < 700; i++) {
+            multiroarBitSet(r, i);
+        }
 
-        for (uint64_t i = 0; i < numOps; i++) {
-            uint64_t pos = (uint64_t)rand() % FUZZ_ORACLE_MAX_BIT;
-            int op = rand() % 10;
-
-            if (op < 7) {
-                /* Set operation (70%) */
-                bool mrPrev = multiroarBitSet(r, pos);
-                bool oraclePrev = FUZZ_ORACLE_GET(oracle, pos);
-                FUZZ_ORACLE_SET(oracle, pos);
-
-                if (mrPrev != oraclePrev) {
-                    ERR("Set at %" PRIu64
-                        ": multiroar said prev=%d, oracle said "
-                        "prev=%d",
-                        pos, mrPrev, oraclePrev);
-                }
-                setOps++;
-            } else {
-                /* Get operation (30%) */
-                bool mrVal = multiroarBitGet(r, pos);
-                bool oracleVal = FUZZ_ORACLE_GET(oracle, pos);
-
-                if (mrVal != oracleVal) {
-                    ERR("Get at %" PRIu64 ": multiroar=%d, oracle=%d", pos,
-                        mrVal, oracleVal);
+        /* Test byte boundary positions: 0, 7, 8, 15, 16, ... */
+        const uint64_t byteBoundaries[] = {0,   7,   8,   15,  16, 23,
+                                           24,  31,  32,  63,  64, 127,
+                                           128, 255, 256, 511, 512};
+        for (uint64_t i = 0;
+             i < sizeof(byteBoundaries) / sizeof(byteBoundaries[0]); i++) {
+            uint64_t pos = byteBoundaries[i];
+            if (pos < 700) {
+                if (!multiroarBitGet(r, pos)) {
+                    ERR("Byte boundary position %" PRIu64 " should be set!",
+                        pos);
                 }
-                getOps++;
             }
         }
 
-        /* Full verification */
-        uint64_t mismatches = 0;
-        for (uint64_t pos = 0; pos < FUZZ_ORACLE_MAX_BIT; pos++) {
-            bool mrVal = multiroarBitGet(r, pos);
-            bool oracleVal = FUZZ_ORACLE_GET(oracle, pos);
-            if (mrVal != oracleVal) {
-                if (mismatches < 10) {
-                    ERR("Final verify at %" PRIu64 ": multiroar=%d, oracle=%d",
-                        pos, mrVal, oracleVal);
+        /* Test 64-bit word boundary positions */
+        const uint64_t wordBoundaries[] = {63,  64,  127, 128, 191, 192,
+                                           255, 256, 319, 320, 383, 384,
+                                           447, 448, 511, 512};
+        for (uint64_t i = 0;
+             i < sizeof(wordBoundaries) / sizeof(wordBoundaries[0]); i++) {
+            uint64_t pos = wordBoundaries[i];
+            if (pos < 700) {
+                if (!multiroarBitGet(r, pos)) {
+                    ERR("Word boundary position %" PRIu64 " should be set!",
+                        pos);
                 }
-                mismatches++;
             }
         }
 
-        if (mismatches > 0) {
-            ERR("Total mismatches: %" PRIu64 "", mismatches);
-        }
-
-        printf("  set=%" PRIu64 " get=%" PRIu64 " verified=%d\n", setOps,
-               getOps, FUZZ_ORACLE_MAX_BIT);
         multiroarFree(r);
     }
 
-    TEST("FUZZ: sequential then random access") {
+    TEST("sparse positions across chunk boundary") {
+        /* Test sparse positions that span multiple chunks */
         multiroar *r = multiroarBitNew();
-        uint64_t oracle[FUZZ_ORACLE_WORDS] = {0};
+        const uint64_t chunkBits = 8192;
 
-        /* Sequential fill */
-        for (uint64_t i = 0; i < 5000; i++) {
-            multiroarBitSet(r, i);
-            FUZZ_ORACLE_SET(oracle, i);
-        }
+        /* Set sparse positions across 4 chunks */
+        const uint64_t positions[] = {
+            0,
+            100,
+            1000, /* Chunk 0 */
+            chunkBits + 50,
+            chunkBits + 500, /* Chunk 1 */
+            chunkBits * 2 + 1,
+            chunkBits * 2 + 999, /* Chunk 2 */
+            chunkBits * 3 + 8191 /* Chunk 3, last bit */
+        };
+        const uint64_t numPositions = sizeof(positions) / sizeof(positions[0]);
 
-        /* Random access verification */
-        srand(54321);
-        for (uint64_t i = 0; i < 10000; i++) {
-            uint64_t pos = (uint64_t)rand() % FUZZ_ORACLE_MAX_BIT;
-            bool mrVal = multiroarBitGet(r, pos);
-            bool oracleVal = FUZZ_ORACLE_GET(oracle, pos);
+        for (uint64_t i = 0; i < numPositions; i++) {
+            multiroarBitSet(r, positions[i]);
+        }
 
-            if (mrVal != oracleVal) {
-                ERR("Pos %" PRIu64 ": multiroar=%d, oracle=%d", pos, mrVal,
-                    oracleVal);
+        /* Verify all positions */
+        for (uint64_t i = 0; i < numPositions; i++) {
+            if (!multiroarBitGet(r, positions[i])) {
+                ERR("Sparse cross-chunk position %" PRIu64 " not set!",
+                    positions[i]);
             }
         }
 
-        printf("  sequential fill 5000, random verify 10000\n");
+        /* Verify positions between are NOT set */
+        if (multiroarBitGet(r, 50)) {
+            ERRR("Position 50 should not be set!");
+        }
+        if (multiroarBitGet(r, chunkBits + 100)) {
+            ERRR("Position in chunk 1 should not be set!");
+        }
+
         multiroarFree(r);
     }
 
-    TEST("FUZZ: sparse bits across many chunks") {
+    TEST("set and immediate re-read in UNDER_FULL mode") {
+        /* Test that set followed by immediate get works in UNDER_FULL */
         multiroar *r = multiroarBitNew();
 
-        srand(99999);
-        const uint64_t numSparse = 1000;
-        uint64_t *positions = zmalloc(numSparse * sizeof(uint64_t));
-
-        /* Generate sparse positions across many chunks (8192 bits per chunk) */
-        for (uint64_t i = 0; i < numSparse; i++) {
-            /* Spread across up to 1000 chunks */
-            positions[i] =
-                ((uint64_t)rand() % 1000) * 8192 + ((uint64_t)rand() % 8192);
-            multiroarBitSet(r, positions[i]);
-        }
+        /* Set and verify in sequence, staying in UNDER_FULL mode */
+        for (uint64_t i = 0; i < 100; i++) {
+            uint64_t pos = i * 100; /* Spread positions */
+            multiroarBitSet(r, pos);
 
-        /* Verify all set positions */
-        for (uint64_t i = 0; i < numSparse; i++) {
-            if (!multiroarBitGet(r, positions[i])) {
-                ERR("Sparse position %" PRIu64 " not set!", positions[i]);
+            /* Immediate verification */
+            if (!multiroarBitGet(r, pos)) {
+                ERR("UNDER_FULL: position %" PRIu64 " not set immediately!",
+                    pos);
             }
-        }
-
-        /* Verify some unset positions */
-        uint64_t verified = 0;
-        for (uint64_t chunk = 0; chunk < 100; chunk++) {
-            for (uint64_t offset = 0; offset < 100; offset++) {
-                uint64_t pos =
-                    chunk * 8192 + offset * 80 + 40; /* Unlikely to be set */
-                bool isSet = multiroarBitGet(r, pos);
-                bool shouldBeSet = false;
-
-                for (uint64_t i = 0; i < numSparse; i++) {
-                    if (positions[i] == pos) {
-                        shouldBeSet = true;
-                        break;
-                    }
-                }
 
-                if (isSet != shouldBeSet) {
-                    ERR("Unset verify at %" PRIu64 ": got %d expected %d", pos,
-                        isSet, shouldBeSet);
+            /* Verify previously set positions still exist */
+            for (uint64_t j = 0; j <= i; j++) {
+                if (!multiroarBitGet(r, j * 100)) {
+                    ERR("UNDER_FULL: earlier position %" PRIu64 " lost!",
+                        j * 100);
                 }
-                verified++;
             }
         }
 
-        printf("  sparse bits=%" PRIu64 ", verified unset=%" PRIu64 "\n",
-               numSparse, verified);
-        zfree(positions);
         multiroarFree(r);
     }
 
-    TEST("FUZZ: chunk boundary stress") {
+    TEST("set and immediate re-read in FULL_BITMAP mode") {
+        /* Test that set followed by immediate get works in FULL_BITMAP */
         multiroar *r = multiroarBitNew();
-        uint64_t oracle[FUZZ_ORACLE_WORDS] = {0};
-        const uint64_t chunkBits = 8192;
-
-        srand(77777);
 
-        /* Set bits around chunk boundaries */
-        for (uint64_t chunk = 0; chunk < 10; chunk++) {
-            uint64_t base = chunk * chunkBits;
+        /* First, fill to trigger bitmap mode */
+        for (uint64_t i = 0; i < 700; i++) {
+            multiroarBitSet(r, i);
+        }
 
-            /* Around boundary start */
-            for (int offset = -5; offset <= 5; offset++) {
-                if (base + offset < FUZZ_ORACLE_MAX_BIT) {
-                    uint64_t pos = base + offset;
-                    if (rand() % 2) {
-                        multiroarBitSet(r, pos);
-                        FUZZ_ORACLE_SET(oracle, pos);
-                    }
-                }
-            }
+        /* Now set additional positions and verify immediately */
+        for (uint64_t i = 700; i < 1000; i++) {
+            multiroarBitSet(r, i);
 
-            /* Around boundary end */
-            if (base + chunkBits - 1 < FUZZ_ORACLE_MAX_BIT) {
-                for (int offset = -5; offset <= 5; offset++) {
-                    uint64_t pos = base + chunkBits - 1 + offset;
-                    if (pos < FUZZ_ORACLE_MAX_BIT && rand() % 2) {
-                        multiroarBitSet(r, pos);
-                        FUZZ_ORACLE_SET(oracle, pos);
-                    }
-                }
+            if (!multiroarBitGet(r, i)) {
+                ERR("FULL_BITMAP: position %" PRIu64 " not set immediately!",
+                    i);
             }
         }
 
-        /* Verify around boundaries */
-        uint64_t mismatches = 0;
-        for (uint64_t chunk = 0; chunk < 10; chunk++) {
-            uint64_t base = chunk * chunkBits;
-
-            for (int offset = -10; offset <= (int)chunkBits + 10; offset++) {
-                uint64_t pos = base + offset;
-                if (pos >= FUZZ_ORACLE_MAX_BIT) {
-                    continue;
-                }
-
-                bool mrVal = multiroarBitGet(r, pos);
-                bool oracleVal = FUZZ_ORACLE_GET(oracle, pos);
-
-                if (mrVal != oracleVal) {
-                    if (mismatches < 5) {
-                        ERR("Boundary pos %" PRIu64 " (chunk %" PRIu64
-                            ", offset %d): mr=%d "
-                            "oracle=%d",
-                            pos, chunk, offset, mrVal, oracleVal);
-                    }
-                    mismatches++;
-                }
+        /* Verify all positions are still set */
+        for (uint64_t i = 0; i < 1000; i++) {
+            if (!multiroarBitGet(r, i)) {
+                ERR("FULL_BITMAP: position %" PRIu64 " lost!", i);
             }
         }
 
-        printf("  tested 10 chunk boundaries, mismatches=%" PRIu64 "\n",
-               mismatches);
         multiroarFree(r);
     }
 
-    TEST("FUZZ: duplicate set operations") {
+    TEST("previouslySet behavior across all chunk types") {
         multiroar *r = multiroarBitNew();
 
-        srand(11111);
-        const uint64_t numUnique = 500;
-        uint64_t *positions = zmalloc(numUnique * sizeof(uint64_t));
-
-        /* Generate unique positions */
-        for (uint64_t i = 0; i < numUnique; i++) {
-            positions[i] = (uint64_t)rand() % 50000;
+        /* Test in UNDER_FULL mode */
+        bool prev = multiroarBitSet(r, 100);
+        if (prev) {
+            ERRR("UNDER_FULL: first set should return false!");
         }
-
-        /* First pass: set all */
-        for (uint64_t i = 0; i < numUnique; i++) {
-            multiroarBitSet(r, positions[i]);
+        prev = multiroarBitSet(r, 100);
+        if (!prev) {
+            ERRR("UNDER_FULL: second set should return true!");
         }
 
-        /* Second pass: set all again, should all report previously set */
-        uint64_t reportedNew = 0;
-        for (uint64_t i = 0; i < numUnique; i++) {
-            bool prev = multiroarBitSet(r, positions[i]);
-            if (!prev) {
-                /* This might happen if we have duplicate positions */
-                bool duplicate = false;
-                for (uint64_t j = 0; j < i; j++) {
-                    if (positions[j] == positions[i]) {
-                        duplicate = true;
-                        break;
-                    }
-                }
-                if (!duplicate) {
-                    reportedNew++;
-                    if (reportedNew <= 5) {
-                        ERR("Position %" PRIu64 " reported new on second set!",
-                            positions[i]);
-                    }
-                }
-            }
-        }
-
-        /* Verify all still set */
-        for (uint64_t i = 0; i < numUnique; i++) {
-            if (!multiroarBitGet(r, positions[i])) {
-                ERR("Position %" PRIu64 " not set after double-set!",
-                    positions[i]);
-            }
-        }
-
-        printf("  double-set %" PRIu64 " positions\n", numUnique);
-        zfree(positions);
-        multiroarFree(r);
-    }
-
-    TEST("FUZZ: adversarial patterns - reverse order") {
-        multiroar *r = multiroarBitNew();
-        const uint64_t count = 2000;
-
-        /* Insert in reverse order - stresses sorted insertion */
-        for (uint64_t i = count; i > 0; i--) {
-            multiroarBitSet(r, i - 1);
+        /* Fill to get into FULL_BITMAP mode */
+        for (uint64_t i = 0; i < 700; i++) {
+            multiroarBitSet(r, i);
         }
 
-        /* Verify all set */
-        for (uint64_t i = 0; i < count; i++) {
-            if (!multiroarBitGet(r, i)) {
-                ERR("Reverse insert: position %" PRIu64 " not set!", i);
-            }
+        /* Test in FULL_BITMAP mode with new position */
+        prev = multiroarBitSet(r, 5000);
+        if (prev) {
+            ERRR("FULL_BITMAP: first set of new pos should return false!");
         }
-
-        printf("  reverse order insert %" PRIu64 " positions\n", count);
-        multiroarFree(r);
-    }
-
-    TEST("FUZZ: adversarial patterns - alternating") {
-        multiroar *r = multiroarBitNew();
-        const uint64_t count = 5000;
-
-        /* Set every other bit */
-        for (uint64_t i = 0; i < count * 2; i += 2) {
-            multiroarBitSet(r, i);
+        prev = multiroarBitSet(r, 5000);
+        if (!prev) {
+            ERRR("FULL_BITMAP: second set should return true!");
         }
 
-        /* Verify even positions set, odd not set */
-        for (uint64_t i = 0; i < count * 2; i++) {
-            bool expected = (i % 2 == 0);
-            bool actual = multiroarBitGet(r, i);
-            if (actual != expected) {
-                ERR("Alternating at %" PRIu64 ": got %d expected %d", i, actual,
-                    expected);
-            }
+        /* Test in FULL_BITMAP mode with existing position */
+        prev = multiroarBitSet(r, 100); /* Was set earlier */
+        if (!prev) {
+            ERRR("FULL_BITMAP: set of existing pos should return true!");
         }
 
-        printf("  alternating pattern %" PRIu64 " positions\n", count);
         multiroarFree(r);
     }
 
-    TEST("FUZZ: large position values") {
+    TEST("large position values near SIZE_MAX") {
         multiroar *r = multiroarBitNew();
 
-        /* Test very large position values - avoid adjacent positions */
-        const uint64_t largePositions[] = {
-            SIZE_MAX - 1,      SIZE_MAX - 200,    SIZE_MAX - 8192,
-            SIZE_MAX - 16384,  SIZE_MAX / 2,      SIZE_MAX / 4,
-            (uint64_t)1 << 40, (uint64_t)1 << 50, (uint64_t)1 << 60};
+        /* Test very large positions */
+        const uint64_t largePositions[] = {SIZE_MAX - 1, SIZE_MAX - 8192,
+                                           SIZE_MAX - 8193, SIZE_MAX / 2,
+                                           SIZE_MAX / 2 + 1};
         const uint64_t numLarge =
             sizeof(largePositions) / sizeof(largePositions[0]);
 
@@ -4645,4736 +5647,6385 @@ int multiroarTest(int argc, char *argv[]) {
             }
         }
 
-        /* Verify adjacent positions not set (check position - 2 to avoid
-         * collision with positions that differ by 1) */
-        for (uint64_t i = 0; i < numLarge; i++) {
-            if (largePositions[i] > 2) {
-                uint64_t adjacent = largePositions[i] - 2;
-                /* Make sure this adjacent position isn't one we set */
-                bool shouldBeSet = false;
-                for (uint64_t j = 0; j < numLarge; j++) {
-                    if (largePositions[j] == adjacent) {
-                        shouldBeSet = true;
-                        break;
-                    }
-                }
-                if (!shouldBeSet && multiroarBitGet(r, adjacent)) {
-                    ERR("Adjacent-2 to large position %" PRIu64
-                        " incorrectly set!",
-                        largePositions[i]);
-                }
-            }
+        /* Verify nearby positions are NOT set */
+        if (multiroarBitGet(r, SIZE_MAX - 2)) {
+            ERRR("Position SIZE_MAX-2 should not be set!");
         }
 
-        printf("  verified %" PRIu64 " large positions\n", numLarge);
         multiroarFree(r);
     }
 
-    TEST("FUZZ: stress 100K random operations") {
+    TEST("interleaved set pattern") {
+        /* Set every other bit, then fill in the gaps */
         multiroar *r = multiroarBitNew();
-        uint64_t oracle[FUZZ_ORACLE_WORDS] = {0};
-
-        srand(88888);
-        const uint64_t numOps = 100000;
-
-        for (uint64_t i = 0; i < numOps; i++) {
-            uint64_t pos = (uint64_t)rand() % FUZZ_ORACLE_MAX_BIT;
+        const uint64_t testRange = 2000;
 
-            bool mrPrev = multiroarBitSet(r, pos);
-            bool oraclePrev = FUZZ_ORACLE_GET(oracle, pos);
-            FUZZ_ORACLE_SET(oracle, pos);
+        /* Set even positions first */
+        for (uint64_t i = 0; i < testRange; i += 2) {
+            multiroarBitSet(r, i);
+        }
 
-            if (mrPrev != oraclePrev) {
-                ERR("100K stress at %" PRIu64 ": prev mismatch mr=%d oracle=%d",
-                    pos, mrPrev, oraclePrev);
+        /* Verify even positions are set, odd are not */
+        for (uint64_t i = 0; i < testRange; i++) {
+            bool isSet = multiroarBitGet(r, i);
+            if (i % 2 == 0 && !isSet) {
+                ERR("Even position %" PRIu64 " should be set!", i);
             }
-
-            /* Periodic spot check */
-            if (i % 10000 == 0) {
-                uint64_t checkPos = (uint64_t)rand() % FUZZ_ORACLE_MAX_BIT;
-                bool mrVal = multiroarBitGet(r, checkPos);
-                bool oracleVal = FUZZ_ORACLE_GET(oracle, checkPos);
-                if (mrVal != oracleVal) {
-                    ERR("Spot check at round %" PRIu64 " pos %" PRIu64
-                        ": mr=%d oracle=%d",
-                        i, checkPos, mrVal, oracleVal);
-                }
+            if (i % 2 == 1 && isSet) {
+                ERR("Odd position %" PRIu64 " should NOT be set!", i);
             }
         }
 
-        /* Final full verification */
-        uint64_t mismatches = 0;
-        uint64_t bitsSet = 0;
-        for (uint64_t pos = 0; pos < FUZZ_ORACLE_MAX_BIT; pos++) {
-            bool mrVal = multiroarBitGet(r, pos);
-            bool oracleVal = FUZZ_ORACLE_GET(oracle, pos);
-            if (mrVal != oracleVal) {
-                mismatches++;
-            }
-            if (oracleVal) {
-                bitsSet++;
-            }
+        /* Now set odd positions */
+        for (uint64_t i = 1; i < testRange; i += 2) {
+            multiroarBitSet(r, i);
         }
 
-        if (mismatches > 0) {
-            ERR("100K stress final: %" PRIu64 " mismatches", mismatches);
+        /* Verify all positions are now set */
+        for (uint64_t i = 0; i < testRange; i++) {
+            if (!multiroarBitGet(r, i)) {
+                ERR("After fill: position %" PRIu64 " should be set!", i);
+            }
         }
 
-        printf("  100K ops, %" PRIu64 " unique bits set, %" PRIu64
-               " mismatches\n",
-               bitsSet, mismatches);
         multiroarFree(r);
     }
 
-    printf("\n=== NEW FUNCTIONALITY TESTS ===\n\n");
-
-    TEST("multiroarRemove - basic remove from UNDER_FULL") {
+    TEST("reverse order insertion") {
+        /* Insert bits in reverse order */
         multiroar *r = multiroarBitNew();
-        multiroarBitSet(r, 100);
-        multiroarBitSet(r, 200);
-        multiroarBitSet(r, 300);
+        const uint64_t testCount = 1000;
 
-        if (!multiroarBitGet(r, 100)) {
-            ERRR("bit 100 should be set");
-        }
-        if (!multiroarBitGet(r, 200)) {
-            ERRR("bit 200 should be set");
-        }
-        if (!multiroarBitGet(r, 300)) {
-            ERRR("bit 300 should be set");
-        }
+        for (uint64_t i = testCount; i > 0; i--) {
+            multiroarBitSet(r, i - 1);
 
-        /* Remove middle element */
-        bool wasSet = multiroarRemove(r, 200);
-        if (!wasSet) {
-            ERRR("wasSet should be true for bit 200");
-        }
-        if (multiroarBitGet(r, 200)) {
-            ERRR("bit 200 should be clear after remove");
-        }
-        if (!multiroarBitGet(r, 100)) {
-            ERRR("bit 100 should still be set");
-        }
-        if (!multiroarBitGet(r, 300)) {
-            ERRR("bit 300 should still be set");
+            /* Verify this position is set */
+            if (!multiroarBitGet(r, i - 1)) {
+                ERR("Reverse insert: position %" PRIu64 " not set!", i - 1);
+            }
         }
 
-        /* Remove again - should return false */
-        wasSet = multiroarRemove(r, 200);
-        if (wasSet) {
-            ERRR("wasSet should be false for already-cleared bit");
+        /* Verify all positions are set */
+        for (uint64_t i = 0; i < testCount; i++) {
+            if (!multiroarBitGet(r, i)) {
+                ERR("Reverse insert: position %" PRIu64 " lost!", i);
+            }
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarRemove - remove from FULL_BITMAP") {
+    TEST("random order insertion with verification") {
+        /* Insert bits in pseudo-random order using LCG */
         multiroar *r = multiroarBitNew();
-        /* Fill enough bits to trigger FULL_BITMAP mode (>629) */
-        for (uint64_t i = 0; i < 1000; i++) {
-            multiroarBitSet(r, i);
-        }
+        const uint64_t testCount = 500;
+        uint64_t *positions = zcalloc(testCount, sizeof(uint64_t));
 
-        if (!multiroarBitGet(r, 500)) {
-            ERRR("bit 500 should be set");
-        }
-        bool wasSet = multiroarRemove(r, 500);
-        if (!wasSet) {
-            ERRR("wasSet should be true");
-        }
-        if (multiroarBitGet(r, 500)) {
-            ERRR("bit 500 should be clear");
+        /* Generate pseudo-random positions */
+        uint32_t seed = 12345;
+        for (uint64_t i = 0; i < testCount; i++) {
+            seed = seed * 1103515245 + 12345;
+            positions[i] = (seed >> 8) % 10000;
         }
 
-        /* Other bits should still be set */
-        if (!multiroarBitGet(r, 499)) {
-            ERRR("bit 499 should still be set");
+        /* Insert all positions */
+        for (uint64_t i = 0; i < testCount; i++) {
+            multiroarBitSet(r, positions[i]);
         }
-        if (!multiroarBitGet(r, 501)) {
-            ERRR("bit 501 should still be set");
+
+        /* Verify all positions are set */
+        for (uint64_t i = 0; i < testCount; i++) {
+            if (!multiroarBitGet(r, positions[i])) {
+                ERR("Random order: position %" PRIu64 " not set!",
+                    positions[i]);
+            }
         }
 
+        zfree(positions);
         multiroarFree(r);
     }
 
-    TEST("multiroarRemove - remove all bits from chunk") {
+    TEST("chunk type transitions (UNDER_FULL -> FULL_BITMAP)") {
+        /* Carefully test the transition from UNDER_FULL to FULL_BITMAP */
         multiroar *r = multiroarBitNew();
-        multiroarBitSet(r, 100);
 
-        bool wasSet = multiroarRemove(r, 100);
-        if (!wasSet) {
-            ERRR("wasSet should be true");
+        /* Insert 628 positions (just under threshold) */
+        for (uint64_t i = 0; i < 628; i++) {
+            multiroarBitSet(r, i);
+            if (!multiroarBitGet(r, i)) {
+                ERR("Pre-transition: position %" PRIu64 " not set!", i);
+            }
         }
-        if (multiroarBitGet(r, 100)) {
-            ERRR("bit 100 should be clear");
+
+        /* Insert 629th position - triggers transition */
+        multiroarBitSet(r, 628);
+        if (!multiroarBitGet(r, 628)) {
+            ERRR("Transition position 628 not set!");
         }
 
-        /* Chunk should be gone, but we can still add to it */
-        multiroarBitSet(r, 100);
-        if (!multiroarBitGet(r, 100)) {
-            ERRR("bit 100 should be set again");
+        /* Verify all previous positions survived transition */
+        for (uint64_t i = 0; i < 629; i++) {
+            if (!multiroarBitGet(r, i)) {
+                ERR("Post-transition: position %" PRIu64 " lost!", i);
+            }
+        }
+
+        /* Continue inserting to verify bitmap mode works */
+        for (uint64_t i = 629; i < 1000; i++) {
+            multiroarBitSet(r, i);
+            if (!multiroarBitGet(r, i)) {
+                ERR("Bitmap mode: position %" PRIu64 " not set!", i);
+            }
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarDuplicate - basic clone") {
+    TEST("OVER_FULL transition (FULL_BITMAP -> negative list)") {
+        /* Test transition to OVER_FULL when most bits are set */
         multiroar *r = multiroarBitNew();
-        multiroarBitSet(r, 100);
-        multiroarBitSet(r, 200);
-        multiroarBitSet(r, 10000);
+        const uint64_t chunkBits = 8192;
+        const uint64_t threshold = 7564; /* Just past OVER_FULL threshold */
 
-        multiroar *dup = multiroarDuplicate(r);
-        if (dup == NULL) {
-            ERRR("dup should not be NULL");
-        }
-        if (dup == r) {
-            ERRR("dup should be different pointer");
-        }
+        /* Set bits sequentially up to threshold */
+        for (uint64_t i = 0; i < threshold; i++) {
+            multiroarBitSet(r, i);
 
-        /* Verify all bits match */
-        if (!multiroarBitGet(dup, 100)) {
-            ERRR("dup bit 100 should be set");
-        }
-        if (!multiroarBitGet(dup, 200)) {
-            ERRR("dup bit 200 should be set");
+            /* Verify immediately */
+            if (!multiroarBitGet(r, i)) {
+                ERR("OVER_FULL transition: position %" PRIu64
+                    " not set immediately!",
+                    i);
+            }
         }
-        if (!multiroarBitGet(dup, 10000)) {
-            ERRR("dup bit 10000 should be set");
+
+        /* Verify all positions still set after potential transition */
+        uint64_t failures = 0;
+        for (uint64_t i = 0; i < threshold; i++) {
+            if (!multiroarBitGet(r, i)) {
+                if (failures < 10) {
+                    ERR("OVER_FULL: position %" PRIu64 " lost!", i);
+                }
+                failures++;
+            }
         }
-        if (multiroarBitGet(dup, 101)) {
-            ERRR("dup bit 101 should be clear");
+        if (failures > 10) {
+            printf("... and %" PRIu64 " more positions lost\n", failures - 10);
         }
 
-        /* Modifications to original shouldn't affect dup */
-        multiroarBitSet(r, 999);
-        if (!multiroarBitGet(r, 999)) {
-            ERRR("original bit 999 should be set");
-        }
-        if (multiroarBitGet(dup, 999)) {
-            ERRR("dup bit 999 should be clear");
+        /* Verify positions past threshold are NOT set */
+        for (uint64_t i = threshold; i < chunkBits; i += 100) {
+            if (multiroarBitGet(r, i)) {
+                ERR("OVER_FULL: position %" PRIu64 " incorrectly set!", i);
+            }
         }
 
         multiroarFree(r);
-        multiroarFree(dup);
     }
 
-    TEST("multiroarOr - basic OR operation") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("ALL_1 transition (fill entire chunk)") {
+        /* Fill an entire chunk to trigger ALL_1 type */
+        multiroar *r = multiroarBitNew();
+        const uint64_t chunkBits = 8192;
 
-        multiroarBitSet(a, 100);
-        multiroarBitSet(a, 200);
-        multiroarBitSet(b, 200);
-        multiroarBitSet(b, 300);
+        printf("    Filling entire chunk (%" PRIu64 " bits)...\n", chunkBits);
 
-        multiroarOr(a, b);
+        /* Set all bits in chunk 0 */
+        for (uint64_t i = 0; i < chunkBits; i++) {
+            multiroarBitSet(r, i);
 
-        /* a should have: 100, 200, 300 */
-        if (!multiroarBitGet(a, 100)) {
-            ERRR("OR: bit 100 should be set");
-        }
-        if (!multiroarBitGet(a, 200)) {
-            ERRR("OR: bit 200 should be set");
+            /* Periodic verification */
+            if (i % 1000 == 0 || i == chunkBits - 1) {
+                if (!multiroarBitGet(r, i)) {
+                    ERR("ALL_1 fill: position %" PRIu64 " not set!", i);
+                }
+            }
         }
-        if (!multiroarBitGet(a, 300)) {
-            ERRR("OR: bit 300 should be set");
+
+        /* Verify all bits in chunk are set */
+        uint64_t failures = 0;
+        for (uint64_t i = 0; i < chunkBits; i++) {
+            if (!multiroarBitGet(r, i)) {
+                if (failures < 5) {
+                    ERR("ALL_1 verify: position %" PRIu64 " not set!", i);
+                }
+                failures++;
+            }
         }
-        if (multiroarBitGet(a, 150)) {
-            ERRR("OR: bit 150 should be clear");
+        if (failures > 5) {
+            printf("    ... and %" PRIu64
+                   " more bits not set (total failures: %" PRIu64 ")\n",
+                   failures - 5, failures);
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-    }
-
-    TEST("multiroarAnd - basic AND operation") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
-
-        multiroarBitSet(a, 100);
-        multiroarBitSet(a, 200);
-        multiroarBitSet(a, 300);
-        multiroarBitSet(b, 200);
-        multiroarBitSet(b, 300);
-        multiroarBitSet(b, 400);
-
-        multiroarAnd(a, b);
-
-        /* a should have: 200, 300 (intersection) */
-        if (multiroarBitGet(a, 100)) {
-            ERRR("AND: bit 100 should be clear");
-        }
-        if (!multiroarBitGet(a, 200)) {
-            ERRR("AND: bit 200 should be set");
+        /* Verify bits in next chunk are NOT set */
+        if (multiroarBitGet(r, chunkBits)) {
+            ERRR("Bit in next chunk should not be set!");
         }
-        if (!multiroarBitGet(a, 300)) {
-            ERRR("AND: bit 300 should be set");
+        if (multiroarBitGet(r, chunkBits + 100)) {
+            ERRR("Bit in next chunk should not be set!");
         }
-        if (multiroarBitGet(a, 400)) {
-            ERRR("AND: bit 400 should be clear");
+
+        /* Setting a bit in the ALL_1 chunk should return true (already set) */
+        bool prev = multiroarBitSet(r, 4096);
+        if (!prev) {
+            ERRR("ALL_1: setting existing bit should return true!");
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
+        multiroarFree(r);
     }
 
-    TEST("multiroarXor - basic XOR operation") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("mixed chunk types in single roar") {
+        /* Create a roar with all different chunk types */
+        multiroar *r = multiroarBitNew();
+        const uint64_t chunkBits = 8192;
 
-        multiroarBitSet(a, 100);
-        multiroarBitSet(a, 200);
-        multiroarBitSet(b, 200);
-        multiroarBitSet(b, 300);
+        /* Chunk 0: UNDER_FULL (sparse, few bits) */
+        multiroarBitSet(r, 10);
+        multiroarBitSet(r, 100);
+        multiroarBitSet(r, 500);
 
-        multiroarXor(a, b);
+        /* Chunk 1: FULL_BITMAP (moderate density) */
+        for (uint64_t i = chunkBits; i < chunkBits + 2000; i++) {
+            multiroarBitSet(r, i);
+        }
 
-        /* a should have: 100, 300 (symmetric difference) */
-        if (!multiroarBitGet(a, 100)) {
-            ERRR("XOR: bit 100 should be set");
+        /* Chunk 2: High density (triggers OVER_FULL if working) */
+        for (uint64_t i = chunkBits * 2; i < chunkBits * 2 + 7600; i++) {
+            multiroarBitSet(r, i);
         }
-        if (multiroarBitGet(a, 200)) {
-            ERRR("XOR: bit 200 should be clear");
+
+        /* Verify chunk 0 */
+        if (!multiroarBitGet(r, 10) || !multiroarBitGet(r, 100) ||
+            !multiroarBitGet(r, 500)) {
+            ERRR("Chunk 0 bits not set!");
         }
-        if (!multiroarBitGet(a, 300)) {
-            ERRR("XOR: bit 300 should be set");
+        if (multiroarBitGet(r, 50) || multiroarBitGet(r, 200)) {
+            ERRR("Chunk 0 has unexpected bits set!");
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
+        /* Verify chunk 1 */
+        for (uint64_t i = chunkBits; i < chunkBits + 2000; i += 100) {
+            if (!multiroarBitGet(r, i)) {
+                ERR("Chunk 1 position %" PRIu64 " not set!", i);
+            }
+        }
+
+        /* Verify chunk 2 */
+        for (uint64_t i = chunkBits * 2; i < chunkBits * 2 + 7600; i += 100) {
+            if (!multiroarBitGet(r, i)) {
+                ERR("Chunk 2 position %" PRIu64 " not set!", i);
+            }
+        }
+
+        multiroarFree(r);
     }
 
-    TEST("multiroarNot - basic NOT operation") {
+    TEST("packed array sorted insertion stress") {
+        /* Stress test the sorted insertion in UNDER_FULL mode */
         multiroar *r = multiroarBitNew();
-        /* Set specific bits in a chunk */
-        multiroarBitSet(r, 0);
-        multiroarBitSet(r, 1);
-        multiroarBitSet(r, 100);
-
-        multiroarNot(r);
 
-        /* The set bits should now be clear, unset bits should be set */
-        if (multiroarBitGet(r, 0)) {
-            ERRR("NOT: bit 0 should be clear");
-        }
-        if (multiroarBitGet(r, 1)) {
-            ERRR("NOT: bit 1 should be clear");
-        }
-        if (multiroarBitGet(r, 100)) {
-            ERRR("NOT: bit 100 should be clear");
-        }
-        if (!multiroarBitGet(r, 2)) {
-            ERRR("NOT: bit 2 should be set");
-        }
-        if (!multiroarBitGet(r, 50)) {
-            ERRR("NOT: bit 50 should be set");
-        }
-        if (!multiroarBitGet(r, 8191)) {
-            ERRR("NOT: bit 8191 should be set");
+        /* Insert positions that stress the sorted insert algorithm */
+        const uint64_t positions[] = {
+            500, 100, 900, 50, 950,  25,  975, 12,  988, 6,  994, 3,
+            997, 1,   999, 0,  1000, 2,   998, 4,   996, 8,  992, 16,
+            984, 32,  968, 64, 936,  128, 872, 256, 744, 512};
+        const uint64_t numPos = sizeof(positions) / sizeof(positions[0]);
+
+        for (uint64_t i = 0; i < numPos; i++) {
+            multiroarBitSet(r, positions[i]);
         }
 
-        /* Bits outside the existing chunk are still 0 */
-        if (multiroarBitGet(r, 8192)) {
-            ERRR("NOT: bit 8192 should be clear");
+        /* Verify all positions are set */
+        for (uint64_t i = 0; i < numPos; i++) {
+            if (!multiroarBitGet(r, positions[i])) {
+                ERR("Sorted insert stress: position %" PRIu64 " not set!",
+                    positions[i]);
+            }
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarNewOr - creates new roar") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
-
-        multiroarBitSet(a, 100);
-        multiroarBitSet(b, 200);
+    TEST("empty chunk queries") {
+        /* Test queries on chunks that don't exist (empty) */
+        multiroar *r = multiroarBitNew();
 
-        multiroar *result = multiroarNewOr(a, b);
-        if (result == NULL) {
-            ERRR("NewOr result should not be NULL");
-        }
-        if (result == a) {
-            ERRR("NewOr result should not be a");
+        /* Query various positions without setting anything */
+        if (multiroarBitGet(r, 0)) {
+            ERRR("Empty roar: position 0 should not be set!");
         }
-        if (result == b) {
-            ERRR("NewOr result should not be b");
+        if (multiroarBitGet(r, 100)) {
+            ERRR("Empty roar: position 100 should not be set!");
         }
-
-        if (!multiroarBitGet(result, 100)) {
-            ERRR("NewOr: bit 100 should be set");
+        if (multiroarBitGet(r, 8192)) {
+            ERRR("Empty roar: position 8192 should not be set!");
         }
-        if (!multiroarBitGet(result, 200)) {
-            ERRR("NewOr: bit 200 should be set");
+        if (multiroarBitGet(r, SIZE_MAX / 2)) {
+            ERRR("Empty roar: large position should not be set!");
         }
 
-        /* Originals unchanged */
-        if (multiroarBitGet(a, 200)) {
-            ERRR("NewOr: a bit 200 should be clear");
+        /* Set one position, verify others still not set */
+        multiroarBitSet(r, 5000);
+        if (!multiroarBitGet(r, 5000)) {
+            ERRR("Position 5000 should be set!");
         }
-        if (multiroarBitGet(b, 100)) {
-            ERRR("NewOr: b bit 100 should be clear");
+        if (multiroarBitGet(r, 4999) || multiroarBitGet(r, 5001)) {
+            ERRR("Adjacent positions should not be set!");
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(result);
+        multiroarFree(r);
     }
 
-    TEST("FUZZ: set operations with oracle verification") {
-        printf("  Testing set operations with oracle...\n");
-
-#define FUZZ_OP_SIZE 500
-        uint64_t oracleA[divCeil(FUZZ_OP_SIZE, 64)] = {0};
-        uint64_t oracleB[divCeil(FUZZ_OP_SIZE, 64)] = {0};
-
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
-
-        /* Populate both with random bits */
-        for (uint64_t i = 0; i < 200; i++) {
-            uint64_t posA = rand() % FUZZ_OP_SIZE;
-            uint64_t posB = rand() % FUZZ_OP_SIZE;
-            multiroarBitSet(a, posA);
-            multiroarBitSet(b, posB);
-            FUZZ_ORACLE_SET(oracleA, posA);
-            FUZZ_ORACLE_SET(oracleB, posB);
-        }
+    TEST("PERF: sparse lookup performance") {
+        const uint64_t numPositions = 1000;
+        const uint64_t positionSpread = 1000000;
+        multiroar *r = multiroarBitNew();
 
-        /* Test OR */
-        multiroar *orResult = multiroarNewOr(a, b);
-        uint64_t orMismatches = 0;
-        for (uint64_t i = 0; i < FUZZ_OP_SIZE; i++) {
-            bool expected =
-                FUZZ_ORACLE_GET(oracleA, i) || FUZZ_ORACLE_GET(oracleB, i);
-            bool actual = multiroarBitGet(orResult, i);
-            if (expected != actual) {
-                orMismatches++;
-            }
-        }
-        if (orMismatches > 0) {
-            ERR("OR operation: %" PRIu64 " mismatches", orMismatches);
+        /* Create sparse bitmap across many chunks */
+        for (uint64_t i = 0; i < numPositions; i++) {
+            multiroarBitSet(r, i * positionSpread);
         }
-        multiroarFree(orResult);
 
-        /* Test AND */
-        multiroar *andResult = multiroarNewAnd(a, b);
-        uint64_t andMismatches = 0;
-        for (uint64_t i = 0; i < FUZZ_OP_SIZE; i++) {
-            bool expected =
-                FUZZ_ORACLE_GET(oracleA, i) && FUZZ_ORACLE_GET(oracleB, i);
-            bool actual = multiroarBitGet(andResult, i);
-            if (expected != actual) {
-                andMismatches++;
+        int64_t startNs = timeUtilMonotonicNs();
+        for (uint64_t round = 0; round < 100; round++) {
+            for (uint64_t i = 0; i < numPositions; i++) {
+                multiroarBitGet(r, i * positionSpread);
             }
         }
-        if (andMismatches > 0) {
-            ERR("AND operation: %" PRIu64 " mismatches", andMismatches);
-        }
-        multiroarFree(andResult);
+        int64_t elapsed = timeUtilMonotonicNs() - startNs;
+        printf("Sparse lookup: %.1f ns/op, %.0f ops/sec\n",
+               (double)elapsed / (numPositions * 100),
+               (numPositions * 100) / (elapsed / 1e9));
 
-        /* Test XOR */
-        multiroar *xorResult = multiroarNewXor(a, b);
-        uint64_t xorMismatches = 0;
-        for (uint64_t i = 0; i < FUZZ_OP_SIZE; i++) {
-            bool expected =
-                FUZZ_ORACLE_GET(oracleA, i) != FUZZ_ORACLE_GET(oracleB, i);
-            bool actual = multiroarBitGet(xorResult, i);
-            if (expected != actual) {
-                xorMismatches++;
-            }
-        }
-        if (xorMismatches > 0) {
-            ERR("XOR operation: %" PRIu64 " mismatches", xorMismatches);
-        }
-        multiroarFree(xorResult);
+        multiroarFree(r);
+    }
 
-        /* Test NOT */
-        multiroar *notResult = multiroarDuplicate(a);
-        multiroarNot(notResult);
-        uint64_t notMismatches = 0;
-        for (uint64_t i = 0; i < FUZZ_OP_SIZE; i++) {
-            bool expected = !FUZZ_ORACLE_GET(oracleA, i);
-            bool actual = multiroarBitGet(notResult, i);
-            if (expected != actual) {
-                notMismatches++;
-            }
-        }
-        if (notMismatches > 0) {
-            ERR("NOT operation: %" PRIu64 " mismatches (within existing chunk)",
-                notMismatches);
-        }
-        multiroarFree(notResult);
+    /* ========================================
+     * FUZZ TESTS - Oracle-Based Verification
+     * ======================================== */
+    printf("\n=== MULTIROAR FUZZ TESTING ===\n\n");
 
-        printf("  OR=%" PRIu64 " AND=%" PRIu64 " XOR=%" PRIu64 " NOT=%" PRIu64
-               " mismatches\n",
-               orMismatches, andMismatches, xorMismatches, notMismatches);
+/* Simple bitmap oracle - just use bits in an array of uint64_t */
+#define FUZZ_ORACLE_MAX_BIT 100000
+#define FUZZ_ORACLE_WORDS ((FUZZ_ORACLE_MAX_BIT + 63) / 64)
+#define FUZZ_ORACLE_SET(oracle, pos)                                           \
+    ((oracle)[(pos) / 64] |= (1ULL << ((pos) % 64)))
+#define FUZZ_ORACLE_CLEAR(oracle, pos)                                         \
+    ((oracle)[(pos) / 64] &= ~(1ULL << ((pos) % 64)))
+#define FUZZ_ORACLE_GET(oracle, pos)                                           \
+    (((oracle)[(pos) / 64] >> ((pos) % 64)) & 1)
 
-        multiroarFree(a);
-        multiroarFree(b);
-#undef FUZZ_OP_SIZE
-    }
+    TEST("FUZZ: random bit operations with oracle") {
+        multiroar *r = multiroarBitNew();
+        uint64_t oracle[FUZZ_ORACLE_WORDS] = {0};
 
-    TEST("FUZZ: Remove operations with oracle") {
-        printf("  Testing remove operations...\n");
+        srand(12345);
+        const uint64_t numOps = 10000;
+        uint64_t setOps = 0, getOps = 0;
 
-#define FUZZ_REMOVE_SIZE 2000
-        uint64_t oracle[divCeil(FUZZ_REMOVE_SIZE, 64)] = {0};
-        multiroar *r = multiroarBitNew();
+        for (uint64_t i = 0; i < numOps; i++) {
+            uint64_t pos = (uint64_t)rand() % FUZZ_ORACLE_MAX_BIT;
+            int op = rand() % 10;
 
-        /* First add some bits */
-        for (uint64_t i = 0; i < 500; i++) {
-            uint64_t pos = rand() % FUZZ_REMOVE_SIZE;
-            multiroarBitSet(r, pos);
-            FUZZ_ORACLE_SET(oracle, pos);
-        }
+            if (op < 7) {
+                /* Set operation (70%) */
+                bool mrPrev = multiroarBitSet(r, pos);
+                bool oraclePrev = FUZZ_ORACLE_GET(oracle, pos);
+                FUZZ_ORACLE_SET(oracle, pos);
 
-        /* Then remove some */
-        for (uint64_t i = 0; i < 200; i++) {
-            uint64_t pos = rand() % FUZZ_REMOVE_SIZE;
-            bool expectedWasSet = FUZZ_ORACLE_GET(oracle, pos);
-            bool actualWasSet = multiroarRemove(r, pos);
+                if (mrPrev != oraclePrev) {
+                    ERR("Set at %" PRIu64
+                        ": multiroar said prev=%d, oracle said "
+                        "prev=%d",
+                        pos, mrPrev, oraclePrev);
+                }
+                setOps++;
+            } else {
+                /* Get operation (30%) */
+                bool mrVal = multiroarBitGet(r, pos);
+                bool oracleVal = FUZZ_ORACLE_GET(oracle, pos);
 
-            if (expectedWasSet != actualWasSet) {
-                ERR("Remove wasSet mismatch at pos %" PRIu64 "", pos);
+                if (mrVal != oracleVal) {
+                    ERR("Get at %" PRIu64 ": multiroar=%d, oracle=%d", pos,
+                        mrVal, oracleVal);
+                }
+                getOps++;
             }
-            FUZZ_ORACLE_CLEAR(oracle, pos);
         }
 
-        /* Verify final state */
+        /* Full verification */
         uint64_t mismatches = 0;
-        for (uint64_t i = 0; i < FUZZ_REMOVE_SIZE; i++) {
-            if (FUZZ_ORACLE_GET(oracle, i) != multiroarBitGet(r, i)) {
+        for (uint64_t pos = 0; pos < FUZZ_ORACLE_MAX_BIT; pos++) {
+            bool mrVal = multiroarBitGet(r, pos);
+            bool oracleVal = FUZZ_ORACLE_GET(oracle, pos);
+            if (mrVal != oracleVal) {
+                if (mismatches < 10) {
+                    ERR("Final verify at %" PRIu64 ": multiroar=%d, oracle=%d",
+                        pos, mrVal, oracleVal);
+                }
                 mismatches++;
             }
         }
 
         if (mismatches > 0) {
-            ERR("Remove verification: %" PRIu64 " mismatches", mismatches);
+            ERR("Total mismatches: %" PRIu64 "", mismatches);
         }
 
-        printf("  add=500 remove=200 mismatches=%" PRIu64 "\n", mismatches);
+        printf("  set=%" PRIu64 " get=%" PRIu64 " verified=%d\n", setOps,
+               getOps, FUZZ_ORACLE_MAX_BIT);
         multiroarFree(r);
-#undef FUZZ_REMOVE_SIZE
     }
 
-    TEST("FUZZ: Set operations across multiple chunks") {
-        printf("  Testing multi-chunk set operations...\n");
+    TEST("FUZZ: sequential then random access") {
+        multiroar *r = multiroarBitNew();
+        uint64_t oracle[FUZZ_ORACLE_WORDS] = {0};
 
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+        /* Sequential fill */
+        for (uint64_t i = 0; i < 5000; i++) {
+            multiroarBitSet(r, i);
+            FUZZ_ORACLE_SET(oracle, i);
+        }
 
-        /* Set bits across multiple chunks */
-        for (uint64_t chunk = 0; chunk < 5; chunk++) {
-            uint64_t base = chunk * 8192;
-            for (uint64_t i = 0; i < 100; i++) {
-                multiroarBitSet(a, base + i * 10);
-                multiroarBitSet(b, base + i * 10 + 5);
+        /* Random access verification */
+        srand(54321);
+        for (uint64_t i = 0; i < 10000; i++) {
+            uint64_t pos = (uint64_t)rand() % FUZZ_ORACLE_MAX_BIT;
+            bool mrVal = multiroarBitGet(r, pos);
+            bool oracleVal = FUZZ_ORACLE_GET(oracle, pos);
+
+            if (mrVal != oracleVal) {
+                ERR("Pos %" PRIu64 ": multiroar=%d, oracle=%d", pos, mrVal,
+                    oracleVal);
             }
         }
 
-        /* OR should combine both */
-        multiroar *orResult = multiroarNewOr(a, b);
-        uint64_t orCount = 0;
-        for (uint64_t chunk = 0; chunk < 5; chunk++) {
-            uint64_t base = chunk * 8192;
-            for (uint64_t i = 0; i < 100; i++) {
-                if (multiroarBitGet(orResult, base + i * 10)) {
-                    orCount++;
-                }
-                if (multiroarBitGet(orResult, base + i * 10 + 5)) {
-                    orCount++;
-                }
-            }
+        printf("  sequential fill 5000, random verify 10000\n");
+        multiroarFree(r);
+    }
+
+    TEST("FUZZ: sparse bits across many chunks") {
+        multiroar *r = multiroarBitNew();
+
+        srand(99999);
+        const uint64_t numSparse = 1000;
+        uint64_t *positions = zmalloc(numSparse * sizeof(uint64_t));
+
+        /* Generate sparse positions across many chunks (8192 bits per chunk) */
+        for (uint64_t i = 0; i < numSparse; i++) {
+            /* Spread across up to 1000 chunks */
+            positions[i] =
+                ((uint64_t)rand() % 1000) * 8192 + ((uint64_t)rand() % 8192);
+            multiroarBitSet(r, positions[i]);
         }
-        if (orCount != 1000) {
-            ERR("multi-chunk OR: expected 1000 bits, got %" PRIu64 "", orCount);
+
+        /* Verify all set positions */
+        for (uint64_t i = 0; i < numSparse; i++) {
+            if (!multiroarBitGet(r, positions[i])) {
+                ERR("Sparse position %" PRIu64 " not set!", positions[i]);
+            }
         }
 
-        /* AND should be empty (no overlap) */
-        multiroar *andResult = multiroarNewAnd(a, b);
-        uint64_t andCount = 0;
-        for (uint64_t chunk = 0; chunk < 5; chunk++) {
-            uint64_t base = chunk * 8192;
-            for (uint64_t i = 0; i < 200; i++) {
-                if (multiroarBitGet(andResult, base + i)) {
-                    andCount++;
+        /* Verify some unset positions */
+        uint64_t verified = 0;
+        for (uint64_t chunk = 0; chunk < 100; chunk++) {
+            for (uint64_t offset = 0; offset < 100; offset++) {
+                uint64_t pos =
+                    chunk * 8192 + offset * 80 + 40; /* Unlikely to be set */
+                bool isSet = multiroarBitGet(r, pos);
+                bool shouldBeSet = false;
+
+                for (uint64_t i = 0; i < numSparse; i++) {
+                    if (positions[i] == pos) {
+                        shouldBeSet = true;
+                        break;
+                    }
+                }
+
+                if (isSet != shouldBeSet) {
+                    ERR("Unset verify at %" PRIu64 ": got %d expected %d", pos,
+                        isSet, shouldBeSet);
                 }
+                verified++;
             }
         }
-        if (andCount != 0) {
-            ERR("multi-chunk AND: expected 0 bits, got %" PRIu64 "", andCount);
-        }
-
-        printf("  multi-chunk: OR count=%" PRIu64 ", AND count=%" PRIu64 "\n",
-               orCount, andCount);
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(orResult);
-        multiroarFree(andResult);
+        printf("  sparse bits=%" PRIu64 ", verified unset=%" PRIu64 "\n",
+               numSparse, verified);
+        zfree(positions);
+        multiroarFree(r);
     }
 
-    TEST("set operations with dense bitmaps") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("FUZZ: chunk boundary stress") {
+        multiroar *r = multiroarBitNew();
+        uint64_t oracle[FUZZ_ORACLE_WORDS] = {0};
+        const uint64_t chunkBits = 8192;
 
-        /* Fill to trigger FULL_BITMAP mode */
-        for (uint64_t i = 0; i < 2000; i++) {
-            multiroarBitSet(a, i);
-        }
-        for (uint64_t i = 1000; i < 3000; i++) {
-            multiroarBitSet(b, i);
-        }
+        srand(77777);
 
-        /* AND should give intersection: 1000-1999 */
-        multiroar *andResult = multiroarNewAnd(a, b);
-        uint64_t errors = 0;
-        for (uint64_t i = 0; i < 1000; i++) {
-            if (multiroarBitGet(andResult, i)) {
-                errors++;
-            }
-        }
-        for (uint64_t i = 1000; i < 2000; i++) {
-            if (!multiroarBitGet(andResult, i)) {
-                errors++;
+        /* Set bits around chunk boundaries */
+        for (uint64_t chunk = 0; chunk < 10; chunk++) {
+            uint64_t base = chunk * chunkBits;
+
+            /* Around boundary start */
+            for (int offset = -5; offset <= 5; offset++) {
+                if (base + offset < FUZZ_ORACLE_MAX_BIT) {
+                    uint64_t pos = base + offset;
+                    if (rand() % 2) {
+                        multiroarBitSet(r, pos);
+                        FUZZ_ORACLE_SET(oracle, pos);
+                    }
+                }
             }
-        }
-        for (uint64_t i = 2000; i < 3000; i++) {
-            if (multiroarBitGet(andResult, i)) {
-                errors++;
+
+            /* Around boundary end */
+            if (base + chunkBits - 1 < FUZZ_ORACLE_MAX_BIT) {
+                for (int offset = -5; offset <= 5; offset++) {
+                    uint64_t pos = base + chunkBits - 1 + offset;
+                    if (pos < FUZZ_ORACLE_MAX_BIT && rand() % 2) {
+                        multiroarBitSet(r, pos);
+                        FUZZ_ORACLE_SET(oracle, pos);
+                    }
+                }
             }
         }
-        if (errors > 0) {
-            ERR("dense AND: %" PRIu64 " bit errors", errors);
-        }
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(andResult);
-    }
+        /* Verify around boundaries */
+        uint64_t mismatches = 0;
+        for (uint64_t chunk = 0; chunk < 10; chunk++) {
+            uint64_t base = chunk * chunkBits;
 
-    printf("\n=== All multiroar fuzz tests completed! ===\n\n");
+            for (int offset = -10; offset <= (int)chunkBits + 10; offset++) {
+                uint64_t pos = base + offset;
+                if (pos >= FUZZ_ORACLE_MAX_BIT) {
+                    continue;
+                }
 
-    /* ========================================
-     * BITCOUNT TESTS
-     * ======================================== */
-    printf("\n=== BITCOUNT TESTS ===\n\n");
+                bool mrVal = multiroarBitGet(r, pos);
+                bool oracleVal = FUZZ_ORACLE_GET(oracle, pos);
 
-    TEST("multiroarBitCount - empty roar") {
-        multiroar *r = multiroarBitNew();
-        uint64_t count = multiroarBitCount(r);
-        if (count != 0) {
-            ERR("Empty roar should have count=0, got %" PRIu64 "", count);
+                if (mrVal != oracleVal) {
+                    if (mismatches < 5) {
+                        ERR("Boundary pos %" PRIu64 " (chunk %" PRIu64
+                            ", offset %d): mr=%d "
+                            "oracle=%d",
+                            pos, chunk, offset, mrVal, oracleVal);
+                    }
+                    mismatches++;
+                }
+            }
         }
-        multiroarFree(r);
-    }
 
-    TEST("multiroarBitCount - single bit") {
-        multiroar *r = multiroarBitNew();
-        multiroarBitSet(r, 100);
-        uint64_t count = multiroarBitCount(r);
-        if (count != 1) {
-            ERR("Single bit should have count=1, got %" PRIu64 "", count);
-        }
+        printf("  tested 10 chunk boundaries, mismatches=%" PRIu64 "\n",
+               mismatches);
         multiroarFree(r);
     }
 
-    TEST("multiroarBitCount - sparse chunk") {
+    TEST("FUZZ: duplicate set operations") {
         multiroar *r = multiroarBitNew();
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(r, i * 10);
-        }
-        uint64_t count = multiroarBitCount(r);
-        if (count != 100) {
-            ERR("Sparse chunk should have count=100, got %" PRIu64 "", count);
-        }
-        multiroarFree(r);
-    }
 
-    TEST("multiroarBitCount - dense chunk") {
-        multiroar *r = multiroarBitNew();
-        /* Set 1000 bits to trigger FULL_BITMAP */
-        for (uint64_t i = 0; i < 1000; i++) {
-            multiroarBitSet(r, i);
-        }
-        uint64_t count = multiroarBitCount(r);
-        if (count != 1000) {
-            ERR("Dense chunk should have count=1000, got %" PRIu64 "", count);
-        }
-        multiroarFree(r);
-    }
+        srand(11111);
+        const uint64_t numUnique = 500;
+        uint64_t *positions = zmalloc(numUnique * sizeof(uint64_t));
 
-    TEST("multiroarBitCount - full chunk (ALL_1)") {
-        multiroar *r = multiroarBitNew();
-        /* Set all 8192 bits in chunk */
-        for (uint64_t i = 0; i < 8192; i++) {
-            multiroarBitSet(r, i);
-        }
-        uint64_t count = multiroarBitCount(r);
-        if (count != 8192) {
-            ERR("Full chunk should have count=8192, got %" PRIu64 "", count);
+        /* Generate unique positions */
+        for (uint64_t i = 0; i < numUnique; i++) {
+            positions[i] = (uint64_t)rand() % 50000;
         }
-        multiroarFree(r);
-    }
 
-    TEST("multiroarBitCount - multiple chunks") {
-        multiroar *r = multiroarBitNew();
-        /* Chunk 0: 100 bits */
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(r, i);
-        }
-        /* Chunk 1: 50 bits */
-        for (uint64_t i = 0; i < 50; i++) {
-            multiroarBitSet(r, 8192 + i);
+        /* First pass: set all */
+        for (uint64_t i = 0; i < numUnique; i++) {
+            multiroarBitSet(r, positions[i]);
         }
-        /* Chunk 2: 200 bits */
-        for (uint64_t i = 0; i < 200; i++) {
-            multiroarBitSet(r, 16384 + i);
+
+        /* Second pass: set all again, should all report previously set */
+        uint64_t reportedNew = 0;
+        for (uint64_t i = 0; i < numUnique; i++) {
+            bool prev = multiroarBitSet(r, positions[i]);
+            if (!prev) {
+                /* This might happen if we have duplicate positions */
+                bool duplicate = false;
+                for (uint64_t j = 0; j < i; j++) {
+                    if (positions[j] == positions[i]) {
+                        duplicate = true;
+                        break;
+                    }
+                }
+                if (!duplicate) {
+                    reportedNew++;
+                    if (reportedNew <= 5) {
+                        ERR("Position %" PRIu64 " reported new on second set!",
+                            positions[i]);
+                    }
+                }
+            }
         }
-        uint64_t count = multiroarBitCount(r);
-        if (count != 350) {
-            ERR("Multi-chunk should have count=350, got %" PRIu64 "", count);
+
+        /* Verify all still set */
+        for (uint64_t i = 0; i < numUnique; i++) {
+            if (!multiroarBitGet(r, positions[i])) {
+                ERR("Position %" PRIu64 " not set after double-set!",
+                    positions[i]);
+            }
         }
+
+        printf("  double-set %" PRIu64 " positions\n", numUnique);
+        zfree(positions);
         multiroarFree(r);
     }
 
-    TEST("FUZZ: bitcount correctness oracle") {
-        printf("  Testing bitcount with oracle...\n");
+    TEST("FUZZ: adversarial patterns - reverse order") {
         multiroar *r = multiroarBitNew();
-        uint64_t expectedCount = 0;
+        const uint64_t count = 2000;
 
-        srand(33333);
-        for (uint64_t i = 0; i < 10000; i++) {
-            uint64_t pos = (uint64_t)rand() % 100000;
-            if (!multiroarBitGet(r, pos)) {
-                multiroarBitSet(r, pos);
-                expectedCount++;
-            }
+        /* Insert in reverse order - stresses sorted insertion */
+        for (uint64_t i = count; i > 0; i--) {
+            multiroarBitSet(r, i - 1);
         }
 
-        uint64_t actualCount = multiroarBitCount(r);
-        if (actualCount != expectedCount) {
-            ERR("Bitcount mismatch: expected %" PRIu64 ", got %" PRIu64 "",
-                expectedCount, actualCount);
+        /* Verify all set */
+        for (uint64_t i = 0; i < count; i++) {
+            if (!multiroarBitGet(r, i)) {
+                ERR("Reverse insert: position %" PRIu64 " not set!", i);
+            }
         }
 
-        printf("  verified %" PRIu64 " set bits\n", actualCount);
+        printf("  reverse order insert %" PRIu64 " positions\n", count);
         multiroarFree(r);
     }
 
-    /* ========================================
-     * N-WAY OPERATIONS TESTS
-     * ======================================== */
-    printf("\n=== N-WAY OPERATIONS TESTS ===\n\n");
-
-    TEST("multiroarAndN - 3 roars basic") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
-        multiroar *r3 = multiroarBitNew();
+    TEST("FUZZ: adversarial patterns - alternating") {
+        multiroar *r = multiroarBitNew();
+        const uint64_t count = 5000;
 
-        /* r1: 0-99 */
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(r1, i);
-        }
-        /* r2: 50-149 */
-        for (uint64_t i = 50; i < 150; i++) {
-            multiroarBitSet(r2, i);
-        }
-        /* r3: 75-174 */
-        for (uint64_t i = 75; i < 175; i++) {
-            multiroarBitSet(r3, i);
+        /* Set every other bit */
+        for (uint64_t i = 0; i < count * 2; i += 2) {
+            multiroarBitSet(r, i);
         }
 
-        multiroar *roars[] = {r1, r2, r3};
-        multiroar *result = multiroarNewAndN(3, roars);
-
-        /* Intersection: 75-99 = 25 bits */
-        uint64_t count = 0;
-        for (uint64_t i = 0; i < 200; i++) {
-            if (multiroarBitGet(result, i)) {
-                if (i < 75 || i >= 100) {
-                    ERR("AndN: bit %" PRIu64 " should not be set", i);
-                }
-                count++;
+        /* Verify even positions set, odd not set */
+        for (uint64_t i = 0; i < count * 2; i++) {
+            bool expected = (i % 2 == 0);
+            bool actual = multiroarBitGet(r, i);
+            if (actual != expected) {
+                ERR("Alternating at %" PRIu64 ": got %d expected %d", i, actual,
+                    expected);
             }
         }
 
-        if (count != 25) {
-            ERR("AndN: expected 25 bits, got %" PRIu64 "", count);
-        }
-
-        multiroarFree(r1);
-        multiroarFree(r2);
-        multiroarFree(r3);
-        multiroarFree(result);
+        printf("  alternating pattern %" PRIu64 " positions\n", count);
+        multiroarFree(r);
     }
 
-    TEST("multiroarOrN - 3 roars basic") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
-        multiroar *r3 = multiroarBitNew();
-
-        multiroarBitSet(r1, 100);
-        multiroarBitSet(r2, 200);
-        multiroarBitSet(r3, 300);
+    TEST("FUZZ: large position values") {
+        multiroar *r = multiroarBitNew();
 
-        multiroar *roars[] = {r1, r2, r3};
-        multiroar *result = multiroarNewOrN(3, roars);
+        /* Test very large position values - avoid adjacent positions */
+        const uint64_t largePositions[] = {
+            SIZE_MAX - 1,      SIZE_MAX - 200,    SIZE_MAX - 8192,
+            SIZE_MAX - 16384,  SIZE_MAX / 2,      SIZE_MAX / 4,
+            (uint64_t)1 << 40, (uint64_t)1 << 50, (uint64_t)1 << 60};
+        const uint64_t numLarge =
+            sizeof(largePositions) / sizeof(largePositions[0]);
 
-        /* Union: all 3 bits */
-        if (!multiroarBitGet(result, 100)) {
-            ERRR("OrN: bit 100 should be set");
-        }
-        if (!multiroarBitGet(result, 200)) {
-            ERRR("OrN: bit 200 should be set");
+        for (uint64_t i = 0; i < numLarge; i++) {
+            multiroarBitSet(r, largePositions[i]);
         }
-        if (!multiroarBitGet(result, 300)) {
-            ERRR("OrN: bit 300 should be set");
+
+        for (uint64_t i = 0; i < numLarge; i++) {
+            if (!multiroarBitGet(r, largePositions[i])) {
+                ERR("Large position %" PRIu64 " not set!", largePositions[i]);
+            }
         }
 
-        uint64_t count = multiroarBitCount(result);
-        if (count != 3) {
-            ERR("OrN: expected 3 bits, got %" PRIu64 "", count);
+        /* Verify adjacent positions not set (check position - 2 to avoid
+         * collision with positions that differ by 1) */
+        for (uint64_t i = 0; i < numLarge; i++) {
+            if (largePositions[i] > 2) {
+                uint64_t adjacent = largePositions[i] - 2;
+                /* Make sure this adjacent position isn't one we set */
+                bool shouldBeSet = false;
+                for (uint64_t j = 0; j < numLarge; j++) {
+                    if (largePositions[j] == adjacent) {
+                        shouldBeSet = true;
+                        break;
+                    }
+                }
+                if (!shouldBeSet && multiroarBitGet(r, adjacent)) {
+                    ERR("Adjacent-2 to large position %" PRIu64
+                        " incorrectly set!",
+                        largePositions[i]);
+                }
+            }
         }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
-        multiroarFree(r3);
-        multiroarFree(result);
+        printf("  verified %" PRIu64 " large positions\n", numLarge);
+        multiroarFree(r);
     }
 
-    TEST("multiroarXorN - 3 roars basic") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
-        multiroar *r3 = multiroarBitNew();
+    TEST("FUZZ: stress 100K random operations") {
+        multiroar *r = multiroarBitNew();
+        uint64_t oracle[FUZZ_ORACLE_WORDS] = {0};
 
-        multiroarBitSet(r1, 100);
-        multiroarBitSet(r2, 100); /* Cancels out */
-        multiroarBitSet(r3, 100); /* Sets again */
+        srand(88888);
+        const uint64_t numOps = 100000;
 
-        multiroarBitSet(r1, 200);
-        multiroarBitSet(r2, 200); /* Cancels out */
+        for (uint64_t i = 0; i < numOps; i++) {
+            uint64_t pos = (uint64_t)rand() % FUZZ_ORACLE_MAX_BIT;
 
-        multiroarBitSet(r3, 300);
+            bool mrPrev = multiroarBitSet(r, pos);
+            bool oraclePrev = FUZZ_ORACLE_GET(oracle, pos);
+            FUZZ_ORACLE_SET(oracle, pos);
 
-        multiroar *roars[] = {r1, r2, r3};
-        multiroar *result = multiroarNewXorN(3, roars);
+            if (mrPrev != oraclePrev) {
+                ERR("100K stress at %" PRIu64 ": prev mismatch mr=%d oracle=%d",
+                    pos, mrPrev, oraclePrev);
+            }
 
-        /* 100: 1^1^1 = 1 */
-        /* 200: 1^1^0 = 0 */
-        /* 300: 0^0^1 = 1 */
-        if (!multiroarBitGet(result, 100)) {
-            ERRR("XorN: bit 100 should be set");
+            /* Periodic spot check */
+            if (i % 10000 == 0) {
+                uint64_t checkPos = (uint64_t)rand() % FUZZ_ORACLE_MAX_BIT;
+                bool mrVal = multiroarBitGet(r, checkPos);
+                bool oracleVal = FUZZ_ORACLE_GET(oracle, checkPos);
+                if (mrVal != oracleVal) {
+                    ERR("Spot check at round %" PRIu64 " pos %" PRIu64
+                        ": mr=%d oracle=%d",
+                        i, checkPos, mrVal, oracleVal);
+                }
+            }
         }
-        if (multiroarBitGet(result, 200)) {
-            ERRR("XorN: bit 200 should not be set");
+
+        /* Final full verification */
+        uint64_t mismatches = 0;
+        uint64_t bitsSet = 0;
+        for (uint64_t pos = 0; pos < FUZZ_ORACLE_MAX_BIT; pos++) {
+            bool mrVal = multiroarBitGet(r, pos);
+            bool oracleVal = FUZZ_ORACLE_GET(oracle, pos);
+            if (mrVal != oracleVal) {
+                mismatches++;
+            }
+            if (oracleVal) {
+                bitsSet++;
+            }
         }
-        if (!multiroarBitGet(result, 300)) {
-            ERRR("XorN: bit 300 should be set");
+
+        if (mismatches > 0) {
+            ERR("100K stress final: %" PRIu64 " mismatches", mismatches);
         }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
-        multiroarFree(r3);
-        multiroarFree(result);
+        printf("  100K ops, %" PRIu64 " unique bits set, %" PRIu64
+               " mismatches\n",
+               bitsSet, mismatches);
+        multiroarFree(r);
+    }
+
+    printf("\n=== NEW FUNCTIONALITY TESTS ===\n\n");
+
+    TEST("multiroarRemove - basic remove from UNDER_FULL") {
+        multiroar *r = multiroarBitNew();
+        multiroarBitSet(r, 100);
+        multiroarBitSet(r, 200);
+        multiroarBitSet(r, 300);
+
+        if (!multiroarBitGet(r, 100)) {
+            ERRR("bit 100 should be set");
+        }
+        if (!multiroarBitGet(r, 200)) {
+            ERRR("bit 200 should be set");
+        }
+        if (!multiroarBitGet(r, 300)) {
+            ERRR("bit 300 should be set");
+        }
+
+        /* Remove middle element */
+        bool wasSet = multiroarRemove(r, 200);
+        if (!wasSet) {
+            ERRR("wasSet should be true for bit 200");
+        }
+        if (multiroarBitGet(r, 200)) {
+            ERRR("bit 200 should be clear after remove");
+        }
+        if (!multiroarBitGet(r, 100)) {
+            ERRR("bit 100 should still be set");
+        }
+        if (!multiroarBitGet(r, 300)) {
+            ERRR("bit 300 should still be set");
+        }
+
+        /* Remove again - should return false */
+        wasSet = multiroarRemove(r, 200);
+        if (wasSet) {
+            ERRR("wasSet should be false for already-cleared bit");
+        }
+
+        multiroarFree(r);
+    }
+
+    TEST("multiroarRemove - remove from FULL_BITMAP") {
+        multiroar *r = multiroarBitNew();
+        /* Fill enough bits to trigger FULL_BITMAP mode (>629) */
+        for (uint64_t i = 0; i < 1000; i++) {
+            multiroarBitSet(r, i);
+        }
+
+        if (!multiroarBitGet(r, 500)) {
+            ERRR("bit 500 should be set");
+        }
+        bool wasSet = multiroarRemove(r, 500);
+        if (!wasSet) {
+            ERRR("wasSet should be true");
+        }
+        if (multiroarBitGet(r, 500)) {
+            ERRR("bit 500 should be clear");
+        }
+
+        /* Other bits should still be set */
+        if (!multiroarBitGet(r, 499)) {
+            ERRR("bit 499 should still be set");
+        }
+        if (!multiroarBitGet(r, 501)) {
+            ERRR("bit 501 should still be set");
+        }
+
+        multiroarFree(r);
+    }
+
+    TEST("multiroarRemove - remove all bits from chunk") {
+        multiroar *r = multiroarBitNew();
+        multiroarBitSet(r, 100);
+
+        bool wasSet = multiroarRemove(r, 100);
+        if (!wasSet) {
+            ERRR("wasSet should be true");
+        }
+        if (multiroarBitGet(r, 100)) {
+            ERRR("bit 100 should be clear");
+        }
+
+        /* Chunk should be gone, but we can still add to it */
+        multiroarBitSet(r, 100);
+        if (!multiroarBitGet(r, 100)) {
+            ERRR("bit 100 should be set again");
+        }
+
+        multiroarFree(r);
+    }
+
+    TEST("multiroarDuplicate - basic clone") {
+        multiroar *r = multiroarBitNew();
+        multiroarBitSet(r, 100);
+        multiroarBitSet(r, 200);
+        multiroarBitSet(r, 10000);
+
+        multiroar *dup = multiroarDuplicate(r);
+        if (dup == NULL) {
+            ERRR("dup should not be NULL");
+        }
+        if (dup == r) {
+            ERRR("dup should be different pointer");
+        }
+
+        /* Verify all bits match */
+        if (!multiroarBitGet(dup, 100)) {
+            ERRR("dup bit 100 should be set");
+        }
+        if (!multiroarBitGet(dup, 200)) {
+            ERRR("dup bit 200 should be set");
+        }
+        if (!multiroarBitGet(dup, 10000)) {
+            ERRR("dup bit 10000 should be set");
+        }
+        if (multiroarBitGet(dup, 101)) {
+            ERRR("dup bit 101 should be clear");
+        }
+
+        /* Modifications to original shouldn't affect dup */
+        multiroarBitSet(r, 999);
+        if (!multiroarBitGet(r, 999)) {
+            ERRR("original bit 999 should be set");
+        }
+        if (multiroarBitGet(dup, 999)) {
+            ERRR("dup bit 999 should be clear");
+        }
+
+        multiroarFree(r);
+        multiroarFree(dup);
+    }
+
+    TEST("multiroarOr - basic OR operation") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
+
+        multiroarBitSet(a, 100);
+        multiroarBitSet(a, 200);
+        multiroarBitSet(b, 200);
+        multiroarBitSet(b, 300);
+
+        multiroarOr(a, b);
+
+        /* a should have: 100, 200, 300 */
+        if (!multiroarBitGet(a, 100)) {
+            ERRR("OR: bit 100 should be set");
+        }
+        if (!multiroarBitGet(a, 200)) {
+            ERRR("OR: bit 200 should be set");
+        }
+        if (!multiroarBitGet(a, 300)) {
+            ERRR("OR: bit 300 should be set");
+        }
+        if (multiroarBitGet(a, 150)) {
+            ERRR("OR: bit 150 should be clear");
+        }
+
+        multiroarFree(a);
+        multiroarFree(b);
+    }
+
+    TEST("multiroarAnd - basic AND operation") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
+
+        multiroarBitSet(a, 100);
+        multiroarBitSet(a, 200);
+        multiroarBitSet(a, 300);
+        multiroarBitSet(b, 200);
+        multiroarBitSet(b, 300);
+        multiroarBitSet(b, 400);
+
+        multiroarAnd(a, b);
+
+        /* a should have: 200, 300 (intersection) */
+        if (multiroarBitGet(a, 100)) {
+            ERRR("AND: bit 100 should be clear");
+        }
+        if (!multiroarBitGet(a, 200)) {
+            ERRR("AND: bit 200 should be set");
+        }
+        if (!multiroarBitGet(a, 300)) {
+            ERRR("AND: bit 300 should be set");
+        }
+        if (multiroarBitGet(a, 400)) {
+            ERRR("AND: bit 400 should be clear");
+        }
+
+        multiroarFree(a);
+        multiroarFree(b);
+    }
+
+    TEST("multiroarXor - basic XOR operation") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
+
+        multiroarBitSet(a, 100);
+        multiroarBitSet(a, 200);
+        multiroarBitSet(b, 200);
+        multiroarBitSet(b, 300);
+
+        multiroarXor(a, b);
+
+        /* a should have: 100, 300 (symmetric difference) */
+        if (!multiroarBitGet(a, 100)) {
+            ERRR("XOR: bit 100 should be set");
+        }
+        if (multiroarBitGet(a, 200)) {
+            ERRR("XOR: bit 200 should be clear");
+        }
+        if (!multiroarBitGet(a, 300)) {
+            ERRR("XOR: bit 300 should be set");
+        }
+
+        multiroarFree(a);
+        multiroarFree(b);
+    }
+
+    TEST("multiroarNot - basic NOT operation") {
+        multiroar *r = multiroarBitNew();
+        /* Set specific bits in a chunk */
+        multiroarBitSet(r, 0);
+        multiroarBitSet(r, 1);
+        multiroarBitSet(r, 100);
+
+        multiroarNot(r);
+
+        /* The set bits should now be clear, unset bits should be set */
+        if (multiroarBitGet(r, 0)) {
+            ERRR("NOT: bit 0 should be clear");
+        }
+        if (multiroarBitGet(r, 1)) {
+            ERRR("NOT: bit 1 should be clear");
+        }
+        if (multiroarBitGet(r, 100)) {
+            ERRR("NOT: bit 100 should be clear");
+        }
+        if (!multiroarBitGet(r, 2)) {
+            ERRR("NOT: bit 2 should be set");
+        }
+        if (!multiroarBitGet(r, 50)) {
+            ERRR("NOT: bit 50 should be set");
+        }
+        if (!multiroarBitGet(r, 8191)) {
+            ERRR("NOT: bit 8191 should be set");
+        }
+
+        /* Bits outside the existing chunk are still 0 */
+        if (multiroarBitGet(r, 8192)) {
+            ERRR("NOT: bit 8192 should be clear");
+        }
+
+        multiroarFree(r);
+    }
+
+    TEST("multiroarNewOr - creates new roar") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
+
+        multiroarBitSet(a, 100);
+        multiroarBitSet(b, 200);
+
+        multiroar *result = multiroarNewOr(a, b);
+        if (result == NULL) {
+            ERRR("NewOr result should not be NULL");
+        }
+        if (result == a) {
+            ERRR("NewOr result should not be a");
+        }
+        if (result == b) {
+            ERRR("NewOr result should not be b");
+        }
+
+        if (!multiroarBitGet(result, 100)) {
+            ERRR("NewOr: bit 100 should be set");
+        }
+        if (!multiroarBitGet(result, 200)) {
+            ERRR("NewOr: bit 200 should be set");
+        }
+
+        /* Originals unchanged */
+        if (multiroarBitGet(a, 200)) {
+            ERRR("NewOr: a bit 200 should be clear");
+        }
+        if (multiroarBitGet(b, 100)) {
+            ERRR("NewOr: b bit 100 should be clear");
+        }
+
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
+    }
+
+    TEST("FUZZ: set operations with oracle verification") {
+        printf("  Testing set operations with oracle...\n");
+
+#define FUZZ_OP_SIZE 500
+        uint64_t oracleA[divCeil(FUZZ_OP_SIZE, 64)] = {0};
+        uint64_t oracleB[divCeil(FUZZ_OP_SIZE, 64)] = {0};
+
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
+
+        /* Populate both with random bits */
+        for (uint64_t i = 0; i < 200; i++) {
+            uint64_t posA = rand() % FUZZ_OP_SIZE;
+            uint64_t posB = rand() % FUZZ_OP_SIZE;
+            multiroarBitSet(a, posA);
+            multiroarBitSet(b, posB);
+            FUZZ_ORACLE_SET(oracleA, posA);
+            FUZZ_ORACLE_SET(oracleB, posB);
+        }
+
+        /* Test OR */
+        multiroar *orResult = multiroarNewOr(a, b);
+        uint64_t orMismatches = 0;
+        for (uint64_t i = 0; i < FUZZ_OP_SIZE; i++) {
+            bool expected =
+                FUZZ_ORACLE_GET(oracleA, i) || FUZZ_ORACLE_GET(oracleB, i);
+            bool actual = multiroarBitGet(orResult, i);
+            if (expected != actual) {
+                orMismatches++;
+            }
+        }
+        if (orMismatches > 0) {
+            ERR("OR operation: %" PRIu64 " mismatches", orMismatches);
+        }
+        multiroarFree(orResult);
+
+        /* Test AND */
+        multiroar *andResult = multiroarNewAnd(a, b);
+        uint64_t andMismatches = 0;
+        for (uint64_t i = 0; i < FUZZ_OP_SIZE; i++) {
+            bool expected =
+                FUZZ_ORACLE_GET(oracleA, i) && FUZZ_ORACLE_GET(oracleB, i);
+            bool actual = multiroarBitGet(andResult, i);
+            if (expected != actual) {
+                andMismatches++;
+            }
+        }
+        if (andMismatches > 0) {
+            ERR("AND operation: %" PRIu64 " mismatches", andMismatches);
+        }
+        multiroarFree(andResult);
+
+        /* Test XOR */
+        multiroar *xorResult = multiroarNewXor(a, b);
+        uint64_t xorMismatches = 0;
+        for (uint64_t i = 0; i < FUZZ_OP_SIZE; i++) {
+            bool expected =
+                FUZZ_ORACLE_GET(oracleA, i) != FUZZ_ORACLE_GET(oracleB, i);
+            bool actual = multiroarBitGet(xorResult, i);
+            if (expected != actual) {
+                xorMismatches++;
+            }
+        }
+        if (xorMismatches > 0) {
+            ERR("XOR operation: %" PRIu64 " mismatches", xorMismatches);
+        }
+        multiroarFree(xorResult);
+
+        /* Test NOT */
+        multiroar *notResult = multiroarDuplicate(a);
+        multiroarNot(notResult);
+        uint64_t notMismatches = 0;
+        for (uint64_t i = 0; i < FUZZ_OP_SIZE; i++) {
+            bool expected = !FUZZ_ORACLE_GET(oracleA, i);
+            bool actual = multiroarBitGet(notResult, i);
+            if (expected != actual) {
+                notMismatches++;
+            }
+        }
+        if (notMismatches > 0) {
+            ERR("NOT operation: %" PRIu64 " mismatches (within existing chunk)",
+                notMismatches);
+        }
+        multiroarFree(notResult);
+
+        printf("  OR=%" PRIu64 " AND=%" PRIu64 " XOR=%" PRIu64 " NOT=%" PRIu64
+               " mismatches\n",
+               orMismatches, andMismatches, xorMismatches, notMismatches);
+
+        multiroarFree(a);
+        multiroarFree(b);
+#undef FUZZ_OP_SIZE
+    }
+
+    TEST("FUZZ: Remove operations with oracle") {
+        printf("  Testing remove operations...\n");
+
+#define FUZZ_REMOVE_SIZE 2000
+        uint64_t oracle[divCeil(FUZZ_REMOVE_SIZE, 64)] = {0};
+        multiroar *r = multiroarBitNew();
+
+        /* First add some bits */
+        for (uint64_t i = 0; i < 500; i++) {
+            uint64_t pos = rand() % FUZZ_REMOVE_SIZE;
+            multiroarBitSet(r, pos);
+            FUZZ_ORACLE_SET(oracle, pos);
+        }
+
+        /* Then remove some */
+        for (uint64_t i = 0; i < 200; i++) {
+            uint64_t pos = rand() % FUZZ_REMOVE_SIZE;
+            bool expectedWasSet = FUZZ_ORACLE_GET(oracle, pos);
+            bool actualWasSet = multiroarRemove(r, pos);
+
+            if (expectedWasSet != actualWasSet) {
+                ERR("Remove wasSet mismatch at pos %" PRIu64 "", pos);
+            }
+            FUZZ_ORACLE_CLEAR(oracle, pos);
+        }
+
+        /* Verify final state */
+        uint64_t mismatches = 0;
+        for (uint64_t i = 0; i < FUZZ_REMOVE_SIZE; i++) {
+            if (FUZZ_ORACLE_GET(oracle, i) != multiroarBitGet(r, i)) {
+                mismatches++;
+            }
+        }
+
+        if (mismatches > 0) {
+            ERR("Remove verification: %" PRIu64 " mismatches", mismatches);
+        }
+
+        printf("  add=500 remove=200 mismatches=%" PRIu64 "\n", mismatches);
+        multiroarFree(r);
+#undef FUZZ_REMOVE_SIZE
+    }
+
+    TEST("FUZZ: Set operations across multiple chunks") {
+        printf("  Testing multi-chunk set operations...\n");
+
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
+
+        /* Set bits across multiple chunks */
+        for (uint64_t chunk = 0; chunk < 5; chunk++) {
+            uint64_t base = chunk * 8192;
+            for (uint64_t i = 0; i < 100; i++) {
+                multiroarBitSet(a, base + i * 10);
+                multiroarBitSet(b, base + i * 10 + 5);
+            }
+        }
+
+        /* OR should combine both */
+        multiroar *orResult = multiroarNewOr(a, b);
+        uint64_t orCount = 0;
+        for (uint64_t chunk = 0; chunk < 5; chunk++) {
+            uint64_t base = chunk * 8192;
+            for (uint64_t i = 0; i < 100; i++) {
+                if (multiroarBitGet(orResult, base + i * 10)) {
+                    orCount++;
+                }
+                if (multiroarBitGet(orResult, base + i * 10 + 5)) {
+                    orCount++;
+                }
+            }
+        }
+        if (orCount != 1000) {
+            ERR("multi-chunk OR: expected 1000 bits, got %" PRIu64 "", orCount);
+        }
+
+        /* AND should be empty (no overlap) */
+        multiroar *andResult = multiroarNewAnd(a, b);
+        uint64_t andCount = 0;
+        for (uint64_t chunk = 0; chunk < 5; chunk++) {
+            uint64_t base = chunk * 8192;
+            for (uint64_t i = 0; i < 200; i++) {
+                if (multiroarBitGet(andResult, base + i)) {
+                    andCount++;
+                }
+            }
+        }
+        if (andCount != 0) {
+            ERR("multi-chunk AND: expected 0 bits, got %" PRIu64 "", andCount);
+        }
+
+        printf("  multi-chunk: OR count=%" PRIu64 ", AND count=%" PRIu64 "\n",
+               orCount, andCount);
+
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(orResult);
+        multiroarFree(andResult);
+    }
+
+    TEST("set operations with dense bitmaps") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
+
+        /* Fill to trigger FULL_BITMAP mode */
+        for (uint64_t i = 0; i < 2000; i++) {
+            multiroarBitSet(a, i);
+        }
+        for (uint64_t i = 1000; i < 3000; i++) {
+            multiroarBitSet(b, i);
+        }
+
+        /* AND should give intersection: 1000-1999 */
+        multiroar *andResult = multiroarNewAnd(a, b);
+        uint64_t errors = 0;
+        for (uint64_t i = 0; i < 1000; i++) {
+            if (multiroarBitGet(andResult, i)) {
+                errors++;
+            }
+        }
+        for (uint64_t i = 1000; i < 2000; i++) {
+            if (!multiroarBitGet(andResult, i)) {
+                errors++;
+            }
+        }
+        for (uint64_t i = 2000; i < 3000; i++) {
+            if (multiroarBitGet(andResult, i)) {
+                errors++;
+            }
+        }
+        if (errors > 0) {
+            ERR("dense AND: %" PRIu64 " bit errors", errors);
+        }
+
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(andResult);
+    }
+
+    printf("\n=== All multiroar fuzz tests completed! ===\n\n");
+
+    /* ========================================
+     * BITCOUNT TESTS
+     * ======================================== */
+    printf("\n=== BITCOUNT TESTS ===\n\n");
+
+    TEST("multiroarBitCount - empty roar") {
+        multiroar *r = multiroarBitNew();
+        uint64_t count = multiroarBitCount(r);
+        if (count != 0) {
+            ERR("Empty roar should have count=0, got %" PRIu64 "", count);
+        }
+        multiroarFree(r);
+    }
+
+    TEST("multiroarBitCount - single bit") {
+        multiroar *r = multiroarBitNew();
+        multiroarBitSet(r, 100);
+        uint64_t count = multiroarBitCount(r);
+        if (count != 1) {
+            ERR("Single bit should have count=1, got %" PRIu64 "", count);
+        }
+        multiroarFree(r);
+    }
+
+    TEST("multiroarBitCount - sparse chunk") {
+        multiroar *r = multiroarBitNew();
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(r, i * 10);
+        }
+        uint64_t count = multiroarBitCount(r);
+        if (count != 100) {
+            ERR("Sparse chunk should have count=100, got %" PRIu64 "", count);
+        }
+        multiroarFree(r);
+    }
+
+    TEST("multiroarBitCount - dense chunk") {
+        multiroar *r = multiroarBitNew();
+        /* Set 1000 bits to trigger FULL_BITMAP */
+        for (uint64_t i = 0; i < 1000; i++) {
+            multiroarBitSet(r, i);
+        }
+        uint64_t count = multiroarBitCount(r);
+        if (count != 1000) {
+            ERR("Dense chunk should have count=1000, got %" PRIu64 "", count);
+        }
+        multiroarFree(r);
+    }
+
+    TEST("multiroarBitCount - full chunk (ALL_1)") {
+        multiroar *r = multiroarBitNew();
+        /* Set all 8192 bits in chunk */
+        for (uint64_t i = 0; i < 8192; i++) {
+            multiroarBitSet(r, i);
+        }
+        uint64_t count = multiroarBitCount(r);
+        if (count != 8192) {
+            ERR("Full chunk should have count=8192, got %" PRIu64 "", count);
+        }
+        multiroarFree(r);
+    }
+
+    TEST("multiroarBitCount - multiple chunks") {
+        multiroar *r = multiroarBitNew();
+        /* Chunk 0: 100 bits */
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(r, i);
+        }
+        /* Chunk 1: 50 bits */
+        for (uint64_t i = 0; i < 50; i++) {
+            multiroarBitSet(r, 8192 + i);
+        }
+        /* Chunk 2: 200 bits */
+        for (uint64_t i = 0; i < 200; i++) {
+            multiroarBitSet(r, 16384 + i);
+        }
+        uint64_t count = multiroarBitCount(r);
+        if (count != 350) {
+            ERR("Multi-chunk should have count=350, got %" PRIu64 "", count);
+        }
+        multiroarFree(r);
+    }
+
+    TEST("FUZZ: bitcount correctness oracle") {
+        printf("  Testing bitcount with oracle...\n");
+        multiroar *r = multiroarBitNew();
+        uint64_t expectedCount = 0;
+
+        srand(33333);
+        for (uint64_t i = 0; i < 10000; i++) {
+            uint64_t pos = (uint64_t)rand() % 100000;
+            if (!multiroarBitGet(r, pos)) {
+                multiroarBitSet(r, pos);
+                expectedCount++;
+            }
+        }
+
+        uint64_t actualCount = multiroarBitCount(r);
+        if (actualCount != expectedCount) {
+            ERR("Bitcount mismatch: expected %" PRIu64 ", got %" PRIu64 "",
+                expectedCount, actualCount);
+        }
+
+        printf("  verified %" PRIu64 " set bits\n", actualCount);
+        multiroarFree(r);
+    }
+
+    /* ========================================
+     * N-WAY OPERATIONS TESTS
+     * ======================================== */
+    printf("\n=== N-WAY OPERATIONS TESTS ===\n\n");
+
+    TEST("multiroarAndN - 3 roars basic") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
+        multiroar *r3 = multiroarBitNew();
+
+        /* r1: 0-99 */
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(r1, i);
+        }
+        /* r2: 50-149 */
+        for (uint64_t i = 50; i < 150; i++) {
+            multiroarBitSet(r2, i);
+        }
+        /* r3: 75-174 */
+        for (uint64_t i = 75; i < 175; i++) {
+            multiroarBitSet(r3, i);
+        }
+
+        multiroar *roars[] = {r1, r2, r3};
+        multiroar *result = multiroarNewAndN(3, roars);
+
+        /* Intersection: 75-99 = 25 bits */
+        uint64_t count = 0;
+        for (uint64_t i = 0; i < 200; i++) {
+            if (multiroarBitGet(result, i)) {
+                if (i < 75 || i >= 100) {
+                    ERR("AndN: bit %" PRIu64 " should not be set", i);
+                }
+                count++;
+            }
+        }
+
+        if (count != 25) {
+            ERR("AndN: expected 25 bits, got %" PRIu64 "", count);
+        }
+
+        multiroarFree(r1);
+        multiroarFree(r2);
+        multiroarFree(r3);
+        multiroarFree(result);
+    }
+
+    TEST("multiroarOrN - 3 roars basic") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
+        multiroar *r3 = multiroarBitNew();
+
+        multiroarBitSet(r1, 100);
+        multiroarBitSet(r2, 200);
+        multiroarBitSet(r3, 300);
+
+        multiroar *roars[] = {r1, r2, r3};
+        multiroar *result = multiroarNewOrN(3, roars);
+
+        /* Union: all 3 bits */
+        if (!multiroarBitGet(result, 100)) {
+            ERRR("OrN: bit 100 should be set");
+        }
+        if (!multiroarBitGet(result, 200)) {
+            ERRR("OrN: bit 200 should be set");
+        }
+        if (!multiroarBitGet(result, 300)) {
+            ERRR("OrN: bit 300 should be set");
+        }
+
+        uint64_t count = multiroarBitCount(result);
+        if (count != 3) {
+            ERR("OrN: expected 3 bits, got %" PRIu64 "", count);
+        }
+
+        multiroarFree(r1);
+        multiroarFree(r2);
+        multiroarFree(r3);
+        multiroarFree(result);
+    }
+
+    TEST("multiroarXorN - 3 roars basic") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
+        multiroar *r3 = multiroarBitNew();
+
+        multiroarBitSet(r1, 100);
+        multiroarBitSet(r2, 100); /* Cancels out */
+        multiroarBitSet(r3, 100); /* Sets again */
+
+        multiroarBitSet(r1, 200);
+        multiroarBitSet(r2, 200); /* Cancels out */
+
+        multiroarBitSet(r3, 300);
+
+        multiroar *roars[] = {r1, r2, r3};
+        multiroar *result = multiroarNewXorN(3, roars);
+
+        /* 100: 1^1^1 = 1 */
+        /* 200: 1^1^0 = 0 */
+        /* 300: 0^0^1 = 1 */
+        if (!multiroarBitGet(result, 100)) {
+            ERRR("XorN: bit 100 should be set");
+        }
+        if (multiroarBitGet(result, 200)) {
+            ERRR("XorN: bit 200 should not be set");
+        }
+        if (!multiroarBitGet(result, 300)) {
+            ERRR("XorN: bit 300 should be set");
+        }
+
+        multiroarFree(r1);
+        multiroarFree(r2);
+        multiroarFree(r3);
+        multiroarFree(result);
+    }
+
+    TEST("N-way operations equivalence to chained binary") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
+        multiroar *r3 = multiroarBitNew();
+        multiroar *r4 = multiroarBitNew();
+
+        srand(44444);
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(r1, rand() % 500);
+            multiroarBitSet(r2, rand() % 500);
+            multiroarBitSet(r3, rand() % 500);
+            multiroarBitSet(r4, rand() % 500);
+        }
+
+        multiroar *roars[] = {r1, r2, r3, r4};
+
+        /* Test N-way AND vs chained binary */
+        multiroar *nwayAnd = multiroarNewAndN(4, roars);
+        multiroar *chainedAnd = multiroarDuplicate(r1);
+        multiroarAnd(chainedAnd, r2);
+        multiroarAnd(chainedAnd, r3);
+        multiroarAnd(chainedAnd, r4);
+
+        uint64_t nwayCount = multiroarBitCount(nwayAnd);
+        uint64_t chainedCount = multiroarBitCount(chainedAnd);
+
+        if (nwayCount != chainedCount) {
+            ERR("N-way AND count=%" PRIu64 ", chained count=%" PRIu64 "",
+                nwayCount, chainedCount);
+        }
+
+        /* Verify bit-by-bit */
+        for (uint64_t i = 0; i < 500; i++) {
+            bool nway = multiroarBitGet(nwayAnd, i);
+            bool chained = multiroarBitGet(chainedAnd, i);
+            if (nway != chained) {
+                ERR("AND equivalence: bit %" PRIu64 " mismatch", i);
+            }
+        }
+
+        /* Test N-way OR vs chained binary */
+        multiroar *nwayOr = multiroarNewOrN(4, roars);
+        multiroar *chainedOr = multiroarDuplicate(r1);
+        multiroarOr(chainedOr, r2);
+        multiroarOr(chainedOr, r3);
+        multiroarOr(chainedOr, r4);
+
+        nwayCount = multiroarBitCount(nwayOr);
+        chainedCount = multiroarBitCount(chainedOr);
+
+        if (nwayCount != chainedCount) {
+            ERR("N-way OR count=%" PRIu64 ", chained count=%" PRIu64 "",
+                nwayCount, chainedCount);
+        }
+
+        for (uint64_t i = 0; i < 500; i++) {
+            bool nway = multiroarBitGet(nwayOr, i);
+            bool chained = multiroarBitGet(chainedOr, i);
+            if (nway != chained) {
+                ERR("OR equivalence: bit %" PRIu64 " mismatch", i);
+            }
+        }
+
+        multiroarFree(r1);
+        multiroarFree(r2);
+        multiroarFree(r3);
+        multiroarFree(r4);
+        multiroarFree(nwayAnd);
+        multiroarFree(chainedAnd);
+        multiroarFree(nwayOr);
+        multiroarFree(chainedOr);
+    }
+
+    TEST("N-way operations with many inputs (N=10)") {
+        const uint64_t n = 10;
+        multiroar **roars = zmalloc(n * sizeof(multiroar *));
+
+        srand(55555);
+        for (uint64_t i = 0; i < n; i++) {
+            roars[i] = multiroarBitNew();
+            /* Each roar sets random bits */
+            for (uint64_t j = 0; j < 50; j++) {
+                multiroarBitSet(roars[i], rand() % 1000);
+            }
+        }
+
+        /* Test N-way OR - should combine all */
+        multiroar *orResult = multiroarNewOrN(n, roars);
+        uint64_t orCount = multiroarBitCount(orResult);
+
+        /* OR count should be > 0 */
+        if (orCount == 0) {
+            ERRR("N=10 OR: count should be > 0");
+        }
+
+        /* Test N-way AND - should be subset of any individual */
+        multiroar *andResult = multiroarNewAndN(n, roars);
+        uint64_t andCount = multiroarBitCount(andResult);
+
+        for (uint64_t i = 0; i < n; i++) {
+            uint64_t individualCount = multiroarBitCount(roars[i]);
+            if (andCount > individualCount) {
+                ERR("N=10 AND: intersection (%" PRIu64
+                    ") > individual (%" PRIu64 ")",
+                    andCount, individualCount);
+            }
+        }
+
+        printf("  N=10: OR count=%" PRIu64 ", AND count=%" PRIu64 "\n", orCount,
+               andCount);
+
+        for (uint64_t i = 0; i < n; i++) {
+            multiroarFree(roars[i]);
+        }
+        zfree(roars);
+        multiroarFree(orResult);
+        multiroarFree(andResult);
+    }
+
+    TEST("FUZZ: N-way operations with random data") {
+        printf("  Fuzzing N-way operations...\n");
+
+        srand(66666);
+        const uint64_t trials = 100;
+        const uint64_t maxN = 7;
+
+        for (uint64_t trial = 0; trial < trials; trial++) {
+            uint64_t n = 2 + (rand() % (maxN - 1)); /* 2 to 7 inputs */
+            multiroar **roars = zmalloc(n * sizeof(multiroar *));
+
+            /* Create random roars */
+            for (uint64_t i = 0; i < n; i++) {
+                roars[i] = multiroarBitNew();
+                uint64_t numBits = rand() % 200;
+                for (uint64_t j = 0; j < numBits; j++) {
+                    multiroarBitSet(roars[i], rand() % 1000);
+                }
+            }
+
+            /* Test N-way operations don't crash */
+            multiroar *andResult = multiroarNewAndN(n, roars);
+            multiroar *orResult = multiroarNewOrN(n, roars);
+            multiroar *xorResult = multiroarNewXorN(n, roars);
+
+            /* Basic sanity: AND count <= OR count */
+            uint64_t andCount = multiroarBitCount(andResult);
+            uint64_t orCount = multiroarBitCount(orResult);
+
+            if (andCount > orCount) {
+                ERR("Trial %" PRIu64 ": AND count %" PRIu64
+                    " > OR count %" PRIu64 "",
+                    trial, andCount, orCount);
+            }
+
+            /* Cleanup */
+            for (uint64_t i = 0; i < n; i++) {
+                multiroarFree(roars[i]);
+            }
+            zfree(roars);
+            multiroarFree(andResult);
+            multiroarFree(orResult);
+            multiroarFree(xorResult);
+        }
+
+        printf("  completed %" PRIu64 " fuzz trials\n", trials);
+    }
+
+    TEST("N-way operations with empty roars") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
+        multiroar *r3 = multiroarBitNew();
+
+        multiroarBitSet(r2, 100); /* Only r2 has a bit */
+
+        multiroar *roars[] = {r1, r2, r3};
+
+        /* AND with empty = empty */
+        multiroar *andResult = multiroarNewAndN(3, roars);
+        uint64_t andCount = multiroarBitCount(andResult);
+        if (andCount != 0) {
+            ERR("AND with empty should be 0, got %" PRIu64 "", andCount);
+        }
+
+        /* OR with empty = union of non-empty */
+        multiroar *orResult = multiroarNewOrN(3, roars);
+        uint64_t orCount = multiroarBitCount(orResult);
+        if (orCount != 1) {
+            ERR("OR with empty should be 1, got %" PRIu64 "", orCount);
+        }
+
+        multiroarFree(r1);
+        multiroarFree(r2);
+        multiroarFree(r3);
+        multiroarFree(andResult);
+        multiroarFree(orResult);
+    }
+
+    TEST("bitcount + N-way integration") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
+        multiroar *r3 = multiroarBitNew();
+
+        /* Set known counts with proper overlaps for AND operation */
+        for (uint64_t i = 0; i < 150; i++) {
+            multiroarBitSet(r1, i);
+        }
+        for (uint64_t i = 50; i < 200; i++) {
+            multiroarBitSet(r2, i);
+        }
+        for (uint64_t i = 100; i < 250; i++) {
+            multiroarBitSet(r3, i);
+        }
+
+        /* Verify individual counts */
+        if (multiroarBitCount(r1) != 150) {
+            ERR("r1 count should be 150, got %" PRIu64 "",
+                multiroarBitCount(r1));
+        }
+        if (multiroarBitCount(r2) != 150) {
+            ERR("r2 count should be 150, got %" PRIu64 "",
+                multiroarBitCount(r2));
+        }
+        if (multiroarBitCount(r3) != 150) {
+            ERR("r3 count should be 150, got %" PRIu64 "",
+                multiroarBitCount(r3));
+        }
+
+        multiroar *roars[] = {r1, r2, r3};
+
+        /* AND: intersection [100..149] = 50 bits */
+        multiroar *andResult = multiroarNewAndN(3, roars);
+        uint64_t andCount = multiroarBitCount(andResult);
+        if (andCount != 50) {
+            ERR("AND count should be 50, got %" PRIu64 "", andCount);
+        }
+
+        /* OR: union [0..249] = 250 bits */
+        multiroar *orResult = multiroarNewOrN(3, roars);
+        uint64_t orCount = multiroarBitCount(orResult);
+        if (orCount != 250) {
+            ERR("OR count should be 250, got %" PRIu64 "", orCount);
+        }
+
+        printf("  Integration: AND=%" PRIu64 " OR=%" PRIu64 "\n", andCount,
+               orCount);
+
+        multiroarFree(r1);
+        multiroarFree(r2);
+        multiroarFree(r3);
+        multiroarFree(andResult);
+        multiroarFree(orResult);
+    }
+
+    printf("\n=== All new functionality tests completed! ===\n\n");
+
+    /* ================================================================
+     * ADVANCED FUZZING AND EDGE CASE TESTS
+     * ================================================================ */
+
+    printf("=== ADVANCED FUZZING TESTS ===\n\n");
+
+    TEST("FUZZ: bitcount with all chunk types (1K iterations)") {
+        srand(99999);
+        for (int trial = 0; trial < 1000; trial++) {
+            multiroar *r = multiroarBitNew();
+            uint64_t expectedCount = 0;
+
+            /* Set random number of bits to trigger different chunk types */
+            int numBits = rand() % 10000;
+            for (int i = 0; i < numBits; i++) {
+                uint64_t pos = ((uint64_t)rand() * rand()) % 1000000;
+                if (!multiroarBitGet(r, pos)) {
+                    multiroarBitSet(r, pos);
+                    expectedCount++;
+                }
+            }
+
+            uint64_t actualCount = multiroarBitCount(r);
+            if (actualCount != expectedCount) {
+                ERR("FUZZ bitcount: expected %" PRIu64 ", got %" PRIu64
+                    " (trial %d)",
+                    expectedCount, actualCount, trial);
+                break;
+            }
+
+            multiroarFree(r);
+        }
+        printf("  Completed 1K bitcount fuzz iterations\n");
+    }
+
+    TEST("FUZZ: N-way AND with random overlaps (1K iterations)") {
+        srand(111111);
+        for (int trial = 0; trial < 1000; trial++) {
+            int n = 2 + (rand() % 8); /* 2-9 inputs */
+            multiroar **roars = zmalloc(n * sizeof(multiroar *));
+
+            for (int i = 0; i < n; i++) {
+                roars[i] = multiroarBitNew();
+                /* Set overlapping ranges */
+                uint64_t start = (rand() % 500);
+                uint64_t count = 50 + (rand() % 200);
+                for (uint64_t j = start; j < start + count; j++) {
+                    multiroarBitSet(roars[i], j);
+                }
+            }
+
+            /* Test N-way vs chained binary */
+            multiroar *nwayResult = multiroarNewAndN(n, roars);
+            multiroar *chainedResult = multiroarDuplicate(roars[0]);
+            for (int i = 1; i < n; i++) {
+                multiroarAnd(chainedResult, roars[i]);
+            }
+
+            uint64_t nwayCount = multiroarBitCount(nwayResult);
+            uint64_t chainedCount = multiroarBitCount(chainedResult);
+
+            if (nwayCount != chainedCount) {
+                ERR("FUZZ N-way AND: nway=%" PRIu64 " chained=%" PRIu64
+                    " (trial %d, n=%d)",
+                    nwayCount, chainedCount, trial, n);
+                break;
+            }
+
+            /* Verify random positions */
+            for (int i = 0; i < 100; i++) {
+                uint64_t pos = rand() % 1000;
+                bool nway = multiroarBitGet(nwayResult, pos);
+                bool chained = multiroarBitGet(chainedResult, pos);
+                if (nway != chained) {
+                    ERR("FUZZ AND: bit %" PRIu64 " mismatch at trial %d", pos,
+                        trial);
+                    break;
+                }
+            }
+
+            for (int i = 0; i < n; i++) {
+                multiroarFree(roars[i]);
+            }
+            zfree(roars);
+            multiroarFree(nwayResult);
+            multiroarFree(chainedResult);
+        }
+        printf("  Completed 1K N-way AND fuzz iterations\n");
     }
 
-    TEST("N-way operations equivalence to chained binary") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
-        multiroar *r3 = multiroarBitNew();
-        multiroar *r4 = multiroarBitNew();
+    TEST("FUZZ: N-way OR with random overlaps (1K iterations)") {
+        srand(222222);
+        for (int trial = 0; trial < 1000; trial++) {
+            int n = 2 + (rand() % 8);
+            multiroar **roars = zmalloc(n * sizeof(multiroar *));
 
-        srand(44444);
+            for (int i = 0; i < n; i++) {
+                roars[i] = multiroarBitNew();
+                uint64_t start = (rand() % 500);
+                uint64_t count = 50 + (rand() % 200);
+                for (uint64_t j = start; j < start + count; j++) {
+                    multiroarBitSet(roars[i], j);
+                }
+            }
+
+            multiroar *nwayResult = multiroarNewOrN(n, roars);
+            multiroar *chainedResult = multiroarDuplicate(roars[0]);
+            for (int i = 1; i < n; i++) {
+                multiroarOr(chainedResult, roars[i]);
+            }
+
+            uint64_t nwayCount = multiroarBitCount(nwayResult);
+            uint64_t chainedCount = multiroarBitCount(chainedResult);
+
+            if (nwayCount != chainedCount) {
+                ERR("FUZZ N-way OR: nway=%" PRIu64 " chained=%" PRIu64
+                    " (trial %d)",
+                    nwayCount, chainedCount, trial);
+                break;
+            }
+
+            for (int i = 0; i < n; i++) {
+                multiroarFree(roars[i]);
+            }
+            zfree(roars);
+            multiroarFree(nwayResult);
+            multiroarFree(chainedResult);
+        }
+        printf("  Completed 1K N-way OR fuzz iterations\n");
+    }
+
+    TEST("FUZZ: N-way XOR with random overlaps (1K iterations)") {
+        srand(333333);
+        for (int trial = 0; trial < 1000; trial++) {
+            int n = 2 + (rand() % 8);
+            multiroar **roars = zmalloc(n * sizeof(multiroar *));
+
+            for (int i = 0; i < n; i++) {
+                roars[i] = multiroarBitNew();
+                uint64_t start = (rand() % 500);
+                uint64_t count = 50 + (rand() % 200);
+                for (uint64_t j = start; j < start + count; j++) {
+                    multiroarBitSet(roars[i], j);
+                }
+            }
+
+            multiroar *nwayResult = multiroarNewXorN(n, roars);
+            multiroar *chainedResult = multiroarDuplicate(roars[0]);
+            for (int i = 1; i < n; i++) {
+                multiroarXor(chainedResult, roars[i]);
+            }
+
+            uint64_t nwayCount = multiroarBitCount(nwayResult);
+            uint64_t chainedCount = multiroarBitCount(chainedResult);
+
+            if (nwayCount != chainedCount) {
+                ERR("FUZZ N-way XOR: nway=%" PRIu64 " chained=%" PRIu64
+                    " (trial %d)",
+                    nwayCount, chainedCount, trial);
+                break;
+            }
+
+            for (int i = 0; i < n; i++) {
+                multiroarFree(roars[i]);
+            }
+            zfree(roars);
+            multiroarFree(nwayResult);
+            multiroarFree(chainedResult);
+        }
+        printf("  Completed 1K N-way XOR fuzz iterations\n");
+    }
+
+    TEST("EDGE: bitcount with chunk type transitions") {
+        multiroar *r = multiroarBitNew();
+        uint64_t count = 0;
+
+        /* Start with UNDER_FULL (sparse) */
         for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(r1, rand() % 500);
-            multiroarBitSet(r2, rand() % 500);
-            multiroarBitSet(r3, rand() % 500);
-            multiroarBitSet(r4, rand() % 500);
+            multiroarBitSet(r, i * 100);
+            count++;
+        }
+        if (multiroarBitCount(r) != count) {
+            ERR("Sparse chunk bitcount: expected %" PRIu64 ", got %" PRIu64 "",
+                count, multiroarBitCount(r));
         }
 
-        multiroar *roars[] = {r1, r2, r3, r4};
+        /* Transition to FULL_BITMAP (dense) */
+        for (uint64_t i = 0; i < 2000; i++) {
+            if (!multiroarBitGet(r, i)) {
+                multiroarBitSet(r, i);
+                count++;
+            }
+        }
+        if (multiroarBitCount(r) != count) {
+            ERR("Dense chunk bitcount: expected %" PRIu64 ", got %" PRIu64 "",
+                count, multiroarBitCount(r));
+        }
 
-        /* Test N-way AND vs chained binary */
-        multiroar *nwayAnd = multiroarNewAndN(4, roars);
-        multiroar *chainedAnd = multiroarDuplicate(r1);
-        multiroarAnd(chainedAnd, r2);
-        multiroarAnd(chainedAnd, r3);
-        multiroarAnd(chainedAnd, r4);
+        /* Transition to OVER_FULL (inverted) */
+        for (uint64_t i = 0; i < 8000; i++) {
+            if (!multiroarBitGet(r, i)) {
+                multiroarBitSet(r, i);
+                count++;
+            }
+        }
+        if (multiroarBitCount(r) != count) {
+            ERR("Inverted chunk bitcount: expected %" PRIu64 ", got %" PRIu64
+                "",
+                count, multiroarBitCount(r));
+        }
 
-        uint64_t nwayCount = multiroarBitCount(nwayAnd);
-        uint64_t chainedCount = multiroarBitCount(chainedAnd);
+        /* Transition to ALL_1 (all bits set) */
+        for (uint64_t i = 0; i < 8192; i++) {
+            if (!multiroarBitGet(r, i)) {
+                multiroarBitSet(r, i);
+                count++;
+            }
+        }
+        if (multiroarBitCount(r) != count) {
+            ERR("All-ones chunk bitcount: expected %" PRIu64 ", got %" PRIu64
+                "",
+                count, multiroarBitCount(r));
+        }
 
-        if (nwayCount != chainedCount) {
-            ERR("N-way AND count=%" PRIu64 ", chained count=%" PRIu64 "",
-                nwayCount, chainedCount);
+        multiroarFree(r);
+    }
+
+    TEST("EDGE: N-way operations with very large N (N=100)") {
+        const int n = 100;
+        multiroar **roars = zmalloc(n * sizeof(multiroar *));
+
+        srand(444444);
+        for (int i = 0; i < n; i++) {
+            roars[i] = multiroarBitNew();
+            /* Each sets bit at position i to guarantee some overlap */
+            multiroarBitSet(roars[i], i);
+            /* Plus some random bits */
+            for (int j = 0; j < 10; j++) {
+                multiroarBitSet(roars[i], rand() % 1000);
+            }
+        }
+
+        multiroar *orResult = multiroarNewOrN(n, roars);
+        uint64_t orCount = multiroarBitCount(orResult);
+
+        /* OR should have at least N bits (positions 0..N-1) */
+        if (orCount < (uint64_t)n) {
+            ERR("N=100 OR: count %" PRIu64 " should be >= %d", orCount, n);
+        }
+
+        multiroar *andResult = multiroarNewAndN(n, roars);
+        uint64_t andCount = multiroarBitCount(andResult);
+
+        /* AND should be small (likely 0) since each roar has unique bits */
+        if (andCount > 50) {
+            ERR("N=100 AND: count %" PRIu64 " unexpectedly large", andCount);
+        }
+
+        printf("  N=100: OR=%" PRIu64 " AND=%" PRIu64 "\n", orCount, andCount);
+
+        for (int i = 0; i < n; i++) {
+            multiroarFree(roars[i]);
+        }
+        zfree(roars);
+        multiroarFree(orResult);
+        multiroarFree(andResult);
+    }
+
+    TEST("EDGE: Multi-chunk operations across boundaries") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
+        multiroar *r3 = multiroarBitNew();
+
+        /* Set bits in different chunks (chunks are 8192 bits each) */
+        /* Chunk 0: bits 0-8191 - with proper overlaps */
+        for (uint64_t i = 0; i < 2000; i++) {
+            multiroarBitSet(r1, i);
+        }
+        for (uint64_t i = 500; i < 2500; i++) {
+            multiroarBitSet(r2, i);
+        }
+        for (uint64_t i = 1000; i < 3000; i++) {
+            multiroarBitSet(r3, i);
+        }
+
+        /* Chunk 1: bits 8192-16383 - with proper overlaps */
+        for (uint64_t i = 8192; i < 10192; i++) {
+            multiroarBitSet(r1, i);
+        }
+        for (uint64_t i = 8692; i < 10692; i++) {
+            multiroarBitSet(r2, i);
+        }
+        for (uint64_t i = 9192; i < 11192; i++) {
+            multiroarBitSet(r3, i);
+        }
+
+        /* Chunk 10: bits 81920-90111 - with proper overlaps */
+        for (uint64_t i = 81920; i < 83920; i++) {
+            multiroarBitSet(r1, i);
         }
-
-        /* Verify bit-by-bit */
-        for (uint64_t i = 0; i < 500; i++) {
-            bool nway = multiroarBitGet(nwayAnd, i);
-            bool chained = multiroarBitGet(chainedAnd, i);
-            if (nway != chained) {
-                ERR("AND equivalence: bit %" PRIu64 " mismatch", i);
-            }
+        for (uint64_t i = 82420; i < 84420; i++) {
+            multiroarBitSet(r2, i);
+        }
+        for (uint64_t i = 82920; i < 84920; i++) {
+            multiroarBitSet(r3, i);
         }
 
-        /* Test N-way OR vs chained binary */
-        multiroar *nwayOr = multiroarNewOrN(4, roars);
-        multiroar *chainedOr = multiroarDuplicate(r1);
-        multiroarOr(chainedOr, r2);
-        multiroarOr(chainedOr, r3);
-        multiroarOr(chainedOr, r4);
+        multiroar *roars[] = {r1, r2, r3};
 
-        nwayCount = multiroarBitCount(nwayOr);
-        chainedCount = multiroarBitCount(chainedOr);
+        /* Test AND across chunks - should have overlaps */
+        multiroar *andResult = multiroarNewAndN(3, roars);
+        uint64_t andCount = multiroarBitCount(andResult);
 
-        if (nwayCount != chainedCount) {
-            ERR("N-way OR count=%" PRIu64 ", chained count=%" PRIu64 "",
-                nwayCount, chainedCount);
+        /* Should have overlaps: chunk0=[1000..1999], chunk1=[9192..10191],
+         * chunk10=[82920..83919] */
+        uint64_t expectedAnd = 1000 + 1000 + 1000; /* 3000 bits total overlap */
+        if (andCount != expectedAnd) {
+            ERR("Multi-chunk AND: expected %" PRIu64 ", got %" PRIu64 "",
+                expectedAnd, andCount);
         }
 
-        for (uint64_t i = 0; i < 500; i++) {
-            bool nway = multiroarBitGet(nwayOr, i);
-            bool chained = multiroarBitGet(chainedOr, i);
-            if (nway != chained) {
-                ERR("OR equivalence: bit %" PRIu64 " mismatch", i);
-            }
+        /* Test OR across chunks */
+        multiroar *orResult = multiroarNewOrN(3, roars);
+        uint64_t orCount = multiroarBitCount(orResult);
+
+        /* OR should be union of all ranges */
+        /* chunk0: [0..2999], chunk1: [8192..11191], chunk10: [81920..84919] */
+        uint64_t expectedOr = 3000 + 3000 + 3000; /* 9000 bits total */
+        if (orCount != expectedOr) {
+            ERR("Multi-chunk OR: expected %" PRIu64 ", got %" PRIu64 "",
+                expectedOr, orCount);
         }
 
+        printf("  Multi-chunk: AND=%" PRIu64 " OR=%" PRIu64 "\n", andCount,
+               orCount);
+
         multiroarFree(r1);
         multiroarFree(r2);
         multiroarFree(r3);
-        multiroarFree(r4);
-        multiroarFree(nwayAnd);
-        multiroarFree(chainedAnd);
-        multiroarFree(nwayOr);
-        multiroarFree(chainedOr);
+        multiroarFree(andResult);
+        multiroarFree(orResult);
     }
 
-    TEST("N-way operations with many inputs (N=10)") {
-        const uint64_t n = 10;
-        multiroar **roars = zmalloc(n * sizeof(multiroar *));
+    TEST("EDGE: Operations with all chunk types mixed") {
+        multiroar *sparse = multiroarBitNew();
+        multiroar *dense = multiroarBitNew();
+        multiroar *inverted = multiroarBitNew();
+        multiroar *full = multiroarBitNew();
 
-        srand(55555);
-        for (uint64_t i = 0; i < n; i++) {
-            roars[i] = multiroarBitNew();
-            /* Each roar sets random bits */
-            for (uint64_t j = 0; j < 50; j++) {
-                multiroarBitSet(roars[i], rand() % 1000);
-            }
+        /* Sparse chunk (< 631 bits) */
+        for (uint64_t i = 0; i < 300; i++) {
+            multiroarBitSet(sparse, i * 10);
         }
 
-        /* Test N-way OR - should combine all */
-        multiroar *orResult = multiroarNewOrN(n, roars);
-        uint64_t orCount = multiroarBitCount(orResult);
+        /* Dense chunk (631-7561 bits) */
+        for (uint64_t i = 0; i < 2000; i++) {
+            multiroarBitSet(dense, i);
+        }
 
-        /* OR count should be > 0 */
-        if (orCount == 0) {
-            ERRR("N=10 OR: count should be > 0");
+        /* Inverted chunk (> 7561 bits) */
+        for (uint64_t i = 0; i < 8000; i++) {
+            multiroarBitSet(inverted, i);
         }
 
-        /* Test N-way AND - should be subset of any individual */
-        multiroar *andResult = multiroarNewAndN(n, roars);
-        uint64_t andCount = multiroarBitCount(andResult);
+        /* Full chunk (all 8192 bits) */
+        for (uint64_t i = 0; i < 8192; i++) {
+            multiroarBitSet(full, i);
+        }
 
-        for (uint64_t i = 0; i < n; i++) {
-            uint64_t individualCount = multiroarBitCount(roars[i]);
-            if (andCount > individualCount) {
-                ERR("N=10 AND: intersection (%" PRIu64
-                    ") > individual (%" PRIu64 ")",
-                    andCount, individualCount);
-            }
+        /* Verify counts */
+        if (multiroarBitCount(sparse) != 300) {
+            ERR("Sparse count: expected 300, got %" PRIu64 "",
+                multiroarBitCount(sparse));
+        }
+        if (multiroarBitCount(dense) != 2000) {
+            ERR("Dense count: expected 2000, got %" PRIu64 "",
+                multiroarBitCount(dense));
+        }
+        if (multiroarBitCount(inverted) != 8000) {
+            ERR("Inverted count: expected 8000, got %" PRIu64 "",
+                multiroarBitCount(inverted));
+        }
+        if (multiroarBitCount(full) != 8192) {
+            ERR("Full count: expected 8192, got %" PRIu64 "",
+                multiroarBitCount(full));
         }
 
-        printf("  N=10: OR count=%" PRIu64 ", AND count=%" PRIu64 "\n", orCount,
-               andCount);
+        multiroar *roars[] = {sparse, dense, inverted, full};
 
-        for (uint64_t i = 0; i < n; i++) {
-            multiroarFree(roars[i]);
+        /* AND of all types - should be sparse positions only */
+        multiroar *andResult = multiroarNewAndN(4, roars);
+        uint64_t andCount = multiroarBitCount(andResult);
+        /* All have bits [0, 10, 20, ... 290] in common = ~30 bits */
+        if (andCount == 0 || andCount > 300) {
+            ERR("Mixed types AND: count %" PRIu64 " unexpected", andCount);
         }
-        zfree(roars);
-        multiroarFree(orResult);
-        multiroarFree(andResult);
-    }
 
-    TEST("FUZZ: N-way operations with random data") {
-        printf("  Fuzzing N-way operations...\n");
-
-        srand(66666);
-        const uint64_t trials = 100;
-        const uint64_t maxN = 7;
+        /* OR of all types - should be full chunk */
+        multiroar *orResult = multiroarNewOrN(4, roars);
+        uint64_t orCount = multiroarBitCount(orResult);
+        if (orCount != 8192) {
+            ERR("Mixed types OR: expected 8192, got %" PRIu64 "", orCount);
+        }
 
-        for (uint64_t trial = 0; trial < trials; trial++) {
-            uint64_t n = 2 + (rand() % (maxN - 1)); /* 2 to 7 inputs */
-            multiroar **roars = zmalloc(n * sizeof(multiroar *));
+        printf("  Mixed chunk types: AND=%" PRIu64 " OR=%" PRIu64 "\n",
+               andCount, orCount);
 
-            /* Create random roars */
-            for (uint64_t i = 0; i < n; i++) {
-                roars[i] = multiroarBitNew();
-                uint64_t numBits = rand() % 200;
-                for (uint64_t j = 0; j < numBits; j++) {
-                    multiroarBitSet(roars[i], rand() % 1000);
-                }
-            }
+        multiroarFree(sparse);
+        multiroarFree(dense);
+        multiroarFree(inverted);
+        multiroarFree(full);
+        multiroarFree(andResult);
+        multiroarFree(orResult);
+    }
 
-            /* Test N-way operations don't crash */
-            multiroar *andResult = multiroarNewAndN(n, roars);
-            multiroar *orResult = multiroarNewOrN(n, roars);
-            multiroar *xorResult = multiroarNewXorN(n, roars);
+    TEST("EDGE: Bitcount with very large positions") {
+        multiroar *r = multiroarBitNew();
 
-            /* Basic sanity: AND count <= OR count */
-            uint64_t andCount = multiroarBitCount(andResult);
-            uint64_t orCount = multiroarBitCount(orResult);
+        /* Set bits at very large positions */
+        uint64_t positions[] = {
+            1000000,        10000000,        100000000,       1000000000,
+            10000000000ULL, 100000000000ULL, 1000000000000ULL};
 
-            if (andCount > orCount) {
-                ERR("Trial %" PRIu64 ": AND count %" PRIu64
-                    " > OR count %" PRIu64 "",
-                    trial, andCount, orCount);
-            }
+        for (uint64_t i = 0; i < sizeof(positions) / sizeof(positions[0]);
+             i++) {
+            multiroarBitSet(r, positions[i]);
+        }
 
-            /* Cleanup */
-            for (uint64_t i = 0; i < n; i++) {
-                multiroarFree(roars[i]);
-            }
-            zfree(roars);
-            multiroarFree(andResult);
-            multiroarFree(orResult);
-            multiroarFree(xorResult);
+        uint64_t count = multiroarBitCount(r);
+        if (count != sizeof(positions) / sizeof(positions[0])) {
+            ERR("Large positions bitcount: expected %zu, got %" PRIu64,
+                sizeof(positions) / sizeof(positions[0]), count);
         }
 
-        printf("  completed %" PRIu64 " fuzz trials\n", trials);
+        multiroarFree(r);
     }
 
-    TEST("N-way operations with empty roars") {
+    TEST("EDGE: N=2 equivalence to binary operations") {
         multiroar *r1 = multiroarBitNew();
         multiroar *r2 = multiroarBitNew();
-        multiroar *r3 = multiroarBitNew();
 
-        multiroarBitSet(r2, 100); /* Only r2 has a bit */
+        srand(555555);
+        for (int i = 0; i < 1000; i++) {
+            multiroarBitSet(r1, rand() % 5000);
+            multiroarBitSet(r2, rand() % 5000);
+        }
 
-        multiroar *roars[] = {r1, r2, r3};
+        multiroar *roars[] = {r1, r2};
 
-        /* AND with empty = empty */
-        multiroar *andResult = multiroarNewAndN(3, roars);
-        uint64_t andCount = multiroarBitCount(andResult);
-        if (andCount != 0) {
-            ERR("AND with empty should be 0, got %" PRIu64 "", andCount);
+        /* Test N=2 AND vs binary AND */
+        multiroar *nwayAnd = multiroarNewAndN(2, roars);
+        multiroar *binaryAnd = multiroarNewAnd(r1, r2);
+
+        uint64_t nwayCount = multiroarBitCount(nwayAnd);
+        uint64_t binaryCount = multiroarBitCount(binaryAnd);
+
+        if (nwayCount != binaryCount) {
+            ERR("N=2 AND: nway=%" PRIu64 " binary=%" PRIu64 "", nwayCount,
+                binaryCount);
+        }
+
+        /* Verify bit-by-bit */
+        for (uint64_t i = 0; i < 5000; i++) {
+            if (multiroarBitGet(nwayAnd, i) != multiroarBitGet(binaryAnd, i)) {
+                ERR("N=2 AND: bit %" PRIu64 " mismatch", i);
+                break;
+            }
+        }
+
+        /* Test N=2 OR vs binary OR */
+        multiroar *nwayOr = multiroarNewOrN(2, roars);
+        multiroar *binaryOr = multiroarNewOr(r1, r2);
+
+        nwayCount = multiroarBitCount(nwayOr);
+        binaryCount = multiroarBitCount(binaryOr);
+
+        if (nwayCount != binaryCount) {
+            ERR("N=2 OR: nway=%" PRIu64 " binary=%" PRIu64 "", nwayCount,
+                binaryCount);
         }
 
-        /* OR with empty = union of non-empty */
-        multiroar *orResult = multiroarNewOrN(3, roars);
-        uint64_t orCount = multiroarBitCount(orResult);
-        if (orCount != 1) {
-            ERR("OR with empty should be 1, got %" PRIu64 "", orCount);
+        /* Test N=2 XOR vs binary XOR */
+        multiroar *nwayXor = multiroarNewXorN(2, roars);
+        multiroar *binaryXor = multiroarNewXor(r1, r2);
+
+        nwayCount = multiroarBitCount(nwayXor);
+        binaryCount = multiroarBitCount(binaryXor);
+
+        if (nwayCount != binaryCount) {
+            ERR("N=2 XOR: nway=%" PRIu64 " binary=%" PRIu64 "", nwayCount,
+                binaryCount);
         }
 
         multiroarFree(r1);
         multiroarFree(r2);
-        multiroarFree(r3);
-        multiroarFree(andResult);
-        multiroarFree(orResult);
+        multiroarFree(nwayAnd);
+        multiroarFree(binaryAnd);
+        multiroarFree(nwayOr);
+        multiroarFree(binaryOr);
+        multiroarFree(nwayXor);
+        multiroarFree(binaryXor);
     }
 
-    TEST("bitcount + N-way integration") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
-        multiroar *r3 = multiroarBitNew();
+    TEST("PERF: Bitcount performance across different densities") {
+        const int iterations = 10000;
 
-        /* Set known counts with proper overlaps for AND operation */
-        for (uint64_t i = 0; i < 150; i++) {
-            multiroarBitSet(r1, i);
-        }
-        for (uint64_t i = 50; i < 200; i++) {
-            multiroarBitSet(r2, i);
-        }
-        for (uint64_t i = 100; i < 250; i++) {
-            multiroarBitSet(r3, i);
+        /* Sparse */
+        multiroar *sparse = multiroarBitNew();
+        for (int i = 0; i < 100; i++) {
+            multiroarBitSet(sparse, i * 100);
         }
 
-        /* Verify individual counts */
-        if (multiroarBitCount(r1) != 150) {
-            ERR("r1 count should be 150, got %" PRIu64 "",
-                multiroarBitCount(r1));
-        }
-        if (multiroarBitCount(r2) != 150) {
-            ERR("r2 count should be 150, got %" PRIu64 "",
-                multiroarBitCount(r2));
-        }
-        if (multiroarBitCount(r3) != 150) {
-            ERR("r3 count should be 150, got %" PRIu64 "",
-                multiroarBitCount(r3));
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < iterations; i++) {
+            volatile uint64_t count = multiroarBitCount(sparse);
+            (void)count;
         }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double sparseNs =
+            (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+        sparseNs /= iterations;
 
-        multiroar *roars[] = {r1, r2, r3};
-
-        /* AND: intersection [100..149] = 50 bits */
-        multiroar *andResult = multiroarNewAndN(3, roars);
-        uint64_t andCount = multiroarBitCount(andResult);
-        if (andCount != 50) {
-            ERR("AND count should be 50, got %" PRIu64 "", andCount);
+        /* Dense */
+        multiroar *dense = multiroarBitNew();
+        for (int i = 0; i < 5000; i++) {
+            multiroarBitSet(dense, i);
         }
 
-        /* OR: union [0..249] = 250 bits */
-        multiroar *orResult = multiroarNewOrN(3, roars);
-        uint64_t orCount = multiroarBitCount(orResult);
-        if (orCount != 250) {
-            ERR("OR count should be 250, got %" PRIu64 "", orCount);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < iterations; i++) {
+            volatile uint64_t count = multiroarBitCount(dense);
+            (void)count;
         }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double denseNs =
+            (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+        denseNs /= iterations;
 
-        printf("  Integration: AND=%" PRIu64 " OR=%" PRIu64 "\n", andCount,
-               orCount);
+        printf("  Sparse: %.1f ns/op, Dense: %.1f ns/op\n", sparseNs, denseNs);
 
-        multiroarFree(r1);
-        multiroarFree(r2);
-        multiroarFree(r3);
-        multiroarFree(andResult);
-        multiroarFree(orResult);
+        multiroarFree(sparse);
+        multiroarFree(dense);
     }
 
-    printf("\n=== All new functionality tests completed! ===\n\n");
+    TEST("PERF: N-way operations vs chained binary (N=10)") {
+        const int n = 10;
+        multiroar **roars = zmalloc(n * sizeof(multiroar *));
 
-    /* ================================================================
-     * ADVANCED FUZZING AND EDGE CASE TESTS
-     * ================================================================ */
+        srand(666666);
+        for (int i = 0; i < n; i++) {
+            roars[i] = multiroarBitNew();
+            for (int j = 0; j < 500; j++) {
+                multiroarBitSet(roars[i], rand() % 5000);
+            }
+        }
 
-    printf("=== ADVANCED FUZZING TESTS ===\n\n");
+        /* N-way AND performance */
+        struct timespec start, end;
+        const int iterations = 1000;
 
-    TEST("FUZZ: bitcount with all chunk types (1K iterations)") {
-        srand(99999);
-        for (int trial = 0; trial < 1000; trial++) {
-            multiroar *r = multiroarBitNew();
-            uint64_t expectedCount = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < iterations; i++) {
+            multiroar *result = multiroarNewAndN(n, roars);
+            multiroarFree(result);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double nwayNs =
+            (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+        nwayNs /= iterations;
 
-            /* Set random number of bits to trigger different chunk types */
-            int numBits = rand() % 10000;
-            for (int i = 0; i < numBits; i++) {
-                uint64_t pos = ((uint64_t)rand() * rand()) % 1000000;
-                if (!multiroarBitGet(r, pos)) {
-                    multiroarBitSet(r, pos);
-                    expectedCount++;
-                }
+        /* Chained binary AND performance */
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < iterations; i++) {
+            multiroar *result = multiroarDuplicate(roars[0]);
+            for (int j = 1; j < n; j++) {
+                multiroarAnd(result, roars[j]);
             }
+            multiroarFree(result);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double chainedNs =
+            (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+        chainedNs /= iterations;
 
-            uint64_t actualCount = multiroarBitCount(r);
-            if (actualCount != expectedCount) {
-                ERR("FUZZ bitcount: expected %" PRIu64 ", got %" PRIu64
-                    " (trial %d)",
-                    expectedCount, actualCount, trial);
-                break;
-            }
+        printf("  N=10 AND: N-way=%.0f ns, Chained=%.0f ns, Ratio=%.2fx\n",
+               nwayNs, chainedNs, chainedNs / nwayNs);
 
-            multiroarFree(r);
+        for (int i = 0; i < n; i++) {
+            multiroarFree(roars[i]);
         }
-        printf("  Completed 1K bitcount fuzz iterations\n");
+        zfree(roars);
     }
 
-    TEST("FUZZ: N-way AND with random overlaps (1K iterations)") {
-        srand(111111);
-        for (int trial = 0; trial < 1000; trial++) {
-            int n = 2 + (rand() % 8); /* 2-9 inputs */
-            multiroar **roars = zmalloc(n * sizeof(multiroar *));
+    printf("\n=== All advanced fuzzing tests completed! ===\n\n");
 
-            for (int i = 0; i < n; i++) {
-                roars[i] = multiroarBitNew();
-                /* Set overlapping ranges */
-                uint64_t start = (rand() % 500);
-                uint64_t count = 50 + (rand() % 200);
-                for (uint64_t j = start; j < start + count; j++) {
-                    multiroarBitSet(roars[i], j);
-                }
-            }
+    /* ====================================================================
+     * Min/Max/IsEmpty/Comparison Operations Tests
+     * ==================================================================== */
 
-            /* Test N-way vs chained binary */
-            multiroar *nwayResult = multiroarNewAndN(n, roars);
-            multiroar *chainedResult = multiroarDuplicate(roars[0]);
-            for (int i = 1; i < n; i++) {
-                multiroarAnd(chainedResult, roars[i]);
-            }
+    TEST("multiroarMin/Max - empty bitmap") {
+        multiroar *r = multiroarBitNew();
+        uint64_t position;
 
-            uint64_t nwayCount = multiroarBitCount(nwayResult);
-            uint64_t chainedCount = multiroarBitCount(chainedResult);
+        if (multiroarMin(r, &position)) {
+            ERRR("Min should return false for empty bitmap");
+        }
+        if (multiroarMax(r, &position)) {
+            ERRR("Max should return false for empty bitmap");
+        }
 
-            if (nwayCount != chainedCount) {
-                ERR("FUZZ N-way AND: nway=%" PRIu64 " chained=%" PRIu64
-                    " (trial %d, n=%d)",
-                    nwayCount, chainedCount, trial, n);
-                break;
-            }
+        multiroarFree(r);
+    }
 
-            /* Verify random positions */
-            for (int i = 0; i < 100; i++) {
-                uint64_t pos = rand() % 1000;
-                bool nway = multiroarBitGet(nwayResult, pos);
-                bool chained = multiroarBitGet(chainedResult, pos);
-                if (nway != chained) {
-                    ERR("FUZZ AND: bit %" PRIu64 " mismatch at trial %d", pos,
-                        trial);
-                    break;
-                }
-            }
+    TEST("multiroarIsEmpty - empty and non-empty") {
+        multiroar *r = multiroarBitNew();
 
-            for (int i = 0; i < n; i++) {
-                multiroarFree(roars[i]);
-            }
-            zfree(roars);
-            multiroarFree(nwayResult);
-            multiroarFree(chainedResult);
+        if (!multiroarIsEmpty(r)) {
+            ERRR("Newly created bitmap should be empty");
         }
-        printf("  Completed 1K N-way AND fuzz iterations\n");
-    }
 
-    TEST("FUZZ: N-way OR with random overlaps (1K iterations)") {
-        srand(222222);
-        for (int trial = 0; trial < 1000; trial++) {
-            int n = 2 + (rand() % 8);
-            multiroar **roars = zmalloc(n * sizeof(multiroar *));
+        multiroarBitSet(r, 42);
+        if (multiroarIsEmpty(r)) {
+            ERRR("Bitmap with bit set should not be empty");
+        }
 
-            for (int i = 0; i < n; i++) {
-                roars[i] = multiroarBitNew();
-                uint64_t start = (rand() % 500);
-                uint64_t count = 50 + (rand() % 200);
-                for (uint64_t j = start; j < start + count; j++) {
-                    multiroarBitSet(roars[i], j);
-                }
-            }
+        multiroarRemove(r, 42);
+        if (!multiroarIsEmpty(r)) {
+            ERRR("Bitmap after removing all bits should be empty");
+        }
 
-            multiroar *nwayResult = multiroarNewOrN(n, roars);
-            multiroar *chainedResult = multiroarDuplicate(roars[0]);
-            for (int i = 1; i < n; i++) {
-                multiroarOr(chainedResult, roars[i]);
-            }
+        multiroarFree(r);
+    }
+
+    TEST("multiroarMin/Max - single bit at various positions") {
+        uint64_t testPositions[] = {0,    1,    100,    8191,
+                                    8192, 8193, 100000, 1000000};
 
-            uint64_t nwayCount = multiroarBitCount(nwayResult);
-            uint64_t chainedCount = multiroarBitCount(chainedResult);
+        for (uint64_t i = 0;
+             i < sizeof(testPositions) / sizeof(testPositions[0]); i++) {
+            multiroar *r = multiroarBitNew();
+            uint64_t pos = testPositions[i];
 
-            if (nwayCount != chainedCount) {
-                ERR("FUZZ N-way OR: nway=%" PRIu64 " chained=%" PRIu64
-                    " (trial %d)",
-                    nwayCount, chainedCount, trial);
-                break;
-            }
+            multiroarBitSet(r, pos);
 
-            for (int i = 0; i < n; i++) {
-                multiroarFree(roars[i]);
+            uint64_t minPos, maxPos;
+            if (!multiroarMin(r, &minPos) || minPos != pos) {
+                ERR("Min position mismatch: expected %" PRIu64 ", got %" PRIu64
+                    "",
+                    pos, minPos);
             }
-            zfree(roars);
-            multiroarFree(nwayResult);
-            multiroarFree(chainedResult);
+            if (!multiroarMax(r, &maxPos) || maxPos != pos) {
+                ERR("Max position mismatch: expected %" PRIu64 ", got %" PRIu64
+                    "",
+                    pos, maxPos);
+            }
+
+            multiroarFree(r);
         }
-        printf("  Completed 1K N-way OR fuzz iterations\n");
     }
 
-    TEST("FUZZ: N-way XOR with random overlaps (1K iterations)") {
-        srand(333333);
-        for (int trial = 0; trial < 1000; trial++) {
-            int n = 2 + (rand() % 8);
-            multiroar **roars = zmalloc(n * sizeof(multiroar *));
+    TEST("multiroarMin/Max - sparse chunk (UNDER_FULL)") {
+        multiroar *r = multiroarBitNew();
 
-            for (int i = 0; i < n; i++) {
-                roars[i] = multiroarBitNew();
-                uint64_t start = (rand() % 500);
-                uint64_t count = 50 + (rand() % 200);
-                for (uint64_t j = start; j < start + count; j++) {
-                    multiroarBitSet(roars[i], j);
-                }
-            }
+        /* Set bits at positions that will stay sparse (<631 bits per chunk) */
+        multiroarBitSet(r, 100);
+        multiroarBitSet(r, 500);
+        multiroarBitSet(r, 1000);
 
-            multiroar *nwayResult = multiroarNewXorN(n, roars);
-            multiroar *chainedResult = multiroarDuplicate(roars[0]);
-            for (int i = 1; i < n; i++) {
-                multiroarXor(chainedResult, roars[i]);
-            }
+        uint64_t minPos, maxPos;
+        if (!multiroarMin(r, &minPos) || minPos != 100) {
+            ERR("Min for sparse chunk: expected 100, got %" PRIu64 "", minPos);
+        }
+        if (!multiroarMax(r, &maxPos) || maxPos != 1000) {
+            ERR("Max for sparse chunk: expected 1000, got %" PRIu64 "", maxPos);
+        }
 
-            uint64_t nwayCount = multiroarBitCount(nwayResult);
-            uint64_t chainedCount = multiroarBitCount(chainedResult);
+        multiroarFree(r);
+    }
 
-            if (nwayCount != chainedCount) {
-                ERR("FUZZ N-way XOR: nway=%" PRIu64 " chained=%" PRIu64
-                    " (trial %d)",
-                    nwayCount, chainedCount, trial);
-                break;
-            }
+    TEST("multiroarMin/Max - dense chunk (FULL_BITMAP)") {
+        multiroar *r = multiroarBitNew();
 
-            for (int i = 0; i < n; i++) {
-                multiroarFree(roars[i]);
-            }
-            zfree(roars);
-            multiroarFree(nwayResult);
-            multiroarFree(chainedResult);
+        /* Set many bits to trigger dense encoding (631-7561 bits) */
+        for (uint64_t i = 100; i < 1100; i++) {
+            multiroarBitSet(r, i);
         }
-        printf("  Completed 1K N-way XOR fuzz iterations\n");
+
+        uint64_t minPos, maxPos;
+        if (!multiroarMin(r, &minPos) || minPos != 100) {
+            ERR("Min for dense chunk: expected 100, got %" PRIu64 "", minPos);
+        }
+        if (!multiroarMax(r, &maxPos) || maxPos != 1099) {
+            ERR("Max for dense chunk: expected 1099, got %" PRIu64 "", maxPos);
+        }
+
+        multiroarFree(r);
     }
 
-    TEST("EDGE: bitcount with chunk type transitions") {
+    TEST("multiroarMin/Max - inverted chunk (OVER_FULL)") {
         multiroar *r = multiroarBitNew();
-        uint64_t count = 0;
 
-        /* Start with UNDER_FULL (sparse) */
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(r, i * 100);
-            count++;
-        }
-        if (multiroarBitCount(r) != count) {
-            ERR("Sparse chunk bitcount: expected %" PRIu64 ", got %" PRIu64 "",
-                count, multiroarBitCount(r));
+        /* Set most bits in a chunk to trigger inverted encoding (>7561 bits) */
+        for (uint64_t i = 10; i < 8190; i++) {
+            multiroarBitSet(r, i);
         }
 
-        /* Transition to FULL_BITMAP (dense) */
-        for (uint64_t i = 0; i < 2000; i++) {
-            if (!multiroarBitGet(r, i)) {
-                multiroarBitSet(r, i);
-                count++;
-            }
+        uint64_t minPos, maxPos;
+        if (!multiroarMin(r, &minPos) || minPos != 10) {
+            ERR("Min for inverted chunk: expected 10, got %" PRIu64 "", minPos);
         }
-        if (multiroarBitCount(r) != count) {
-            ERR("Dense chunk bitcount: expected %" PRIu64 ", got %" PRIu64 "",
-                count, multiroarBitCount(r));
+        if (!multiroarMax(r, &maxPos) || maxPos != 8189) {
+            ERR("Max for inverted chunk: expected 8189, got %" PRIu64 "",
+                maxPos);
         }
 
-        /* Transition to OVER_FULL (inverted) */
-        for (uint64_t i = 0; i < 8000; i++) {
-            if (!multiroarBitGet(r, i)) {
-                multiroarBitSet(r, i);
-                count++;
-            }
-        }
-        if (multiroarBitCount(r) != count) {
-            ERR("Inverted chunk bitcount: expected %" PRIu64 ", got %" PRIu64
-                "",
-                count, multiroarBitCount(r));
-        }
+        multiroarFree(r);
+    }
 
-        /* Transition to ALL_1 (all bits set) */
+    TEST("multiroarMin/Max - full chunk (ALL_1)") {
+        multiroar *r = multiroarBitNew();
+
+        /* Set all bits in a chunk */
         for (uint64_t i = 0; i < 8192; i++) {
-            if (!multiroarBitGet(r, i)) {
-                multiroarBitSet(r, i);
-                count++;
-            }
+            multiroarBitSet(r, i);
         }
-        if (multiroarBitCount(r) != count) {
-            ERR("All-ones chunk bitcount: expected %" PRIu64 ", got %" PRIu64
-                "",
-                count, multiroarBitCount(r));
+
+        uint64_t minPos, maxPos;
+        if (!multiroarMin(r, &minPos) || minPos != 0) {
+            ERR("Min for full chunk: expected 0, got %" PRIu64 "", minPos);
+        }
+        if (!multiroarMax(r, &maxPos) || maxPos != 8191) {
+            ERR("Max for full chunk: expected 8191, got %" PRIu64 "", maxPos);
         }
 
         multiroarFree(r);
     }
 
-    TEST("EDGE: N-way operations with very large N (N=100)") {
-        const int n = 100;
-        multiroar **roars = zmalloc(n * sizeof(multiroar *));
-
-        srand(444444);
-        for (int i = 0; i < n; i++) {
-            roars[i] = multiroarBitNew();
-            /* Each sets bit at position i to guarantee some overlap */
-            multiroarBitSet(roars[i], i);
-            /* Plus some random bits */
-            for (int j = 0; j < 10; j++) {
-                multiroarBitSet(roars[i], rand() % 1000);
-            }
-        }
+    TEST("multiroarMin/Max - multiple chunks") {
+        multiroar *r = multiroarBitNew();
 
-        multiroar *orResult = multiroarNewOrN(n, roars);
-        uint64_t orCount = multiroarBitCount(orResult);
+        /* Set bits across multiple chunks */
+        multiroarBitSet(r, 100);     /* Chunk 0 */
+        multiroarBitSet(r, 10000);   /* Chunk 1 */
+        multiroarBitSet(r, 100000);  /* Chunk 12 */
+        multiroarBitSet(r, 1000000); /* Chunk 122 */
 
-        /* OR should have at least N bits (positions 0..N-1) */
-        if (orCount < (uint64_t)n) {
-            ERR("N=100 OR: count %" PRIu64 " should be >= %d", orCount, n);
+        uint64_t minPos, maxPos;
+        if (!multiroarMin(r, &minPos) || minPos != 100) {
+            ERR("Min for multi-chunk: expected 100, got %" PRIu64 "", minPos);
+        }
+        if (!multiroarMax(r, &maxPos) || maxPos != 1000000) {
+            ERR("Max for multi-chunk: expected 1000000, got %" PRIu64 "",
+                maxPos);
         }
 
-        multiroar *andResult = multiroarNewAndN(n, roars);
-        uint64_t andCount = multiroarBitCount(andResult);
+        multiroarFree(r);
+    }
 
-        /* AND should be small (likely 0) since each roar has unique bits */
-        if (andCount > 50) {
-            ERR("N=100 AND: count %" PRIu64 " unexpectedly large", andCount);
-        }
+    TEST("multiroarMin/Max - chunk boundaries") {
+        multiroar *r = multiroarBitNew();
 
-        printf("  N=100: OR=%" PRIu64 " AND=%" PRIu64 "\n", orCount, andCount);
+        /* Test at chunk boundaries (8192 bits per chunk) */
+        multiroarBitSet(r, 0);     /* First bit of chunk 0 */
+        multiroarBitSet(r, 8191);  /* Last bit of chunk 0 */
+        multiroarBitSet(r, 8192);  /* First bit of chunk 1 */
+        multiroarBitSet(r, 16383); /* Last bit of chunk 1 */
 
-        for (int i = 0; i < n; i++) {
-            multiroarFree(roars[i]);
+        uint64_t minPos, maxPos;
+        if (!multiroarMin(r, &minPos) || minPos != 0) {
+            ERR("Min at chunk boundary: expected 0, got %" PRIu64 "", minPos);
         }
-        zfree(roars);
-        multiroarFree(orResult);
-        multiroarFree(andResult);
+        if (!multiroarMax(r, &maxPos) || maxPos != 16383) {
+            ERR("Max at chunk boundary: expected 16383, got %" PRIu64 "",
+                maxPos);
+        }
+
+        multiroarFree(r);
     }
 
-    TEST("EDGE: Multi-chunk operations across boundaries") {
+    TEST("multiroarIntersects - empty and disjoint") {
         multiroar *r1 = multiroarBitNew();
         multiroar *r2 = multiroarBitNew();
-        multiroar *r3 = multiroarBitNew();
 
-        /* Set bits in different chunks (chunks are 8192 bits each) */
-        /* Chunk 0: bits 0-8191 - with proper overlaps */
-        for (uint64_t i = 0; i < 2000; i++) {
-            multiroarBitSet(r1, i);
-        }
-        for (uint64_t i = 500; i < 2500; i++) {
-            multiroarBitSet(r2, i);
-        }
-        for (uint64_t i = 1000; i < 3000; i++) {
-            multiroarBitSet(r3, i);
-        }
-
-        /* Chunk 1: bits 8192-16383 - with proper overlaps */
-        for (uint64_t i = 8192; i < 10192; i++) {
-            multiroarBitSet(r1, i);
-        }
-        for (uint64_t i = 8692; i < 10692; i++) {
-            multiroarBitSet(r2, i);
-        }
-        for (uint64_t i = 9192; i < 11192; i++) {
-            multiroarBitSet(r3, i);
+        /* Both empty */
+        if (multiroarIntersects(r1, r2)) {
+            ERRR("Empty bitmaps should not intersect");
         }
 
-        /* Chunk 10: bits 81920-90111 - with proper overlaps */
-        for (uint64_t i = 81920; i < 83920; i++) {
-            multiroarBitSet(r1, i);
-        }
-        for (uint64_t i = 82420; i < 84420; i++) {
-            multiroarBitSet(r2, i);
+        /* One empty */
+        multiroarBitSet(r1, 100);
+        if (multiroarIntersects(r1, r2)) {
+            ERRR("One empty bitmap should not intersect");
         }
-        for (uint64_t i = 82920; i < 84920; i++) {
-            multiroarBitSet(r3, i);
+
+        /* Disjoint */
+        multiroarBitSet(r2, 200);
+        if (multiroarIntersects(r1, r2)) {
+            ERRR("Disjoint bitmaps should not intersect");
         }
 
-        multiroar *roars[] = {r1, r2, r3};
+        multiroarFree(r1);
+        multiroarFree(r2);
+    }
 
-        /* Test AND across chunks - should have overlaps */
-        multiroar *andResult = multiroarNewAndN(3, roars);
-        uint64_t andCount = multiroarBitCount(andResult);
+    TEST("multiroarIntersects - overlapping") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
 
-        /* Should have overlaps: chunk0=[1000..1999], chunk1=[9192..10191],
-         * chunk10=[82920..83919] */
-        uint64_t expectedAnd = 1000 + 1000 + 1000; /* 3000 bits total overlap */
-        if (andCount != expectedAnd) {
-            ERR("Multi-chunk AND: expected %" PRIu64 ", got %" PRIu64 "",
-                expectedAnd, andCount);
+        /* Same chunk, overlapping bits */
+        multiroarBitSet(r1, 100);
+        multiroarBitSet(r1, 200);
+        multiroarBitSet(r2, 200);
+        multiroarBitSet(r2, 300);
+
+        if (!multiroarIntersects(r1, r2)) {
+            ERRR("Overlapping bitmaps should intersect");
         }
 
-        /* Test OR across chunks */
-        multiroar *orResult = multiroarNewOrN(3, roars);
-        uint64_t orCount = multiroarBitCount(orResult);
+        multiroarFree(r1);
+        multiroarFree(r2);
+    }
 
-        /* OR should be union of all ranges */
-        /* chunk0: [0..2999], chunk1: [8192..11191], chunk10: [81920..84919] */
-        uint64_t expectedOr = 3000 + 3000 + 3000; /* 9000 bits total */
-        if (orCount != expectedOr) {
-            ERR("Multi-chunk OR: expected %" PRIu64 ", got %" PRIu64 "",
-                expectedOr, orCount);
+    TEST("multiroarIntersects - different chunks") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
+
+        /* Different chunks, no overlap */
+        multiroarBitSet(r1, 100);
+        multiroarBitSet(r2, 10000);
+
+        if (multiroarIntersects(r1, r2)) {
+            ERRR("Bits in different chunks should not intersect");
         }
 
-        printf("  Multi-chunk: AND=%" PRIu64 " OR=%" PRIu64 "\n", andCount,
-               orCount);
+        /* Same bit in different chunk */
+        multiroarBitSet(r1, 10000);
+
+        if (!multiroarIntersects(r1, r2)) {
+            ERRR("Same bit in same chunk should intersect");
+        }
 
         multiroarFree(r1);
         multiroarFree(r2);
-        multiroarFree(r3);
-        multiroarFree(andResult);
-        multiroarFree(orResult);
     }
 
-    TEST("EDGE: Operations with all chunk types mixed") {
-        multiroar *sparse = multiroarBitNew();
-        multiroar *dense = multiroarBitNew();
-        multiroar *inverted = multiroarBitNew();
-        multiroar *full = multiroarBitNew();
+    TEST("multiroarIsSubset - empty sets") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
 
-        /* Sparse chunk (< 631 bits) */
-        for (uint64_t i = 0; i < 300; i++) {
-            multiroarBitSet(sparse, i * 10);
+        /* Empty set is subset of empty set */
+        if (!multiroarIsSubset(r1, r2)) {
+            ERRR("Empty set should be subset of empty set");
         }
 
-        /* Dense chunk (631-7561 bits) */
-        for (uint64_t i = 0; i < 2000; i++) {
-            multiroarBitSet(dense, i);
+        /* Empty set is subset of any set */
+        multiroarBitSet(r2, 100);
+        if (!multiroarIsSubset(r1, r2)) {
+            ERRR("Empty set should be subset of non-empty set");
         }
 
-        /* Inverted chunk (> 7561 bits) */
-        for (uint64_t i = 0; i < 8000; i++) {
-            multiroarBitSet(inverted, i);
+        /* Non-empty set is not subset of empty set */
+        if (multiroarIsSubset(r2, r1)) {
+            ERRR("Non-empty set should not be subset of empty set");
         }
 
-        /* Full chunk (all 8192 bits) */
-        for (uint64_t i = 0; i < 8192; i++) {
-            multiroarBitSet(full, i);
-        }
+        multiroarFree(r1);
+        multiroarFree(r2);
+    }
 
-        /* Verify counts */
-        if (multiroarBitCount(sparse) != 300) {
-            ERR("Sparse count: expected 300, got %" PRIu64 "",
-                multiroarBitCount(sparse));
-        }
-        if (multiroarBitCount(dense) != 2000) {
-            ERR("Dense count: expected 2000, got %" PRIu64 "",
-                multiroarBitCount(dense));
-        }
-        if (multiroarBitCount(inverted) != 8000) {
-            ERR("Inverted count: expected 8000, got %" PRIu64 "",
-                multiroarBitCount(inverted));
+    TEST("multiroarIsSubset - equal sets") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
+
+        multiroarBitSet(r1, 100);
+        multiroarBitSet(r1, 200);
+        multiroarBitSet(r2, 100);
+        multiroarBitSet(r2, 200);
+
+        /* Equal sets are subsets of each other */
+        if (!multiroarIsSubset(r1, r2)) {
+            ERRR("Equal sets should be subsets of each other (r1 ⊆ r2)");
         }
-        if (multiroarBitCount(full) != 8192) {
-            ERR("Full count: expected 8192, got %" PRIu64 "",
-                multiroarBitCount(full));
+        if (!multiroarIsSubset(r2, r1)) {
+            ERRR("Equal sets should be subsets of each other (r2 ⊆ r1)");
         }
 
-        multiroar *roars[] = {sparse, dense, inverted, full};
+        multiroarFree(r1);
+        multiroarFree(r2);
+    }
 
-        /* AND of all types - should be sparse positions only */
-        multiroar *andResult = multiroarNewAndN(4, roars);
-        uint64_t andCount = multiroarBitCount(andResult);
-        /* All have bits [0, 10, 20, ... 290] in common = ~30 bits */
-        if (andCount == 0 || andCount > 300) {
-            ERR("Mixed types AND: count %" PRIu64 " unexpected", andCount);
-        }
+    TEST("multiroarIsSubset - proper subset") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
 
-        /* OR of all types - should be full chunk */
-        multiroar *orResult = multiroarNewOrN(4, roars);
-        uint64_t orCount = multiroarBitCount(orResult);
-        if (orCount != 8192) {
-            ERR("Mixed types OR: expected 8192, got %" PRIu64 "", orCount);
+        multiroarBitSet(r1, 100);
+        multiroarBitSet(r2, 100);
+        multiroarBitSet(r2, 200);
+
+        /* r1 ⊂ r2 (proper subset) */
+        if (!multiroarIsSubset(r1, r2)) {
+            ERRR("r1 should be subset of r2");
         }
 
-        printf("  Mixed chunk types: AND=%" PRIu64 " OR=%" PRIu64 "\n",
-               andCount, orCount);
+        /* r2 ⊄ r1 (not a subset) */
+        if (multiroarIsSubset(r2, r1)) {
+            ERRR("r2 should not be subset of r1");
+        }
 
-        multiroarFree(sparse);
-        multiroarFree(dense);
-        multiroarFree(inverted);
-        multiroarFree(full);
-        multiroarFree(andResult);
-        multiroarFree(orResult);
+        multiroarFree(r1);
+        multiroarFree(r2);
     }
 
-    TEST("EDGE: Bitcount with very large positions") {
-        multiroar *r = multiroarBitNew();
+    TEST("multiroarIsSubset - non-subset") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
 
-        /* Set bits at very large positions */
-        uint64_t positions[] = {
-            1000000,        10000000,        100000000,       1000000000,
-            10000000000ULL, 100000000000ULL, 1000000000000ULL};
+        multiroarBitSet(r1, 100);
+        multiroarBitSet(r1, 300);
+        multiroarBitSet(r2, 200);
+        multiroarBitSet(r2, 400);
 
-        for (uint64_t i = 0; i < sizeof(positions) / sizeof(positions[0]);
-             i++) {
-            multiroarBitSet(r, positions[i]);
+        /* Disjoint sets are not subsets */
+        if (multiroarIsSubset(r1, r2)) {
+            ERRR("Disjoint r1 should not be subset of r2");
         }
-
-        uint64_t count = multiroarBitCount(r);
-        if (count != sizeof(positions) / sizeof(positions[0])) {
-            ERR("Large positions bitcount: expected %zu, got %" PRIu64,
-                sizeof(positions) / sizeof(positions[0]), count);
+        if (multiroarIsSubset(r2, r1)) {
+            ERRR("Disjoint r2 should not be subset of r1");
         }
 
-        multiroarFree(r);
+        multiroarFree(r1);
+        multiroarFree(r2);
     }
 
-    TEST("EDGE: N=2 equivalence to binary operations") {
+    TEST("multiroarEquals - empty bitmaps") {
         multiroar *r1 = multiroarBitNew();
         multiroar *r2 = multiroarBitNew();
 
-        srand(555555);
-        for (int i = 0; i < 1000; i++) {
-            multiroarBitSet(r1, rand() % 5000);
-            multiroarBitSet(r2, rand() % 5000);
+        if (!multiroarEquals(r1, r2)) {
+            ERRR("Empty bitmaps should be equal");
         }
 
-        multiroar *roars[] = {r1, r2};
+        multiroarFree(r1);
+        multiroarFree(r2);
+    }
 
-        /* Test N=2 AND vs binary AND */
-        multiroar *nwayAnd = multiroarNewAndN(2, roars);
-        multiroar *binaryAnd = multiroarNewAnd(r1, r2);
+    TEST("multiroarEquals - identical bitmaps") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
 
-        uint64_t nwayCount = multiroarBitCount(nwayAnd);
-        uint64_t binaryCount = multiroarBitCount(binaryAnd);
+        multiroarBitSet(r1, 100);
+        multiroarBitSet(r1, 200);
+        multiroarBitSet(r1, 10000);
 
-        if (nwayCount != binaryCount) {
-            ERR("N=2 AND: nway=%" PRIu64 " binary=%" PRIu64 "", nwayCount,
-                binaryCount);
-        }
+        multiroarBitSet(r2, 100);
+        multiroarBitSet(r2, 200);
+        multiroarBitSet(r2, 10000);
 
-        /* Verify bit-by-bit */
-        for (uint64_t i = 0; i < 5000; i++) {
-            if (multiroarBitGet(nwayAnd, i) != multiroarBitGet(binaryAnd, i)) {
-                ERR("N=2 AND: bit %" PRIu64 " mismatch", i);
-                break;
-            }
+        if (!multiroarEquals(r1, r2)) {
+            ERRR("Identical bitmaps should be equal");
         }
 
-        /* Test N=2 OR vs binary OR */
-        multiroar *nwayOr = multiroarNewOrN(2, roars);
-        multiroar *binaryOr = multiroarNewOr(r1, r2);
+        multiroarFree(r1);
+        multiroarFree(r2);
+    }
 
-        nwayCount = multiroarBitCount(nwayOr);
-        binaryCount = multiroarBitCount(binaryOr);
+    TEST("multiroarEquals - different sizes") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
 
-        if (nwayCount != binaryCount) {
-            ERR("N=2 OR: nway=%" PRIu64 " binary=%" PRIu64 "", nwayCount,
-                binaryCount);
+        multiroarBitSet(r1, 100);
+        multiroarBitSet(r2, 100);
+        multiroarBitSet(r2, 200);
+
+        if (multiroarEquals(r1, r2)) {
+            ERRR("Bitmaps with different sizes should not be equal");
         }
 
-        /* Test N=2 XOR vs binary XOR */
-        multiroar *nwayXor = multiroarNewXorN(2, roars);
-        multiroar *binaryXor = multiroarNewXor(r1, r2);
+        multiroarFree(r1);
+        multiroarFree(r2);
+    }
 
-        nwayCount = multiroarBitCount(nwayXor);
-        binaryCount = multiroarBitCount(binaryXor);
+    TEST("multiroarEquals - different positions") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
 
-        if (nwayCount != binaryCount) {
-            ERR("N=2 XOR: nway=%" PRIu64 " binary=%" PRIu64 "", nwayCount,
-                binaryCount);
+        multiroarBitSet(r1, 100);
+        multiroarBitSet(r2, 200);
+
+        if (multiroarEquals(r1, r2)) {
+            ERRR("Bitmaps with different positions should not be equal");
         }
 
         multiroarFree(r1);
         multiroarFree(r2);
-        multiroarFree(nwayAnd);
-        multiroarFree(binaryAnd);
-        multiroarFree(nwayOr);
-        multiroarFree(binaryOr);
-        multiroarFree(nwayXor);
-        multiroarFree(binaryXor);
     }
 
-    TEST("PERF: Bitcount performance across different densities") {
-        const int iterations = 10000;
+    TEST("multiroarEquals - different chunks") {
+        multiroar *r1 = multiroarBitNew();
+        multiroar *r2 = multiroarBitNew();
 
-        /* Sparse */
-        multiroar *sparse = multiroarBitNew();
-        for (int i = 0; i < 100; i++) {
-            multiroarBitSet(sparse, i * 100);
-        }
+        multiroarBitSet(r1, 100);
+        multiroarBitSet(r2, 10000);
 
-        struct timespec start, end;
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        for (int i = 0; i < iterations; i++) {
-            volatile uint64_t count = multiroarBitCount(sparse);
-            (void)count;
+        if (multiroarEquals(r1, r2)) {
+            ERRR("Bitmaps with bits in different chunks should not be equal");
         }
-        clock_gettime(CLOCK_MONOTONIC, &end);
-        double sparseNs =
-            (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
-        sparseNs /= iterations;
 
-        /* Dense */
-        multiroar *dense = multiroarBitNew();
-        for (int i = 0; i < 5000; i++) {
-            multiroarBitSet(dense, i);
-        }
+        multiroarFree(r1);
+        multiroarFree(r2);
+    }
 
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        for (int i = 0; i < iterations; i++) {
-            volatile uint64_t count = multiroarBitCount(dense);
-            (void)count;
-        }
-        clock_gettime(CLOCK_MONOTONIC, &end);
-        double denseNs =
-            (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
-        denseNs /= iterations;
+    TEST_DESC("min/max/comparison fuzzing - %d random operations", 1000) {
+        for (int trial = 0; trial < 1000; trial++) {
+            multiroar *r1 = multiroarBitNew();
+            multiroar *r2 = multiroarBitNew();
 
-        printf("  Sparse: %.1f ns/op, Dense: %.1f ns/op\n", sparseNs, denseNs);
+            /* Create random bitmaps */
+            int numBits1 = rand() % 500;
+            int numBits2 = rand() % 500;
 
-        multiroarFree(sparse);
-        multiroarFree(dense);
-    }
+            uint64_t min1 = UINT64_MAX, max1 = 0;
+            uint64_t min2 = UINT64_MAX, max2 = 0;
 
-    TEST("PERF: N-way operations vs chained binary (N=10)") {
-        const int n = 10;
-        multiroar **roars = zmalloc(n * sizeof(multiroar *));
+            for (int i = 0; i < numBits1; i++) {
+                uint64_t pos = ((uint64_t)rand() * rand()) % 100000;
+                multiroarBitSet(r1, pos);
+                if (pos < min1) {
+                    min1 = pos;
+                }
+                if (pos > max1) {
+                    max1 = pos;
+                }
+            }
 
-        srand(666666);
-        for (int i = 0; i < n; i++) {
-            roars[i] = multiroarBitNew();
-            for (int j = 0; j < 500; j++) {
-                multiroarBitSet(roars[i], rand() % 5000);
+            for (int i = 0; i < numBits2; i++) {
+                uint64_t pos = ((uint64_t)rand() * rand()) % 100000;
+                multiroarBitSet(r2, pos);
+                if (pos < min2) {
+                    min2 = pos;
+                }
+                if (pos > max2) {
+                    max2 = pos;
+                }
             }
-        }
 
-        /* N-way AND performance */
-        struct timespec start, end;
-        const int iterations = 1000;
+            /* Verify Min/Max */
+            if (numBits1 > 0) {
+                uint64_t actualMin, actualMax;
+                if (!multiroarMin(r1, &actualMin)) {
+                    ERRR("Min should succeed for non-empty bitmap");
+                }
+                if (!multiroarMax(r1, &actualMax)) {
+                    ERRR("Max should succeed for non-empty bitmap");
+                }
 
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        for (int i = 0; i < iterations; i++) {
-            multiroar *result = multiroarNewAndN(n, roars);
-            multiroarFree(result);
-        }
-        clock_gettime(CLOCK_MONOTONIC, &end);
-        double nwayNs =
-            (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
-        nwayNs /= iterations;
+                /* Verify min/max are actually set */
+                if (!multiroarBitGet(r1, actualMin)) {
+                    ERR("Min position %" PRIu64 " should be set", actualMin);
+                }
+                if (!multiroarBitGet(r1, actualMax)) {
+                    ERR("Max position %" PRIu64 " should be set", actualMax);
+                }
+            } else {
+                uint64_t pos;
+                if (multiroarMin(r1, &pos)) {
+                    ERRR("Min should fail for empty bitmap");
+                }
+                if (multiroarMax(r1, &pos)) {
+                    ERRR("Max should fail for empty bitmap");
+                }
+            }
 
-        /* Chained binary AND performance */
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        for (int i = 0; i < iterations; i++) {
-            multiroar *result = multiroarDuplicate(roars[0]);
-            for (int j = 1; j < n; j++) {
-                multiroarAnd(result, roars[j]);
+            /* Verify IsEmpty */
+            bool shouldBeEmpty1 = (numBits1 == 0);
+            if (multiroarIsEmpty(r1) != shouldBeEmpty1) {
+                ERR("IsEmpty mismatch: expected %d", shouldBeEmpty1);
             }
-            multiroarFree(result);
-        }
-        clock_gettime(CLOCK_MONOTONIC, &end);
-        double chainedNs =
-            (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
-        chainedNs /= iterations;
 
-        printf("  N=10 AND: N-way=%.0f ns, Chained=%.0f ns, Ratio=%.2fx\n",
-               nwayNs, chainedNs, chainedNs / nwayNs);
+            /* Verify Intersects */
+            bool hasIntersection = false;
+            for (uint64_t pos = 0; pos < 100000; pos++) {
+                if (multiroarBitGet(r1, pos) && multiroarBitGet(r2, pos)) {
+                    hasIntersection = true;
+                    break;
+                }
+            }
+            if (multiroarIntersects(r1, r2) != hasIntersection) {
+                ERR("Intersects mismatch: expected %d", hasIntersection);
+            }
 
-        for (int i = 0; i < n; i++) {
-            multiroarFree(roars[i]);
+            /* Verify Equals */
+            bool shouldBeEqual = true;
+            if (multiroarBitCount(r1) != multiroarBitCount(r2)) {
+                shouldBeEqual = false;
+            } else {
+                for (uint64_t pos = 0; pos < 100000; pos++) {
+                    if (multiroarBitGet(r1, pos) != multiroarBitGet(r2, pos)) {
+                        shouldBeEqual = false;
+                        break;
+                    }
+                }
+            }
+            if (multiroarEquals(r1, r2) != shouldBeEqual) {
+                ERR("Equals mismatch: expected %d", shouldBeEqual);
+            }
+
+            multiroarFree(r1);
+            multiroarFree(r2);
         }
-        zfree(roars);
     }
 
-    printf("\n=== All advanced fuzzing tests completed! ===\n\n");
+    printf("\n=== Min/Max/Comparison tests completed! ===\n\n");
 
     /* ====================================================================
-     * Min/Max/IsEmpty/Comparison Operations Tests
+     * Rank/Select Operations Tests
      * ==================================================================== */
 
-    TEST("multiroarMin/Max - empty bitmap") {
+    TEST("multiroarRank - empty bitmap") {
         multiroar *r = multiroarBitNew();
-        uint64_t position;
 
-        if (multiroarMin(r, &position)) {
-            ERRR("Min should return false for empty bitmap");
+        if (multiroarRank(r, 0) != 0) {
+            ERRR("Rank at 0 for empty bitmap should be 0");
+        }
+        if (multiroarRank(r, 100) != 0) {
+            ERRR("Rank at 100 for empty bitmap should be 0");
+        }
+
+        multiroarFree(r);
+    }
+
+    TEST("multiroarRank - single bit") {
+        multiroar *r = multiroarBitNew();
+        multiroarBitSet(r, 100);
+
+        if (multiroarRank(r, 0) != 0) {
+            ERRR("Rank before bit should be 0");
+        }
+        if (multiroarRank(r, 100) != 0) {
+            ERRR("Rank at bit position should be 0 (excludes position)");
+        }
+        if (multiroarRank(r, 101) != 1) {
+            ERRR("Rank after bit should be 1");
+        }
+        if (multiroarRank(r, 1000) != 1) {
+            ERRR("Rank far after bit should be 1");
+        }
+
+        multiroarFree(r);
+    }
+
+    TEST("multiroarRank - sparse chunk") {
+        multiroar *r = multiroarBitNew();
+        /* Set bits at positions 10, 20, 30 */
+        multiroarBitSet(r, 10);
+        multiroarBitSet(r, 20);
+        multiroarBitSet(r, 30);
+
+        if (multiroarRank(r, 0) != 0) {
+            ERR("Rank at 0: expected 0, got %" PRIu64 "", multiroarRank(r, 0));
+        }
+        if (multiroarRank(r, 10) != 0) {
+            ERR("Rank at 10: expected 0, got %" PRIu64 "",
+                multiroarRank(r, 10));
+        }
+        if (multiroarRank(r, 11) != 1) {
+            ERR("Rank at 11: expected 1, got %" PRIu64 "",
+                multiroarRank(r, 11));
+        }
+        if (multiroarRank(r, 20) != 1) {
+            ERR("Rank at 20: expected 1, got %" PRIu64 "",
+                multiroarRank(r, 20));
+        }
+        if (multiroarRank(r, 21) != 2) {
+            ERR("Rank at 21: expected 2, got %" PRIu64 "",
+                multiroarRank(r, 21));
         }
-        if (multiroarMax(r, &position)) {
-            ERRR("Max should return false for empty bitmap");
+        if (multiroarRank(r, 31) != 3) {
+            ERR("Rank at 31: expected 3, got %" PRIu64 "",
+                multiroarRank(r, 31));
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarIsEmpty - empty and non-empty") {
+    TEST("multiroarRank - dense chunk") {
         multiroar *r = multiroarBitNew();
-
-        if (!multiroarIsEmpty(r)) {
-            ERRR("Newly created bitmap should be empty");
+        /* Set bits 0..999 (1000 bits, triggers dense mode) */
+        for (uint64_t i = 0; i < 1000; i++) {
+            multiroarBitSet(r, i);
         }
 
-        multiroarBitSet(r, 42);
-        if (multiroarIsEmpty(r)) {
-            ERRR("Bitmap with bit set should not be empty");
+        if (multiroarRank(r, 0) != 0) {
+            ERR("Rank at 0: expected 0, got %" PRIu64 "", multiroarRank(r, 0));
         }
-
-        multiroarRemove(r, 42);
-        if (!multiroarIsEmpty(r)) {
-            ERRR("Bitmap after removing all bits should be empty");
+        if (multiroarRank(r, 500) != 500) {
+            ERR("Rank at 500: expected 500, got %" PRIu64 "",
+                multiroarRank(r, 500));
+        }
+        if (multiroarRank(r, 1000) != 1000) {
+            ERR("Rank at 1000: expected 1000, got %" PRIu64 "",
+                multiroarRank(r, 1000));
+        }
+        if (multiroarRank(r, 1001) != 1000) {
+            ERR("Rank at 1001: expected 1000, got %" PRIu64 "",
+                multiroarRank(r, 1001));
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarMin/Max - single bit at various positions") {
-        uint64_t testPositions[] = {0,    1,    100,    8191,
-                                    8192, 8193, 100000, 1000000};
-
-        for (uint64_t i = 0;
-             i < sizeof(testPositions) / sizeof(testPositions[0]); i++) {
-            multiroar *r = multiroarBitNew();
-            uint64_t pos = testPositions[i];
-
-            multiroarBitSet(r, pos);
-
-            uint64_t minPos, maxPos;
-            if (!multiroarMin(r, &minPos) || minPos != pos) {
-                ERR("Min position mismatch: expected %" PRIu64 ", got %" PRIu64
-                    "",
-                    pos, minPos);
-            }
-            if (!multiroarMax(r, &maxPos) || maxPos != pos) {
-                ERR("Max position mismatch: expected %" PRIu64 ", got %" PRIu64
-                    "",
-                    pos, maxPos);
-            }
-
-            multiroarFree(r);
-        }
-    }
-
-    TEST("multiroarMin/Max - sparse chunk (UNDER_FULL)") {
+    TEST("multiroarRank - multi-chunk") {
         multiroar *r = multiroarBitNew();
+        /* Set bits in multiple chunks */
+        multiroarBitSet(r, 100);    /* Chunk 0 */
+        multiroarBitSet(r, 200);    /* Chunk 0 */
+        multiroarBitSet(r, 10000);  /* Chunk 1 */
+        multiroarBitSet(r, 10100);  /* Chunk 1 */
+        multiroarBitSet(r, 100000); /* Chunk 12 */
 
-        /* Set bits at positions that will stay sparse (<631 bits per chunk) */
-        multiroarBitSet(r, 100);
-        multiroarBitSet(r, 500);
-        multiroarBitSet(r, 1000);
-
-        uint64_t minPos, maxPos;
-        if (!multiroarMin(r, &minPos) || minPos != 100) {
-            ERR("Min for sparse chunk: expected 100, got %" PRIu64 "", minPos);
+        if (multiroarRank(r, 100) != 0) {
+            ERR("Rank at 100: expected 0, got %" PRIu64 "",
+                multiroarRank(r, 100));
         }
-        if (!multiroarMax(r, &maxPos) || maxPos != 1000) {
-            ERR("Max for sparse chunk: expected 1000, got %" PRIu64 "", maxPos);
+        if (multiroarRank(r, 201) != 2) {
+            ERR("Rank at 201: expected 2, got %" PRIu64 "",
+                multiroarRank(r, 201));
+        }
+        if (multiroarRank(r, 10000) != 2) {
+            ERR("Rank at 10000: expected 2, got %" PRIu64 "",
+                multiroarRank(r, 10000));
+        }
+        if (multiroarRank(r, 10101) != 4) {
+            ERR("Rank at 10101: expected 4, got %" PRIu64 "",
+                multiroarRank(r, 10101));
+        }
+        if (multiroarRank(r, 100001) != 5) {
+            ERR("Rank at 100001: expected 5, got %" PRIu64 "",
+                multiroarRank(r, 100001));
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarMin/Max - dense chunk (FULL_BITMAP)") {
+    TEST("multiroarSelect - empty bitmap") {
         multiroar *r = multiroarBitNew();
+        uint64_t pos;
 
-        /* Set many bits to trigger dense encoding (631-7561 bits) */
-        for (uint64_t i = 100; i < 1100; i++) {
-            multiroarBitSet(r, i);
-        }
-
-        uint64_t minPos, maxPos;
-        if (!multiroarMin(r, &minPos) || minPos != 100) {
-            ERR("Min for dense chunk: expected 100, got %" PRIu64 "", minPos);
+        if (multiroarSelect(r, 0, &pos)) {
+            ERRR("Select with k=0 should fail");
         }
-        if (!multiroarMax(r, &maxPos) || maxPos != 1099) {
-            ERR("Max for dense chunk: expected 1099, got %" PRIu64 "", maxPos);
+        if (multiroarSelect(r, 1, &pos)) {
+            ERRR("Select on empty bitmap should fail");
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarMin/Max - inverted chunk (OVER_FULL)") {
+    TEST("multiroarSelect - single bit") {
         multiroar *r = multiroarBitNew();
+        multiroarBitSet(r, 100);
 
-        /* Set most bits in a chunk to trigger inverted encoding (>7561 bits) */
-        for (uint64_t i = 10; i < 8190; i++) {
-            multiroarBitSet(r, i);
-        }
-
-        uint64_t minPos, maxPos;
-        if (!multiroarMin(r, &minPos) || minPos != 10) {
-            ERR("Min for inverted chunk: expected 10, got %" PRIu64 "", minPos);
+        uint64_t pos;
+        if (!multiroarSelect(r, 1, &pos) || pos != 100) {
+            ERR("Select 1st bit: expected 100, got %" PRIu64, pos);
         }
-        if (!multiroarMax(r, &maxPos) || maxPos != 8189) {
-            ERR("Max for inverted chunk: expected 8189, got %" PRIu64 "",
-                maxPos);
+        if (multiroarSelect(r, 2, &pos)) {
+            ERRR("Select 2nd bit should fail (only 1 bit set)");
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarMin/Max - full chunk (ALL_1)") {
+    TEST("multiroarSelect - sparse chunk") {
         multiroar *r = multiroarBitNew();
+        /* Set bits at positions 10, 20, 30 */
+        multiroarBitSet(r, 10);
+        multiroarBitSet(r, 20);
+        multiroarBitSet(r, 30);
 
-        /* Set all bits in a chunk */
-        for (uint64_t i = 0; i < 8192; i++) {
-            multiroarBitSet(r, i);
+        uint64_t pos;
+        if (!multiroarSelect(r, 1, &pos) || pos != 10) {
+            ERR("Select 1st: expected 10, got %" PRIu64, pos);
         }
-
-        uint64_t minPos, maxPos;
-        if (!multiroarMin(r, &minPos) || minPos != 0) {
-            ERR("Min for full chunk: expected 0, got %" PRIu64 "", minPos);
+        if (!multiroarSelect(r, 2, &pos) || pos != 20) {
+            ERR("Select 2nd: expected 20, got %" PRIu64, pos);
         }
-        if (!multiroarMax(r, &maxPos) || maxPos != 8191) {
-            ERR("Max for full chunk: expected 8191, got %" PRIu64 "", maxPos);
+        if (!multiroarSelect(r, 3, &pos) || pos != 30) {
+            ERR("Select 3rd: expected 30, got %" PRIu64, pos);
+        }
+        if (multiroarSelect(r, 4, &pos)) {
+            ERRR("Select 4th should fail");
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarMin/Max - multiple chunks") {
+    TEST("multiroarSelect - dense chunk") {
         multiroar *r = multiroarBitNew();
+        /* Set bits 0..999 */
+        for (uint64_t i = 0; i < 1000; i++) {
+            multiroarBitSet(r, i);
+        }
 
-        /* Set bits across multiple chunks */
-        multiroarBitSet(r, 100);     /* Chunk 0 */
-        multiroarBitSet(r, 10000);   /* Chunk 1 */
-        multiroarBitSet(r, 100000);  /* Chunk 12 */
-        multiroarBitSet(r, 1000000); /* Chunk 122 */
-
-        uint64_t minPos, maxPos;
-        if (!multiroarMin(r, &minPos) || minPos != 100) {
-            ERR("Min for multi-chunk: expected 100, got %" PRIu64 "", minPos);
+        uint64_t pos;
+        if (!multiroarSelect(r, 1, &pos) || pos != 0) {
+            ERR("Select 1st: expected 0, got %" PRIu64, pos);
         }
-        if (!multiroarMax(r, &maxPos) || maxPos != 1000000) {
-            ERR("Max for multi-chunk: expected 1000000, got %" PRIu64 "",
-                maxPos);
+        if (!multiroarSelect(r, 500, &pos) || pos != 499) {
+            ERR("Select 500th: expected 499, got %" PRIu64, pos);
+        }
+        if (!multiroarSelect(r, 1000, &pos) || pos != 999) {
+            ERR("Select 1000th: expected 999, got %" PRIu64, pos);
+        }
+        if (multiroarSelect(r, 1001, &pos)) {
+            ERRR("Select 1001st should fail");
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarMin/Max - chunk boundaries") {
+    TEST("multiroarSelect - multi-chunk") {
         multiroar *r = multiroarBitNew();
+        multiroarBitSet(r, 100);    /* 1st bit */
+        multiroarBitSet(r, 200);    /* 2nd bit */
+        multiroarBitSet(r, 10000);  /* 3rd bit (chunk 1) */
+        multiroarBitSet(r, 10100);  /* 4th bit */
+        multiroarBitSet(r, 100000); /* 5th bit (chunk 12) */
 
-        /* Test at chunk boundaries (8192 bits per chunk) */
-        multiroarBitSet(r, 0);     /* First bit of chunk 0 */
-        multiroarBitSet(r, 8191);  /* Last bit of chunk 0 */
-        multiroarBitSet(r, 8192);  /* First bit of chunk 1 */
-        multiroarBitSet(r, 16383); /* Last bit of chunk 1 */
-
-        uint64_t minPos, maxPos;
-        if (!multiroarMin(r, &minPos) || minPos != 0) {
-            ERR("Min at chunk boundary: expected 0, got %" PRIu64 "", minPos);
+        uint64_t pos;
+        if (!multiroarSelect(r, 1, &pos) || pos != 100) {
+            ERR("Select 1st: expected 100, got %" PRIu64, pos);
         }
-        if (!multiroarMax(r, &maxPos) || maxPos != 16383) {
-            ERR("Max at chunk boundary: expected 16383, got %" PRIu64 "",
-                maxPos);
+        if (!multiroarSelect(r, 2, &pos) || pos != 200) {
+            ERR("Select 2nd: expected 200, got %" PRIu64, pos);
+        }
+        if (!multiroarSelect(r, 3, &pos) || pos != 10000) {
+            ERR("Select 3rd: expected 10000, got %" PRIu64, pos);
+        }
+        if (!multiroarSelect(r, 4, &pos) || pos != 10100) {
+            ERR("Select 4th: expected 10100, got %" PRIu64, pos);
+        }
+        if (!multiroarSelect(r, 5, &pos) || pos != 100000) {
+            ERR("Select 5th: expected 100000, got %" PRIu64, pos);
+        }
+        if (multiroarSelect(r, 6, &pos)) {
+            ERRR("Select 6th should fail");
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarIntersects - empty and disjoint") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
-
-        /* Both empty */
-        if (multiroarIntersects(r1, r2)) {
-            ERRR("Empty bitmaps should not intersect");
-        }
+    TEST("multiroarRank/Select - invariant: rank(select(k)) == k") {
+        multiroar *r = multiroarBitNew();
 
-        /* One empty */
-        multiroarBitSet(r1, 100);
-        if (multiroarIntersects(r1, r2)) {
-            ERRR("One empty bitmap should not intersect");
-        }
+        /* Set various bits */
+        multiroarBitSet(r, 5);
+        multiroarBitSet(r, 15);
+        multiroarBitSet(r, 25);
+        multiroarBitSet(r, 100);
+        multiroarBitSet(r, 1000);
+        multiroarBitSet(r, 10000);
 
-        /* Disjoint */
-        multiroarBitSet(r2, 200);
-        if (multiroarIntersects(r1, r2)) {
-            ERRR("Disjoint bitmaps should not intersect");
+        /* Verify rank(select(k)) == k for all k */
+        for (uint64_t k = 1; k <= 6; k++) {
+            uint64_t pos;
+            if (!multiroarSelect(r, k, &pos)) {
+                ERR("Select(%" PRIu64 ") failed", k);
+                continue;
+            }
+            uint64_t rank = multiroarRank(r, pos + 1);
+            if (rank != k) {
+                ERR("Invariant broken: rank(select(%" PRIu64 ")+1) = %" PRIu64
+                    ", expected %" PRIu64 "",
+                    k, rank, k);
+            }
         }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
+        multiroarFree(r);
     }
 
-    TEST("multiroarIntersects - overlapping") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
+    TEST_DESC("rank/select fuzzing - %d random operations", 1000) {
+        for (int trial = 0; trial < 1000; trial++) {
+            multiroar *r = multiroarBitNew();
 
-        /* Same chunk, overlapping bits */
-        multiroarBitSet(r1, 100);
-        multiroarBitSet(r1, 200);
-        multiroarBitSet(r2, 200);
-        multiroarBitSet(r2, 300);
+            /* Create random bitmap */
+            int numBits = 10 + (rand() % 491); /* Max 500 to fit in array */
+            uint64_t positions[500];
 
-        if (!multiroarIntersects(r1, r2)) {
-            ERRR("Overlapping bitmaps should intersect");
-        }
+            for (int i = 0; i < numBits; i++) {
+                positions[i] = ((uint64_t)rand() * rand()) % 50000;
+                multiroarBitSet(r, positions[i]);
+            }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
-    }
+            /* Sort positions for oracle */
+            for (int i = 0; i < numBits; i++) {
+                for (int j = i + 1; j < numBits; j++) {
+                    if (positions[i] > positions[j]) {
+                        uint64_t tmp = positions[i];
+                        positions[i] = positions[j];
+                        positions[j] = tmp;
+                    }
+                }
+            }
 
-    TEST("multiroarIntersects - different chunks") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
+            /* Remove duplicates */
+            int uniqueCount = 0;
+            for (int i = 0; i < numBits; i++) {
+                if (i == 0 || positions[i] != positions[uniqueCount - 1]) {
+                    positions[uniqueCount++] = positions[i];
+                }
+            }
 
-        /* Different chunks, no overlap */
-        multiroarBitSet(r1, 100);
-        multiroarBitSet(r2, 10000);
+            /* Test Rank at random positions */
+            for (int test = 0; test < 10; test++) {
+                uint64_t testPos = ((uint64_t)rand() * rand()) % 60000;
+                uint64_t rank = multiroarRank(r, testPos);
 
-        if (multiroarIntersects(r1, r2)) {
-            ERRR("Bits in different chunks should not intersect");
-        }
+                /* Count bits < testPos manually */
+                uint64_t expectedRank = 0;
+                for (int i = 0; i < uniqueCount; i++) {
+                    if (positions[i] < testPos) {
+                        expectedRank++;
+                    }
+                }
 
-        /* Same bit in different chunk */
-        multiroarBitSet(r1, 10000);
+                if (rank != expectedRank) {
+                    ERR("Rank mismatch at %" PRIu64 ": expected %" PRIu64
+                        ", got %" PRIu64 "",
+                        testPos, expectedRank, rank);
+                }
+            }
 
-        if (!multiroarIntersects(r1, r2)) {
-            ERRR("Same bit in same chunk should intersect");
-        }
+            /* Test Select for all bits */
+            for (int k = 1; k <= uniqueCount; k++) {
+                uint64_t pos;
+                if (!multiroarSelect(r, k, &pos)) {
+                    ERR("Select(%d) failed but should succeed", k);
+                    continue;
+                }
+                if (pos != positions[k - 1]) {
+                    ERR("Select(%d): expected %" PRIu64 ", got %" PRIu64, k,
+                        positions[k - 1], pos);
+                }
+            }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
-    }
+            /* Test Select beyond bounds */
+            uint64_t pos;
+            if (multiroarSelect(r, uniqueCount + 1, &pos)) {
+                ERRR("Select beyond bounds should fail");
+            }
 
-    TEST("multiroarIsSubset - empty sets") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
+            /* Verify rank/select invariant */
+            for (int k = 1; k <= uniqueCount; k++) {
+                uint64_t selectPos;
+                if (multiroarSelect(r, k, &selectPos)) {
+                    uint64_t rankVal = multiroarRank(r, selectPos + 1);
+                    if (rankVal != (uint64_t)k) {
+                        ERR("Invariant broken: rank(select(%d)+1) = %" PRIu64
+                            ", "
+                            "expected %d",
+                            k, rankVal, k);
+                    }
+                }
+            }
 
-        /* Empty set is subset of empty set */
-        if (!multiroarIsSubset(r1, r2)) {
-            ERRR("Empty set should be subset of empty set");
+            multiroarFree(r);
         }
+    }
 
-        /* Empty set is subset of any set */
-        multiroarBitSet(r2, 100);
-        if (!multiroarIsSubset(r1, r2)) {
-            ERRR("Empty set should be subset of non-empty set");
-        }
+    TEST("rank/select - edge case: max uint64_t positions") {
+        multiroar *r = multiroarBitNew();
 
-        /* Non-empty set is not subset of empty set */
-        if (multiroarIsSubset(r2, r1)) {
-            ERRR("Non-empty set should not be subset of empty set");
-        }
+        /* Test near max uint64_t boundaries */
+        uint64_t largePos = UINT64_MAX - 1000;
+        multiroarBitSet(r, largePos);
+        multiroarBitSet(r, largePos + 500);
 
-        multiroarFree(r1);
-        multiroarFree(r2);
-    }
+        /* Test rank at boundaries */
+        uint64_t rank1 = multiroarRank(r, largePos);
+        if (rank1 != 0) {
+            ERR("Rank before first large bit should be 0, got %" PRIu64 "",
+                rank1);
+        }
 
-    TEST("multiroarIsSubset - equal sets") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
+        uint64_t rank2 = multiroarRank(r, largePos + 1);
+        if (rank2 != 1) {
+            ERR("Rank after first large bit should be 1, got %" PRIu64 "",
+                rank2);
+        }
 
-        multiroarBitSet(r1, 100);
-        multiroarBitSet(r1, 200);
-        multiroarBitSet(r2, 100);
-        multiroarBitSet(r2, 200);
+        uint64_t rank3 = multiroarRank(r, UINT64_MAX);
+        if (rank3 != 2) {
+            ERR("Rank at UINT64_MAX should be 2, got %" PRIu64 "", rank3);
+        }
 
-        /* Equal sets are subsets of each other */
-        if (!multiroarIsSubset(r1, r2)) {
-            ERRR("Equal sets should be subsets of each other (r1 ⊆ r2)");
+        /* Test select */
+        uint64_t pos;
+        if (!multiroarSelect(r, 1, &pos) || pos != largePos) {
+            ERR("Select(1) should return %" PRIu64 ", got %" PRIu64, largePos,
+                pos);
         }
-        if (!multiroarIsSubset(r2, r1)) {
-            ERRR("Equal sets should be subsets of each other (r2 ⊆ r1)");
+        if (!multiroarSelect(r, 2, &pos) || pos != largePos + 500) {
+            ERR("Select(2) should return %" PRIu64 ", got %" PRIu64,
+                largePos + 500, pos);
         }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
+        multiroarFree(r);
     }
 
-    TEST("multiroarIsSubset - proper subset") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
+    TEST("rank/select - edge case: sparse bitmaps") {
+        multiroar *r = multiroarBitNew();
 
-        multiroarBitSet(r1, 100);
-        multiroarBitSet(r2, 100);
-        multiroarBitSet(r2, 200);
+        /* Very sparse bitmap with widely separated bits */
+        uint64_t positions[] = {0, 1ULL << 20, 1ULL << 30, 1ULL << 40};
+        for (int i = 0; i < 4; i++) {
+            multiroarBitSet(r, positions[i]);
+        }
 
-        /* r1 ⊂ r2 (proper subset) */
-        if (!multiroarIsSubset(r1, r2)) {
-            ERRR("r1 should be subset of r2");
+        /* Verify rank at each position */
+        for (int i = 0; i < 4; i++) {
+            uint64_t rank = multiroarRank(r, positions[i] + 1);
+            if (rank != (uint64_t)(i + 1)) {
+                ERR("Rank after position %d should be %d, got %" PRIu64 "", i,
+                    i + 1, rank);
+            }
         }
 
-        /* r2 ⊄ r1 (not a subset) */
-        if (multiroarIsSubset(r2, r1)) {
-            ERRR("r2 should not be subset of r1");
+        /* Verify select */
+        for (int i = 0; i < 4; i++) {
+            uint64_t pos;
+            if (!multiroarSelect(r, i + 1, &pos) || pos != positions[i]) {
+                ERR("Select(%d) should return %" PRIu64 ", got %" PRIu64, i + 1,
+                    positions[i], pos);
+            }
         }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
+        multiroarFree(r);
     }
 
-    TEST("multiroarIsSubset - non-subset") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
+    TEST("rank/select - edge case: dense consecutive bits") {
+        multiroar *r = multiroarBitNew();
 
-        multiroarBitSet(r1, 100);
-        multiroarBitSet(r1, 300);
-        multiroarBitSet(r2, 200);
-        multiroarBitSet(r2, 400);
+        /* Set 10000 consecutive bits starting at position 1000000 */
+        uint64_t start = 1000000;
+        uint64_t count = 10000;
+        for (uint64_t i = 0; i < count; i++) {
+            multiroarBitSet(r, start + i);
+        }
 
-        /* Disjoint sets are not subsets */
-        if (multiroarIsSubset(r1, r2)) {
-            ERRR("Disjoint r1 should not be subset of r2");
+        /* Test rank */
+        if (multiroarRank(r, start) != 0) {
+            ERR("Rank before dense region should be 0, got %" PRIu64 "",
+                multiroarRank(r, start));
         }
-        if (multiroarIsSubset(r2, r1)) {
-            ERRR("Disjoint r2 should not be subset of r1");
+        if (multiroarRank(r, start + count) != count) {
+            ERR("Rank after dense region should be %" PRIu64 ", got %" PRIu64
+                "",
+                count, multiroarRank(r, start + count));
+        }
+
+        /* Test select at boundaries */
+        uint64_t pos;
+        if (!multiroarSelect(r, 1, &pos) || pos != start) {
+            ERR("Select(1) should return %" PRIu64 ", got %" PRIu64, start,
+                pos);
+        }
+        if (!multiroarSelect(r, count, &pos) || pos != start + count - 1) {
+            ERR("Select(%" PRIu64 ") should return %" PRIu64 ", got %" PRIu64,
+                count, start + count - 1, pos);
+        }
+        if (multiroarSelect(r, count + 1, &pos)) {
+            ERRR("Select beyond count should fail");
         }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
+        multiroarFree(r);
     }
 
-    TEST("multiroarEquals - empty bitmaps") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
+    TEST("rank/select - edge case: alternating bits") {
+        multiroar *r = multiroarBitNew();
 
-        if (!multiroarEquals(r1, r2)) {
-            ERRR("Empty bitmaps should be equal");
+        /* Set alternating bits in a range */
+        uint64_t start = 50000;
+        uint64_t range = 10000;
+        for (uint64_t i = 0; i < range; i += 2) {
+            multiroarBitSet(r, start + i);
         }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
-    }
-
-    TEST("multiroarEquals - identical bitmaps") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
-
-        multiroarBitSet(r1, 100);
-        multiroarBitSet(r1, 200);
-        multiroarBitSet(r1, 10000);
-
-        multiroarBitSet(r2, 100);
-        multiroarBitSet(r2, 200);
-        multiroarBitSet(r2, 10000);
-
-        if (!multiroarEquals(r1, r2)) {
-            ERRR("Identical bitmaps should be equal");
+        /* Test rank at various positions */
+        uint64_t expectedCount = range / 2;
+        if (multiroarRank(r, start + range) != expectedCount) {
+            ERR("Rank should be %" PRIu64 ", got %" PRIu64 "", expectedCount,
+                multiroarRank(r, start + range));
         }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
-    }
-
-    TEST("multiroarEquals - different sizes") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
-
-        multiroarBitSet(r1, 100);
-        multiroarBitSet(r2, 100);
-        multiroarBitSet(r2, 200);
-
-        if (multiroarEquals(r1, r2)) {
-            ERRR("Bitmaps with different sizes should not be equal");
+        /* Test select for every 100th bit */
+        for (uint64_t k = 1; k <= expectedCount; k += 100) {
+            uint64_t pos;
+            uint64_t expected = start + (k - 1) * 2;
+            if (!multiroarSelect(r, k, &pos) || pos != expected) {
+                ERR("Select(%" PRIu64 ") should return %" PRIu64
+                    ", got %" PRIu64,
+                    k, expected, pos);
+            }
         }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
+        multiroarFree(r);
     }
 
-    TEST("multiroarEquals - different positions") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
+    TEST("rank/select - edge case: single bit") {
+        multiroar *r = multiroarBitNew();
 
-        multiroarBitSet(r1, 100);
-        multiroarBitSet(r2, 200);
+        multiroarBitSet(r, 42);
 
-        if (multiroarEquals(r1, r2)) {
-            ERRR("Bitmaps with different positions should not be equal");
+        /* Test rank */
+        if (multiroarRank(r, 0) != 0) {
+            ERRR("Rank(0) should be 0");
+        }
+        if (multiroarRank(r, 42) != 0) {
+            ERRR("Rank(42) should be 0");
+        }
+        if (multiroarRank(r, 43) != 1) {
+            ERRR("Rank(43) should be 1");
+        }
+        if (multiroarRank(r, 1000) != 1) {
+            ERRR("Rank(1000) should be 1");
         }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
-    }
-
-    TEST("multiroarEquals - different chunks") {
-        multiroar *r1 = multiroarBitNew();
-        multiroar *r2 = multiroarBitNew();
-
-        multiroarBitSet(r1, 100);
-        multiroarBitSet(r2, 10000);
-
-        if (multiroarEquals(r1, r2)) {
-            ERRR("Bitmaps with bits in different chunks should not be equal");
+        /* Test select */
+        uint64_t pos;
+        if (!multiroarSelect(r, 1, &pos) || pos != 42) {
+            ERR("Select(1) should return 42, got %" PRIu64, pos);
+        }
+        if (multiroarSelect(r, 2, &pos)) {
+            ERRR("Select(2) should fail");
+        }
+        if (multiroarSelect(r, 0, &pos)) {
+            ERRR("Select(0) should fail");
         }
 
-        multiroarFree(r1);
-        multiroarFree(r2);
+        multiroarFree(r);
     }
 
-    TEST_DESC("min/max/comparison fuzzing - %d random operations", 1000) {
-        for (int trial = 0; trial < 1000; trial++) {
-            multiroar *r1 = multiroarBitNew();
-            multiroar *r2 = multiroarBitNew();
-
-            /* Create random bitmaps */
-            int numBits1 = rand() % 500;
-            int numBits2 = rand() % 500;
-
-            uint64_t min1 = UINT64_MAX, max1 = 0;
-            uint64_t min2 = UINT64_MAX, max2 = 0;
+    TEST("rank/select - edge case: duplicate positions in fuzzing") {
+        multiroar *r = multiroarBitNew();
 
-            for (int i = 0; i < numBits1; i++) {
-                uint64_t pos = ((uint64_t)rand() * rand()) % 100000;
-                multiroarBitSet(r1, pos);
-                if (pos < min1) {
-                    min1 = pos;
-                }
-                if (pos > max1) {
-                    max1 = pos;
-                }
-            }
+        /* Set same position multiple times */
+        for (int i = 0; i < 100; i++) {
+            multiroarBitSet(r, 1000);
+        }
 
-            for (int i = 0; i < numBits2; i++) {
-                uint64_t pos = ((uint64_t)rand() * rand()) % 100000;
-                multiroarBitSet(r2, pos);
-                if (pos < min2) {
-                    min2 = pos;
-                }
-                if (pos > max2) {
-                    max2 = pos;
-                }
-            }
+        /* Should only count once */
+        if (multiroarBitCount(r) != 1) {
+            ERR("Count should be 1, got %" PRIu64 "", multiroarBitCount(r));
+        }
+        if (multiroarRank(r, 1001) != 1) {
+            ERR("Rank(1001) should be 1, got %" PRIu64 "",
+                multiroarRank(r, 1001));
+        }
 
-            /* Verify Min/Max */
-            if (numBits1 > 0) {
-                uint64_t actualMin, actualMax;
-                if (!multiroarMin(r1, &actualMin)) {
-                    ERRR("Min should succeed for non-empty bitmap");
-                }
-                if (!multiroarMax(r1, &actualMax)) {
-                    ERRR("Max should succeed for non-empty bitmap");
-                }
+        uint64_t pos;
+        if (!multiroarSelect(r, 1, &pos) || pos != 1000) {
+            ERR("Select(1) should return 1000, got %" PRIu64, pos);
+        }
 
-                /* Verify min/max are actually set */
-                if (!multiroarBitGet(r1, actualMin)) {
-                    ERR("Min position %" PRIu64 " should be set", actualMin);
-                }
-                if (!multiroarBitGet(r1, actualMax)) {
-                    ERR("Max position %" PRIu64 " should be set", actualMax);
-                }
-            } else {
-                uint64_t pos;
-                if (multiroarMin(r1, &pos)) {
-                    ERRR("Min should fail for empty bitmap");
-                }
-                if (multiroarMax(r1, &pos)) {
-                    ERRR("Max should fail for empty bitmap");
-                }
-            }
+        multiroarFree(r);
+    }
 
-            /* Verify IsEmpty */
-            bool shouldBeEmpty1 = (numBits1 == 0);
-            if (multiroarIsEmpty(r1) != shouldBeEmpty1) {
-                ERR("IsEmpty mismatch: expected %d", shouldBeEmpty1);
-            }
+    printf("\n=== Rank/Select tests completed! ===\n\n");
 
-            /* Verify Intersects */
-            bool hasIntersection = false;
-            for (uint64_t pos = 0; pos < 100000; pos++) {
-                if (multiroarBitGet(r1, pos) && multiroarBitGet(r2, pos)) {
-                    hasIntersection = true;
-                    break;
-                }
-            }
-            if (multiroarIntersects(r1, r2) != hasIntersection) {
-                ERR("Intersects mismatch: expected %d", hasIntersection);
-            }
+    /* ====================================================================
+     * Range Operations Tests
+     * ==================================================================== */
 
-            /* Verify Equals */
-            bool shouldBeEqual = true;
-            if (multiroarBitCount(r1) != multiroarBitCount(r2)) {
-                shouldBeEqual = false;
-            } else {
-                for (uint64_t pos = 0; pos < 100000; pos++) {
-                    if (multiroarBitGet(r1, pos) != multiroarBitGet(r2, pos)) {
-                        shouldBeEqual = false;
-                        break;
-                    }
-                }
-            }
-            if (multiroarEquals(r1, r2) != shouldBeEqual) {
-                ERR("Equals mismatch: expected %d", shouldBeEqual);
-            }
+    TEST("multiroarRangeCount - empty bitmap") {
+        multiroar *r = multiroarBitNew();
 
-            multiroarFree(r1);
-            multiroarFree(r2);
+        if (multiroarRangeCount(r, 0, 100) != 0) {
+            ERRR("RangeCount on empty bitmap should be 0");
         }
-    }
-
-    printf("\n=== Min/Max/Comparison tests completed! ===\n\n");
 
-    /* ====================================================================
-     * Rank/Select Operations Tests
-     * ==================================================================== */
+        multiroarFree(r);
+    }
 
-    TEST("multiroarRank - empty bitmap") {
+    TEST("multiroarRangeCount - basic range") {
         multiroar *r = multiroarBitNew();
+        /* Set bits 10, 20, 30, 40, 50 */
+        for (uint64_t i = 10; i <= 50; i += 10) {
+            multiroarBitSet(r, i);
+        }
 
-        if (multiroarRank(r, 0) != 0) {
-            ERRR("Rank at 0 for empty bitmap should be 0");
+        if (multiroarRangeCount(r, 0, 25) != 2) {
+            ERR("RangeCount [0,25): expected 2, got %" PRIu64 "",
+                multiroarRangeCount(r, 0, 25));
         }
-        if (multiroarRank(r, 100) != 0) {
-            ERRR("Rank at 100 for empty bitmap should be 0");
+        if (multiroarRangeCount(r, 15, 45) != 3) {
+            ERR("RangeCount [15,45): expected 3, got %" PRIu64 "",
+                multiroarRangeCount(r, 15, 45));
+        }
+        if (multiroarRangeCount(r, 10, 51) != 5) {
+            ERR("RangeCount [10,51): expected 5, got %" PRIu64 "",
+                multiroarRangeCount(r, 10, 51));
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarRank - single bit") {
+    TEST("multiroarBitClearRange - basic clear") {
         multiroar *r = multiroarBitNew();
-        multiroarBitSet(r, 100);
-
-        if (multiroarRank(r, 0) != 0) {
-            ERRR("Rank before bit should be 0");
-        }
-        if (multiroarRank(r, 100) != 0) {
-            ERRR("Rank at bit position should be 0 (excludes position)");
+        /* Set bits 0..99 */
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(r, i);
         }
-        if (multiroarRank(r, 101) != 1) {
-            ERRR("Rank after bit should be 1");
+
+        /* Clear 20..29 (10 bits) */
+        multiroarBitClearRange(r, 20, 10);
+
+        if (multiroarBitCount(r) != 90) {
+            ERR("After clearing 10 bits: expected 90, got %" PRIu64 "",
+                multiroarBitCount(r));
         }
-        if (multiroarRank(r, 1000) != 1) {
-            ERRR("Rank far after bit should be 1");
+
+        for (uint64_t i = 20; i < 30; i++) {
+            if (multiroarBitGet(r, i)) {
+                ERR("Bit %" PRIu64 " should be cleared", i);
+            }
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarRank - sparse chunk") {
+    TEST("multiroarBitClearRange - multi-chunk") {
         multiroar *r = multiroarBitNew();
-        /* Set bits at positions 10, 20, 30 */
-        multiroarBitSet(r, 10);
-        multiroarBitSet(r, 20);
-        multiroarBitSet(r, 30);
-
-        if (multiroarRank(r, 0) != 0) {
-            ERR("Rank at 0: expected 0, got %" PRIu64 "", multiroarRank(r, 0));
-        }
-        if (multiroarRank(r, 10) != 0) {
-            ERR("Rank at 10: expected 0, got %" PRIu64 "",
-                multiroarRank(r, 10));
-        }
-        if (multiroarRank(r, 11) != 1) {
-            ERR("Rank at 11: expected 1, got %" PRIu64 "",
-                multiroarRank(r, 11));
-        }
-        if (multiroarRank(r, 20) != 1) {
-            ERR("Rank at 20: expected 1, got %" PRIu64 "",
-                multiroarRank(r, 20));
-        }
-        if (multiroarRank(r, 21) != 2) {
-            ERR("Rank at 21: expected 2, got %" PRIu64 "",
-                multiroarRank(r, 21));
+        /* Set bits across chunks */
+        for (uint64_t i = 8000; i < 10000; i++) {
+            multiroarBitSet(r, i);
         }
-        if (multiroarRank(r, 31) != 3) {
-            ERR("Rank at 31: expected 3, got %" PRIu64 "",
-                multiroarRank(r, 31));
+
+        uint64_t beforeCount = multiroarBitCount(r);
+
+        /* Count how many bits are actually set in the range we're about to
+         * clear */
+        uint64_t bitsInRange = multiroarRangeCount(r, 8100, 9000);
+
+        multiroarBitClearRange(r, 8100, 900); /* Clear across chunk boundary */
+        uint64_t afterCount = multiroarBitCount(r);
+
+        if (afterCount != beforeCount - bitsInRange) {
+            ERR("Clear range: expected %" PRIu64 ", got %" PRIu64
+                " (range had %" PRIu64 " bits)",
+                beforeCount - bitsInRange, afterCount, bitsInRange);
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarRank - dense chunk") {
+    TEST("multiroarBitFlipRange - basic flip") {
         multiroar *r = multiroarBitNew();
-        /* Set bits 0..999 (1000 bits, triggers dense mode) */
-        for (uint64_t i = 0; i < 1000; i++) {
+        /* Set alternating bits 0, 2, 4, 6, 8 */
+        for (uint64_t i = 0; i < 10; i += 2) {
             multiroarBitSet(r, i);
         }
 
-        if (multiroarRank(r, 0) != 0) {
-            ERR("Rank at 0: expected 0, got %" PRIu64 "", multiroarRank(r, 0));
-        }
-        if (multiroarRank(r, 500) != 500) {
-            ERR("Rank at 500: expected 500, got %" PRIu64 "",
-                multiroarRank(r, 500));
-        }
-        if (multiroarRank(r, 1000) != 1000) {
-            ERR("Rank at 1000: expected 1000, got %" PRIu64 "",
-                multiroarRank(r, 1000));
-        }
-        if (multiroarRank(r, 1001) != 1000) {
-            ERR("Rank at 1001: expected 1000, got %" PRIu64 "",
-                multiroarRank(r, 1001));
+        /* Flip range 0..9 (should flip all bits in range) */
+        multiroarBitFlipRange(r, 0, 10);
+
+        /* Now bits 1, 3, 5, 7, 9 should be set */
+        for (uint64_t i = 0; i < 10; i++) {
+            bool shouldBeSet = (i % 2 == 1);
+            if (multiroarBitGet(r, i) != shouldBeSet) {
+                ERR("After flip: bit %" PRIu64 " should be %d", i, shouldBeSet);
+            }
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarRank - multi-chunk") {
+    TEST("multiroarBitFlipRange - double flip") {
         multiroar *r = multiroarBitNew();
-        /* Set bits in multiple chunks */
-        multiroarBitSet(r, 100);    /* Chunk 0 */
-        multiroarBitSet(r, 200);    /* Chunk 0 */
-        multiroarBitSet(r, 10000);  /* Chunk 1 */
-        multiroarBitSet(r, 10100);  /* Chunk 1 */
-        multiroarBitSet(r, 100000); /* Chunk 12 */
+        multiroarBitSet(r, 50);
 
-        if (multiroarRank(r, 100) != 0) {
-            ERR("Rank at 100: expected 0, got %" PRIu64 "",
-                multiroarRank(r, 100));
-        }
-        if (multiroarRank(r, 201) != 2) {
-            ERR("Rank at 201: expected 2, got %" PRIu64 "",
-                multiroarRank(r, 201));
-        }
-        if (multiroarRank(r, 10000) != 2) {
-            ERR("Rank at 10000: expected 2, got %" PRIu64 "",
-                multiroarRank(r, 10000));
-        }
-        if (multiroarRank(r, 10101) != 4) {
-            ERR("Rank at 10101: expected 4, got %" PRIu64 "",
-                multiroarRank(r, 10101));
-        }
-        if (multiroarRank(r, 100001) != 5) {
-            ERR("Rank at 100001: expected 5, got %" PRIu64 "",
-                multiroarRank(r, 100001));
+        /* Flip twice should restore */
+        multiroarBitFlipRange(r, 40, 20);
+        multiroarBitFlipRange(r, 40, 20);
+
+        if (!multiroarBitGet(r, 50)) {
+            ERRR("Double flip should restore original state");
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarSelect - empty bitmap") {
-        multiroar *r = multiroarBitNew();
-        uint64_t pos;
+    TEST("multiroarAndNot - basic difference") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        if (multiroarSelect(r, 0, &pos)) {
-            ERRR("Select with k=0 should fail");
-        }
-        if (multiroarSelect(r, 1, &pos)) {
-            ERRR("Select on empty bitmap should fail");
+        /* A = {10, 20, 30, 40, 50} */
+        for (uint64_t i = 10; i <= 50; i += 10) {
+            multiroarBitSet(a, i);
         }
 
-        multiroarFree(r);
-    }
+        /* B = {20, 40} */
+        multiroarBitSet(b, 20);
+        multiroarBitSet(b, 40);
 
-    TEST("multiroarSelect - single bit") {
-        multiroar *r = multiroarBitNew();
-        multiroarBitSet(r, 100);
+        /* A - B = {10, 30, 50} */
+        multiroarAndNot(a, b);
 
-        uint64_t pos;
-        if (!multiroarSelect(r, 1, &pos) || pos != 100) {
-            ERR("Select 1st bit: expected 100, got %" PRIu64, pos);
+        if (multiroarBitCount(a) != 3) {
+            ERR("A - B count: expected 3, got %" PRIu64 "",
+                multiroarBitCount(a));
         }
-        if (multiroarSelect(r, 2, &pos)) {
-            ERRR("Select 2nd bit should fail (only 1 bit set)");
+        if (!multiroarBitGet(a, 10) || !multiroarBitGet(a, 30) ||
+            !multiroarBitGet(a, 50)) {
+            ERRR("A - B should contain {10, 30, 50}");
+        }
+        if (multiroarBitGet(a, 20) || multiroarBitGet(a, 40)) {
+            ERRR("A - B should not contain {20, 40}");
         }
 
-        multiroarFree(r);
+        multiroarFree(a);
+        multiroarFree(b);
     }
 
-    TEST("multiroarSelect - sparse chunk") {
-        multiroar *r = multiroarBitNew();
-        /* Set bits at positions 10, 20, 30 */
-        multiroarBitSet(r, 10);
-        multiroarBitSet(r, 20);
-        multiroarBitSet(r, 30);
+    TEST("multiroarNewAndNot - creates new result") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        uint64_t pos;
-        if (!multiroarSelect(r, 1, &pos) || pos != 10) {
-            ERR("Select 1st: expected 10, got %" PRIu64, pos);
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(a, i);
         }
-        if (!multiroarSelect(r, 2, &pos) || pos != 20) {
-            ERR("Select 2nd: expected 20, got %" PRIu64, pos);
+        for (uint64_t i = 50; i < 150; i++) {
+            multiroarBitSet(b, i);
         }
-        if (!multiroarSelect(r, 3, &pos) || pos != 30) {
-            ERR("Select 3rd: expected 30, got %" PRIu64, pos);
+
+        /* A - B = [0, 50) */
+        multiroar *result = multiroarNewAndNot(a, b);
+
+        if (multiroarBitCount(result) != 50) {
+            ERR("NewAndNot count: expected 50, got %" PRIu64 "",
+                multiroarBitCount(result));
         }
-        if (multiroarSelect(r, 4, &pos)) {
-            ERRR("Select 4th should fail");
+
+        /* Verify a is unchanged */
+        if (multiroarBitCount(a) != 100) {
+            ERRR("Original A should be unchanged");
         }
 
-        multiroarFree(r);
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
     }
 
-    TEST("multiroarSelect - dense chunk") {
-        multiroar *r = multiroarBitNew();
-        /* Set bits 0..999 */
-        for (uint64_t i = 0; i < 1000; i++) {
-            multiroarBitSet(r, i);
-        }
+    TEST("multiroarAndNot - disjoint sets") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        uint64_t pos;
-        if (!multiroarSelect(r, 1, &pos) || pos != 0) {
-            ERR("Select 1st: expected 0, got %" PRIu64, pos);
+        for (uint64_t i = 0; i < 50; i++) {
+            multiroarBitSet(a, i);
         }
-        if (!multiroarSelect(r, 500, &pos) || pos != 499) {
-            ERR("Select 500th: expected 499, got %" PRIu64, pos);
+        for (uint64_t i = 100; i < 150; i++) {
+            multiroarBitSet(b, i);
         }
-        if (!multiroarSelect(r, 1000, &pos) || pos != 999) {
-            ERR("Select 1000th: expected 999, got %" PRIu64, pos);
+
+        uint64_t beforeCount = multiroarBitCount(a);
+        multiroarAndNot(a, b);
+
+        if (multiroarBitCount(a) != beforeCount) {
+            ERRR("Disjoint A - B should equal A");
         }
-        if (multiroarSelect(r, 1001, &pos)) {
-            ERRR("Select 1001st should fail");
+
+        multiroarFree(a);
+        multiroarFree(b);
+    }
+
+    TEST("multiroarAndNot - complete overlap") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
+
+        for (uint64_t i = 0; i < 50; i++) {
+            multiroarBitSet(a, i);
+            multiroarBitSet(b, i);
+        }
+
+        multiroarAndNot(a, b);
+
+        if (multiroarBitCount(a) != 0) {
+            ERRR("Complete overlap: A - A should be empty");
         }
 
-        multiroarFree(r);
+        multiroarFree(a);
+        multiroarFree(b);
     }
 
-    TEST("multiroarSelect - multi-chunk") {
+    TEST("multiroarBitFlipRange - minimal debug test") {
+        /* Minimal test to debug the assertion failure */
         multiroar *r = multiroarBitNew();
-        multiroarBitSet(r, 100);    /* 1st bit */
-        multiroarBitSet(r, 200);    /* 2nd bit */
-        multiroarBitSet(r, 10000);  /* 3rd bit (chunk 1) */
-        multiroarBitSet(r, 10100);  /* 4th bit */
-        multiroarBitSet(r, 100000); /* 5th bit (chunk 12) */
 
-        uint64_t pos;
-        if (!multiroarSelect(r, 1, &pos) || pos != 100) {
-            ERR("Select 1st: expected 100, got %" PRIu64, pos);
-        }
-        if (!multiroarSelect(r, 2, &pos) || pos != 200) {
-            ERR("Select 2nd: expected 200, got %" PRIu64, pos);
-        }
-        if (!multiroarSelect(r, 3, &pos) || pos != 10000) {
-            ERR("Select 3rd: expected 10000, got %" PRIu64, pos);
-        }
-        if (!multiroarSelect(r, 4, &pos) || pos != 10100) {
-            ERR("Select 4th: expected 10100, got %" PRIu64, pos);
-        }
-        if (!multiroarSelect(r, 5, &pos) || pos != 100000) {
-            ERR("Select 5th: expected 100000, got %" PRIu64, pos);
-        }
-        if (multiroarSelect(r, 6, &pos)) {
-            ERRR("Select 6th should fail");
+        /* Set some bits */
+        for (uint64_t i = 0; i < 20; i++) {
+            multiroarBitSet(r, i * 5); /* 0, 5, 10, 15, ... 95 */
         }
 
-        multiroarFree(r);
-    }
+        uint64_t countBefore = multiroarBitCount(r);
 
-    TEST("multiroarRank/Select - invariant: rank(select(k)) == k") {
-        multiroar *r = multiroarBitNew();
+        /* Flip a range */
+        multiroarBitFlipRange(r, 10, 30); /* Flip [10, 40) */
 
-        /* Set various bits */
-        multiroarBitSet(r, 5);
-        multiroarBitSet(r, 15);
-        multiroarBitSet(r, 25);
-        multiroarBitSet(r, 100);
-        multiroarBitSet(r, 1000);
-        multiroarBitSet(r, 10000);
+        /* Flip the same range again - should restore */
+        multiroarBitFlipRange(r, 10, 30); /* Flip [10, 40) again */
 
-        /* Verify rank(select(k)) == k for all k */
-        for (uint64_t k = 1; k <= 6; k++) {
-            uint64_t pos;
-            if (!multiroarSelect(r, k, &pos)) {
-                ERR("Select(%" PRIu64 ") failed", k);
-                continue;
-            }
-            uint64_t rank = multiroarRank(r, pos + 1);
-            if (rank != k) {
-                ERR("Invariant broken: rank(select(%" PRIu64 ")+1) = %" PRIu64
-                    ", expected %" PRIu64 "",
-                    k, rank, k);
-            }
+        uint64_t countAfter = multiroarBitCount(r);
+
+        if (countBefore != countAfter) {
+            ERR("Minimal flip test: expected count %" PRIu64 ", got %" PRIu64
+                "",
+                countBefore, countAfter);
         }
 
         multiroarFree(r);
     }
 
-    TEST_DESC("rank/select fuzzing - %d random operations", 1000) {
-        for (int trial = 0; trial < 1000; trial++) {
+    TEST_DESC("range operations fuzzing - %d random operations", 500) {
+        for (int trial = 0; trial < 500; trial++) {
             multiroar *r = multiroarBitNew();
 
-            /* Create random bitmap */
-            int numBits = 10 + (rand() % 491); /* Max 500 to fit in array */
-            uint64_t positions[500];
-
+            /* Set random bits */
+            int numBits = 50 + (rand() % 200);
             for (int i = 0; i < numBits; i++) {
-                positions[i] = ((uint64_t)rand() * rand()) % 50000;
-                multiroarBitSet(r, positions[i]);
+                uint64_t pos = ((uint64_t)rand() * rand()) % 10000;
+                multiroarBitSet(r, pos);
             }
 
-            /* Sort positions for oracle */
-            for (int i = 0; i < numBits; i++) {
-                for (int j = i + 1; j < numBits; j++) {
-                    if (positions[i] > positions[j]) {
-                        uint64_t tmp = positions[i];
-                        positions[i] = positions[j];
-                        positions[j] = tmp;
-                    }
+            uint64_t initialCount = multiroarBitCount(r);
+
+            /* Test RangeCount */
+            uint64_t rangeStart = ((uint64_t)rand() * rand()) % 8000;
+            uint64_t rangeEnd = rangeStart + (rand() % 2000);
+
+            uint64_t rangeCount = multiroarRangeCount(r, rangeStart, rangeEnd);
+            uint64_t manualCount = 0;
+            for (uint64_t pos = rangeStart; pos < rangeEnd; pos++) {
+                if (multiroarBitGet(r, pos)) {
+                    manualCount++;
                 }
             }
 
-            /* Remove duplicates */
-            int uniqueCount = 0;
-            for (int i = 0; i < numBits; i++) {
-                if (i == 0 || positions[i] != positions[uniqueCount - 1]) {
-                    positions[uniqueCount++] = positions[i];
-                }
+            if (rangeCount != manualCount) {
+                ERR("RangeCount mismatch: expected %" PRIu64 ", got %" PRIu64
+                    "",
+                    manualCount, rangeCount);
             }
 
-            /* Test Rank at random positions */
-            for (int test = 0; test < 10; test++) {
-                uint64_t testPos = ((uint64_t)rand() * rand()) % 60000;
-                uint64_t rank = multiroarRank(r, testPos);
+            /* Test ClearRange */
+            multiroar *r2 = multiroarDuplicate(r);
+            uint64_t clearStart = rand() % 1000;
+            uint64_t clearExtent = rand() % 500;
 
-                /* Count bits < testPos manually */
-                uint64_t expectedRank = 0;
-                for (int i = 0; i < uniqueCount; i++) {
-                    if (positions[i] < testPos) {
-                        expectedRank++;
-                    }
-                }
+            uint64_t bitsInRange =
+                multiroarRangeCount(r2, clearStart, clearStart + clearExtent);
+            multiroarBitClearRange(r2, clearStart, clearExtent);
+            uint64_t afterClear = multiroarBitCount(r2);
 
-                if (rank != expectedRank) {
-                    ERR("Rank mismatch at %" PRIu64 ": expected %" PRIu64
-                        ", got %" PRIu64 "",
-                        testPos, expectedRank, rank);
-                }
+            if (afterClear != initialCount - bitsInRange) {
+                ERR("ClearRange: expected %" PRIu64 ", got %" PRIu64 "",
+                    initialCount - bitsInRange, afterClear);
             }
 
-            /* Test Select for all bits */
-            for (int k = 1; k <= uniqueCount; k++) {
-                uint64_t pos;
-                if (!multiroarSelect(r, k, &pos)) {
-                    ERR("Select(%d) failed but should succeed", k);
-                    continue;
-                }
-                if (pos != positions[k - 1]) {
-                    ERR("Select(%d): expected %" PRIu64 ", got %" PRIu64, k,
-                        positions[k - 1], pos);
-                }
-            }
+            multiroarFree(r2);
 
-            /* Test Select beyond bounds */
-            uint64_t pos;
-            if (multiroarSelect(r, uniqueCount + 1, &pos)) {
-                ERRR("Select beyond bounds should fail");
-            }
+            /* Test FlipRange */
+            multiroar *r3 = multiroarDuplicate(r);
+            uint64_t flipStart = rand() % 1000;
+            uint64_t flipExtent = rand() % 500;
 
-            /* Verify rank/select invariant */
-            for (int k = 1; k <= uniqueCount; k++) {
-                uint64_t selectPos;
-                if (multiroarSelect(r, k, &selectPos)) {
-                    uint64_t rankVal = multiroarRank(r, selectPos + 1);
-                    if (rankVal != (uint64_t)k) {
-                        ERR("Invariant broken: rank(select(%d)+1) = %" PRIu64
-                            ", "
-                            "expected %d",
-                            k, rankVal, k);
-                    }
-                }
+            multiroarBitFlipRange(r3, flipStart, flipExtent);
+            multiroarBitFlipRange(r3, flipStart, flipExtent); /* Flip twice */
+
+            /* Should equal original */
+            if (!multiroarEquals(r, r3)) {
+                ERRR("Double flip should restore original");
             }
 
+            multiroarFree(r3);
             multiroarFree(r);
         }
     }
 
-    TEST("rank/select - edge case: max uint64_t positions") {
-        multiroar *r = multiroarBitNew();
+    printf("\n=== Range operations tests completed! ===\n\n");
 
-        /* Test near max uint64_t boundaries */
-        uint64_t largePos = UINT64_MAX - 1000;
-        multiroarBitSet(r, largePos);
-        multiroarBitSet(r, largePos + 500);
+    /* ================================================================
+     * Iterator Tests
+     * ================================================================ */
 
-        /* Test rank at boundaries */
-        uint64_t rank1 = multiroarRank(r, largePos);
-        if (rank1 != 0) {
-            ERR("Rank before first large bit should be 0, got %" PRIu64 "",
-                rank1);
-        }
+    TEST("multiroarIterator - empty bitmap") {
+        multiroar *r = multiroarBitNew();
+        multiroarIterator iter;
+        multiroarIteratorInit(r, &iter);
 
-        uint64_t rank2 = multiroarRank(r, largePos + 1);
-        if (rank2 != 1) {
-            ERR("Rank after first large bit should be 1, got %" PRIu64 "",
-                rank2);
+        uint64_t pos;
+        if (multiroarIteratorNext(&iter, &pos)) {
+            ERRR("Empty bitmap should have no positions");
         }
 
-        uint64_t rank3 = multiroarRank(r, UINT64_MAX);
-        if (rank3 != 2) {
-            ERR("Rank at UINT64_MAX should be 2, got %" PRIu64 "", rank3);
-        }
+        multiroarFree(r);
+    }
+
+    TEST("multiroarIterator - single bit") {
+        multiroar *r = multiroarBitNew();
+        multiroarBitSet(r, 42);
+
+        multiroarIterator iter;
+        multiroarIteratorInit(r, &iter);
 
-        /* Test select */
         uint64_t pos;
-        if (!multiroarSelect(r, 1, &pos) || pos != largePos) {
-            ERR("Select(1) should return %" PRIu64 ", got %" PRIu64, largePos,
-                pos);
+        if (!multiroarIteratorNext(&iter, &pos) || pos != 42) {
+            ERR("Expected position 42, got %" PRIu64, pos);
         }
-        if (!multiroarSelect(r, 2, &pos) || pos != largePos + 500) {
-            ERR("Select(2) should return %" PRIu64 ", got %" PRIu64,
-                largePos + 500, pos);
+
+        if (multiroarIteratorNext(&iter, &pos)) {
+            ERRR("Should only have one position");
         }
 
         multiroarFree(r);
     }
 
-    TEST("rank/select - edge case: sparse bitmaps") {
+    TEST("multiroarIterator - sparse chunk") {
         multiroar *r = multiroarBitNew();
-
-        /* Very sparse bitmap with widely separated bits */
-        uint64_t positions[] = {0, 1ULL << 20, 1ULL << 30, 1ULL << 40};
-        for (int i = 0; i < 4; i++) {
-            multiroarBitSet(r, positions[i]);
+        /* Set bits 10, 20, 30, 40, 50 */
+        for (uint64_t i = 10; i <= 50; i += 10) {
+            multiroarBitSet(r, i);
         }
 
-        /* Verify rank at each position */
-        for (int i = 0; i < 4; i++) {
-            uint64_t rank = multiroarRank(r, positions[i] + 1);
-            if (rank != (uint64_t)(i + 1)) {
-                ERR("Rank after position %d should be %d, got %" PRIu64 "", i,
-                    i + 1, rank);
+        multiroarIterator iter;
+        multiroarIteratorInit(r, &iter);
+
+        const uint64_t expected[] = {10, 20, 30, 40, 50};
+        for (int i = 0; i < 5; i++) {
+            uint64_t pos;
+            if (!multiroarIteratorNext(&iter, &pos) || pos != expected[i]) {
+                ERR("Expected %" PRIu64 ", got %" PRIu64, expected[i], pos);
             }
         }
 
-        /* Verify select */
-        for (int i = 0; i < 4; i++) {
-            uint64_t pos;
-            if (!multiroarSelect(r, i + 1, &pos) || pos != positions[i]) {
-                ERR("Select(%d) should return %" PRIu64 ", got %" PRIu64, i + 1,
-                    positions[i], pos);
-            }
+        uint64_t pos;
+        if (multiroarIteratorNext(&iter, &pos)) {
+            ERRR("Should have exactly 5 positions");
         }
 
         multiroarFree(r);
     }
 
-    TEST("rank/select - edge case: dense consecutive bits") {
+    TEST("multiroarIterator - dense chunk") {
         multiroar *r = multiroarBitNew();
-
-        /* Set 10000 consecutive bits starting at position 1000000 */
-        uint64_t start = 1000000;
-        uint64_t count = 10000;
-        for (uint64_t i = 0; i < count; i++) {
-            multiroarBitSet(r, start + i);
+        /* Set 1000 consecutive bits */
+        for (uint64_t i = 0; i < 1000; i++) {
+            multiroarBitSet(r, i);
         }
 
-        /* Test rank */
-        if (multiroarRank(r, start) != 0) {
-            ERR("Rank before dense region should be 0, got %" PRIu64 "",
-                multiroarRank(r, start));
-        }
-        if (multiroarRank(r, start + count) != count) {
-            ERR("Rank after dense region should be %" PRIu64 ", got %" PRIu64
-                "",
-                count, multiroarRank(r, start + count));
-        }
+        multiroarIterator iter;
+        multiroarIteratorInit(r, &iter);
 
-        /* Test select at boundaries */
+        uint64_t count = 0;
         uint64_t pos;
-        if (!multiroarSelect(r, 1, &pos) || pos != start) {
-            ERR("Select(1) should return %" PRIu64 ", got %" PRIu64, start,
-                pos);
-        }
-        if (!multiroarSelect(r, count, &pos) || pos != start + count - 1) {
-            ERR("Select(%" PRIu64 ") should return %" PRIu64 ", got %" PRIu64,
-                count, start + count - 1, pos);
+        uint64_t lastPos = 0;
+        while (multiroarIteratorNext(&iter, &pos)) {
+            if (count > 0 && pos != lastPos + 1) {
+                ERR("Non-consecutive positions: %" PRIu64 " -> %" PRIu64,
+                    lastPos, pos);
+            }
+            lastPos = pos;
+            count++;
         }
-        if (multiroarSelect(r, count + 1, &pos)) {
-            ERRR("Select beyond count should fail");
+
+        if (count != 1000) {
+            ERR("Expected 1000 positions, got %" PRIu64, count);
         }
 
         multiroarFree(r);
     }
 
-    TEST("rank/select - edge case: alternating bits") {
+    TEST("multiroarIterator - multiple chunks") {
         multiroar *r = multiroarBitNew();
+        /* Set bits in different chunks */
+        multiroarBitSet(r, 100);   /* Chunk 0 */
+        multiroarBitSet(r, 8200);  /* Chunk 1 */
+        multiroarBitSet(r, 16400); /* Chunk 2 */
 
-        /* Set alternating bits in a range */
-        uint64_t start = 50000;
-        uint64_t range = 10000;
-        for (uint64_t i = 0; i < range; i += 2) {
-            multiroarBitSet(r, start + i);
-        }
-
-        /* Test rank at various positions */
-        uint64_t expectedCount = range / 2;
-        if (multiroarRank(r, start + range) != expectedCount) {
-            ERR("Rank should be %" PRIu64 ", got %" PRIu64 "", expectedCount,
-                multiroarRank(r, start + range));
-        }
+        multiroarIterator iter;
+        multiroarIteratorInit(r, &iter);
 
-        /* Test select for every 100th bit */
-        for (uint64_t k = 1; k <= expectedCount; k += 100) {
+        const uint64_t expected[] = {100, 8200, 16400};
+        for (int i = 0; i < 3; i++) {
             uint64_t pos;
-            uint64_t expected = start + (k - 1) * 2;
-            if (!multiroarSelect(r, k, &pos) || pos != expected) {
-                ERR("Select(%" PRIu64 ") should return %" PRIu64
-                    ", got %" PRIu64,
-                    k, expected, pos);
+            if (!multiroarIteratorNext(&iter, &pos) || pos != expected[i]) {
+                ERR("Expected %" PRIu64 ", got %" PRIu64, expected[i], pos);
             }
         }
 
         multiroarFree(r);
     }
 
-    TEST("rank/select - edge case: single bit") {
+    TEST("multiroarIterator - verify count matches bitcount") {
         multiroar *r = multiroarBitNew();
+        /* Set random bits */
+        for (int i = 0; i < 500; i++) {
+            uint64_t pos = ((uint64_t)rand() * rand()) % 50000;
+            multiroarBitSet(r, pos);
+        }
 
-        multiroarBitSet(r, 42);
+        uint64_t expectedCount = multiroarBitCount(r);
 
-        /* Test rank */
-        if (multiroarRank(r, 0) != 0) {
-            ERRR("Rank(0) should be 0");
-        }
-        if (multiroarRank(r, 42) != 0) {
-            ERRR("Rank(42) should be 0");
-        }
-        if (multiroarRank(r, 43) != 1) {
-            ERRR("Rank(43) should be 1");
-        }
-        if (multiroarRank(r, 1000) != 1) {
-            ERRR("Rank(1000) should be 1");
-        }
+        multiroarIterator iter;
+        multiroarIteratorInit(r, &iter);
 
-        /* Test select */
+        uint64_t iterCount = 0;
         uint64_t pos;
-        if (!multiroarSelect(r, 1, &pos) || pos != 42) {
-            ERR("Select(1) should return 42, got %" PRIu64, pos);
-        }
-        if (multiroarSelect(r, 2, &pos)) {
-            ERRR("Select(2) should fail");
+        while (multiroarIteratorNext(&iter, &pos)) {
+            iterCount++;
         }
-        if (multiroarSelect(r, 0, &pos)) {
-            ERRR("Select(0) should fail");
+
+        if (iterCount != expectedCount) {
+            ERR("Iterator count %" PRIu64 " != bitcount %" PRIu64 "", iterCount,
+                expectedCount);
         }
 
         multiroarFree(r);
     }
 
-    TEST("rank/select - edge case: duplicate positions in fuzzing") {
+    TEST("multiroarIterator - ascending order") {
         multiroar *r = multiroarBitNew();
-
-        /* Set same position multiple times */
-        for (int i = 0; i < 100; i++) {
-            multiroarBitSet(r, 1000);
+        /* Set bits in random order */
+        uint64_t positions[] = {500, 100, 300, 200, 400};
+        for (int i = 0; i < 5; i++) {
+            multiroarBitSet(r, positions[i]);
         }
 
-        /* Should only count once */
-        if (multiroarBitCount(r) != 1) {
-            ERR("Count should be 1, got %" PRIu64 "", multiroarBitCount(r));
-        }
-        if (multiroarRank(r, 1001) != 1) {
-            ERR("Rank(1001) should be 1, got %" PRIu64 "",
-                multiroarRank(r, 1001));
-        }
+        multiroarIterator iter;
+        multiroarIteratorInit(r, &iter);
 
+        uint64_t lastPos = 0;
         uint64_t pos;
-        if (!multiroarSelect(r, 1, &pos) || pos != 1000) {
-            ERR("Select(1) should return 1000, got %" PRIu64, pos);
+        bool first = true;
+        while (multiroarIteratorNext(&iter, &pos)) {
+            if (!first && pos <= lastPos) {
+                ERR("Positions not ascending: %" PRIu64 " -> %" PRIu64, lastPos,
+                    pos);
+            }
+            lastPos = pos;
+            first = false;
         }
 
         multiroarFree(r);
     }
 
-    printf("\n=== Rank/Select tests completed! ===\n\n");
-
-    /* ====================================================================
-     * Range Operations Tests
-     * ==================================================================== */
-
-    TEST("multiroarRangeCount - empty bitmap") {
+    TEST("multiroarIteratorReset - reset and re-iterate") {
         multiroar *r = multiroarBitNew();
-
-        if (multiroarRangeCount(r, 0, 100) != 0) {
-            ERRR("RangeCount on empty bitmap should be 0");
+        for (uint64_t i = 0; i < 10; i++) {
+            multiroarBitSet(r, i * 10);
         }
 
-        multiroarFree(r);
-    }
+        multiroarIterator iter;
+        multiroarIteratorInit(r, &iter);
 
-    TEST("multiroarRangeCount - basic range") {
-        multiroar *r = multiroarBitNew();
-        /* Set bits 10, 20, 30, 40, 50 */
-        for (uint64_t i = 10; i <= 50; i += 10) {
-            multiroarBitSet(r, i);
+        /* First iteration */
+        uint64_t count1 = 0;
+        uint64_t pos;
+        while (multiroarIteratorNext(&iter, &pos)) {
+            count1++;
         }
 
-        if (multiroarRangeCount(r, 0, 25) != 2) {
-            ERR("RangeCount [0,25): expected 2, got %" PRIu64 "",
-                multiroarRangeCount(r, 0, 25));
-        }
-        if (multiroarRangeCount(r, 15, 45) != 3) {
-            ERR("RangeCount [15,45): expected 3, got %" PRIu64 "",
-                multiroarRangeCount(r, 15, 45));
+        /* Reset and iterate again */
+        multiroarIteratorReset(&iter);
+        uint64_t count2 = 0;
+        while (multiroarIteratorNext(&iter, &pos)) {
+            count2++;
         }
-        if (multiroarRangeCount(r, 10, 51) != 5) {
-            ERR("RangeCount [10,51): expected 5, got %" PRIu64 "",
-                multiroarRangeCount(r, 10, 51));
+
+        if (count1 != count2 || count1 != 10) {
+            ERR("Reset failed: first=%" PRIu64 " second=%" PRIu64, count1,
+                count2);
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarBitClearRange - basic clear") {
-        multiroar *r = multiroarBitNew();
-        /* Set bits 0..99 */
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(r, i);
-        }
+    TEST_DESC("iterator fuzzing - %d random bitmaps", 500) {
+        for (int trial = 0; trial < 500; trial++) {
+            multiroar *r = multiroarBitNew();
 
-        /* Clear 20..29 (10 bits) */
-        multiroarBitClearRange(r, 20, 10);
+            /* Create random bitmap */
+            int numBits = 50 + (rand() % 200);
+            for (int i = 0; i < numBits; i++) {
+                uint64_t pos = ((uint64_t)rand() * rand()) % 100000;
+                multiroarBitSet(r, pos);
+            }
 
-        if (multiroarBitCount(r) != 90) {
-            ERR("After clearing 10 bits: expected 90, got %" PRIu64 "",
-                multiroarBitCount(r));
-        }
+            uint64_t expectedCount = multiroarBitCount(r);
+
+            /* Iterate and verify */
+            multiroarIterator iter;
+            multiroarIteratorInit(r, &iter);
+
+            uint64_t iterCount = 0;
+            uint64_t pos;
+            uint64_t lastPos = 0;
+            bool first = true;
+
+            while (multiroarIteratorNext(&iter, &pos)) {
+                /* Verify ascending order */
+                if (!first && pos <= lastPos) {
+                    ERR("Trial %d: positions not ascending: %" PRIu64
+                        " -> %" PRIu64,
+                        trial, lastPos, pos);
+                }
+
+                /* Verify bit is actually set */
+                if (!multiroarBitGet(r, pos)) {
+                    ERR("Trial %d: iterator returned unset position %" PRIu64,
+                        trial, pos);
+                }
+
+                lastPos = pos;
+                first = false;
+                iterCount++;
+            }
 
-        for (uint64_t i = 20; i < 30; i++) {
-            if (multiroarBitGet(r, i)) {
-                ERR("Bit %" PRIu64 " should be cleared", i);
+            if (iterCount != expectedCount) {
+                ERR("Trial %d: iterator count %" PRIu64 " != bitcount %" PRIu64
+                    "",
+                    trial, iterCount, expectedCount);
             }
-        }
 
-        multiroarFree(r);
+            multiroarFree(r);
+        }
     }
 
-    TEST("multiroarBitClearRange - multi-chunk") {
-        multiroar *r = multiroarBitNew();
-        /* Set bits across chunks */
-        for (uint64_t i = 8000; i < 10000; i++) {
-            multiroarBitSet(r, i);
-        }
+    printf("\n=== Iterator tests completed! ===\n\n");
 
-        uint64_t beforeCount = multiroarBitCount(r);
+    /* ================================================================
+     * Bulk Operations Tests
+     * ================================================================ */
 
-        /* Count how many bits are actually set in the range we're about to
-         * clear */
-        uint64_t bitsInRange = multiroarRangeCount(r, 8100, 9000);
+    TEST("multiroarBitSetMany - basic") {
+        multiroar *r = multiroarBitNew();
+        uint64_t positions[] = {10, 20, 30, 40, 50};
+        multiroarBitSetMany(r, positions, 5);
 
-        multiroarBitClearRange(r, 8100, 900); /* Clear across chunk boundary */
-        uint64_t afterCount = multiroarBitCount(r);
+        for (int i = 0; i < 5; i++) {
+            if (!multiroarBitGet(r, positions[i])) {
+                ERR("Position %" PRIu64 " should be set", positions[i]);
+            }
+        }
 
-        if (afterCount != beforeCount - bitsInRange) {
-            ERR("Clear range: expected %" PRIu64 ", got %" PRIu64
-                " (range had %" PRIu64 " bits)",
-                beforeCount - bitsInRange, afterCount, bitsInRange);
+        if (multiroarBitCount(r) != 5) {
+            ERR("Expected 5 bits, got %" PRIu64 "", multiroarBitCount(r));
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarBitFlipRange - basic flip") {
+    TEST("multiroarBitGetMany - basic") {
         multiroar *r = multiroarBitNew();
-        /* Set alternating bits 0, 2, 4, 6, 8 */
-        for (uint64_t i = 0; i < 10; i += 2) {
-            multiroarBitSet(r, i);
-        }
+        multiroarBitSet(r, 10);
+        multiroarBitSet(r, 30);
+        multiroarBitSet(r, 50);
 
-        /* Flip range 0..9 (should flip all bits in range) */
-        multiroarBitFlipRange(r, 0, 10);
+        uint64_t positions[] = {10, 20, 30, 40, 50};
+        bool results[5];
+        multiroarBitGetMany(r, positions, 5, results);
 
-        /* Now bits 1, 3, 5, 7, 9 should be set */
-        for (uint64_t i = 0; i < 10; i++) {
-            bool shouldBeSet = (i % 2 == 1);
-            if (multiroarBitGet(r, i) != shouldBeSet) {
-                ERR("After flip: bit %" PRIu64 " should be %d", i, shouldBeSet);
+        bool expected[] = {true, false, true, false, true};
+        for (int i = 0; i < 5; i++) {
+            if (results[i] != expected[i]) {
+                ERR("Position %" PRIu64 ": expected %d, got %d", positions[i],
+                    expected[i], results[i]);
             }
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarBitFlipRange - double flip") {
+    TEST("multiroarToArray - basic") {
         multiroar *r = multiroarBitNew();
-        multiroarBitSet(r, 50);
-
-        /* Flip twice should restore */
-        multiroarBitFlipRange(r, 40, 20);
-        multiroarBitFlipRange(r, 40, 20);
-
-        if (!multiroarBitGet(r, 50)) {
-            ERRR("Double flip should restore original state");
+        uint64_t setPositions[] = {100, 200, 300, 400, 500};
+        for (int i = 0; i < 5; i++) {
+            multiroarBitSet(r, setPositions[i]);
         }
 
-        multiroarFree(r);
-    }
-
-    TEST("multiroarAndNot - basic difference") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+        uint64_t array[10];
+        uint64_t count = multiroarToArray(r, array, 10);
 
-        /* A = {10, 20, 30, 40, 50} */
-        for (uint64_t i = 10; i <= 50; i += 10) {
-            multiroarBitSet(a, i);
+        if (count != 5) {
+            ERR("Expected 5 positions, got %" PRIu64 "", count);
         }
 
-        /* B = {20, 40} */
-        multiroarBitSet(b, 20);
-        multiroarBitSet(b, 40);
-
-        /* A - B = {10, 30, 50} */
-        multiroarAndNot(a, b);
-
-        if (multiroarBitCount(a) != 3) {
-            ERR("A - B count: expected 3, got %" PRIu64 "",
-                multiroarBitCount(a));
-        }
-        if (!multiroarBitGet(a, 10) || !multiroarBitGet(a, 30) ||
-            !multiroarBitGet(a, 50)) {
-            ERRR("A - B should contain {10, 30, 50}");
-        }
-        if (multiroarBitGet(a, 20) || multiroarBitGet(a, 40)) {
-            ERRR("A - B should not contain {20, 40}");
+        for (uint64_t i = 0; i < count; i++) {
+            if (array[i] != setPositions[i]) {
+                ERR("Position %" PRIu64 ": expected %" PRIu64 ", got %" PRIu64,
+                    i, setPositions[i], array[i]);
+            }
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
+        multiroarFree(r);
     }
 
-    TEST("multiroarNewAndNot - creates new result") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
-
+    TEST("multiroarToArray - limited capacity") {
+        multiroar *r = multiroarBitNew();
         for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(a, i);
-        }
-        for (uint64_t i = 50; i < 150; i++) {
-            multiroarBitSet(b, i);
+            multiroarBitSet(r, i);
         }
 
-        /* A - B = [0, 50) */
-        multiroar *result = multiroarNewAndNot(a, b);
+        uint64_t array[50];
+        uint64_t count = multiroarToArray(r, array, 50);
 
-        if (multiroarBitCount(result) != 50) {
-            ERR("NewAndNot count: expected 50, got %" PRIu64 "",
-                multiroarBitCount(result));
+        if (count != 50) {
+            ERR("Expected 50 positions (limited by maxCount), got %" PRIu64 "",
+                count);
         }
 
-        /* Verify a is unchanged */
-        if (multiroarBitCount(a) != 100) {
-            ERRR("Original A should be unchanged");
+        /* Verify positions are ascending */
+        for (uint64_t i = 1; i < count; i++) {
+            if (array[i] <= array[i - 1]) {
+                ERR("Positions not ascending at index %" PRIu64 "", i);
+            }
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(result);
+        multiroarFree(r);
     }
 
-    TEST("multiroarAndNot - disjoint sets") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("multiroarFromArray - basic") {
+        uint64_t positions[] = {10, 20, 30, 40, 50};
+        multiroar *r = multiroarFromArray(positions, 5);
 
-        for (uint64_t i = 0; i < 50; i++) {
-            multiroarBitSet(a, i);
-        }
-        for (uint64_t i = 100; i < 150; i++) {
-            multiroarBitSet(b, i);
+        if (multiroarBitCount(r) != 5) {
+            ERR("Expected 5 bits, got %" PRIu64 "", multiroarBitCount(r));
         }
 
-        uint64_t beforeCount = multiroarBitCount(a);
-        multiroarAndNot(a, b);
-
-        if (multiroarBitCount(a) != beforeCount) {
-            ERRR("Disjoint A - B should equal A");
+        for (int i = 0; i < 5; i++) {
+            if (!multiroarBitGet(r, positions[i])) {
+                ERR("Position %" PRIu64 " should be set", positions[i]);
+            }
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
+        multiroarFree(r);
     }
 
-    TEST("multiroarAndNot - complete overlap") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("multiroarFromArray - with duplicates") {
+        uint64_t positions[] = {10, 20, 10, 30, 20, 40};
+        multiroar *r = multiroarFromArray(positions, 6);
 
-        for (uint64_t i = 0; i < 50; i++) {
-            multiroarBitSet(a, i);
-            multiroarBitSet(b, i);
+        /* Should have 4 unique positions */
+        if (multiroarBitCount(r) != 4) {
+            ERR("Expected 4 unique bits, got %" PRIu64 "",
+                multiroarBitCount(r));
         }
 
-        multiroarAndNot(a, b);
+        multiroarFree(r);
+    }
 
-        if (multiroarBitCount(a) != 0) {
-            ERRR("Complete overlap: A - A should be empty");
+    TEST("ToArray/FromArray round-trip") {
+        multiroar *r1 = multiroarBitNew();
+        /* Set random bits */
+        for (int i = 0; i < 100; i++) {
+            uint64_t pos = ((uint64_t)rand() * rand()) % 10000;
+            multiroarBitSet(r1, pos);
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-    }
+        uint64_t count1 = multiroarBitCount(r1);
 
-    TEST("multiroarBitFlipRange - minimal debug test") {
-        /* Minimal test to debug the assertion failure */
-        multiroar *r = multiroarBitNew();
+        /* Convert to array */
+        uint64_t *array = zcalloc(count1, sizeof(uint64_t));
+        uint64_t arrayCount = multiroarToArray(r1, array, count1);
 
-        /* Set some bits */
-        for (uint64_t i = 0; i < 20; i++) {
-            multiroarBitSet(r, i * 5); /* 0, 5, 10, 15, ... 95 */
+        if (arrayCount != count1) {
+            ERR("ToArray returned %" PRIu64 ", expected %" PRIu64 "",
+                arrayCount, count1);
         }
 
-        uint64_t countBefore = multiroarBitCount(r);
-
-        /* Flip a range */
-        multiroarBitFlipRange(r, 10, 30); /* Flip [10, 40) */
-
-        /* Flip the same range again - should restore */
-        multiroarBitFlipRange(r, 10, 30); /* Flip [10, 40) again */
+        /* Convert back from array */
+        multiroar *r2 = multiroarFromArray(array, arrayCount);
 
-        uint64_t countAfter = multiroarBitCount(r);
+        uint64_t count2 = multiroarBitCount(r2);
+        if (count2 != count1) {
+            ERR("Round-trip count mismatch: %" PRIu64 " != %" PRIu64 "", count2,
+                count1);
+        }
 
-        if (countBefore != countAfter) {
-            ERR("Minimal flip test: expected count %" PRIu64 ", got %" PRIu64
-                "",
-                countBefore, countAfter);
+        /* Verify equality */
+        if (!multiroarEquals(r1, r2)) {
+            ERRR("Round-trip bitmaps not equal");
         }
 
-        multiroarFree(r);
+        zfree(array);
+        multiroarFree(r1);
+        multiroarFree(r2);
     }
 
-    TEST_DESC("range operations fuzzing - %d random operations", 500) {
+    TEST_DESC("bulk operations fuzzing - %d trials", 500) {
         for (int trial = 0; trial < 500; trial++) {
             multiroar *r = multiroarBitNew();
 
-            /* Set random bits */
-            int numBits = 50 + (rand() % 200);
-            for (int i = 0; i < numBits; i++) {
-                uint64_t pos = ((uint64_t)rand() * rand()) % 10000;
-                multiroarBitSet(r, pos);
-            }
-
-            uint64_t initialCount = multiroarBitCount(r);
-
-            /* Test RangeCount */
-            uint64_t rangeStart = ((uint64_t)rand() * rand()) % 8000;
-            uint64_t rangeEnd = rangeStart + (rand() % 2000);
-
-            uint64_t rangeCount = multiroarRangeCount(r, rangeStart, rangeEnd);
-            uint64_t manualCount = 0;
-            for (uint64_t pos = rangeStart; pos < rangeEnd; pos++) {
-                if (multiroarBitGet(r, pos)) {
-                    manualCount++;
-                }
-            }
+            /* Generate random positions */
+            int numPositions = 50 + (rand() % 200);
+            uint64_t *positions = zcalloc(numPositions, sizeof(uint64_t));
 
-            if (rangeCount != manualCount) {
-                ERR("RangeCount mismatch: expected %" PRIu64 ", got %" PRIu64
-                    "",
-                    manualCount, rangeCount);
+            for (int i = 0; i < numPositions; i++) {
+                positions[i] = ((uint64_t)rand() * rand()) % 100000;
             }
 
-            /* Test ClearRange */
-            multiroar *r2 = multiroarDuplicate(r);
-            uint64_t clearStart = rand() % 1000;
-            uint64_t clearExtent = rand() % 500;
+            /* Test SetMany */
+            multiroarBitSetMany(r, positions, numPositions);
 
-            uint64_t bitsInRange =
-                multiroarRangeCount(r2, clearStart, clearStart + clearExtent);
-            multiroarBitClearRange(r2, clearStart, clearExtent);
-            uint64_t afterClear = multiroarBitCount(r2);
+            /* Test GetMany */
+            bool *results = zcalloc(numPositions, sizeof(bool));
+            multiroarBitGetMany(r, positions, numPositions, results);
 
-            if (afterClear != initialCount - bitsInRange) {
-                ERR("ClearRange: expected %" PRIu64 ", got %" PRIu64 "",
-                    initialCount - bitsInRange, afterClear);
+            for (int i = 0; i < numPositions; i++) {
+                if (!results[i]) {
+                    ERR("Trial %d: Position %" PRIu64 " should be set", trial,
+                        positions[i]);
+                }
             }
 
-            multiroarFree(r2);
-
-            /* Test FlipRange */
-            multiroar *r3 = multiroarDuplicate(r);
-            uint64_t flipStart = rand() % 1000;
-            uint64_t flipExtent = rand() % 500;
+            /* Test ToArray */
+            uint64_t bitCount = multiroarBitCount(r);
+            uint64_t *array = zcalloc(bitCount, sizeof(uint64_t));
+            uint64_t arrayCount = multiroarToArray(r, array, bitCount);
 
-            multiroarBitFlipRange(r3, flipStart, flipExtent);
-            multiroarBitFlipRange(r3, flipStart, flipExtent); /* Flip twice */
+            if (arrayCount != bitCount) {
+                ERR("Trial %d: ToArray count mismatch: %" PRIu64 " != %" PRIu64
+                    "",
+                    trial, arrayCount, bitCount);
+            }
 
-            /* Should equal original */
-            if (!multiroarEquals(r, r3)) {
-                ERRR("Double flip should restore original");
+            /* Verify array is sorted */
+            for (uint64_t i = 1; i < arrayCount; i++) {
+                if (array[i] <= array[i - 1]) {
+                    ERR("Trial %d: Array not sorted at index %" PRIu64 "",
+                        trial, i);
+                }
             }
 
-            multiroarFree(r3);
+            zfree(positions);
+            zfree(results);
+            zfree(array);
             multiroarFree(r);
         }
     }
 
-    printf("\n=== Range operations tests completed! ===\n\n");
+    printf("\n=== Bulk operations tests completed! ===\n\n");
 
     /* ================================================================
-     * Iterator Tests
+     * Similarity Metrics Tests
      * ================================================================ */
 
-    TEST("multiroarIterator - empty bitmap") {
-        multiroar *r = multiroarBitNew();
-        multiroarIterator iter;
-        multiroarIteratorInit(r, &iter);
+    TEST("multiroarJaccard - identical sets") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        uint64_t pos;
-        if (multiroarIteratorNext(&iter, &pos)) {
-            ERRR("Empty bitmap should have no positions");
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(a, i);
+            multiroarBitSet(b, i);
         }
 
-        multiroarFree(r);
-    }
+        double jaccard = multiroarJaccard(a, b);
+        if (jaccard < 0.999 || jaccard > 1.001) {
+            ERR("Identical sets should have Jaccard = 1.0, got %f", jaccard);
+        }
 
-    TEST("multiroarIterator - single bit") {
-        multiroar *r = multiroarBitNew();
-        multiroarBitSet(r, 42);
+        multiroarFree(a);
+        multiroarFree(b);
+    }
 
-        multiroarIterator iter;
-        multiroarIteratorInit(r, &iter);
+    TEST("multiroarJaccard - disjoint sets") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        uint64_t pos;
-        if (!multiroarIteratorNext(&iter, &pos) || pos != 42) {
-            ERR("Expected position 42, got %" PRIu64, pos);
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(a, i);
+        }
+        for (uint64_t i = 100; i < 200; i++) {
+            multiroarBitSet(b, i);
         }
 
-        if (multiroarIteratorNext(&iter, &pos)) {
-            ERRR("Should only have one position");
+        double jaccard = multiroarJaccard(a, b);
+        if (jaccard > 0.001) {
+            ERR("Disjoint sets should have Jaccard = 0.0, got %f", jaccard);
         }
 
-        multiroarFree(r);
+        multiroarFree(a);
+        multiroarFree(b);
     }
 
-    TEST("multiroarIterator - sparse chunk") {
-        multiroar *r = multiroarBitNew();
-        /* Set bits 10, 20, 30, 40, 50 */
-        for (uint64_t i = 10; i <= 50; i += 10) {
-            multiroarBitSet(r, i);
-        }
-
-        multiroarIterator iter;
-        multiroarIteratorInit(r, &iter);
+    TEST("multiroarJaccard - partial overlap") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        const uint64_t expected[] = {10, 20, 30, 40, 50};
-        for (int i = 0; i < 5; i++) {
-            uint64_t pos;
-            if (!multiroarIteratorNext(&iter, &pos) || pos != expected[i]) {
-                ERR("Expected %" PRIu64 ", got %" PRIu64, expected[i], pos);
-            }
+        /* A = [0..99], B = [50..149] */
+        /* Intersection = [50..99] = 50 bits */
+        /* Union = [0..149] = 150 bits */
+        /* Jaccard = 50/150 = 0.333... */
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(a, i);
+        }
+        for (uint64_t i = 50; i < 150; i++) {
+            multiroarBitSet(b, i);
         }
 
-        uint64_t pos;
-        if (multiroarIteratorNext(&iter, &pos)) {
-            ERRR("Should have exactly 5 positions");
+        double jaccard = multiroarJaccard(a, b);
+        double expected = 50.0 / 150.0;
+        if (jaccard < expected - 0.01 || jaccard > expected + 0.01) {
+            ERR("Expected Jaccard ~= %f, got %f", expected, jaccard);
         }
 
-        multiroarFree(r);
+        multiroarFree(a);
+        multiroarFree(b);
     }
 
-    TEST("multiroarIterator - dense chunk") {
-        multiroar *r = multiroarBitNew();
-        /* Set 1000 consecutive bits */
-        for (uint64_t i = 0; i < 1000; i++) {
-            multiroarBitSet(r, i);
+    TEST("multiroarJaccard - empty sets") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
+
+        double jaccard = multiroarJaccard(a, b);
+        if (jaccard < 0.999 || jaccard > 1.001) {
+            ERR("Empty sets should have Jaccard = 1.0, got %f", jaccard);
         }
 
-        multiroarIterator iter;
-        multiroarIteratorInit(r, &iter);
+        multiroarFree(a);
+        multiroarFree(b);
+    }
 
-        uint64_t count = 0;
-        uint64_t pos;
-        uint64_t lastPos = 0;
-        while (multiroarIteratorNext(&iter, &pos)) {
-            if (count > 0 && pos != lastPos + 1) {
-                ERR("Non-consecutive positions: %" PRIu64 " -> %" PRIu64,
-                    lastPos, pos);
-            }
-            lastPos = pos;
-            count++;
+    TEST("multiroarHammingDistance - identical sets") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
+
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(a, i);
+            multiroarBitSet(b, i);
         }
 
-        if (count != 1000) {
-            ERR("Expected 1000 positions, got %" PRIu64, count);
+        uint64_t distance = multiroarHammingDistance(a, b);
+        if (distance != 0) {
+            ERR("Identical sets should have Hamming distance = 0, got %" PRIu64
+                "",
+                distance);
         }
 
-        multiroarFree(r);
+        multiroarFree(a);
+        multiroarFree(b);
     }
 
-    TEST("multiroarIterator - multiple chunks") {
-        multiroar *r = multiroarBitNew();
-        /* Set bits in different chunks */
-        multiroarBitSet(r, 100);   /* Chunk 0 */
-        multiroarBitSet(r, 8200);  /* Chunk 1 */
-        multiroarBitSet(r, 16400); /* Chunk 2 */
-
-        multiroarIterator iter;
-        multiroarIteratorInit(r, &iter);
+    TEST("multiroarHammingDistance - disjoint sets") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        const uint64_t expected[] = {100, 8200, 16400};
-        for (int i = 0; i < 3; i++) {
-            uint64_t pos;
-            if (!multiroarIteratorNext(&iter, &pos) || pos != expected[i]) {
-                ERR("Expected %" PRIu64 ", got %" PRIu64, expected[i], pos);
-            }
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(a, i);
+        }
+        for (uint64_t i = 100; i < 200; i++) {
+            multiroarBitSet(b, i);
         }
 
-        multiroarFree(r);
-    }
-
-    TEST("multiroarIterator - verify count matches bitcount") {
-        multiroar *r = multiroarBitNew();
-        /* Set random bits */
-        for (int i = 0; i < 500; i++) {
-            uint64_t pos = ((uint64_t)rand() * rand()) % 50000;
-            multiroarBitSet(r, pos);
+        uint64_t distance = multiroarHammingDistance(a, b);
+        if (distance != 200) {
+            ERR("Disjoint sets (100+100) should have Hamming distance = 200, "
+                "got %" PRIu64 "",
+                distance);
         }
 
-        uint64_t expectedCount = multiroarBitCount(r);
+        multiroarFree(a);
+        multiroarFree(b);
+    }
 
-        multiroarIterator iter;
-        multiroarIteratorInit(r, &iter);
+    TEST("multiroarOverlap - perfect overlap") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        uint64_t iterCount = 0;
-        uint64_t pos;
-        while (multiroarIteratorNext(&iter, &pos)) {
-            iterCount++;
+        for (uint64_t i = 0; i < 50; i++) {
+            multiroarBitSet(a, i);
+        }
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(b, i);
         }
 
-        if (iterCount != expectedCount) {
-            ERR("Iterator count %" PRIu64 " != bitcount %" PRIu64 "", iterCount,
-                expectedCount);
+        /* A ⊆ B, so overlap = 1.0 */
+        double overlap = multiroarOverlap(a, b);
+        if (overlap < 0.999 || overlap > 1.001) {
+            ERR("Perfect overlap should be 1.0, got %f", overlap);
         }
 
-        multiroarFree(r);
+        multiroarFree(a);
+        multiroarFree(b);
     }
 
-    TEST("multiroarIterator - ascending order") {
-        multiroar *r = multiroarBitNew();
-        /* Set bits in random order */
-        uint64_t positions[] = {500, 100, 300, 200, 400};
-        for (int i = 0; i < 5; i++) {
-            multiroarBitSet(r, positions[i]);
-        }
+    TEST("multiroarDice - identical sets") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        multiroarIterator iter;
-        multiroarIteratorInit(r, &iter);
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(a, i);
+            multiroarBitSet(b, i);
+        }
 
-        uint64_t lastPos = 0;
-        uint64_t pos;
-        bool first = true;
-        while (multiroarIteratorNext(&iter, &pos)) {
-            if (!first && pos <= lastPos) {
-                ERR("Positions not ascending: %" PRIu64 " -> %" PRIu64, lastPos,
-                    pos);
-            }
-            lastPos = pos;
-            first = false;
+        double dice = multiroarDice(a, b);
+        if (dice < 0.999 || dice > 1.001) {
+            ERR("Identical sets should have Dice = 1.0, got %f", dice);
         }
 
-        multiroarFree(r);
+        multiroarFree(a);
+        multiroarFree(b);
     }
 
-    TEST("multiroarIteratorReset - reset and re-iterate") {
-        multiroar *r = multiroarBitNew();
-        for (uint64_t i = 0; i < 10; i++) {
-            multiroarBitSet(r, i * 10);
-        }
-
-        multiroarIterator iter;
-        multiroarIteratorInit(r, &iter);
+    TEST("multiroarDice - partial overlap") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        /* First iteration */
-        uint64_t count1 = 0;
-        uint64_t pos;
-        while (multiroarIteratorNext(&iter, &pos)) {
-            count1++;
+        /* A = [0..99] (100 bits), B = [50..149] (100 bits) */
+        /* Intersection = [50..99] = 50 bits */
+        /* Dice = 2*50 / (100+100) = 100/200 = 0.5 */
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSet(a, i);
         }
-
-        /* Reset and iterate again */
-        multiroarIteratorReset(&iter);
-        uint64_t count2 = 0;
-        while (multiroarIteratorNext(&iter, &pos)) {
-            count2++;
+        for (uint64_t i = 50; i < 150; i++) {
+            multiroarBitSet(b, i);
         }
 
-        if (count1 != count2 || count1 != 10) {
-            ERR("Reset failed: first=%" PRIu64 " second=%" PRIu64, count1,
-                count2);
+        double dice = multiroarDice(a, b);
+        double expected = 0.5;
+        if (dice < expected - 0.01 || dice > expected + 0.01) {
+            ERR("Expected Dice = %f, got %f", expected, dice);
         }
 
-        multiroarFree(r);
+        multiroarFree(a);
+        multiroarFree(b);
     }
 
-    TEST_DESC("iterator fuzzing - %d random bitmaps", 500) {
+    TEST_DESC("similarity metrics fuzzing - %d trials", 500) {
         for (int trial = 0; trial < 500; trial++) {
-            multiroar *r = multiroarBitNew();
-
-            /* Create random bitmap */
-            int numBits = 50 + (rand() % 200);
-            for (int i = 0; i < numBits; i++) {
-                uint64_t pos = ((uint64_t)rand() * rand()) % 100000;
-                multiroarBitSet(r, pos);
-            }
-
-            uint64_t expectedCount = multiroarBitCount(r);
+            multiroar *a = multiroarBitNew();
+            multiroar *b = multiroarBitNew();
 
-            /* Iterate and verify */
-            multiroarIterator iter;
-            multiroarIteratorInit(r, &iter);
+            /* Create random bitmaps */
+            int numBitsA = 50 + (rand() % 200);
+            int numBitsB = 50 + (rand() % 200);
 
-            uint64_t iterCount = 0;
-            uint64_t pos;
-            uint64_t lastPos = 0;
-            bool first = true;
+            for (int i = 0; i < numBitsA; i++) {
+                uint64_t pos = ((uint64_t)rand() * rand()) % 10000;
+                multiroarBitSet(a, pos);
+            }
+            for (int i = 0; i < numBitsB; i++) {
+                uint64_t pos = ((uint64_t)rand() * rand()) % 10000;
+                multiroarBitSet(b, pos);
+            }
 
-            while (multiroarIteratorNext(&iter, &pos)) {
-                /* Verify ascending order */
-                if (!first && pos <= lastPos) {
-                    ERR("Trial %d: positions not ascending: %" PRIu64
-                        " -> %" PRIu64,
-                        trial, lastPos, pos);
-                }
+            /* Test all metrics are in valid ranges */
+            double jaccard = multiroarJaccard(a, b);
+            if (jaccard < 0.0 || jaccard > 1.0) {
+                ERR("Trial %d: Jaccard out of range [0,1]: %f", trial, jaccard);
+            }
 
-                /* Verify bit is actually set */
-                if (!multiroarBitGet(r, pos)) {
-                    ERR("Trial %d: iterator returned unset position %" PRIu64,
-                        trial, pos);
-                }
+            uint64_t hamming = multiroarHammingDistance(a, b);
+            uint64_t maxHamming = multiroarBitCount(a) + multiroarBitCount(b);
+            if (hamming > maxHamming) {
+                ERR("Trial %d: Hamming distance %" PRIu64
+                    " exceeds max %" PRIu64 "",
+                    trial, hamming, maxHamming);
+            }
 
-                lastPos = pos;
-                first = false;
-                iterCount++;
+            double overlap = multiroarOverlap(a, b);
+            if (overlap < 0.0 || overlap > 1.0) {
+                ERR("Trial %d: Overlap out of range [0,1]: %f", trial, overlap);
             }
 
-            if (iterCount != expectedCount) {
-                ERR("Trial %d: iterator count %" PRIu64 " != bitcount %" PRIu64
-                    "",
-                    trial, iterCount, expectedCount);
+            double dice = multiroarDice(a, b);
+            if (dice < 0.0 || dice > 1.0) {
+                ERR("Trial %d: Dice out of range [0,1]: %f", trial, dice);
             }
 
-            multiroarFree(r);
+            multiroarFree(a);
+            multiroarFree(b);
         }
     }
 
-    printf("\n=== Iterator tests completed! ===\n\n");
+    printf("\n=== Similarity metrics tests completed! ===\n\n");
 
     /* ================================================================
-     * Bulk Operations Tests
+     * Statistics and Memory Tests
      * ================================================================ */
 
-    TEST("multiroarBitSetMany - basic") {
+    TEST("multiroarMemoryUsage - empty") {
         multiroar *r = multiroarBitNew();
-        uint64_t positions[] = {10, 20, 30, 40, 50};
-        multiroarBitSetMany(r, positions, 5);
-
-        for (int i = 0; i < 5; i++) {
-            if (!multiroarBitGet(r, positions[i])) {
-                ERR("Position %" PRIu64 " should be set", positions[i]);
-            }
-        }
+        uint64_t usage = multiroarMemoryUsage(r);
 
-        if (multiroarBitCount(r) != 5) {
-            ERR("Expected 5 bits, got %" PRIu64 "", multiroarBitCount(r));
+        if (usage < sizeof(multiroar)) {
+            ERR("Memory usage should be at least %zu, got %" PRIu64 "",
+                sizeof(multiroar), usage);
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarBitGetMany - basic") {
+    TEST("multiroarMemoryUsage - non-empty") {
         multiroar *r = multiroarBitNew();
-        multiroarBitSet(r, 10);
-        multiroarBitSet(r, 30);
-        multiroarBitSet(r, 50);
 
-        uint64_t positions[] = {10, 20, 30, 40, 50};
-        bool results[5];
-        multiroarBitGetMany(r, positions, 5, results);
+        for (uint64_t i = 0; i < 1000; i++) {
+            multiroarBitSet(r, i);
+        }
 
-        bool expected[] = {true, false, true, false, true};
-        for (int i = 0; i < 5; i++) {
-            if (results[i] != expected[i]) {
-                ERR("Position %" PRIu64 ": expected %d, got %d", positions[i],
-                    expected[i], results[i]);
-            }
+        uint64_t usage = multiroarMemoryUsage(r);
+        if (usage < sizeof(multiroar)) {
+            ERR("Memory usage should be at least %zu, got %" PRIu64 "",
+                sizeof(multiroar), usage);
         }
 
         multiroarFree(r);
     }
 
-    TEST("multiroarToArray - basic") {
+    printf("\n=== Statistics and memory tests completed! ===\n\n");
+
+    /* ================================================================
+     * Serialization Tests
+     * ================================================================ */
+
+    TEST("multiroarSerialize/Deserialize - empty roar") {
         multiroar *r = multiroarBitNew();
-        uint64_t setPositions[] = {100, 200, 300, 400, 500};
-        for (int i = 0; i < 5; i++) {
-            multiroarBitSet(r, setPositions[i]);
-        }
 
-        uint64_t array[10];
-        uint64_t count = multiroarToArray(r, array, 10);
+        uint64_t size = multiroarSerializedSize(r);
+        void *buf = zcalloc(size, 1);
 
-        if (count != 5) {
-            ERR("Expected 5 positions, got %" PRIu64 "", count);
+        uint64_t written = multiroarSerialize(r, buf, size);
+        if (written == 0) {
+            ERRR("Failed to serialize empty roar");
         }
 
-        for (uint64_t i = 0; i < count; i++) {
-            if (array[i] != setPositions[i]) {
-                ERR("Position %" PRIu64 ": expected %" PRIu64 ", got %" PRIu64,
-                    i, setPositions[i], array[i]);
-            }
+        multiroar *r2 = multiroarDeserialize(buf, written);
+        if (!r2) {
+            ERRR("Failed to deserialize empty roar");
+        }
+
+        if (!multiroarEquals(r, r2)) {
+            ERRR("Deserialized roar doesn't match original");
         }
 
+        zfree(buf);
         multiroarFree(r);
+        multiroarFree(r2);
     }
 
-    TEST("multiroarToArray - limited capacity") {
+    TEST("multiroarSerialize/Deserialize - single bit") {
         multiroar *r = multiroarBitNew();
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(r, i);
+        multiroarBitSet(r, 42);
+
+        uint64_t size = multiroarSerializedSize(r);
+        void *buf = zcalloc(size, 1);
+
+        uint64_t written = multiroarSerialize(r, buf, size);
+        if (written == 0) {
+            ERRR("Failed to serialize single bit");
         }
 
-        uint64_t array[50];
-        uint64_t count = multiroarToArray(r, array, 50);
+        multiroar *r2 = multiroarDeserialize(buf, written);
+        if (!r2) {
+            ERRR("Failed to deserialize single bit");
+        }
 
-        if (count != 50) {
-            ERR("Expected 50 positions (limited by maxCount), got %" PRIu64 "",
-                count);
+        if (!multiroarBitGet(r2, 42)) {
+            ERRR("Bit 42 not set after deserialization");
         }
 
-        /* Verify positions are ascending */
-        for (uint64_t i = 1; i < count; i++) {
-            if (array[i] <= array[i - 1]) {
-                ERR("Positions not ascending at index %" PRIu64 "", i);
-            }
+        if (!multiroarEquals(r, r2)) {
+            ERRR("Deserialized roar doesn't match original");
         }
 
+        zfree(buf);
         multiroarFree(r);
+        multiroarFree(r2);
     }
 
-    TEST("multiroarFromArray - basic") {
-        uint64_t positions[] = {10, 20, 30, 40, 50};
-        multiroar *r = multiroarFromArray(positions, 5);
+    TEST("multiroarSerialize/Deserialize - sparse chunk (UNDER_FULL)") {
+        multiroar *r = multiroarBitNew();
 
-        if (multiroarBitCount(r) != 5) {
-            ERR("Expected 5 bits, got %" PRIu64 "", multiroarBitCount(r));
+        /* Set 50 bits in one chunk */
+        for (uint64_t i = 0; i < 100; i += 2) {
+            multiroarBitSet(r, i);
         }
 
-        for (int i = 0; i < 5; i++) {
-            if (!multiroarBitGet(r, positions[i])) {
-                ERR("Position %" PRIu64 " should be set", positions[i]);
-            }
+        uint64_t size = multiroarSerializedSize(r);
+        void *buf = zcalloc(size, 1);
+
+        uint64_t written = multiroarSerialize(r, buf, size);
+        if (written == 0) {
+            ERRR("Failed to serialize sparse chunk");
         }
 
-        multiroarFree(r);
-    }
+        multiroar *r2 = multiroarDeserialize(buf, written);
+        if (!r2) {
+            ERRR("Failed to deserialize sparse chunk");
+        }
 
-    TEST("multiroarFromArray - with duplicates") {
-        uint64_t positions[] = {10, 20, 10, 30, 20, 40};
-        multiroar *r = multiroarFromArray(positions, 6);
+        if (!multiroarEquals(r, r2)) {
+            ERRR("Deserialized roar doesn't match original");
+        }
 
-        /* Should have 4 unique positions */
-        if (multiroarBitCount(r) != 4) {
-            ERR("Expected 4 unique bits, got %" PRIu64 "",
-                multiroarBitCount(r));
+        /* Verify bitcount matches */
+        if (multiroarBitCount(r) != multiroarBitCount(r2)) {
+            ERR("Bitcount mismatch: %" PRIu64 " vs %" PRIu64 "",
+                multiroarBitCount(r), multiroarBitCount(r2));
         }
 
+        zfree(buf);
         multiroarFree(r);
+        multiroarFree(r2);
     }
 
-    TEST("ToArray/FromArray round-trip") {
-        multiroar *r1 = multiroarBitNew();
-        /* Set random bits */
-        for (int i = 0; i < 100; i++) {
-            uint64_t pos = ((uint64_t)rand() * rand()) % 10000;
-            multiroarBitSet(r1, pos);
-        }
+    TEST("multiroarSerialize/Deserialize - dense chunk (FULL_BITMAP)") {
+        multiroar *r = multiroarBitNew();
 
-        uint64_t count1 = multiroarBitCount(r1);
+        /* Set 4000 bits to force FULL_BITMAP */
+        for (uint64_t i = 0; i < 4000; i++) {
+            multiroarBitSet(r, i);
+        }
 
-        /* Convert to array */
-        uint64_t *array = zcalloc(count1, sizeof(uint64_t));
-        uint64_t arrayCount = multiroarToArray(r1, array, count1);
+        uint64_t size = multiroarSerializedSize(r);
+        void *buf = zcalloc(size, 1);
 
-        if (arrayCount != count1) {
-            ERR("ToArray returned %" PRIu64 ", expected %" PRIu64 "",
-                arrayCount, count1);
+        uint64_t written = multiroarSerialize(r, buf, size);
+        if (written == 0) {
+            ERRR("Failed to serialize dense chunk");
         }
 
-        /* Convert back from array */
-        multiroar *r2 = multiroarFromArray(array, arrayCount);
+        multiroar *r2 = multiroarDeserialize(buf, written);
+        if (!r2) {
+            ERRR("Failed to deserialize dense chunk");
+        }
 
-        uint64_t count2 = multiroarBitCount(r2);
-        if (count2 != count1) {
-            ERR("Round-trip count mismatch: %" PRIu64 " != %" PRIu64 "", count2,
-                count1);
+        if (!multiroarEquals(r, r2)) {
+            ERRR("Deserialized roar doesn't match original");
         }
 
-        /* Verify equality */
-        if (!multiroarEquals(r1, r2)) {
-            ERRR("Round-trip bitmaps not equal");
+        if (multiroarBitCount(r) != multiroarBitCount(r2)) {
+            ERR("Bitcount mismatch: %" PRIu64 " vs %" PRIu64 "",
+                multiroarBitCount(r), multiroarBitCount(r2));
         }
 
-        zfree(array);
-        multiroarFree(r1);
+        zfree(buf);
+        multiroarFree(r);
         multiroarFree(r2);
     }
 
-    TEST_DESC("bulk operations fuzzing - %d trials", 500) {
-        for (int trial = 0; trial < 500; trial++) {
-            multiroar *r = multiroarBitNew();
+    TEST("multiroarSerialize/Deserialize - inverted chunk (OVER_FULL)") {
+        multiroar *r = multiroarBitNew();
 
-            /* Generate random positions */
-            int numPositions = 50 + (rand() % 200);
-            uint64_t *positions = zcalloc(numPositions, sizeof(uint64_t));
+        /* Fill entire chunk except 100 bits to force OVER_FULL */
+        for (uint64_t i = 0; i < 8192; i++) {
+            multiroarBitSet(r, i);
+        }
+        for (uint64_t i = 0; i < 100; i += 2) {
+            multiroarRemove(r, i);
+        }
 
-            for (int i = 0; i < numPositions; i++) {
-                positions[i] = ((uint64_t)rand() * rand()) % 100000;
-            }
+        uint64_t size = multiroarSerializedSize(r);
+        void *buf = zcalloc(size, 1);
 
-            /* Test SetMany */
-            multiroarBitSetMany(r, positions, numPositions);
+        uint64_t written = multiroarSerialize(r, buf, size);
+        if (written == 0) {
+            ERRR("Failed to serialize inverted chunk");
+        }
 
-            /* Test GetMany */
-            bool *results = zcalloc(numPositions, sizeof(bool));
-            multiroarBitGetMany(r, positions, numPositions, results);
+        multiroar *r2 = multiroarDeserialize(buf, written);
+        if (!r2) {
+            ERRR("Failed to deserialize inverted chunk");
+        }
 
-            for (int i = 0; i < numPositions; i++) {
-                if (!results[i]) {
-                    ERR("Trial %d: Position %" PRIu64 " should be set", trial,
-                        positions[i]);
-                }
-            }
+        if (!multiroarEquals(r, r2)) {
+            ERRR("Deserialized roar doesn't match original");
+        }
 
-            /* Test ToArray */
-            uint64_t bitCount = multiroarBitCount(r);
-            uint64_t *array = zcalloc(bitCount, sizeof(uint64_t));
-            uint64_t arrayCount = multiroarToArray(r, array, bitCount);
+        if (multiroarBitCount(r) != multiroarBitCount(r2)) {
+            ERR("Bitcount mismatch: %" PRIu64 " vs %" PRIu64 "",
+                multiroarBitCount(r), multiroarBitCount(r2));
+        }
 
-            if (arrayCount != bitCount) {
-                ERR("Trial %d: ToArray count mismatch: %" PRIu64 " != %" PRIu64
-                    "",
-                    trial, arrayCount, bitCount);
-            }
+        zfree(buf);
+        multiroarFree(r);
+        multiroarFree(r2);
+    }
 
-            /* Verify array is sorted */
-            for (uint64_t i = 1; i < arrayCount; i++) {
-                if (array[i] <= array[i - 1]) {
-                    ERR("Trial %d: Array not sorted at index %" PRIu64 "",
-                        trial, i);
-                }
-            }
+    TEST("multiroarSerialize/Deserialize - full chunk (ALL_1)") {
+        multiroar *r = multiroarBitNew();
 
-            zfree(positions);
-            zfree(results);
-            zfree(array);
-            multiroarFree(r);
+        /* Fill entire chunk */
+        for (uint64_t i = 0; i < 8192; i++) {
+            multiroarBitSet(r, i);
         }
-    }
 
-    printf("\n=== Bulk operations tests completed! ===\n\n");
+        uint64_t size = multiroarSerializedSize(r);
+        void *buf = zcalloc(size, 1);
 
-    /* ================================================================
-     * Similarity Metrics Tests
-     * ================================================================ */
+        uint64_t written = multiroarSerialize(r, buf, size);
+        if (written == 0) {
+            ERRR("Failed to serialize full chunk");
+        }
 
-    TEST("multiroarJaccard - identical sets") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+        multiroar *r2 = multiroarDeserialize(buf, written);
+        if (!r2) {
+            ERRR("Failed to deserialize full chunk");
+        }
 
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(a, i);
-            multiroarBitSet(b, i);
+        if (!multiroarEquals(r, r2)) {
+            ERRR("Deserialized roar doesn't match original");
         }
 
-        double jaccard = multiroarJaccard(a, b);
-        if (jaccard < 0.999 || jaccard > 1.001) {
-            ERR("Identical sets should have Jaccard = 1.0, got %f", jaccard);
+        if (multiroarBitCount(r) != multiroarBitCount(r2)) {
+            ERR("Bitcount mismatch: %" PRIu64 " vs %" PRIu64 "",
+                multiroarBitCount(r), multiroarBitCount(r2));
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
+        zfree(buf);
+        multiroarFree(r);
+        multiroarFree(r2);
     }
 
-    TEST("multiroarJaccard - disjoint sets") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("multiroarSerialize/Deserialize - multiple chunks") {
+        multiroar *r = multiroarBitNew();
 
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(a, i);
+        /* Create multiple chunks with different types */
+        /* Chunk 0: sparse */
+        for (uint64_t i = 0; i < 100; i += 3) {
+            multiroarBitSet(r, i);
         }
-        for (uint64_t i = 100; i < 200; i++) {
-            multiroarBitSet(b, i);
+
+        /* Chunk 1: dense */
+        for (uint64_t i = 8192; i < 12192; i++) {
+            multiroarBitSet(r, i);
         }
 
-        double jaccard = multiroarJaccard(a, b);
-        if (jaccard > 0.001) {
-            ERR("Disjoint sets should have Jaccard = 0.0, got %f", jaccard);
+        /* Chunk 5: sparse */
+        for (uint64_t i = 5 * 8192; i < 5 * 8192 + 50; i += 2) {
+            multiroarBitSet(r, i);
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-    }
+        uint64_t size = multiroarSerializedSize(r);
+        void *buf = zcalloc(size, 1);
 
-    TEST("multiroarJaccard - partial overlap") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+        uint64_t written = multiroarSerialize(r, buf, size);
+        if (written == 0) {
+            ERRR("Failed to serialize multiple chunks");
+        }
 
-        /* A = [0..99], B = [50..149] */
-        /* Intersection = [50..99] = 50 bits */
-        /* Union = [0..149] = 150 bits */
-        /* Jaccard = 50/150 = 0.333... */
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(a, i);
+        multiroar *r2 = multiroarDeserialize(buf, written);
+        if (!r2) {
+            ERRR("Failed to deserialize multiple chunks");
         }
-        for (uint64_t i = 50; i < 150; i++) {
-            multiroarBitSet(b, i);
+
+        if (!multiroarEquals(r, r2)) {
+            ERRR("Deserialized roar doesn't match original");
         }
 
-        double jaccard = multiroarJaccard(a, b);
-        double expected = 50.0 / 150.0;
-        if (jaccard < expected - 0.01 || jaccard > expected + 0.01) {
-            ERR("Expected Jaccard ~= %f, got %f", expected, jaccard);
+        if (multiroarBitCount(r) != multiroarBitCount(r2)) {
+            ERR("Bitcount mismatch: %" PRIu64 " vs %" PRIu64 "",
+                multiroarBitCount(r), multiroarBitCount(r2));
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
+        zfree(buf);
+        multiroarFree(r);
+        multiroarFree(r2);
     }
 
-    TEST("multiroarJaccard - empty sets") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("multiroarSerialize - buffer too small") {
+        multiroar *r = multiroarBitNew();
+        multiroarBitSet(r, 42);
 
-        double jaccard = multiroarJaccard(a, b);
-        if (jaccard < 0.999 || jaccard > 1.001) {
-            ERR("Empty sets should have Jaccard = 1.0, got %f", jaccard);
+        /* Try to serialize with insufficient buffer */
+        uint8_t buf[4]; /* Too small */
+        uint64_t written = multiroarSerialize(r, buf, sizeof(buf));
+
+        if (written != 0) {
+            ERR("Should fail with buffer too small, but wrote %" PRIu64
+                " bytes",
+                written);
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
+        multiroarFree(r);
     }
 
-    TEST("multiroarHammingDistance - identical sets") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
-
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(a, i);
-            multiroarBitSet(b, i);
-        }
+    TEST("multiroarDeserialize - invalid magic") {
+        uint8_t buf[10] = {'X', 'X', 'X', 'X', 1, 0, 0};
 
-        uint64_t distance = multiroarHammingDistance(a, b);
-        if (distance != 0) {
-            ERR("Identical sets should have Hamming distance = 0, got %" PRIu64
-                "",
-                distance);
+        multiroar *r = multiroarDeserialize(buf, sizeof(buf));
+        if (r != NULL) {
+            ERRR("Should fail with invalid magic");
+            multiroarFree(r);
         }
-
-        multiroarFree(a);
-        multiroarFree(b);
     }
 
-    TEST("multiroarHammingDistance - disjoint sets") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("multiroarDeserialize - invalid version") {
+        uint8_t buf[10] = {'R', 'O', 'A', 'R', 99, 0, 0}; /* Version 99 */
 
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(a, i);
+        multiroar *r = multiroarDeserialize(buf, sizeof(buf));
+        if (r != NULL) {
+            ERRR("Should fail with invalid version");
+            multiroarFree(r);
         }
-        for (uint64_t i = 100; i < 200; i++) {
-            multiroarBitSet(b, i);
+    }
+
+    TEST("multiroarDeserialize - malformed RUNS chunks") {
+        /* header, 1 chunk, id 0, RUNS, 1 run, then (start, length) */
+        const uint8_t head[] = {'R', 'O', 'A', 'R', MULTIROAR_VERSION, 0,
+                                1,   0,   CHUNK_TYPE_RUNS, 1};
+        /* start 5, length 2^64 - 4: start + length wraps to 1 */
+        const uint8_t wrapLength[] = {5,    0xfc, 0xff, 0xff, 0xff, 0xff,
+                                      0xff, 0xff, 0xff, 0xff, 0x01};
+        /* start 2^64 - 1, length 3: wraps to 2 */
+        const uint8_t wrapStart[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                     0xff, 0xff, 0xff, 0x01, 3};
+        /* start 8190, length 2: last == BITMAP_SIZE_IN_BITS */
+        const uint8_t pastEnd[] = {0xfe, 0x3f, 2};
+        const struct {
+            const uint8_t *tail;
+            size_t len;
+            const char *what;
+        } cases[] = {{wrapLength, sizeof(wrapLength), "wrapping length"},
+                     {wrapStart, sizeof(wrapStart), "wrapping start"},
+                     {pastEnd, sizeof(pastEnd), "run past chunk end"}};
+
+        for (size_t c = 0; c < sizeof(cases) / sizeof(*cases); c++) {
+            uint8_t buf[32];
+            memcpy(buf, head, sizeof(head));
+            memcpy(buf + sizeof(head), cases[c].tail, cases[c].len);
+            multiroar *r =
+                multiroarDeserialize(buf, sizeof(head) + cases[c].len);
+            if (r) {
+                ERR("Accepted %s", cases[c].what);
+                multiroarFree(r);
+            }
         }
 
-        uint64_t distance = multiroarHammingDistance(a, b);
-        if (distance != 200) {
-            ERR("Disjoint sets (100+100) should have Hamming distance = 200, "
-                "got %" PRIu64 "",
-                distance);
+        /* A valid run restores; the same bytes are rejected as version 1 */
+        uint8_t v1[sizeof(head) + 2];
+        memcpy(v1, head, sizeof(head));
+        v1[sizeof(head)] = 5;
+        v1[sizeof(head) + 1] = 2;
+        multiroar *ok = multiroarDeserialize(v1, sizeof(v1));
+        if (!ok || !multiroarBitGet(ok, 7) || multiroarBitGet(ok, 8)) {
+            ERRR("Valid RUNS chunk not restored");
         }
+        multiroarFree(ok);
 
-        multiroarFree(a);
-        multiroarFree(b);
+        v1[4] = 1;
+        multiroar *old = multiroarDeserialize(v1, sizeof(v1));
+        if (old) {
+            ERRR("RUNS chunk accepted in version 1 buffer");
+            multiroarFree(old);
+        }
     }
 
-    TEST("multiroarOverlap - perfect overlap") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
-
-        for (uint64_t i = 0; i < 50; i++) {
-            multiroarBitSet(a, i);
-        }
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(b, i);
-        }
+    TEST("multiroarSerialize/Deserialize - round-trip iterator verification") {
+        multiroar *r = multiroarBitNew();
 
-        /* A ⊆ B, so overlap = 1.0 */
-        double overlap = multiroarOverlap(a, b);
-        if (overlap < 0.999 || overlap > 1.001) {
-            ERR("Perfect overlap should be 1.0, got %f", overlap);
+        /* Create diverse bitmap */
+        for (uint64_t i = 0; i < 10000; i += 7) {
+            multiroarBitSet(r, i);
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-    }
-
-    TEST("multiroarDice - identical sets") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+        uint64_t size = multiroarSerializedSize(r);
+        void *buf = zcalloc(size, 1);
 
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(a, i);
-            multiroarBitSet(b, i);
+        uint64_t written = multiroarSerialize(r, buf, size);
+        if (written == 0) {
+            ERRR("Serialization failed");
         }
 
-        double dice = multiroarDice(a, b);
-        if (dice < 0.999 || dice > 1.001) {
-            ERR("Identical sets should have Dice = 1.0, got %f", dice);
+        multiroar *r2 = multiroarDeserialize(buf, written);
+        if (!r2) {
+            ERRR("Deserialization failed");
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-    }
+        /* Verify using iterator */
+        multiroarIterator iter1, iter2;
+        multiroarIteratorInit(r, &iter1);
+        multiroarIteratorInit(r2, &iter2);
 
-    TEST("multiroarDice - partial overlap") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+        uint64_t pos1, pos2;
+        int count = 0;
+        while (true) {
+            bool has1 = multiroarIteratorNext(&iter1, &pos1);
+            bool has2 = multiroarIteratorNext(&iter2, &pos2);
 
-        /* A = [0..99] (100 bits), B = [50..149] (100 bits) */
-        /* Intersection = [50..99] = 50 bits */
-        /* Dice = 2*50 / (100+100) = 100/200 = 0.5 */
-        for (uint64_t i = 0; i < 100; i++) {
-            multiroarBitSet(a, i);
-        }
-        for (uint64_t i = 50; i < 150; i++) {
-            multiroarBitSet(b, i);
-        }
+            if (has1 != has2) {
+                ERR("Iterator mismatch at position %d", count);
+            }
 
-        double dice = multiroarDice(a, b);
-        double expected = 0.5;
-        if (dice < expected - 0.01 || dice > expected + 0.01) {
-            ERR("Expected Dice = %f, got %f", expected, dice);
+            if (!has1) {
+                break; /* Both exhausted */
+            }
+
+            if (pos1 != pos2) {
+                ERR("Position mismatch: %" PRIu64 " vs %" PRIu64, pos1, pos2);
+            }
+
+            count++;
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
+        zfree(buf);
+        multiroarFree(r);
+        multiroarFree(r2);
     }
 
-    TEST_DESC("similarity metrics fuzzing - %d trials", 500) {
-        for (int trial = 0; trial < 500; trial++) {
-            multiroar *a = multiroarBitNew();
-            multiroar *b = multiroarBitNew();
-
-            /* Create random bitmaps */
-            int numBitsA = 50 + (rand() % 200);
-            int numBitsB = 50 + (rand() % 200);
+    TEST_DESC("serialization fuzzing - %d trials", 200) {
+        for (int trial = 0; trial < 200; trial++) {
+            multiroar *r = multiroarBitNew();
 
-            for (int i = 0; i < numBitsA; i++) {
-                uint64_t pos = ((uint64_t)rand() * rand()) % 10000;
-                multiroarBitSet(a, pos);
-            }
-            for (int i = 0; i < numBitsB; i++) {
-                uint64_t pos = ((uint64_t)rand() * rand()) % 10000;
-                multiroarBitSet(b, pos);
+            /* Create random bitmap */
+            int numBits = 10 + (rand() % 5000);
+            for (int i = 0; i < numBits; i++) {
+                uint64_t pos = ((uint64_t)rand() * rand() * rand()) % 1000000;
+                multiroarBitSet(r, pos);
             }
 
-            /* Test all metrics are in valid ranges */
-            double jaccard = multiroarJaccard(a, b);
-            if (jaccard < 0.0 || jaccard > 1.0) {
-                ERR("Trial %d: Jaccard out of range [0,1]: %f", trial, jaccard);
+            uint64_t size = multiroarSerializedSize(r);
+            void *buf = zcalloc(size, 1);
+
+            uint64_t written = multiroarSerialize(r, buf, size);
+            if (written == 0) {
+                ERR("Trial %d: Serialization failed", trial);
             }
 
-            uint64_t hamming = multiroarHammingDistance(a, b);
-            uint64_t maxHamming = multiroarBitCount(a) + multiroarBitCount(b);
-            if (hamming > maxHamming) {
-                ERR("Trial %d: Hamming distance %" PRIu64
-                    " exceeds max %" PRIu64 "",
-                    trial, hamming, maxHamming);
+            multiroar *r2 = multiroarDeserialize(buf, written);
+            if (!r2) {
+                ERR("Trial %d: Deserialization failed", trial);
             }
 
-            double overlap = multiroarOverlap(a, b);
-            if (overlap < 0.0 || overlap > 1.0) {
-                ERR("Trial %d: Overlap out of range [0,1]: %f", trial, overlap);
+            if (!multiroarEquals(r, r2)) {
+                ERR("Trial %d: Round-trip equality failed", trial);
             }
 
-            double dice = multiroarDice(a, b);
-            if (dice < 0.0 || dice > 1.0) {
-                ERR("Trial %d: Dice out of range [0,1]: %f", trial, dice);
+            if (multiroarBitCount(r) != multiroarBitCount(r2)) {
+                ERR("Trial %d: Bitcount mismatch", trial);
             }
 
-            multiroarFree(a);
-            multiroarFree(b);
+            zfree(buf);
+            multiroarFree(r);
+            multiroarFree(r2);
         }
     }
 
-    printf("\n=== Similarity metrics tests completed! ===\n\n");
+    printf("\n=== Serialization tests completed! ===\n\n");
 
     /* ================================================================
-     * Statistics and Memory Tests
+     * CROSS-CONTAINER-TYPE OPERATION TESTS
+     *
+     * Roaring bitmaps use different container types based on density:
+     * - UNDER_FULL: sparse array of positions (< 629 bits)
+     * - FULL_BITMAP: actual 8192-bit bitmap (629-7563 bits)
+     * - OVER_FULL: negative listing (> 7563 bits)
+     * - ALL_1: implicit all-ones (all 8192 bits set)
+     *
+     * These tests verify set operations work correctly when combining
+     * chunks of different container types.
      * ================================================================ */
 
-    TEST("multiroarMemoryUsage - empty") {
-        multiroar *r = multiroarBitNew();
-        uint64_t usage = multiroarMemoryUsage(r);
+    printf("\n=== Cross-Container-Type Operation Tests ===\n\n");
+
+/* Helper to create a chunk with specific container type by population */
+#define FILL_SPARSE(r, chunk, count)                                           \
+    do {                                                                       \
+        uint64_t base = (uint64_t)(chunk) * 8192;                              \
+        for (int i = 0; i < (count); i++) {                                    \
+            multiroarBitSet((r), base + (i * 12));                             \
+        }                                                                      \
+    } while (0)
+
+#define FILL_DENSE(r, chunk, start, end)                                       \
+    do {                                                                       \
+        uint64_t base = (uint64_t)(chunk) * 8192;                              \
+        for (int i = (start); i < (end); i++) {                                \
+            multiroarBitSet((r), base + i);                                    \
+        }                                                                      \
+    } while (0)
+
+#define FILL_ALL_ONES(r, chunk)                                                \
+    do {                                                                       \
+        uint64_t base = (uint64_t)(chunk) * 8192;                              \
+        for (int i = 0; i < 8192; i++) {                                       \
+            multiroarBitSet((r), base + i);                                    \
+        }                                                                      \
+    } while (0)
 
-        if (usage < sizeof(multiroar)) {
-            ERR("Memory usage should be at least %zu, got %" PRIu64 "",
-                sizeof(multiroar), usage);
-        }
+    TEST("AND: UNDER_FULL x UNDER_FULL (same chunk)") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        multiroarFree(r);
-    }
+        /* Create sparse chunks (< 629 positions) */
+        FILL_SPARSE(a, 0, 100); /* Positions 0, 12, 24, ... */
+        FILL_SPARSE(b, 0, 50);  /* Overlaps first 50 positions of a */
 
-    TEST("multiroarMemoryUsage - non-empty") {
-        multiroar *r = multiroarBitNew();
+        multiroar *result = multiroarNewAnd(a, b);
 
-        for (uint64_t i = 0; i < 1000; i++) {
-            multiroarBitSet(r, i);
+        /* Result should have 50 bits (the overlap) */
+        uint64_t countResult = multiroarBitCount(result);
+        if (countResult != 50) {
+            ERR("UNDER_FULL x UNDER_FULL: expected 50, got %" PRIu64,
+                countResult);
         }
 
-        uint64_t usage = multiroarMemoryUsage(r);
-        if (usage < sizeof(multiroar)) {
-            ERR("Memory usage should be at least %zu, got %" PRIu64 "",
-                sizeof(multiroar), usage);
+        /* Verify specific bits */
+        for (int i = 0; i < 50; i++) {
+            if (!multiroarBitGet(result, i * 12)) {
+                ERR("Missing bit at position %d", i * 12);
+            }
+        }
+        for (int i = 50; i < 100; i++) {
+            if (multiroarBitGet(result, i * 12)) {
+                ERR("Unexpected bit at position %d", i * 12);
+            }
         }
 
-        multiroarFree(r);
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
     }
 
-    printf("\n=== Statistics and memory tests completed! ===\n\n");
-
-    /* ================================================================
-     * Serialization Tests
-     * ================================================================ */
+    TEST("AND: FULL_BITMAP x FULL_BITMAP") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-    TEST("multiroarSerialize/Deserialize - empty roar") {
-        multiroar *r = multiroarBitNew();
+        /* Create bitmap chunks (> 629 positions, contiguous) */
+        FILL_DENSE(a, 0, 0, 4096);    /* First half of chunk */
+        FILL_DENSE(b, 0, 2048, 6144); /* Middle portion, overlaps [2048,4096) */
 
-        uint64_t size = multiroarSerializedSize(r);
-        void *buf = zcalloc(size, 1);
+        multiroar *result = multiroarNewAnd(a, b);
 
-        uint64_t written = multiroarSerialize(r, buf, size);
-        if (written == 0) {
-            ERRR("Failed to serialize empty roar");
+        /* Result should have 2048 bits (the overlap [2048, 4096)) */
+        uint64_t countResult = multiroarBitCount(result);
+        if (countResult != 2048) {
+            ERR("FULL_BITMAP x FULL_BITMAP: expected 2048, got %" PRIu64,
+                countResult);
         }
 
-        multiroar *r2 = multiroarDeserialize(buf, written);
-        if (!r2) {
-            ERRR("Failed to deserialize empty roar");
+        /* Verify boundaries */
+        if (multiroarBitGet(result, 2047)) {
+            ERRR("Bit 2047 should NOT be set");
         }
-
-        if (!multiroarEquals(r, r2)) {
-            ERRR("Deserialized roar doesn't match original");
+        if (!multiroarBitGet(result, 2048)) {
+            ERRR("Bit 2048 should be set");
+        }
+        if (!multiroarBitGet(result, 4095)) {
+            ERRR("Bit 4095 should be set");
+        }
+        if (multiroarBitGet(result, 4096)) {
+            ERRR("Bit 4096 should NOT be set");
         }
 
-        zfree(buf);
-        multiroarFree(r);
-        multiroarFree(r2);
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
     }
 
-    TEST("multiroarSerialize/Deserialize - single bit") {
-        multiroar *r = multiroarBitNew();
-        multiroarBitSet(r, 42);
-
-        uint64_t size = multiroarSerializedSize(r);
-        void *buf = zcalloc(size, 1);
-
-        uint64_t written = multiroarSerialize(r, buf, size);
-        if (written == 0) {
-            ERRR("Failed to serialize single bit");
-        }
+    TEST("AND: UNDER_FULL x FULL_BITMAP") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        multiroar *r2 = multiroarDeserialize(buf, written);
-        if (!r2) {
-            ERRR("Failed to deserialize single bit");
-        }
+        /* a: sparse (100 positions spread out) */
+        FILL_SPARSE(a, 0, 100);
+        /* b: dense bitmap covering first 2000 positions */
+        FILL_DENSE(b, 0, 0, 2000);
 
-        if (!multiroarBitGet(r2, 42)) {
-            ERRR("Bit 42 not set after deserialization");
-        }
+        multiroar *result = multiroarNewAnd(a, b);
 
-        if (!multiroarEquals(r, r2)) {
-            ERRR("Deserialized roar doesn't match original");
+        /* Positions 0,12,24,...,1188 (i*12 where i*12 < 2000) are in both
+         * 1188 / 12 = 99 positions, but we need i*12 < 2000
+         * Max i where i*12 < 2000: i < 166.67, so i <= 166
+         * But we only filled 100 sparse positions, so all 100 should match */
+        uint64_t countResult = multiroarBitCount(result);
+        if (countResult != 100) {
+            ERR("UNDER_FULL x FULL_BITMAP: expected 100, got %" PRIu64,
+                countResult);
         }
 
-        zfree(buf);
-        multiroarFree(r);
-        multiroarFree(r2);
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
     }
 
-    TEST("multiroarSerialize/Deserialize - sparse chunk (UNDER_FULL)") {
-        multiroar *r = multiroarBitNew();
+    TEST("AND: FULL_BITMAP x OVER_FULL (negative listing)") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        /* Set 50 bits in one chunk */
-        for (uint64_t i = 0; i < 100; i += 2) {
-            multiroarBitSet(r, i);
-        }
+        /* a: bitmap covering [0, 4096) */
+        FILL_DENSE(a, 0, 0, 4096);
 
-        uint64_t size = multiroarSerializedSize(r);
-        void *buf = zcalloc(size, 1);
+        /* b: negative listing - almost all bits set (> 7563) */
+        FILL_ALL_ONES(b, 0);
+        /* Clear just a few bits to verify difference */
+        multiroarRemove(b, 100);
+        multiroarRemove(b, 200);
+        multiroarRemove(b, 300);
 
-        uint64_t written = multiroarSerialize(r, buf, size);
-        if (written == 0) {
-            ERRR("Failed to serialize sparse chunk");
-        }
+        multiroar *result = multiroarNewAnd(a, b);
 
-        multiroar *r2 = multiroarDeserialize(buf, written);
-        if (!r2) {
-            ERRR("Failed to deserialize sparse chunk");
+        /* Should have 4096 - 3 bits (the ones we cleared in b) */
+        uint64_t countResult = multiroarBitCount(result);
+        if (countResult != 4093) {
+            ERR("FULL_BITMAP x OVER_FULL: expected 4093, got %" PRIu64,
+                countResult);
         }
 
-        if (!multiroarEquals(r, r2)) {
-            ERRR("Deserialized roar doesn't match original");
+        /* Verify the cleared bits are not set */
+        if (multiroarBitGet(result, 100)) {
+            ERRR("Bit 100 should NOT be set");
         }
-
-        /* Verify bitcount matches */
-        if (multiroarBitCount(r) != multiroarBitCount(r2)) {
-            ERR("Bitcount mismatch: %" PRIu64 " vs %" PRIu64 "",
-                multiroarBitCount(r), multiroarBitCount(r2));
+        if (multiroarBitGet(result, 200)) {
+            ERRR("Bit 200 should NOT be set");
+        }
+        if (multiroarBitGet(result, 300)) {
+            ERRR("Bit 300 should NOT be set");
         }
 
-        zfree(buf);
-        multiroarFree(r);
-        multiroarFree(r2);
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
     }
 
-    TEST("multiroarSerialize/Deserialize - dense chunk (FULL_BITMAP)") {
-        multiroar *r = multiroarBitNew();
+    TEST("AND: ALL_1 x UNDER_FULL") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        /* Set 4000 bits to force FULL_BITMAP */
-        for (uint64_t i = 0; i < 4000; i++) {
-            multiroarBitSet(r, i);
-        }
+        /* a: all ones */
+        FILL_ALL_ONES(a, 0);
+        /* b: sparse */
+        FILL_SPARSE(b, 0, 200);
 
-        uint64_t size = multiroarSerializedSize(r);
-        void *buf = zcalloc(size, 1);
+        multiroar *result = multiroarNewAnd(a, b);
 
-        uint64_t written = multiroarSerialize(r, buf, size);
-        if (written == 0) {
-            ERRR("Failed to serialize dense chunk");
+        /* Result should equal b */
+        uint64_t countResult = multiroarBitCount(result);
+        if (countResult != 200) {
+            ERR("ALL_1 x UNDER_FULL: expected 200, got %" PRIu64, countResult);
         }
 
-        multiroar *r2 = multiroarDeserialize(buf, written);
-        if (!r2) {
-            ERRR("Failed to deserialize dense chunk");
+        if (!multiroarEquals(result, b)) {
+            ERRR("ALL_1 AND sparse should equal sparse");
         }
 
-        if (!multiroarEquals(r, r2)) {
-            ERRR("Deserialized roar doesn't match original");
-        }
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
+    }
 
-        if (multiroarBitCount(r) != multiroarBitCount(r2)) {
-            ERR("Bitcount mismatch: %" PRIu64 " vs %" PRIu64 "",
-                multiroarBitCount(r), multiroarBitCount(r2));
-        }
+    TEST("OR: UNDER_FULL x FULL_BITMAP") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        zfree(buf);
-        multiroarFree(r);
-        multiroarFree(r2);
-    }
+        /* a: sparse in chunk 0, positions 0,12,24,...,1188 */
+        FILL_SPARSE(a, 0, 100);
+        /* b: dense in chunk 0, positions [2000, 4000) */
+        FILL_DENSE(b, 0, 2000, 4000);
 
-    TEST("multiroarSerialize/Deserialize - inverted chunk (OVER_FULL)") {
-        multiroar *r = multiroarBitNew();
+        multiroar *result = multiroarNewOr(a, b);
 
-        /* Fill entire chunk except 100 bits to force OVER_FULL */
-        for (uint64_t i = 0; i < 8192; i++) {
-            multiroarBitSet(r, i);
-        }
-        for (uint64_t i = 0; i < 100; i += 2) {
-            multiroarRemove(r, i);
+        /* Result should have 100 + 2000 = 2100 bits (no overlap) */
+        uint64_t countResult = multiroarBitCount(result);
+        if (countResult != 2100) {
+            ERR("OR UNDER_FULL x FULL_BITMAP: expected 2100, got %" PRIu64,
+                countResult);
         }
 
-        uint64_t size = multiroarSerializedSize(r);
-        void *buf = zcalloc(size, 1);
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
+    }
 
-        uint64_t written = multiroarSerialize(r, buf, size);
-        if (written == 0) {
-            ERRR("Failed to serialize inverted chunk");
-        }
+    TEST("OR: UNDER_FULL x OVER_FULL across different chunks") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        multiroar *r2 = multiroarDeserialize(buf, written);
-        if (!r2) {
-            ERRR("Failed to deserialize inverted chunk");
-        }
+        /* a: sparse in chunk 0 */
+        FILL_SPARSE(a, 0, 100);
+        /* b: negative listing in chunk 1 (almost all ones) */
+        FILL_ALL_ONES(b, 1);
+        multiroarRemove(b, 8192 + 50);
 
-        if (!multiroarEquals(r, r2)) {
-            ERRR("Deserialized roar doesn't match original");
-        }
+        multiroar *result = multiroarNewOr(a, b);
 
-        if (multiroarBitCount(r) != multiroarBitCount(r2)) {
-            ERR("Bitcount mismatch: %" PRIu64 " vs %" PRIu64 "",
-                multiroarBitCount(r), multiroarBitCount(r2));
+        /* Result: 100 bits in chunk 0, 8191 bits in chunk 1 */
+        uint64_t countResult = multiroarBitCount(result);
+        if (countResult != 100 + 8191) {
+            ERR("OR across chunks: expected %d, got %" PRIu64, 100 + 8191,
+                countResult);
         }
 
-        zfree(buf);
-        multiroarFree(r);
-        multiroarFree(r2);
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
     }
 
-    TEST("multiroarSerialize/Deserialize - full chunk (ALL_1)") {
-        multiroar *r = multiroarBitNew();
+    TEST("XOR: FULL_BITMAP x FULL_BITMAP (partial overlap)") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        /* Fill entire chunk */
-        for (uint64_t i = 0; i < 8192; i++) {
-            multiroarBitSet(r, i);
-        }
+        /* a: [0, 3000) */
+        FILL_DENSE(a, 0, 0, 3000);
+        /* b: [2000, 5000) */
+        FILL_DENSE(b, 0, 2000, 5000);
 
-        uint64_t size = multiroarSerializedSize(r);
-        void *buf = zcalloc(size, 1);
+        multiroar *result = multiroarNewXor(a, b);
 
-        uint64_t written = multiroarSerialize(r, buf, size);
-        if (written == 0) {
-            ERRR("Failed to serialize full chunk");
+        /* XOR: [0,2000) + [3000,5000) = 2000 + 2000 = 4000 */
+        uint64_t countResult = multiroarBitCount(result);
+        if (countResult != 4000) {
+            ERR("XOR FULL_BITMAP x FULL_BITMAP: expected 4000, got %" PRIu64,
+                countResult);
         }
 
-        multiroar *r2 = multiroarDeserialize(buf, written);
-        if (!r2) {
-            ERRR("Failed to deserialize full chunk");
+        /* Verify boundaries */
+        if (!multiroarBitGet(result, 1999)) {
+            ERRR("Bit 1999 should be set (in a only)");
         }
-
-        if (!multiroarEquals(r, r2)) {
-            ERRR("Deserialized roar doesn't match original");
+        if (multiroarBitGet(result, 2000)) {
+            ERRR("Bit 2000 should NOT be set (in both)");
         }
-
-        if (multiroarBitCount(r) != multiroarBitCount(r2)) {
-            ERR("Bitcount mismatch: %" PRIu64 " vs %" PRIu64 "",
-                multiroarBitCount(r), multiroarBitCount(r2));
+        if (multiroarBitGet(result, 2999)) {
+            ERRR("Bit 2999 should NOT be set (in both)");
+        }
+        if (!multiroarBitGet(result, 3000)) {
+            ERRR("Bit 3000 should be set (in b only)");
         }
 
-        zfree(buf);
-        multiroarFree(r);
-        multiroarFree(r2);
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
     }
 
-    TEST("multiroarSerialize/Deserialize - multiple chunks") {
-        multiroar *r = multiroarBitNew();
+    TEST("XOR: ALL_1 x FULL_BITMAP") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        /* Create multiple chunks with different types */
-        /* Chunk 0: sparse */
-        for (uint64_t i = 0; i < 100; i += 3) {
-            multiroarBitSet(r, i);
-        }
+        /* a: all ones in chunk 0 */
+        FILL_ALL_ONES(a, 0);
+        /* b: [0, 4096) in chunk 0 */
+        FILL_DENSE(b, 0, 0, 4096);
 
-        /* Chunk 1: dense */
-        for (uint64_t i = 8192; i < 12192; i++) {
-            multiroarBitSet(r, i);
-        }
+        multiroar *result = multiroarNewXor(a, b);
 
-        /* Chunk 5: sparse */
-        for (uint64_t i = 5 * 8192; i < 5 * 8192 + 50; i += 2) {
-            multiroarBitSet(r, i);
+        /* XOR: bits [4096, 8192) should be set (8192 - 4096 = 4096 bits) */
+        uint64_t countResult = multiroarBitCount(result);
+        if (countResult != 4096) {
+            ERR("XOR ALL_1 x FULL_BITMAP: expected 4096, got %" PRIu64,
+                countResult);
         }
 
-        uint64_t size = multiroarSerializedSize(r);
-        void *buf = zcalloc(size, 1);
-
-        uint64_t written = multiroarSerialize(r, buf, size);
-        if (written == 0) {
-            ERRR("Failed to serialize multiple chunks");
+        if (multiroarBitGet(result, 4095)) {
+            ERRR("Bit 4095 should NOT be set");
         }
-
-        multiroar *r2 = multiroarDeserialize(buf, written);
-        if (!r2) {
-            ERRR("Failed to deserialize multiple chunks");
+        if (!multiroarBitGet(result, 4096)) {
+            ERRR("Bit 4096 should be set");
         }
 
-        if (!multiroarEquals(r, r2)) {
-            ERRR("Deserialized roar doesn't match original");
-        }
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
+    }
 
-        if (multiroarBitCount(r) != multiroarBitCount(r2)) {
-            ERR("Bitcount mismatch: %" PRIu64 " vs %" PRIu64 "",
-                multiroarBitCount(r), multiroarBitCount(r2));
-        }
+    TEST("ANDNOT: FULL_BITMAP - UNDER_FULL") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        zfree(buf);
-        multiroarFree(r);
-        multiroarFree(r2);
-    }
+        /* a: dense [0, 2000) */
+        FILL_DENSE(a, 0, 0, 2000);
+        /* b: sparse at 0,12,24,...,588 (50 positions) */
+        FILL_SPARSE(b, 0, 50);
 
-    TEST("multiroarSerialize - buffer too small") {
-        multiroar *r = multiroarBitNew();
-        multiroarBitSet(r, 42);
+        multiroar *result = multiroarNewAndNot(a, b);
 
-        /* Try to serialize with insufficient buffer */
-        uint8_t buf[4]; /* Too small */
-        uint64_t written = multiroarSerialize(r, buf, sizeof(buf));
+        /* Result: 2000 - 50 = 1950 bits */
+        uint64_t countResult = multiroarBitCount(result);
+        if (countResult != 1950) {
+            ERR("ANDNOT FULL_BITMAP - UNDER_FULL: expected 1950, got %" PRIu64,
+                countResult);
+        }
 
-        if (written != 0) {
-            ERR("Should fail with buffer too small, but wrote %" PRIu64
-                " bytes",
-                written);
+        /* Verify removed bits */
+        for (int i = 0; i < 50; i++) {
+            if (multiroarBitGet(result, i * 12)) {
+                ERR("Bit %d should be removed", i * 12);
+            }
         }
 
-        multiroarFree(r);
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
     }
 
-    TEST("multiroarDeserialize - invalid magic") {
-        uint8_t buf[10] = {'X', 'X', 'X', 'X', 1, 0, 0};
+    TEST("ANDNOT: OVER_FULL - FULL_BITMAP") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        multiroar *r = multiroarDeserialize(buf, sizeof(buf));
-        if (r != NULL) {
-            ERRR("Should fail with invalid magic");
-            multiroarFree(r);
-        }
-    }
+        /* a: almost all ones (negative listing) */
+        FILL_ALL_ONES(a, 0);
+        multiroarRemove(a, 100); /* 8191 bits set */
 
-    TEST("multiroarDeserialize - invalid version") {
-        uint8_t buf[10] = {'R', 'O', 'A', 'R', 99, 0, 0}; /* Version 99 */
+        /* b: dense [0, 4096) */
+        FILL_DENSE(b, 0, 0, 4096);
 
-        multiroar *r = multiroarDeserialize(buf, sizeof(buf));
-        if (r != NULL) {
-            ERRR("Should fail with invalid version");
-            multiroarFree(r);
+        multiroar *result = multiroarNewAndNot(a, b);
+
+        /* Result: bits in a not in b = [4096, 8192) minus bit 100 wasn't in a
+         * But bit 100 is in [0,4096) so it's removed by ANDNOT anyway
+         * a has all except 100, b has [0,4096)
+         * a - b = [4096, 8192) = 4096 bits */
+        uint64_t countResult = multiroarBitCount(result);
+        if (countResult != 4096) {
+            ERR("ANDNOT OVER_FULL - FULL_BITMAP: expected 4096, got %" PRIu64,
+                countResult);
         }
+
+        multiroarFree(a);
+        multiroarFree(b);
+        multiroarFree(result);
     }
 
-    TEST("multiroarSerialize/Deserialize - round-trip iterator verification") {
-        multiroar *r = multiroarBitNew();
+    TEST("Complex: mixed container types across multiple chunks") {
+        multiroar *a = multiroarBitNew();
+        multiroar *b = multiroarBitNew();
 
-        /* Create diverse bitmap */
-        for (uint64_t i = 0; i < 10000; i += 7) {
-            multiroarBitSet(r, i);
-        }
+        /* Chunk 0: a=sparse, b=bitmap */
+        FILL_SPARSE(a, 0, 100);
+        FILL_DENSE(b, 0, 0, 1000);
 
-        uint64_t size = multiroarSerializedSize(r);
-        void *buf = zcalloc(size, 1);
+        /* Chunk 1: a=bitmap, b=sparse */
+        FILL_DENSE(a, 1, 0, 2000);
+        FILL_SPARSE(b, 1, 150);
 
-        uint64_t written = multiroarSerialize(r, buf, size);
-        if (written == 0) {
-            ERRR("Serialization failed");
-        }
+        /* Chunk 2: a=all_ones, b=over_full */
+        FILL_ALL_ONES(a, 2);
+        FILL_ALL_ONES(b, 2);
+        multiroarRemove(b, 2 * 8192 + 500);
 
-        multiroar *r2 = multiroarDeserialize(buf, written);
-        if (!r2) {
-            ERRR("Deserialization failed");
-        }
+        /* Chunk 3: a=empty, b=bitmap */
+        FILL_DENSE(b, 3, 1000, 3000);
 
-        /* Verify using iterator */
-        multiroarIterator iter1, iter2;
-        multiroarIteratorInit(r, &iter1);
-        multiroarIteratorInit(r2, &iter2);
+        /* Chunk 4: a=over_full, b=empty */
+        FILL_ALL_ONES(a, 4);
+        multiroarRemove(a, 4 * 8192 + 100);
 
-        uint64_t pos1, pos2;
-        int count = 0;
-        while (true) {
-            bool has1 = multiroarIteratorNext(&iter1, &pos1);
-            bool has2 = multiroarIteratorNext(&iter2, &pos2);
+        /* Test AND */
+        multiroar *andResult = multiroarNewAnd(a, b);
+        /* Chunk 0: sparse 100 positions at i*12, dense [0,1000)
+         *          i*12 < 1000 for i < 83.33, so 84 positions match (i=0..83)
+         */
+        /* Chunk 1: dense [0,2000), sparse 150 positions at i*12
+         *          i*12 < 2000 for i < 167, we have 150 positions, all match */
+        /* Chunk 2: 8192 AND (8192-1) = 8191 */
+        /* Chunk 3: empty AND bitmap = empty */
+        /* Chunk 4: over_full AND empty = empty */
+        uint64_t expectedAnd = 84 + 150 + 8191;
 
-            if (has1 != has2) {
-                ERR("Iterator mismatch at position %d", count);
-            }
+        if (multiroarBitCount(andResult) != expectedAnd) {
+            ERR("Complex AND: expected %" PRIu64 ", got %" PRIu64, expectedAnd,
+                multiroarBitCount(andResult));
+        }
+        multiroarFree(andResult);
 
-            if (!has1) {
-                break; /* Both exhausted */
-            }
+        /* Test OR */
+        multiroar *orResult = multiroarNewOr(a, b);
+        /* Chunk 0: 100 sparse + 1000 dense with overlap */
+        /* Chunk 1: 2000 dense + 150 sparse with overlap */
+        /* Chunk 2: all_ones OR (all-1) = all_ones = 8192 */
+        /* Chunk 3: empty + 2000 = 2000 */
+        /* Chunk 4: 8191 + 0 = 8191 */
 
-            if (pos1 != pos2) {
-                ERR("Position mismatch: %" PRIu64 " vs %" PRIu64, pos1, pos2);
-            }
+        /* Chunk 0: positions 0,12,24,...1188 (100) union [0,1000)
+         *          The sparse positions i*12 for i<84 are in [0,1000)
+         *          So union is [0,1000) + positions 1008,1020,...,1188 = 16
+         * more = 1000 + (100-84) = 1016 */
+        /* Chunk 1: [0,2000) union positions i*12 for i in [0,150)
+         *          i*12 < 2000 for i < 167, so all 150 in [0,2000)
+         *          = 2000 (no additional) */
+        /* So OR = 1016 + 2000 + 8192 + 2000 + 8191 = 21399 */
+        /* Actually let me recalculate chunk 0:
+         * sparse has i*12 for i in [0,100), so max is 99*12 = 1188
+         * dense has [0,1000)
+         * overlap: i*12 < 1000 for i < 83.33, so i <= 83 -> positions
+         * 0,12,...996 union: 1000 + (100 - 84) = 1000 + 16 = 1016 */
 
-            count++;
+        uint64_t expectedOr = 1016 + 2000 + 8192 + 2000 + 8191;
+        if (multiroarBitCount(orResult) != expectedOr) {
+            ERR("Complex OR: expected %" PRIu64 ", got %" PRIu64, expectedOr,
+                multiroarBitCount(orResult));
         }
+        multiroarFree(orResult);
 
-        zfree(buf);
-        multiroarFree(r);
-        multiroarFree(r2);
+        multiroarFree(a);
+        multiroarFree(b);
     }
 
-    TEST_DESC("serialization fuzzing - %d trials", 200) {
-        for (int trial = 0; trial < 200; trial++) {
-            multiroar *r = multiroarBitNew();
+    TEST("FUZZ: random cross-container operations") {
+        uint64_t seed[2] = {0xDEADBEEF12345678ULL, 0x8765432100000001ULL};
 
-            /* Create random bitmap */
-            int numBits = 10 + (rand() % 5000);
-            for (int i = 0; i < numBits; i++) {
-                uint64_t pos = ((uint64_t)rand() * rand() * rand()) % 1000000;
-                multiroarBitSet(r, pos);
+        for (int trial = 0; trial < 20; trial++) {
+            multiroar *a = multiroarBitNew();
+            multiroar *b = multiroarBitNew();
+
+            /* Randomly fill chunks with different densities */
+            for (int chunk = 0; chunk < 4; chunk++) {
+                uint64_t base = chunk * 8192ULL;
+                uint64_t densityA = xoroshiro128plus(seed) % 100;
+                uint64_t densityB = xoroshiro128plus(seed) % 100;
+
+                /* 0-20%: empty, 20-40%: sparse, 40-80%: bitmap, 80-100%: dense
+                 */
+                if (densityA >= 20) {
+                    int count = (densityA < 40)   ? 50 + (densityA % 100)
+                                : (densityA < 80) ? 1000 + (densityA % 2000)
+                                                  : 7500 + (densityA % 692);
+                    for (int i = 0; i < count; i++) {
+                        multiroarBitSet(a,
+                                        base + (xoroshiro128plus(seed) % 8192));
+                    }
+                }
+                if (densityB >= 20) {
+                    int count = (densityB < 40)   ? 50 + (densityB % 100)
+                                : (densityB < 80) ? 1000 + (densityB % 2000)
+                                                  : 7500 + (densityB % 692);
+                    for (int i = 0; i < count; i++) {
+                        multiroarBitSet(b,
+                                        base + (xoroshiro128plus(seed) % 8192));
+                    }
+                }
             }
 
-            uint64_t size = multiroarSerializedSize(r);
-            void *buf = zcalloc(size, 1);
+            uint64_t countA = multiroarBitCount(a);
+            uint64_t countB = multiroarBitCount(b);
 
-            uint64_t written = multiroarSerialize(r, buf, size);
-            if (written == 0) {
-                ERR("Trial %d: Serialization failed", trial);
+            /* Test AND: result count <= min(countA, countB) */
+            multiroar *andResult = multiroarNewAnd(a, b);
+            uint64_t andCount = multiroarBitCount(andResult);
+            uint64_t minAB = (countA < countB) ? countA : countB;
+            if (andCount > minAB) {
+                ERR("Trial %d: AND count %" PRIu64 " > min(%" PRIu64 ",%" PRIu64
+                    ")",
+                    trial, andCount, countA, countB);
             }
 
-            multiroar *r2 = multiroarDeserialize(buf, written);
-            if (!r2) {
-                ERR("Trial %d: Deserialization failed", trial);
+            /* Test OR: result count >= max(countA, countB) */
+            multiroar *orResult = multiroarNewOr(a, b);
+            uint64_t orCount = multiroarBitCount(orResult);
+            uint64_t maxAB = (countA > countB) ? countA : countB;
+            if (orCount < maxAB) {
+                ERR("Trial %d: OR count %" PRIu64 " < max(%" PRIu64 ",%" PRIu64
+                    ")",
+                    trial, orCount, countA, countB);
             }
 
-            if (!multiroarEquals(r, r2)) {
-                ERR("Trial %d: Round-trip equality failed", trial);
+            /* Test XOR: result count should satisfy |countA - countB| <=
+             * xorCount <= countA + countB */
+            multiroar *xorResult = multiroarNewXor(a, b);
+            uint64_t xorCount = multiroarBitCount(xorResult);
+            uint64_t diffAB =
+                (countA > countB) ? (countA - countB) : (countB - countA);
+            if (xorCount < diffAB || xorCount > countA + countB) {
+                ERR("Trial %d: XOR count %" PRIu64 " out of range [%" PRIu64
+                    ", %" PRIu64 "]",
+                    trial, xorCount, diffAB, countA + countB);
             }
 
-            if (multiroarBitCount(r) != multiroarBitCount(r2)) {
-                ERR("Trial %d: Bitcount mismatch", trial);
+            /* Verify AND + XOR = OR (set theory identity) */
+            /* Actually: |A ∪ B| = |A| + |B| - |A ∩ B|
+             * and: |A △ B| = |A| + |B| - 2|A ∩ B|
+             * So: |A △ B| + |A ∩ B| = |A| + |B| - |A ∩ B|... no
+             * |A △ B| = |A ∪ B| - |A ∩ B|
+             * So: xorCount = orCount - andCount */
+            if (xorCount != orCount - andCount) {
+                ERR("Trial %d: set identity failed: XOR=%" PRIu64
+                    " != OR=%" PRIu64 " - AND=%" PRIu64,
+                    trial, xorCount, orCount, andCount);
             }
 
-            zfree(buf);
-            multiroarFree(r);
-            multiroarFree(r2);
+            multiroarFree(andResult);
+            multiroarFree(orResult);
+            multiroarFree(xorResult);
+            multiroarFree(a);
+            multiroarFree(b);
         }
     }
 
-    printf("\n=== Serialization tests completed! ===\n\n");
+#undef FILL_SPARSE
+#undef FILL_DENSE
+#undef FILL_ALL_ONES
+
+    printf("=== Cross-Container-Type Tests Passed! ===\n\n");
 
     /* ================================================================
-     * CROSS-CONTAINER-TYPE OPERATION TESTS
-     *
-     * Roaring bitmaps use different container types based on density:
-     * - UNDER_FULL: sparse array of positions (< 629 bits)
-     * - FULL_BITMAP: actual 8192-bit bitmap (629-7563 bits)
-     * - OVER_FULL: negative listing (> 7563 bits)
-     * - ALL_1: implicit all-ones (all 8192 bits set)
-     *
-     * These tests verify set operations work correctly when combining
-     * chunks of different container types.
+     * Run Container Tests
+     * ================================================================
+     * Range-built bitmaps use CHUNK_TYPE_RUNS when runs are the smallest
+     * encoding. Results are checked against a plain byte-per-bit oracle.
      * ================================================================ */
 
-    printf("\n=== Cross-Container-Type Operation Tests ===\n\n");
-
-/* Helper to create a chunk with specific container type by population */
-#define FILL_SPARSE(r, chunk, count)                                           \
-    do {                                                                       \
-        uint64_t base = (uint64_t)(chunk) * 8192;                              \
-        for (int i = 0; i < (count); i++) {                                    \
-            multiroarBitSet((r), base + (i * 12));                             \
-        }                                                                      \
-    } while (0)
+    printf("\n=== Run Container Tests ===\n\n");
 
-#define FILL_DENSE(r, chunk, start, end)                                       \
+#define RUN_TEST_BITS (4 * 8192)
+#define RUN_ORACLE_CHECK(r, oracle, what)                                      \
     do {                                                                       \
-        uint64_t base = (uint64_t)(chunk) * 8192;                              \
-        for (int i = (start); i < (end); i++) {                                \
-            multiroarBitSet((r), base + i);                                    \
+        uint64_t expectCount_ = 0;                                             \
+        for (uint64_t p_ = 0; p_ < RUN_TEST_BITS; p_++) {                      \
+            expectCount_ += (oracle)[p_];                                      \
+            if (multiroarBitGet((r), p_) != (bool)(oracle)[p_]) {              \
+                ERR("%s: bit %" PRIu64 " expected %d", (what), p_,             \
+                    (oracle)[p_]);                                             \
+                break;                                                         \
+            }                                                                  \
         }                                                                      \
-    } while (0)
-
-#define FILL_ALL_ONES(r, chunk)                                                \
-    do {                                                                       \
-        uint64_t base = (uint64_t)(chunk) * 8192;                              \
-        for (int i = 0; i < 8192; i++) {                                       \
-            multiroarBitSet((r), base + i);                                    \
+        if (multiroarBitCount((r)) != expectCount_) {                          \
+            ERR("%s: count %" PRIu64 " expected %" PRIu64, (what),             \
+                multiroarBitCount((r)), expectCount_);                         \
         }                                                                      \
     } while (0)
 
-    TEST("AND: UNDER_FULL x UNDER_FULL (same chunk)") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("RUNS: many short ranges stay run-encoded") {
+        multiroar *r = multiroarBitNew();
 
-        /* Create sparse chunks (< 629 positions) */
-        FILL_SPARSE(a, 0, 100); /* Positions 0, 12, 24, ... */
-        FILL_SPARSE(b, 0, 50);  /* Overlaps first 50 positions of a */
+        /* 100 ranges of 20 bits would be 2000 bits -> FULL_BITMAP */
+        for (uint64_t i = 0; i < 100; i++) {
+            multiroarBitSetRange(r, i * 80, 20);
+        }
 
-        multiroar *result = multiroarNewAnd(a, b);
+        if (multiroarTestChunkType(r, 0) != CHUNK_TYPE_RUNS) {
+            ERR("Expected RUNS chunk, got type %d",
+                multiroarTestChunkType(r, 0));
+        }
 
-        /* Result should have 50 bits (the overlap) */
-        uint64_t countResult = multiroarBitCount(result);
-        if (countResult != 50) {
-            ERR("UNDER_FULL x UNDER_FULL: expected 50, got %" PRIu64,
-                countResult);
+        if (multiroarBitCount(r) != 2000) {
+            ERR("Expected 2000 bits, got %" PRIu64, multiroarBitCount(r));
         }
 
-        /* Verify specific bits */
-        for (int i = 0; i < 50; i++) {
-            if (!multiroarBitGet(result, i * 12)) {
-                ERR("Missing bit at position %d", i * 12);
-            }
+        if (multiroarMemoryUsage(r) >= BITMAP_SIZE_IN_BYTES) {
+            ERR("Run chunk uses %" PRIu64 " bytes", multiroarMemoryUsage(r));
         }
-        for (int i = 50; i < 100; i++) {
-            if (multiroarBitGet(result, i * 12)) {
-                ERR("Unexpected bit at position %d", i * 12);
+
+        for (uint64_t i = 0; i < 8000; i++) {
+            if (multiroarBitGet(r, i) != ((i % 80) < 20)) {
+                ERR("Bit %" PRIu64 " wrong", i);
+                break;
             }
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(result);
+        multiroarFree(r);
     }
 
-    TEST("AND: FULL_BITMAP x FULL_BITMAP") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
-
-        /* Create bitmap chunks (> 629 positions, contiguous) */
-        FILL_DENSE(a, 0, 0, 4096);    /* First half of chunk */
-        FILL_DENSE(b, 0, 2048, 6144); /* Middle portion, overlaps [2048,4096) */
-
-        multiroar *result = multiroarNewAnd(a, b);
-
-        /* Result should have 2048 bits (the overlap [2048, 4096)) */
-        uint64_t countResult = multiroarBitCount(result);
-        if (countResult != 2048) {
-            ERR("FULL_BITMAP x FULL_BITMAP: expected 2048, got %" PRIu64,
-                countResult);
-        }
+    TEST("RUNS: range spanning chunks uses ALL_1 for whole chunks") {
+        multiroar *r = multiroarBitNew();
+        multiroarBitSetRange(r, 100, (3 * 8192) + 50 - 100);
 
-        /* Verify boundaries */
-        if (multiroarBitGet(result, 2047)) {
-            ERRR("Bit 2047 should NOT be set");
-        }
-        if (!multiroarBitGet(result, 2048)) {
-            ERRR("Bit 2048 should be set");
-        }
-        if (!multiroarBitGet(result, 4095)) {
-            ERRR("Bit 4095 should be set");
+        if (multiroarTestChunkType(r, 0) != CHUNK_TYPE_RUNS ||
+            multiroarTestChunkType(r, 1) != CHUNK_TYPE_ALL_1 ||
+            multiroarTestChunkType(r, 2) != CHUNK_TYPE_ALL_1 ||
+            multiroarTestChunkType(r, 3) != CHUNK_TYPE_RUNS) {
+            ERRR("Unexpected chunk types for spanning range");
         }
-        if (multiroarBitGet(result, 4096)) {
-            ERRR("Bit 4096 should NOT be set");
-        }
-
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(result);
-    }
 
-    TEST("AND: UNDER_FULL x FULL_BITMAP") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
-
-        /* a: sparse (100 positions spread out) */
-        FILL_SPARSE(a, 0, 100);
-        /* b: dense bitmap covering first 2000 positions */
-        FILL_DENSE(b, 0, 0, 2000);
+        if (multiroarBitCount(r) != (3 * 8192) + 50 - 100) {
+            ERR("Wrong count %" PRIu64, multiroarBitCount(r));
+        }
 
-        multiroar *result = multiroarNewAnd(a, b);
+        uint64_t pos;
+        if (!multiroarMin(r, &pos) || pos != 100) {
+            ERRR("Wrong min");
+        }
 
-        /* Positions 0,12,24,...,1188 (i*12 where i*12 < 2000) are in both
-         * 1188 / 12 = 99 positions, but we need i*12 < 2000
-         * Max i where i*12 < 2000: i < 166.67, so i <= 166
-         * But we only filled 100 sparse positions, so all 100 should match */
-        uint64_t countResult = multiroarBitCount(result);
-        if (countResult != 100) {
-            ERR("UNDER_FULL x FULL_BITMAP: expected 100, got %" PRIu64,
-                countResult);
+        if (!multiroarMax(r, &pos) || pos != (3 * 8192) + 49) {
+            ERRR("Wrong max");
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(result);
+        multiroarFree(r);
     }
 
-    TEST("AND: FULL_BITMAP x OVER_FULL (negative listing)") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("RUNS: BitSet/Remove merge and split runs") {
+        multiroar *r = multiroarBitNew();
+        multiroarBitSetRange(r, 100, 50); /* [100, 149] */
+        multiroarBitSetRange(r, 151, 50); /* [151, 200] */
 
-        /* a: bitmap covering [0, 4096) */
-        FILL_DENSE(a, 0, 0, 4096);
+        if (!multiroarBitSet(r, 120)) {
+            ERRR("Bit 120 should report previously set");
+        }
 
-        /* b: negative listing - almost all bits set (> 7563) */
-        FILL_ALL_ONES(b, 0);
-        /* Clear just a few bits to verify difference */
-        multiroarRemove(b, 100);
-        multiroarRemove(b, 200);
-        multiroarRemove(b, 300);
+        /* Join the two runs */
+        if (multiroarBitSet(r, 150)) {
+            ERRR("Bit 150 should not have been set");
+        }
 
-        multiroar *result = multiroarNewAnd(a, b);
+        if (multiroarTestChunkType(r, 0) != CHUNK_TYPE_RUNS ||
+            multiroarBitCount(r) != 101) {
+            ERRR("Join failed");
+        }
 
-        /* Should have 4096 - 3 bits (the ones we cleared in b) */
-        uint64_t countResult = multiroarBitCount(result);
-        if (countResult != 4093) {
-            ERR("FULL_BITMAP x OVER_FULL: expected 4093, got %" PRIu64,
-                countResult);
+        /* Split the joined run */
+        if (!multiroarRemove(r, 175)) {
+            ERRR("Bit 175 should have been set");
         }
 
-        /* Verify the cleared bits are not set */
-        if (multiroarBitGet(result, 100)) {
-            ERRR("Bit 100 should NOT be set");
+        if (multiroarRemove(r, 175)) {
+            ERRR("Bit 175 should now be clear");
         }
-        if (multiroarBitGet(result, 200)) {
-            ERRR("Bit 200 should NOT be set");
+
+        if (multiroarBitCount(r) != 100 || multiroarBitGet(r, 175) ||
+            !multiroarBitGet(r, 174) || !multiroarBitGet(r, 176)) {
+            ERRR("Split failed");
         }
-        if (multiroarBitGet(result, 300)) {
-            ERRR("Bit 300 should NOT be set");
+
+        /* Clearing everything removes the chunk */
+        multiroarBitClearRange(r, 0, 8192);
+        if (!multiroarIsEmpty(r)) {
+            ERRR("Chunk should be gone after clearing");
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(result);
+        multiroarFree(r);
     }
 
-    TEST("AND: ALL_1 x UNDER_FULL") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
-
-        /* a: all ones */
-        FILL_ALL_ONES(a, 0);
-        /* b: sparse */
-        FILL_SPARSE(b, 0, 200);
+    TEST("RUNS: too many runs falls back to positional encoding") {
+        multiroar *r = multiroarBitNew();
 
-        multiroar *result = multiroarNewAnd(a, b);
+        /* 300 runs of 2 bits can't beat a sparse list (600 positions) */
+        for (uint64_t i = 0; i < 300; i++) {
+            multiroarBitSetRange(r, i * 20, 2);
+        }
 
-        /* Result should equal b */
-        uint64_t countResult = multiroarBitCount(result);
-        if (countResult != 200) {
-            ERR("ALL_1 x UNDER_FULL: expected 200, got %" PRIu64, countResult);
+        if (multiroarTestChunkType(r, 0) == CHUNK_TYPE_RUNS) {
+            ERRR("Expected positional encoding for many tiny runs");
         }
 
-        if (!multiroarEquals(result, b)) {
-            ERRR("ALL_1 AND sparse should equal sparse");
+        if (multiroarBitCount(r) != 600) {
+            ERR("Expected 600 bits, got %" PRIu64, multiroarBitCount(r));
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(result);
+        multiroarFree(r);
     }
 
-    TEST("OR: UNDER_FULL x FULL_BITMAP") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("RUNS: AND/OR/XOR/ANDNOT against oracle") {
+        uint64_t seed[2] = {0x52554E5352554E53ULL, 0x0123456789ABCDEFULL};
+        uint8_t *oracleA = zcalloc(RUN_TEST_BITS, 1);
+        uint8_t *oracleB = zcalloc(RUN_TEST_BITS, 1);
+        uint8_t *expect = zcalloc(RUN_TEST_BITS, 1);
 
-        /* a: sparse in chunk 0, positions 0,12,24,...,1188 */
-        FILL_SPARSE(a, 0, 100);
-        /* b: dense in chunk 0, positions [2000, 4000) */
-        FILL_DENSE(b, 0, 2000, 4000);
+        for (int trial = 0; trial < 12; trial++) {
+            multiroar *a = multiroarBitNew();
+            multiroar *b = multiroarBitNew();
+            memset(oracleA, 0, RUN_TEST_BITS);
+            memset(oracleB, 0, RUN_TEST_BITS);
+
+            for (int side = 0; side < 2; side++) {
+                multiroar *r = side ? b : a;
+                uint8_t *oracle = side ? oracleB : oracleA;
+                const int ranges = 5 + (xoroshiro128plus(seed) % 150);
+                for (int i = 0; i < ranges; i++) {
+                    const uint64_t start =
+                        xoroshiro128plus(seed) % RUN_TEST_BITS;
+                    uint64_t extent = 1 + (xoroshiro128plus(seed) % 300);
+                    if (start + extent > RUN_TEST_BITS) {
+                        extent = RUN_TEST_BITS - start;
+                    }
 
-        multiroar *result = multiroarNewOr(a, b);
+                    multiroarBitSetRange(r, start, extent);
+                    memset(oracle + start, 1, extent);
+                }
 
-        /* Result should have 100 + 2000 = 2100 bits (no overlap) */
-        uint64_t countResult = multiroarBitCount(result);
-        if (countResult != 2100) {
-            ERR("OR UNDER_FULL x FULL_BITMAP: expected 2100, got %" PRIu64,
-                countResult);
+                /* Every third trial mixes in single bits so some chunks
+                 * are positional rather than runs. */
+                if (trial % 3 == 0) {
+                    for (int i = 0; i < 400; i++) {
+                        const uint64_t p =
+                            xoroshiro128plus(seed) % RUN_TEST_BITS;
+                        multiroarBitSet(r, p);
+                        oracle[p] = 1;
+                    }
+                }
+            }
+
+            RUN_ORACLE_CHECK(a, oracleA, "input A");
+            RUN_ORACLE_CHECK(b, oracleB, "input B");
+
+            multiroar *andR = multiroarNewAnd(a, b);
+            for (uint64_t p = 0; p < RUN_TEST_BITS; p++) {
+                expect[p] = oracleA[p] & oracleB[p];
+            }
+            RUN_ORACLE_CHECK(andR, expect, "AND");
+
+            multiroar *orR = multiroarNewOr(a, b);
+            for (uint64_t p = 0; p < RUN_TEST_BITS; p++) {
+                expect[p] = oracleA[p] | oracleB[p];
+            }
+            RUN_ORACLE_CHECK(orR, expect, "OR");
+
+            multiroar *xorR = multiroarNewXor(a, b);
+            for (uint64_t p = 0; p < RUN_TEST_BITS; p++) {
+                expect[p] = oracleA[p] ^ oracleB[p];
+            }
+            RUN_ORACLE_CHECK(xorR, expect, "XOR");
+
+            multiroar *andNotR = multiroarNewAndNot(a, b);
+            for (uint64_t p = 0; p < RUN_TEST_BITS; p++) {
+                expect[p] = oracleA[p] & !oracleB[p];
+            }
+            RUN_ORACLE_CHECK(andNotR, expect, "ANDNOT");
+
+            multiroarFree(andR);
+            multiroarFree(orR);
+            multiroarFree(xorR);
+            multiroarFree(andNotR);
+            multiroarFree(a);
+            multiroarFree(b);
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(result);
+        zfree(oracleA);
+        zfree(oracleB);
+        zfree(expect);
     }
 
-    TEST("OR: UNDER_FULL x OVER_FULL across different chunks") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("RUNS: clear and flip ranges against oracle") {
+        uint8_t *oracle = zcalloc(RUN_TEST_BITS, 1);
+        multiroar *r = multiroarBitNew();
 
-        /* a: sparse in chunk 0 */
-        FILL_SPARSE(a, 0, 100);
-        /* b: negative listing in chunk 1 (almost all ones) */
-        FILL_ALL_ONES(b, 1);
-        multiroarRemove(b, 8192 + 50);
+        multiroarBitSetRange(r, 1000, 20000);
+        memset(oracle + 1000, 1, 20000);
 
-        multiroar *result = multiroarNewOr(a, b);
+        multiroarBitClearRange(r, 5000, 100);
+        memset(oracle + 5000, 0, 100);
 
-        /* Result: 100 bits in chunk 0, 8191 bits in chunk 1 */
-        uint64_t countResult = multiroarBitCount(result);
-        if (countResult != 100 + 8191) {
-            ERR("OR across chunks: expected %d, got %" PRIu64, 100 + 8191,
-                countResult);
+        multiroarBitFlipRange(r, 20000, 5000);
+        for (uint64_t p = 20000; p < 25000; p++) {
+            oracle[p] = !oracle[p];
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(result);
+        RUN_ORACLE_CHECK(r, oracle, "clear/flip");
+
+        multiroarFree(r);
+        zfree(oracle);
     }
 
-    TEST("XOR: FULL_BITMAP x FULL_BITMAP (partial overlap)") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("RUNS: Rank/Select/iteration") {
+        multiroar *r = multiroarBitNew();
+        uint8_t *oracle = zcalloc(RUN_TEST_BITS, 1);
 
-        /* a: [0, 3000) */
-        FILL_DENSE(a, 0, 0, 3000);
-        /* b: [2000, 5000) */
-        FILL_DENSE(b, 0, 2000, 5000);
+        for (uint64_t i = 0; i < 60; i++) {
+            const uint64_t start = (i * 431) % (RUN_TEST_BITS - 64);
+            multiroarBitSetRange(r, start, 1 + (i % 40));
+            memset(oracle + start, 1, 1 + (i % 40));
+        }
 
-        multiroar *result = multiroarNewXor(a, b);
+        uint64_t rank = 0;
+        uint64_t k = 0;
+        multiroarIterator iter;
+        multiroarIteratorInit(r, &iter);
+        for (uint64_t p = 0; p < RUN_TEST_BITS; p++) {
+            if (multiroarRank(r, p) != rank) {
+                ERR("Rank(%" PRIu64 ") = %" PRIu64 ", expected %" PRIu64, p,
+                    multiroarRank(r, p), rank);
+                break;
+            }
 
-        /* XOR: [0,2000) + [3000,5000) = 2000 + 2000 = 4000 */
-        uint64_t countResult = multiroarBitCount(result);
-        if (countResult != 4000) {
-            ERR("XOR FULL_BITMAP x FULL_BITMAP: expected 4000, got %" PRIu64,
-                countResult);
+            if (oracle[p]) {
+                rank++;
+                k++;
+
+                uint64_t selected;
+                if (!multiroarSelect(r, k, &selected) || selected != p) {
+                    ERR("Select(%" PRIu64 ") != %" PRIu64, k, p);
+                    break;
+                }
+
+                uint64_t next;
+                if (!multiroarIteratorNext(&iter, &next) || next != p) {
+                    ERR("Iterator expected %" PRIu64, p);
+                    break;
+                }
+            }
         }
 
-        /* Verify boundaries */
-        if (!multiroarBitGet(result, 1999)) {
-            ERRR("Bit 1999 should be set (in a only)");
+        uint64_t extra;
+        if (multiroarIteratorNext(&iter, &extra)) {
+            ERR("Iterator returned extra position %" PRIu64, extra);
         }
-        if (multiroarBitGet(result, 2000)) {
-            ERRR("Bit 2000 should NOT be set (in both)");
+
+        multiroarFree(r);
+        zfree(oracle);
+    }
+
+    TEST("RUNS: serialization round-trip keeps runs") {
+        multiroar *r = multiroarBitNew();
+        for (uint64_t i = 0; i < 50; i++) {
+            multiroarBitSetRange(r, (i * 300) + 7, 100);
         }
-        if (multiroarBitGet(result, 2999)) {
-            ERRR("Bit 2999 should NOT be set (in both)");
+
+        multiroarBitSetRange(r, 5 * 8192, 8192); /* ALL_1 chunk */
+
+        const uint64_t size = multiroarSerializedSize(r);
+        void *buf = zcalloc(size, 1);
+        const uint64_t written = multiroarSerialize(r, buf, size);
+        if (written != size) {
+            ERR("Serialized %" PRIu64 " bytes, expected %" PRIu64, written,
+                size);
         }
-        if (!multiroarBitGet(result, 3000)) {
-            ERRR("Bit 3000 should be set (in b only)");
+
+        /* 3 run chunks + ALL_1 must be far below bitmap encoding */
+        if (size >= 2 * BITMAP_SIZE_IN_BYTES) {
+            ERR("Serialized size too large: %" PRIu64, size);
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(result);
+        multiroar *r2 = multiroarDeserialize(buf, written);
+        if (!r2) {
+            ERRR("Failed to deserialize runs");
+        } else {
+            if (!multiroarEquals(r, r2)) {
+                ERRR("Deserialized runs don't match");
+            }
+
+            if (multiroarTestChunkType(r2, 0) != CHUNK_TYPE_RUNS) {
+                ERRR("Deserialized chunk not RUNS");
+            }
+
+            multiroarFree(r2);
+        }
+
+        /* Truncated buffers must be rejected */
+        multiroar *bad = multiroarDeserialize(buf, written - 1);
+        if (bad) {
+            ERRR("Truncated buffer deserialized");
+            multiroarFree(bad);
+        }
+
+        zfree(buf);
+        multiroarFree(r);
     }
 
-    TEST("XOR: ALL_1 x FULL_BITMAP") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+    TEST("RUNS: RunOptimize converts bit-by-bit clustered data") {
+        multiroar *r = multiroarBitNew();
+        for (uint64_t i = 0; i < 4000; i++) {
+            multiroarBitSet(r, 100 + i);
+        }
 
-        /* a: all ones in chunk 0 */
-        FILL_ALL_ONES(a, 0);
-        /* b: [0, 4096) in chunk 0 */
-        FILL_DENSE(b, 0, 0, 4096);
+        if (multiroarTestChunkType(r, 0) != CHUNK_TYPE_FULL_BITMAP) {
+            ERRR("Expected FULL_BITMAP before optimizing");
+        }
 
-        multiroar *result = multiroarNewXor(a, b);
+        multiroar *before = multiroarDuplicate(r);
+        if (multiroarRunOptimize(r) != 1) {
+            ERRR("Expected one chunk converted");
+        }
 
-        /* XOR: bits [4096, 8192) should be set (8192 - 4096 = 4096 bits) */
-        uint64_t countResult = multiroarBitCount(result);
-        if (countResult != 4096) {
-            ERR("XOR ALL_1 x FULL_BITMAP: expected 4096, got %" PRIu64,
-                countResult);
+        if (multiroarTestChunkType(r, 0) != CHUNK_TYPE_RUNS) {
+            ERRR("Expected RUNS after optimizing");
         }
 
-        if (multiroarBitGet(result, 4095)) {
-            ERRR("Bit 4095 should NOT be set");
+        if (!multiroarEquals(r, before)) {
+            ERRR("RunOptimize changed contents");
         }
-        if (!multiroarBitGet(result, 4096)) {
-            ERRR("Bit 4096 should be set");
+
+        if (multiroarRunOptimize(r) != 0) {
+            ERRR("Second RunOptimize should be a no-op");
         }
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(result);
+        multiroarFree(before);
+        multiroarFree(r);
+    }
+
+#undef RUN_ORACLE_CHECK
+#undef RUN_TEST_BITS
+
+    printf("=== Run Container Tests Passed! ===\n\n");
+
+    /* ================================================================
+     * Heap-Driven N-way Tests
+     * ================================================================ */
+
+    printf("\n=== N-way Aggregation Tests ===\n\n");
+
+    TEST("N-way: heap OR/XOR/AND match pairwise fold (mixed containers)") {
+        uint64_t seed[2] = {0x4E5741594E574159ULL, 0x1122334455667788ULL};
+
+        for (int trial = 0; trial < 10; trial++) {
+            const uint64_t n = 2 + (xoroshiro128plus(seed) % 12);
+            multiroar *roars[16];
+
+            for (uint64_t i = 0; i < n; i++) {
+                roars[i] = multiroarBitNew();
+                for (uint64_t chunk = 0; chunk < 6; chunk++) {
+                    const uint64_t base = chunk * 8192;
+                    switch (xoroshiro128plus(seed) % 5) {
+                    case 0: /* empty */
+                        break;
+                    case 1: /* sparse */
+                        for (int k = 0; k < 200; k++) {
+                            multiroarBitSet(roars[i],
+                                            base + (xoroshiro128plus(seed) %
+                                                    8192));
+                        }
+                        break;
+                    case 2: /* runs */
+                        for (int k = 0; k < 20; k++) {
+                            multiroarBitSetRange(
+                                roars[i],
+                                base + (xoroshiro128plus(seed) % 8000),
+                                1 + (xoroshiro128plus(seed) % 190));
+                        }
+                        break;
+                    case 3: /* bitmap */
+                        for (int k = 0; k < 3000; k++) {
+                            multiroarBitSet(roars[i],
+                                            base + (xoroshiro128plus(seed) %
+                                                    8192));
+                        }
+                        break;
+                    case 4: /* full */
+                        multiroarBitSetRange(roars[i], base, 8192);
+                        break;
+                    }
+                }
+            }
+
+            /* Same input twice must not confuse the heap walk */
+            roars[n] = roars[0];
+
+            multiroar *pairOr = multiroarDuplicate(roars[0]);
+            multiroar *pairXor = multiroarDuplicate(roars[0]);
+            multiroar *pairAnd = multiroarDuplicate(roars[0]);
+            for (uint64_t i = 1; i <= n; i++) {
+                multiroarOr(pairOr, roars[i]);
+                multiroarXor(pairXor, roars[i]);
+                multiroarAnd(pairAnd, roars[i]);
+            }
+
+            multiroar *nwayOr = multiroarNewOrN(n + 1, roars);
+            multiroar *nwayXor = multiroarNewXorN(n + 1, roars);
+            multiroar *nwayAnd = multiroarNewAndN(n + 1, roars);
+
+            if (!multiroarEquals(pairOr, nwayOr)) {
+                ERR("Trial %d: OR mismatch", trial);
+            }
+
+            if (!multiroarEquals(pairXor, nwayXor)) {
+                ERR("Trial %d: XOR mismatch", trial);
+            }
+
+            if (!multiroarEquals(pairAnd, nwayAnd)) {
+                ERR("Trial %d: AND mismatch", trial);
+            }
+
+            multiroarFree(pairOr);
+            multiroarFree(pairXor);
+            multiroarFree(pairAnd);
+            multiroarFree(nwayOr);
+            multiroarFree(nwayXor);
+            multiroarFree(nwayAnd);
+            for (uint64_t i = 0; i < n; i++) {
+                multiroarFree(roars[i]);
+            }
+        }
     }
 
-    TEST("ANDNOT: FULL_BITMAP - UNDER_FULL") {
+    TEST("N-way: in-place OrN/AndN where roars[0] is also a later input") {
         multiroar *a = multiroarBitNew();
         multiroar *b = multiroarBitNew();
+        multiroarBitSetRange(a, 0, 20000);
+        multiroarBitSetRange(b, 10000, 20000);
 
-        /* a: dense [0, 2000) */
-        FILL_DENSE(a, 0, 0, 2000);
-        /* b: sparse at 0,12,24,...,588 (50 positions) */
-        FILL_SPARSE(b, 0, 50);
-
-        multiroar *result = multiroarNewAndNot(a, b);
-
-        /* Result: 2000 - 50 = 1950 bits */
-        uint64_t countResult = multiroarBitCount(result);
-        if (countResult != 1950) {
-            ERR("ANDNOT FULL_BITMAP - UNDER_FULL: expected 1950, got %" PRIu64,
-                countResult);
+        multiroar *orInputs[] = {a, b, a};
+        multiroarOrN(3, orInputs);
+        if (multiroarBitCount(a) != 30000) {
+            ERR("OrN count %" PRIu64, multiroarBitCount(a));
         }
 
-        /* Verify removed bits */
-        for (int i = 0; i < 50; i++) {
-            if (multiroarBitGet(result, i * 12)) {
-                ERR("Bit %d should be removed", i * 12);
-            }
+        multiroar *andInputs[] = {a, b, a};
+        multiroarAndN(3, andInputs);
+        if (multiroarBitCount(a) != 20000) {
+            ERR("AndN count %" PRIu64, multiroarBitCount(a));
         }
 
         multiroarFree(a);
         multiroarFree(b);
-        multiroarFree(result);
     }
 
-    TEST("ANDNOT: OVER_FULL - FULL_BITMAP") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
-
-        /* a: almost all ones (negative listing) */
-        FILL_ALL_ONES(a, 0);
-        multiroarRemove(a, 100); /* 8191 bits set */
+    TEST("PERF: N-way heap aggregation vs pairwise fold") {
+        uint64_t seed[2] = {0x5045524650455246ULL, 0x0F0E0D0C0B0A0908ULL};
+        const uint64_t inputCounts[] = {10, 100, 1000};
 
-        /* b: dense [0, 4096) */
-        FILL_DENSE(b, 0, 0, 4096);
+        for (size_t c = 0; c < sizeof(inputCounts) / sizeof(*inputCounts);
+             c++) {
+            const uint64_t n = inputCounts[c];
+            multiroar **roars = zmalloc(n * sizeof(*roars));
 
-        multiroar *result = multiroarNewAndNot(a, b);
+            /* Postings-list shape: a shared dense prefix (so AND has a
+             * result) plus scattered ids across 64 chunks. */
+            for (uint64_t i = 0; i < n; i++) {
+                roars[i] = multiroarBitNew();
+                multiroarBitSetRange(roars[i], 0, 12000);
+                for (int k = 0; k < 200; k++) {
+                    multiroarBitSet(roars[i],
+                                    xoroshiro128plus(seed) % (64 * 8192));
+                }
+            }
 
-        /* Result: bits in a not in b = [4096, 8192) minus bit 100 wasn't in a
-         * But bit 100 is in [0,4096) so it's removed by ANDNOT anyway
-         * a has all except 100, b has [0,4096)
-         * a - b = [4096, 8192) = 4096 bits */
-        uint64_t countResult = multiroarBitCount(result);
-        if (countResult != 4096) {
-            ERR("ANDNOT OVER_FULL - FULL_BITMAP: expected 4096, got %" PRIu64,
-                countResult);
-        }
+            int64_t startNs = timeUtilMonotonicNs();
+            multiroar *pairOr = multiroarDuplicate(roars[0]);
+            for (uint64_t i = 1; i < n; i++) {
+                multiroarOr(pairOr, roars[i]);
+            }
+            const int64_t pairOrNs = timeUtilMonotonicNs() - startNs;
 
-        multiroarFree(a);
-        multiroarFree(b);
-        multiroarFree(result);
-    }
+            startNs = timeUtilMonotonicNs();
+            multiroar *nwayOr = multiroarNewOrN(n, roars);
+            const int64_t nwayOrNs = timeUtilMonotonicNs() - startNs;
 
-    TEST("Complex: mixed container types across multiple chunks") {
-        multiroar *a = multiroarBitNew();
-        multiroar *b = multiroarBitNew();
+            startNs = timeUtilMonotonicNs();
+            multiroar *pairAnd = multiroarDuplicate(roars[0]);
+            for (uint64_t i = 1; i < n; i++) {
+                multiroarAnd(pairAnd, roars[i]);
+            }
+            const int64_t pairAndNs = timeUtilMonotonicNs() - startNs;
 
-        /* Chunk 0: a=sparse, b=bitmap */
-        FILL_SPARSE(a, 0, 100);
-        FILL_DENSE(b, 0, 0, 1000);
+            startNs = timeUtilMonotonicNs();
+            multiroar *nwayAnd = multiroarNewAndN(n, roars);
+            const int64_t nwayAndNs = timeUtilMonotonicNs() - startNs;
 
-        /* Chunk 1: a=bitmap, b=sparse */
-        FILL_DENSE(a, 1, 0, 2000);
-        FILL_SPARSE(b, 1, 150);
+            if (!multiroarEquals(pairOr, nwayOr) ||
+                !multiroarEquals(pairAnd, nwayAnd)) {
+                ERR("N-way result mismatch at %" PRIu64 " inputs", n);
+            }
 
-        /* Chunk 2: a=all_ones, b=over_full */
-        FILL_ALL_ONES(a, 2);
-        FILL_ALL_ONES(b, 2);
-        multiroarRemove(b, 2 * 8192 + 500);
+            printf("%4" PRIu64 " inputs: OR pairwise %8.3f ms, heap %8.3f ms "
+                   "(%.1fx); AND pairwise %8.3f ms, heap %8.3f ms (%.1fx)\n",
+                   n, pairOrNs / 1e6, nwayOrNs / 1e6,
+                   (double)pairOrNs / (nwayOrNs ? nwayOrNs : 1),
+                   pairAndNs / 1e6, nwayAndNs / 1e6,
+                   (double)pairAndNs / (nwayAndNs ? nwayAndNs : 1));
 
-        /* Chunk 3: a=empty, b=bitmap */
-        FILL_DENSE(b, 3, 1000, 3000);
+            multiroarFree(pairOr);
+            multiroarFree(nwayOr);
+            multiroarFree(pairAnd);
+            multiroarFree(nwayAnd);
+            for (uint64_t i = 0; i < n; i++) {
+                multiroarFree(roars[i]);
+            }
+            zfree(roars);
+        }
+    }
 
-        /* Chunk 4: a=over_full, b=empty */
-        FILL_ALL_ONES(a, 4);
-        multiroarRemove(a, 4 * 8192 + 100);
+    printf("=== N-way Aggregation Tests Passed! ===\n\n");
 
-        /* Test AND */
-        multiroar *andResult = multiroarNewAnd(a, b);
-        /* Chunk 0: sparse 100 positions at i*12, dense [0,1000)
-         *          i*12 < 1000 for i < 83.33, so 84 positions match (i=0..83)
-         */
-        /* Chunk 1: dense [0,2000), sparse 150 positions at i*12
-         *          i*12 < 2000 for i < 167, we have 150 positions, all match */
-        /* Chunk 2: 8192 AND (8192-1) = 8191 */
-        /* Chunk 3: empty AND bitmap = empty */
-        /* Chunk 4: over_full AND empty = empty */
-        uint64_t expectedAnd = 84 + 150 + 8191;
+    TEST("Chunk cursor/store and AndCount match bit-level ops") {
+        uint64_t seed[2] = {0x43484E4B43555253ULL, 0x5A5A5A5A12345678ULL};
+        multiroar *a = multiroarTestFrozenSource(seed);
+        multiroar *b = multiroarTestFrozenSource(seed);
 
-        if (multiroarBitCount(andResult) != expectedAnd) {
-            ERR("Complex AND: expected %" PRIu64 ", got %" PRIu64, expectedAnd,
-                multiroarBitCount(andResult));
+        multiroar *expect = multiroarNewAnd(a, b);
+        if (multiroarAndCount(a, b) != multiroarBitCount(expect)) {
+            ERR("AndCount %" PRIu64 " != %" PRIu64, multiroarAndCount(a, b),
+                multiroarBitCount(expect));
         }
-        multiroarFree(andResult);
 
-        /* Test OR */
-        multiroar *orResult = multiroarNewOr(a, b);
-        /* Chunk 0: 100 sparse + 1000 dense with overlap */
-        /* Chunk 1: 2000 dense + 150 sparse with overlap */
-        /* Chunk 2: all_ones OR (all-1) = all_ones = 8192 */
-        /* Chunk 3: empty + 2000 = 2000 */
-        /* Chunk 4: 8191 + 0 = 8191 */
+        /* Rebuild a AND b chunk by chunk through the public chunk API */
+        multiroar *rebuilt = multiroarBitNew();
+        multiroarChunkCursor ca;
+        multiroarChunkCursor cb;
+        multiroarChunkCursorInit(a, &ca);
+        multiroarChunkCursorInit(b, &cb);
+        uint8_t bitmapA[MULTIROAR_CHUNK_BYTES];
+        uint8_t bitmapB[MULTIROAR_CHUNK_BYTES];
+        uint64_t chunkId;
+        while (multiroarChunkCursorNext(&ca, &chunkId, bitmapA)) {
+            if (multiroarChunkCursorSeek(&cb, chunkId, bitmapB)) {
+                for (uint32_t i = 0; i < MULTIROAR_CHUNK_BYTES; i++) {
+                    bitmapA[i] &= bitmapB[i];
+                }
 
-        /* Chunk 0: positions 0,12,24,...1188 (100) union [0,1000)
-         *          The sparse positions i*12 for i<84 are in [0,1000)
-         *          So union is [0,1000) + positions 1008,1020,...,1188 = 16
-         * more = 1000 + (100-84) = 1016 */
-        /* Chunk 1: [0,2000) union positions i*12 for i in [0,150)
-         *          i*12 < 2000 for i < 167, so all 150 in [0,2000)
-         *          = 2000 (no additional) */
-        /* So OR = 1016 + 2000 + 8192 + 2000 + 8191 = 21399 */
-        /* Actually let me recalculate chunk 0:
-         * sparse has i*12 for i in [0,100), so max is 99*12 = 1188
-         * dense has [0,1000)
-         * overlap: i*12 < 1000 for i < 83.33, so i <= 83 -> positions
-         * 0,12,...996 union: 1000 + (100 - 84) = 1000 + 16 = 1016 */
+                multiroarChunkStore(rebuilt, chunkId, bitmapA);
+            }
+        }
 
-        uint64_t expectedOr = 1016 + 2000 + 8192 + 2000 + 8191;
-        if (multiroarBitCount(orResult) != expectedOr) {
-            ERR("Complex OR: expected %" PRIu64 ", got %" PRIu64, expectedOr,
-                multiroarBitCount(orResult));
+        if (!multiroarEquals(rebuilt, expect)) {
+            ERRR("Chunk-level AND differs from multiroarNewAnd");
+        }
+
+        /* Storing an empty bitmap removes the chunk */
+        memset(bitmapA, 0, sizeof(bitmapA));
+        multiroarChunkStore(rebuilt, 0, bitmapA);
+        if (multiroarTestChunkType(rebuilt, 0) != CHUNK_TYPE_ALL_0) {
+            ERRR("Empty chunk store left a chunk behind");
         }
-        multiroarFree(orResult);
 
+        multiroarFree(rebuilt);
+        multiroarFree(expect);
         multiroarFree(a);
         multiroarFree(b);
     }
 
-    TEST("FUZZ: random cross-container operations") {
-        uint64_t seed[2] = {0xDEADBEEF12345678ULL, 0x8765432100000001ULL};
+    printf("\n=== Frozen Format Tests ===\n\n");
 
-        for (int trial = 0; trial < 20; trial++) {
-            multiroar *a = multiroarBitNew();
-            multiroar *b = multiroarBitNew();
+    TEST("FROZEN: queries read in place match the source roar") {
+        uint64_t seed[2] = {0x46524F5A454E3031ULL, 0x0F1E2D3C4B5A6978ULL};
+        multiroar *r = multiroarTestFrozenSource(seed);
 
-            /* Randomly fill chunks with different densities */
-            for (int chunk = 0; chunk < 4; chunk++) {
-                uint64_t base = chunk * 8192ULL;
-                uint64_t densityA = xoroshiro128plus(seed) % 100;
-                uint64_t densityB = xoroshiro128plus(seed) % 100;
+        bool seen[CHUNK_TYPE_RUNS + 1] = {false};
+        multimapIterator mi;
+        multimapIteratorInit(r->map, &mi, true);
+        databox kv[2];
+        databox *kvp[2] = {&kv[0], &kv[1]};
+        while (multimapIteratorNext(&mi, kvp)) {
+            if (GET_CHUNK_TYPE(&kv[1]) <= CHUNK_TYPE_RUNS) {
+                seen[GET_CHUNK_TYPE(&kv[1])] = true;
+            }
+        }
 
-                /* 0-20%: empty, 20-40%: sparse, 40-80%: bitmap, 80-100%: dense
-                 */
-                if (densityA >= 20) {
-                    int count = (densityA < 40)   ? 50 + (densityA % 100)
-                                : (densityA < 80) ? 1000 + (densityA % 2000)
-                                                  : 7500 + (densityA % 692);
-                    for (int i = 0; i < count; i++) {
-                        multiroarBitSet(a,
-                                        base + (xoroshiro128plus(seed) % 8192));
+        for (uint32_t t = CHUNK_TYPE_ALL_1; t <= CHUNK_TYPE_RUNS; t++) {
+            if (!seen[t]) {
+                ERR("Source roar lacks chunk type %u", t);
+            }
+        }
+
+        const uint64_t size = multiroarFrozenSize(r);
+        uint8_t *buf = zcalloc(size, 1);
+        if (multiroarFreeze(r, buf, size) != size) {
+            ERRR("Freeze didn't write the full image");
+        }
+
+        multiroarFrozen f;
+        if (!multiroarFrozenOpen(&f, buf, size)) {
+            ERRR("Failed to open frozen image");
+        } else {
+            /* Chunk data is 8-byte aligned relative to the buffer */
+            for (uint64_t i = 0; i < f.chunkCount; i++) {
+                if ((FROZEN_ENTRY_OFFSET(frozenDirEntry(&f, i)) + 1) % 8) {
+                    ERR("Chunk %" PRIu64 " payload misaligned", i);
+                }
+            }
+
+            if (multiroarFrozenBitCount(&f) != multiroarBitCount(r)) {
+                ERR("BitCount %" PRIu64 " != %" PRIu64,
+                    multiroarFrozenBitCount(&f), multiroarBitCount(r));
+            }
+
+            const uint64_t maxPos = 123457ULL * BITMAP_SIZE_IN_BITS;
+            for (int k = 0; k < 20000; k++) {
+                /* Half the probes land in populated low chunks */
+                const uint64_t pos = (k & 1) ? xoroshiro128plus(seed) % maxPos
+                                             : xoroshiro128plus(seed) %
+                                                   (70 * BITMAP_SIZE_IN_BITS);
+                if (multiroarFrozenBitGet(&f, pos) != multiroarBitGet(r, pos)) {
+                    ERR("BitGet(%" PRIu64 ") mismatch", pos);
+                    break;
+                }
+
+                if (multiroarFrozenRank(&f, pos) != multiroarRank(r, pos)) {
+                    ERR("Rank(%" PRIu64 ") %" PRIu64 " != %" PRIu64, pos,
+                        multiroarFrozenRank(&f, pos), multiroarRank(r, pos));
+                    break;
+                }
+            }
+
+            if (multiroarFrozenRank(&f, UINT64_MAX) != multiroarBitCount(r)) {
+                ERRR("Rank past the end != BitCount");
+            }
+
+            /* Iteration yields exactly the source sequence, twice */
+            multiroarIterator fi;
+            multiroarIterator ri;
+            multiroarFrozenIteratorInit(&f, &fi);
+            for (int pass = 0; pass < 2; pass++) {
+                multiroarIteratorInit(r, &ri);
+                uint64_t fp = 0;
+                uint64_t rp = 0;
+                uint64_t n = 0;
+                bool fHas;
+                while ((fHas = multiroarIteratorNext(&fi, &fp)) &
+                       multiroarIteratorNext(&ri, &rp)) {
+                    if (fp != rp) {
+                        ERR("Iteration %" PRIu64 ": %" PRIu64 " != %" PRIu64,
+                            n, fp, rp);
+                        break;
                     }
+                    n++;
                 }
-                if (densityB >= 20) {
-                    int count = (densityB < 40)   ? 50 + (densityB % 100)
-                                : (densityB < 80) ? 1000 + (densityB % 2000)
-                                                  : 7500 + (densityB % 692);
-                    for (int i = 0; i < count; i++) {
+
+                if (fHas || n != multiroarBitCount(r)) {
+                    ERR("Iteration pass %d visited %" PRIu64 " bits", pass, n);
+                }
+
+                multiroarIteratorReset(&fi);
+            }
+        }
+
+        zfree(buf);
+        multiroarFree(r);
+    }
+
+    TEST("FROZEN: OR/AND into a mutable roar match in-memory ops") {
+        uint64_t seed[2] = {0x46524F5A454E3032ULL, 0x8877665544332211ULL};
+
+        for (int trial = 0; trial < 8; trial++) {
+            multiroar *a = multiroarTestFrozenSource(seed);
+            multiroar *b = multiroarBitNew();
+            for (uint64_t chunk = 0; chunk < 70; chunk += 1 + (trial % 3)) {
+                const uint64_t base = chunk * BITMAP_SIZE_IN_BITS;
+                if (xoroshiro128plus(seed) % 2) {
+                    multiroarBitSetRange(
+                        b, base + (xoroshiro128plus(seed) % 4096),
+                        1 + (xoroshiro128plus(seed) % 4096));
+                } else {
+                    for (int k = 0; k < 400; k++) {
                         multiroarBitSet(b,
                                         base + (xoroshiro128plus(seed) % 8192));
                     }
                 }
             }
 
-            uint64_t countA = multiroarBitCount(a);
-            uint64_t countB = multiroarBitCount(b);
+            const uint64_t size = multiroarFrozenSize(a);
+            uint8_t *buf = zcalloc(size, 1);
+            multiroarFreeze(a, buf, size);
 
-            /* Test AND: result count <= min(countA, countB) */
-            multiroar *andResult = multiroarNewAnd(a, b);
-            uint64_t andCount = multiroarBitCount(andResult);
-            uint64_t minAB = (countA < countB) ? countA : countB;
-            if (andCount > minAB) {
-                ERR("Trial %d: AND count %" PRIu64 " > min(%" PRIu64 ",%" PRIu64
-                    ")",
-                    trial, andCount, countA, countB);
+            multiroarFrozen f;
+            if (!multiroarFrozenOpen(&f, buf, size)) {
+                ERR("Trial %d: open failed", trial);
+            } else {
+                multiroar *expectOr = multiroarNewOr(b, a);
+                multiroar *gotOr = multiroarDuplicate(b);
+                multiroarOrFrozen(gotOr, &f);
+                if (!multiroarEquals(expectOr, gotOr)) {
+                    ERR("Trial %d: OR mismatch", trial);
+                }
+
+                multiroar *expectAnd = multiroarNewAnd(b, a);
+                multiroar *gotAnd = multiroarDuplicate(b);
+                multiroarAndFrozen(gotAnd, &f);
+                if (!multiroarEquals(expectAnd, gotAnd)) {
+                    ERR("Trial %d: AND mismatch", trial);
+                }
+
+                /* Materializing: OR into an empty roar copies 'a' */
+                multiroar *copy = multiroarBitNew();
+                multiroarOrFrozen(copy, &f);
+                if (!multiroarEquals(copy, a)) {
+                    ERR("Trial %d: materialized copy mismatch", trial);
+                }
+
+                multiroarFree(expectOr);
+                multiroarFree(gotOr);
+                multiroarFree(expectAnd);
+                multiroarFree(gotAnd);
+                multiroarFree(copy);
             }
 
-            /* Test OR: result count >= max(countA, countB) */
-            multiroar *orResult = multiroarNewOr(a, b);
-            uint64_t orCount = multiroarBitCount(orResult);
-            uint64_t maxAB = (countA > countB) ? countA : countB;
-            if (orCount < maxAB) {
-                ERR("Trial %d: OR count %" PRIu64 " < max(%" PRIu64 ",%" PRIu64
-                    ")",
-                    trial, orCount, countA, countB);
+            zfree(buf);
+            multiroarFree(a);
+            multiroarFree(b);
+        }
+    }
+
+    TEST("FROZEN: empty image, oversized mapping, and malformed input") {
+        multiroar *empty = multiroarBitNew();
+        uint8_t small[64];
+        const uint64_t emptySize = multiroarFrozenSize(empty);
+        multiroarFrozen f;
+
+        if (multiroarFreeze(empty, small, sizeof(small)) != emptySize ||
+            !multiroarFrozenOpen(&f, small, emptySize)) {
+            ERRR("Empty roar didn't freeze/open");
+        } else {
+            multiroarIterator it;
+            uint64_t pos;
+            multiroarFrozenIteratorInit(&f, &it);
+            if (multiroarFrozenBitCount(&f) != 0 ||
+                multiroarFrozenBitGet(&f, 0) || multiroarFrozenRank(&f, 99) ||
+                multiroarIteratorNext(&it, &pos)) {
+                ERRR("Empty frozen image not empty");
+            }
+        }
+
+        multiroarFree(empty);
+
+        uint64_t seed[2] = {0x46524F5A454E3033ULL, 0x1234567890ABCDEFULL};
+        multiroar *r = multiroarTestFrozenSource(seed);
+        const uint64_t size = multiroarFrozenSize(r);
+
+        /* Page-rounded mappings are larger than the image */
+        const uint64_t mapped = size + 4096;
+        uint8_t *buf = zcalloc(mapped, 1);
+        uint8_t *bad = zcalloc(mapped, 1);
+
+        if (multiroarFreeze(r, buf, size - 1) != 0) {
+            ERRR("Freeze into a short buffer succeeded");
+        }
+
+        multiroarFreeze(r, buf, mapped);
+        if (!multiroarFrozenOpen(&f, buf, mapped)) {
+            ERRR("Open of page-rounded mapping failed");
+        }
+
+        if (multiroarFrozenOpen(&f, buf, size - 1)) {
+            ERRR("Truncated image opened");
+        }
+
+        /* Corrupt one field at a time; every variant must be rejected */
+        const uint64_t entry1 = FROZEN_HEADER_BYTES + FROZEN_DIR_ENTRY_BYTES;
+        multiroarFrozen good;
+        multiroarFrozenOpen(&good, buf, size);
+        databox key0;
+        databox value0;
+        frozenChunkAt(&good, 0, &key0, &value0);
+        const uint64_t payload0 = FROZEN_ENTRY_OFFSET(frozenDirEntry(&good, 0));
+
+        const struct {
+            uint64_t offset;
+            uint8_t value;
+            const char *what;
+        } corruptions[] = {
+            {0, 'X', "magic"},
+            {4, FROZEN_VERSION + 1, "version"},
+            {5, 0x01, "flags"},
+            {6, 0x01, "reserved byte 6"},
+            {7, 0x80, "reserved byte 7"},
+            {8, 0xFF, "chunk count"},
+            {16, 0x01, "bit count"},
+            {24, 0x01, "total length"},
+            {entry1, 0x00, "directory order"},
+            {entry1 + 8, 0x00, "rank"},
+            {entry1 + 16 + 5, 0x01, "payload offset"},
+            {entry1 + 24 + 3, 0x01, "payload length"},
+            {payload0, CHUNKY_MONKEY, "chunk type"},
+            {payload0 + 1, 0xF8, "packed count"},
+        };
+
+        for (uint32_t i = 0; i < sizeof(corruptions) / sizeof(*corruptions);
+             i++) {
+            memcpy(bad, buf, size);
+            bad[corruptions[i].offset] = corruptions[i].value;
+            if (multiroarFrozenOpen(&f, bad, size)) {
+                ERR("Corrupted %s accepted", corruptions[i].what);
             }
+        }
 
-            /* Test XOR: result count should satisfy |countA - countB| <=
-             * xorCount <= countA + countB */
-            multiroar *xorResult = multiroarNewXor(a, b);
-            uint64_t xorCount = multiroarBitCount(xorResult);
-            uint64_t diffAB =
-                (countA > countB) ? (countA - countB) : (countB - countA);
-            if (xorCount < diffAB || xorCount > countA + countB) {
-                ERR("Trial %d: XOR count %" PRIu64 " out of range [%" PRIu64
-                    ", %" PRIu64 "]",
-                    trial, xorCount, diffAB, countA + countB);
+        zfree(bad);
+        zfree(buf);
+        multiroarFree(r);
+    }
+
+    TEST("PERF: frozen open vs deserialize") {
+        multiroar *r = multiroarBitNew();
+        uint64_t seed[2] = {0x46524F5A454E3034ULL, 0xFEDCBA0987654321ULL};
+        for (uint64_t chunk = 0; chunk < 2000; chunk++) {
+            for (int k = 0; k < 40; k++) {
+                multiroarBitSet(r, (chunk * BITMAP_SIZE_IN_BITS) +
+                                       (xoroshiro128plus(seed) % 8192));
             }
+        }
 
-            /* Verify AND + XOR = OR (set theory identity) */
-            /* Actually: |A ∪ B| = |A| + |B| - |A ∩ B|
-             * and: |A △ B| = |A| + |B| - 2|A ∩ B|
-             * So: |A △ B| + |A ∩ B| = |A| + |B| - |A ∩ B|... no
-             * |A △ B| = |A ∪ B| - |A ∩ B|
-             * So: xorCount = orCount - andCount */
-            if (xorCount != orCount - andCount) {
-                ERR("Trial %d: set identity failed: XOR=%" PRIu64
-                    " != OR=%" PRIu64 " - AND=%" PRIu64,
-                    trial, xorCount, orCount, andCount);
+        const uint64_t serialSize = multiroarSerializedSize(r);
+        const uint64_t frozenSize = multiroarFrozenSize(r);
+        uint8_t *serial = zcalloc(serialSize, 1);
+        uint8_t *frozen = zcalloc(frozenSize, 1);
+        multiroarSerialize(r, serial, serialSize);
+        multiroarFreeze(r, frozen, frozenSize);
+
+        const int rounds = 20;
+        uint64_t start = timeUtilMonotonicNs();
+        for (int i = 0; i < rounds; i++) {
+            multiroar *d = multiroarDeserialize(serial, serialSize);
+            if (multiroarRank(d, 1000 * BITMAP_SIZE_IN_BITS) == UINT64_MAX) {
+                ERRR("unreachable");
             }
+            multiroarFree(d);
+        }
+        const uint64_t deserializeNs = timeUtilMonotonicNs() - start;
 
-            multiroarFree(andResult);
-            multiroarFree(orResult);
-            multiroarFree(xorResult);
-            multiroarFree(a);
-            multiroarFree(b);
+        start = timeUtilMonotonicNs();
+        for (int i = 0; i < rounds; i++) {
+            multiroarFrozen f;
+            if (!multiroarFrozenOpen(&f, frozen, frozenSize) ||
+                multiroarFrozenRank(&f, 1000 * BITMAP_SIZE_IN_BITS) ==
+                    UINT64_MAX) {
+                ERRR("Frozen open failed");
+            }
         }
+        const uint64_t openNs = timeUtilMonotonicNs() - start;
+
+        printf("    2000 chunks: serialized %" PRIu64 " B, frozen %" PRIu64
+               " B\n",
+               serialSize, frozenSize);
+        printf("    deserialize+rank: %.1f us, open+rank: %.1f us (%.1fx)\n",
+               deserializeNs / 1000.0 / rounds, openNs / 1000.0 / rounds,
+               (double)deserializeNs / (openNs ? openNs : 1));
+
+        zfree(serial);
+        zfree(frozen);
+        multiroarFree(r);
     }
 
-#undef FILL_SPARSE
-#undef FILL_DENSE
-#undef FILL_ALL_ONES
+    printf("=== Frozen Format Tests Passed! ===\n\n");
+
 
-    printf("=== Cross-Container-Type Tests Passed! ===\n\n");
 
     TEST_FINAL_RESULT;
 }
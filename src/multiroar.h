@@ -38,6 +38,8 @@ bool multiroarIsEmpty(const multiroar *r); /* True if no bits set */
 bool multiroarIntersects(const multiroar *a, const multiroar *b);
 bool multiroarIsSubset(const multiroar *a, const multiroar *b);
 bool multiroarEquals(const multiroar *a, const multiroar *b);
+/* |a AND b| without materializing the intersection */
+uint64_t multiroarAndCount(const multiroar *a, const multiroar *b);
 
 /* Rank/Select operations (succinct data structure support) */
 /* Count set bits in [0, position) */
@@ -80,6 +82,15 @@ multiroar *multiroarNewAndN(uint64_t n, multiroar **roars);
 multiroar *multiroarNewOrN(uint64_t n, multiroar **roars);
 multiroar *multiroarNewXorN(uint64_t n, multiroar **roars);
 
+/* Frozen (read-only, zero-copy) view over a buffer written by
+ * multiroarFreeze(); see the Frozen section below */
+typedef struct multiroarFrozen {
+    const uint8_t *buf;
+    uint64_t len;
+    uint64_t chunkCount;
+    uint64_t bitCount;
+} multiroarFrozen;
+
 /* Iterator for efficient traversal */
 typedef struct multiroarIterator {
     const multiroar *roar;
@@ -89,6 +100,9 @@ typedef struct multiroarIterator {
     uint64_t positionInChunk;
     uint16_t countInChunk;
     uint16_t indexInChunk;
+    uint16_t runInChunk; /* current run index for run chunks */
+    const multiroarFrozen *frozen; /* non-NULL when iterating a frozen view */
+    uint64_t frozenChunk;          /* next directory entry in 'frozen' */
     bool valid;
 } multiroarIterator;
 
@@ -114,11 +128,81 @@ double multiroarDice(const multiroar *a, const multiroar *b);
 /* Statistics and memory */
 uint64_t multiroarMemoryUsage(const multiroar *r);
 
+/* Convert chunks to run-length encoding where smaller; returns the number
+ * of chunks converted */
+uint64_t multiroarRunOptimize(multiroar *r);
+
 /* Serialization */
 uint64_t multiroarSerialize(const multiroar *r, void *buf, uint64_t bufSize);
 multiroar *multiroarDeserialize(const void *buf, uint64_t bufSize);
 uint64_t multiroarSerializedSize(const multiroar *r);
 
+/* Chunk-level access for column kernels built on top of multiroar (e.g.
+ * multiroarBsi). Chunk 'id' covers positions
+ * [id * MULTIROAR_CHUNK_BITS, (id + 1) * MULTIROAR_CHUNK_BITS), exchanged
+ * as a little-endian bitmap of MULTIROAR_CHUNK_BYTES bytes. */
+#define MULTIROAR_CHUNK_BITS 8192
+#define MULTIROAR_CHUNK_BYTES (MULTIROAR_CHUNK_BITS / 8)
+
+/* Forward-only walk over stored chunks; the roar must not be modified
+ * while a cursor is in use */
+typedef struct multiroarChunkCursor {
+    const multiroar *roar;
+    multimapIterator mapIter;
+    databox chunk; /* next unconsumed chunk when 'loaded' */
+    uint64_t chunkId;
+    bool loaded;
+    bool done;
+} multiroarChunkCursor;
+
+void multiroarChunkCursorInit(const multiroar *r, multiroarChunkCursor *c);
+/* Expand the next stored chunk into 'bitmap'; false when exhausted */
+bool multiroarChunkCursorNext(multiroarChunkCursor *c, uint64_t *chunkId,
+                              uint8_t *bitmap);
+/* Expand chunk 'chunkId' into 'bitmap' (zeroed if absent, returning false).
+ * Successive seeks must use non-decreasing ids. */
+bool multiroarChunkCursorSeek(multiroarChunkCursor *c, uint64_t chunkId,
+                              uint8_t *bitmap);
+/* Store 'bitmap' as chunk 'chunkId', replacing any existing chunk */
+void multiroarChunkStore(multiroar *r, uint64_t chunkId,
+                          const uint8_t *bitmap);
+
+/* Frozen format: a position-independent image that can be queried in place
+ * (e.g. straight out of mmap) without deserializing.
+ *
+ * Layout:
+ *   [header:32] [directory: chunkCount * 32] [payloads] [tail padding]
+ * Header and directory integers are little endian. Directory entries are
+ * sorted by chunk id and carry each chunk's rank so BitCount is O(1) and
+ * Rank is a binary search plus one in-chunk count. Payloads are the same
+ * chunk encodings used in memory, laid out so each chunk's data starts
+ * 8-byte aligned relative to the buffer start; sparse position lists
+ * (varintPacked13) are copied in native byte order, so images are only
+ * portable between hosts of the same endianness. */
+uint64_t multiroarFrozenSize(const multiroar *r);
+/* Returns bytes written, or 0 if 'bufSize' is smaller than
+ * multiroarFrozenSize() */
+uint64_t multiroarFreeze(const multiroar *r, void *buf, uint64_t bufSize);
+
+/* Validates 'buf' and points 'f' into it (no copy); 'buf' must outlive 'f'.
+ * Validation is eager: every directory entry is checked and every chunk
+ * payload's encoding is verified against it (type byte, lengths, run
+ * ordering), so Open is O(chunks + total runs) and touches the whole image.
+ * Queries afterwards do no further checking. Returns false for malformed or
+ * truncated input, including unknown header flags or non-zero reserved
+ * bytes. */
+bool multiroarFrozenOpen(multiroarFrozen *f, const void *buf, uint64_t len);
+bool multiroarFrozenBitGet(const multiroarFrozen *f, uint64_t position);
+uint64_t multiroarFrozenBitCount(const multiroarFrozen *f);
+/* Count set bits in [0, position) */
+uint64_t multiroarFrozenRank(const multiroarFrozen *f, uint64_t position);
+void multiroarFrozenIteratorInit(const multiroarFrozen *f,
+                                 multiroarIterator *iter);
+
+/* r = r OR f / r = r AND f, reading 'f' in place */
+void multiroarOrFrozen(multiroar *r, const multiroarFrozen *f);
+void multiroarAndFrozen(multiroar *r, const multiroarFrozen *f);
+
 #ifdef DATAKIT_TEST
 int multiroarTest(int argc, char *argv[]);
 #endif /* DATAKIT_TEST */
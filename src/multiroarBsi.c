@@ -0,0 +1,832 @@
+#include "multiroarBsi.h"
+#include "datakit.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+/* ====================================================================
+ * Storage
+ * ==================================================================== */
+#define BSI_MAX_BIT_WIDTH 64
+
+struct multiroarBsi {
+    multiroar *existence;                 /* Rows holding a value */
+    multiroar *slices[BSI_MAX_BIT_WIDTH]; /* slices[i]: rows with bit i set */
+    uint8_t bitWidth;
+};
+
+#define BSI_MAX_VALUE(b)                                                       \
+    ((b)->bitWidth == 64 ? UINT64_MAX : ((1ULL << (b)->bitWidth) - 1))
+
+multiroarBsi *multiroarBsiNew(uint8_t bitWidth) {
+    if (bitWidth == 0 || bitWidth > BSI_MAX_BIT_WIDTH) {
+        return NULL;
+    }
+
+    multiroarBsi *b = zcalloc(1, sizeof(*b));
+    b->bitWidth = bitWidth;
+    b->existence = multiroarBitNew();
+    for (uint32_t i = 0; i < bitWidth; i++) {
+        b->slices[i] = multiroarBitNew();
+    }
+
+    return b;
+}
+
+multiroarBsi *multiroarBsiNewFromArray(uint8_t bitWidth,
+                                       const uint64_t *values,
+                                       uint64_t count) {
+    multiroarBsi *b = multiroarBsiNew(bitWidth);
+    if (!b || count == 0) {
+        return b;
+    }
+
+    const uint64_t maxValue = BSI_MAX_VALUE(b);
+    for (uint64_t row = 0; row < count; row++) {
+        if (values[row] > maxValue) {
+            multiroarBsiFree(b);
+            return NULL;
+        }
+    }
+
+    /* Dense rows become ALL_1/run chunks instead of per-bit inserts */
+    multiroarBitSetRange(b->existence, 0, count);
+
+    /* Scatter one chunk of rows into every slice bitmap at once, then
+     * store each slice's chunk whole */
+    uint8_t(*bitmaps)[MULTIROAR_CHUNK_BYTES] =
+        zmalloc(bitWidth * sizeof(*bitmaps));
+    for (uint64_t base = 0; base < count; base += MULTIROAR_CHUNK_BITS) {
+        const uint64_t end = count - base < MULTIROAR_CHUNK_BITS
+                                 ? count
+                                 : base + MULTIROAR_CHUNK_BITS;
+        memset(bitmaps, 0, bitWidth * sizeof(*bitmaps));
+
+        for (uint64_t row = base; row < end; row++) {
+            const uint64_t offset = row - base;
+            for (uint64_t v = values[row]; v; v &= v - 1) {
+                bitmaps[__builtin_ctzll(v)][offset / 8] |= 1 << (offset % 8);
+            }
+        }
+
+        const uint64_t chunkId = base / MULTIROAR_CHUNK_BITS;
+        for (uint32_t i = 0; i < bitWidth; i++) {
+            multiroarChunkStore(b->slices[i], chunkId, bitmaps[i]);
+        }
+    }
+
+    zfree(bitmaps);
+    return b;
+}
+
+void multiroarBsiFree(multiroarBsi *b) {
+    if (!b) {
+        return;
+    }
+
+    multiroarFree(b->existence);
+    for (uint32_t i = 0; i < b->bitWidth; i++) {
+        multiroarFree(b->slices[i]);
+    }
+
+    zfree(b);
+}
+
+uint8_t multiroarBsiBitWidth(const multiroarBsi *b) {
+    return b ? b->bitWidth : 0;
+}
+
+uint64_t multiroarBsiCount(const multiroarBsi *b) {
+    return b ? multiroarBitCount(b->existence) : 0;
+}
+
+const multiroar *multiroarBsiExistence(const multiroarBsi *b) {
+    return b ? b->existence : NULL;
+}
+
+/* ====================================================================
+ * Row Access
+ * ==================================================================== */
+bool multiroarBsiSet(multiroarBsi *b, uint64_t row, uint64_t value) {
+    if (!b || value > BSI_MAX_VALUE(b)) {
+        return false;
+    }
+
+    multiroarBitSet(b->existence, row);
+    for (uint32_t i = 0; i < b->bitWidth; i++) {
+        if ((value >> i) & 1) {
+            multiroarBitSet(b->slices[i], row);
+        } else {
+            multiroarRemove(b->slices[i], row);
+        }
+    }
+
+    return true;
+}
+
+bool multiroarBsiGet(const multiroarBsi *b, uint64_t row, uint64_t *value) {
+    if (!b || !multiroarBitGet(b->existence, row)) {
+        return false;
+    }
+
+    uint64_t v = 0;
+    for (uint32_t i = 0; i < b->bitWidth; i++) {
+        v |= (uint64_t)multiroarBitGet(b->slices[i], row) << i;
+    }
+
+    if (value) {
+        *value = v;
+    }
+
+    return true;
+}
+
+bool multiroarBsiRemove(multiroarBsi *b, uint64_t row) {
+    if (!b || !multiroarRemove(b->existence, row)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < b->bitWidth; i++) {
+        multiroarRemove(b->slices[i], row);
+    }
+
+    return true;
+}
+
+/* ====================================================================
+ * Chunk Scan
+ * ====================================================================
+ * Predicates and SUM walk the candidate rows one multiroar chunk at a
+ * time: the candidate chunk and the same chunk of every slice are expanded
+ * into word arrays, and the per-bit algorithm runs on 64 rows per word
+ * without building any intermediate multiroar. */
+#define BSI_CHUNK_WORDS (MULTIROAR_CHUNK_BYTES / sizeof(uint64_t))
+
+typedef struct bsiScan {
+    const multiroarBsi *b;
+    multiroarChunkCursor existence;
+    multiroarChunkCursor filter;
+    multiroarChunkCursor slices[BSI_MAX_BIT_WIDTH];
+    bool hasFilter;
+    uint64_t chunkId;
+    uint64_t candidates[BSI_CHUNK_WORDS];
+    uint64_t filterWords[BSI_CHUNK_WORDS];
+    uint64_t sliceWords[BSI_MAX_BIT_WIDTH][BSI_CHUNK_WORDS];
+} bsiScan;
+
+static bsiScan *bsiScanNew(const multiroarBsi *b, const multiroar *filter) {
+    bsiScan *scan = zmalloc(sizeof(*scan));
+    scan->b = b;
+    scan->hasFilter = !!filter;
+    multiroarChunkCursorInit(b->existence, &scan->existence);
+    if (filter) {
+        multiroarChunkCursorInit(filter, &scan->filter);
+    }
+
+    for (uint32_t i = 0; i < b->bitWidth; i++) {
+        multiroarChunkCursorInit(b->slices[i], &scan->slices[i]);
+    }
+
+    return scan;
+}
+
+/* Load the next chunk holding at least one candidate row */
+static bool bsiScanNext(bsiScan *scan) {
+    while (multiroarChunkCursorNext(&scan->existence, &scan->chunkId,
+                                    (uint8_t *)scan->candidates)) {
+        if (scan->hasFilter) {
+            if (!multiroarChunkCursorSeek(&scan->filter, scan->chunkId,
+                                          (uint8_t *)scan->filterWords)) {
+                continue;
+            }
+
+            uint64_t any = 0;
+            for (uint32_t w = 0; w < BSI_CHUNK_WORDS; w++) {
+                scan->candidates[w] &= scan->filterWords[w];
+                any |= scan->candidates[w];
+            }
+
+            if (!any) {
+                continue;
+            }
+        }
+
+        for (uint32_t i = 0; i < scan->b->bitWidth; i++) {
+            multiroarChunkCursorSeek(&scan->slices[i], scan->chunkId,
+                                     (uint8_t *)scan->sliceWords[i]);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+/* For the 64 rows of word 'w', split 'candidates' into rows whose value is
+ * below, equal to, or above 'value'. Walks from the most significant
+ * slice down: a row leaves 'eq' at the first bit where it differs from
+ * 'value', and that bit decides which side it lands on. */
+static void bsiCompareWord(const bsiScan *scan, uint32_t w, uint64_t value,
+                           uint64_t *lt, uint64_t *eq, uint64_t *gt) {
+    uint64_t below = 0;
+    uint64_t equal = scan->candidates[w];
+    uint64_t above = 0;
+
+    for (int32_t i = scan->b->bitWidth - 1; i >= 0 && equal; i--) {
+        const uint64_t slice = scan->sliceWords[i][w];
+        if ((value >> i) & 1) {
+            below |= equal & ~slice;
+            equal &= slice;
+        } else {
+            above |= equal & slice;
+            equal &= ~slice;
+        }
+    }
+
+    *lt = below;
+    *eq = equal;
+    *gt = above;
+}
+
+/* ====================================================================
+ * Predicates
+ * ==================================================================== */
+/* Internal op for BETWEEN; never exposed through multiroarBsiOp */
+#define BSI_OP_BETWEEN (MULTIROAR_BSI_GT + 1)
+
+static multiroar *bsiEvaluate(const multiroarBsi *b, int32_t op, uint64_t lo,
+                              uint64_t hi, const multiroar *filter) {
+    multiroar *result = multiroarBitNew();
+    bsiScan *scan = bsiScanNew(b, filter);
+    uint64_t out[BSI_CHUNK_WORDS];
+
+    while (bsiScanNext(scan)) {
+        uint64_t any = 0;
+        for (uint32_t w = 0; w < BSI_CHUNK_WORDS; w++) {
+            uint64_t lt;
+            uint64_t eq;
+            uint64_t gt;
+            bsiCompareWord(scan, w, lo, &lt, &eq, &gt);
+
+            switch (op) {
+            case MULTIROAR_BSI_LT:
+                out[w] = lt;
+                break;
+            case MULTIROAR_BSI_LE:
+                out[w] = lt | eq;
+                break;
+            case MULTIROAR_BSI_EQ:
+                out[w] = eq;
+                break;
+            case MULTIROAR_BSI_NE:
+                out[w] = lt | gt;
+                break;
+            case MULTIROAR_BSI_GE:
+                out[w] = gt | eq;
+                break;
+            case MULTIROAR_BSI_GT:
+                out[w] = gt;
+                break;
+            case BSI_OP_BETWEEN: {
+                uint64_t hiLt;
+                uint64_t hiEq;
+                uint64_t hiGt;
+                bsiCompareWord(scan, w, hi, &hiLt, &hiEq, &hiGt);
+                out[w] = (gt | eq) & (hiLt | hiEq);
+                break;
+            }
+            }
+
+            any |= out[w];
+        }
+
+        if (any) {
+            multiroarChunkStore(result, scan->chunkId, (const uint8_t *)out);
+        }
+    }
+
+    zfree(scan);
+    return result;
+}
+
+multiroar *multiroarBsiCompare(const multiroarBsi *b, multiroarBsiOp op,
+                               uint64_t value, const multiroar *filter) {
+    if (!b) {
+        return NULL;
+    }
+
+    /* Out of range constants resolve without touching any slice */
+    if (value > BSI_MAX_VALUE(b)) {
+        if (op == MULTIROAR_BSI_LT || op == MULTIROAR_BSI_LE ||
+            op == MULTIROAR_BSI_NE) {
+            return filter ? multiroarNewAnd(b->existence, filter)
+                          : multiroarDuplicate(b->existence);
+        }
+
+        return multiroarBitNew();
+    }
+
+    return bsiEvaluate(b, op, value, 0, filter);
+}
+
+multiroar *multiroarBsiRange(const multiroarBsi *b, uint64_t lo, uint64_t hi,
+                             const multiroar *filter) {
+    if (!b) {
+        return NULL;
+    }
+
+    if (lo > hi || lo > BSI_MAX_VALUE(b)) {
+        return multiroarBitNew();
+    }
+
+    if (hi > BSI_MAX_VALUE(b)) {
+        hi = BSI_MAX_VALUE(b);
+    }
+
+    /* Both bounds are evaluated in the same pass over the slices */
+    return bsiEvaluate(b, BSI_OP_BETWEEN, lo, hi, filter);
+}
+
+/* ====================================================================
+ * Aggregates
+ * ==================================================================== */
+__uint128_t multiroarBsiSum(const multiroarBsi *b, const multiroar *filter,
+                            uint64_t *count) {
+    __uint128_t sum = 0;
+    uint64_t rows = 0;
+
+    if (b) {
+        bsiScan *scan = bsiScanNew(b, filter);
+        while (bsiScanNext(scan)) {
+            for (uint32_t w = 0; w < BSI_CHUNK_WORDS; w++) {
+                const uint64_t candidates = scan->candidates[w];
+                if (!candidates) {
+                    continue;
+                }
+
+                rows += __builtin_popcountll(candidates);
+                for (uint32_t i = 0; i < b->bitWidth; i++) {
+                    sum += (__uint128_t)__builtin_popcountll(
+                               scan->sliceWords[i][w] & candidates)
+                           << i;
+                }
+            }
+        }
+
+        zfree(scan);
+    }
+
+    if (count) {
+        *count = rows;
+    }
+
+    return sum;
+}
+
+/* Rows that exist and are inside 'filter' (NULL = every existing row) */
+static multiroar *bsiCandidates(const multiroarBsi *b,
+                                const multiroar *filter) {
+    return filter ? multiroarNewAnd(b->existence, filter)
+                  : multiroarDuplicate(b->existence);
+}
+
+/* Narrow candidates bit by bit, preferring rows with the bit set (max) or
+ * clear (min) whenever any candidate has it. */
+static bool bsiExtreme(const multiroarBsi *b, const multiroar *filter,
+                       bool max, uint64_t *value) {
+    if (!b) {
+        return false;
+    }
+
+    multiroar *candidates = bsiCandidates(b, filter);
+    if (multiroarIsEmpty(candidates)) {
+        multiroarFree(candidates);
+        return false;
+    }
+
+    uint64_t result = 0;
+    for (int32_t i = b->bitWidth - 1; i >= 0; i--) {
+        multiroar *preferred =
+            max ? multiroarNewAnd(candidates, b->slices[i])
+                : multiroarNewAndNot(candidates, b->slices[i]);
+
+        if (multiroarIsEmpty(preferred)) {
+            /* Every candidate has the other bit value */
+            multiroarFree(preferred);
+            result |= (uint64_t)!max << i;
+        } else {
+            multiroarFree(candidates);
+            candidates = preferred;
+            result |= (uint64_t)max << i;
+        }
+    }
+
+    multiroarFree(candidates);
+    if (value) {
+        *value = result;
+    }
+
+    return true;
+}
+
+bool multiroarBsiMin(const multiroarBsi *b, const multiroar *filter,
+                     uint64_t *value) {
+    return bsiExtreme(b, filter, false, value);
+}
+
+bool multiroarBsiMax(const multiroarBsi *b, const multiroar *filter,
+                     uint64_t *value) {
+    return bsiExtreme(b, filter, true, value);
+}
+
+multiroar *multiroarBsiTopK(const multiroarBsi *b, uint64_t k,
+                            const multiroar *filter) {
+    if (!b) {
+        return NULL;
+    }
+
+    multiroar *candidates = bsiCandidates(b, filter);
+    if (multiroarBitCount(candidates) <= k) {
+        return candidates;
+    }
+
+    /* 'chosen' holds rows certainly in the top K; 'candidates' holds rows
+     * tied with each other on every slice examined so far. */
+    multiroar *chosen = multiroarBitNew();
+    uint64_t chosenCount = 0;
+
+    for (int32_t i = b->bitWidth - 1; i >= 0 && chosenCount < k; i--) {
+        multiroar *high = multiroarNewAnd(candidates, b->slices[i]);
+        const uint64_t highCount = multiroarBitCount(high);
+
+        if (chosenCount + highCount > k) {
+            /* Too many rows with this bit set; the answer is among them */
+            multiroarFree(candidates);
+            candidates = high;
+        } else {
+            /* All of them make it; keep looking among rows with bit clear */
+            multiroarOr(chosen, high);
+            multiroarFree(high);
+            chosenCount += highCount;
+            multiroarAndNot(candidates, b->slices[i]);
+        }
+    }
+
+    /* Remaining candidates all hold the cutoff value; take lowest rows */
+    if (chosenCount < k) {
+        multiroarIterator iter;
+        multiroarIteratorInit(candidates, &iter);
+        uint64_t row;
+        while (chosenCount < k && multiroarIteratorNext(&iter, &row)) {
+            multiroarBitSet(chosen, row);
+            chosenCount++;
+        }
+    }
+
+    multiroarFree(candidates);
+    return chosen;
+}
+
+/* ====================================================================
+ * Testing
+ * ==================================================================== */
+#ifdef DATAKIT_TEST
+#include "ctest.h"
+#include "str.h"
+#include "timeUtil.h"
+
+#include <stdlib.h>
+
+/* Random value that fits in 'bitWidth', skewed toward small and boundary
+ * values so comparisons hit equal prefixes */
+static uint64_t bsiTestValue(uint64_t seed[2], uint8_t bitWidth) {
+    const uint64_t max = bitWidth == 64 ? UINT64_MAX : (1ULL << bitWidth) - 1;
+    const uint64_t r = xoroshiro128plus(seed);
+    switch (r % 4) {
+    case 0:
+        return ((r >> 8) % 16) & max;
+    case 1:
+        return max - (((r >> 8) % 4) & max);
+    default:
+        return (r >> 2) & max;
+    }
+}
+
+static int bsiTestCompareU64(const void *a, const void *b) {
+    const uint64_t x = *(const uint64_t *)a;
+    const uint64_t y = *(const uint64_t *)b;
+    return x < y ? 1 : x > y ? -1 : 0; /* descending */
+}
+
+static bool bsiTestOpHolds(multiroarBsiOp op, uint64_t v, uint64_t c) {
+    switch (op) {
+    case MULTIROAR_BSI_LT:
+        return v < c;
+    case MULTIROAR_BSI_LE:
+        return v <= c;
+    case MULTIROAR_BSI_EQ:
+        return v == c;
+    case MULTIROAR_BSI_NE:
+        return v != c;
+    case MULTIROAR_BSI_GE:
+        return v >= c;
+    case MULTIROAR_BSI_GT:
+        return v > c;
+    }
+
+    return false;
+}
+
+int multiroarBsiTest(int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+
+    int err = 0;
+
+    TEST("create, set, get, remove") {
+        if (multiroarBsiNew(0) || multiroarBsiNew(65)) {
+            ERRR("Invalid bit widths accepted");
+        }
+
+        multiroarBsi *b = multiroarBsiNew(8);
+        if (multiroarBsiSet(b, 5, 256)) {
+            ERRR("Value wider than bitWidth accepted");
+        }
+
+        multiroarBsiSet(b, 5, 200);
+        multiroarBsiSet(b, 9000, 0);
+        multiroarBsiSet(b, 5, 17); /* overwrite clears stale slice bits */
+
+        uint64_t v = 0;
+        if (!multiroarBsiGet(b, 5, &v) || v != 17) {
+            ERR("Get(5) = %" PRIu64 ", expected 17", v);
+        }
+
+        if (!multiroarBsiGet(b, 9000, &v) || v != 0) {
+            ERRR("Zero value row lost");
+        }
+
+        if (multiroarBsiGet(b, 6, &v)) {
+            ERRR("Missing row reported present");
+        }
+
+        if (multiroarBsiCount(b) != 2) {
+            ERR("Count %" PRIu64 ", expected 2", multiroarBsiCount(b));
+        }
+
+        if (!multiroarBsiRemove(b, 5) || multiroarBsiRemove(b, 5) ||
+            multiroarBsiGet(b, 5, &v) || multiroarBsiCount(b) != 1) {
+            ERRR("Remove didn't clear row");
+        }
+
+        multiroarBsiFree(b);
+    }
+
+    TEST("FUZZ: predicates and aggregates match a row scan") {
+        uint64_t seed[2] = {0x4253494253494253ULL, 0x0123456789ABCDEFULL};
+        const uint8_t widths[] = {1, 3, 8, 17, 33, 64};
+        const uint64_t rows = 40000;
+        uint64_t *values = zcalloc(rows, sizeof(*values));
+        bool *present = zcalloc(rows, sizeof(*present));
+        bool *inFilter = zcalloc(rows, sizeof(*inFilter));
+        uint64_t *sorted = zcalloc(rows, sizeof(*sorted));
+
+        for (uint32_t w = 0; w < sizeof(widths); w++) {
+            const uint8_t width = widths[w];
+            multiroarBsi *b = multiroarBsiNew(width);
+            multiroar *filter = multiroarBitNew();
+
+            /* Row gaps, clustered filter ranges, and scattered filter bits */
+            for (uint64_t row = 0; row < rows; row++) {
+                present[row] = xoroshiro128plus(seed) % 10 != 0;
+                values[row] = bsiTestValue(seed, width);
+                inFilter[row] = (row / 5000) % 2 == 0
+                                    ? true
+                                    : xoroshiro128plus(seed) % 3 == 0;
+                if (present[row]) {
+                    multiroarBsiSet(b, row, values[row]);
+                }
+
+                if (inFilter[row]) {
+                    multiroarBitSet(filter, row);
+                }
+            }
+
+            for (int q = 0; q < 12; q++) {
+                const multiroarBsiOp op = q % 6;
+                const bool useFilter = q >= 6;
+                const uint64_t c = bsiTestValue(seed, width);
+
+                multiroar *got =
+                    multiroarBsiCompare(b, op, c, useFilter ? filter : NULL);
+                for (uint64_t row = 0; row < rows; row++) {
+                    const bool expect = present[row] &&
+                                        (!useFilter || inFilter[row]) &&
+                                        bsiTestOpHolds(op, values[row], c);
+                    if (multiroarBitGet(got, row) != expect) {
+                        ERR("width %u op %d c %" PRIu64 " row %" PRIu64
+                            ": got %d",
+                            width, op, c, row, !expect);
+                        break;
+                    }
+                }
+
+                multiroarFree(got);
+            }
+
+            /* BETWEEN, including an empty and an inverted range */
+            for (int q = 0; q < 6; q++) {
+                uint64_t lo = bsiTestValue(seed, width);
+                uint64_t hi = bsiTestValue(seed, width);
+                if (q < 4 && lo > hi) {
+                    const uint64_t t = lo;
+                    lo = hi;
+                    hi = t;
+                }
+
+                multiroar *got = multiroarBsiRange(b, lo, hi, filter);
+                uint64_t expectCount = 0;
+                for (uint64_t row = 0; row < rows; row++) {
+                    const bool expect = present[row] && inFilter[row] &&
+                                        values[row] >= lo && values[row] <= hi;
+                    expectCount += expect;
+                    if (multiroarBitGet(got, row) != expect) {
+                        ERR("width %u BETWEEN %" PRIu64 " %" PRIu64
+                            " row %" PRIu64,
+                            width, lo, hi, row);
+                        break;
+                    }
+                }
+
+                if (multiroarBitCount(got) != expectCount) {
+                    ERR("width %u BETWEEN count mismatch", width);
+                }
+
+                multiroarFree(got);
+            }
+
+            /* SUM / MIN / MAX */
+            for (int useFilter = 0; useFilter < 2; useFilter++) {
+                __uint128_t expectSum = 0;
+                uint64_t expectCount = 0;
+                uint64_t expectMin = UINT64_MAX;
+                uint64_t expectMax = 0;
+                for (uint64_t row = 0; row < rows; row++) {
+                    if (present[row] && (!useFilter || inFilter[row])) {
+                        expectSum += values[row];
+                        expectCount++;
+                        expectMin =
+                            values[row] < expectMin ? values[row] : expectMin;
+                        expectMax =
+                            values[row] > expectMax ? values[row] : expectMax;
+                    }
+                }
+
+                uint64_t count = 0;
+                const __uint128_t sum =
+                    multiroarBsiSum(b, useFilter ? filter : NULL, &count);
+                if (sum != expectSum || count != expectCount) {
+                    ERR("width %u SUM mismatch (filter %d)", width, useFilter);
+                }
+
+                uint64_t min = 0;
+                uint64_t max = 0;
+                if (!multiroarBsiMin(b, useFilter ? filter : NULL, &min) ||
+                    !multiroarBsiMax(b, useFilter ? filter : NULL, &max) ||
+                    min != expectMin || max != expectMax) {
+                    ERR("width %u MIN/MAX %" PRIu64 "/%" PRIu64
+                        ", expected %" PRIu64 "/%" PRIu64,
+                        width, min, max, expectMin, expectMax);
+                }
+            }
+
+            /* TopK: exactly k rows whose values are the k largest */
+            const uint64_t ks[] = {0, 1, 7, 1000, rows};
+            for (uint32_t kq = 0; kq < sizeof(ks) / sizeof(*ks); kq++) {
+                const uint64_t k = ks[kq];
+                uint64_t n = 0;
+                for (uint64_t row = 0; row < rows; row++) {
+                    if (present[row] && inFilter[row]) {
+                        sorted[n++] = values[row];
+                    }
+                }
+
+                qsort(sorted, n, sizeof(*sorted), bsiTestCompareU64);
+                const uint64_t want = k < n ? k : n;
+
+                multiroar *top = multiroarBsiTopK(b, k, filter);
+                if (multiroarBitCount(top) != want) {
+                    ERR("width %u TopK(%" PRIu64 ") returned %" PRIu64
+                        " rows",
+                        width, k, multiroarBitCount(top));
+                }
+
+                /* Multiset of chosen values must equal the k largest */
+                uint64_t *picked = zcalloc(want + 1, sizeof(*picked));
+                uint64_t p = 0;
+                multiroarIterator iter;
+                multiroarIteratorInit(top, &iter);
+                uint64_t row;
+                while (multiroarIteratorNext(&iter, &row) && p < want) {
+                    if (!present[row] || !inFilter[row]) {
+                        ERR("TopK picked row %" PRIu64 " outside filter", row);
+                    }
+
+                    picked[p++] = values[row];
+                }
+
+                qsort(picked, p, sizeof(*picked), bsiTestCompareU64);
+                for (uint64_t i = 0; i < p; i++) {
+                    if (picked[i] != sorted[i]) {
+                        ERR("width %u TopK(%" PRIu64 ") rank %" PRIu64
+                            " mismatch",
+                            width, k, i);
+                        break;
+                    }
+                }
+
+                zfree(picked);
+                multiroarFree(top);
+            }
+
+            /* Bulk build matches row-at-a-time build on dense rows */
+            multiroarBsi *bulk = multiroarBsiNewFromArray(width, values, rows);
+            for (uint64_t row = 0; row < rows; row += 997) {
+                uint64_t v = 0;
+                if (!multiroarBsiGet(bulk, row, &v) || v != values[row]) {
+                    ERR("width %u bulk row %" PRIu64 " mismatch", width, row);
+                    break;
+                }
+            }
+
+            multiroarBsiFree(bulk);
+            multiroarFree(filter);
+            multiroarBsiFree(b);
+        }
+
+        zfree(values);
+        zfree(present);
+        zfree(inFilter);
+        zfree(sorted);
+    }
+
+    TEST("PERF: bit-sliced predicates vs row scan (1M rows, 20 bits)") {
+        const uint64_t rows = 1000000;
+        const uint8_t width = 20;
+        uint64_t seed[2] = {0x5045524642534931ULL, 0x1F2E3D4C5B6A7988ULL};
+        uint64_t *values = zcalloc(rows, sizeof(*values));
+        for (uint64_t row = 0; row < rows; row++) {
+            values[row] = xoroshiro128plus(seed) & ((1ULL << width) - 1);
+        }
+
+        uint64_t start = timeUtilMonotonicNs();
+        multiroarBsi *b = multiroarBsiNewFromArray(width, values, rows);
+        const uint64_t buildNs = timeUtilMonotonicNs() - start;
+
+        const uint64_t lo = 100000;
+        const uint64_t hi = 300000;
+
+        start = timeUtilMonotonicNs();
+        multiroar *between = multiroarBsiRange(b, lo, hi, NULL);
+        const uint64_t rangeNs = timeUtilMonotonicNs() - start;
+
+        start = timeUtilMonotonicNs();
+        uint64_t count = 0;
+        const __uint128_t sum = multiroarBsiSum(b, between, &count);
+        const uint64_t sumNs = timeUtilMonotonicNs() - start;
+
+        start = timeUtilMonotonicNs();
+        multiroar *top = multiroarBsiTopK(b, 100, NULL);
+        const uint64_t topNs = timeUtilMonotonicNs() - start;
+
+        start = timeUtilMonotonicNs();
+        uint64_t scanCount = 0;
+        __uint128_t scanSum = 0;
+        for (uint64_t row = 0; row < rows; row++) {
+            if (values[row] >= lo && values[row] <= hi) {
+                scanCount++;
+                scanSum += values[row];
+            }
+        }
+        const uint64_t scanNs = timeUtilMonotonicNs() - start;
+
+        if (count != scanCount || sum != scanSum ||
+            multiroarBitCount(between) != scanCount ||
+            multiroarBitCount(top) != 100) {
+            ERRR("PERF results disagree with scan");
+        }
+
+        printf("    build %.1f ms, BETWEEN %.2f ms, SUM(filtered) %.2f ms, "
+               "TopK(100) %.2f ms; scan BETWEEN+SUM %.2f ms\n",
+               buildNs / 1e6, rangeNs / 1e6, sumNs / 1e6, topNs / 1e6,
+               scanNs / 1e6);
+
+        multiroarFree(top);
+        multiroarFree(between);
+        multiroarBsiFree(b);
+        zfree(values);
+    }
+
+    TEST_FINAL_RESULT;
+}
+#endif /* DATAKIT_TEST */
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "multiroar.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ====================================================================
+ * multiroar Bit-Sliced Index
+ * ====================================================================
+ *
+ * OVERVIEW
+ * --------
+ * Stores one unsigned integer column (up to 64 bits wide) as bitWidth
+ * multiroar bitmaps: slice i holds the rows whose value has bit i set, and
+ * an existence bitmap holds the rows that have a value at all.
+ *
+ * Queries never look at individual rows. Each one is a fixed sequence of
+ * AND / OR / ANDNOT steps over the slices, one step per bit of the value
+ * width (O'Neil & Quass comparison, Rinfret et al. top-K), so cost scales
+ * with bitWidth x chunks touched rather than rows:
+ *   - Compare (<, <=, ==, !=, >=, >) and Range (BETWEEN, inclusive)
+ *     return a new multiroar of matching rows.
+ *   - Sum is sum(2^i * |slice_i AND filter|), a popcount per slice.
+ *   - TopK returns exactly k rows holding the largest values.
+ *
+ * Compare, Range, and Sum run one multiroar chunk (8192 rows) at a time
+ * over all slices, 64 rows per machine word, without materializing
+ * intermediate bitmaps. Min, Max, and TopK need global counts per slice
+ * and use whole-multiroar operations.
+ *
+ * Every query takes an optional 'filter' multiroar of candidate rows
+ * (NULL = all rows), so predicates compose: pass one predicate's result
+ * as the next one's filter.
+ *
+ * A multiroarValueNew() matrix with C columns maps to C indexes (one per
+ * column) sharing row numbering.
+ *
+ * USAGE EXAMPLE
+ * -------------
+ *   multiroarBsi *price = multiroarBsiNewFromArray(20, prices, rows);
+ *   multiroar *cheap = multiroarBsiRange(price, 100, 500, NULL);
+ *   uint64_t n;
+ *   __uint128_t total = multiroarBsiSum(price, cheap, &n);
+ *   multiroar *top = multiroarBsiTopK(price, 10, cheap);
+ */
+
+typedef struct multiroarBsi multiroarBsi;
+
+typedef enum multiroarBsiOp {
+    MULTIROAR_BSI_LT = 0,
+    MULTIROAR_BSI_LE,
+    MULTIROAR_BSI_EQ,
+    MULTIROAR_BSI_NE,
+    MULTIROAR_BSI_GE,
+    MULTIROAR_BSI_GT
+} multiroarBsiOp;
+
+/* bitWidth must be in [1, 64]; returns NULL otherwise */
+multiroarBsi *multiroarBsiNew(uint8_t bitWidth);
+/* Rows [0, count) get values[row] */
+multiroarBsi *multiroarBsiNewFromArray(uint8_t bitWidth,
+                                       const uint64_t *values, uint64_t count);
+void multiroarBsiFree(multiroarBsi *b);
+
+uint8_t multiroarBsiBitWidth(const multiroarBsi *b);
+/* Number of rows holding a value */
+uint64_t multiroarBsiCount(const multiroarBsi *b);
+/* Rows holding a value (owned by 'b') */
+const multiroar *multiroarBsiExistence(const multiroarBsi *b);
+
+/* Returns false if 'value' doesn't fit in bitWidth */
+bool multiroarBsiSet(multiroarBsi *b, uint64_t row, uint64_t value);
+bool multiroarBsiGet(const multiroarBsi *b, uint64_t row, uint64_t *value);
+/* Returns false if 'row' held no value */
+bool multiroarBsiRemove(multiroarBsi *b, uint64_t row);
+
+/* Rows (within 'filter') where (row value) <op> 'value'; caller frees */
+multiroar *multiroarBsiCompare(const multiroarBsi *b, multiroarBsiOp op,
+                               uint64_t value, const multiroar *filter);
+/* Rows (within 'filter') with lo <= (row value) <= hi; caller frees */
+multiroar *multiroarBsiRange(const multiroarBsi *b, uint64_t lo, uint64_t hi,
+                             const multiroar *filter);
+
+/* Sum of values over rows in 'filter'; matched row count in *count */
+__uint128_t multiroarBsiSum(const multiroarBsi *b, const multiroar *filter,
+                            uint64_t *count);
+/* Extreme values over rows in 'filter'; false if no rows match */
+bool multiroarBsiMin(const multiroarBsi *b, const multiroar *filter,
+                     uint64_t *value);
+bool multiroarBsiMax(const multiroarBsi *b, const multiroar *filter,
+                     uint64_t *value);
+
+/* Exactly min(k, matching rows) rows with the largest values; ties at the
+ * cutoff value are broken by lowest row number. Caller frees. */
+multiroar *multiroarBsiTopK(const multiroarBsi *b, uint64_t k,
+                            const multiroar *filter);
+
+#ifdef DATAKIT_TEST
+int multiroarBsiTest(int argc, char *argv[]);
+#endif